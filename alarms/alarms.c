@@ -25,6 +25,7 @@
 */
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <sys/ioctl.h>
 #include <unistd.h>
 
 /*  ... Library include files
@@ -55,6 +56,9 @@ static char*            alarmsStatusLabels[STATUS_STATS_MAX] =
     "Datafeed packets sent"
 };
 
+static int              alarmsBacklogLimits[STATUS_HISTOGRAM_BINS - 1] =
+    ALARMS_BACKLOG_LIMITS;
+
 
 /* ... methods
 */
@@ -536,12 +540,73 @@ static void pushArchiveToClients(ARCHIVE_PKT* archive)
     return;
 }
 
+// Bytes written to the client but not yet read by it:
+static int GetClientBacklog(WVIEW_ALARM_CLIENT* client)
+{
+    int                 pending = 0;
+
+#ifdef TIOCOUTQ
+    if (ioctl(radSocketGetDescriptor(client->client), TIOCOUTQ, &pending) != 0)
+    {
+        pending = 0;
+    }
+#endif
+
+    return pending;
+}
+
+static int writeLoopFrames
+(
+    WVIEW_ALARM_CLIENT  *client,
+    LOOP_PKT            *networkLoop,
+    DF_LOOP_EXT         *networkExt
+)
+{
+    // write the frame start so clients may sync to the beginning of each
+    // data update
+    if (radSocketWriteExact (client->client, 
+                             (void *)DF_LOOP_START_FRAME, 
+                             DF_START_FRAME_LENGTH)
+        != DF_START_FRAME_LENGTH)
+    {
+        return ERROR;
+    }
+
+    // write out the loop data in network byte order, in the LOOP frame
+    // layout older clients expect:
+    if (radSocketWriteExact(client->client, networkLoop, DF_LOOP_PKT_LENGTH)
+        != DF_LOOP_PKT_LENGTH)
+    {
+        return ERROR;
+    }
+
+    // then the wind windows in their own frame:
+    if (radSocketWriteExact (client->client, 
+                             (void *)DF_LOOP_EXT_START_FRAME, 
+                             DF_START_FRAME_LENGTH)
+        != DF_START_FRAME_LENGTH)
+    {
+        return ERROR;
+    }
+
+    if (radSocketWriteExact(client->client, networkExt, sizeof(*networkExt))
+        != sizeof(*networkExt))
+    {
+        return ERROR;
+    }
+
+    return OK;
+}
+
 static void pushLoopToClients(LOOP_PKT* loopData)
 {
     WVIEW_ALARM_CLIENT  *client, *oldClient;
     LOOP_PKT            networkLoop;
+    DF_LOOP_EXT         networkExt;
+    int                 backlog, maxBacklog = 0;
 
     datafeedConvertLOOP_HTON(&networkLoop, loopData);
+    datafeedConvertLOOPExt_HTON(&networkExt, loopData);
 
     // Push to each socket client:
     for (client = (WVIEW_ALARM_CLIENT *) radListGetFirst (&alarmsWork.clientList);
@@ -549,12 +614,7 @@ static void pushLoopToClients(LOOP_PKT* loopData)
          client = (WVIEW_ALARM_CLIENT *) radListGetNext (&alarmsWork.clientList, 
                                                          (NODE_PTR)client))
     {
-        // write the frame start so clients may sync to the beginning of each
-        // data update
-        if (radSocketWriteExact (client->client, 
-                                 (void *)DF_LOOP_START_FRAME, 
-                                 DF_START_FRAME_LENGTH)
-            != DF_START_FRAME_LENGTH)
+        if (writeLoopFrames(client, &networkLoop, &networkExt) == ERROR)
         {
             // write error, bail on this guy
             radMsgLog (PRI_HIGH, "LOOP: write error to client %s:%d - closing socket...",
@@ -571,28 +631,16 @@ static void pushLoopToClients(LOOP_PKT* loopData)
             continue;
         }
 
-        // write out the loop data in network byte order:
-        if (radSocketWriteExact(client->client, &networkLoop, sizeof(networkLoop))
-            != sizeof(networkLoop))
+        statusIncrementStat(ALARM_STATS_PKTS_SENT);
+
+        backlog = GetClientBacklog(client);
+        if (backlog > maxBacklog)
         {
-            // write error, bail on this guy
-            radMsgLog (PRI_HIGH, "LOOP: write error to client %s:%d - closing socket...",
-                       radSocketGetHost (client->client),
-                       radSocketGetPort (client->client));
-            statusDecrementStat(ALARM_STATS_CLIENTS);
-            radProcessIODeRegisterDescriptorByFd(radSocketGetDescriptor(client->client));
-            radSocketDestroy (client->client);
-            oldClient = client;
-            client = (WVIEW_ALARM_CLIENT *) 
-                        radListGetPrevious (&alarmsWork.clientList, (NODE_PTR)client);
-            radListRemove (&alarmsWork.clientList, (NODE_PTR)oldClient);
-            free (oldClient);
-            continue;
+            maxBacklog = backlog;
         }
-
-        statusIncrementStat(ALARM_STATS_PKTS_SENT);
     }
 
+    statusHistogramAdd(ALARMS_HISTOGRAM_BACKLOG, maxBacklog);
     return;
 }
 
@@ -1494,6 +1542,7 @@ int main (int argc, char *argv[])
     }
 
     statusUpdate(STATUS_BOOTING);
+    statusHistogramInit(ALARMS_HISTOGRAM_BACKLOG, "Datafeed backlog bytes", alarmsBacklogLimits);
     statusUpdateStat(ALARM_STATS_ALARMS, retVal);
 
 
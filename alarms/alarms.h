@@ -124,6 +124,9 @@ typedef enum
     ALARM_STATS_PKTS_SENT
 } ALARM_STATS;
 
+// status histogram upper bounds in bytes not yet read by the slowest client:
+#define ALARMS_BACKLOG_LIMITS       {0, 1024, 4096, 16384, 65536, 262144, 1048576}
+
 
 // define an alarm definition structure
 typedef struct
@@ -90,6 +90,7 @@ int main (int argc, char *argv[])
     char            temp[128];
     LOOP_PKT        loopData;
     LOOP_PKT        hostLoopData;
+    DF_LOOP_EXT     loopExt;
     ARCHIVE_PKT     archiveRecord;
     ARCHIVE_PKT     hostRecord;
     ULONG           dateTime = 0;
@@ -156,8 +157,8 @@ int main (int argc, char *argv[])
 
             case DF_LOOP_PKT_TYPE:
                 /* OK, we have a loop update coming (this may block) */
-                if (radSocketReadExact(ClientSocket, (void *)&loopData, sizeof (loopData)) 
-                    != sizeof (loopData))
+                if (radSocketReadExact(ClientSocket, (void *)&loopData, DF_LOOP_PKT_LENGTH) 
+                    != DF_LOOP_PKT_LENGTH)
                 {
                     printf("datafeedClient: ClientSocket read error - abort!\n");
                     ProcessDone = TRUE;
@@ -174,6 +175,26 @@ int main (int argc, char *argv[])
                            hostLoopData.outTemp);
                 break;
 
+            case DF_LOOP_EXT_PKT_TYPE:
+                /* the wind windows for the LOOP update just received */
+                if (radSocketReadExact(ClientSocket, (void *)&loopExt, sizeof (loopExt)) 
+                    != sizeof (loopExt))
+                {
+                    printf("datafeedClient: ClientSocket read error - abort!\n");
+                    ProcessDone = TRUE;
+                    continue;
+                }
+
+                // Convert from network byte order:
+                datafeedConvertLOOPExt_NTOH(&hostLoopData, &loopExt);
+
+                printf("dataFeedClient:%s:%d:received LOOP wind windows: %d mph %d deg\n",
+                           radSocketGetHost (ClientSocket),
+                           radSocketGetPort (ClientSocket),
+                           (int)hostLoopData.twoMinuteAvgWindSpeed,
+                           (int)hostLoopData.twoMinuteAvgWindDir);
+                break;
+
             case DF_ARCHIVE_PKT_TYPE:
                 /* OK, we have an archive coming (this may block) */
                 if (radSocketReadExact(ClientSocket, (void *)&archiveRecord, sizeof(archiveRecord)) 
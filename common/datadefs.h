@@ -14,6 +14,8 @@
         03/23/2008      W. Krenn        1               add WXT510 specials
         07/07/2009      M.S. Teel       2               Remove pragma packed
                                                         from internal structs
+        10/19/2026      M.S. Teel       3               Wind window fields at the
+                                                        end of LOOP_PKT
 
   NOTES:
 
@@ -272,7 +274,7 @@ typedef struct
 
     // Vantage Pro
     USHORT              rxCheckPercent;         /* 0 - 100                */
-    USHORT              tenMinuteAvgWindSpeed;  /* mph                    */
+    USHORT              tenMinuteAvgWindSpeed;  /* mph (computed for all) */
     USHORT              forecastIcon;           /* VP only                */
     USHORT              forecastRule;           /* VP only                */
     USHORT              txBatteryStatus;        /* VP only                */
@@ -329,6 +331,14 @@ typedef struct
     UCHAR               uvBatteryStatus;
     UCHAR               solarBatteryStatus;
     UCHAR               extraTempBatteryStatus[WVIEW_NUM_EXTRA_SENSORS];
+
+    // Sliding wind windows (windStats.c), computed for all stations; these
+    // stay last so the datafeed LOOP frame keeps its layout (see datafeed.h):
+    USHORT              twoMinuteAvgWindSpeed;  /* mph                    */
+    USHORT              twoMinuteAvgWindDir;    /* degrees (vector mean)  */
+    USHORT              tenMinuteAvgWindDir;    /* degrees (vector mean)  */
+    USHORT              tenMinuteWindGust;      /* mph                    */
+    USHORT              tenMinuteWindGustDir;   /* degrees                */
 } LOOP_PKT;
 
 
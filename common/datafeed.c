@@ -11,6 +11,7 @@
         12/16/2009      M.S. Teel       0               Original
         01/02/2011      M.S. Teel       1               Remove fixed point translation;
                         & P. Sanchez                    add htonf and ntohf utilities.
+        10/19/2026      M.S. Teel       2               Add the LOOP extension frame
  
   NOTES:
         
@@ -194,6 +195,10 @@ int datafeedSyncStartOfFrame(RADSOCK_ID socket)
     {
         return (int)DF_RQST_ARCHIVE_START_FRAME[3];
     }
+    else if (start == DF_LOOP_EXT_START_FRAME[3])
+    {
+        return (int)DF_LOOP_EXT_START_FRAME[3];
+    }
 
     return FALSE;
 }
@@ -381,6 +386,35 @@ int datafeedConvertLOOP_NTOH(LOOP_PKT* dest, LOOP_PKT* src)
     tempshort = (USHORT*)&(dest->wmr918extra2BatteryStatus);
     *tempshort = swapShortNTOH(&dest->wmr918extra2BatteryStatus);
 
+    // not in the LOOP frame, a DF_LOOP_EXT frame carries these:
+    dest->twoMinuteAvgWindSpeed         = 0;
+    dest->twoMinuteAvgWindDir           = 0;
+    dest->tenMinuteAvgWindDir           = 0;
+    dest->tenMinuteWindGust             = 0;
+    dest->tenMinuteWindGustDir          = 0;
+
+    return OK;
+}
+
+int datafeedConvertLOOPExt_HTON(DF_LOOP_EXT* dest, LOOP_PKT* src)
+{
+    dest->twoMinuteAvgWindSpeed         = htons(src->twoMinuteAvgWindSpeed);
+    dest->twoMinuteAvgWindDir           = htons(src->twoMinuteAvgWindDir);
+    dest->tenMinuteAvgWindDir           = htons(src->tenMinuteAvgWindDir);
+    dest->tenMinuteWindGust             = htons(src->tenMinuteWindGust);
+    dest->tenMinuteWindGustDir          = htons(src->tenMinuteWindGustDir);
+
+    return OK;
+}
+
+int datafeedConvertLOOPExt_NTOH(LOOP_PKT* dest, DF_LOOP_EXT* src)
+{
+    dest->twoMinuteAvgWindSpeed         = ntohs(src->twoMinuteAvgWindSpeed);
+    dest->twoMinuteAvgWindDir           = ntohs(src->twoMinuteAvgWindDir);
+    dest->tenMinuteAvgWindDir           = ntohs(src->tenMinuteAvgWindDir);
+    dest->tenMinuteWindGust             = ntohs(src->tenMinuteWindGust);
+    dest->tenMinuteWindGustDir          = ntohs(src->tenMinuteWindGustDir);
+
     return OK;
 }
 
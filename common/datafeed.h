@@ -11,6 +11,7 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         12/16/2009      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Add the LOOP extension frame
  
   NOTES:
         
@@ -27,6 +28,7 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <time.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -61,6 +63,7 @@
 #define DF_LOOP_PKT_TYPE            1
 #define DF_ARCHIVE_PKT_TYPE         2
 #define DF_RQST_ARCHIVE_PKT_TYPE    3
+#define DF_LOOP_EXT_PKT_TYPE        4
 
 // Define some times:
 #define DF_WAIT_FIRST               500
@@ -92,19 +95,56 @@ const USHORT DF_RQST_ARCHIVE_START_FRAME[4] =
     0xDADA, 
     0x0003
 };
+
+// This one follows each LOOP frame with the LOOP_PKT fields added after the
+// LOOP frame layout was fixed; clients that do not know it skip it while
+// they look for the next start frame:
+const USHORT DF_LOOP_EXT_START_FRAME[4] = 
+{
+    0xF388, 
+    0xC6A2, 
+    0xDADA, 
+    0x0004
+};
 #else
 extern const USHORT DF_LOOP_START_FRAME[4]; 
 extern const USHORT DF_ARCHIVE_START_FRAME[4]; 
 extern const USHORT DF_RQST_ARCHIVE_START_FRAME[4];
+extern const USHORT DF_LOOP_EXT_START_FRAME[4];
 #endif
 
+// The LOOP frame carries LOOP_PKT up to the wind window fields, so its
+// length is what sizeof(LOOP_PKT) was before they were appended and older
+// clients and servers still agree on it:
+typedef struct
+{
+    char                pad;
+    LOOP_PKT            loop;
+} DF_LOOP_ALIGN;
+
+#define DF_LOOP_ALIGNMENT           offsetof(DF_LOOP_ALIGN, loop)
+#define DF_LOOP_PKT_LENGTH          \
+    (((offsetof(LOOP_PKT, twoMinuteAvgWindSpeed) + DF_LOOP_ALIGNMENT - 1) / \
+      DF_LOOP_ALIGNMENT) * DF_LOOP_ALIGNMENT)
+
+// The DF_LOOP_EXT frame payload:
+typedef struct
+{
+    USHORT              twoMinuteAvgWindSpeed;
+    USHORT              twoMinuteAvgWindDir;
+    USHORT              tenMinuteAvgWindDir;
+    USHORT              tenMinuteWindGust;
+    USHORT              tenMinuteWindGustDir;
+} DF_LOOP_EXT;
+
 
 //  ... API prototypes
 
 // Frame sync utility:
-// Returns DF_LOOP_PKT_TYPE, DF_ARCHIVE_PKT_TYPE or DF_RQST_ARCHIVE_PKT_TYPE 
-//   if a valid frame header of one of those types is received, FALSE if not a 
-//   valid frame header and ERROR if there is a socket error:
+// Returns DF_LOOP_PKT_TYPE, DF_ARCHIVE_PKT_TYPE, DF_RQST_ARCHIVE_PKT_TYPE or
+//   DF_LOOP_EXT_PKT_TYPE if a valid frame header of one of those types is
+//   received, FALSE if not a valid frame header and ERROR if there is a socket
+//   error:
 extern int datafeedSyncStartOfFrame(RADSOCK_ID socket);
 
 
@@ -112,6 +152,10 @@ extern int datafeedSyncStartOfFrame(RADSOCK_ID socket);
 extern int datafeedConvertLOOP_HTON(LOOP_PKT* dest, LOOP_PKT* src);
 extern int datafeedConvertLOOP_NTOH(LOOP_PKT* dest, LOOP_PKT* src);
 
+// DF_LOOP_EXT byteorder conversions to/from the LOOP_PKT wind window fields:
+extern int datafeedConvertLOOPExt_HTON(DF_LOOP_EXT* dest, LOOP_PKT* src);
+extern int datafeedConvertLOOPExt_NTOH(LOOP_PKT* dest, DF_LOOP_EXT* src);
+
 // ARCHIVE_PKT byteorder and fixed point conversions:
 extern int datafeedConvertArchive_HTON(ARCHIVE_PKT* dest, ARCHIVE_PKT* src);
 extern int datafeedConvertArchive_NTOH(ARCHIVE_PKT* dest, ARCHIVE_PKT* src);
@@ -9,6 +9,7 @@
 //  REVISION HISTORY:
 //        Date            Engineer        Revision        Remarks
 //        08/31/2008      M.S. Teel       0               Original
+//        10/19/2026      M.S. Teel       1               Field index by name
 //
 //  NOTES:
 //
@@ -37,6 +38,7 @@
 
 //  ... Library include files
 #include <radmsgLog.h>
+#include <sqlite3.h>
 
 //  ... Local include files
 #include <dbsqlite.h>
@@ -843,6 +845,21 @@ char* dbsqliteArchiveGetPath (void)
     return DefaultArchivePath;
 }
 
+int dbsqliteArchiveGetFieldIndex (const char* name)
+{
+    int         index;
+
+    for (index = 0; index < DATA_INDEX_MAX; index ++)
+    {
+        if (!strcmp(name, ArchiveValueName[index]))
+        {
+            return index;
+        }
+    }
+
+    return ERROR;
+}
+
 #if defined(BUILD_HTMLGEND)
 //  ... calculate averages over a given period of time
 //  ... (given in arcInterval minute samples);
@@ -1194,3 +1211,193 @@ int dbsqliteArchiveGetCount(char* whereClause)
     return (getCount(whereClause));
 }
 
+#ifdef BUILD_UTILITIES
+//  ... bulk import - the archive connection goes through radsqlite row
+//  ... descriptions and autocommits each insert, which is far too slow for
+//  ... converting years of history, so use a private prepared connection:
+
+static sqlite3*         bulkDB = NULL;
+static sqlite3_stmt*    bulkInsert = NULL;
+static sqlite3_stmt*    bulkSelect = NULL;
+static int              bulkBatchSize;
+static int              bulkPending;
+static time_t           bulkNewest;
+
+static int bulkExec (char* query)
+{
+    char*           errMsg = NULL;
+
+    if (sqlite3_exec (bulkDB, query, NULL, NULL, &errMsg) != SQLITE_OK)
+    {
+        radMsgLog (PRI_HIGH, "dbsqlite: %s failed: %s", query, 
+                   (errMsg != NULL) ? errMsg : "unknown");
+        sqlite3_free (errMsg);
+        return ERROR;
+    }
+
+    return OK;
+}
+
+int dbsqliteArchiveBulkBegin (int batchSize)
+{
+    char            query[DB_SQLITE_QUERY_LENGTH_MAX];
+    int             length;
+    Data_Indices    index;
+
+    if (sqlite3_open (getArchiveDBFilename(), &bulkDB) != SQLITE_OK)
+    {
+        radMsgLog (PRI_HIGH, "dbsqliteArchiveBulkBegin: failed to open %s!", getArchiveDBFilename());
+        sqlite3_close (bulkDB);
+        bulkDB = NULL;
+        return ERROR;
+    }
+
+    // Avoid expensive fsyncs and journal operations during conversion:
+    bulkExec ("PRAGMA synchronous = OFF");
+    if (SQLITE_VERSION_NUMBER >= 3005009)
+    {
+        bulkExec ("PRAGMA journal_mode = OFF");
+    }
+
+    length = sprintf (query, "INSERT OR IGNORE INTO archive (dateTime,usUnits,interval");
+    for (index = DATA_INDEX_barometer; index < DATA_INDEX_MAX; index ++)
+    {
+        length += sprintf (&query[length], ",%s", ArchiveValueName[index]);
+    }
+    length += sprintf (&query[length], ") VALUES (?,?,?");
+    for (index = DATA_INDEX_barometer; index < DATA_INDEX_MAX; index ++)
+    {
+        length += sprintf (&query[length], ",?");
+    }
+    sprintf (&query[length], ")");
+
+    if (sqlite3_prepare_v2 (bulkDB, query, -1, &bulkInsert, NULL) != SQLITE_OK ||
+        sqlite3_prepare_v2 (bulkDB,
+                            "SELECT dateTime FROM archive WHERE dateTime >= ? AND dateTime < ? ORDER BY dateTime ASC",
+                            -1, &bulkSelect, NULL) != SQLITE_OK)
+    {
+        radMsgLog (PRI_HIGH, "dbsqliteArchiveBulkBegin: prepare failed: %s", sqlite3_errmsg(bulkDB));
+        dbsqliteArchiveBulkEnd ();
+        return ERROR;
+    }
+
+    bulkBatchSize = (batchSize > 0) ? batchSize : 1;
+    bulkPending = 0;
+    bulkNewest = 0;
+
+    if (bulkExec ("BEGIN TRANSACTION") == ERROR)
+    {
+        dbsqliteArchiveBulkEnd ();
+        return ERROR;
+    }
+
+    return OK;
+}
+
+int dbsqliteArchiveBulkStore (ARCHIVE_PKT* record)
+{
+    Data_Indices    index;
+    int             retVal;
+
+    if (bulkInsert == NULL)
+    {
+        return ERROR;
+    }
+
+    sqlite3_bind_int64 (bulkInsert, 1, (sqlite3_int64)record->dateTime);
+    sqlite3_bind_int64 (bulkInsert, 2, (sqlite3_int64)record->usUnits);
+    sqlite3_bind_int64 (bulkInsert, 3, (sqlite3_int64)record->interval);
+    for (index = DATA_INDEX_barometer; index < DATA_INDEX_MAX; index ++)
+    {
+        if (record->value[index] <= ARCHIVE_VALUE_NULL)
+        {
+            sqlite3_bind_null (bulkInsert, 4 + index);
+        }
+        else
+        {
+            sqlite3_bind_double (bulkInsert, 4 + index, (double)record->value[index]);
+        }
+    }
+
+    if (sqlite3_step (bulkInsert) != SQLITE_DONE)
+    {
+        radMsgLog (PRI_MEDIUM, "dbsqliteArchiveBulkStore: insert failed: %s", sqlite3_errmsg(bulkDB));
+        sqlite3_reset (bulkInsert);
+        return ERROR;
+    }
+
+    retVal = (sqlite3_changes (bulkDB) > 0) ? TRUE : FALSE;
+    sqlite3_reset (bulkInsert);
+
+    if (retVal && record->dateTime > bulkNewest)
+    {
+        bulkNewest = record->dateTime;
+    }
+
+    if (++ bulkPending >= bulkBatchSize)
+    {
+        if (bulkExec ("COMMIT TRANSACTION") == ERROR ||
+            bulkExec ("BEGIN TRANSACTION") == ERROR)
+        {
+            return ERROR;
+        }
+        bulkPending = 0;
+    }
+
+    return retVal;
+}
+
+int dbsqliteArchiveBulkGetTimes
+(
+    time_t          startTime,
+    time_t          stopTime,
+    time_t*         store,
+    int             maxTimes
+)
+{
+    int             count = 0, rc;
+
+    if (bulkSelect == NULL)
+    {
+        return ERROR;
+    }
+
+    sqlite3_bind_int64 (bulkSelect, 1, (sqlite3_int64)startTime);
+    sqlite3_bind_int64 (bulkSelect, 2, (sqlite3_int64)stopTime);
+
+    while (count < maxTimes && (rc = sqlite3_step (bulkSelect)) == SQLITE_ROW)
+    {
+        store[count++] = (time_t)sqlite3_column_int64 (bulkSelect, 0);
+    }
+
+    sqlite3_reset (bulkSelect);
+    return count;
+}
+
+void dbsqliteArchiveBulkEnd (void)
+{
+    char            fileName[128];
+
+    if (bulkDB == NULL)
+    {
+        return;
+    }
+
+    if (bulkInsert != NULL)
+    {
+        bulkExec ("COMMIT TRANSACTION");
+    }
+
+    sqlite3_finalize (bulkInsert);
+    sqlite3_finalize (bulkSelect);
+    sqlite3_close (bulkDB);
+    bulkInsert = bulkSelect = NULL;
+    bulkDB = NULL;
+
+    if (bulkNewest > 0)
+    {
+        sprintf (fileName, "%s/export/%s", wvutilsGetConfigPath(), WVIEW_ARCHIVE_MARKER_FILE);
+        wvutilsWriteMarkerFile(fileName, bulkNewest);
+    }
+}
+#endif
@@ -11,6 +11,7 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         08/31/2008      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Field index by name
  
   NOTES:
  
@@ -122,6 +123,10 @@ extern int dbsqliteArchivePragmaSet(char* pragma, char* setting);
 extern void dbsqliteArchiveSetPath (char* newPath);
 extern char* dbsqliteArchiveGetPath (void);
 
+//  ... get the Data_Indices index of an archive field name (i.e. "outTemp");
+//  ... returns the index or ERROR
+extern int dbsqliteArchiveGetFieldIndex (const char* name);
+
 //  ... append an archive record to the archive database;
 //  ... returns OK or ERROR
 extern int dbsqliteArchiveStoreRecord (ARCHIVE_PKT* record);
@@ -170,6 +175,32 @@ extern int dbsqliteArchiveExecutePerRecord
 extern int dbsqliteArchiveGetCount(char* whereClause);
 
 
+#ifdef BUILD_UTILITIES
+//  ... Bulk archive import (conversion utilities): uses a private connection
+//  ... with a prepared INSERT OR IGNORE and commits every 'batchSize' records;
+//  ... returns OK or ERROR
+extern int dbsqliteArchiveBulkBegin (int batchSize);
+
+//  ... queue a record for insert;
+//  ... returns TRUE if inserted, FALSE if it already existed, or ERROR
+extern int dbsqliteArchiveBulkStore (ARCHIVE_PKT* record);
+
+//  ... retrieve the timestamps of existing records in [startTime, stopTime)
+//  ... in ascending order (up to 'maxTimes');
+//  ... returns the number stored or ERROR
+extern int dbsqliteArchiveBulkGetTimes
+(
+    time_t          startTime,
+    time_t          stopTime,
+    time_t*         store,
+    int             maxTimes
+);
+
+//  ... commit any pending records and close the bulk connection
+extern void dbsqliteArchiveBulkEnd (void);
+#endif
+
+
 
 // ------------------------ HILOW Database ------------------------
 // Initialize the HILOW database:
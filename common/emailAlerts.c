@@ -38,7 +38,11 @@ static ALERT_INFO       alertInfo[ALERT_TYPE_MAX] =
     { "wview Station Interface Alert!", "Loop data retrieval failed - current conditions may not be updating!" },
     { "wview Station Interface Alert!", "Archive data retrieval failed - arcive table and graphs may not be updating!" },
     { "wview Station Interface Alert!", "Station device interface failed - check driver, device or interface!" },
-    { "wview Station Interface Alert!", "Bogus or corrupt station data received - check station or cabling" }
+    { "wview Station Interface Alert!", "Bogus or corrupt station data received - check station or cabling" },
+    { "wview Process Health Alert!", "A daemon exceeded its memory or open file limit - see the wvpmond log and pmon.health" },
+    { "wview Process Health Alert!", "A daemon is slow to answer polls - see the wvpmond log and pmon.health" },
+    { "wview Process Health Alert!", "htmlgend generation is taking longer than PROCMON_ALERT_HTML_GEN_MS" },
+    { "wview Process Health Alert!", "A wvalarmd datafeed client is falling behind (PROCMON_ALERT_DATAFEED_BACKLOG)" }
 };
 
 static time_t           lastAlertTime[ALERT_TYPE_MAX] =
@@ -52,6 +52,10 @@ typedef enum
     ALERT_TYPE_STATION_ARCHIVE,
     ALERT_TYPE_STATION_DEVICE,
     ALERT_TYPE_STATION_READ,
+    ALERT_TYPE_PROCESS_RESOURCES,
+    ALERT_TYPE_PROCESS_LATENCY,
+    ALERT_TYPE_HTML_GENERATION,
+    ALERT_TYPE_DATAFEED_BACKLOG,
     ALERT_TYPE_MAX
 } EmailAlertTypes;
 
@@ -10,6 +10,7 @@
         Date            Engineer        Revision        Remarks
         08/17/2005      M.S. Teel       0               Original
         12/01/2009      M. Hornsby      1               Add Moon Rise and Set
+        10/19/2026      M.S. Teel       2               Phase by date for the astro table
  
   NOTES:
         
@@ -359,9 +360,25 @@ static MOONLOCATION GetMoonLocation(double jd)
 
 // Public methods:
 #define PHASE_STR_MAX       128
-char *lunarPhaseGet (char *increase, char *decrease, char *full)
+double lunarPhaseCompute (int year, int month, int day, int hour)
+{
+    return GetMoonPhase (year, month, day, hour);
+}
+
+char *lunarPhaseFormat (double phase, char *increase, char *decrease, char *full)
 {
     static char     phaseStr[PHASE_STR_MAX];
+
+    if (phase < 0)
+        snprintf(phaseStr, PHASE_STR_MAX-1, "%s %.0f%c %s", decrease, fabs(phase), '%', full);
+    else
+        snprintf(phaseStr, PHASE_STR_MAX-1, "%s %.0f%c %s", increase, phase, '%', full);
+
+    return phaseStr;
+}
+
+char *lunarPhaseGet (char *increase, char *decrease, char *full)
+{
     time_t          timeNow = time (NULL);
     double          phase;
     struct tm       bknTime;
@@ -372,12 +389,7 @@ char *lunarPhaseGet (char *increase, char *decrease, char *full)
     phase = GetMoonPhase (bknTime.tm_year+1900, bknTime.tm_mon+1,
                           bknTime.tm_mday, bknTime.tm_hour);
 
-    if (phase < 0)
-        snprintf(phaseStr, PHASE_STR_MAX-1, "%s %.0f%c %s", decrease, fabs(phase), '%', full);
-    else
-        snprintf(phaseStr, PHASE_STR_MAX-1, "%s %.0f%c %s", increase, phase, '%', full);
-
-    return phaseStr;
+    return lunarPhaseFormat (phase, increase, decrease, full);
 }
 
 
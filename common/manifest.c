@@ -0,0 +1,453 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        manifest.c
+
+  PURPOSE:
+        Provide the file content manifest API methods.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+//  ... System header files
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <errno.h>
+#include <radmsgLog.h>
+
+
+//  ... Local header files
+#include <manifest.h>
+
+
+#define MANIFEST_GROW_SIZE          256
+#define MANIFEST_READ_SIZE          65536
+
+#define FNV_OFFSET_BASIS            0xcbf29ce484222325ULL
+#define FNV_PRIME                   0x100000001b3ULL
+
+
+//  ... local utilities
+
+// binary search; returns the index of 'path' or, if not found, the
+// insertion point as (-index - 1)
+static int Search (MANIFEST_ID id, const char *path)
+{
+    int         low = 0, high = id->count - 1, mid, cmp;
+
+    while (low <= high)
+    {
+        mid = (low + high) / 2;
+        cmp = strcmp (id->entries[mid].path, path);
+        if (cmp == 0)
+            return mid;
+        else if (cmp < 0)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
+
+    return (-low - 1);
+}
+
+static int Walk
+(
+    const char          *directory,
+    const char          *relDir,
+    int                 depth,
+    MANIFEST_WALK_FUNC  func,
+    void                *context
+)
+{
+    DIR                 *dir;
+    struct dirent       *entry;
+    struct stat         fileStat;
+    char                path[_MAX_PATH], relPath[_MAX_PATH];
+    int                 retVal, numFiles = 0;
+
+    dir = opendir (directory);
+    if (dir == NULL)
+    {
+        radMsgLog (PRI_HIGH, "manifestWalk: cannot open %s: %s", directory, strerror(errno));
+        return ERROR;
+    }
+
+    while ((entry = readdir (dir)) != NULL)
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        snprintf (path, sizeof(path), "%s/%s", directory, entry->d_name);
+        if (relDir[0] != 0)
+            snprintf (relPath, sizeof(relPath), "%s/%s", relDir, entry->d_name);
+        else
+            wvstrncpy (relPath, entry->d_name, sizeof(relPath));
+
+        if (stat (path, &fileStat) == -1)
+            continue;
+
+        if (S_ISDIR(fileStat.st_mode))
+        {
+            if (depth >= MANIFEST_MAX_DEPTH)
+                continue;
+
+            retVal = Walk (path, relPath, depth + 1, func, context);
+            if (retVal > 0)
+                numFiles += retVal;
+        }
+        else if (S_ISREG(fileStat.st_mode))
+        {
+            (*func) (path, relPath, &fileStat, context);
+            numFiles ++;
+        }
+    }
+
+    closedir (dir);
+    return numFiles;
+}
+
+static void UpdateFile
+(
+    const char      *path,
+    const char      *relPath,
+    struct stat     *fileStat,
+    void            *context
+)
+{
+    MANIFEST_ID     id = (MANIFEST_ID)context;
+    MANIFEST_ENTRY  *entry;
+    ULONGLONG       hash;
+
+    entry = manifestFind (id, path);
+    if (entry != NULL &&
+        entry->size == fileStat->st_size &&
+        entry->mtime == fileStat->st_mtime)
+    {
+        entry->seen = TRUE;
+        return;
+    }
+
+    if (manifestHashFile (path, &hash) == ERROR)
+        return;
+
+    if (manifestSet (id, path, fileStat->st_size, fileStat->st_mtime, hash) == OK)
+    {
+        manifestFind (id, path)->seen = TRUE;
+        id->rehashed ++;
+    }
+}
+
+
+//  ... define methods here
+
+void manifestInit (MANIFEST_ID id, const char *destination)
+{
+    memset (id, 0, sizeof (*id));
+    if (destination != NULL)
+    {
+        wvstrncpy (id->destination, destination, _MAX_PATH);
+    }
+}
+
+int manifestLoad (MANIFEST_ID id, const char *file)
+{
+    FILE            *fp;
+    struct stat     fileStat;
+    char            line[_MAX_PATH + 64];
+    ULONGLONG       hash;
+    long long       size;
+    long            mtime;
+    int             offset, length;
+
+    if (stat (file, &fileStat) == -1)
+    {
+        manifestClear (id);
+        id->fileTime = 0;
+        return OK;
+    }
+
+    if (fileStat.st_mtime == id->fileTime && id->count > 0)
+    {
+        // no change since we loaded it
+        return OK;
+    }
+
+    fp = fopen (file, "r");
+    if (fp == NULL)
+    {
+        radMsgLog (PRI_HIGH, "manifestLoad: cannot open %s: %s", file, strerror(errno));
+        return ERROR;
+    }
+
+    manifestClear (id);
+
+    while (fgets (line, sizeof(line), fp) != NULL)
+    {
+        length = strlen (line);
+        if (length > 0 && line[length - 1] == '\n')
+            line[length - 1] = 0;
+
+        if (line[0] == '#')
+        {
+            offset = 0;
+            sscanf (line, "# wview manifest %*d %n", &offset);
+            if (offset > 0 && strcmp (&line[offset], id->destination) != 0)
+            {
+                radMsgLog (PRI_STATUS, "manifestLoad: %s is for %s, ignoring it",
+                           file, &line[offset]);
+                break;
+            }
+            continue;
+        }
+
+        offset = 0;
+        if (sscanf (line, "%llx %lld %ld %n", &hash, &size, &mtime, &offset) < 3 ||
+            offset == 0 || line[offset] == 0 || strlen (&line[offset]) >= _MAX_PATH)
+        {
+            continue;
+        }
+
+        if (manifestSet (id, &line[offset], (off_t)size, (time_t)mtime, hash) == ERROR)
+        {
+            fclose (fp);
+            return ERROR;
+        }
+    }
+
+    fclose (fp);
+    id->fileTime = fileStat.st_mtime;
+    return OK;
+}
+
+int manifestSave (MANIFEST_ID id, const char *file)
+{
+    FILE            *fp;
+    char            tempFile[_MAX_PATH];
+    int             i;
+
+    snprintf (tempFile, sizeof(tempFile), "%s.tmp", file);
+    fp = fopen (tempFile, "w");
+    if (fp == NULL)
+    {
+        radMsgLog (PRI_HIGH, "manifestSave: cannot open %s: %s", tempFile, strerror(errno));
+        return ERROR;
+    }
+
+    fprintf (fp, "# wview manifest %d %s\n", MANIFEST_VERSION, id->destination);
+    for (i = 0; i < id->count; i ++)
+    {
+        fprintf (fp, "%16.16llx %lld %ld %s\n",
+                 id->entries[i].hash,
+                 (long long)id->entries[i].size,
+                 (long)id->entries[i].mtime,
+                 id->entries[i].path);
+    }
+
+    if (fflush (fp) != 0 || ferror (fp))
+    {
+        radMsgLog (PRI_HIGH, "manifestSave: write to %s failed: %s", tempFile, strerror(errno));
+        fclose (fp);
+        unlink (tempFile);
+        return ERROR;
+    }
+    fclose (fp);
+
+    if (rename (tempFile, file) == -1)
+    {
+        radMsgLog (PRI_HIGH, "manifestSave: rename to %s failed: %s", file, strerror(errno));
+        unlink (tempFile);
+        return ERROR;
+    }
+
+    return OK;
+}
+
+MANIFEST_ENTRY *manifestFind (MANIFEST_ID id, const char *path)
+{
+    int             index = Search (id, path);
+
+    return ((index >= 0) ? &id->entries[index] : NULL);
+}
+
+int manifestSet
+(
+    MANIFEST_ID     id,
+    const char      *path,
+    off_t           size,
+    time_t          mtime,
+    ULONGLONG       hash
+)
+{
+    MANIFEST_ENTRY  *newEntries;
+    int             index = Search (id, path);
+
+    if (index < 0)
+    {
+        if (strlen (path) >= _MAX_PATH)
+        {
+            return ERROR;
+        }
+
+        if (id->count >= id->size)
+        {
+            newEntries = realloc (id->entries,
+                                  (id->size + MANIFEST_GROW_SIZE) * sizeof(MANIFEST_ENTRY));
+            if (newEntries == NULL)
+            {
+                radMsgLog (PRI_HIGH, "manifestSet: cannot grow the manifest");
+                return ERROR;
+            }
+            id->entries = newEntries;
+            id->size += MANIFEST_GROW_SIZE;
+        }
+
+        index = -index - 1;
+        memmove (&id->entries[index + 1], &id->entries[index],
+                 (id->count - index) * sizeof(MANIFEST_ENTRY));
+        id->count ++;
+
+        memset (&id->entries[index], 0, sizeof(MANIFEST_ENTRY));
+        wvstrncpy (id->entries[index].path, path, _MAX_PATH);
+    }
+
+    id->entries[index].size     = size;
+    id->entries[index].mtime    = mtime;
+    id->entries[index].hash     = hash;
+    return OK;
+}
+
+void manifestClear (MANIFEST_ID id)
+{
+    id->count = 0;
+}
+
+int manifestHashFile (const char *path, ULONGLONG *hash)
+{
+    int             fd, i;
+    ssize_t         bytes;
+    ULONGLONG       value = FNV_OFFSET_BASIS;
+    unsigned char   buffer[MANIFEST_READ_SIZE];
+
+    fd = open (path, O_RDONLY);
+    if (fd == -1)
+    {
+        return ERROR;
+    }
+
+    while ((bytes = read (fd, buffer, sizeof(buffer))) != 0)
+    {
+        if (bytes == -1)
+        {
+            if (errno == EINTR)
+                continue;
+
+            close (fd);
+            return ERROR;
+        }
+
+        for (i = 0; i < bytes; i ++)
+        {
+            value ^= buffer[i];
+            value *= FNV_PRIME;
+        }
+    }
+
+    close (fd);
+    *hash = value;
+    return OK;
+}
+
+int manifestGetHash
+(
+    MANIFEST_ID     published,
+    const char      *path,
+    struct stat     *fileStat,
+    ULONGLONG       *hash
+)
+{
+    MANIFEST_ENTRY  *entry = NULL;
+
+    if (published != NULL)
+    {
+        entry = manifestFind (published, path);
+    }
+
+    if (entry != NULL &&
+        entry->size == fileStat->st_size &&
+        entry->mtime == fileStat->st_mtime)
+    {
+        *hash = entry->hash;
+        return OK;
+    }
+
+    return manifestHashFile (path, hash);
+}
+
+int manifestWalk
+(
+    const char          *directory,
+    MANIFEST_WALK_FUNC  func,
+    void                *context
+)
+{
+    char                realDir[PATH_MAX];
+
+    // report real paths so every daemon uses the same manifest keys:
+    if (realpath (directory, realDir) == NULL)
+    {
+        wvstrncpy (realDir, directory, sizeof(realDir));
+    }
+
+    return Walk (realDir, "", 0, func, context);
+}
+
+int manifestUpdate (MANIFEST_ID id, const char *directory)
+{
+    int             i, kept;
+
+    for (i = 0; i < id->count; i ++)
+    {
+        id->entries[i].seen = FALSE;
+    }
+
+    id->rehashed = 0;
+    if (manifestWalk (directory, UpdateFile, (void *)id) == ERROR)
+    {
+        return ERROR;
+    }
+
+    // drop entries for files which have gone away:
+    for (i = 0, kept = 0; i < id->count; i ++)
+    {
+        if (id->entries[i].seen)
+        {
+            if (kept != i)
+                id->entries[kept] = id->entries[i];
+            kept ++;
+        }
+    }
+    id->count = kept;
+
+    return id->rehashed;
+}
+
+void manifestExit (MANIFEST_ID id)
+{
+    free (id->entries);
+    id->entries = NULL;
+    id->count = id->size = 0;
+}
+
@@ -0,0 +1,144 @@
+#ifndef INC_manifesth
+#define INC_manifesth
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        manifest.h
+
+  PURPOSE:
+        Define the file content manifest API.
+        A manifest maps a file path to its size, mtime and a 64-bit content
+        hash so the publishing daemons can tell a rewritten file from a
+        changed one.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        htmlgend publishes WVIEW_RUN_DIR/HTML_MANIFEST_FILE after every
+        generation cycle; a file is only rehashed when its size or mtime
+        changed since the last scan. The uploaders keep one "sent" manifest
+        per destination holding the hashes of what was last delivered; its
+        header names the destination so a new server starts from scratch.
+
+        File format (a header line, then one entry per line sorted by path):
+            # wview manifest <version> [<destination>]
+            <hash as 16 hex digits> <size> <mtime> <path>
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+//  ... includes
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <string.h>
+
+#include <sysdefs.h>
+
+
+//  ... macro definitions
+
+#define MANIFEST_VERSION            1
+#define MANIFEST_MAX_DEPTH          8           // directory recursion limit
+
+
+//  ... typedefs
+
+typedef struct
+{
+    char            path[_MAX_PATH];
+    off_t           size;
+    time_t          mtime;
+    ULONGLONG       hash;
+    int             seen;                       // found by the last scan
+} MANIFEST_ENTRY;
+
+typedef struct
+{
+    MANIFEST_ENTRY  *entries;                   // sorted by path
+    int             count;
+    int             size;
+    time_t          fileTime;                   // mtime of the file loaded
+    int             rehashed;                   // by the last manifestUpdate
+    char            destination[_MAX_PATH];     // sent manifests only
+} MANIFEST, *MANIFEST_ID;
+
+// called for each regular file found by manifestWalk;
+// 'relPath' is relative to the walk directory
+typedef void (*MANIFEST_WALK_FUNC)
+(
+    const char      *path,
+    const char      *relPath,
+    struct stat     *fileStat,
+    void            *context
+);
+
+
+//  ... API methods
+
+// 'destination' identifies the server for a sent manifest, NULL otherwise
+extern void manifestInit (MANIFEST_ID id, const char *destination);
+
+// (re)load 'file' if it changed since the last load; a missing file or one
+// for another destination leaves the manifest empty; returns OK or ERROR
+extern int manifestLoad (MANIFEST_ID id, const char *file);
+
+// write 'file' atomically (temp file + rename); returns OK or ERROR
+extern int manifestSave (MANIFEST_ID id, const char *file);
+
+// returns the entry for 'path' or NULL
+extern MANIFEST_ENTRY *manifestFind (MANIFEST_ID id, const char *path);
+
+// add or update the entry for 'path'; returns OK or ERROR
+extern int manifestSet
+(
+    MANIFEST_ID     id,
+    const char      *path,
+    off_t           size,
+    time_t          mtime,
+    ULONGLONG       hash
+);
+
+// remove all entries
+extern void manifestClear (MANIFEST_ID id);
+
+// compute the FNV-1a 64-bit hash of a file's content; returns OK or ERROR
+extern int manifestHashFile (const char *path, ULONGLONG *hash);
+
+// get the content hash of 'path': from 'published' if its entry matches the
+// current size and mtime, otherwise by hashing the file; returns OK or ERROR
+extern int manifestGetHash
+(
+    MANIFEST_ID     published,
+    const char      *path,
+    struct stat     *fileStat,
+    ULONGLONG       *hash
+);
+
+// call 'func' for every regular file below 'directory' (symlinks are
+// followed, dot files skipped); paths passed to 'func' are real paths;
+// returns the number of files or ERROR
+extern int manifestWalk
+(
+    const char          *directory,
+    MANIFEST_WALK_FUNC  func,
+    void                *context
+);
+
+// rescan 'directory': rehash new or modified files and drop entries for
+// files that no longer exist; returns the number rehashed or ERROR
+extern int manifestUpdate (MANIFEST_ID id, const char *directory);
+
+extern void manifestExit (MANIFEST_ID id);
+
+#endif
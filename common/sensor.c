@@ -461,25 +461,54 @@ float sensorGetWindRun (SENSOR_TIMEFRAMES frame, WV_SENSOR *sensor)
     return retVal;
 }
 
+//  ... accumulator ring utilities
+
+#define ACCUM_BUCKET(id,seq)        (&(id)->buckets[(seq) % (id)->numBuckets])
+
+static void ClearBucket (WV_ACCUM_BUCKET *bucket)
+{
+    bucket->sum     = 0;
+    bucket->count   = 0;
+}
+
+static void DropOldestBucket (WV_ACCUM_ID id)
+{
+    WV_ACCUM_BUCKET     *bucket = ACCUM_BUCKET(id, id->oldestBucket);
+
+    id->sum     -= bucket->sum;
+    id->samples -= bucket->count;
+    ClearBucket (bucket);
+    id->oldestBucket ++;
+}
+
+static void ResetAccumulator (WV_ACCUM_ID id)
+{
+    int                 i;
+
+    for (i = 0; i < id->numBuckets; i ++)
+    {
+        ClearBucket (&id->buckets[i]);
+    }
+
+    // start over with an exact zero so float error cannot accumulate:
+    id->samples = 0;
+    id->sum = 0;
+}
+
 static void AgeAccumulator (WV_ACCUM_ID id)
 {
-    WV_ACCUM_SAMPLE     *nodePtr, *oldPtr;
-    time_t              nowTime = time(NULL);
+    time_t              cutoff = time(NULL) - id->secondsInAccumulator;
 
-    for (nodePtr = (WV_ACCUM_SAMPLE*)radListGetLast (&id->samples);
-         nodePtr != NULL;
-         nodePtr = (WV_ACCUM_SAMPLE*)radListGetLast (&id->samples))
+    // a bucket is aged off once its newest possible sample time is expired:
+    while (id->samples > 0 &&
+           ((id->oldestBucket + 1) * id->secondsInBucket) - 1 <= cutoff)
     {
-        if ((nowTime - id->secondsInAccumulator) >= nodePtr->sampleTime)
-        {
-            // remove and free him
-            oldPtr = (WV_ACCUM_SAMPLE*)radListRemoveLast (&id->samples);
-            radBufferRls (oldPtr);
-        }
-        else
-        {
-            break;
-        }
+        DropOldestBucket (id);
+    }
+
+    if (id->samples <= 0)
+    {
+        ResetAccumulator (id);
     }
 }
 
@@ -492,71 +521,110 @@ WV_ACCUM_ID sensorAccumInit (int minutesInAccumulator)
     {
         return NULL;
     }
+    memset (newId, 0, sizeof (*newId));
 
-    radListReset (&newId->samples);
     newId->secondsInAccumulator = minutesInAccumulator * 60;
-    newId->sum = 0;
+    newId->secondsInBucket = (newId->secondsInAccumulator + WV_ACCUM_MAX_BUCKETS - 1) /
+                             WV_ACCUM_MAX_BUCKETS;
+    if (newId->secondsInBucket < 1)
+    {
+        newId->secondsInBucket = 1;
+    }
+
+    // one extra bucket for the partial bucket at each end of the window:
+    newId->numBuckets = (newId->secondsInAccumulator / newId->secondsInBucket) + 2;
+
+    newId->buckets = (WV_ACCUM_BUCKET *)malloc (newId->numBuckets * sizeof(WV_ACCUM_BUCKET));
+    if (newId->buckets == NULL)
+    {
+        radBufferRls (newId);
+        return NULL;
+    }
+
+    ResetAccumulator (newId);
     return newId;
 }
 
 void sensorAccumExit (WV_ACCUM_ID id)
 {
-    WV_ACCUM_SAMPLE*    nodePtr;
-
-    for (nodePtr = (WV_ACCUM_SAMPLE*)radListRemoveFirst (&id->samples);
-         nodePtr != NULL;
-         nodePtr = (WV_ACCUM_SAMPLE*)radListRemoveFirst (&id->samples))
-    {
-        radBufferRls (nodePtr);
-    }
+    if (id->buckets != NULL)
+        free (id->buckets);
     radBufferRls (id);
 }
 
 void sensorAccumAddSample (WV_ACCUM_ID id, time_t timeStamp, float value)
 {
-    WV_ACCUM_SAMPLE*    newNode;
+    WV_ACCUM_BUCKET*    bucket;
+    long                seq = (long)(timeStamp / id->secondsInBucket);
+    long                next;
 
-    newNode = (WV_ACCUM_SAMPLE*)radBufferGet (sizeof(WV_ACCUM_SAMPLE));
-    if (newNode == NULL)
+    if (id->samples == 0)
     {
-        return;
+        id->oldestBucket = id->newestBucket = seq;
+    }
+    else if (seq > id->newestBucket)
+    {
+        if (seq - id->newestBucket >= id->numBuckets)
+        {
+            // everything we have is older than the ring can hold:
+            ResetAccumulator (id);
+            id->oldestBucket = seq;
+        }
+        else
+        {
+            // make room for the new bucket:
+            while (seq - id->oldestBucket >= id->numBuckets)
+            {
+                DropOldestBucket (id);
+            }
+            if (id->samples == 0)
+            {
+                ResetAccumulator (id);
+                id->oldestBucket = seq;
+            }
+        }
+        id->newestBucket = seq;
+    }
+    else if (seq < id->oldestBucket)
+    {
+        if (id->newestBucket - seq >= id->numBuckets)
+        {
+            // too old to fit in the ring, it would be aged off anyway
+            return;
+        }
+        for (next = id->oldestBucket - 1; next >= seq; next --)
+        {
+            ClearBucket (ACCUM_BUCKET(id, next));
+        }
+        id->oldestBucket = seq;
     }
 
-    newNode->value      = value;
-    newNode->sampleTime = timeStamp;
-    radListAddToFront (&id->samples, (NODE_PTR)newNode);
+    bucket = ACCUM_BUCKET(id, seq);
+    bucket->sum += value;
+    bucket->count ++;
+
+    id->sum += value;
+    id->samples ++;
 
-    // Do we need to age off any nodes?
+    // Do we need to age off any buckets?
     AgeAccumulator (id);
 }
 
 float sensorAccumGetTotal (WV_ACCUM_ID id)
 {
-    WV_ACCUM_SAMPLE*    nodePtr;
-    float               sum = 0;
-
-    // Do we need to age off any nodes?
+    // Do we need to age off any buckets?
     AgeAccumulator (id);
 
-    for (nodePtr = (WV_ACCUM_SAMPLE*)radListGetFirst (&id->samples);
-         nodePtr != NULL;
-         nodePtr = (WV_ACCUM_SAMPLE*)radListGetNext (&id->samples, (NODE_PTR)nodePtr))
-    {
-        sum += nodePtr->value;
-    }
-
-    return sum;
+    return (float)id->sum;
 }
 
 float sensorAccumGetAverage (WV_ACCUM_ID id)
 {
-    float               samples, sum;
+    AgeAccumulator (id);
 
-    sum = sensorAccumGetTotal(id);
-    samples = (float)radListGetNumberOfNodes(&id->samples);
-    if (samples > 0)
+    if (id->samples > 0)
     {
-        return (sum/samples);
+        return (float)(id->sum/id->samples);
     }
     else
     {
@@ -55,19 +55,30 @@
 
 //  ... typedefs
 
-// sample accumulator with time decay
+// sample accumulator with time decay:
+// samples are summed into a fixed ring of time buckets (at most
+// WV_ACCUM_MAX_BUCKETS) and a running total is kept, so adding, aging and
+// reading the total are O(1) amortized regardless of the sample rate;
+// the aging resolution is one bucket (1 second for accumulators up to 24
+// minutes, scaling up with the accumulator length)
+#define WV_ACCUM_MAX_BUCKETS            1440
+
 typedef struct
 {
-    NODE                node;
-    float               value;
-    time_t              sampleTime;
-} WV_ACCUM_SAMPLE;
+    float               sum;
+    int                 count;
+} WV_ACCUM_BUCKET;
 
 typedef struct
 {
-    RADLIST             samples;
+    WV_ACCUM_BUCKET     *buckets;
+    int                 numBuckets;
+    int                 secondsInBucket;
     int                 secondsInAccumulator;
-    float               sum;
+    long                oldestBucket;           // bucket sequence numbers
+    long                newestBucket;
+    int                 samples;
+    double              sum;
 } WV_ACCUM, *WV_ACCUM_ID;
 
 
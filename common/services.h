@@ -11,6 +11,8 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         08/24/03        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Wind windows in the
+                                                        archive notification
  
   NOTES:
  
@@ -159,6 +161,9 @@ typedef struct
     int             rainDay;
     int             dewpoint;
     int             rxPercent;
+    int             winddir2min;        // the LOOP wind windows (windStats.c)
+    int             wspeed2min;
+    int             hiwspeed10min;
 
 }
 __attribute__ ((packed)) WVIEW_MSG_ARCHIVE_NOTIFY;
@@ -9,9 +9,17 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         12/27/2009      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Add metrics segment
  
   NOTES:
-        
+        The segment has a single writer (the owning process). Counters and
+        histograms are updated with atomic operations; the message is
+        guarded by a sequence count which readers check around their copy.
+
+        A counter change starts a one-shot timer (if it is not already
+        running) that rewrites the status file, so the file trails the
+        segment by at most STATUS_FILE_INTERVAL however often the counters
+        change.
  
   LICENSE:
         Copyright (c) 2009, Mark S. Teel (mark@teel.ws)
@@ -22,49 +30,122 @@
 ----------------------------------------------------------------------------*/
 
 //  ... System header files
+#include <errno.h>
+#include <fcntl.h>
 #include <radmsgLog.h>
+#include <radtimers.h>
 
 
 //  ... Local header files
 #include <status.h>
 
+//  ... Local definitions:
+
+#define STATUS_READ_RETRIES         10
+#define STATUS_FILE_INTERVAL        10000       // ms
+
 //  ... Local memory:
 
 static STATUS_INFO          ProcessStatus;
+static TIMER_ID             FileTimer;
+static int                  FileTimerRunning;
+static int                  FileDirty;
 
 
 static int WriteStatusFile(void)
 {
     FILE*       statfile;
-    int         index;
+    char        temp[_MAX_PATH+8];
 
-    statfile = fopen (ProcessStatus.filePath, "w");
+    FileDirty = FALSE;
+
+    // write a new copy and rename it so readers never see a partial file:
+    sprintf (temp, "%s.tmp", ProcessStatus.filePath);
+    statfile = fopen (temp, "w");
     if (statfile == NULL)
     {
         radMsgLog (PRI_HIGH, "status file create failed!");
         return ERROR;
     }
 
-    fprintf (statfile, "status = %d\n", ProcessStatus.status);
-    if (strlen(ProcessStatus.lastMessage) > 0)
+    statusSegmentRender (ProcessStatus.segment, statfile, FALSE);
+    fclose (statfile);
+
+    if (rename (temp, ProcessStatus.filePath) != 0)
     {
-        fprintf (statfile, "message = \"%s\"\n", ProcessStatus.lastMessage);
+        radMsgLog (PRI_HIGH, "status file rename failed: %s", strerror(errno));
+        unlink (temp);
+        return ERROR;
     }
 
-    for (index = 0; index < STATUS_STATS_MAX; index ++)
+    return OK;
+}
+
+static void FileTimerHandler(void* parm)
+{
+    FileTimerRunning = FALSE;
+    if (FileDirty)
     {
-        if (ProcessStatus.stat[index] == -1 || 
-            ProcessStatus.statLabel[index][0] == 0)
-        {
-            continue;
-        }
+        WriteStatusFile();
+    }
+}
 
-        fprintf (statfile, "desc%d = \"%s\"\n", index, ProcessStatus.statLabel[index]);
-        fprintf (statfile, "stat%d = %d\n", index, ProcessStatus.stat[index]);
+// a counter changed; have the timer bring the status file up to date:
+static void MarkFileDirty(void)
+{
+    FileDirty = TRUE;
+    if (FileTimer != NULL && ! FileTimerRunning)
+    {
+        FileTimerRunning = TRUE;
+        radTimerStart(FileTimer, STATUS_FILE_INTERVAL);
     }
+}
 
-    fclose (statfile);
-    return OK;
+static STATUS_SEGMENT* CreateSegment(const char* segmentPath)
+{
+    STATUS_SEGMENT* segment;
+    int             fd;
+
+    // start with a new file so readers still mapping the old one are safe:
+    unlink (segmentPath);
+    fd = open (segmentPath, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd == -1)
+    {
+        radMsgLog (PRI_HIGH, "status segment %s create failed: %s",
+                   segmentPath, strerror(errno));
+        return NULL;
+    }
+
+    if (ftruncate (fd, sizeof(STATUS_SEGMENT)) != 0)
+    {
+        radMsgLog (PRI_HIGH, "status segment %s size failed: %s",
+                   segmentPath, strerror(errno));
+        close (fd);
+        unlink (segmentPath);
+        return NULL;
+    }
+
+    segment = (STATUS_SEGMENT*)mmap (NULL, sizeof(STATUS_SEGMENT),
+                                     PROT_READ | PROT_WRITE, MAP_SHARED,
+                                     fd, 0);
+    close (fd);
+    if (segment == MAP_FAILED)
+    {
+        radMsgLog (PRI_HIGH, "status segment %s mmap failed: %s",
+                   segmentPath, strerror(errno));
+        unlink (segmentPath);
+        return NULL;
+    }
+
+    memset (segment, 0, sizeof(STATUS_SEGMENT));
+    segment->version = STATUS_SEGMENT_VERSION;
+    segment->size    = sizeof(STATUS_SEGMENT);
+    segment->pid     = getpid();
+
+    // readers check the magic number last:
+    __sync_synchronize();
+    segment->magic   = STATUS_SEGMENT_MAGIC;
+    return segment;
 }
 
 //  ... API methods:
@@ -102,6 +183,13 @@ int statusInit(const char* filePath, char* statLabel[4])
 
     memset(&ProcessStatus, 0, sizeof(ProcessStatus));
     wvstrncpy(ProcessStatus.filePath, filePath, _MAX_PATH);
+    statusSegmentPath(filePath, ProcessStatus.segmentPath);
+
+    ProcessStatus.segment = CreateSegment(ProcessStatus.segmentPath);
+    if (ProcessStatus.segment == NULL)
+    {
+        return ERROR;
+    }
 
     for (index = 0; index < STATUS_STATS_MAX; index ++)
     {
@@ -109,12 +197,21 @@ int statusInit(const char* filePath, char* statLabel[4])
             statLabel[index] == NULL || statLabel[index][0] == 0)
         {
             // skip this one:
-            ProcessStatus.stat[index] = -1;
-            ProcessStatus.statLabel[index][0] = 0;
+            continue;
         }
 
-        ProcessStatus.stat[index] = 0;
-        wvstrncpy(ProcessStatus.statLabel[index], statLabel[index], 64);
+        wvstrncpy(ProcessStatus.segment->statLabel[index], statLabel[index],
+                  STATUS_LABEL_LENGTH);
+    }
+
+    FileTimerRunning = FALSE;
+    FileDirty = FALSE;
+    FileTimer = radTimerCreate(NULL, FileTimerHandler, NULL);
+    if (FileTimer == NULL)
+    {
+        radMsgLog (PRI_MEDIUM, "status: radTimerCreate failed - "
+                               "%s only updated on status changes",
+                   ProcessStatus.filePath);
     }
 
     return OK;
@@ -123,7 +220,12 @@ int statusInit(const char* filePath, char* statLabel[4])
 //  ... send a status update:
 int statusUpdate(STATUS_TYPE status)
 {
-    ProcessStatus.status = status;
+    if (ProcessStatus.segment == NULL)
+    {
+        return ERROR;
+    }
+
+    ProcessStatus.segment->status = status;
     WriteStatusFile();
     return OK;
 }
@@ -131,7 +233,19 @@ int statusUpdate(STATUS_TYPE status)
 //  ... send a status update:
 int statusUpdateMessage(const char* message)
 {
-    wvstrncpy(ProcessStatus.lastMessage, message, _MAX_PATH);
+    STATUS_SEGMENT* segment = ProcessStatus.segment;
+
+    if (segment == NULL)
+    {
+        return ERROR;
+    }
+
+    segment->messageSequence ++;
+    __sync_synchronize();
+    wvstrncpy(segment->message, message, _MAX_PATH);
+    __sync_synchronize();
+    segment->messageSequence ++;
+
     WriteStatusFile();
     return OK;
 }
@@ -140,13 +254,16 @@ int statusUpdateMessage(const char* message)
 int statusUpdateStat(int index, int value)
 {
     if (0 > index || index >= STATUS_STATS_MAX ||
-        ProcessStatus.stat[index] == -1)
+        ProcessStatus.segment == NULL)
     {
         return ERROR;
     }
 
-    ProcessStatus.stat[index] = value;
-    WriteStatusFile();
+    if (ProcessStatus.segment->stat[index] != value)
+    {
+        ProcessStatus.segment->stat[index] = value;
+        MarkFileDirty();
+    }
     return OK;
 }
 
@@ -154,13 +271,13 @@ int statusUpdateStat(int index, int value)
 int statusIncrementStat(int index)
 {
     if (0 > index || index >= STATUS_STATS_MAX ||
-        ProcessStatus.stat[index] == -1)
+        ProcessStatus.segment == NULL)
     {
         return ERROR;
     }
 
-    ProcessStatus.stat[index] ++;
-    WriteStatusFile();
+    __sync_fetch_and_add(&ProcessStatus.segment->stat[index], 1);
+    MarkFileDirty();
     return OK;
 }
 
@@ -168,14 +285,241 @@ int statusIncrementStat(int index)
 // Do not allow the value to be negative:
 int statusDecrementStat(int index)
 {
+    int             value;
+
     if (0 > index || index >= STATUS_STATS_MAX ||
-        ProcessStatus.stat[index] <= 0)
+        ProcessStatus.segment == NULL)
     {
         return ERROR;
     }
 
-    ProcessStatus.stat[index] --;
-    WriteStatusFile();
+    do
+    {
+        value = ProcessStatus.segment->stat[index];
+        if (value <= 0)
+        {
+            return ERROR;
+        }
+    } while (! __sync_bool_compare_and_swap(&ProcessStatus.segment->stat[index],
+                                            value, value - 1));
+
+    MarkFileDirty();
+    return OK;
+}
+
+int statusHistogramInit
+(
+    int             index,
+    const char*     name,
+    const int       limit[STATUS_HISTOGRAM_BINS - 1]
+)
+{
+    STATUS_HISTOGRAM*   hist;
+
+    if (0 > index || index >= STATUS_HISTOGRAMS_MAX ||
+        ProcessStatus.segment == NULL || name == NULL || name[0] == 0)
+    {
+        return ERROR;
+    }
+
+    hist = &ProcessStatus.segment->histogram[index];
+    memset (hist, 0, sizeof(*hist));
+    memcpy (hist->limit, limit, sizeof(hist->limit));
+
+    // readers skip histograms without a name:
+    __sync_synchronize();
+    wvstrncpy(hist->name, name, STATUS_LABEL_LENGTH);
+    return OK;
+}
+
+int statusHistogramAdd(int index, int value)
+{
+    STATUS_HISTOGRAM*   hist;
+    int                 bin, max;
+
+    if (0 > index || index >= STATUS_HISTOGRAMS_MAX ||
+        ProcessStatus.segment == NULL)
+    {
+        return ERROR;
+    }
+
+    hist = &ProcessStatus.segment->histogram[index];
+    if (hist->name[0] == 0)
+    {
+        return ERROR;
+    }
+
+    for (bin = 0; bin < STATUS_HISTOGRAM_BINS - 1; bin ++)
+    {
+        if (value <= hist->limit[bin])
+        {
+            break;
+        }
+    }
+
+    __sync_fetch_and_add(&hist->count[bin], 1);
+    __sync_fetch_and_add(&hist->samples, 1);
+    hist->last = value;
+
+    do
+    {
+        max = hist->max;
+        if (value <= max)
+        {
+            break;
+        }
+    } while (! __sync_bool_compare_and_swap(&hist->max, max, value));
+
+    return OK;
+}
+
+
+//  ... reader API:
+
+void statusSegmentPath(const char* filePath, char* segmentPath)
+{
+    char*           ext;
+
+    wvstrncpy(segmentPath, filePath, _MAX_PATH - strlen(STATUS_SEGMENT_EXT));
+    ext = strrchr(segmentPath, '.');
+    if (ext != NULL && strcmp(ext, STATUS_FILE_EXT) == 0)
+    {
+        *ext = 0;
+    }
+    strcat(segmentPath, STATUS_SEGMENT_EXT);
+}
+
+STATUS_SEGMENT* statusSegmentAttach(const char* segmentPath)
+{
+    STATUS_SEGMENT* segment;
+    struct stat     fileData;
+    int             fd;
+
+    fd = open (segmentPath, O_RDONLY);
+    if (fd == -1)
+    {
+        return NULL;
+    }
+
+    if (fstat (fd, &fileData) != 0 || fileData.st_size < sizeof(STATUS_SEGMENT))
+    {
+        close (fd);
+        return NULL;
+    }
+
+    segment = (STATUS_SEGMENT*)mmap (NULL, sizeof(STATUS_SEGMENT), PROT_READ,
+                                     MAP_SHARED, fd, 0);
+    close (fd);
+    if (segment == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    if (segment->magic != STATUS_SEGMENT_MAGIC ||
+        segment->version != STATUS_SEGMENT_VERSION ||
+        segment->size != sizeof(STATUS_SEGMENT))
+    {
+        munmap (segment, sizeof(STATUS_SEGMENT));
+        return NULL;
+    }
+
+    __sync_synchronize();
+    return segment;
+}
+
+void statusSegmentDetach(STATUS_SEGMENT* segment)
+{
+    if (segment != NULL)
+    {
+        munmap (segment, sizeof(STATUS_SEGMENT));
+    }
+}
+
+int statusSegmentRender
+(
+    STATUS_SEGMENT* segment,
+    FILE*           out,
+    int             withHistograms
+)
+{
+    STATUS_HISTOGRAM*   hist;
+    char                message[_MAX_PATH];
+    int                 index, bin, sequence, retries;
+
+    if (segment == NULL)
+    {
+        return ERROR;
+    }
+
+    // copy the message while it is not being changed:
+    message[0] = 0;
+    for (retries = 0; retries < STATUS_READ_RETRIES; retries ++)
+    {
+        sequence = segment->messageSequence;
+        __sync_synchronize();
+        if (sequence & 1)
+        {
+            usleep (1000);
+            continue;
+        }
+
+        memcpy (message, segment->message, _MAX_PATH);
+        message[_MAX_PATH-1] = 0;
+        __sync_synchronize();
+        if (segment->messageSequence == sequence)
+        {
+            break;
+        }
+    }
+    if (retries == STATUS_READ_RETRIES)
+    {
+        message[0] = 0;
+    }
+
+    fprintf (out, "status = %d\n", segment->status);
+    if (strlen(message) > 0)
+    {
+        fprintf (out, "message = \"%s\"\n", message);
+    }
+
+    for (index = 0; index < STATUS_STATS_MAX; index ++)
+    {
+        if (segment->statLabel[index][0] == 0)
+        {
+            continue;
+        }
+
+        fprintf (out, "desc%d = \"%s\"\n", index, segment->statLabel[index]);
+        fprintf (out, "stat%d = %d\n", index, segment->stat[index]);
+    }
+
+    if (! withHistograms)
+    {
+        return OK;
+    }
+
+    for (index = 0; index < STATUS_HISTOGRAMS_MAX; index ++)
+    {
+        hist = &segment->histogram[index];
+        if (hist->name[0] == 0)
+        {
+            continue;
+        }
+
+        fprintf (out, "hist%d = \"%s\"\n", index, hist->name);
+        fprintf (out, "hist%d_samples = %d\n", index, hist->samples);
+        fprintf (out, "hist%d_last = %d\n", index, hist->last);
+        fprintf (out, "hist%d_max = %d\n", index, hist->max);
+        fprintf (out, "hist%d_bins = \"", index);
+        for (bin = 0; bin < STATUS_HISTOGRAM_BINS - 1; bin ++)
+        {
+            fprintf (out, "<=%d:%d ", hist->limit[bin], hist->count[bin]);
+        }
+        fprintf (out, ">%d:%d\"\n",
+                 hist->limit[STATUS_HISTOGRAM_BINS - 2],
+                 hist->count[STATUS_HISTOGRAM_BINS - 1]);
+    }
+
     return OK;
 }
 
@@ -11,9 +11,15 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         12/27/2009      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Add metrics segment
  
   NOTES:
-        
+        Each process keeps its status in a memory mapped STATUS_SEGMENT
+        (WVIEW_STATUS_DIRECTORY/<name>.met) so counter updates are a single
+        atomic operation instead of a status file rewrite. The text status
+        file (<name>.sts) is rewritten when the status or message changes
+        and, at most every 10 seconds, after counter changes; wvstatus
+        renders any segment in the same format on demand.
  
   LICENSE:
         Copyright (c) 2009, Mark S. Teel (mark@teel.ws)
@@ -34,6 +40,7 @@
 #include <signal.h>
 #include <math.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 
 #include <sysdefs.h>
 #include <services.h>
@@ -42,6 +49,14 @@
 //  ... definitions
 
 #define STATUS_STATS_MAX        4
+#define STATUS_LABEL_LENGTH     64
+#define STATUS_HISTOGRAMS_MAX   4
+#define STATUS_HISTOGRAM_BINS   8
+
+#define STATUS_SEGMENT_MAGIC    0x77765354          // "wvST"
+#define STATUS_SEGMENT_VERSION  1
+#define STATUS_SEGMENT_EXT      ".met"
+#define STATUS_FILE_EXT         ".sts"
 
 typedef enum
 {
@@ -53,19 +68,44 @@ typedef enum
     STATUS_ERROR
 } STATUS_TYPE;
     
+// Samples are counted in the first bin whose upper bound 'limit' they do not
+// exceed, the last bin counts everything larger:
+typedef struct
+{
+    char            name[STATUS_LABEL_LENGTH];  // empty if not in use
+    int             limit[STATUS_HISTOGRAM_BINS - 1];
+    volatile int    count[STATUS_HISTOGRAM_BINS];
+    volatile int    samples;
+    volatile int    last;
+    volatile int    max;
+} STATUS_HISTOGRAM;
+
+// The fixed layout shared with readers; only the owning process writes it:
+typedef struct
+{
+    int             magic;
+    int             version;
+    int             size;
+    int             pid;
+    volatile int    status;
+    volatile int    messageSequence;            // odd while being changed
+    char            message[_MAX_PATH];
+    volatile int    stat[STATUS_STATS_MAX];
+    char            statLabel[STATUS_STATS_MAX][STATUS_LABEL_LENGTH];
+    STATUS_HISTOGRAM histogram[STATUS_HISTOGRAMS_MAX];
+} STATUS_SEGMENT;
+
 typedef struct
 {
     char            filePath[_MAX_PATH];
-    STATUS_TYPE     status;
-    char            lastMessage[_MAX_PATH];
-    int             stat[STATUS_STATS_MAX];
-    char            statLabel[STATUS_STATS_MAX][64];
+    char            segmentPath[_MAX_PATH];
+    STATUS_SEGMENT  *segment;
 } STATUS_INFO;
 
 
 //  ... API prototypes
 
-//  ... initialize the status log:
+//  ... initialize the status log and create the metrics segment:
 extern int statusInit(const char* filePath, char* statLabel[STATUS_STATS_MAX]);
 
 //  ... send a status update:
@@ -82,6 +122,36 @@ extern int statusIncrementStat(int index);
 // Does not allow the value to be negative:
 extern int statusDecrementStat(int index);
 
-#endif
+//  ... define a histogram; 'limit' holds the ascending upper bounds of the
+//  ... first STATUS_HISTOGRAM_BINS-1 bins:
+extern int statusHistogramInit
+(
+    int             index,
+    const char*     name,
+    const int       limit[STATUS_HISTOGRAM_BINS - 1]
+);
 
+//  ... add a sample to a histogram:
+extern int statusHistogramAdd(int index, int value);
 
+
+//  ... reader API:
+
+//  ... build the segment path for a status file path (.sts -> .met):
+extern void statusSegmentPath(const char* filePath, char* segmentPath);
+
+//  ... map a segment read-only; returns NULL if it is missing or invalid:
+extern STATUS_SEGMENT* statusSegmentAttach(const char* segmentPath);
+
+extern void statusSegmentDetach(STATUS_SEGMENT* segment);
+
+//  ... render a segment in the status file format, optionally followed by
+//  ... the histograms; returns OK or ERROR:
+extern int statusSegmentRender
+(
+    STATUS_SEGMENT* segment,
+    FILE*           out,
+    int             withHistograms
+);
+
+#endif
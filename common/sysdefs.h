@@ -96,35 +96,45 @@
 #define CWOP_LOCK_FILE_NAME             "wvcwopd.pid"
 #define HTTP_LOCK_FILE_NAME             "wvhttpd.pid"
 #define PMON_LOCK_FILE_NAME             "wvpmond.pid"
+#define EXPORT_LOCK_FILE_NAME           "wvexportd.pid"
 
 #define PROC_NAME_DAEMON                "wviewd"
 #define PROC_NUM_TIMERS_DAEMON          5
 
 #define PROC_NAME_HTML                  "htmlgend"
-#define PROC_NUM_TIMERS_HTML            3
+#define PROC_NUM_TIMERS_HTML            5
 #define HTML_GRAPHICS_CONFIG_FILENAME   "graphics.conf"
 #define HTML_PRE_GEN_SCRIPT             "pre-generate.sh"
 #define HTML_POST_GEN_SCRIPT            "post-generate.sh"
+#define HTML_MANIFEST_FILE              "html_manifest"
 
 #define PROC_NAME_FTP                   "wviewftpd"
 #define PROC_NUM_TIMERS_FTP             1
-#define FTP_MARKER_FILE                 "ftp_marker"
+#define FTP_MANIFEST_FILE               "ftp_manifest"
 
 #define PROC_NAME_SSH                   "wviewsshd"
 #define PROC_NUM_TIMERS_SSH             1
+#define SSH_MANIFEST_FILE               "ssh_manifest"
+#define SSH_FILES_FROM_FILE             "ssh_files"
+#define SSH_CONTROL_FILE                "ssh_master"
+#define SSH_STAGE_DIR                   "ssh_stage"
 
 #define PROC_NAME_ALARMS                "wvalarmd"
 #define PROC_NUM_TIMERS_ALARMS          0
 
 #define PROC_NAME_CWOP                  "wvcwopd"
-#define PROC_NUM_TIMERS_CWOP            1
+#define PROC_NUM_TIMERS_CWOP            2
 
 #define PROC_NAME_HTTP                  "wvhttpd"
-#define PROC_NUM_TIMERS_HTTP            0
+#define PROC_NUM_TIMERS_HTTP            1
+#define HTTP_RETRY_FILE                 "http_retry"
 
 #define PROC_NAME_PMON                  "wvpmond"
 #define PROC_NUM_TIMERS_PMON            2
 
+#define PROC_NAME_EXPORT                "wvexportd"
+#define PROC_NUM_TIMERS_EXPORT          1
+
 #define WVIEW_STATUS_DIRECTORY          "/var/run/wview"
 #define WVIEW_STATUS_FILE_NAME          "wview.sts"
 #define HTML_STATUS_FILE_NAME           "html.sts"
@@ -134,6 +144,12 @@
 #define CWOP_STATUS_FILE_NAME           "cwop.sts"
 #define HTTP_STATUS_FILE_NAME           "http.sts"
 #define PMON_STATUS_FILE_NAME           "pmon.sts"
+#define PMON_HEALTH_FILE_NAME           "pmon.health"
+#define EXPORT_STATUS_FILE_NAME         "export.sts"
+
+// status histograms read by wvpmond:
+#define HTML_HISTOGRAM_GENERATE_MS      0
+#define ALARMS_HISTOGRAM_BACKLOG        0
 
 
 // define all wview events here for consistency
@@ -209,7 +225,8 @@ enum _verbosity_bits
     WV_VERBOSE_WVIEWSSHD    = 0x10,
     WV_VERBOSE_WVCWOPD      = 0x20,
     WV_VERBOSE_WVWUNDERD    = 0x40,
-    WV_VERBOSE_ALL          = 0x7F
+    WV_VERBOSE_WVEXPORTD    = 0x80,
+    WV_VERBOSE_ALL          = 0xFF
 };
     
 // wvconfigInit() must have been called before calling this:
@@ -363,6 +380,28 @@ extern int wvutilsIsDayTime (short timeSunrise, short timeSunset);
 //  return a string indicating the moon phase:
 extern char *lunarPhaseGet (char *increase, char *decrease, char *full);
 
+//  return the moon phase in percent illuminated for the local date and hour,
+//  negative when waning:
+extern double lunarPhaseCompute (int year, int month, int day, int hour);
+
+//  return the lunarPhaseGet string for 'phase':
+extern char *lunarPhaseFormat (double phase, char *increase, char *decrease, char *full);
+
+//  compute moonrise and moonset as packed times (see lunarCycle.c):
+extern int GetMoonRiseSetTimes
+(
+    int         year,
+    int         month,
+    int         day,
+    double      zone,
+    double      lat,
+    double      lon,
+    short       *packedRise,
+    double      *riseAz,
+    short       *packedSet,
+    double      *setAz
+);
+
 
 // Path utilities:
 extern char* wvutilsGetArchivePath(void);
@@ -0,0 +1,235 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        windStats.c
+
+  PURPOSE:
+        Provide the sliding window wind statistics API methods.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+//  ... System header files
+#include <radmsgLog.h>
+
+
+//  ... Local header files
+#include <windStats.h>
+
+
+#define WSTATS_DEG_TO_RAD           (M_PI/180.0)
+#define WSTATS_BUCKET(id,seq)       (&(id)->buckets[(seq) % WSTATS_NUM_BUCKETS])
+
+
+//  ... local utilities
+
+static void ClearBucket (WSTATS_BUCKET *bucket)
+{
+    memset (bucket, 0, sizeof (*bucket));
+}
+
+static void Reset (WSTATS_ID id)
+{
+    int         seconds = id->windowSeconds;
+
+    // start over with exact zeros so float error cannot accumulate:
+    memset (id, 0, sizeof (*id));
+    id->windowSeconds = seconds;
+}
+
+static void DropOldestBucket (WSTATS_ID id)
+{
+    WSTATS_BUCKET   *bucket = WSTATS_BUCKET(id, id->oldestBucket);
+
+    id->samples     -= bucket->count;
+    id->speedSum    -= bucket->speedSum;
+    id->u           -= bucket->u;
+    id->v           -= bucket->v;
+    id->unitU       -= bucket->unitU;
+    id->unitV       -= bucket->unitV;
+    ClearBucket (bucket);
+    id->oldestBucket ++;
+
+    if (id->gustCount > 0 && id->gustQueue[id->gustFirst] < id->oldestBucket)
+    {
+        id->gustFirst = (id->gustFirst + 1) % WSTATS_NUM_BUCKETS;
+        id->gustCount --;
+    }
+}
+
+static void Age (WSTATS_ID id, time_t now)
+{
+    long        cutoff = (long)now - id->windowSeconds;
+
+    while (id->samples > 0 && id->oldestBucket <= cutoff)
+    {
+        DropOldestBucket (id);
+    }
+
+    if (id->samples <= 0)
+    {
+        Reset (id);
+    }
+}
+
+// The newest bucket's gust can only grow, so drop any queued buckets it
+// now dominates (including its own previous entry) and append it:
+static void PushGust (WSTATS_ID id, long seq)
+{
+    USHORT      gust = WSTATS_BUCKET(id, seq)->gust;
+    long        back;
+
+    while (id->gustCount > 0)
+    {
+        back = id->gustQueue[(id->gustFirst + id->gustCount - 1) % WSTATS_NUM_BUCKETS];
+        if (WSTATS_BUCKET(id, back)->gust > gust)
+            break;
+        id->gustCount --;
+    }
+
+    id->gustQueue[(id->gustFirst + id->gustCount) % WSTATS_NUM_BUCKETS] = seq;
+    id->gustCount ++;
+}
+
+
+//  ... define methods here
+
+void windStatsInit (WSTATS_ID id, int seconds)
+{
+    if (seconds > WSTATS_MAX_SECONDS)
+        seconds = WSTATS_MAX_SECONDS;
+    if (seconds < 1)
+        seconds = 1;
+
+    id->windowSeconds = seconds;
+    Reset (id);
+}
+
+void windStatsAddSample
+(
+    WSTATS_ID   id,
+    time_t      timeStamp,
+    USHORT      speed,
+    USHORT      direction,
+    USHORT      gust,
+    USHORT      gustDirection
+)
+{
+    WSTATS_BUCKET   *bucket;
+    long            seq = (long)timeStamp;
+    double          radians;
+
+    if (id->samples > 0 && seq < id->newestBucket)
+    {
+        // LOOP samples arrive in time order; treat a clock step back as
+        // a fresh start
+        Reset (id);
+    }
+
+    Age (id, timeStamp);
+
+    if (id->samples == 0)
+    {
+        id->oldestBucket = id->newestBucket = seq;
+    }
+    id->newestBucket = seq;
+
+    // the station gust can lag the current speed:
+    if (speed > gust)
+    {
+        gust = speed;
+        gustDirection = direction;
+    }
+
+    radians = (double)(direction % 360) * WSTATS_DEG_TO_RAD;
+
+    bucket = WSTATS_BUCKET(id, seq);
+    bucket->count ++;
+    bucket->speedSum    += speed;
+    bucket->u           += speed * sin(radians);
+    bucket->v           += speed * cos(radians);
+    bucket->unitU       += sin(radians);
+    bucket->unitV       += cos(radians);
+    if (bucket->count == 1 || gust >= bucket->gust)
+    {
+        bucket->gust    = gust;
+        bucket->gustDir = gustDirection;
+    }
+
+    id->samples ++;
+    id->speedSum    += speed;
+    id->u           += speed * sin(radians);
+    id->v           += speed * cos(radians);
+    id->unitU       += sin(radians);
+    id->unitV       += cos(radians);
+
+    PushGust (id, seq);
+}
+
+float windStatsGetAvgSpeed (WSTATS_ID id, time_t now)
+{
+    Age (id, now);
+
+    if (id->samples == 0)
+        return 0;
+
+    return (float)(id->speedSum / id->samples);
+}
+
+int windStatsGetAvgDirection (WSTATS_ID id, time_t now)
+{
+    double      u, v, degrees;
+
+    Age (id, now);
+
+    if (id->samples == 0)
+        return 0;
+
+    u = id->u;
+    v = id->v;
+    if (fabs(u) < 0.001 && fabs(v) < 0.001)
+    {
+        // calm - fall back to the vane direction
+        u = id->unitU;
+        v = id->unitV;
+    }
+
+    degrees = atan2(u, v) / WSTATS_DEG_TO_RAD;
+    if (degrees < 0)
+        degrees += 360.0;
+
+    return ((int)(degrees + 0.5) % 360);
+}
+
+int windStatsGetGust (WSTATS_ID id, time_t now)
+{
+    Age (id, now);
+
+    if (id->gustCount == 0)
+        return 0;
+
+    return (int)WSTATS_BUCKET(id, id->gustQueue[id->gustFirst])->gust;
+}
+
+int windStatsGetGustDirection (WSTATS_ID id, time_t now)
+{
+    Age (id, now);
+
+    if (id->gustCount == 0)
+        return 0;
+
+    return (int)WSTATS_BUCKET(id, id->gustQueue[id->gustFirst])->gustDir;
+}
+
@@ -0,0 +1,106 @@
+#ifndef INC_windstatsh
+#define INC_windstatsh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        windStats.h
+
+  PURPOSE:
+        Define the sliding window wind statistics API.
+        Maintains average speed, vector mean direction and peak gust over a
+        fixed trailing window of LOOP samples with O(1) amortized updates.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        Samples are summed into one second buckets held in a ring; running
+        sums give the averages and a monotonic deque of bucket numbers gives
+        the window peak gust without rescanning.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+//  ... includes
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <string.h>
+#include <math.h>
+
+#include <sysdefs.h>
+
+
+//  ... macro definitions
+
+#define WSTATS_MAX_SECONDS          600         // longest supported window
+#define WSTATS_NUM_BUCKETS          (WSTATS_MAX_SECONDS + 1)
+
+#define WSTATS_TWO_MINUTES          120
+#define WSTATS_TEN_MINUTES          600
+
+
+//  ... typedefs
+
+typedef struct
+{
+    float               speedSum;
+    int                 count;
+    float               u;                      // speed weighted east
+    float               v;                      // speed weighted north
+    float               unitU;                  // unweighted (for calm)
+    float               unitV;
+    USHORT              gust;
+    USHORT              gustDir;
+} WSTATS_BUCKET;
+
+typedef struct
+{
+    int                 windowSeconds;
+    WSTATS_BUCKET       buckets[WSTATS_NUM_BUCKETS];
+    long                oldestBucket;           // bucket sequence numbers
+    long                newestBucket;
+    int                 samples;
+    double              speedSum;
+    double              u;
+    double              v;
+    double              unitU;
+    double              unitV;
+    long                gustQueue[WSTATS_NUM_BUCKETS];
+    int                 gustFirst;
+    int                 gustCount;
+} WSTATS, *WSTATS_ID;
+
+
+//  ... API prototypes
+
+// initialize 'id' for a trailing window of 'seconds' (<= WSTATS_MAX_SECONDS)
+extern void windStatsInit (WSTATS_ID id, int seconds);
+
+//  ... add a LOOP sample; direction in degrees [0,359]
+extern void windStatsAddSample
+(
+    WSTATS_ID   id,
+    time_t      timeStamp,
+    USHORT      speed,
+    USHORT      direction,
+    USHORT      gust,
+    USHORT      gustDirection
+);
+
+//  ... window results as of 'now' (0 if no samples in the window):
+extern float windStatsGetAvgSpeed (WSTATS_ID id, time_t now);
+extern int windStatsGetAvgDirection (WSTATS_ID id, time_t now);
+extern int windStatsGetGust (WSTATS_ID id, time_t now);
+extern int windStatsGetGustDirection (WSTATS_ID id, time_t now);
+
+#endif
+
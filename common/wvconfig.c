@@ -9,9 +9,16 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         7/05/2008       M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Cache the config table
  
   NOTES:
-        
+        wvconfigInit loads the whole config table into a hash table with one
+        query; the wvconfigGet* methods read the cache. The cache is kept
+        after wvconfigExit so wvconfigReload can report which items changed.
+
+        The config_version table holds a counter bumped by triggers on every
+        write to the config table (by wviewmgmt, wviewconfig or anything else),
+        so checking for changes is a single one row query.
  
   LICENSE:
         Copyright (c) 2008, Mark S. Teel (mark@teel.ws)
@@ -30,73 +37,219 @@
 #include <wvconfig.h>
 
 
+//  ... Local definitions:
+
+#define WVCONFIG_HASH_SIZE          256
+
+typedef struct _wvconfigItem
+{
+    struct _wvconfigItem*   next;
+    char*                   name;
+    char*                   value;
+    int                     isChanged;
+} WVCONFIG_ITEM;
+
+
 //  ... Local memory:
 static SQLITE_DATABASE_ID   sqliteID;
 
 //  ... Define a semaphore for access control:
 static SEM_ID               wvconfigMutex;
 
+//  ... The config cache:
+static WVCONFIG_ITEM*       configCache[WVCONFIG_HASH_SIZE];
+static int                  configVersion = ERROR;
+
 
 //  ... Local methods
 
-// Query for a parameter value - it is converted to the proper format later:
-static int queryParmValue (const char* configItem, char* valueStore)
+static unsigned int hashName (const char* name)
 {
-    char                    query[DB_SQLITE_QUERY_LENGTH_MAX];
-    SQLITE_RESULT_SET_ID    result;
-    SQLITE_ROW_ID           rowDescr;
-    SQLITE_FIELD_ID         field;
+    unsigned int            hash = 5381;
 
-    if (sqliteID == NULL)
+    while (*name)
     {
-        radMsgLog (PRI_HIGH, "queryParmValue: sqliteID is NULL!");
-        return ERROR;
+        hash = ((hash << 5) + hash) + (unsigned char)*name ++;
     }
 
-    sprintf (query, "SELECT value FROM config WHERE name = '%s'", configItem);
+    return (hash % WVCONFIG_HASH_SIZE);
+}
+
+static WVCONFIG_ITEM* findItem (WVCONFIG_ITEM** cache, const char* configItem)
+{
+    WVCONFIG_ITEM*          item;
 
-    if (radsqliteQuery(sqliteID, query, TRUE) == ERROR)
+    for (item = cache[hashName(configItem)]; item != NULL; item = item->next)
     {
-        radMsgLog (PRI_MEDIUM, 
-                   "queryParmValue: radsqliteQuery %s failed!", configItem);
-        return ERROR;
+        if (!strcmp(item->name, configItem))
+        {
+            return item;
+        }
+    }
+
+    return NULL;
+}
+
+static void freeCache (WVCONFIG_ITEM** cache)
+{
+    WVCONFIG_ITEM           *item, *next;
+    int                     i;
+
+    for (i = 0; i < WVCONFIG_HASH_SIZE; i ++)
+    {
+        for (item = cache[i]; item != NULL; item = next)
+        {
+            next = item->next;
+            free (item->name);
+            free (item->value);
+            free (item);
+        }
+        cache[i] = NULL;
+    }
+}
+
+static char* copyField (SQLITE_FIELD_ID field)
+{
+    char*                   value;
+    const char*             text;
+    int                     length;
+
+    text   = radsqliteFieldGetCharValue(field);
+    length = (text == NULL) ? 0 : radsqliteFieldGetCharLength(field);
+
+    value = (char*)malloc (length + 1);
+    if (value == NULL)
+    {
+        return NULL;
     }
 
-    result = radsqliteGetResults (sqliteID);
-    if (result == NULL)
+    if (length > 0)
+    {
+        memcpy (value, text, length);
+    }
+    value[length] = 0;
+    return value;
+}
+
+// Read the version counter; returns ERROR if the database has none:
+static int queryVersion (void)
+{
+    SQLITE_DIRECT_ROW       rowDescr;
+    SQLITE_FIELD_ID         field;
+    int                     version = ERROR;
+
+    if (radsqliteTableIfExists(sqliteID, configVERSION_TABLE) == FALSE)
     {
-        radMsgLog (PRI_MEDIUM, 
-                   "queryParmValue: radsqliteGetResults failed!");
         return ERROR;
     }
 
-    // We have a result, return it to the caller:
-    rowDescr = radsqliteResultsGetFirst (result);
-    if (rowDescr == NULL)
+    if (radsqlitedirectQuery(sqliteID, "SELECT version FROM " configVERSION_TABLE, TRUE)
+        == ERROR)
     {
-        radMsgLog (PRI_MEDIUM, 
-                   "queryParmValue: radsqliteResultsGetFirst failed!");
-        radsqliteReleaseResults (sqliteID, result);
         return ERROR;
     }
 
-    field = radsqliteFieldGet (rowDescr, configCOLUMN_VALUE);
-    if (field == NULL)
+    rowDescr = radsqlitedirectGetRow(sqliteID);
+    if (rowDescr != NULL)
     {
-        radMsgLog (PRI_MEDIUM, 
-                   "queryParmValue: radsqliteFieldGet failed!");
-        radsqliteReleaseResults (sqliteID, result);
+        field = radsqlitedirectFieldGet(rowDescr, configCOLUMN_VERSION);
+        if (field != NULL)
+        {
+            version = (int)radsqliteFieldGetBigIntValue(field);
+        }
+    }
+
+    radsqlitedirectReleaseResults(sqliteID);
+    return version;
+}
+
+// Load the whole config table into 'cache' with one query; items which are
+// new or differ from 'previous' (if not NULL) are marked as changed;
+// returns the number of items changed or ERROR:
+static int loadCache (WVCONFIG_ITEM** cache, WVCONFIG_ITEM** previous)
+{
+    char                    query[DB_SQLITE_QUERY_LENGTH_MAX];
+    SQLITE_DIRECT_ROW       rowDescr;
+    SQLITE_FIELD_ID         nameField, valueField;
+    WVCONFIG_ITEM           *item, *oldItem;
+    unsigned int            hash;
+    int                     changed = 0;
+
+    sprintf (query, "SELECT %s,%s FROM config", configCOLUMN_NAME, configCOLUMN_VALUE);
+    if (radsqlitedirectQuery(sqliteID, query, TRUE) == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "wvconfig: radsqlitedirectQuery %s failed!", query);
         return ERROR;
     }
 
-    memcpy (valueStore, 
-            radsqliteFieldGetCharValue(field), 
-            radsqliteFieldGetCharLength(field));
-    valueStore[radsqliteFieldGetCharLength(field)] = 0;
+    for (rowDescr = radsqlitedirectGetRow(sqliteID);
+         rowDescr != NULL;
+         rowDescr = radsqlitedirectGetRow(sqliteID))
+    {
+        nameField  = radsqlitedirectFieldGet(rowDescr, configCOLUMN_NAME);
+        valueField = radsqlitedirectFieldGet(rowDescr, configCOLUMN_VALUE);
+        if (nameField == NULL || valueField == NULL)
+        {
+            radMsgLog (PRI_HIGH, "wvconfig: radsqlitedirectFieldGet failed!");
+            radsqlitedirectReleaseResults(sqliteID);
+            freeCache (cache);
+            return ERROR;
+        }
+
+        item = (WVCONFIG_ITEM*)malloc (sizeof(*item));
+        if (item == NULL)
+        {
+            radMsgLog (PRI_HIGH, "wvconfig: malloc failed!");
+            radsqlitedirectReleaseResults(sqliteID);
+            freeCache (cache);
+            return ERROR;
+        }
+
+        item->name  = copyField (nameField);
+        item->value = copyField (valueField);
+        if (item->name == NULL || item->value == NULL)
+        {
+            radMsgLog (PRI_HIGH, "wvconfig: malloc failed!");
+            free (item->name);
+            free (item->value);
+            free (item);
+            radsqlitedirectReleaseResults(sqliteID);
+            freeCache (cache);
+            return ERROR;
+        }
+
+        item->isChanged = FALSE;
+        if (previous != NULL)
+        {
+            oldItem = findItem (previous, item->name);
+            if (oldItem == NULL || strcmp(oldItem->value, item->value))
+            {
+                item->isChanged = TRUE;
+                changed ++;
+            }
+        }
+
+        hash = hashName (item->name);
+        item->next = cache[hash];
+        cache[hash] = item;
+    }
+
+    radsqlitedirectReleaseResults(sqliteID);
+    return changed;
+}
+
+// Query for a parameter value - it is converted to the proper format later:
+static int queryParmValue (const char* configItem, char* valueStore)
+{
+    WVCONFIG_ITEM*          item;
 
-    // Clean up:
-    radsqliteReleaseResults (sqliteID, result);
+    item = findItem (configCache, configItem);
+    if (item == NULL)
+    {
+        return ERROR;
+    }
 
+    wvstrncpy (valueStore, item->value, _MAX_PATH);
     return OK;
 }
 
@@ -148,6 +301,19 @@ int wvconfigInit (int firstProcess)
         return ERROR;
     }
 
+    // Load the cache:
+    freeCache (configCache);
+    configVersion = queryVersion ();
+    if (loadCache (configCache, NULL) == ERROR)
+    {
+        radMsgLog (PRI_CATASTROPHIC, "wvconfigInit: config table load failed!");
+        radsqliteClose (sqliteID);
+        sqliteID = NULL;
+        radSemGive(wvconfigMutex);
+        radSemDelete(wvconfigMutex);
+        return ERROR;
+    }
+
     return OK;
 }
 
@@ -164,6 +330,101 @@ void wvconfigExit (void)
     radSemDelete(wvconfigMutex);
 }
 
+//  wvconfigGetVersion: retrieve the config version the cache was loaded at
+int wvconfigGetVersion (void)
+{
+    return configVersion;
+}
+
+//  wvconfigReload: reload the cache if the config database has changed
+int wvconfigReload (void)
+{
+    WVCONFIG_ITEM*  newCache[WVCONFIG_HASH_SIZE];
+    char            buffer[_MAX_PATH];
+    int             isAttached = (sqliteID != NULL);
+    int             version, changed = 0;
+
+    if (! isAttached)
+    {
+        wvconfigMutex = radSemCreate(WVIEW_CONFIG_SEM_INDEX, -1);
+        if (wvconfigMutex == NULL)
+        {
+            radMsgLog (PRI_HIGH, "wvconfigReload: cannot attach config semaphore!");
+            return ERROR;
+        }
+
+        radSemTake(wvconfigMutex);
+
+        sprintf (buffer, "%s/%s", WVIEW_CONFIG_DIR, WVIEW_CONFIG_DATABASE);
+        sqliteID = radsqliteOpen ((const char*)buffer);
+        if (sqliteID == NULL)
+        {
+            radMsgLog (PRI_HIGH, "wvconfigReload: radsqliteOpen %s failed!", buffer);
+            radSemGive(wvconfigMutex);
+            radSemDelete(wvconfigMutex);
+            return ERROR;
+        }
+    }
+
+    // Without a version counter everything must be compared:
+    version = queryVersion ();
+    if (version == ERROR || version != configVersion)
+    {
+        memset (newCache, 0, sizeof(newCache));
+        changed = loadCache (newCache, configCache);
+        if (changed != ERROR)
+        {
+            freeCache (configCache);
+            memcpy (configCache, newCache, sizeof(configCache));
+            configVersion = version;
+        }
+    }
+    else
+    {
+        // Nothing changed since the last load:
+        wvconfigClearChanged ();
+    }
+
+    if (! isAttached)
+    {
+        radsqliteClose (sqliteID);
+        sqliteID = NULL;
+        radSemGive(wvconfigMutex);
+        radSemDelete(wvconfigMutex);
+    }
+
+    return changed;
+}
+
+//  wvconfigIsChanged: was this parameter changed by the last wvconfigReload?
+int wvconfigIsChanged (const char* configItem)
+{
+    WVCONFIG_ITEM*  item;
+
+    item = findItem (configCache, configItem);
+    if (item == NULL)
+    {
+        return FALSE;
+    }
+
+    return item->isChanged;
+}
+
+//  wvconfigClearChanged: clear the changed marks of all parameters
+void wvconfigClearChanged (void)
+{
+    WVCONFIG_ITEM*  item;
+    int             i;
+
+    for (i = 0; i < WVCONFIG_HASH_SIZE; i ++)
+    {
+        for (item = configCache[i]; item != NULL; item = item->next)
+        {
+            item->isChanged = FALSE;
+        }
+    }
+}
+
 //  wvconfigGetINTValue: retrieve the integer value for this parameter;
 //  Returns: integer value or 0
 int wvconfigGetINTValue (const char* configItem)
@@ -89,6 +89,26 @@
 #define configItem_STATION_VERBOSE_MSGS                         "STATION_VERBOSE_MSGS"
 #define configItem_STATION_DO_RXCHECK                           "STATION_DO_RCHECK"
 #define configItem_STATION_OUTSIDE_CHANNEL                      "STATION_OUTSIDE_CHANNEL"
+#define configItem_STATION_VMULTI_HOSTS                         "STATION_VMULTI_HOSTS"
+#define configItem_STATION_VMULTI_POLICY                        "STATION_VMULTI_POLICY"
+#define configItem_STATION_VMULTI_FIELD_PRIORITY                "STATION_VMULTI_FIELD_PRIORITY"
+#define configItem_STATION_VMULTI_STALE_SECS                    "STATION_VMULTI_STALE_SECS"
+#define configItem_STATION_SIM_BENCH_RATE                       "STATION_SIM_BENCH_RATE"
+#define configItem_STATION_SIM_BENCH_COMPRESSION                "STATION_SIM_BENCH_COMPRESSION"
+#define configItem_STATION_SIM_BENCH_DAYS                       "STATION_SIM_BENCH_DAYS"
+#define configItem_STATION_SIM_BENCH_HTML_FILE                  "STATION_SIM_BENCH_HTML_FILE"
+#define configItem_STATION_CAPTURE_FILE                         "STATION_CAPTURE_FILE"
+#define configItem_STATION_REPLAY_FILE                          "STATION_REPLAY_FILE"
+#define configItem_STATION_REPLAY_SPEED                         "STATION_REPLAY_SPEED"
+
+#define configItem_STATION_SQLDB_HOST                           "STATION_SQLDB_HOST"
+#define configItem_STATION_SQLDB_USERNAME                       "STATION_SQLDB_USERNAME"
+#define configItem_STATION_SQLDB_PASSWORD                       "STATION_SQLDB_PASSWORD"
+#define configItem_STATION_SQLDB_DB_NAME                        "STATION_SQLDB_DB_NAME"
+#define configItem_STATION_SQLDB_EXPORT_SINK                    "STATION_SQLDB_EXPORT_SINK"
+#define configItem_STATION_SQLDB_EXPORT_DIRECTORY               "STATION_SQLDB_EXPORT_DIRECTORY"
+#define configItem_STATION_SQLDB_EXPORT_INTERVAL                "STATION_SQLDB_EXPORT_INTERVAL"
+#define configItem_STATION_SQLDB_EXPORT_BATCH                   "STATION_SQLDB_EXPORT_BATCH"
 
 #define configItem_HTMLGEN_STATION_NAME                         "HTMLGEN_STATION_NAME" 
 #define configItem_HTMLGEN_STATION_CITY                         "HTMLGEN_STATION_CITY" 
@@ -109,6 +129,10 @@
 #define configItem_HTMLGEN_LOCAL_RADAR_URL                      "HTMLGEN_LOCAL_RADAR_URL" 
 #define configItem_HTMLGEN_LOCAL_FORECAST_URL                   "HTMLGEN_LOCAL_FORECAST_URL" 
 #define configItem_HTMLGEN_DATE_FORMAT                          "HTMLGEN_DATE_FORMAT"  
+#define configItem_HTMLGEN_DATA_JSON                            "HTMLGEN_DATA_JSON"
+#define configItem_HTMLGEN_DATA_BINARY                          "HTMLGEN_DATA_BINARY"
+#define configItem_HTMLGEN_HTTP_PORT                            "HTMLGEN_HTTP_PORT"
+#define configItem_HTMLGEN_PRECOMPRESS_SIZE                     "HTMLGEN_PRECOMPRESS_SIZE"
  
 #define configItem_ALARMS_STATION_METRIC                        "ALARMS_STATION_METRIC"
 #define configItem_ALARMS_DO_TEST                               "ALARMS_DO_TEST"
@@ -170,6 +194,7 @@
 #define configItemFTP_REMOTE_DIRECTORY                          "FTP_REMOTE_DIRECTORY" 
 #define configItemFTP_USE_PASSIVE                               "FTP_USE_PASSIVE" 
 #define configItemFTP_INTERVAL                                  "FTP_INTERVAL"
+#define configItemFTP_PARALLEL_TRANSFERS                        "FTP_PARALLEL_TRANSFERS"
 #define configItemFTP_RULE_1_SOURCE                             "FTP_RULE_1_SOURCE" 
 #define configItemFTP_RULE_2_SOURCE                             "FTP_RULE_2_SOURCE" 
 #define configItemFTP_RULE_3_SOURCE                             "FTP_RULE_3_SOURCE"
@@ -211,6 +236,7 @@
 #define configItemSSH_5_PORT                                    "SSH_5_PORT" 
 #define configItemSSH_5_USERNAME                                "SSH_5_USERNAME" 
 #define configItemSSH_5_DESTINATION                             "SSH_5_DESTINATION"
+#define configItemSSH_PERSISTENT_CONNECTION                     "SSH_PERSISTENT_CONNECTION"
 
 #define configItemCWOP_APRS_CALL_SIGN                           "CWOP_APRS_CALL_SIGN"
 #define configItemCWOP_APRS_SERVER1                             "CWOP_APRS_SERVER1" 
@@ -222,6 +248,7 @@
 #define configItemCWOP_LATITUDE                                 "CWOP_LATITUDE" 
 #define configItemCWOP_LONGITUDE                                "CWOP_LONGITUDE" 
 #define configItemCWOP_LOG_WX_PACKET                            "CWOP_LOG_WX_PACKET" 
+#define configItemCWOP_PERSISTENT_CONNECTION                    "CWOP_PERSISTENT_CONNECTION"
 
 #define configItemHTTP_WUSTATIONID                              "HTTP_WUSTATIONID"
 #define configItemHTTP_WUPASSWD                                 "HTTP_WUPASSWD"
@@ -258,12 +285,21 @@
 #define configItemPROCMON_wvcwopd                               "PROCMON_wvcwopd"
 #define configItemPROCMON_wvhttpd                               "PROCMON_wvhttpd"
 #define configItemPROCMON_wviewsqld                             "PROCMON_wviewsqld"
+#define configItemPROCMON_ALERT_RSS_KB                          "PROCMON_ALERT_RSS_KB"
+#define configItemPROCMON_ALERT_FDS                             "PROCMON_ALERT_FDS"
+#define configItemPROCMON_ALERT_POLL_MS                         "PROCMON_ALERT_POLL_MS"
+#define configItemPROCMON_ALERT_HTML_GEN_MS                     "PROCMON_ALERT_HTML_GEN_MS"
+#define configItemPROCMON_ALERT_DATAFEED_BACKLOG                "PROCMON_ALERT_DATAFEED_BACKLOG"
 
 // Define the column names for wview-conf.sdb:
 #define configCOLUMN_NAME                                       "name"
 #define configCOLUMN_VALUE                                      "value"
 #define configCOLUMN_DESCRIPTION                                "description"
 
+// Define the config version counter table, bumped by triggers on config:
+#define configVERSION_TABLE                                     "config_version"
+#define configCOLUMN_VERSION                                    "version"
+
 
 //  ... API prototypes
 
@@ -273,8 +309,27 @@
 extern int wvconfigInit (int firstProcess);
 
 //  wvconfigExit: clean up and detach from the wview configuration API
+//  (the cached values remain available)
 extern void wvconfigExit (void);
 
+//  wvconfigGetVersion: retrieve the config version counter the cache was
+//  loaded at;
+//  Returns: version or ERROR if the database has no version counter
+extern int wvconfigGetVersion (void);
+
+//  wvconfigReload: check the config version counter and reload the cache if
+//  it has changed; may be called with or without wvconfigInit;
+//  Returns: number of parameters changed (0 if none) or ERROR
+extern int wvconfigReload (void);
+
+//  wvconfigIsChanged: is this parameter new or changed by the last
+//  wvconfigReload?
+//  Returns: TRUE or FALSE
+extern int wvconfigIsChanged (const char* configItem);
+
+//  wvconfigClearChanged: clear the changed state of all parameters
+extern void wvconfigClearChanged (void);
+
 //  wvconfigGetINTValue: retrieve the integer value for this parameter;
 //  Returns: integer value
 extern int wvconfigGetINTValue (const char* configItem);
@@ -9,6 +9,8 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         07/12/2005      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Persistent APRS-IS session
+        10/19/2026      M.S. Teel       2               Report the wind windows
  
   NOTES:
         
@@ -50,8 +52,8 @@ static char*                cwopStatusLabels[STATUS_STATS_MAX] =
 {
     "Connection errors",
     "Packets sent",
-    NULL,
-    NULL
+    "Reports queued",
+    "Send latency ms"
 };
 
 /* ... methods
@@ -97,13 +99,10 @@ static short getPasscode (char *callSign)
 
 static void processCWOP ()
 {
-    RADSOCK_ID                          socket;
     time_t                              ntime;
     struct tm                           *gmTime;
-    char                                cwopBuffer[256], login[64];
+    char                                cwopBuffer[256];
     int                                 length = 0;
-    char                                *serv;
-    int                                 port;
     volatile WVIEW_MSG_ARCHIVE_NOTIFY   Notify;
 
     memcpy ((void*)&Notify, (void*)&cwopWork.ArchiveMsg, sizeof(WVIEW_MSG_ARCHIVE_NOTIFY));
@@ -118,18 +117,19 @@ static void processCWOP ()
     length += sprintf (&cwopBuffer[length], "%s/%s",
                        cwopWork.latitude, cwopWork.longitude);
 
-    // check for any wind registered
-    if (Notify.wspeed < 0)
+    // check for any wind registered - direction and speed are the 2 minute
+    // averages and the gust the 10 minute peak kept by wviewd (windStats.c):
+    if (Notify.wspeed2min < 0)
     {
         length += sprintf (&cwopBuffer[length], "_...");
     }
     else
     {
-        length += sprintf (&cwopBuffer[length], "_%3.3d", Notify.winddir);
+        length += sprintf (&cwopBuffer[length], "_%3.3d", Notify.winddir2min);
     }
     
-    length += sprintf (&cwopBuffer[length], "/%3.3d", Notify.wspeed);
-    length += sprintf (&cwopBuffer[length], "g%3.3d", Notify.hiwspeed);
+    length += sprintf (&cwopBuffer[length], "/%3.3d", Notify.wspeed2min);
+    length += sprintf (&cwopBuffer[length], "g%3.3d", Notify.hiwspeed10min);
 
     if (Notify.temp < 0)
     {
@@ -163,103 +163,8 @@ static void processCWOP ()
     sprintf (&cwopBuffer[length], ".%s", wvutilsCreateCWOPVersion(globalWviewVersionStr));
 
 
-    // connect to the CWOP server - try the primary then secondary then tertiary
-    socket = radSocketClientCreate (cwopWork.server1, cwopWork.portNo1);
-    if (socket == NULL)
-    {
-        statusUpdateMessage("CWOP-connect: failed to connect to server");
-        statusIncrementStat(CWOP_STATS_CONNECT_ERRORS);
-        wvutilsLogEvent (PRI_MEDIUM, "CWOP-connect: failed to connect to %s:%d",
-                         cwopWork.server1, cwopWork.portNo1);
-        
-        // try the secondary server
-        socket = radSocketClientCreate (cwopWork.server2, cwopWork.portNo2);
-        if (socket == NULL)
-        {
-            statusUpdateMessage("CWOP-connect: failed to connect to server");
-            statusIncrementStat(CWOP_STATS_CONNECT_ERRORS);
-            wvutilsLogEvent (PRI_MEDIUM, "CWOP-connect: failed to connect to %s:%d",
-                             cwopWork.server2, cwopWork.portNo2);
-        
-            // try the tertiary server
-            socket = radSocketClientCreate (cwopWork.server3, cwopWork.portNo3);
-            if (socket == NULL)
-            {
-                // we are all out of luck this time!
-                statusUpdateMessage("CWOP-connect: failed to connect to server");
-                statusIncrementStat(CWOP_STATS_CONNECT_ERRORS);
-                wvutilsLogEvent (PRI_MEDIUM, "CWOP-connect: failed to connect to %s:%d",
-                                 cwopWork.server3, cwopWork.portNo3);
-                radMsgLog (PRI_HIGH, 
-                           "CWOP-connect: failed to connect to all 3 APRS servers!");
-                return;
-            }
-            else
-            {
-                serv = cwopWork.server3;
-                port = cwopWork.portNo3;
-            }
-        }
-        else
-        {
-            serv = cwopWork.server2;
-            port = cwopWork.portNo2;
-        }
-    }
-    else
-    {
-        serv = cwopWork.server1;
-        port = cwopWork.portNo1;
-    }
-    
-    // wait 1 second ...
-    radUtilsSleep (1000);
-    
-    // transmit the data 
-    sprintf (login, "user %6s pass %d vers %s", 
-             cwopWork.callSign, 
-             (int)getPasscode(cwopWork.callSign), 
-             globalWviewVersionStr);
-    length = strlen (login);
-    login[length] = 0x0D;           // tack on the CR and LF
-    login[length+1] = 0x0A;
-    login[length+2] = 0;
-    
-    if (radSocketWriteExact (socket, login, length + 2) != (length + 2))
-    {
-        statusUpdateMessage("CWOP-error: failed to login to server");
-        radMsgLog (PRI_HIGH, "CWOP-error: %d: failed to login to %s:%d!",
-                   errno, serv, port);
-        radSocketDestroy (socket);
-        return;
-    }
-    
-    // wait 3 seconds ...
-    radUtilsSleep (3000);
-    
-    // write the data record
-    wvutilsLogEvent (PRI_STATUS, "CWOP-send: %s", cwopBuffer);
-
-    length = strlen (cwopBuffer);
-    cwopBuffer[length] = 0x0D;       // tack on the CR and LF
-    cwopBuffer[length+1] = 0x0A;
-    cwopBuffer[length+2] = 0;
-    if (radSocketWriteExact (socket, cwopBuffer, length + 2) != (length + 2))
-    {
-        statusUpdateMessage("CWOP-error: failed to write to server");
-        radMsgLog (PRI_HIGH, "CWOP-error: %d: failed to write to %s:%d!",
-                   errno, serv, port);
-        radSocketDestroy (socket);
-        return;
-    }
-
-    statusIncrementStat(CWOP_STATS_PKTS_SENT);
-
-    // wait 3 more seconds ...
-    radUtilsSleep (3000);
-
-    // close connection and cleanup
-    radSocketDestroy (socket);
+    // the session sends it now or as soon as it can:
+    cwopSessionSend (&cwopWork.session, cwopBuffer);
 
     return;
 }
@@ -441,15 +346,15 @@ static void defaultSigHandler (int signum)
                 return;
             }
 
-            // Exit here in case the socket transaction is hung
-            statusUpdateMessage("exiting normally");
-            statusUpdate(STATUS_SHUTDOWN);
-            radMsgLog (PRI_HIGH, "wvcwopd: recv sig %d: exiting now!", signum);
-            radMsgRouterExit ();
-            cwopSysExit (&cwopWork);
-            radProcessExit ();
-            radSystemExit (WVIEW_SYSTEM_ID);
-            exit (0);                
+            // the session never blocks for long, so we can allow the
+            // process to exit normally...
+            radMsgLog (PRI_HIGH, "wvcwopd: recv sig %d: exiting!", signum);
+
+            cwopWork.exiting = TRUE;
+            radProcessSetExitFlag ();
+
+            radProcessSignalCatch(signum, defaultSigHandler);
+            break;
     }
     
     return;
@@ -542,6 +447,10 @@ int main (int argc, char *argv[])
     double          dValue;
     const char*     sValue;
     int             runAsDaemon = TRUE;
+    int             isPersistent;
+    char            *servers[CWOP_NUM_SERVERS];
+    int             ports[CWOP_NUM_SERVERS];
+    char            login[CWOP_MAX_PACKET];
 
     if (argc > 1)
     {
@@ -822,6 +731,10 @@ int main (int argc, char *argv[])
         cwopWork.logWXPackets = iValue;
     }
 
+    // Keep the APRS-IS session open between reports?
+    iValue = wvconfigGetBooleanValue(configItemCWOP_PERSISTENT_CONNECTION);
+    isPersistent = ((iValue == ERROR) ? TRUE : iValue);
+
     wvconfigExit ();
 
 
@@ -896,6 +809,32 @@ int main (int argc, char *argv[])
     radMsgLog (PRI_STATUS, "CWOP: Tertiary:  %s:%d", cwopWork.server3, cwopWork.portNo3);
     radMsgLog (PRI_STATUS, "CWOP: Submitting every %d minutes at offset minute: %d",
                cwopWork.reportInterval, cwopWork.callSignOffset);
+    radMsgLog (PRI_STATUS, "CWOP: %susing a persistent connection",
+               (isPersistent ? "" : "not "));
+
+
+    // start the APRS-IS session
+    servers[0] = cwopWork.server1;
+    ports[0] = cwopWork.portNo1;
+    servers[1] = cwopWork.server2;
+    ports[1] = cwopWork.portNo2;
+    servers[2] = cwopWork.server3;
+    ports[2] = cwopWork.portNo3;
+    sprintf (login, "user %6s pass %d vers %s",
+             cwopWork.callSign,
+             (int)getPasscode(cwopWork.callSign),
+             globalWviewVersionStr);
+    if (cwopSessionInit (&cwopWork.session, servers, ports, login, isPersistent) == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "cwopSessionInit failed");
+        statusUpdate(STATUS_ERROR);
+        radMsgRouterExit ();
+        radTimerDelete (cwopWork.timer);
+        cwopSysExit (&cwopWork);
+        radProcessExit ();
+        radSystemExit (WVIEW_SYSTEM_ID);
+        exit (1);
+    }
 
 
     // enter normal processing
@@ -919,6 +858,7 @@ int main (int argc, char *argv[])
     radMsgLog (PRI_STATUS, "exiting normally...");
     statusUpdate(STATUS_SHUTDOWN);
 
+    cwopSessionExit (&cwopWork.session);
     radMsgRouterExit ();
     radTimerDelete (cwopWork.timer);
     cwopSysExit (&cwopWork);
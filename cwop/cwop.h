@@ -56,6 +56,7 @@
 #include <datadefs.h>
 #include <status.h>
 #include <wvconfig.h>
+#include <cwopSession.h>
 
 
 #define CWOP_MINUTE_INTERVAL            60000
@@ -69,7 +70,9 @@
 typedef enum
 {
     CWOP_STATS_CONNECT_ERRORS       = 0,
-    CWOP_STATS_PKTS_SENT
+    CWOP_STATS_PKTS_SENT,
+    CWOP_STATS_QUEUE_DEPTH,
+    CWOP_STATS_SEND_LATENCY_MS
 } CWOP_STATS;
 
 
@@ -97,6 +100,7 @@ typedef struct
     char                        latitude[16];
     char                        longitude[16];
     int                         logWXPackets;
+    CWOP_SESSION                session;
     int                         inMainLoop;
     int                         exiting;
 } WVIEW_CWOP_WORK;
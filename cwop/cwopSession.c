@@ -0,0 +1,548 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        cwopSession.c
+
+  PURPOSE:
+        Provide the wvcwopd APRS-IS session: one persistent, logged in
+        connection with keepalive, exponential backoff reconnect and a queue
+        of reports which is replayed once connected.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        See cwopSession.h.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <errno.h>
+#include <sys/socket.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radprocess.h>
+#include <radtimeUtils.h>
+
+/*  ... Local include files
+*/
+#include <cwop.h>
+
+
+/* ... methods
+*/
+static void Service (CWOP_SESSION_ID id);
+
+static void SetState (CWOP_SESSION_ID id, CWOP_SESSION_STATE state)
+{
+    char            msg[256];
+
+    id->state = state;
+    id->stateTime = time (NULL);
+
+    switch (state)
+    {
+        case CWOP_SESSION_DISCONNECTED:
+            if (id->nextConnect > id->stateTime)
+            {
+                sprintf (msg, "Disconnected - reconnect in %d seconds",
+                         (int)(id->nextConnect - id->stateTime));
+            }
+            else
+            {
+                sprintf (msg, "Disconnected");
+            }
+            break;
+        case CWOP_SESSION_WAIT_BANNER:
+        case CWOP_SESSION_WAIT_LOGRESP:
+            sprintf (msg, "Logging in to %s:%d",
+                     id->server[id->serverIndex], id->port[id->serverIndex]);
+            break;
+        case CWOP_SESSION_READY:
+            sprintf (msg, "Connected to %s:%d",
+                     id->server[id->serverIndex], id->port[id->serverIndex]);
+            break;
+    }
+
+    statusUpdateMessage(msg);
+}
+
+static void Disconnect (CWOP_SESSION_ID id, int isFailure)
+{
+    time_t          ntime = time (NULL);
+
+    if (id->socket != NULL)
+    {
+        radProcessIODeRegisterDescriptorByFd (id->fd);
+        radSocketDestroy (id->socket);
+        id->socket = NULL;
+    }
+
+    if (isFailure)
+    {
+        id->nextConnect = ntime + id->backoff;
+        id->backoff *= 2;
+        if (id->backoff > CWOP_BACKOFF_MAX)
+            id->backoff = CWOP_BACKOFF_MAX;
+
+        // try the next server first:
+        id->serverIndex = (id->serverIndex + 1) % CWOP_NUM_SERVERS;
+    }
+    else
+    {
+        id->nextConnect = ntime;
+    }
+
+    SetState (id, CWOP_SESSION_DISCONNECTED);
+}
+
+static int WriteLine (CWOP_SESSION_ID id, const char *line)
+{
+    char            bfr[CWOP_MAX_PACKET + 2];
+    int             length = strlen (line);
+
+    memcpy (bfr, line, length);
+    bfr[length] = 0x0D;           // tack on the CR and LF
+    bfr[length+1] = 0x0A;
+
+    if (radSocketWriteExact (id->socket, bfr, length + 2) != (length + 2))
+    {
+        radMsgLog (PRI_HIGH, "CWOP-error: %d: failed to write to %s:%d!",
+                   errno, id->server[id->serverIndex], id->port[id->serverIndex]);
+        statusUpdateMessage("CWOP-error: failed to write to server");
+        return ERROR;
+    }
+
+    id->lastTx = time (NULL);
+    return OK;
+}
+
+static void ProcessLine (CWOP_SESSION_ID id, char *line)
+{
+    wvutilsLogEvent (PRI_STATUS, "CWOP-recv: %s", line);
+
+    if (line[0] != '#')
+    {
+        // traffic from a full feed port, nothing for us
+        return;
+    }
+
+    if (id->state == CWOP_SESSION_WAIT_BANNER)
+    {
+        if (WriteLine (id, id->login) == ERROR)
+        {
+            Disconnect (id, TRUE);
+            return;
+        }
+        SetState (id, CWOP_SESSION_WAIT_LOGRESP);
+    }
+    else if (id->state == CWOP_SESSION_WAIT_LOGRESP &&
+             strncmp (line, "# logresp", 9) == 0)
+    {
+        radMsgLog (PRI_STATUS, "CWOP: logged in to %s:%d: %s",
+                   id->server[id->serverIndex], id->port[id->serverIndex], &line[2]);
+        SetState (id, CWOP_SESSION_READY);
+    }
+}
+
+// radProcess input callback for the server socket
+static void SocketDataCallback (int fd, void *userData)
+{
+    CWOP_SESSION_ID id = (CWOP_SESSION_ID)userData;
+    int             bytes, start, i;
+
+    if (id->socket == NULL)
+    {
+        return;
+    }
+
+    bytes = read (fd, &id->rxBuffer[id->rxLength], CWOP_RX_BUFFER - id->rxLength - 1);
+    if (bytes <= 0)
+    {
+        if (bytes < 0 && (errno == EAGAIN || errno == EINTR))
+        {
+            return;
+        }
+
+        radMsgLog (PRI_MEDIUM, "CWOP: %s:%d closed the connection",
+                   id->server[id->serverIndex], id->port[id->serverIndex]);
+        statusIncrementStat(CWOP_STATS_CONNECT_ERRORS);
+        Disconnect (id, TRUE);
+        Service (id);
+        return;
+    }
+
+    id->lastRx = time (NULL);
+    id->rxLength += bytes;
+
+    // process complete lines:
+    for (start = 0, i = 0; i < id->rxLength; i ++)
+    {
+        if (id->rxBuffer[i] != 0x0A)
+        {
+            continue;
+        }
+
+        id->rxBuffer[i] = 0;
+        if (i > start && id->rxBuffer[i - 1] == 0x0D)
+        {
+            id->rxBuffer[i - 1] = 0;
+        }
+
+        ProcessLine (id, &id->rxBuffer[start]);
+        start = i + 1;
+
+        if (id->socket == NULL)
+        {
+            // lost while answering
+            id->rxLength = 0;
+            Service (id);
+            return;
+        }
+    }
+
+    if (start > 0)
+    {
+        memmove (id->rxBuffer, &id->rxBuffer[start], id->rxLength - start);
+        id->rxLength -= start;
+    }
+    else if (id->rxLength >= CWOP_RX_BUFFER - 1)
+    {
+        // a line too long to matter
+        id->rxLength = 0;
+    }
+
+    Service (id);
+}
+
+// try each server once, starting with the current one
+static int Connect (CWOP_SESSION_ID id)
+{
+    int             i, index, optval = 1;
+
+    for (i = 0; i < CWOP_NUM_SERVERS; i ++)
+    {
+        index = (id->serverIndex + i) % CWOP_NUM_SERVERS;
+        id->socket = radSocketClientCreate (id->server[index], id->port[index]);
+        if (id->socket != NULL)
+        {
+            id->serverIndex = index;
+            break;
+        }
+
+        statusIncrementStat(CWOP_STATS_CONNECT_ERRORS);
+        wvutilsLogEvent (PRI_MEDIUM, "CWOP-connect: failed to connect to %s:%d",
+                         id->server[index], id->port[index]);
+    }
+
+    if (id->socket == NULL)
+    {
+        radMsgLog (PRI_HIGH, "CWOP-connect: failed to connect to all %d APRS servers!",
+                   CWOP_NUM_SERVERS);
+        return ERROR;
+    }
+
+    id->fd = radSocketGetDescriptor (id->socket);
+    setsockopt (id->fd, SOL_SOCKET, SO_KEEPALIVE, &optval, sizeof(optval));
+    radSocketSetBlocking (id->socket, FALSE);
+
+    if (radProcessIORegisterDescriptor (id->fd, SocketDataCallback, (void *)id) == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "CWOP-connect: radProcessIORegisterDescriptor failed");
+        radSocketDestroy (id->socket);
+        id->socket = NULL;
+        return ERROR;
+    }
+
+    id->rxLength = 0;
+    id->lastRx = id->lastTx = time (NULL);
+    SetState (id, CWOP_SESSION_WAIT_BANNER);
+    return OK;
+}
+
+static int SendReport (CWOP_SESSION_ID id)
+{
+    CWOP_REPORT     *report = (CWOP_REPORT *)radListGetFirst (&id->queue);
+    int             latencyMS;
+
+    wvutilsLogEvent (PRI_STATUS, "CWOP-send: %s", report->packet);
+
+    if (WriteLine (id, report->packet) == ERROR)
+    {
+        return ERROR;
+    }
+
+    latencyMS = (int)(radTimeGetMSSinceEpoch () - report->queuedMS);
+    radListRemove (&id->queue, (NODE_PTR)report);
+    id->queueDepth --;
+    free (report);
+
+    // this server is good:
+    id->backoff = CWOP_BACKOFF_MIN;
+
+    statusIncrementStat(CWOP_STATS_PKTS_SENT);
+    statusUpdateStat(CWOP_STATS_QUEUE_DEPTH, id->queueDepth);
+    statusUpdateStat(CWOP_STATS_SEND_LATENCY_MS, latencyMS);
+    return OK;
+}
+
+static void DropStale (CWOP_SESSION_ID id, time_t ntime)
+{
+    CWOP_REPORT     *report;
+
+    while ((report = (CWOP_REPORT *)radListGetFirst (&id->queue)) != NULL &&
+           ntime - report->queued > CWOP_QUEUE_MAX_AGE)
+    {
+        radMsgLog (PRI_MEDIUM, "CWOP: dropping a report queued %d minutes ago",
+                   (int)((ntime - report->queued) / 60));
+        radListRemove (&id->queue, (NODE_PTR)report);
+        id->queueDepth --;
+        id->dropped ++;
+        free (report);
+        statusUpdateStat(CWOP_STATS_QUEUE_DEPTH, id->queueDepth);
+    }
+}
+
+static int MinWait (int wait, int seconds)
+{
+    if (seconds < 0)
+        seconds = 0;
+    return ((wait < 0 || seconds < wait) ? seconds : wait);
+}
+
+// advance the session and (re)arm the timer for the next thing to do
+static void Service (CWOP_SESSION_ID id)
+{
+    time_t          ntime = time (NULL);
+    int             wait = -1;
+
+    DropStale (id, ntime);
+
+    if (id->state == CWOP_SESSION_DISCONNECTED)
+    {
+        if (id->queueDepth > 0 || id->isPersistent)
+        {
+            if (ntime < id->nextConnect)
+            {
+                wait = id->nextConnect - ntime;
+            }
+            else if (Connect (id) == ERROR)
+            {
+                Disconnect (id, TRUE);
+                wait = id->nextConnect - ntime;
+            }
+        }
+    }
+
+    if (id->state == CWOP_SESSION_WAIT_BANNER || id->state == CWOP_SESSION_WAIT_LOGRESP)
+    {
+        if (ntime - id->stateTime >= CWOP_LOGIN_WAIT)
+        {
+            // some servers are quiet, carry on:
+            if (id->state == CWOP_SESSION_WAIT_BANNER)
+            {
+                if (WriteLine (id, id->login) == ERROR)
+                {
+                    Disconnect (id, TRUE);
+                    Service (id);
+                    return;
+                }
+                SetState (id, CWOP_SESSION_WAIT_LOGRESP);
+            }
+            else
+            {
+                SetState (id, CWOP_SESSION_READY);
+            }
+        }
+
+        if (id->state != CWOP_SESSION_READY)
+        {
+            wait = MinWait (wait, CWOP_LOGIN_WAIT - (ntime - id->stateTime));
+        }
+    }
+
+    if (id->state == CWOP_SESSION_READY)
+    {
+        if (ntime - id->lastRx >= CWOP_RX_TIMEOUT)
+        {
+            radMsgLog (PRI_MEDIUM, "CWOP: nothing from %s:%d for %d seconds, reconnecting",
+                       id->server[id->serverIndex], id->port[id->serverIndex],
+                       (int)(ntime - id->lastRx));
+            statusIncrementStat(CWOP_STATS_CONNECT_ERRORS);
+            Disconnect (id, TRUE);
+            Service (id);
+            return;
+        }
+
+        if (id->queueDepth > 0 && ntime - id->lastTx >= CWOP_REPLAY_SPACING)
+        {
+            if (SendReport (id) == ERROR)
+            {
+                Disconnect (id, TRUE);
+                Service (id);
+                return;
+            }
+        }
+
+        if (id->queueDepth > 0)
+        {
+            wait = MinWait (wait, CWOP_REPLAY_SPACING - (ntime - id->lastTx));
+        }
+        else if (! id->isPersistent)
+        {
+            Disconnect (id, FALSE);
+            radProcessTimerStop (id->timer);
+            return;
+        }
+        else
+        {
+            if (ntime - id->lastTx >= CWOP_KEEPALIVE_INTERVAL)
+            {
+                if (WriteLine (id, "#keepalive") == ERROR)
+                {
+                    Disconnect (id, TRUE);
+                    Service (id);
+                    return;
+                }
+            }
+            wait = MinWait (wait, CWOP_KEEPALIVE_INTERVAL - (ntime - id->lastTx));
+        }
+
+        wait = MinWait (wait, CWOP_RX_TIMEOUT - (ntime - id->lastRx));
+    }
+
+    if (wait < 0)
+    {
+        radProcessTimerStop (id->timer);
+    }
+    else
+    {
+        radProcessTimerStart (id->timer, (wait > 0) ? wait * 1000 : 100);
+    }
+}
+
+static void TimerHandler (void *parm)
+{
+    Service ((CWOP_SESSION_ID)parm);
+}
+
+
+// API:
+int cwopSessionInit
+(
+    CWOP_SESSION_ID id,
+    char            *servers[CWOP_NUM_SERVERS],
+    int             ports[CWOP_NUM_SERVERS],
+    const char      *login,
+    int             isPersistent
+)
+{
+    int             i;
+
+    memset (id, 0, sizeof (*id));
+    for (i = 0; i < CWOP_NUM_SERVERS; i ++)
+    {
+        wvstrncpy (id->server[i], servers[i], sizeof(id->server[i]));
+        id->port[i] = ports[i];
+    }
+    wvstrncpy (id->login, login, CWOP_MAX_PACKET);
+    id->isPersistent = isPersistent;
+    id->backoff = CWOP_BACKOFF_MIN;
+    radListReset (&id->queue);
+
+    id->timer = radTimerCreate (NULL, TimerHandler, (void *)id);
+    if (id->timer == NULL)
+    {
+        radMsgLog (PRI_HIGH, "cwopSessionInit: radTimerCreate failed");
+        return ERROR;
+    }
+
+    SetState (id, CWOP_SESSION_DISCONNECTED);
+    statusUpdateStat(CWOP_STATS_QUEUE_DEPTH, 0);
+
+    if (id->isPersistent)
+    {
+        Service (id);
+    }
+
+    return OK;
+}
+
+int cwopSessionSend (CWOP_SESSION_ID id, const char *packet)
+{
+    CWOP_REPORT     *report;
+
+    if (strlen (packet) >= CWOP_MAX_PACKET)
+    {
+        radMsgLog (PRI_HIGH, "CWOP-error: report too long");
+        return ERROR;
+    }
+
+    if (id->queueDepth >= CWOP_QUEUE_MAX)
+    {
+        report = (CWOP_REPORT *)radListRemoveFirst (&id->queue);
+        radMsgLog (PRI_MEDIUM, "CWOP: queue full, dropping the oldest report");
+        free (report);
+        id->queueDepth --;
+        id->dropped ++;
+    }
+
+    report = (CWOP_REPORT *)malloc (sizeof (*report));
+    if (report == NULL)
+    {
+        radMsgLog (PRI_HIGH, "CWOP-error: cannot allocate report");
+        return ERROR;
+    }
+
+    report->queued = time (NULL);
+    report->queuedMS = radTimeGetMSSinceEpoch ();
+    strcpy (report->packet, packet);
+    radListAddToEnd (&id->queue, (NODE_PTR)report);
+    id->queueDepth ++;
+    statusUpdateStat(CWOP_STATS_QUEUE_DEPTH, id->queueDepth);
+
+    if (id->state == CWOP_SESSION_DISCONNECTED && id->queueDepth > 1)
+    {
+        radMsgLog (PRI_MEDIUM, "CWOP: not connected, %d reports queued", id->queueDepth);
+    }
+
+    Service (id);
+    return OK;
+}
+
+void cwopSessionExit (CWOP_SESSION_ID id)
+{
+    CWOP_REPORT     *report;
+
+    if (id->queueDepth > 0)
+    {
+        radMsgLog (PRI_MEDIUM, "CWOP: %d queued reports not sent", id->queueDepth);
+    }
+
+    if (id->socket != NULL)
+    {
+        radProcessIODeRegisterDescriptorByFd (id->fd);
+        radSocketDestroy (id->socket);
+        id->socket = NULL;
+    }
+
+    radTimerDelete (id->timer);
+
+    for (report = (CWOP_REPORT *)radListRemoveFirst (&id->queue);
+         report != NULL;
+         report = (CWOP_REPORT *)radListRemoveFirst (&id->queue))
+    {
+        free (report);
+    }
+    id->queueDepth = 0;
+}
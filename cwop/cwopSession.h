@@ -0,0 +1,131 @@
+#ifndef INC_cwopSessionh
+#define INC_cwopSessionh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        cwopSession.h
+
+  PURPOSE:
+        Provide the wvcwopd APRS-IS session definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        Reports are queued and sent over one logged in APRS-IS connection.
+        The session waits for the server banner before the login and for the
+        "# logresp" line (or CWOP_LOGIN_WAIT) before the first report, sends
+        queued reports at least CWOP_REPLAY_SPACING apart and keeps an idle
+        connection alive with a comment line every CWOP_KEEPALIVE_INTERVAL.
+        A server which goes quiet for CWOP_RX_TIMEOUT (servers send a comment
+        line every 20 seconds or so) is considered lost.
+
+        Failed connects try the next server and back off exponentially from
+        CWOP_BACKOFF_MIN to CWOP_BACKOFF_MAX. Reports wait in the queue while
+        disconnected: at most CWOP_QUEUE_MAX, each for up to CWOP_QUEUE_MAX_AGE
+        since its timestamp is the time it was made.
+
+        Without CWOP_PERSISTENT_CONNECTION the session disconnects once the
+        queue is empty, as wvcwopd always used to.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radlist.h>
+#include <radtimers.h>
+#include <radsocket.h>
+
+
+/*  ... API definitions
+*/
+#define CWOP_NUM_SERVERS                3
+#define CWOP_MAX_PACKET                 256
+#define CWOP_RX_BUFFER                  512
+
+#define CWOP_LOGIN_WAIT                 5           // seconds
+#define CWOP_REPLAY_SPACING             5           // seconds between reports
+#define CWOP_KEEPALIVE_INTERVAL         120         // seconds
+#define CWOP_RX_TIMEOUT                 180         // seconds
+#define CWOP_BACKOFF_MIN                15          // seconds
+#define CWOP_BACKOFF_MAX                960         // seconds
+#define CWOP_QUEUE_MAX                  24
+#define CWOP_QUEUE_MAX_AGE              (2*WV_SECONDS_IN_HOUR)
+
+typedef enum
+{
+    CWOP_SESSION_DISCONNECTED       = 0,
+    CWOP_SESSION_WAIT_BANNER,
+    CWOP_SESSION_WAIT_LOGRESP,
+    CWOP_SESSION_READY
+} CWOP_SESSION_STATE;
+
+typedef struct
+{
+    NODE            node;
+    time_t          queued;
+    ULONGLONG       queuedMS;
+    char            packet[CWOP_MAX_PACKET];
+} CWOP_REPORT;
+
+typedef struct
+{
+    char                server[CWOP_NUM_SERVERS][128];
+    int                 port[CWOP_NUM_SERVERS];
+    int                 serverIndex;                // current/next to try
+    char                login[CWOP_MAX_PACKET];
+    int                 isPersistent;
+    TIMER_ID            timer;
+    RADSOCK_ID          socket;
+    int                 fd;
+    CWOP_SESSION_STATE  state;
+    char                rxBuffer[CWOP_RX_BUFFER];
+    int                 rxLength;
+    time_t              stateTime;                  // when 'state' was entered
+    time_t              lastRx;
+    time_t              lastTx;
+    time_t              nextConnect;
+    int                 backoff;
+    RADLIST             queue;                      // oldest first
+    int                 queueDepth;
+    ULONG               dropped;
+} CWOP_SESSION, *CWOP_SESSION_ID;
+
+
+/* ... API function prototypes
+*/
+
+// 'login' is the APRS-IS login line without the CR/LF; the process must
+// have a free radlib timer; returns OK or ERROR
+extern int cwopSessionInit
+(
+    CWOP_SESSION_ID id,
+    char            *servers[CWOP_NUM_SERVERS],
+    int             ports[CWOP_NUM_SERVERS],
+    const char      *login,
+    int             isPersistent
+);
+
+// queue a report (without the CR/LF) and send it as soon as the session
+// allows; returns OK or ERROR
+extern int cwopSessionSend (CWOP_SESSION_ID id, const char *packet);
+
+extern void cwopSessionExit (CWOP_SESSION_ID id);
+
+#endif
@@ -0,0 +1,603 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        cwopTest.c
+
+  PURPOSE:
+        Run the wvcwopd APRS-IS session against a loopback server stand-in
+        ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The stand-in is a forked APRS-IS server on a 127.0.0.1 port with one
+        child per connection. It sends a banner, answers the login line with
+        a logresp and logs each connection, login, keepalive and report to a
+        shared file. A report containing "drop" makes it close the
+        connection after logging it.
+
+        The radProcess event loop is replaced by a poll loop over the
+        session socket and its timer. The session's clock (time) is moved
+        forward to the timer expiry whenever the loop is idle, so the login
+        waits, report spacing, backoff and receive timeout take no real
+        time. With a persistent session:
+            - it connects and logs in at init
+            - reports reuse the logged in connection, CWOP_REPLAY_SPACING
+              apart
+            - an idle session sends a keepalive and reconnects to a server
+              which stays quiet for CWOP_RX_TIMEOUT
+            - a dropped connection is reconnected to the next server after
+              the backoff, and the reports made meanwhile are sent
+        Without persistence a report connects, logs in, is sent and the
+        session disconnects.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+
+/*  ... Local include files
+*/
+#include <cwop.h>
+
+
+/*  ... local memory
+*/
+
+#define TEST_LOGIN              "user WVTEST pass -1 vers wview 5.20.0"
+#define TEST_IDLE_MS            50          // real time before the clock jumps
+#define TEST_TIMEOUT_SECS       60
+
+static char         testDir[64];
+static char         testLogFile[128];
+static pid_t        testPid;
+static int          testPort;
+static int          testFailures;
+
+static CWOP_SESSION testSession;
+
+// the radProcess and clock stand-in state:
+static int          testFd = -1;
+static void         (*testCallback) (int fd, void *userData);
+static void         *testUserData;
+static int          testTimer;
+static ULONGLONG    testTimerExpiry;            // 0 when stopped
+static void         (*testTimerRoutine) (void *parm);
+static void         *testTimerParm;
+static ULONGLONG    testClockOffsetMS;
+
+
+//  ... stand-ins for wvutils and the status file
+
+int wvstrncpy (char *d, const char *s, size_t bufsize)
+{
+    snprintf (d, bufsize, "%s", s);
+    return strlen (s);
+}
+
+void wvutilsLogEvent (int priority, char *format, ...)
+{
+    return;
+}
+
+int statusUpdateStat (int index, int value)
+{
+    return OK;
+}
+
+int statusIncrementStat (int index)
+{
+    return OK;
+}
+
+int statusUpdateMessage (const char *message)
+{
+    return OK;
+}
+
+
+//  ... stand-ins for the clock, the radProcess timer and descriptors
+
+static ULONGLONG testNowMS (void)
+{
+    struct timeval      tv;
+
+    gettimeofday (&tv, NULL);
+    return ((ULONGLONG)tv.tv_sec * 1000ULL) + (tv.tv_usec / 1000) + testClockOffsetMS;
+}
+
+time_t time (time_t *result)
+{
+    time_t              now = (time_t)(testNowMS () / 1000);
+
+    if (result != NULL)
+    {
+        *result = now;
+    }
+    return now;
+}
+
+TIMER_ID radTimerCreate (TIMER_ID timer, void (*routine) (void *parm), void *parm)
+{
+    testTimerRoutine    = routine;
+    testTimerParm       = parm;
+    testTimerExpiry     = 0;
+    return (TIMER_ID)&testTimer;
+}
+
+void radTimerDelete (TIMER_ID timer)
+{
+    testTimerExpiry = 0;
+    testTimerRoutine = NULL;
+    return;
+}
+
+void radProcessTimerStart (TIMER_ID timer, ULONG time)
+{
+    testTimerExpiry = testNowMS () + time;
+    return;
+}
+
+void radProcessTimerStop (TIMER_ID timer)
+{
+    testTimerExpiry = 0;
+    return;
+}
+
+int radProcessIORegisterDescriptor
+(
+    int             fd,
+    void            (*callback) (int fd, void *userData),
+    void            *userData
+)
+{
+    testFd          = fd;
+    testCallback    = callback;
+    testUserData    = userData;
+    return OK;
+}
+
+int radProcessIODeRegisterDescriptorByFd (int fd)
+{
+    if (fd != testFd)
+    {
+        return ERROR;
+    }
+
+    testFd = -1;
+    return OK;
+}
+
+
+//  ... the APRS-IS stand-in
+
+static void standInLog (const char *format, const char *arg)
+{
+    char            line[512];
+    int             fd, length;
+
+    length = snprintf (line, sizeof (line), format, arg);
+    fd = open (testLogFile, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd >= 0)
+    {
+        if (write (fd, line, length) != length)
+        {
+            exit (1);
+        }
+        close (fd);
+    }
+    return;
+}
+
+static void standInWrite (int fd, const char *line)
+{
+    int             length = strlen (line);
+
+    if (write (fd, line, length) != length)
+    {
+        exit (0);
+    }
+    return;
+}
+
+static void standInSession (int fd)
+{
+    char            buffer[1024], *line, *end;
+    int             length = 0, count;
+
+    standInLog ("CONN\n", "");
+    standInWrite (fd, "# aprsc stand-in\r\n");
+
+    for (;;)
+    {
+        count = read (fd, &buffer[length], sizeof (buffer) - 1 - length);
+        if (count <= 0)
+        {
+            exit (0);
+        }
+        length += count;
+        buffer[length] = 0;
+
+        for (line = buffer; (end = strstr (line, "\r\n")) != NULL; line = end + 2)
+        {
+            *end = 0;
+            if (! strncmp (line, "user ", 5))
+            {
+                standInLog ("LOGIN %s\n", line);
+                standInWrite (fd, "# logresp WVTEST unverified, server STANDIN\r\n");
+            }
+            else if (line[0] == '#')
+            {
+                standInLog ("KEEPALIVE %s\n", line);
+            }
+            else
+            {
+                standInLog ("PKT %s\n", line);
+                if (strstr (line, "drop") != NULL)
+                {
+                    exit (0);
+                }
+            }
+        }
+
+        length -= (line - buffer);
+        memmove (buffer, line, length);
+    }
+}
+
+static void standInRun (int listenFd)
+{
+    int             fd;
+
+    signal (SIGPIPE, SIG_IGN);
+    signal (SIGCHLD, SIG_IGN);
+    signal (SIGTERM, SIG_DFL);
+
+    for (;;)
+    {
+        if ((fd = accept (listenFd, NULL, NULL)) < 0)
+        {
+            continue;
+        }
+
+        if (fork () == 0)
+        {
+            close (listenFd);
+            standInSession (fd);
+        }
+        close (fd);
+    }
+}
+
+static int standInStart (void)
+{
+    int                 fd;
+    struct sockaddr_in  addr;
+    socklen_t           length = sizeof (addr);
+
+    fd = socket (AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return ERROR;
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_addr.s_addr    = htonl (INADDR_LOOPBACK);
+    addr.sin_port           = 0;
+    if (bind (fd, (struct sockaddr *)&addr, sizeof (addr)) < 0 ||
+        listen (fd, 4) < 0 ||
+        getsockname (fd, (struct sockaddr *)&addr, &length) < 0)
+    {
+        close (fd);
+        return ERROR;
+    }
+    testPort = ntohs (addr.sin_port);
+
+    testPid = fork ();
+    if (testPid < 0)
+    {
+        close (fd);
+        return ERROR;
+    }
+    else if (testPid == 0)
+    {
+        // the sessions share its process group so they stop with it:
+        setpgid (0, 0);
+        standInRun (fd);
+        exit (0);
+    }
+
+    setpgid (testPid, testPid);
+    close (fd);
+    return OK;
+}
+
+static void standInStop (void)
+{
+    if (testPid > 0)
+    {
+        kill (0 - testPid, SIGTERM);
+        kill (testPid, SIGTERM);
+        waitpid (testPid, NULL, 0);
+        testPid = 0;
+    }
+    return;
+}
+
+static int standInCount (const char *what)
+{
+    FILE            *file = fopen (testLogFile, "r");
+    char            line[512];
+    int             count = 0;
+
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    while (fgets (line, sizeof (line), file) != NULL)
+    {
+        if (!strncmp (line, what, strlen (what)))
+        {
+            count ++;
+        }
+    }
+
+    fclose (file);
+    return count;
+}
+
+
+// wait (in real time) for the stand-in to log 'count' lines of 'what':
+static int standInWait (const char *what, int count)
+{
+    int             i;
+
+    for (i = 0; i < 1000 / TEST_IDLE_MS; i ++)
+    {
+        if (standInCount (what) >= count)
+        {
+            break;
+        }
+        usleep (TEST_IDLE_MS * 1000);
+    }
+
+    return standInCount (what);
+}
+
+
+//  ... the session, driven the way the radProcess loop drives it
+
+// run the event loop until 'done' returns TRUE or 'maxSecs' pass on the
+// session clock; the clock jumps to the timer expiry when nothing arrives
+static int runUntil (int (*done) (void), int maxSecs)
+{
+    struct pollfd   pfd;
+    ULONGLONG       end = testNowMS () + (ULONGLONG)maxSecs * 1000ULL;
+    int             isInput;
+
+    while (! (*done) ())
+    {
+        if (testNowMS () >= end)
+        {
+            return ERROR;
+        }
+
+        isInput = FALSE;
+        if (testFd >= 0)
+        {
+            pfd.fd      = testFd;
+            pfd.events  = POLLIN;
+            pfd.revents = 0;
+            isInput = (poll (&pfd, 1, TEST_IDLE_MS) > 0);
+        }
+        else
+        {
+            usleep (TEST_IDLE_MS * 1000);
+        }
+
+        if (isInput)
+        {
+            (*testCallback) (testFd, testUserData);
+            continue;
+        }
+
+        if (testTimerExpiry != 0)
+        {
+            if (testTimerExpiry > testNowMS ())
+            {
+                testClockOffsetMS += testTimerExpiry - testNowMS ();
+            }
+            testTimerExpiry = 0;
+            (*testTimerRoutine) (testTimerParm);
+        }
+    }
+
+    return OK;
+}
+
+static int isReady (void)
+{
+    return (testSession.state == CWOP_SESSION_READY);
+}
+
+static int isSent (void)
+{
+    return (testSession.state == CWOP_SESSION_READY && testSession.queueDepth == 0);
+}
+
+static int isDisconnected (void)
+{
+    return (testSession.state == CWOP_SESSION_DISCONNECTED);
+}
+
+static int isDone (void)
+{
+    return (testSession.state == CWOP_SESSION_DISCONNECTED && testSession.queueDepth == 0);
+}
+
+static int isKeptAlive (void)
+{
+    return (standInCount ("KEEPALIVE") > 0);
+}
+
+static int isReconnected (void)
+{
+    return (standInCount ("CONN") == 2 && isReady ());
+}
+
+static void check (int condition, char *what)
+{
+    printf ("cwopTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static void checkPersistent (void)
+{
+    char            *servers[CWOP_NUM_SERVERS];
+    int             i, ports[CWOP_NUM_SERVERS];
+    time_t          startTime;
+
+    for (i = 0; i < CWOP_NUM_SERVERS; i ++)
+    {
+        servers[i] = "127.0.0.1";
+        ports[i] = testPort;
+    }
+
+    check (cwopSessionInit (&testSession, servers, ports, TEST_LOGIN, TRUE) == OK &&
+           runUntil (isReady, 30) == OK &&
+           standInCount ("CONN") == 1 && standInCount ("LOGIN " TEST_LOGIN) == 1,
+           "logs in at init");
+
+    cwopSessionSend (&testSession, "WVTEST>APRS,TCPIP*:@report1");
+    runUntil (isSent, 30);
+    startTime = time (NULL);
+    cwopSessionSend (&testSession, "WVTEST>APRS,TCPIP*:@report2");
+    cwopSessionSend (&testSession, "WVTEST>APRS,TCPIP*:@report3");
+    check (runUntil (isSent, 30) == OK && standInWait ("PKT WVTEST>APRS,TCPIP*:@report", 3) == 3,
+           "reports are delivered");
+    check (standInCount ("CONN") == 1 && standInCount ("LOGIN") == 1,
+           "and reuse the logged in connection");
+    check (time (NULL) - startTime >= CWOP_REPLAY_SPACING, "queued reports are spaced out");
+
+    // idle until the keepalive, then the quiet server is given up on:
+    check (runUntil (isKeptAlive, CWOP_KEEPALIVE_INTERVAL + 10) == OK &&
+           standInCount ("CONN") == 1,
+           "an idle session sends keepalives");
+    startTime = time (NULL);
+    check (runUntil (isReconnected, CWOP_RX_TIMEOUT + CWOP_BACKOFF_MIN + 10) == OK &&
+           standInCount ("LOGIN") == 2 && testSession.serverIndex == 1,
+           "a quiet server is replaced after the rx timeout");
+
+    // the server drops us; a report made meanwhile waits for the reconnect:
+    cwopSessionSend (&testSession, "WVTEST>APRS,TCPIP*:@drop");
+    runUntil (isDisconnected, 30);
+    startTime = time (NULL);
+    cwopSessionSend (&testSession, "WVTEST>APRS,TCPIP*:@report4");
+    check (testSession.queueDepth == 1 && testSession.socket == NULL,
+           "reports made while dropped are queued");
+    check (runUntil (isSent, CWOP_BACKOFF_MAX) == OK &&
+           standInCount ("CONN") == 3 && standInCount ("LOGIN") == 3 &&
+           standInWait ("PKT WVTEST>APRS,TCPIP*:@report4", 1) == 1 &&
+           testSession.serverIndex == 2,
+           "and sent after reconnecting to the next server");
+    check (time (NULL) - startTime >= CWOP_BACKOFF_MIN, "reconnect waits out the backoff");
+
+    cwopSessionExit (&testSession);
+    return;
+}
+
+static void checkOneShot (void)
+{
+    char            *servers[CWOP_NUM_SERVERS];
+    int             i, ports[CWOP_NUM_SERVERS];
+
+    for (i = 0; i < CWOP_NUM_SERVERS; i ++)
+    {
+        servers[i] = "127.0.0.1";
+        ports[i] = testPort;
+    }
+
+    check (cwopSessionInit (&testSession, servers, ports, TEST_LOGIN, FALSE) == OK &&
+           standInCount ("CONN") == 3,
+           "no connection at init without persistence");
+
+    cwopSessionSend (&testSession, "WVTEST>APRS,TCPIP*:@report5");
+    check (runUntil (isDone, 30) == OK && testSession.socket == NULL &&
+           standInCount ("CONN") == 4 && standInCount ("LOGIN") == 4 &&
+           standInWait ("PKT WVTEST>APRS,TCPIP*:@report5", 1) == 1,
+           "a report connects, logs in, sends and closes");
+
+    cwopSessionExit (&testSession);
+    return;
+}
+
+
+int main (int argc, char *argv[])
+{
+    char            command[128];
+
+    alarm (TEST_TIMEOUT_SECS);
+    signal (SIGPIPE, SIG_IGN);
+
+    snprintf (testDir, sizeof (testDir), "/tmp/cwopTest.%d", (int)getpid ());
+    if (mkdir (testDir, 0755) != 0)
+    {
+        printf ("cwopTest: cannot create %s\n", testDir);
+        return 1;
+    }
+    sprintf (testLogFile, "%s/server.log", testDir);
+
+    if (standInStart () == ERROR)
+    {
+        printf ("cwopTest: cannot start the stand-in: %s\n", strerror (errno));
+        return 1;
+    }
+
+    checkPersistent ();
+    checkOneShot ();
+
+    standInStop ();
+
+    sprintf (command, "rm -rf %s", testDir);
+    if (system (command) != 0)
+    {
+        printf ("cwopTest: cannot remove %s\n", testDir);
+    }
+
+    printf ("cwopTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
@@ -0,0 +1,364 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        export.c
+
+  PURPOSE:
+        Provide the wview database export daemon entry point.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        Replaces the cron driven wview-mysql-export/wview-pgsql-export
+        scripts: tails the archive, HILOW and NOAA tables and streams new
+        rows to the configured sink every STATION_SQLDB_EXPORT_INTERVAL
+        seconds.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <signal.h>
+
+/*  ... Library include files
+*/
+#include <radsystem.h>
+
+/*  ... Local include files
+*/
+#include <export.h>
+
+
+/*  ... global memory declarations
+*/
+
+/*  ... global memory referenced
+*/
+
+/*  ... static (local) memory declarations
+*/
+static EXPORT_WORK      exportWork;
+
+static char*            exportStatusLabels[STATUS_STATS_MAX] =
+{
+    "Rows exported",
+    "Rows/sec (last run)",
+    "Export lag (secs)",
+    "Export errors"
+};
+
+/* ... methods
+*/
+/*  ... system initialization
+*/
+static int exportSysInit (EXPORT_WORK *work)
+{
+    char            devPath[256];
+    struct stat     fileData;
+
+    /*  ... check for our daemon's pid file, don't run if it isn't there
+    */
+    sprintf (devPath, "%s/%s", WVIEW_RUN_DIR, WVD_LOCK_FILE_NAME);
+    if (stat (devPath, &fileData) != 0)
+    {
+        radMsgLogInit (PROC_NAME_EXPORT, TRUE, TRUE);
+        radMsgLog (PRI_CATASTROPHIC, 
+                   "wviewd process not running - aborting!");
+        radMsgLogExit ();
+        return ERROR;
+    }
+
+    sprintf (work->pidFile, "%s/%s", WVIEW_RUN_DIR, EXPORT_LOCK_FILE_NAME);
+    sprintf (work->fifoFile, "%s/dev/%s", WVIEW_RUN_DIR, PROC_NAME_EXPORT);
+    sprintf (work->statusFile, "%s/%s", WVIEW_STATUS_DIRECTORY, EXPORT_STATUS_FILE_NAME);
+    sprintf (work->daemonQname, "%s/dev/%s", WVIEW_RUN_DIR, PROC_NAME_DAEMON);
+
+    /*  ... check for our pid file, don't run if it IS there
+    */
+    if (stat (work->pidFile, &fileData) == 0)
+    {
+        radMsgLogInit (PROC_NAME_EXPORT, TRUE, TRUE);
+        radMsgLog (PRI_CATASTROPHIC, 
+                   "lock file %s exists, older copy may be running - aborting!",
+                   work->pidFile);
+        radMsgLogExit ();
+        return ERROR;
+    }
+
+    return OK;
+}
+
+/*  ... system exit
+*/
+static int exportSysExit (EXPORT_WORK *work)
+{
+    struct stat     fileData;
+
+    /*  ... delete our pid file
+    */
+    if (stat (work->pidFile, &fileData) == 0)
+    {
+        unlink (work->pidFile);
+    }
+
+    return OK;
+}
+
+
+static void exportDefaultSigHandler (int signum)
+{
+    int         retVal;
+
+    switch (signum)
+    {
+        case SIGHUP:
+            // user wants us to change the verbosity setting
+            retVal = wvutilsToggleVerbosity ();
+            radMsgLog (PRI_STATUS, "wvexportd: SIGHUP - toggling log verbosity %s",
+                       ((retVal == 0) ? "OFF" : "ON"));
+
+            radProcessSignalCatch(signum, exportDefaultSigHandler);
+            return;
+
+        case SIGPIPE:
+            // a client sink died - the write error is handled there
+            radProcessSignalCatch(signum, exportDefaultSigHandler);
+            return;
+
+        case SIGBUS:
+        case SIGFPE:
+        case SIGSEGV:
+        case SIGXFSZ:
+        case SIGSYS:
+            // unrecoverable radProcessSignalCatch- we must exit right now!
+            radMsgLog (PRI_CATASTROPHIC, 
+                       "wvexportd: recv unrecoverable signal %d: aborting!",
+                       signum);
+            if (!exportWork.exiting)
+            {
+                radTimerDelete (exportWork.timer);
+                exportSysExit (&exportWork);
+                radProcessExit ();
+                radSystemExit (WVIEW_SYSTEM_ID);
+            }
+            abort ();
+
+        case SIGCHLD:
+            // client sinks are child processes
+            radProcessSignalCatch(signum, exportDefaultSigHandler);
+            break;
+
+        default:
+            // we can allow the process to exit normally...
+            if (exportWork.exiting)
+            {
+                radProcessSignalCatch(signum, exportDefaultSigHandler);
+                return;
+            }
+        
+            radMsgLog (PRI_HIGH, "wvexportd: recv signal %d: exiting!", signum);
+        
+            exportWork.exiting = TRUE;
+            radProcessSetExitFlag ();
+        
+            radProcessSignalCatch(signum, exportDefaultSigHandler);
+            break;
+    }
+
+    return;
+}
+
+static void msgHandler
+(
+    char        *srcQueueName,
+    UINT        msgType,
+    void        *msg,
+    UINT        length,
+    void        *userData
+)
+{
+    return;
+}
+
+static void evtHandler
+(
+    UINT        eventsRx,
+    UINT        rxData,
+    void        *userData
+)
+{
+    return;
+}
+
+static void timerHandler (void *parm)
+{
+    exportUtilsExport (exportWork.exportId);
+
+    radProcessTimerStart (exportWork.timer, exportWork.exportId->interval * 1000);
+    return;
+}
+
+
+/*  ... the main entry point for the export process
+*/
+int main (int argc, char *argv[])
+{
+    void            (*alarmHandler)(int);
+    int             retVal;
+    FILE            *pidfile;
+    int             runAsDaemon = TRUE;
+
+    if (argc > 1)
+    {
+        if (!strcmp(argv[1], "-f"))
+        {
+            runAsDaemon = FALSE;
+        }
+    }
+
+    memset (&exportWork, 0, sizeof (exportWork));
+
+    /*  ... initialize some system stuff first
+    */
+    retVal = exportSysInit (&exportWork);
+    if (retVal == ERROR)
+    {
+        radMsgLogInit (PROC_NAME_EXPORT, FALSE, TRUE);
+        radMsgLog (PRI_CATASTROPHIC, "export init failed!");
+        radMsgLogExit ();
+        exit (1);
+    }
+    else if (retVal == ERROR_ABORT)
+    {
+        exit (2);
+    }
+
+
+    /*  ... call the global radlib system init function
+    */
+    if (radSystemInit (WVIEW_SYSTEM_ID) == ERROR)
+    {
+        radMsgLogInit (PROC_NAME_EXPORT, TRUE, TRUE);
+        radMsgLog (PRI_CATASTROPHIC, "radSystemInit failed!");
+        radMsgLogExit ();
+        exit (1);
+    }
+
+
+    /*  ... call the radlib process init function
+    */
+    if (radProcessInit (PROC_NAME_EXPORT,
+                        exportWork.fifoFile,
+                        PROC_NUM_TIMERS_EXPORT,
+                        runAsDaemon,                // TRUE for daemon
+                        msgHandler,
+                        evtHandler,
+                        NULL)
+        == ERROR)
+    {
+        printf ("\nradProcessInit failed: %s\n\n", PROC_NAME_EXPORT);
+        radSystemExit (WVIEW_SYSTEM_ID);
+        exit (1);
+    }
+
+    exportWork.myPid = getpid ();
+    pidfile = fopen (exportWork.pidFile, "w");
+    if (pidfile == NULL)
+    {
+        radMsgLog (PRI_CATASTROPHIC, "lock file create failed!");
+        radProcessExit ();
+        radSystemExit (WVIEW_SYSTEM_ID);
+        exit (1);
+    }
+    fprintf (pidfile, "%d", getpid ());
+    fclose (pidfile);
+
+
+    alarmHandler = radProcessSignalGetHandler (SIGALRM);
+    radProcessSignalCatchAll (exportDefaultSigHandler);
+    radProcessSignalCatch (SIGALRM, alarmHandler);
+    radProcessSignalRelease(SIGABRT);
+
+
+    exportWork.timer = radTimerCreate (NULL, timerHandler, NULL);
+    if (exportWork.timer == NULL)
+    {
+        radMsgLog (PRI_HIGH, "radTimerCreate failed - exiting");
+        exportSysExit (&exportWork);
+        radProcessExit ();
+        radSystemExit (WVIEW_SYSTEM_ID);
+        exit (1);
+    }
+
+    //  ... initialize the export engine
+    retVal = exportUtilsInit (&exportWork.exportData);
+    if (retVal != OK)
+    {
+        if (retVal == ERROR)
+        {
+            radMsgLog (PRI_HIGH, "exportUtilsInit failed - exiting");
+        }
+        radTimerDelete (exportWork.timer);
+        exportSysExit (&exportWork);
+        radProcessExit ();
+        radSystemExit (WVIEW_SYSTEM_ID);
+        exit (1);
+    }
+    else
+    {
+        exportWork.exportId = &exportWork.exportData;
+    }
+
+    if (statusInit(exportWork.statusFile, exportStatusLabels) == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "statusInit failed - exiting...");
+        exportUtilsExit (exportWork.exportId);
+        exportSysExit (&exportWork);
+        radProcessExit ();
+        radSystemExit (WVIEW_SYSTEM_ID);
+        exit (1);
+    }
+    statusUpdate(STATUS_BOOTING);
+
+    //  ... start THE timer
+    radMsgLog (PRI_STATUS, "EXPORT: starting exports in %d secs", EXPORT_START_DELAY/1000);
+    radProcessTimerStart (exportWork.timer, EXPORT_START_DELAY);
+
+    statusUpdate(STATUS_RUNNING);
+    statusUpdateMessage("Normal operation");
+
+
+    while (!exportWork.exiting)
+    {
+        /*  ... wait on timers, events, file descriptors, msgs, everything!
+        */
+        if (radProcessWait (0) == ERROR)
+        {
+            exportWork.exiting = TRUE;
+        }
+    }
+
+
+    statusUpdateMessage("exiting normally");
+    radMsgLog (PRI_STATUS, "exiting normally...");
+    statusUpdate(STATUS_SHUTDOWN);
+
+    exportUtilsExit (exportWork.exportId);
+    radTimerDelete (exportWork.timer);
+    exportSysExit (&exportWork);
+    radProcessExit ();
+    radSystemExit (WVIEW_SYSTEM_ID);
+    exit (0);
+}
+
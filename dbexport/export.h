@@ -0,0 +1,84 @@
+#ifndef INC_exporth
+#define INC_exporth
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        export.h
+
+  PURPOSE:
+        Provide the wview database export daemon definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <string.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radsemaphores.h>
+#include <radbuffers.h>
+#include <radqueue.h>
+#include <radtimers.h>
+#include <radevents.h>
+#include <radtimeUtils.h>
+#include <radsysutils.h>
+#include <radprocess.h>
+
+/*  ... Local include files
+*/
+#include <exportUtils.h>
+
+
+
+/*  ... API definitions
+*/
+#define EXPORT_START_DELAY          15000       // ms
+
+/*  !!!!!!!!!!!!!!!!!!  HIDDEN, NOT FOR API USE  !!!!!!!!!!!!!!!!!!
+*/
+
+typedef struct
+{
+    pid_t           myPid;
+    char            pidFile[128];
+    char            fifoFile[128];
+    char            statusFile[128];
+    char            daemonQname[128];
+    TIMER_ID        timer;
+    EXPORT_DATA     exportData;
+    EXPORT_ID       exportId;
+    int             exiting;
+} EXPORT_WORK;
+
+/*  !!!!!!!!!!!!!!!!!!!!  END HIDDEN SECTION  !!!!!!!!!!!!!!!!!!!!!
+*/
+
+
+
+/* ... API function prototypes
+*/
+
+
+
+#endif
@@ -0,0 +1,517 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        exportSinks.c
+
+  PURPOSE:
+        Provide the wvexportd output sinks.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The client sinks start one mysql/psql process for each export run
+        and send it every batch of the run. A pipe write only proves the
+        data reached the pipe, so confirm closes the client and checks its
+        exit status: both clients exit non-zero when they cannot connect
+        or a statement fails, and the open transaction is then rolled
+        back by the server. A client that dies mid-run is restarted with
+        the next batch, but the run is not confirmed.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <errno.h>
+#include <sys/wait.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+
+/*  ... Local include files
+*/
+#include <exportSinks.h>
+
+
+/*  ... static (local) memory declarations
+*/
+static const char       *sinkNames[EXPORT_SINK_MAX] =
+{
+    "csv",
+    "sql",
+    "mysql",
+    "pgsql"
+};
+
+
+//  ... local utilities
+
+// config values end up on a shell command line inside single quotes:
+static int isShellSafe (const char *value)
+{
+    return (strchr (value, '\'') == NULL);
+}
+
+static int writeColumnList (FILE *file, EXPORT_SINK_ID sink)
+{
+    int         i;
+
+    for (i = 0; i < sink->numColumns; i ++)
+    {
+        if (fprintf (file, "%s%s", ((i > 0) ? "," : ""), sink->columns[i]) < 0)
+            return ERROR;
+    }
+
+    return OK;
+}
+
+static int writeValueList (FILE *file, EXPORT_SINK_ID sink, const char **values)
+{
+    const char  *cp;
+    int         i;
+
+    for (i = 0; i < sink->numColumns; i ++)
+    {
+        if (i > 0)
+            fputc (',', file);
+
+        if (values[i] == NULL)
+        {
+            fputs ("NULL", file);
+            continue;
+        }
+
+        fputc ('\'', file);
+        for (cp = values[i]; *cp; cp ++)
+        {
+            if (*cp == '\'')
+                fputc ('\'', file);
+            fputc (*cp, file);
+        }
+        fputc ('\'', file);
+    }
+
+    return (ferror (file) ? ERROR : OK);
+}
+
+// dateTime is the key of every exported table:
+static const char *getDateTime (EXPORT_SINK_ID sink, const char **values)
+{
+    int         i;
+
+    for (i = 0; i < sink->numColumns; i ++)
+    {
+        if (!strcmp (sink->columns[i], "dateTime"))
+            return ((values[i] != NULL) ? values[i] : "0");
+    }
+
+    return "0";
+}
+
+static int setBatch
+(
+    EXPORT_SINK_ID  sink,
+    const char      *table,
+    const char      **columns,
+    int             numColumns
+)
+{
+    wvstrncpy (sink->table, table, sizeof(sink->table));
+    sink->columns = columns;
+    sink->numColumns = numColumns;
+    return OK;
+}
+
+static int flushFile (EXPORT_SINK_ID sink)
+{
+    if (fflush (sink->file) != 0 || ferror (sink->file))
+    {
+        radMsgLog (PRI_HIGH, "%s sink: write failed: %s", sink->name, strerror(errno));
+        return ERROR;
+    }
+
+    return OK;
+}
+
+
+//  ... CSV sink
+
+static int csvOpen (EXPORT_SINK_ID sink)
+{
+    return OK;
+}
+
+static int csvBeginBatch
+(
+    EXPORT_SINK_ID  sink,
+    const char      *table,
+    const char      **columns,
+    int             numColumns
+)
+{
+    char            fileName[_MAX_PATH];
+
+    setBatch (sink, table, columns, numColumns);
+
+    sprintf (fileName, "%s/%s.csv", sink->config.directory, table);
+    sink->file = fopen (fileName, "a");
+    if (sink->file == NULL)
+    {
+        radMsgLog (PRI_HIGH, "csv sink: cannot open %s: %s", fileName, strerror(errno));
+        return ERROR;
+    }
+
+    // remember where the batch starts so it can be cut off again:
+    fseek (sink->file, 0, SEEK_END);
+    sink->batchStart = ftell (sink->file);
+    return OK;
+}
+
+static int csvWriteRow (EXPORT_SINK_ID sink, const char **values)
+{
+    int             i;
+
+    for (i = 0; i < sink->numColumns; i ++)
+    {
+        fprintf (sink->file, "%s%s",
+                 ((i > 0) ? "," : ""),
+                 ((values[i] != NULL) ? values[i] : "\\N"));
+    }
+    fputc ('\n', sink->file);
+
+    return (ferror (sink->file) ? ERROR : OK);
+}
+
+static int csvEndBatch (EXPORT_SINK_ID sink)
+{
+    int             retVal = flushFile (sink);
+
+    fclose (sink->file);
+    sink->file = NULL;
+    return retVal;
+}
+
+static void csvAbortBatch (EXPORT_SINK_ID sink)
+{
+    fflush (sink->file);
+    if (sink->batchStart >= 0 &&
+        ftruncate (fileno (sink->file), (off_t)sink->batchStart) != 0)
+    {
+        radMsgLog (PRI_HIGH, "csv sink: cannot remove the abandoned %s rows: %s",
+                   sink->table, strerror(errno));
+    }
+
+    fclose (sink->file);
+    sink->file = NULL;
+}
+
+// the csv and sql sinks have the batch once endBatch has flushed it:
+static int fileConfirm (EXPORT_SINK_ID sink)
+{
+    return OK;
+}
+
+static void csvClose (EXPORT_SINK_ID sink)
+{
+    if (sink->file != NULL)
+    {
+        fclose (sink->file);
+        sink->file = NULL;
+    }
+}
+
+
+//  ... SQL script sink
+
+static int sqlOpen (EXPORT_SINK_ID sink)
+{
+    char            fileName[_MAX_PATH];
+
+    sprintf (fileName, "%s/%s", sink->config.directory, EXPORT_SQL_SCRIPT_NAME);
+    sink->file = fopen (fileName, "a");
+    if (sink->file == NULL)
+    {
+        radMsgLog (PRI_HIGH, "sql sink: cannot open %s: %s", fileName, strerror(errno));
+        return ERROR;
+    }
+
+    return OK;
+}
+
+static int sqlBeginBatch
+(
+    EXPORT_SINK_ID  sink,
+    const char      *table,
+    const char      **columns,
+    int             numColumns
+)
+{
+    setBatch (sink, table, columns, numColumns);
+
+    if (sink->file == NULL && sink->open (sink) == ERROR)
+    {
+        return ERROR;
+    }
+
+    fprintf (sink->file, "BEGIN;\n");
+    return (ferror (sink->file) ? ERROR : OK);
+}
+
+// DELETE then INSERT is understood by both MySQL and PostgreSQL:
+static int sqlWriteRow (EXPORT_SINK_ID sink, const char **values)
+{
+    fprintf (sink->file, "DELETE FROM %s WHERE dateTime = %s;\nINSERT INTO %s (",
+             sink->table, getDateTime (sink, values), sink->table);
+    writeColumnList (sink->file, sink);
+    fprintf (sink->file, ") VALUES (");
+    writeValueList (sink->file, sink, values);
+    fprintf (sink->file, ");\n");
+
+    return (ferror (sink->file) ? ERROR : OK);
+}
+
+static int sqlEndBatch (EXPORT_SINK_ID sink)
+{
+    fprintf (sink->file, "COMMIT;\n");
+    if (flushFile (sink) == ERROR)
+    {
+        sink->close (sink);
+        return ERROR;
+    }
+
+    return OK;
+}
+
+static void sqlAbortBatch (EXPORT_SINK_ID sink)
+{
+    fprintf (sink->file, "ROLLBACK;\n");
+    if (flushFile (sink) == ERROR)
+    {
+        sink->close (sink);
+    }
+}
+
+static void sqlClose (EXPORT_SINK_ID sink)
+{
+    if (sink->file != NULL)
+    {
+        fclose (sink->file);
+        sink->file = NULL;
+    }
+}
+
+
+//  ... MySQL/PostgreSQL client sinks
+
+static int clientOpen (EXPORT_SINK_ID sink)
+{
+    char            command[_MAX_PATH*2];
+    EXPORT_SINK_CONFIG  *cfg = &sink->config;
+
+    if (!isShellSafe (cfg->host) || !isShellSafe (cfg->username) ||
+        !isShellSafe (cfg->database))
+    {
+        radMsgLog (PRI_HIGH, "%s sink: invalid database host, username or name",
+                   sink->name);
+        return ERROR;
+    }
+
+    // pass the password in the environment, not on the command line:
+    if (!strcmp (sink->name, "mysql"))
+    {
+        setenv ("MYSQL_PWD", cfg->password, 1);
+        sprintf (command,
+                 "mysql --batch --silent --host='%s' --user='%s' '%s' > /dev/null",
+                 cfg->host, cfg->username, cfg->database);
+    }
+    else
+    {
+        setenv ("PGPASSWORD", cfg->password, 1);
+        sprintf (command,
+                 "psql --quiet --no-psqlrc -v ON_ERROR_STOP=1 --host='%s' --username='%s' '%s' > /dev/null",
+                 cfg->host, cfg->username, cfg->database);
+    }
+
+    sink->file = popen (command, "w");
+    if (sink->file == NULL)
+    {
+        radMsgLog (PRI_HIGH, "%s sink: cannot start client: %s", sink->name, strerror(errno));
+        return ERROR;
+    }
+
+    wvutilsLogEvent (PRI_STATUS, "%s sink: client started for %s/%s",
+                     sink->name, cfg->host, cfg->database);
+    return OK;
+}
+
+static int clientBeginBatch
+(
+    EXPORT_SINK_ID  sink,
+    const char      *table,
+    const char      **columns,
+    int             numColumns
+)
+{
+    setBatch (sink, table, columns, numColumns);
+
+    if (sink->file == NULL && sink->open (sink) == ERROR)
+    {
+        return ERROR;
+    }
+
+    fprintf (sink->file, "%s;\n",
+             (!strcmp (sink->name, "mysql") ? "START TRANSACTION" : "BEGIN"));
+    return (ferror (sink->file) ? ERROR : OK);
+}
+
+static int mysqlWriteRow (EXPORT_SINK_ID sink, const char **values)
+{
+    fprintf (sink->file, "REPLACE INTO %s (", sink->table);
+    writeColumnList (sink->file, sink);
+    fprintf (sink->file, ") VALUES (");
+    writeValueList (sink->file, sink, values);
+    fprintf (sink->file, ");\n");
+
+    return (ferror (sink->file) ? ERROR : OK);
+}
+
+// wait for the client to run what it was sent and exit:
+static void clientClose (EXPORT_SINK_ID sink)
+{
+    int             status;
+
+    if (sink->file == NULL)
+    {
+        return;
+    }
+
+    status = pclose (sink->file);
+    sink->file = NULL;
+
+    if (status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        radMsgLog (PRI_HIGH, "%s sink: client exited with status %d - "
+                             "export run not confirmed",
+                   sink->name,
+                   ((status != -1 && WIFEXITED(status)) ? WEXITSTATUS(status) : -1));
+        sink->failed = TRUE;
+    }
+}
+
+static int clientEndBatch (EXPORT_SINK_ID sink)
+{
+    fprintf (sink->file, "COMMIT;\n");
+    if (flushFile (sink) == ERROR)
+    {
+        // the client died - restart it with the next batch
+        sink->failed = TRUE;
+        clientClose (sink);
+        return ERROR;
+    }
+
+    return OK;
+}
+
+static void clientAbortBatch (EXPORT_SINK_ID sink)
+{
+    fprintf (sink->file, "ROLLBACK;\n");
+    if (flushFile (sink) == ERROR)
+    {
+        sink->failed = TRUE;
+        clientClose (sink);
+    }
+}
+
+static int clientConfirm (EXPORT_SINK_ID sink)
+{
+    int             retVal;
+
+    clientClose (sink);
+    retVal = (sink->failed ? ERROR : OK);
+    sink->failed = FALSE;
+    return retVal;
+}
+
+
+//  ... define methods here
+
+int exportSinkGetType (const char *name)
+{
+    int             i;
+
+    for (i = 0; i < EXPORT_SINK_MAX; i ++)
+    {
+        if (!strcasecmp (name, sinkNames[i]))
+            return i;
+    }
+
+    return ERROR;
+}
+
+int exportSinkInit
+(
+    EXPORT_SINK         *sink,
+    EXPORT_SINK_TYPE    type,
+    EXPORT_SINK_CONFIG  *config
+)
+{
+    memset (sink, 0, sizeof (*sink));
+    sink->config = *config;
+
+    switch (type)
+    {
+        case EXPORT_SINK_CSV:
+            sink->open          = csvOpen;
+            sink->beginBatch    = csvBeginBatch;
+            sink->writeRow      = csvWriteRow;
+            sink->endBatch      = csvEndBatch;
+            sink->abortBatch    = csvAbortBatch;
+            sink->confirm       = fileConfirm;
+            sink->close         = csvClose;
+            break;
+
+        case EXPORT_SINK_SQL:
+            sink->open          = sqlOpen;
+            sink->beginBatch    = sqlBeginBatch;
+            sink->writeRow      = sqlWriteRow;
+            sink->endBatch      = sqlEndBatch;
+            sink->abortBatch    = sqlAbortBatch;
+            sink->confirm       = fileConfirm;
+            sink->close         = sqlClose;
+            break;
+
+        case EXPORT_SINK_MYSQL:
+            sink->open          = clientOpen;
+            sink->beginBatch    = clientBeginBatch;
+            sink->writeRow      = mysqlWriteRow;
+            sink->endBatch      = clientEndBatch;
+            sink->abortBatch    = clientAbortBatch;
+            sink->confirm       = clientConfirm;
+            sink->close         = clientClose;
+            break;
+
+        case EXPORT_SINK_PGSQL:
+            sink->open          = clientOpen;
+            sink->beginBatch    = clientBeginBatch;
+            sink->writeRow      = sqlWriteRow;
+            sink->endBatch      = clientEndBatch;
+            sink->abortBatch    = clientAbortBatch;
+            sink->confirm       = clientConfirm;
+            sink->close         = clientClose;
+            break;
+
+        default:
+            return ERROR;
+    }
+
+    sink->name = sinkNames[type];
+    return OK;
+}
@@ -0,0 +1,128 @@
+#ifndef INC_exportsinksh
+#define INC_exportsinksh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        exportSinks.h
+
+  PURPOSE:
+        Define the wvexportd output sink interface.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        A sink receives the rows of one table at a time in batches:
+            beginBatch (table, column names)
+            writeRow   (column values, NULL for SQL NULL) ...
+            endBatch   - commit the batch
+        or
+            abortBatch - roll the batch back
+        and after the batches of an export run
+            confirm    - OK only if every batch ended since the last confirm
+                         is stored; the export markers advance only then
+        Rows are always sent in ascending dateTime order and may repeat rows
+        sent before (HILOW and NOAA rows are updated in place), so every
+        sink replaces rather than appends by dateTime.
+
+        Sink types:
+            csv     - one <table>.csv per table in the export directory,
+                      appended (same format as the old sqlite3 CLI exports)
+            sql     - one wview-export.sql script in the export directory,
+                      appended, with portable DELETE/INSERT per row
+            mysql   - stream REPLACE statements into a mysql client process
+                      for each export run, confirmed by its exit status
+            pgsql   - stream DELETE/INSERT statements into a psql client
+                      process for each export run, confirmed by its exit
+                      status
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <string.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+
+
+/*  ... API definitions
+*/
+#define EXPORT_MAX_COLUMNS          128
+#define EXPORT_SQL_SCRIPT_NAME      "wview-export.sql"
+
+typedef enum
+{
+    EXPORT_SINK_CSV             = 0,
+    EXPORT_SINK_SQL,
+    EXPORT_SINK_MYSQL,
+    EXPORT_SINK_PGSQL,
+    EXPORT_SINK_MAX
+} EXPORT_SINK_TYPE;
+
+typedef struct
+{
+    char            directory[_MAX_PATH];       // csv and sql sinks
+    char            host[128];                  // client sinks
+    char            username[64];
+    char            password[64];
+    char            database[64];
+} EXPORT_SINK_CONFIG;
+
+typedef struct _exportSink
+{
+    const char      *name;
+    int             (*open) (struct _exportSink *sink);
+    int             (*beginBatch)
+                    (
+                        struct _exportSink  *sink,
+                        const char          *table,
+                        const char          **columns,
+                        int                 numColumns
+                    );
+    int             (*writeRow) (struct _exportSink *sink, const char **values);
+    int             (*endBatch) (struct _exportSink *sink);
+    void            (*abortBatch) (struct _exportSink *sink);
+    int             (*confirm) (struct _exportSink *sink);
+    void            (*close) (struct _exportSink *sink);
+
+    // private:
+    EXPORT_SINK_CONFIG  config;
+    FILE            *file;
+    long            batchStart;                 // csv file offset
+    int             failed;                     // since the last confirm
+    char            table[64];
+    const char      **columns;
+    int             numColumns;
+} EXPORT_SINK, *EXPORT_SINK_ID;
+
+
+/* ... API function prototypes
+*/
+
+// map a configured sink name ("csv", "sql", "mysql" or "pgsql") to its type;
+// returns the type or ERROR
+extern int exportSinkGetType (const char *name);
+
+// initialize 'sink' with the methods for 'type'; returns OK or ERROR
+extern int exportSinkInit
+(
+    EXPORT_SINK         *sink,
+    EXPORT_SINK_TYPE    type,
+    EXPORT_SINK_CONFIG  *config
+);
+
+#endif
@@ -0,0 +1,498 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        exportTest.c
+
+  PURPOSE:
+        Run the wvexportd export engine against the csv file sink
+        ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        Scratch archive, HILOW and NOAA databases are built under /tmp and
+        exportUtilsInit is run with stand-ins for the wview configuration
+        and paths, so the real table list, marker files and csv sink are
+        used.
+
+        The runs check that only new rows are exported (plus the HILOW and
+        NOAA rewind windows), then that the markers never move past rows
+        the sink did not store: with the export directory missing, with a
+        row write failing part way through a table and with the run not
+        confirmed. A final run must catch up with every table.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radtimeUtils.h>
+
+/*  ... Local include files
+*/
+#include <exportUtils.h>
+
+
+/*  ... local memory
+*/
+
+#define TEST_START_TIME         1798761600  // 01/01/2027 00:00 UTC
+#define TEST_ARCHIVE_INTERVAL   300
+#define TEST_BATCH_SIZE         7
+#define TEST_FAIL_ROW           10          // archive row write that fails
+
+typedef struct
+{
+    const char      *dbName;
+    const char      *table;
+    const char      *create;
+    int             interval;
+    int             rewind;
+    int             rows;                   // rows inserted so far
+} TEST_TABLE;
+
+static TEST_TABLE   testTables[] =
+{
+    { WVIEW_ARCHIVE_DATABASE, "archive",
+      "CREATE TABLE archive (dateTime INTEGER PRIMARY KEY, usUnits INTEGER, "
+      "interval INTEGER, outTemp REAL)",
+      TEST_ARCHIVE_INTERVAL, 0, 0 },
+    { WVIEW_HILOW_DATABASE, "outTemp",
+      "CREATE TABLE outTemp (dateTime INTEGER PRIMARY KEY, low REAL, "
+      "timeLow INTEGER, high REAL, timeHigh INTEGER)",
+      WV_SECONDS_IN_HOUR, WV_SECONDS_IN_HOUR, 0 },
+    { WVIEW_NOAA_DATABASE, WVIEW_NOAA_TABLE,
+      "CREATE TABLE " WVIEW_NOAA_TABLE " (dateTime INTEGER PRIMARY KEY, "
+      "meanTemp REAL, highTemp REAL, lowTemp REAL)",
+      WV_SECONDS_IN_DAY, WV_SECONDS_IN_DAY, 0 }
+};
+#define TEST_TABLES     (int)(sizeof (testTables) / sizeof (testTables[0]))
+
+static char         testDir[64];
+static char         testArchivePath[128];
+static char         testConfigPath[128];
+static char         testCsvPath[128];
+static int          testStats[EXPORT_STATS_ERRORS + 1];
+static int          testWrites;
+static int          testFailures;
+
+static EXPORT_DATA  testData;
+static int          (*csvWriteRow) (EXPORT_SINK_ID sink, const char **values);
+static int          (*csvConfirm) (EXPORT_SINK_ID sink);
+
+
+//  ... stand-ins for the wview configuration, paths and status
+
+int wvconfigInit (int firstProcess)
+{
+    return OK;
+}
+
+void wvconfigExit (void)
+{
+    return;
+}
+
+int wvconfigGetBooleanValue (const char *configItem)
+{
+    return ((!strcmp (configItem, configItem_ENABLE_SQL)) ? TRUE : ERROR);
+}
+
+int wvconfigGetINTValue (const char *configItem)
+{
+    return ((!strcmp (configItem, configItem_STATION_SQLDB_EXPORT_BATCH)) ?
+            TEST_BATCH_SIZE : 0);
+}
+
+const char *wvconfigGetStringValue (const char *configItem)
+{
+    if (!strcmp (configItem, configItem_STATION_SQLDB_EXPORT_SINK))
+        return "csv";
+    if (!strcmp (configItem, configItem_STATION_SQLDB_EXPORT_DIRECTORY))
+        return testCsvPath;
+    return NULL;
+}
+
+int wvutilsSetVerbosity (USHORT daemonBitMask)
+{
+    return OK;
+}
+
+char *wvutilsGetArchivePath (void)
+{
+    return testArchivePath;
+}
+
+char *wvutilsGetConfigPath (void)
+{
+    return testConfigPath;
+}
+
+int wvutilsWriteMarkerFile (const char *filePath, time_t marker)
+{
+    FILE            *pFile = fopen (filePath, "w");
+
+    if (pFile == NULL)
+    {
+        return ERROR;
+    }
+
+    fprintf (pFile, "%lu", (ULONG)marker);
+    fclose (pFile);
+    return OK;
+}
+
+time_t wvutilsReadMarkerFile (const char *filePath)
+{
+    FILE            *pFile = fopen (filePath, "r");
+    ULONG           marker = 0;
+
+    if (pFile == NULL)
+    {
+        return (time_t)0;
+    }
+
+    if (fscanf (pFile, "%lu", &marker) != 1)
+    {
+        marker = 0;
+    }
+
+    fclose (pFile);
+    return (time_t)marker;
+}
+
+int wvstrncpy (char *d, const char *s, size_t bufsize)
+{
+    snprintf (d, bufsize, "%s", s);
+    return strlen (s);
+}
+
+void wvutilsLogEvent (int priority, char *format, ...)
+{
+    return;
+}
+
+int statusUpdateStat (int index, int value)
+{
+    if (index >= 0 && index <= EXPORT_STATS_ERRORS)
+    {
+        testStats[index] = value;
+    }
+    return OK;
+}
+
+
+//  ... sink failures
+
+static int failingWriteRow (EXPORT_SINK_ID sink, const char **values)
+{
+    if (!strcmp (sink->table, "archive") && ++ testWrites == TEST_FAIL_ROW)
+    {
+        return ERROR;
+    }
+
+    return (*csvWriteRow) (sink, values);
+}
+
+static int failingConfirm (EXPORT_SINK_ID sink)
+{
+    return ERROR;
+}
+
+
+//  ... the scratch databases and csv files
+
+static void check (int condition, char *what)
+{
+    printf ("exportTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static time_t rowTime (TEST_TABLE *table, int row)
+{
+    return (time_t)(TEST_START_TIME + (row + 1) * table->interval);
+}
+
+// add 'rows' rows to 'table', creating its database the first time:
+static int addRows (TEST_TABLE *table, int rows)
+{
+    char            dbFile[256], query[256];
+    sqlite3         *db;
+    int             i, retVal = OK;
+
+    sprintf (dbFile, "%s/%s", testArchivePath, table->dbName);
+    if (sqlite3_open (dbFile, &db) != SQLITE_OK)
+    {
+        sqlite3_close (db);
+        return ERROR;
+    }
+
+    if (table->rows == 0)
+    {
+        sqlite3_exec (db, table->create, NULL, NULL, NULL);
+        if (!strcmp (table->dbName, WVIEW_HILOW_DATABASE))
+        {
+            sqlite3_exec (db, "CREATE TABLE " WVIEW_HILOW_META_TABLE
+                          " (name CHAR(64) PRIMARY KEY, value CHAR(64))",
+                          NULL, NULL, NULL);
+        }
+    }
+
+    sqlite3_exec (db, "BEGIN TRANSACTION", NULL, NULL, NULL);
+    for (i = 0; i < rows && retVal == OK; i ++)
+    {
+        sprintf (query, "INSERT INTO %s VALUES (%lu, 1, %d, 50.5%s)",
+                 table->table, (ULONG)rowTime (table, table->rows),
+                 table->rows,
+                 (!strcmp (table->table, "outTemp") ? ", 0" : ""));
+        if (sqlite3_exec (db, query, NULL, NULL, NULL) != SQLITE_OK)
+        {
+            printf ("exportTest: %s: %s\n", query, sqlite3_errmsg (db));
+            retVal = ERROR;
+        }
+        table->rows ++;
+    }
+    sqlite3_exec (db, "COMMIT TRANSACTION", NULL, NULL, NULL);
+
+    sqlite3_close (db);
+    return retVal;
+}
+
+static int countLines (TEST_TABLE *table, time_t *lastTime)
+{
+    char            fileName[256], line[256];
+    FILE            *file;
+    int             lines = 0;
+
+    sprintf (fileName, "%s/%s.csv", testCsvPath, table->table);
+    *lastTime = 0;
+    if ((file = fopen (fileName, "r")) == NULL)
+    {
+        return 0;
+    }
+
+    while (fgets (line, sizeof (line), file) != NULL)
+    {
+        *lastTime = (time_t)strtoul (line, NULL, 10);
+        lines ++;
+    }
+
+    fclose (file);
+    return lines;
+}
+
+static time_t readMarker (TEST_TABLE *table)
+{
+    char            fileName[256];
+
+    sprintf (fileName, "%s/export/wvexportd_csv_%s_marker", testConfigPath, table->table);
+    return wvutilsReadMarkerFile (fileName);
+}
+
+// the rows a run should export for 'table' given its marker:
+static int expectedRows (TEST_TABLE *table, time_t marker)
+{
+    time_t          since = marker - table->rewind;
+    int             row, count = 0;
+
+    if (marker == 0)
+    {
+        return table->rows;
+    }
+
+    for (row = 0; row < table->rows; row ++)
+    {
+        if (rowTime (table, row) > since)
+        {
+            count ++;
+        }
+    }
+
+    return count;
+}
+
+// run one export and check every table against its old marker:
+static void runExport (char *what)
+{
+    time_t          markers[TEST_TABLES], lastTime;
+    int             lines[TEST_TABLES], i, isRight = TRUE;
+    char            label[128];
+
+    for (i = 0; i < TEST_TABLES; i ++)
+    {
+        markers[i] = readMarker (&testTables[i]);
+        lines[i] = countLines (&testTables[i], &lastTime);
+    }
+
+    exportUtilsExport (&testData);
+
+    for (i = 0; i < TEST_TABLES; i ++)
+    {
+        if (countLines (&testTables[i], &lastTime) - lines[i] !=
+                expectedRows (&testTables[i], markers[i]) ||
+            readMarker (&testTables[i]) != rowTime (&testTables[i], testTables[i].rows - 1) ||
+            lastTime != readMarker (&testTables[i]))
+        {
+            printf ("exportTest: %s: %s: %d rows, expected %d, marker %lu\n",
+                    what, testTables[i].table,
+                    countLines (&testTables[i], &lastTime) - lines[i],
+                    expectedRows (&testTables[i], markers[i]),
+                    (ULONG)readMarker (&testTables[i]));
+            isRight = FALSE;
+        }
+    }
+
+    snprintf (label, sizeof (label), "%s exports the new rows", what);
+    check (isRight, label);
+    return;
+}
+
+static int sameMarkers (time_t *markers)
+{
+    int             i;
+
+    for (i = 0; i < TEST_TABLES; i ++)
+    {
+        if (readMarker (&testTables[i]) != markers[i] ||
+            testData.sources[i].marker != markers[i] ||
+            testData.sources[i].pending != markers[i])
+        {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+static void getMarkers (time_t *markers)
+{
+    int             i;
+
+    for (i = 0; i < TEST_TABLES; i ++)
+    {
+        markers[i] = readMarker (&testTables[i]);
+    }
+    return;
+}
+
+
+int main (int argc, char *argv[])
+{
+    char            command[128], movedPath[128];
+    time_t          markers[TEST_TABLES], lastTime;
+    ULONGLONG       runTime;
+    int             lines, errors;
+
+    snprintf (testDir, sizeof (testDir), "/tmp/exportTest.%d", (int)getpid ());
+    sprintf (testArchivePath, "%s/archive", testDir);
+    sprintf (testConfigPath, "%s/config", testDir);
+    sprintf (testCsvPath, "%s/csv", testDir);
+    sprintf (movedPath, "%s/csv.moved", testDir);
+    sprintf (command, "%s/export", testConfigPath);
+    if (mkdir (testDir, 0755) != 0 || mkdir (testArchivePath, 0755) != 0 ||
+        mkdir (testConfigPath, 0755) != 0 || mkdir (command, 0755) != 0 ||
+        mkdir (testCsvPath, 0755) != 0)
+    {
+        printf ("exportTest: cannot create %s\n", testDir);
+        return 1;
+    }
+
+    addRows (&testTables[0], 40);
+    addRows (&testTables[1], 5);
+    addRows (&testTables[2], 3);
+
+    if (exportUtilsInit (&testData) != OK)
+    {
+        printf ("exportTest: exportUtilsInit failed\n");
+        return 1;
+    }
+    check (testData.numSources == TEST_TABLES &&
+           !strcmp (testData.sources[0].table, "archive") &&
+           !strcmp (testData.sources[1].table, "outTemp") &&
+           !strcmp (testData.sources[2].table, WVIEW_NOAA_TABLE),
+           "exportUtilsInit found the tables");
+
+    runTime = radTimeGetMSSinceEpoch ();
+    runExport ("first run");
+    runTime = radTimeGetMSSinceEpoch () - runTime;
+    printf ("exportTest: first run: %d rows in %llu ms\n",
+            testStats[EXPORT_STATS_ROWS], (unsigned long long)runTime);
+
+    runExport ("run with nothing new");
+    addRows (&testTables[0], 10);
+    addRows (&testTables[1], 1);
+    addRows (&testTables[2], 1);
+    runExport ("run with new rows");
+
+    // a missing export directory fails every table:
+    addRows (&testTables[0], 5);
+    getMarkers (markers);
+    errors = testData.errors;
+    rename (testCsvPath, movedPath);
+    exportUtilsExport (&testData);
+    rename (movedPath, testCsvPath);
+    check (sameMarkers (markers), "missing directory leaves the markers");
+    check (testData.errors == errors + TEST_TABLES &&
+           testStats[EXPORT_STATS_ERRORS] == testData.errors,
+           "missing directory counts the errors");
+
+    // a row write failing in the second archive batch keeps the first:
+    addRows (&testTables[0], 10);
+    getMarkers (markers);
+    lines = countLines (&testTables[0], &lastTime);
+    csvWriteRow = testData.sink.writeRow;
+    testData.sink.writeRow = failingWriteRow;
+    testWrites = 0;
+    exportUtilsExport (&testData);
+    testData.sink.writeRow = csvWriteRow;
+    check (countLines (&testTables[0], &lastTime) - lines == TEST_BATCH_SIZE &&
+           lastTime == readMarker (&testTables[0]),
+           "failed batch is cut from the csv file");
+    check (readMarker (&testTables[0]) == markers[0] + TEST_BATCH_SIZE * TEST_ARCHIVE_INTERVAL,
+           "marker stops at the last stored batch");
+
+    // an unconfirmed run moves nothing:
+    addRows (&testTables[0], 3);
+    addRows (&testTables[1], 1);
+    getMarkers (markers);
+    csvConfirm = testData.sink.confirm;
+    testData.sink.confirm = failingConfirm;
+    exportUtilsExport (&testData);
+    check (sameMarkers (markers), "unconfirmed run leaves the markers");
+
+    // then everything is caught up:
+    testData.sink.confirm = csvConfirm;
+    runExport ("recovery run");
+    check (testStats[EXPORT_STATS_LAG] == 0, "recovery run leaves no lag");
+
+    exportUtilsExit (&testData);
+
+    sprintf (command, "rm -rf %s", testDir);
+    if (system (command) != 0)
+    {
+        printf ("exportTest: cannot remove %s\n", testDir);
+    }
+
+    printf ("exportTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
@@ -0,0 +1,445 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        exportUtils.c
+
+  PURPOSE:
+        Provide the wvexportd incremental export engine.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The wview databases are read with their own read-only sqlite3
+        connections so the tables can be walked with one prepared statement
+        regardless of their column layout.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+
+/*  ... Local include files
+*/
+#include <exportUtils.h>
+
+
+/*  ... static (local) memory declarations
+*/
+#define EXPORT_BUSY_TIMEOUT         5000        // ms
+
+
+//  ... local utilities
+
+static void addSource
+(
+    EXPORT_ID       id,
+    const char      *dbName,
+    const char      *table,
+    int             rewindSeconds
+)
+{
+    EXPORT_SOURCE   *source;
+
+    if (id->numSources >= EXPORT_MAX_SOURCES)
+    {
+        radMsgLog (PRI_MEDIUM, "exportUtils: too many tables - %s not exported", table);
+        return;
+    }
+
+    source = &id->sources[id->numSources ++];
+    sprintf (source->dbFile, "%s/%s", wvutilsGetArchivePath(), dbName);
+    wvstrncpy (source->table, table, sizeof(source->table));
+    source->rewindSeconds = rewindSeconds;
+    sprintf (source->markerFile, "%s/export/wvexportd_%s_%s_marker",
+             wvutilsGetConfigPath(), id->sink.name, table);
+    source->marker = wvutilsReadMarkerFile (source->markerFile);
+    source->pending = source->marker;
+}
+
+static sqlite3 *openDatabase (const char *dbFile)
+{
+    sqlite3         *db;
+
+    if (sqlite3_open_v2 (dbFile, &db, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK)
+    {
+        radMsgLog (PRI_HIGH, "exportUtils: failed to open %s: %s",
+                   dbFile, ((db != NULL) ? sqlite3_errmsg(db) : "no memory"));
+        sqlite3_close (db);
+        return NULL;
+    }
+
+    sqlite3_busy_timeout (db, EXPORT_BUSY_TIMEOUT);
+    return db;
+}
+
+// the HILOW database has one table per sensor (plus the metainfo table):
+static int addHiLowSources (EXPORT_ID id)
+{
+    char            dbFile[_MAX_PATH];
+    sqlite3         *db;
+    sqlite3_stmt    *stmt;
+
+    sprintf (dbFile, "%s/%s", wvutilsGetArchivePath(), WVIEW_HILOW_DATABASE);
+    db = openDatabase (dbFile);
+    if (db == NULL)
+    {
+        return ERROR;
+    }
+
+    if (sqlite3_prepare_v2 (db,
+                            "SELECT name FROM sqlite_master WHERE type = 'table' AND name != '"
+                            WVIEW_HILOW_META_TABLE "' ORDER BY name",
+                            -1, &stmt, NULL)
+        != SQLITE_OK)
+    {
+        radMsgLog (PRI_HIGH, "exportUtils: HILOW table query failed: %s", sqlite3_errmsg(db));
+        sqlite3_close (db);
+        return ERROR;
+    }
+
+    while (sqlite3_step (stmt) == SQLITE_ROW)
+    {
+        addSource (id, WVIEW_HILOW_DATABASE, (const char *)sqlite3_column_text (stmt, 0),
+                   WV_SECONDS_IN_HOUR);
+    }
+
+    sqlite3_finalize (stmt);
+    sqlite3_close (db);
+    return OK;
+}
+
+static time_t getNewest (sqlite3 *db, const char *table)
+{
+    char            query[256];
+    sqlite3_stmt    *stmt;
+    time_t          newest = 0;
+
+    sprintf (query, "SELECT MAX(dateTime) FROM %s", table);
+    if (sqlite3_prepare_v2 (db, query, -1, &stmt, NULL) != SQLITE_OK)
+    {
+        return 0;
+    }
+
+    if (sqlite3_step (stmt) == SQLITE_ROW)
+    {
+        newest = (time_t)sqlite3_column_int64 (stmt, 0);
+    }
+
+    sqlite3_finalize (stmt);
+    return newest;
+}
+
+// export one table; returns the number of rows sent or ERROR
+static int exportSource (EXPORT_ID id, EXPORT_SOURCE *source)
+{
+    char            query[256];
+    sqlite3         *db;
+    sqlite3_stmt    *stmt;
+    char            names[EXPORT_MAX_COLUMNS][64];
+    const char      *columns[EXPORT_MAX_COLUMNS];
+    const char      *values[EXPORT_MAX_COLUMNS];
+    int             i, numColumns, timeColumn = -1, rows, total = 0, rc;
+    int             inBatch;
+    time_t          since, lastTime;
+
+    db = openDatabase (source->dbFile);
+    if (db == NULL)
+    {
+        return ERROR;
+    }
+
+    source->newest = getNewest (db, source->table);
+    if (source->newest <= source->marker && source->rewindSeconds == 0)
+    {
+        // nothing new
+        sqlite3_close (db);
+        return 0;
+    }
+
+    sprintf (query, "SELECT * FROM %s WHERE dateTime > ? ORDER BY dateTime ASC LIMIT ?",
+             source->table);
+    if (sqlite3_prepare_v2 (db, query, -1, &stmt, NULL) != SQLITE_OK)
+    {
+        radMsgLog (PRI_HIGH, "exportUtils: %s query failed: %s", source->table, sqlite3_errmsg(db));
+        sqlite3_close (db);
+        return ERROR;
+    }
+
+    numColumns = sqlite3_column_count (stmt);
+    if (numColumns > EXPORT_MAX_COLUMNS)
+    {
+        radMsgLog (PRI_HIGH, "exportUtils: %s has too many columns", source->table);
+        sqlite3_finalize (stmt);
+        sqlite3_close (db);
+        return ERROR;
+    }
+    for (i = 0; i < numColumns; i ++)
+    {
+        // copy - the name pointers do not survive a reprepare:
+        wvstrncpy (names[i], sqlite3_column_name (stmt, i), sizeof(names[i]));
+        columns[i] = names[i];
+        if (!strcmp (columns[i], "dateTime"))
+            timeColumn = i;
+    }
+    if (timeColumn < 0)
+    {
+        radMsgLog (PRI_HIGH, "exportUtils: %s has no dateTime column", source->table);
+        sqlite3_finalize (stmt);
+        sqlite3_close (db);
+        return ERROR;
+    }
+
+    since = ((source->marker > source->rewindSeconds) ?
+             source->marker - source->rewindSeconds : 0);
+
+    do
+    {
+        sqlite3_bind_int64 (stmt, 1, (sqlite3_int64)since);
+        sqlite3_bind_int (stmt, 2, id->batchSize);
+
+        rows = 0;
+        inBatch = FALSE;
+        lastTime = since;
+        while ((rc = sqlite3_step (stmt)) == SQLITE_ROW)
+        {
+            if (! inBatch)
+            {
+                if (id->sink.beginBatch (&id->sink, source->table, columns, numColumns) == ERROR)
+                {
+                    rc = SQLITE_ERROR;
+                    break;
+                }
+                inBatch = TRUE;
+            }
+
+            for (i = 0; i < numColumns; i ++)
+            {
+                values[i] = (const char *)sqlite3_column_text (stmt, i);
+            }
+            lastTime = (time_t)sqlite3_column_int64 (stmt, timeColumn);
+
+            if (id->sink.writeRow (&id->sink, values) == ERROR)
+            {
+                rc = SQLITE_ERROR;
+                break;
+            }
+            rows ++;
+        }
+        sqlite3_reset (stmt);
+
+        if (rc != SQLITE_DONE)
+        {
+            // the batch is abandoned and rolled back; its rows stay pending
+            if (inBatch)
+                id->sink.abortBatch (&id->sink);
+            total = ERROR;
+            break;
+        }
+
+        if (inBatch)
+        {
+            if (id->sink.endBatch (&id->sink) == ERROR)
+            {
+                total = ERROR;
+                break;
+            }
+
+            // the marker advances when the sink confirms the run:
+            if (lastTime > source->pending)
+            {
+                source->pending = lastTime;
+            }
+            total += rows;
+        }
+
+        since = lastTime;
+    } while (rows == id->batchSize);
+
+    sqlite3_finalize (stmt);
+    sqlite3_close (db);
+    return total;
+}
+
+
+//  ... define methods here
+
+int exportUtilsInit (EXPORT_DATA *data)
+{
+    EXPORT_ID           id = (EXPORT_ID)data;
+    EXPORT_SINK_CONFIG  config;
+    const char          *sValue;
+    int                 iValue, type;
+
+    memset (id, 0, sizeof (*id));
+
+    if (wvconfigInit(FALSE) == ERROR)
+    {
+        radMsgLog (PRI_CATASTROPHIC, "wvconfigInit failed!\n");
+        return ERROR;
+    }
+
+    // Is database export enabled?
+    iValue = wvconfigGetBooleanValue(configItem_ENABLE_SQL);
+    if (iValue == ERROR || iValue == 0)
+    {
+        wvconfigExit ();
+        radMsgLog (PRI_STATUS, "export daemon disabled - exiting...");
+        return ERROR_ABORT;
+    }
+
+    // get the wview verbosity setting
+    if (wvutilsSetVerbosity (WV_VERBOSE_WVEXPORTD) == ERROR)
+    {
+        wvconfigExit ();
+        radMsgLog (PRI_CATASTROPHIC, "wvutilsSetVerbosity failed!");
+        return ERROR_ABORT;
+    }
+
+    memset (&config, 0, sizeof (config));
+
+    sValue = wvconfigGetStringValue(configItem_STATION_SQLDB_EXPORT_SINK);
+    type = exportSinkGetType ((sValue != NULL) ? sValue : "mysql");
+    if (type == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "exportUtilsInit: unknown export sink %s", sValue);
+        wvconfigExit ();
+        return ERROR;
+    }
+
+    sValue = wvconfigGetStringValue(configItem_STATION_SQLDB_EXPORT_DIRECTORY);
+    if (sValue == NULL || strlen(sValue) == 0)
+    {
+        sprintf (config.directory, "%s/export", wvutilsGetConfigPath());
+    }
+    else
+    {
+        wvstrncpy (config.directory, sValue, sizeof(config.directory));
+    }
+
+    sValue = wvconfigGetStringValue(configItem_STATION_SQLDB_HOST);
+    wvstrncpy (config.host, ((sValue != NULL) ? sValue : "localhost"), sizeof(config.host));
+    sValue = wvconfigGetStringValue(configItem_STATION_SQLDB_USERNAME);
+    wvstrncpy (config.username, ((sValue != NULL) ? sValue : ""), sizeof(config.username));
+    sValue = wvconfigGetStringValue(configItem_STATION_SQLDB_PASSWORD);
+    wvstrncpy (config.password, ((sValue != NULL) ? sValue : ""), sizeof(config.password));
+    sValue = wvconfigGetStringValue(configItem_STATION_SQLDB_DB_NAME);
+    wvstrncpy (config.database, ((sValue != NULL) ? sValue : ""), sizeof(config.database));
+
+    iValue = wvconfigGetINTValue(configItem_STATION_SQLDB_EXPORT_INTERVAL);
+    id->interval = ((iValue > 0) ? iValue : EXPORT_INTERVAL_DEFAULT);
+    iValue = wvconfigGetINTValue(configItem_STATION_SQLDB_EXPORT_BATCH);
+    id->batchSize = ((iValue > 0) ? iValue : EXPORT_BATCH_DEFAULT);
+
+    wvconfigExit ();
+
+    if (exportSinkInit (&id->sink, type, &config) == ERROR)
+    {
+        return ERROR;
+    }
+
+    // Build the table list:
+    addSource (id, WVIEW_ARCHIVE_DATABASE, "archive", 0);
+    if (addHiLowSources (id) == ERROR)
+    {
+        radMsgLog (PRI_MEDIUM, "exportUtilsInit: HILOW tables will not be exported");
+    }
+    addSource (id, WVIEW_NOAA_DATABASE, WVIEW_NOAA_TABLE, WV_SECONDS_IN_DAY);
+
+    if (id->sink.open (&id->sink) == ERROR)
+    {
+        // client sinks retry with each batch
+        radMsgLog (PRI_MEDIUM, "exportUtilsInit: %s sink not available yet", id->sink.name);
+    }
+    else if (id->sink.confirm (&id->sink) == ERROR)
+    {
+        // the client could not connect (nothing was sent, just check):
+        radMsgLog (PRI_MEDIUM, "exportUtilsInit: %s sink not available yet", id->sink.name);
+    }
+
+    radMsgLog (PRI_STATUS, "export: %d tables to %s sink every %d secs, %d rows per batch",
+               id->numSources, id->sink.name, id->interval, id->batchSize);
+
+    return OK;
+}
+
+void exportUtilsExport (EXPORT_ID id)
+{
+    ULONGLONG       startMS = radTimeGetMSSinceEpoch ();
+    ULONGLONG       elapsedMS;
+    EXPORT_SOURCE   *source;
+    int             i, rows, runRows = 0, lag = 0;
+
+    for (i = 0; i < id->numSources; i ++)
+    {
+        rows = exportSource (id, &id->sources[i]);
+        if (rows == ERROR)
+        {
+            id->errors ++;
+            statusUpdateStat(EXPORT_STATS_ERRORS, id->errors);
+            continue;
+        }
+
+        runRows += rows;
+    }
+
+    // only move the markers over rows the sink says it stored:
+    if (id->sink.confirm (&id->sink) == OK)
+    {
+        for (i = 0; i < id->numSources; i ++)
+        {
+            source = &id->sources[i];
+            if (source->pending > source->marker)
+            {
+                source->marker = source->pending;
+                wvutilsWriteMarkerFile (source->markerFile, source->marker);
+            }
+        }
+    }
+    else
+    {
+        for (i = 0; i < id->numSources; i ++)
+        {
+            id->sources[i].pending = id->sources[i].marker;
+        }
+        runRows = 0;
+        id->errors ++;
+        statusUpdateStat(EXPORT_STATS_ERRORS, id->errors);
+    }
+
+    for (i = 0; i < id->numSources; i ++)
+    {
+        if ((int)(id->sources[i].newest - id->sources[i].marker) > lag)
+        {
+            lag = (int)(id->sources[i].newest - id->sources[i].marker);
+        }
+    }
+
+    elapsedMS = radTimeGetMSSinceEpoch () - startMS;
+    id->totalRows += runRows;
+
+    statusUpdateStat(EXPORT_STATS_ROWS, id->totalRows);
+    if (runRows > 0)
+    {
+        statusUpdateStat(EXPORT_STATS_ROWS_PER_SEC,
+                         (int)((runRows * 1000ULL) / ((elapsedMS > 0) ? elapsedMS : 1)));
+        wvutilsLogEvent (PRI_STATUS, "export: %d rows in %llu ms", runRows, elapsedMS);
+    }
+    statusUpdateStat(EXPORT_STATS_LAG, lag);
+}
+
+void exportUtilsExit (EXPORT_ID id)
+{
+    id->sink.close (&id->sink);
+}
@@ -0,0 +1,109 @@
+#ifndef INC_exportutilsh
+#define INC_exportutilsh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        exportUtils.h
+
+  PURPOSE:
+        Provide the wvexportd incremental export engine definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        Each exported table keeps the dateTime of the last row the sink
+        accepted in a marker file (one per sink type and table), so a run
+        only reads the rows added since. HILOW rows are re-read from one hour
+        and NOAA rows from one day before the marker since wviewd updates
+        them in place.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <string.h>
+#include <sqlite3.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radtimeUtils.h>
+
+/*  ... Local include files
+*/
+#include <datadefs.h>
+#include <wvconfig.h>
+#include <status.h>
+#include <exportSinks.h>
+
+
+/*  ... API definitions
+*/
+#define EXPORT_MAX_SOURCES          32
+#define EXPORT_INTERVAL_DEFAULT     60          // seconds
+#define EXPORT_BATCH_DEFAULT        500         // rows
+
+
+/*  !!!!!!!!!!!!!!!!!!  HIDDEN, NOT FOR API USE  !!!!!!!!!!!!!!!!!!
+*/
+typedef enum
+{
+    EXPORT_STATS_ROWS           = 0,
+    EXPORT_STATS_ROWS_PER_SEC,
+    EXPORT_STATS_LAG,
+    EXPORT_STATS_ERRORS
+} EXPORT_STATS;
+
+typedef struct
+{
+    char            dbFile[_MAX_PATH];
+    char            table[64];
+    int             rewindSeconds;
+    char            markerFile[_MAX_PATH];
+    time_t          marker;                     // last dateTime exported
+    time_t          pending;                    // sent, not yet confirmed
+    time_t          newest;                     // newest dateTime in sqlite
+} EXPORT_SOURCE;
+
+typedef struct
+{
+    EXPORT_SINK     sink;
+    EXPORT_SOURCE   sources[EXPORT_MAX_SOURCES];
+    int             numSources;
+    int             interval;                   // seconds
+    int             batchSize;
+    int             totalRows;
+    int             errors;
+} EXPORT_DATA, *EXPORT_ID;
+
+/*  !!!!!!!!!!!!!!!!!!!!  END HIDDEN SECTION  !!!!!!!!!!!!!!!!!!!!!
+*/
+
+
+/* ... API function prototypes
+*/
+
+// read the export configuration and build the source table list;
+// returns OK, ERROR or ERROR_ABORT (export disabled)
+extern int exportUtilsInit (EXPORT_DATA *data);
+
+// export all rows added since the last run and update the status stats
+extern void exportUtilsExport (EXPORT_ID id);
+
+extern void exportUtilsExit (EXPORT_ID id);
+
+#endif
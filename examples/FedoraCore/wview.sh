@@ -30,6 +30,7 @@ CWOPD_BIN=$WVIEW_INSTALL_DIR/wvcwopd
 test -x $CWOPD_BIN || exit 9
 
 HTTP_BIN=$WVIEW_INSTALL_DIR/wvhttpd
+EXPORTD_BIN=$WVIEW_INSTALL_DIR/wvexportd
 
 SQLD_BIN=$WVIEW_INSTALL_DIR/wviewsqld
 
@@ -45,6 +46,7 @@ SSHD_PID=$RUN_DIRECTORY/wviewsshd.pid
 ALARMD_PID=$RUN_DIRECTORY/wvalarmd.pid
 CWOPD_PID=$RUN_DIRECTORY/wvcwopd.pid
 HTTP_PID=$RUN_DIRECTORY/wvhttpd.pid
+EXPORTD_PID=$RUN_DIRECTORY/wvexportd.pid
 SQLD_PID=$RUN_DIRECTORY/wviewsqld.pid
 RADROUTER_PID=$RUN_DIRECTORY/radmrouted.pid
 PMOND_PID=$RUN_DIRECTORY/wvpmond.pid
@@ -90,6 +92,11 @@ kill_running_processes() {
 		kill -15 `cat $HTTP_PID`
 		rm -f $HTTP_PID
 	fi
+	if [ -f $EXPORTD_PID ]; then
+		echo "wvexportd pid file $EXPORTD_PID exists - killing existing process"
+		kill -15 `cat $EXPORTD_PID`
+		rm -f $EXPORTD_PID
+	fi
 	if [ -f $PMOND_PID ]; then
 		echo "wvpmond pid file $PMOND_PID exists - killing existing process"
 		kill -15 `cat $PMOND_PID`
@@ -116,6 +123,7 @@ case "$1" in
 	$ALARMD_BIN
 	$CWOPD_BIN
 	$HTTP_BIN
+	$EXPORTD_BIN
 	$FTPD_BIN
 	$SSHD_BIN
     $PMOND_BIN
@@ -139,6 +147,7 @@ case "$1" in
 	strace -o $RUN_DIRECTORY/wvalarmd.trace $ALARMD_BIN -f &> /dev/null &
 	strace -o $RUN_DIRECTORY/wvcwopd.trace $CWOPD_BIN -f &> /dev/null &
 	strace -o $RUN_DIRECTORY/wvhttpd.trace $HTTP_BIN -f &> /dev/null &
+	strace -o $RUN_DIRECTORY/wvexportd.trace $EXPORTD_BIN -f &> /dev/null &
 	strace -o $RUN_DIRECTORY/wviewftpd.trace $FTPD_BIN -f &> /dev/null &
 	strace -o $RUN_DIRECTORY/wviewsshd.trace $SSHD_BIN -f &> /dev/null &
 	strace -o $RUN_DIRECTORY/wvpmond.trace $PMOND_BIN -f &> /dev/null &
@@ -151,6 +160,9 @@ case "$1" in
 	if [ -f $HTTP_PID ]; then
 	    kill -15 `cat $HTTP_PID`
 	fi
+	if [ -f $EXPORTD_PID ]; then
+	    kill -15 `cat $EXPORTD_PID`
+	fi
 	if [ -f $CWOPD_PID ]; then
 	    kill -15 `cat $CWOPD_PID`
 	fi
@@ -14,6 +14,7 @@ SSHD_BIN=$WVIEW_INSTALL_DIR/wviewsshd
 ALARMD_BIN=$WVIEW_INSTALL_DIR/wvalarmd
 CWOPD_BIN=$WVIEW_INSTALL_DIR/wvcwopd
 HTTP_BIN=$WVIEW_INSTALL_DIR/wvhttpd
+EXPORTD_BIN=$WVIEW_INSTALL_DIR/wvexportd
 SQLD_BIN=$WVIEW_INSTALL_DIR/wviewsqld
 RADROUTER_BIN=$WVIEW_INSTALL_DIR/radmrouted
 PMOND_BIN=$WVIEW_INSTALL_DIR/wvpmond
@@ -26,6 +27,7 @@ SSHD_PID=$RUN_DIRECTORY/wviewsshd.pid
 ALARMD_PID=$RUN_DIRECTORY/wvalarmd.pid
 CWOPD_PID=$RUN_DIRECTORY/wvcwopd.pid
 HTTP_PID=$RUN_DIRECTORY/wvhttpd.pid
+EXPORTD_PID=$RUN_DIRECTORY/wvexportd.pid
 SQLD_PID=$RUN_DIRECTORY/wviewsqld.pid
 RADROUTER_PID=$RUN_DIRECTORY/radmrouted.pid
 PMOND_PID=$RUN_DIRECTORY/wvpmond.pid
@@ -73,6 +75,11 @@ StartService ()
 		kill -15 `cat $HTTP_PID`
 		rm -f $HTTP_PID
 	fi
+	if [ -f $EXPORTD_PID ]; then
+		echo "wvexportd pid file $EXPORTD_PID exists - killing existing process"
+		kill -15 `cat $EXPORTD_PID`
+		rm -f $EXPORTD_PID
+	fi
 	if [ -f $SQLD_PID ]; then
 		echo "wviewsqld pid file $SQLD_PID exists - killing existing process"
 		kill -15 `cat $SQLD_PID`
@@ -97,6 +104,7 @@ StartService ()
 	$ALARMD_BIN
 	$CWOPD_BIN
 	$HTTP_BIN
+	$EXPORTD_BIN
 	$FTPD_BIN
 	$SSHD_BIN
     $PMOND_BIN
@@ -113,6 +121,9 @@ StopService ()
 	if [ -f $HTTP_PID ]; then
 	    kill -15 `cat $HTTP_PID`
 	fi
+	if [ -f $EXPORTD_PID ]; then
+	    kill -15 `cat $EXPORTD_PID`
+	fi
 	if [ -f $CWOPD_PID ]; then
 		kill -15 `cat $CWOPD_PID`
 	fi
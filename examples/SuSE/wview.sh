@@ -34,6 +34,7 @@ CWOPD_BIN=$WVIEW_INSTALL_DIR/wvcwopd
 test -x $CWOPD_BIN || exit 8
 
 HTTP_BIN=$WVIEW_INSTALL_DIR/wvhttpd
+EXPORTD_BIN=$WVIEW_INSTALL_DIR/wvexportd
 
 SQLD_BIN=$WVIEW_INSTALL_DIR/wviewsqld
 
@@ -51,6 +52,7 @@ SSHD_PID=$RUN_DIRECTORY/wviewsshd.pid
 ALARMD_PID=$RUN_DIRECTORY/wvalarmd.pid
 CWOPD_PID=$RUN_DIRECTORY/wvcwopd.pid
 HTTP_PID=$RUN_DIRECTORY/wvhttpd.pid
+EXPORTD_PID=$RUN_DIRECTORY/wvexportd.pid
 SQLD_PID=$RUN_DIRECTORY/wviewsqld.pid
 RADROUTER_PID=$RUN_DIRECTORY/radmrouted.pid
 PMOND_PID=$RUN_DIRECTORY/wvpmond.pid
@@ -106,6 +108,11 @@ case "$1" in
 		kill -15 `cat $HTTP_PID`
 		rm -f $HTTP_PID
 	fi
+	if [ -f $EXPORTD_PID ]; then
+		echo "wvexportd pid file $EXPORTD_PID exists - killing existing process"
+		kill -15 `cat $EXPORTD_PID`
+		rm -f $EXPORTD_PID
+	fi
 	if [ -f $PMOND_PID ]; then
 		echo "wvpmond pid file $PMOND_PID exists - killing existing process"
 		kill -15 `cat $PMOND_PID`
@@ -136,6 +143,7 @@ case "$1" in
 	/sbin/startproc -v $ALARMD_BIN
 	/sbin/startproc -v $CWOPD_BIN
     /sbin/startproc -v $HTTP_BIN
+    /sbin/startproc -v $EXPORTD_BIN
 	/sbin/startproc -v $FTPD_BIN
 	/sbin/startproc -v $SSHD_BIN
     /sbin/startproc -v $PMOND_BIN
@@ -148,6 +156,7 @@ case "$1" in
 	echo -n "Shutting down wview daemons"
 	/sbin/killproc -p $PMOND_PID -TERM $PMOND_BIN
     /sbin/killproc -p $HTTP_PID -TERM $HTTP_BIN
+    /sbin/killproc -p $EXPORTD_PID -TERM $EXPORTD_BIN
 	/sbin/killproc -p $CWOPD_PID -TERM $CWOPD_BIN
 	/sbin/killproc -p $ALARMD_PID -TERM $ALARMD_BIN
 	/sbin/killproc -p $SSHD_PID -TERM $SSHD_BIN
@@ -34,5 +34,42 @@ INSERT OR IGNORE INTO "config" VALUES('ALARMS_DO_TEST','no','Test an alarm by fa
 INSERT OR IGNORE INTO "config" VALUES('ALARMS_DO_TEST_NUMBER','1','Which alarm (1 - 10) to test:','ENABLE_ALARMS');
 INSERT OR IGNORE INTO "config" VALUES('HTMLGEN_STATION_SHOW_IF','yes','Show interface details:','ENABLE_HTMLGEN');
 INSERT OR IGNORE INTO "config" VALUES('HTTP_WURAPIDFIRE', 'no', 'Use RapidFire for WUNDERGROUND', 'ENABLE_HTTP');
+INSERT OR IGNORE INTO "config" VALUES('STATION_VMULTI_HOSTS','','Upstream wview datafeed servers (VirtualMulti only) - host:port,host:port (empty uses STATION_HOST:STATION_PORT):',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_VMULTI_POLICY','priority','LOOP merge policy (VirtualMulti only) - one of priority, freshest, average:',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_VMULTI_FIELD_PRIORITY','','Per-field source overrides for priority policy (VirtualMulti only) - field:source,... (e.g. outTemp:2,UV:3):',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_VMULTI_STALE_SECS','120','Seconds without LOOP data before an upstream source is ignored (VirtualMulti only):',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_SIM_BENCH_RATE','0','Simulator benchmark mode LOOP packets per second (Simulator only, 1 - 10000, 0 disables):',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_SIM_BENCH_COMPRESSION','1','Simulator benchmark time compression (simulated seconds per real second, Simulator only):',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_SIM_BENCH_DAYS','365','Simulator benchmark days of archive history to generate (Simulator only):',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_SIM_BENCH_HTML_FILE','','Simulator benchmark HTML file to watch for regeneration latency (Simulator only, empty disables):',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_CAPTURE_FILE','','Station medium capture file - records all station traffic for later replay (empty disables):',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_REPLAY_FILE','','Station medium replay file - plays a capture file back in place of the station (empty disables):',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_REPLAY_SPEED','1.0','Station medium replay speed (multiple of recorded speed, 0 for as fast as possible):',NULL);
+INSERT OR IGNORE INTO "config" VALUES('ENABLE_SQL','no','Run export daemon to copy archive, HILOW and NOAA data to a MySQL/PostgreSQL server or export files?',NULL);
+INSERT OR IGNORE INTO "config" VALUES('STATION_SQLDB_HOST','localhost','Database server hostname or IP address:','ENABLE_SQL');
+INSERT OR IGNORE INTO "config" VALUES('STATION_SQLDB_USERNAME','wvuser','Database server username:','ENABLE_SQL');
+INSERT OR IGNORE INTO "config" VALUES('STATION_SQLDB_PASSWORD','wvpasswd','Database server password:','ENABLE_SQL');
+INSERT OR IGNORE INTO "config" VALUES('STATION_SQLDB_DB_NAME','wviewDB','Database name where export data are stored:','ENABLE_SQL');
+INSERT OR IGNORE INTO "config" VALUES('STATION_SQLDB_EXPORT_SINK','mysql','Export sink: mysql, pgsql (stream to the database server), csv or sql (append CSV or SQL script files):','ENABLE_SQL');
+INSERT OR IGNORE INTO "config" VALUES('STATION_SQLDB_EXPORT_DIRECTORY','','Directory for csv/sql export files (empty for $prefix/etc/wview/export):','ENABLE_SQL');
+INSERT OR IGNORE INTO "config" VALUES('STATION_SQLDB_EXPORT_INTERVAL','60','How often to export new data (seconds):','ENABLE_SQL');
+INSERT OR IGNORE INTO "config" VALUES('STATION_SQLDB_EXPORT_BATCH','500','Rows per export transaction:','ENABLE_SQL');
+INSERT OR IGNORE INTO "config" VALUES('FTP_PARALLEL_TRANSFERS','4','Number of files to transfer at once (1 to 8):','ENABLE_FTP');
+INSERT OR IGNORE INTO "config" VALUES('SSH_PERSISTENT_CONNECTION','yes','Keep one ssh connection open per remote host and send all of its rules together:','ENABLE_SSH');
+INSERT OR IGNORE INTO "config" VALUES('CWOP_PERSISTENT_CONNECTION','yes','Keep the APRS-IS connection open between reports and queue reports while the servers are unreachable:','ENABLE_CWOP');
+INSERT OR IGNORE INTO "config" VALUES('PROCMON_ALERT_RSS_KB','65536','Send an email alert when a daemon uses more than this many KB of memory (0 disables):','ENABLE_PROCMON');
+INSERT OR IGNORE INTO "config" VALUES('PROCMON_ALERT_FDS','256','Send an email alert when a daemon has more than this many open files (0 disables):','ENABLE_PROCMON');
+INSERT OR IGNORE INTO "config" VALUES('PROCMON_ALERT_POLL_MS','5000','Send an email alert when a daemon takes more than this many ms to answer a poll (0 disables):','ENABLE_PROCMON');
+INSERT OR IGNORE INTO "config" VALUES('PROCMON_ALERT_HTML_GEN_MS','60000','Send an email alert when htmlgend takes more than this many ms to generate (0 disables):','ENABLE_PROCMON');
+INSERT OR IGNORE INTO "config" VALUES('PROCMON_ALERT_DATAFEED_BACKLOG','65536','Send an email alert when a wvalarmd datafeed client falls more than this many bytes behind (0 disables):','ENABLE_PROCMON');
+INSERT OR IGNORE INTO "config" VALUES('HTMLGEN_DATA_JSON','yes','Write the current, high/low and 24 hour data to wview-data.json for AJAX pages?','ENABLE_HTMLGEN');
+INSERT OR IGNORE INTO "config" VALUES('HTMLGEN_DATA_BINARY','no','Also write the current and high/low data to the binary wview-data.bin?','ENABLE_HTMLGEN');
+INSERT OR IGNORE INTO "config" VALUES('HTMLGEN_HTTP_PORT','0','TCP port htmlgend serves the generated pages, images and a live data event stream on (0 disables the built-in web server):','ENABLE_HTMLGEN');
+INSERT OR IGNORE INTO "config" VALUES('HTMLGEN_PRECOMPRESS_SIZE','1024','Also write a gzip copy (file.gz) of generated text files of at least this many bytes for web servers that serve them directly (0 disables):','ENABLE_HTMLGEN');
+CREATE TABLE IF NOT EXISTS config_version (version INTEGER NOT NULL);
+INSERT INTO "config_version" SELECT 0 WHERE NOT EXISTS (SELECT version FROM config_version);
+CREATE TRIGGER IF NOT EXISTS config_version_insert AFTER INSERT ON config BEGIN UPDATE config_version SET version = version + 1; END;
+CREATE TRIGGER IF NOT EXISTS config_version_update AFTER UPDATE ON config BEGIN UPDATE config_version SET version = version + 1; END;
+CREATE TRIGGER IF NOT EXISTS config_version_delete AFTER DELETE ON config BEGIN UPDATE config_version SET version = version + 1; END;
 COMMIT;
 
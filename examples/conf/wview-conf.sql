@@ -7,7 +7,8 @@ INSERT INTO "config" VALUES('ENABLE_HTTP','no','Run HTTP daemon to report statio
 INSERT INTO "config" VALUES('ENABLE_FTP','no','Run FTP daemon to transfer web site/generated files to a remote server?',NULL);
 INSERT INTO "config" VALUES('ENABLE_SSH','no','Run SSH daemon to transfer web site/generated files to a remote server?',NULL);
 INSERT INTO "config" VALUES('ENABLE_PROCMON','yes','Run process monitor daemon to restart failed/hung daemons?',NULL);
-INSERT INTO "config" VALUES('STATION_TYPE','Simulator','Station type - one of Simulator, Virtual, VantagePro, WXT510, TWI, WS-2300, WMR918, WMRUSB, WH1080, TE923:',NULL);
+INSERT INTO "config" VALUES('ENABLE_SQL','no','Run export daemon to copy archive, HILOW and NOAA data to a MySQL/PostgreSQL server or export files?',NULL);
+INSERT INTO "config" VALUES('STATION_TYPE','Simulator','Station type - one of Simulator, Virtual, VirtualMulti, VantagePro, WXT510, TWI, WS-2300, WMR918, WMRUSB, WH1080, TE923:',NULL);
 INSERT INTO "config" VALUES('STATION_INTERFACE','serial','Physical interface to the weather station - one of serial or ethernet (usb is considered serial):',NULL);
 INSERT INTO "config" VALUES('STATION_DEV','/dev/ttyUSB0','Weather station serial device (/dev/ttyS0, /dev/ttyUSB0, etc.):',NULL);
 INSERT INTO "config" VALUES('STATION_HOST','10.10.10.10','Hostname or IP address (ethernet only):',NULL);
@@ -26,13 +27,28 @@ INSERT INTO "config" VALUES('STATION_LONGITUDE','-96.9','Weather station longitu
 INSERT INTO "config" VALUES('STATION_ARCHIVE_INTERVAL','5','Weather data archive interval (minutes, one of 5, 10, 15, 30):',NULL);
 INSERT INTO "config" VALUES('STATION_POLL_INTERVAL','30','Weather station sensor poll interval (seconds) - should be divisor of 60:',NULL);
 INSERT INTO "config" VALUES('STATION_PUSH_INTERVAL','60','Current conditions data push interval (seconds) - for wvalarmd and possibly others:',NULL);
-INSERT INTO "config" VALUES('STATION_VERBOSE_MSGS','00000011','Daemon Verbose Log Mask: 00000001 - wviewd,00000010 - htmlgend,00000100 - wvalarmd,00001000 - wviewftpd,00010000 - wviewsshd,00100000 - wvcwopd,01000000 - wvhttpd:',NULL);
+INSERT INTO "config" VALUES('STATION_VERBOSE_MSGS','00000011','Daemon Verbose Log Mask: 00000001 - wviewd,00000010 - htmlgend,00000100 - wvalarmd,00001000 - wviewftpd,00010000 - wviewsshd,00100000 - wvcwopd,01000000 - wvhttpd,10000000 - wvexportd:',NULL);
 INSERT INTO "config" VALUES('STATION_DO_RCHECK','no','Generate RX check data (populate rxCheck.png chart, VP only)?',NULL);
 INSERT INTO "config" VALUES('STATION_OUTSIDE_CHANNEL','0','Use extra sensor for outside temperature (pool sensor is not supported) - 0,1,2,3 (Change sensor channel, WMR9XX only)?',0);
+INSERT INTO "config" VALUES('STATION_VMULTI_HOSTS','','Upstream wview datafeed servers (VirtualMulti only) - host:port,host:port (empty uses STATION_HOST:STATION_PORT):',NULL);
+INSERT INTO "config" VALUES('STATION_VMULTI_POLICY','priority','LOOP merge policy (VirtualMulti only) - one of priority, freshest, average:',NULL);
+INSERT INTO "config" VALUES('STATION_VMULTI_FIELD_PRIORITY','','Per-field source overrides for priority policy (VirtualMulti only) - field:source,... (e.g. outTemp:2,UV:3):',NULL);
+INSERT INTO "config" VALUES('STATION_VMULTI_STALE_SECS','120','Seconds without LOOP data before an upstream source is ignored (VirtualMulti only):',NULL);
+INSERT INTO "config" VALUES('STATION_SIM_BENCH_RATE','0','Simulator benchmark mode LOOP packets per second (Simulator only, 1 - 10000, 0 disables):',NULL);
+INSERT INTO "config" VALUES('STATION_SIM_BENCH_COMPRESSION','1','Simulator benchmark time compression (simulated seconds per real second, Simulator only):',NULL);
+INSERT INTO "config" VALUES('STATION_SIM_BENCH_DAYS','365','Simulator benchmark days of archive history to generate (Simulator only):',NULL);
+INSERT INTO "config" VALUES('STATION_SIM_BENCH_HTML_FILE','','Simulator benchmark HTML file to watch for regeneration latency (Simulator only, empty disables):',NULL);
+INSERT INTO "config" VALUES('STATION_CAPTURE_FILE','','Station medium capture file - records all station traffic for later replay (empty disables):',NULL);
+INSERT INTO "config" VALUES('STATION_REPLAY_FILE','','Station medium replay file - plays a capture file back in place of the station (empty disables):',NULL);
+INSERT INTO "config" VALUES('STATION_REPLAY_SPEED','1.0','Station medium replay speed (multiple of recorded speed, 0 for as fast as possible):',NULL);
 INSERT INTO "config" VALUES('STATION_SQLDB_HOST','localhost','Database server hostname or IP address:','ENABLE_SQL');
 INSERT INTO "config" VALUES('STATION_SQLDB_USERNAME','wvuser','Database server username:','ENABLE_SQL');
 INSERT INTO "config" VALUES('STATION_SQLDB_PASSWORD','wvpasswd','Database server password:','ENABLE_SQL');
 INSERT INTO "config" VALUES('STATION_SQLDB_DB_NAME','wviewDB','Database name where export data are stored:','ENABLE_SQL');
+INSERT INTO "config" VALUES('STATION_SQLDB_EXPORT_SINK','mysql','Export sink: mysql, pgsql (stream to the database server), csv or sql (append CSV or SQL script files):','ENABLE_SQL');
+INSERT INTO "config" VALUES('STATION_SQLDB_EXPORT_DIRECTORY','','Directory for csv/sql export files (empty for $prefix/etc/wview/export):','ENABLE_SQL');
+INSERT INTO "config" VALUES('STATION_SQLDB_EXPORT_INTERVAL','60','How often to export new data (seconds):','ENABLE_SQL');
+INSERT INTO "config" VALUES('STATION_SQLDB_EXPORT_BATCH','500','Rows per export transaction:','ENABLE_SQL');
 INSERT INTO "config" VALUES('HTMLGEN_STATION_NAME','changeme','Station Name:','ENABLE_HTMLGEN');
 INSERT INTO "config" VALUES('HTMLGEN_STATION_CITY','changeme','Station City:','ENABLE_HTMLGEN');
 INSERT INTO "config" VALUES('HTMLGEN_STATION_STATE','changeme','Station State:','ENABLE_HTMLGEN');
@@ -52,6 +68,10 @@ INSERT INTO "config" VALUES('HTMLGEN_MPHASE_FULL','Full','Moon ''full'' text:','
 INSERT INTO "config" VALUES('HTMLGEN_LOCAL_RADAR_URL','http://www.srh.noaa.gov/radar/images/DS.p19r0/SI.kfws/latest.gif','Local Radar Image URL (no spaces):','ENABLE_HTMLGEN');
 INSERT INTO "config" VALUES('HTMLGEN_LOCAL_FORECAST_URL','http://www.wunderground.com/cgi-bin/findweather/getForecast?query=76233','Local Forecast URL (no spaces):','ENABLE_HTMLGEN');
 INSERT INTO "config" VALUES('HTMLGEN_DATE_FORMAT','%x','Date Format - see ''man strftime'' for allowable formats; %D - US format mm/dd/yy, %d/%m/%Y  - dd/mm/yyyy, %x - locale''s preferred date representation:','ENABLE_HTMLGEN');
+INSERT INTO "config" VALUES('HTMLGEN_DATA_JSON','yes','Write the current, high/low and 24 hour data to wview-data.json for AJAX pages?','ENABLE_HTMLGEN');
+INSERT INTO "config" VALUES('HTMLGEN_DATA_BINARY','no','Also write the current and high/low data to the binary wview-data.bin?','ENABLE_HTMLGEN');
+INSERT INTO "config" VALUES('HTMLGEN_HTTP_PORT','0','TCP port htmlgend serves the generated pages, images and a live data event stream on (0 disables the built-in web server):','ENABLE_HTMLGEN');
+INSERT INTO "config" VALUES('HTMLGEN_PRECOMPRESS_SIZE','1024','Also write a gzip copy (file.gz) of generated text files of at least this many bytes for web servers that serve them directly (0 disables):','ENABLE_HTMLGEN');
 INSERT INTO "config" VALUES('ALARMS_STATION_METRIC','no','Is station metric?','ENABLE_ALARMS');
 INSERT INTO "config" VALUES('ALARMS_DO_TEST','no','Test an alarm by faking it when alarms are initialized?','ENABLE_ALARMS');
 INSERT INTO "config" VALUES('ALARMS_DO_TEST_NUMBER','1','Which alarm (1 - 10) to test:','ENABLE_ALARMS');
@@ -111,6 +131,7 @@ INSERT INTO "config" VALUES('FTP_PASSWD','yourpassword','Remote password:','ENAB
 INSERT INTO "config" VALUES('FTP_REMOTE_DIRECTORY','','Optional Remote Transfer Directory (relative to the ftp login directory, no leading ''/''):','ENABLE_FTP');
 INSERT INTO "config" VALUES('FTP_USE_PASSIVE','yes','Use EPSV FTP transfer mode (if supported):','ENABLE_FTP');
 INSERT INTO "config" VALUES('FTP_INTERVAL','5','Global transmit interval (mins):','ENABLE_FTP');
+INSERT INTO "config" VALUES('FTP_PARALLEL_TRANSFERS','4','Number of files to transfer at once (1 to 8):','ENABLE_FTP');
 INSERT INTO "config" VALUES('FTP_RULE_1_SOURCE','*.*','(1 of 10) Source file (relative to $prefix/var/wview/img):','ENABLE_FTP');
 INSERT INTO "config" VALUES('FTP_RULE_2_SOURCE','Archive/*.txt','(2 of 10) Source file (relative to $prefix/var/wview/img):','ENABLE_FTP');
 INSERT INTO "config" VALUES('FTP_RULE_3_SOURCE','NOAA/*.txt','(3 of 10) Source file (relative to $prefix/var/wview/img):','ENABLE_FTP');
@@ -151,6 +172,7 @@ INSERT INTO "config" VALUES('SSH_5_HOST','','Remote Host (hostname or IP address
 INSERT INTO "config" VALUES('SSH_5_PORT','22','SSH Port Number:','ENABLE_SSH');
 INSERT INTO "config" VALUES('SSH_5_USERNAME','','Remote SSH username:','ENABLE_SSH');
 INSERT INTO "config" VALUES('SSH_5_DESTINATION','','Remote destination path, relative to the root ssh login directory (no leading ''/''):','ENABLE_SSH');
+INSERT INTO "config" VALUES('SSH_PERSISTENT_CONNECTION','yes','Keep one ssh connection open per remote host and send all of its rules together:','ENABLE_SSH');
 INSERT INTO "config" VALUES('CWOP_APRS_CALL_SIGN','CWXXXX','CWOP call sign (CWXXXX/DWXXXX):','ENABLE_CWOP');
 INSERT INTO "config" VALUES('CWOP_APRS_SERVER1','cwop.aprs.net','CWOP Server name:','ENABLE_CWOP');
 INSERT INTO "config" VALUES('CWOP_APRS_PORTNO1','23','CWOP port number:','ENABLE_CWOP');
@@ -161,6 +183,7 @@ INSERT INTO "config" VALUES('CWOP_APRS_PORTNO3','23','CWOP port number:','ENABLE
 INSERT INTO "config" VALUES('CWOP_LATITUDE','3333.70N','LATITUDE - MUST be of the form DDMM.hhd (LORAN format): DD - degrees (always positive), MM - minutes (0 - 59), hh - hundredths of minutes, d - hemisphere indicator (N or S):','ENABLE_CWOP');
 INSERT INTO "config" VALUES('CWOP_LONGITUDE','09654.13W','LONGITUDE - MUST be of the form DDDMM.hhd: DDD - degrees (always positive and always 3 digits - use leading zero if necessary), MM - minutes (0 - 59), hh - hundredths of minutes, d - hemisphere indicator (E or W):','ENABLE_CWOP');
 INSERT INTO "config" VALUES('CWOP_LOG_WX_PACKET','no','Log the WX packet when sending (0 or 1)?','ENABLE_CWOP');
+INSERT INTO "config" VALUES('CWOP_PERSISTENT_CONNECTION','yes','Keep the APRS-IS connection open between reports and queue reports while the servers are unreachable:','ENABLE_CWOP');
 INSERT INTO "config" VALUES('HTTP_WUSTATIONID','','WUNDERGROUND station ID:','ENABLE_HTTP');
 INSERT INTO "config" VALUES('HTTP_WUPASSWD','','WUNDERGROUND password:','ENABLE_HTTP');
 INSERT INTO "config" VALUES('HTTP_WURAPIDFIRE', 'no', 'Use RapidFire for WUNDERGROUND', 'ENABLE_HTTP');
@@ -193,9 +216,19 @@ INSERT INTO "config" VALUES('PROCMON_htmlgend','0','Seconds to wait before resta
 INSERT INTO "config" VALUES('PROCMON_wvalarmd','120','Seconds to wait before restarting a non-responsive process (0 disables):','ENABLE_PROCMON');
 INSERT INTO "config" VALUES('PROCMON_wvcwopd','120','Seconds to wait before restarting a non-responsive process (0 disables):','ENABLE_PROCMON');
 INSERT INTO "config" VALUES('PROCMON_wvhttpd','120','Seconds to wait before restarting a non-responsive process (0 disables):','ENABLE_PROCMON');
+INSERT INTO "config" VALUES('PROCMON_ALERT_RSS_KB','65536','Send an email alert when a daemon uses more than this many KB of memory (0 disables):','ENABLE_PROCMON');
+INSERT INTO "config" VALUES('PROCMON_ALERT_FDS','256','Send an email alert when a daemon has more than this many open files (0 disables):','ENABLE_PROCMON');
+INSERT INTO "config" VALUES('PROCMON_ALERT_POLL_MS','5000','Send an email alert when a daemon takes more than this many ms to answer a poll (0 disables):','ENABLE_PROCMON');
+INSERT INTO "config" VALUES('PROCMON_ALERT_HTML_GEN_MS','60000','Send an email alert when htmlgend takes more than this many ms to generate (0 disables):','ENABLE_PROCMON');
+INSERT INTO "config" VALUES('PROCMON_ALERT_DATAFEED_BACKLOG','65536','Send an email alert when a wvalarmd datafeed client falls more than this many bytes behind (0 disables):','ENABLE_PROCMON');
 INSERT INTO "config" VALUES('EMAIL_ADDRESS','address@server.com','Destination address for email alerts:',NULL);
 INSERT INTO "config" VALUES('FROM_EMAIL_ADDRESS','from_address@other_server.com','From address for email alerts:',NULL);
 INSERT INTO "config" VALUES('ENABLE_EMAIL_ALERTS','no','Send system alert emails?',NULL);
 INSERT INTO "config" VALUES('SEND_TEST_EMAIL','no','Send a test email?',NULL);
 INSERT INTO "config" VALUES('ADMIN_PASSWORD','9798e81db4d6cc93577169c395b90f66','Admin Password (md5):','');
+CREATE TABLE config_version (version INTEGER NOT NULL);
+INSERT INTO "config_version" VALUES(0);
+CREATE TRIGGER config_version_insert AFTER INSERT ON config BEGIN UPDATE config_version SET version = version + 1; END;
+CREATE TRIGGER config_version_update AFTER UPDATE ON config BEGIN UPDATE config_version SET version = version + 1; END;
+CREATE TRIGGER config_version_delete AFTER DELETE ON config BEGIN UPDATE config_version SET version = version + 1; END;
 COMMIT;
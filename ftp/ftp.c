@@ -51,7 +51,7 @@ static char*            ftpStatusLabels[STATUS_STATS_MAX] =
     "Rules defined",
     "Rules sent",
     NULL,
-    NULL
+    "Files sent (last cycle)"
 };
 
 /* ... methods
@@ -0,0 +1,837 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        ftpTest.c
+
+  PURPOSE:
+        Run wviewftpd's curl multi transfer queue against a loopback FTP
+        stand-in ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The stand-in is a forked FTP server on a 127.0.0.1 port with one
+        child per control connection (USER/PASS, PWD, CWD, MKD, EPSV,
+        TYPE, STOR, RNFR/RNTO and QUIT). It logs each login and upload to
+        a shared file so the test can count them.
+
+        ftpUtilsInit runs with stand-ins for the wview configuration, the
+        status file and the content manifests, then ftpUtilsSendFiles runs
+        update cycles over a scratch web directory:
+            - every file arrives under its real name with its content and
+              no temporary file is left behind
+            - no more logins than transfer slots, and none for later cycles
+            - unchanged (or rewritten but identical) files are not resent
+            - a refused upload is counted and resent the next cycle
+
+        A larger cycle is then timed with 1 and FTP_PARALLEL_DEFAULT slots
+        and its files and bytes per second are printed but not checked.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radtimeUtils.h>
+
+/*  ... Local include files
+*/
+#include <ftpUtils.h>
+
+
+/*  ... local memory
+*/
+
+#define TEST_USER               "wview"
+#define TEST_PASS               "secret"
+#define TEST_REMOTE_DIR         "web"
+#define TEST_REFUSED_FILE       "refused.htm"
+#define TEST_SMALL_FILES        12
+#define TEST_SMALL_SIZE         2048
+#define TEST_BENCH_FILES        48
+#define TEST_BENCH_SIZE         32768
+#define TEST_TIMEOUT_SECS       120
+#define TEST_MAX_SENT           256
+
+static char         testDir[64];
+static char         testWebDir[128];
+static char         testServerDir[128];
+static char         testLogFile[128];
+static char         testHost[64];
+static int          testParallel = FTP_PARALLEL_DEFAULT;
+static int          testStats[FTP_STATS_FILES_LAST_CYCLE + 1];
+static int          testErrors;
+static pid_t        testPid;
+static int          testFailures;
+
+static FTP_DATA     testData;
+
+
+//  ... stand-ins for the wview configuration and status file
+
+int wvconfigInit (int firstProcess)
+{
+    return OK;
+}
+
+void wvconfigExit (void)
+{
+    return;
+}
+
+int wvconfigGetBooleanValue (const char *configItem)
+{
+    return ((!strcmp (configItem, configItem_ENABLE_FTP)) ? TRUE : ERROR);
+}
+
+int wvconfigGetINTValue (const char *configItem)
+{
+    if (!strcmp (configItem, configItemFTP_PARALLEL_TRANSFERS))
+        return testParallel;
+    if (!strcmp (configItem, configItemFTP_INTERVAL))
+        return 1;
+    return ERROR;
+}
+
+const char *wvconfigGetStringValue (const char *configItem)
+{
+    if (!strcmp (configItem, configItemFTP_HOST))
+        return testHost;
+    if (!strcmp (configItem, configItemFTP_USERNAME))
+        return TEST_USER;
+    if (!strcmp (configItem, configItemFTP_PASSWD))
+        return TEST_PASS;
+    if (!strcmp (configItem, configItemFTP_REMOTE_DIRECTORY))
+        return TEST_REMOTE_DIR;
+    if (!strcmp (configItem, "FTP_RULE_1_SOURCE"))
+        return "*.htm";
+    if (!strcmp (configItem, "FTP_RULE_2_SOURCE"))
+        return "img/*.png";
+    return NULL;
+}
+
+int wvutilsSetVerbosity (USHORT daemonBitMask)
+{
+    return OK;
+}
+
+int wvstrncpy (char *d, const char *s, size_t bufsize)
+{
+    snprintf (d, bufsize, "%s", s);
+    return strlen (s);
+}
+
+void wvutilsLogEvent (int priority, char *format, ...)
+{
+    return;
+}
+
+int statusUpdateStat (int index, int value)
+{
+    if (index >= 0 && index <= FTP_STATS_FILES_LAST_CYCLE)
+    {
+        testStats[index] = value;
+    }
+    return OK;
+}
+
+int statusIncrementStat (int index)
+{
+    testErrors ++;
+    return OK;
+}
+
+int statusUpdateMessage (const char *message)
+{
+    return OK;
+}
+
+
+//  ... in-memory stand-ins for the manifests (WVIEW_RUN_DIR is not ours)
+
+void manifestInit (MANIFEST_ID id, const char *destination)
+{
+    memset (id, 0, sizeof (*id));
+    id->entries = (MANIFEST_ENTRY *)calloc (TEST_MAX_SENT, sizeof (MANIFEST_ENTRY));
+    id->size = ((id->entries != NULL) ? TEST_MAX_SENT : 0);
+}
+
+int manifestLoad (MANIFEST_ID id, const char *file)
+{
+    return OK;
+}
+
+int manifestSave (MANIFEST_ID id, const char *file)
+{
+    return OK;
+}
+
+MANIFEST_ENTRY *manifestFind (MANIFEST_ID id, const char *path)
+{
+    int             i;
+
+    for (i = 0; i < id->count; i ++)
+    {
+        if (!strcmp (id->entries[i].path, path))
+        {
+            return &id->entries[i];
+        }
+    }
+
+    return NULL;
+}
+
+int manifestSet
+(
+    MANIFEST_ID     id,
+    const char      *path,
+    off_t           size,
+    time_t          mtime,
+    ULONGLONG       hash
+)
+{
+    MANIFEST_ENTRY  *entry = manifestFind (id, path);
+
+    if (entry == NULL)
+    {
+        if (id->count >= id->size)
+        {
+            return ERROR;
+        }
+        entry = &id->entries[id->count ++];
+        wvstrncpy (entry->path, path, _MAX_PATH);
+    }
+
+    entry->size  = size;
+    entry->mtime = mtime;
+    entry->hash  = hash;
+    return OK;
+}
+
+int manifestGetHash
+(
+    MANIFEST_ID     published,
+    const char      *path,
+    struct stat     *fileStat,
+    ULONGLONG       *hash
+)
+{
+    FILE            *file = fopen (path, "rb");
+    int             ch;
+
+    if (file == NULL)
+    {
+        return ERROR;
+    }
+
+    // FNV-1a, as manifest.c:
+    *hash = 0xcbf29ce484222325ULL;
+    while ((ch = getc (file)) != EOF)
+    {
+        *hash = (*hash ^ (ULONGLONG)ch) * 0x100000001b3ULL;
+    }
+
+    fclose (file);
+    return OK;
+}
+
+void manifestExit (MANIFEST_ID id)
+{
+    free (id->entries);
+    memset (id, 0, sizeof (*id));
+}
+
+
+//  ... the FTP stand-in
+
+static void standInLog (const char *format, const char *arg)
+{
+    char            line[512];
+    int             fd, length;
+
+    length = snprintf (line, sizeof (line), format, arg);
+    fd = open (testLogFile, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd >= 0)
+    {
+        if (write (fd, line, length) != length)
+        {
+            exit (1);
+        }
+        close (fd);
+    }
+    return;
+}
+
+static void standInReply (int fd, const char *reply)
+{
+    if (write (fd, reply, strlen (reply)) != (ssize_t)strlen (reply))
+    {
+        exit (0);
+    }
+    return;
+}
+
+// map an FTP path to the server directory:
+static void standInPath (char *cwd, const char *arg, char *path)
+{
+    if (arg[0] == '/')
+    {
+        sprintf (path, "%s%s", testServerDir, arg);
+    }
+    else
+    {
+        sprintf (path, "%s/%s", cwd, arg);
+    }
+    return;
+}
+
+static int standInListen (int *port)
+{
+    int                 fd;
+    struct sockaddr_in  addr;
+    socklen_t           length = sizeof (addr);
+
+    fd = socket (AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return ERROR;
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_addr.s_addr    = htonl (INADDR_LOOPBACK);
+    addr.sin_port           = 0;
+    if (bind (fd, (struct sockaddr *)&addr, sizeof (addr)) < 0 ||
+        listen (fd, 16) < 0 ||
+        getsockname (fd, (struct sockaddr *)&addr, &length) < 0)
+    {
+        close (fd);
+        return ERROR;
+    }
+
+    *port = ntohs (addr.sin_port);
+    return fd;
+}
+
+// receive a STOR on the passive data connection:
+static int standInStore (int dataListen, const char *path)
+{
+    char            buffer[8192];
+    struct pollfd   pfd;
+    int             fd, file, length;
+
+    pfd.fd      = dataListen;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+    if (poll (&pfd, 1, 10000) <= 0 || (fd = accept (dataListen, NULL, NULL)) < 0)
+    {
+        return ERROR;
+    }
+
+    file = open (path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    while ((length = read (fd, buffer, sizeof (buffer))) > 0)
+    {
+        if (file < 0 || write (file, buffer, length) != length)
+        {
+            break;
+        }
+    }
+
+    close (fd);
+    if (file < 0)
+    {
+        return ERROR;
+    }
+    close (file);
+    return ((length == 0) ? OK : ERROR);
+}
+
+static void standInSession (int fd)
+{
+    FILE            *in = fdopen (fd, "r");
+    char            line[512], arg[512], reply[600];
+    char            cwd[_MAX_PATH], path[_MAX_PATH], renameFrom[_MAX_PATH];
+    char            *cmnd;
+    int             dataListen = -1, dataPort, length;
+    int             isLoggedIn = FALSE;
+
+    strcpy (cwd, testServerDir);
+    renameFrom[0] = 0;
+    standInReply (fd, "220 wview test FTP stand-in\r\n");
+
+    while (fgets (line, sizeof (line), in) != NULL)
+    {
+        length = strlen (line);
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+        {
+            line[-- length] = 0;
+        }
+        cmnd = line;
+        arg[0] = 0;
+        if (strchr (line, ' ') != NULL)
+        {
+            strcpy (arg, strchr (line, ' ') + 1);
+            *strchr (line, ' ') = 0;
+        }
+
+        if (!strcmp (cmnd, "USER"))
+        {
+            standInReply (fd, "331 password please\r\n");
+        }
+        else if (!strcmp (cmnd, "PASS"))
+        {
+            if (strcmp (arg, TEST_PASS) != 0)
+            {
+                standInReply (fd, "530 login incorrect\r\n");
+                continue;
+            }
+            isLoggedIn = TRUE;
+            standInLog ("LOGIN %s\n", "");
+            standInReply (fd, "230 logged in\r\n");
+        }
+        else if (!strcmp (cmnd, "QUIT"))
+        {
+            standInReply (fd, "221 bye\r\n");
+            break;
+        }
+        else if (! isLoggedIn)
+        {
+            standInReply (fd, "530 not logged in\r\n");
+        }
+        else if (!strcmp (cmnd, "PWD"))
+        {
+            standInReply (fd, "257 \"/\" is current\r\n");
+        }
+        else if (!strcmp (cmnd, "CWD"))
+        {
+            standInPath (cwd, arg, path);
+            if (access (path, X_OK) != 0)
+            {
+                standInReply (fd, "550 no such directory\r\n");
+                continue;
+            }
+            strcpy (cwd, path);
+            standInReply (fd, "250 ok\r\n");
+        }
+        else if (!strcmp (cmnd, "MKD"))
+        {
+            standInPath (cwd, arg, path);
+            standInReply (fd, ((mkdir (path, 0755) == 0) ? "257 created\r\n" : "550 failed\r\n"));
+        }
+        else if (!strcmp (cmnd, "EPSV"))
+        {
+            if (dataListen >= 0)
+            {
+                close (dataListen);
+            }
+            dataListen = standInListen (&dataPort);
+            sprintf (reply, "229 Entering Extended Passive Mode (|||%d|)\r\n", dataPort);
+            standInReply (fd, reply);
+        }
+        else if (!strcmp (cmnd, "TYPE"))
+        {
+            standInReply (fd, "200 ok\r\n");
+        }
+        else if (!strcmp (cmnd, "STOR"))
+        {
+            if (dataListen < 0)
+            {
+                standInReply (fd, "425 no data connection\r\n");
+                continue;
+            }
+            if (strstr (arg, TEST_REFUSED_FILE) != NULL)
+            {
+                close (dataListen);
+                dataListen = -1;
+                standInReply (fd, "553 not allowed\r\n");
+                continue;
+            }
+            standInReply (fd, "150 ok\r\n");
+            standInPath (cwd, arg, path);
+            if (standInStore (dataListen, path) == OK)
+            {
+                standInLog ("STOR %s\n", path);
+                standInReply (fd, "226 done\r\n");
+            }
+            else
+            {
+                standInReply (fd, "451 failed\r\n");
+            }
+            close (dataListen);
+            dataListen = -1;
+        }
+        else if (!strcmp (cmnd, "RNFR"))
+        {
+            standInPath (cwd, arg, renameFrom);
+            standInReply (fd, "350 ready\r\n");
+        }
+        else if (!strcmp (cmnd, "RNTO"))
+        {
+            standInPath (cwd, arg, path);
+            standInReply (fd, ((rename (renameFrom, path) == 0) ? "250 renamed\r\n" : "550 failed\r\n"));
+        }
+        else
+        {
+            standInReply (fd, "502 not implemented\r\n");
+        }
+    }
+
+    exit (0);
+}
+
+static void standInRun (int listenFd)
+{
+    int             fd;
+
+    signal (SIGPIPE, SIG_IGN);
+    signal (SIGCHLD, SIG_IGN);
+    signal (SIGTERM, SIG_DFL);
+
+    for (;;)
+    {
+        if ((fd = accept (listenFd, NULL, NULL)) < 0)
+        {
+            continue;
+        }
+
+        if (fork () == 0)
+        {
+            close (listenFd);
+            standInSession (fd);
+        }
+        close (fd);
+    }
+}
+
+static int standInStart (void)
+{
+    int             fd, port;
+
+    fd = standInListen (&port);
+    if (fd < 0)
+    {
+        return ERROR;
+    }
+    sprintf (testHost, "127.0.0.1:%d", port);
+
+    testPid = fork ();
+    if (testPid < 0)
+    {
+        close (fd);
+        return ERROR;
+    }
+    else if (testPid == 0)
+    {
+        // the sessions share its process group so they stop with it:
+        setpgid (0, 0);
+        standInRun (fd);
+        exit (0);
+    }
+
+    setpgid (testPid, testPid);
+    close (fd);
+    return OK;
+}
+
+static void standInStop (void)
+{
+    if (testPid > 0)
+    {
+        kill (0 - testPid, SIGTERM);
+        kill (testPid, SIGTERM);
+        waitpid (testPid, NULL, 0);
+        testPid = 0;
+    }
+    return;
+}
+
+// count the log lines starting with 'what':
+static int standInCount (const char *what)
+{
+    FILE            *file = fopen (testLogFile, "r");
+    char            line[512];
+    int             count = 0;
+
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    while (fgets (line, sizeof (line), file) != NULL)
+    {
+        if (!strncmp (line, what, strlen (what)))
+        {
+            count ++;
+        }
+    }
+
+    fclose (file);
+    return count;
+}
+
+
+//  ... the update cycles
+
+static void check (int condition, char *what)
+{
+    printf ("ftpTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static int writeFile (const char *name, int size, int seed)
+{
+    char            path[256];
+    FILE            *file;
+    int             i;
+
+    sprintf (path, "%s/%s", testWebDir, name);
+    if ((file = fopen (path, "wb")) == NULL)
+    {
+        return ERROR;
+    }
+
+    for (i = 0; i < size; i ++)
+    {
+        fputc ('a' + ((i * 7 + seed) % 26), file);
+    }
+
+    fclose (file);
+    return OK;
+}
+
+// compare a local file with the copy on the server:
+static int isOnServer (const char *name)
+{
+    char            local[256], remote[256], tempName[256], *slash;
+    char            buffer[2][4096];
+    FILE            *files[2];
+    size_t          length[2];
+    int             isSame = TRUE;
+
+    sprintf (local, "%s/%s", testWebDir, name);
+    sprintf (remote, "%s/%s/%s", testServerDir, TEST_REMOTE_DIR, name);
+
+    // and no temporary file is left:
+    strcpy (tempName, remote);
+    slash = strrchr (tempName, '/');
+    sprintf (slash + 1, ".%s%s", strrchr (remote, '/') + 1, FTP_TEMP_SUFFIX);
+    if (access (tempName, F_OK) == 0)
+    {
+        return FALSE;
+    }
+
+    files[0] = fopen (local, "rb");
+    files[1] = fopen (remote, "rb");
+    if (files[0] == NULL || files[1] == NULL)
+    {
+        isSame = FALSE;
+    }
+    while (isSame)
+    {
+        length[0] = fread (buffer[0], 1, sizeof (buffer[0]), files[0]);
+        length[1] = fread (buffer[1], 1, sizeof (buffer[1]), files[1]);
+        if (length[0] != length[1] || memcmp (buffer[0], buffer[1], length[0]) != 0)
+        {
+            isSame = FALSE;
+        }
+        if (length[0] == 0)
+        {
+            break;
+        }
+    }
+
+    if (files[0] != NULL)
+        fclose (files[0]);
+    if (files[1] != NULL)
+        fclose (files[1]);
+    return isSame;
+}
+
+static int runCycle (void)
+{
+    // ftpUtilsSendFiles waits for the interval; run a cycle now:
+    testData.expiry = 0;
+    return ftpUtilsSendFiles (&testData, testWebDir);
+}
+
+static void benchCycle (int parallel)
+{
+    ULONGLONG       cycleTime;
+    char            name[64];
+    int             i;
+
+    testParallel = parallel;
+    if (ftpUtilsInit (&testData) != OK)
+    {
+        check (FALSE, "ftpUtilsInit for the timed cycle");
+        return;
+    }
+
+    for (i = 0; i < TEST_BENCH_FILES; i ++)
+    {
+        sprintf (name, "bench%2.2d.htm", i);
+        writeFile (name, TEST_BENCH_SIZE, i + parallel);
+    }
+
+    cycleTime = radTimeGetMSSinceEpoch ();
+    runCycle ();
+    cycleTime = radTimeGetMSSinceEpoch () - cycleTime;
+
+    printf ("ftpTest: %d slots: %d files/cycle, %.0f bytes in %llu ms, "
+            "%.0f bytes/sec, %.1f files/sec\n",
+            parallel, testData.filesSent, testData.bytesSent,
+            (unsigned long long)cycleTime,
+            (testData.bytesSent * 1000.0) / ((cycleTime > 0) ? cycleTime : 1),
+            (testData.filesSent * 1000.0) / ((cycleTime > 0) ? cycleTime : 1));
+
+    ftpUtilsExit (&testData);
+
+    for (i = 0; i < TEST_BENCH_FILES; i ++)
+    {
+        sprintf (name, "%s/bench%2.2d.htm", testWebDir, i);
+        unlink (name);
+    }
+    return;
+}
+
+
+int main (int argc, char *argv[])
+{
+    char            name[256];
+    int             i, isSent, logins, stored;
+
+    alarm (TEST_TIMEOUT_SECS);
+    signal (SIGPIPE, SIG_IGN);
+
+    snprintf (testDir, sizeof (testDir), "/tmp/ftpTest.%d", (int)getpid ());
+    sprintf (testWebDir, "%s/html", testDir);
+    sprintf (testServerDir, "%s/server", testDir);
+    sprintf (testLogFile, "%s/server.log", testDir);
+    sprintf (name, "%s/img", testWebDir);
+    if (mkdir (testDir, 0755) != 0 || mkdir (testWebDir, 0755) != 0 ||
+        mkdir (name, 0755) != 0 || mkdir (testServerDir, 0755) != 0)
+    {
+        printf ("ftpTest: cannot create %s\n", testDir);
+        return 1;
+    }
+
+    for (i = 0; i < TEST_SMALL_FILES; i ++)
+    {
+        sprintf (name, ((i % 3) ? "page%2.2d.htm" : "img/chart%2.2d.png"), i);
+        writeFile (name, TEST_SMALL_SIZE + i, i);
+    }
+
+    if (standInStart () == ERROR)
+    {
+        printf ("ftpTest: cannot start the stand-in: %s\n", strerror (errno));
+        return 1;
+    }
+
+    if (ftpUtilsInit (&testData) != OK)
+    {
+        printf ("ftpTest: ftpUtilsInit failed\n");
+        standInStop ();
+        return 1;
+    }
+
+    // the first cycle sends everything:
+    check (runCycle () == 2, "first cycle ran both rules");
+    isSent = TRUE;
+    for (i = 0; i < TEST_SMALL_FILES; i ++)
+    {
+        sprintf (name, ((i % 3) ? "page%2.2d.htm" : "img/chart%2.2d.png"), i);
+        if (! isOnServer (name))
+        {
+            printf ("ftpTest: %s is missing or differs on the server\n", name);
+            isSent = FALSE;
+        }
+    }
+    check (isSent, "files arrive complete under their names");
+    check (testData.filesSent == TEST_SMALL_FILES &&
+           testStats[FTP_STATS_FILES_LAST_CYCLE] == TEST_SMALL_FILES &&
+           standInCount ("STOR") == TEST_SMALL_FILES,
+           "first cycle sent every file once");
+    logins = standInCount ("LOGIN");
+    check (logins > 0 && logins <= testParallel, "no more logins than transfer slots");
+
+    // nothing changed:
+    runCycle ();
+    check (testData.filesSent == 0 && standInCount ("STOR") == TEST_SMALL_FILES,
+           "unchanged files are not resent");
+
+    // two changed, one rewritten with the same content:
+    writeFile ("page01.htm", TEST_SMALL_SIZE + 100, 50);
+    writeFile ("img/chart03.png", TEST_SMALL_SIZE + 100, 51);
+    sleep (1);
+    writeFile ("page02.htm", TEST_SMALL_SIZE + 2, 2);
+    stored = standInCount ("STOR");
+    runCycle ();
+    check (testData.filesSent == 2 && standInCount ("STOR") == stored + 2 &&
+           isOnServer ("page01.htm") && isOnServer ("img/chart03.png"),
+           "only changed content is resent");
+    check (standInCount ("LOGIN") == logins, "later cycles reuse the logins");
+
+    // a refused upload:
+    writeFile (TEST_REFUSED_FILE, TEST_SMALL_SIZE, 60);
+    writeFile ("page04.htm", TEST_SMALL_SIZE + 200, 61);
+    testErrors = 0;
+    runCycle ();
+    check (testData.filesSent == 1 && testErrors == 1 && isOnServer ("page04.htm"),
+           "refused upload is counted, the rest are sent");
+    runCycle ();
+    check (testErrors == 2, "refused upload is tried again next cycle");
+    sprintf (name, "%s/%s", testWebDir, TEST_REFUSED_FILE);
+    unlink (name);
+
+    ftpUtilsExit (&testData);
+
+    for (i = 0; i < TEST_SMALL_FILES; i ++)
+    {
+        sprintf (name, ((i % 3) ? "%s/page%2.2d.htm" : "%s/img/chart%2.2d.png"), testWebDir, i);
+        unlink (name);
+    }
+
+    // time a larger cycle with one and several slots:
+    benchCycle (1);
+    benchCycle (FTP_PARALLEL_DEFAULT);
+
+    standInStop ();
+
+    sprintf (name, "rm -rf %s", testDir);
+    if (system (name) != 0)
+    {
+        printf ("ftpTest: cannot remove %s\n", testDir);
+    }
+
+    printf ("ftpTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
@@ -39,6 +39,7 @@
 #include <sys/wait.h>
 #include <unistd.h>
 #include <errno.h>
+#include <limits.h>
 
 /*  ... Library include files
 */
@@ -59,7 +60,6 @@ extern void FTPDefaultSigHandler (int signum);
 /*  ... static (local) memory declarations
 */
 static char         FTPRule[FTP_MAX_PATH];
-static char         curlError[CURL_ERROR_SIZE];
 
 
 static int FilterFile(const struct dirent *dp)
@@ -74,18 +74,79 @@ static int FilterFile(const struct dirent *dp)
     }
 }
 
-static int SendRule(FTP_ID id, FTP_RULE_ID rule, const char* markerFile)
+static int QueueFile
+(
+    FTP_ID          id,
+    const char*     path,
+    const char*     absPath,
+    struct stat*    statbuf,
+    ULONGLONG       hash
+)
+{
+    FTP_QUEUE_ENTRY*    newQueue;
+    FTP_QUEUE_ENTRY*    entry;
+
+    if (id->queueLength >= id->queueSize)
+    {
+        newQueue = realloc(id->queue, (id->queueSize + 64) * sizeof(FTP_QUEUE_ENTRY));
+        if (newQueue == NULL)
+        {
+            radMsgLog (PRI_HIGH, "FTP-ERROR: cannot grow the transfer queue");
+            return ERROR;
+        }
+        id->queue = newQueue;
+        id->queueSize += 64;
+    }
+
+    entry = &id->queue[id->queueLength ++];
+    wvstrncpy(entry->path, path, FTP_MAX_PATH);
+    wvstrncpy(entry->absPath, absPath, _MAX_PATH);
+    entry->size     = statbuf->st_size;
+    entry->mtime    = statbuf->st_mtime;
+    entry->hash     = hash;
+    return OK;
+}
+
+// Decide if the server already has the content of 'absPath':
+static int IsChanged(FTP_ID id, const char* absPath, struct stat* statbuf, ULONGLONG* hash)
+{
+    MANIFEST_ENTRY* sent = manifestFind(&id->sent, absPath);
+
+    if (sent != NULL &&
+        sent->size == statbuf->st_size &&
+        sent->mtime == statbuf->st_mtime)
+    {
+        // not touched since we sent it:
+        return FALSE;
+    }
+
+    if (manifestGetHash(&id->published, absPath, statbuf, hash) == ERROR)
+    {
+        // cannot tell - send it:
+        *hash = 0;
+        return TRUE;
+    }
+
+    if (sent != NULL && sent->hash == *hash)
+    {
+        // rewritten with the same content; remember the new mtime:
+        manifestSet(&id->sent, absPath, statbuf->st_size, statbuf->st_mtime, *hash);
+        id->sentChanged = TRUE;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+// Build the list of changed files for this rule; they are sent by RunQueue:
+static int QueueRule(FTP_ID id, FTP_RULE_ID rule)
 {
-    static char     FTPCmndLine[FTP_MAX_CMND_LENGTH];
     struct dirent   **namelist;
     struct stat     statbuf;
-    int             index, logindex, numFiles, cmndLength, hdrLength, retVal = 0;
-    char            logBfr[RADMSGLOG_MAX_LENGTH];
-    time_t          lastUpdate;
-    char            dirnameStr[FTP_MAX_PATH], basenameStr[FTP_MAX_PATH], loginStr[128];
-    char            tempRule[_MAX_PATH];
-    CURLcode        res;
-    FILE*           sendFile;
+    int             index, numFiles, retVal = 0;
+    ULONGLONG       hash;
+    char            dirnameStr[FTP_MAX_PATH], basenameStr[FTP_MAX_PATH];
+    char            tempRule[_MAX_PATH], absDir[PATH_MAX], absPath[PATH_MAX];
 
     // dirname and basename may be destructive of the input string:
     wvstrncpy(tempRule, rule->src, FTP_MAX_PATH);
@@ -94,6 +155,12 @@ static int SendRule(FTP_ID id, FTP_RULE_ID rule, const char* markerFile)
     wvstrncpy(basenameStr, basename(tempRule), FTP_MAX_PATH);
     wvstrncpy(FTPRule, basenameStr, FTP_MAX_PATH);
 
+    // The manifests are keyed by the real path of each file:
+    if (realpath(dirnameStr, absDir) == NULL)
+    {
+        wvstrncpy(absDir, dirnameStr, sizeof(absDir));
+    }
+
     numFiles = scandir(dirnameStr, &namelist, FilterFile, alphasort);
     if (numFiles <= 0)
     {
@@ -101,27 +168,6 @@ static int SendRule(FTP_ID id, FTP_RULE_ID rule, const char* markerFile)
         return ERROR;
     }
 
-    cmndLength = 0;
-
-    if (strlen(id->directory) == 0)
-    {
-        cmndLength += sprintf (&FTPCmndLine[cmndLength], "ftp://%s/",
-                               id->host);
-    }
-    else
-    {
-        cmndLength += sprintf (&FTPCmndLine[cmndLength], "ftp://%s/%s/",
-                               id->host, id->directory);
-    }
-
-    hdrLength = cmndLength;
-
-    sprintf(loginStr, "%s:%s", id->user, id->pass);
-
-    // Grab last transmission time marker:
-    // wvutilsReadMarkerFile returns 0 if the file does not exist:
-    lastUpdate = wvutilsReadMarkerFile(markerFile);
-
     // Loop through all files in the list:
     for (index = 0; index < numFiles; index ++)
     {
@@ -151,65 +197,255 @@ static int SendRule(FTP_ID id, FTP_RULE_ID rule, const char* markerFile)
             continue;
         }
 
-        if (statbuf.st_mtime <= lastUpdate)
+        snprintf(absPath, sizeof(absPath), "%s/%s", absDir, namelist[index]->d_name);
+
+        if (! IsChanged(id, absPath, &statbuf, &hash))
         {
             // nothing new:
-            wvutilsLogEvent(PRI_STATUS, "FTP-STATUS: %s is not new, skipping it",
+            wvutilsLogEvent(PRI_STATUS, "FTP-STATUS: %s is not changed, skipping it",
                             tempRule);
             free(namelist[index]);
             continue;
         }
 
-        // send it now:
-        cmndLength = hdrLength;
-        cmndLength += sprintf(&FTPCmndLine[cmndLength], "%s", tempRule);
+        if (QueueFile(id, tempRule, absPath, &statbuf, hash) == OK)
+        {
+            retVal ++;
+        }
 
-        // Log the command before executing it:
-        for (logindex = 0; logindex < cmndLength; logindex += RADMSGLOG_MAX_LENGTH)
+        free(namelist[index]);
+    }
+
+    free(namelist);
+    return retVal;
+}
+
+// Start sending 'path' on 'xfer': upload to a hidden temp name, then rename
+// it on the server so readers never see a partial file:
+static int StartTransfer(FTP_ID id, FTP_XFER* xfer, FTP_QUEUE_ENTRY* entry)
+{
+    const char*     path = entry->path;
+    char            logBfr[RADMSGLOG_MAX_LENGTH];
+    char            remoteDir[FTP_MAX_PATH], fileName[FTP_MAX_PATH];
+    char            cmnd[FTP_MAX_PATH + 8];
+    const char*     slash;
+    int             cmndLength;
+
+    xfer->sendFile = fopen(path, "rb");
+    if (xfer->sendFile == NULL)
+    {
+        sprintf(logBfr, "FTP-ERROR: failed to open %s", path);
+        radMsgLog (PRI_HIGH, "%s", logBfr);
+        statusUpdateMessage(logBfr);
+        return ERROR;
+    }
+
+    slash = strrchr(path, '/');
+    if (slash == NULL)
+    {
+        remoteDir[0] = 0;
+        wvstrncpy(fileName, path, sizeof(fileName));
+    }
+    else
+    {
+        wvstrncpy(remoteDir, path, ((slash - path) + 2 < FTP_MAX_PATH) ? (slash - path) + 2 : FTP_MAX_PATH);
+        wvstrncpy(fileName, slash + 1, sizeof(fileName));
+    }
+
+    if (strlen(id->directory) == 0)
+    {
+        cmndLength = snprintf(xfer->url, FTP_MAX_CMND_LENGTH, "ftp://%s/%s.%s%s",
+                              id->host, remoteDir, fileName, FTP_TEMP_SUFFIX);
+    }
+    else
+    {
+        cmndLength = snprintf(xfer->url, FTP_MAX_CMND_LENGTH, "ftp://%s/%s/%s.%s%s",
+                              id->host, id->directory, remoteDir, fileName, FTP_TEMP_SUFFIX);
+    }
+    if (cmndLength >= FTP_MAX_CMND_LENGTH)
+    {
+        radMsgLog (PRI_HIGH, "FTP-ERROR: URL too long for %s", path);
+        fclose(xfer->sendFile);
+        xfer->sendFile = NULL;
+        return ERROR;
+    }
+
+    // The rename runs in the upload directory after the transfer:
+    sprintf(cmnd, "RNFR .%s%s", fileName, FTP_TEMP_SUFFIX);
+    xfer->renameCmnds = curl_slist_append(NULL, cmnd);
+    sprintf(cmnd, "RNTO %s", fileName);
+    xfer->renameCmnds = curl_slist_append(xfer->renameCmnds, cmnd);
+
+    wvutilsLogEvent(PRI_STATUS, "FTP-URL: %s", xfer->url);
+
+    xfer->entry = entry;
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_URL, xfer->url);
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_READDATA, xfer->sendFile);
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_POSTQUOTE, xfer->renameCmnds);
+
+    if (curl_multi_add_handle(id->multiHandle, xfer->curlHandle) != CURLM_OK)
+    {
+        radMsgLog (PRI_HIGH, "FTP-ERROR: curl_multi_add_handle failed for %s", path);
+        fclose(xfer->sendFile);
+        xfer->sendFile = NULL;
+        curl_slist_free_all(xfer->renameCmnds);
+        xfer->renameCmnds = NULL;
+        return ERROR;
+    }
+
+    xfer->busy = TRUE;
+    return OK;
+}
+
+static void FinishTransfer(FTP_ID id, FTP_XFER* xfer, CURLcode res)
+{
+    char            logBfr[RADMSGLOG_MAX_LENGTH];
+    double          bytes;
+
+    curl_multi_remove_handle(id->multiHandle, xfer->curlHandle);
+
+    if (res != CURLE_OK)
+    {
+        snprintf(logBfr, sizeof(logBfr), "FTP-ERROR: %s: %s", xfer->entry->path,
+                 ((strlen(xfer->curlError) > 0) ? xfer->curlError : curl_easy_strerror(res)));
+        radMsgLog (PRI_HIGH, "%s", logBfr);
+        statusUpdateMessage(logBfr);
+        statusIncrementStat(FTP_STATS_CONNECT_ERRORS);
+    }
+    else
+    {
+        wvutilsLogEvent(PRI_STATUS, "FTP-SUCCESS: %s", xfer->entry->path);
+        if (curl_easy_getinfo(xfer->curlHandle, CURLINFO_SIZE_UPLOAD, &bytes) == CURLE_OK)
         {
-            wvstrncpy(logBfr, &FTPCmndLine[logindex], RADMSGLOG_MAX_LENGTH);
-            if (strlen(logBfr) > 0)
+            id->bytesSent += bytes;
+        }
+        id->filesSent ++;
+
+        if (xfer->entry->hash != 0)
+        {
+            manifestSet(&id->sent, xfer->entry->absPath,
+                        xfer->entry->size, xfer->entry->mtime, xfer->entry->hash);
+            id->sentChanged = TRUE;
+        }
+    }
+
+    fclose(xfer->sendFile);
+    xfer->sendFile = NULL;
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_POSTQUOTE, NULL);
+    curl_slist_free_all(xfer->renameCmnds);
+    xfer->renameCmnds = NULL;
+    xfer->curlError[0] = 0;
+    xfer->busy = FALSE;
+}
+
+// Send everything queued, up to 'parallel' files at a time:
+static void RunQueue(FTP_ID id)
+{
+    CURLMsg*        msg;
+    FTP_XFER*       xfer;
+    int             i, next = 0, running = 0, remaining, numfds;
+
+    while (next < id->queueLength || running > 0)
+    {
+        // Keep every idle slot busy:
+        for (i = 0; i < id->parallel && next < id->queueLength; i ++)
+        {
+            if (id->xfers[i].busy)
+            {
+                continue;
+            }
+            if (StartTransfer(id, &id->xfers[i], &id->queue[next ++]) == OK)
             {
-                wvutilsLogEvent(PRI_STATUS, "FTP-URL: %s", logBfr);
+                running ++;
             }
         }
 
-        // Execute the curl transaction:
-        sendFile = fopen(tempRule, "rb");
-        if (sendFile == NULL)
+        if (running == 0)
         {
-            sprintf(logBfr, "FTP-ERROR: failed to open %s", tempRule);
-            radMsgLog (PRI_HIGH, "%s", logBfr);
-            statusUpdateMessage(logBfr);
-            free(namelist[index]);
             continue;
         }
 
-        // Set curl URL, login and FILE* each time through:
-        curl_easy_setopt(id->curlHandle, CURLOPT_URL, FTPCmndLine);
-        curl_easy_setopt(id->curlHandle, CURLOPT_USERPWD, loginStr);
-        curl_easy_setopt(id->curlHandle, CURLOPT_READDATA, sendFile);
-
-        res = curl_easy_perform(id->curlHandle);
-        if (res != CURLE_OK)
+        curl_multi_perform(id->multiHandle, &remaining);
+        while ((msg = curl_multi_info_read(id->multiHandle, &remaining)) != NULL)
         {
-            sprintf(logBfr, "FTP-ERROR: curl_easy_perform failed: %s", curlError);
-            radMsgLog (PRI_HIGH, "%s", logBfr);
-            statusUpdateMessage(logBfr);
-            statusIncrementStat(FTP_STATS_CONNECT_ERRORS);
+            if (msg->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+
+            for (i = 0; i < id->parallel; i ++)
+            {
+                xfer = &id->xfers[i];
+                if (xfer->busy && xfer->curlHandle == msg->easy_handle)
+                {
+                    FinishTransfer(id, xfer, msg->data.result);
+                    running --;
+                    break;
+                }
+            }
         }
-        else
+
+        if (running > 0)
         {
-            wvutilsLogEvent(PRI_STATUS, "FTP-SUCCESS: %s", tempRule);
-            retVal ++;
+            curl_multi_wait(id->multiHandle, NULL, 0, 1000, &numfds);
         }
+    }
 
-        fclose(sendFile);
-        free(namelist[index]);
+    id->queueLength = 0;
+}
+
+static CURL* CreateHandle(FTP_ID id, FTP_XFER* xfer)
+{
+    char            loginStr[128];
+
+    xfer->curlHandle = curl_easy_init();
+    if (xfer->curlHandle == NULL)
+    {
+        return NULL;
     }
 
-    free(namelist);
-    return retVal;
+    // Setup curl options that are not file specific:
+
+    // Make sure libcurl does NOT use SIG_ALARM:
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_NOSIGNAL, 1L);
+
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_ERRORBUFFER, xfer->curlError);
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_UPLOAD, OPTION_TRUE);
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_TCP_NODELAY, OPTION_TRUE);
+    if (id->IsPassive)
+    {
+        curl_easy_setopt(xfer->curlHandle, CURLOPT_FTP_USE_EPSV, OPTION_TRUE);
+    }
+    else
+    {
+        curl_easy_setopt(xfer->curlHandle, CURLOPT_FTP_USE_EPSV, OPTION_FALSE);
+    }
+
+    // The login is the same for every file (curl copies the string):
+    sprintf(loginStr, "%s:%s", id->user, id->pass);
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_USERPWD, loginStr);
+
+    // Set overall timeout for a file:
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_TIMEOUT, 20L);
+
+    // Set the connection timeout:
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_CONNECTTIMEOUT, 15L);
+
+    // Set server FTP response timeout:
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_FTP_RESPONSE_TIMEOUT, 10L);
+
+    // Set the duration in seconds for the curl handle's DNS cache before flush:
+    // (7 days)
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_DNS_CACHE_TIMEOUT, 604800L);
+
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_NOPROGRESS, OPTION_TRUE);
+
+    // Parallel slots can race to create the same directory; the loser's MKD
+    // fails, so retry the CWD instead of failing the transfer:
+    curl_easy_setopt(xfer->curlHandle, CURLOPT_FTP_CREATE_MISSING_DIRS,
+                     (long)CURLFTP_CREATE_DIR_RETRY);
+
+    return xfer->curlHandle;
 }
 
 
@@ -224,8 +460,10 @@ int ftpUtilsInit (FTP_DATA* data)
     const char*     source;
     int             interval;
     FileStates      state = FS_HOST;
+    char            manifestFName[_MAX_PATH];
 
     newId = (FTP_ID)data;
+    memset (newId, 0, sizeof (*newId));
     radListReset (&newId->rules);
     newId->expiry = 0;
 
@@ -327,6 +565,18 @@ int ftpUtilsInit (FTP_DATA* data)
         radMsgLog (PRI_STATUS, "FTP-CONFIG: using %d minute interval for transfers", iValue);
     }
 
+    // Get the number of concurrent transfers:
+    iValue = wvconfigGetINTValue(configItemFTP_PARALLEL_TRANSFERS);
+    if (iValue == ERROR || iValue <= 0)
+    {
+        newId->parallel = FTP_PARALLEL_DEFAULT;
+    }
+    else
+    {
+        newId->parallel = ((iValue > FTP_MAX_PARALLEL) ? FTP_MAX_PARALLEL : iValue);
+    }
+    radMsgLog (PRI_STATUS, "FTP-CONFIG: using %d concurrent transfers", newId->parallel);
+
     for (i = 1; i <= FTP_MAX_RULES; i ++) 
     {
         rule = (FTP_RULE_ID)malloc (sizeof (*rule));
@@ -370,51 +620,37 @@ int ftpUtilsInit (FTP_DATA* data)
 
     curl_global_init(CURL_GLOBAL_ALL);
 
-
-    // Create curl handle here for all files:
-    newId->curlHandle = curl_easy_init();
-    if (newId->curlHandle == NULL)
+    // One multi handle for the life of the daemon - it holds the connection
+    // cache, so logged in control connections are reused across cycles:
+    newId->multiHandle = curl_multi_init();
+    if (newId->multiHandle == NULL)
     {
         radMsgLog (PRI_HIGH, "FTP-ERROR: failed to initialize curl!");
         statusUpdateMessage("failed to initialize curl");
-        return;
+        return ERROR;
     }
+    curl_multi_setopt(newId->multiHandle, CURLMOPT_MAXCONNECTS, (long)newId->parallel);
 
-    // Setup curl options that are not file specific:
-
-    // Make sure libcurl does NOT use SIG_ALARM:
-    curl_easy_setopt(newId->curlHandle, CURLOPT_NOSIGNAL, 1L);
-
-    curl_easy_setopt(newId->curlHandle, CURLOPT_ERRORBUFFER, curlError);
-    curl_easy_setopt(newId->curlHandle, CURLOPT_UPLOAD, OPTION_TRUE);
-    curl_easy_setopt(newId->curlHandle, CURLOPT_TCP_NODELAY, OPTION_TRUE);
-    if (newId->IsPassive)
+    // Create the transfer slots here for all files:
+    for (i = 0; i < newId->parallel; i ++)
     {
-        curl_easy_setopt(newId->curlHandle, CURLOPT_FTP_USE_EPSV, OPTION_TRUE);
-    }
-    else
-    {
-        curl_easy_setopt(newId->curlHandle, CURLOPT_FTP_USE_EPSV, OPTION_FALSE);
+        if (CreateHandle(newId, &newId->xfers[i]) == NULL)
+        {
+            radMsgLog (PRI_HIGH, "FTP-ERROR: failed to initialize curl!");
+            statusUpdateMessage("failed to initialize curl");
+            return ERROR;
+        }
     }
 
-    // Set overall timeout for a file:
-    curl_easy_setopt(newId->curlHandle, CURLOPT_TIMEOUT, 20L);
-
-    // Set the connection timeout:
-    curl_easy_setopt(newId->curlHandle, CURLOPT_CONNECTTIMEOUT, 15L);
-
-    // Set server FTP response timeout:
-    curl_easy_setopt(newId->curlHandle, CURLOPT_FTP_RESPONSE_TIMEOUT, 10L);
-
-    // Set the duration in seconds for the curl handle's DNS cache before flush:
-    // (7 days)
-    curl_easy_setopt(newId->curlHandle, CURLOPT_DNS_CACHE_TIMEOUT, 604800L);
-
-    curl_easy_setopt(newId->curlHandle, CURLOPT_NOPROGRESS, OPTION_TRUE);
-    curl_easy_setopt(newId->curlHandle, CURLOPT_FTP_CREATE_MISSING_DIRS, OPTION_TRUE);
+    // Content hashes: htmlgend's and those of the files the server has:
+    manifestInit(&newId->published, NULL);
+    sprintf (conftype, "ftp://%s/%s", newId->host, newId->directory);
+    manifestInit(&newId->sent, conftype);
+    sprintf (manifestFName, "%s/%s", WVIEW_RUN_DIR, FTP_MANIFEST_FILE);
+    manifestLoad(&newId->sent, manifestFName);
 
-    radMsgLog (PRI_MEDIUM, "FTP: INIT: %d rules added",
-               radListGetNumberOfNodes (&newId->rules));
+    radMsgLog (PRI_MEDIUM, "FTP: INIT: %d rules added, %d files previously sent",
+               radListGetNumberOfNodes (&newId->rules), newId->sent.count);
 
     return OK;
 }
@@ -422,11 +658,10 @@ int ftpUtilsInit (FTP_DATA* data)
 int ftpUtilsSendFiles (FTP_ID id, char *workdir)
 {
     FTP_RULE_ID     rule;
-    int             retVal, numRules = 0, numFiles = 0;
-    char            markerFName[_MAX_PATH];
+    int             retVal, numRules = 0;
+    char            manifestFName[_MAX_PATH];
     time_t          updateTime = time(NULL);
-
-    sprintf (markerFName, "%s/%s", WVIEW_RUN_DIR, FTP_MARKER_FILE);
+    ULONGLONG       startMS, elapsedMS;
 
     if (id->expiry > updateTime)
     {
@@ -440,6 +675,11 @@ int ftpUtilsSendFiles (FTP_ID id, char *workdir)
         return ERROR;
     }
 
+    // Pick up htmlgend's latest content hashes (a missing manifest just
+    // means every file new since the last send is hashed here):
+    sprintf (manifestFName, "%s/%s", WVIEW_RUN_DIR, HTML_MANIFEST_FILE);
+    manifestLoad(&id->published, manifestFName);
+
     for (rule = (FTP_RULE_ID)radListGetFirst (&id->rules);
          rule != NULL;
          rule = (FTP_RULE_ID)radListGetNext (&id->rules, (NODE_PTR)rule))
@@ -452,15 +692,32 @@ int ftpUtilsSendFiles (FTP_ID id, char *workdir)
 
         wvutilsLogEvent(PRI_STATUS, "FTP-RULE: checking for new %s", rule->src);
 
-        retVal = SendRule(id, rule, markerFName);
+        retVal = QueueRule(id, rule);
         if (retVal > 0)
         {
-            numFiles += retVal;
+            wvutilsLogEvent(PRI_STATUS, "FTP-RULE: %d changed files for %s", retVal, rule->src);
         }
 
         numRules ++;
     }
 
+    // Send all rules' files together:
+    id->filesSent = 0;
+    id->bytesSent = 0;
+    startMS = radTimeGetMSSinceEpoch();
+    RunQueue(id);
+    elapsedMS = radTimeGetMSSinceEpoch() - startMS;
+
+    // Remember what the server has now:
+    if (id->sentChanged)
+    {
+        sprintf (manifestFName, "%s/%s", WVIEW_RUN_DIR, FTP_MANIFEST_FILE);
+        if (manifestSave(&id->sent, manifestFName) == OK)
+        {
+            id->sentChanged = FALSE;
+        }
+    }
+
     // First time through?
     if (id->expiry == 0)
     {
@@ -483,10 +740,10 @@ int ftpUtilsSendFiles (FTP_ID id, char *workdir)
     id->rulesSent += numRules;
     statusUpdateStat(FTP_STATS_RULES_SENT, id->rulesSent);
 
-    // Mark the last update time:
-    wvutilsWriteMarkerFile(markerFName, updateTime);
-
-    wvutilsLogEvent(PRI_STATUS, "FTP-DONE: sent %d files", numFiles);
+    statusUpdateStat(FTP_STATS_FILES_LAST_CYCLE, id->filesSent);
+    wvutilsLogEvent(PRI_STATUS, "FTP-DONE: sent %d files, %.0f bytes in %llu ms (%.0f bytes/sec)",
+                    id->filesSent, id->bytesSent, elapsedMS,
+                    (id->bytesSent * 1000.0) / ((elapsedMS > 0) ? elapsedMS : 1));
     return numRules;
 }
 
@@ -494,9 +751,23 @@ int ftpUtilsSendFiles (FTP_ID id, char *workdir)
 void ftpUtilsExit (FTP_ID id)
 {
     FTP_RULE_ID rule;
+    int         i;
 
-    curl_easy_cleanup(id->curlHandle);
+    for (i = 0; i < id->parallel; i ++)
+    {
+        if (id->xfers[i].curlHandle != NULL)
+        {
+            curl_easy_cleanup(id->xfers[i].curlHandle);
+        }
+    }
+    if (id->multiHandle != NULL)
+    {
+        curl_multi_cleanup(id->multiHandle);
+    }
     curl_global_cleanup();
+    free(id->queue);
+    manifestExit(&id->published);
+    manifestExit(&id->sent);
 
     for (rule = (FTP_RULE_ID)radListRemoveFirst (&id->rules);
          rule != NULL;
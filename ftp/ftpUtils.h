@@ -50,6 +50,7 @@
 #include <datadefs.h>
 #include <wvconfig.h>
 #include <status.h>
+#include <manifest.h>
 
 
 
@@ -64,12 +65,16 @@
 #define OPTION_TRUE             1L
 #define OPTION_FALSE            0L
 #define FTP_MAX_PATH            256
+#define FTP_MAX_PARALLEL        8
+#define FTP_PARALLEL_DEFAULT    4
+#define FTP_TEMP_SUFFIX         ".tmp"
 
 typedef enum
 {
     FTP_STATS_RULES_DEFINED     = 0,
     FTP_STATS_RULES_SENT,
-    FTP_STATS_CONNECT_ERRORS
+    FTP_STATS_CONNECT_ERRORS,
+    FTP_STATS_FILES_LAST_CYCLE
 } FTP_STATS;
 
 
@@ -91,11 +96,44 @@ typedef struct
 }*FTP_RULE_ID;
 
 
+// a file to send this cycle and the content it had when queued
+typedef struct
+{
+    char                path[FTP_MAX_PATH];     // relative to the work dir
+    char                absPath[_MAX_PATH];     // manifest key
+    off_t               size;
+    time_t              mtime;
+    ULONGLONG           hash;
+} FTP_QUEUE_ENTRY;
+
+// one transfer slot: the easy handle (and its login) persists for the life
+// of the daemon, the file and rename commands are per transfer
+typedef struct
+{
+    CURL*               curlHandle;
+    int                 busy;
+    FILE*               sendFile;
+    FTP_QUEUE_ENTRY*    entry;
+    char                url[FTP_MAX_CMND_LENGTH];
+    struct curl_slist*  renameCmnds;
+    char                curlError[CURL_ERROR_SIZE];
+} FTP_XFER;
+
 typedef struct
 {
     RADLIST     rules;
-    CURL*       curlHandle;
+    CURLM*      multiHandle;
+    FTP_XFER    xfers[FTP_MAX_PARALLEL];
+    int         parallel;
+    FTP_QUEUE_ENTRY* queue;                     // files to send this cycle
+    int         queueLength;
+    int         queueSize;
+    int         filesSent;                      // this cycle
+    double      bytesSent;
     int         rulesSent;
+    MANIFEST    published;                      // htmlgend's content hashes
+    MANIFEST    sent;                           // what the server has
+    int         sentChanged;
     char        host[96];
     char        user[64];
     char        pass[64];
@@ -10,6 +10,7 @@
         Date            Engineer        Revision        Remarks
         07/05/2005      M.S. Teel       0               Original
         04/12/2008      W. Krenn        1               metric adaptions
+        10/19/2026      M.S. Teel       2               Pre-compressed siblings
 
   NOTES:
 
@@ -31,6 +32,7 @@
 /*  ... Local include files
 */
 #include <arcrecGenerate.h>
+#include <htmlBuffer.h>
 
 
 /*  ... global memory declarations
@@ -227,7 +229,7 @@ int arcrecGenerateInit
         while (arFileExists (temp, temptime))
         {
             // delete that bad boy!
-            unlink (temp);
+            htmlbufferRemoveFile (temp);
 
             temptime -= WV_SECONDS_IN_DAY;
         }
@@ -254,6 +256,8 @@ int arcrecGenerateInit
     {
         if (arFileExists(temp, temptime) && !arSameDay(temptime, timenow))
         {
+            // only compressed if it has no current sibling:
+            htmlbufferCompressFile (temp);
             daysWritten ++;
             continue;
         }
@@ -268,6 +272,7 @@ int arcrecGenerateInit
                                              arcrecWriteHeader)
             == OK)
         {
+            htmlbufferCompressFile (filename);
             daysWritten ++;
         }
     }
@@ -295,6 +300,10 @@ int arcrecGenerate (ARCHIVE_PKT* record, int isMetric)
     temp = buildArcFilenameFromRecord (record);
 
     retVal = dbsqliteUpdateDailyArchiveReport(temp, record, arcrecWriteHeader, isMetric);
+    if (retVal != ERROR)
+    {
+        htmlbufferCompressFile (temp);
+    }
 
     // we need to do some purging?
     if (retVal == 1 && arWork.daysToKeep > 0)
@@ -305,7 +314,7 @@ int arcrecGenerate (ARCHIVE_PKT* record, int isMetric)
         if (arFileExists (tempname, timenow))
         {
             // delete that bad boy!
-            unlink (tempname);
+            htmlbufferRemoveFile (tempname);
         }
 
         return OK;
@@ -0,0 +1,324 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        astroTest.c
+
+  PURPOSE:
+        Compare the htmlAstro sun and moon table with direct sunTimes and
+        lunarCycle calls ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        For each time zone and station location below, every day of the
+        table is looked up by a time on that local day and compared with
+        the sunTimesGetSunRiseSet, sunTimesGetDayLength, GetMoonRiseSetTimes
+        and lunarPhaseCompute results htmlStates.c used to compute itself,
+        using the UTC offset in effect now as it did. The time zones are
+        POSIX TZ strings so no zoneinfo files are needed; the polar station
+        covers the "never rises/sets" codes.
+
+        htmlastroUpdate and htmlastroGetPhase are checked against today's
+        direct values, then a lookup past the end of the table and a
+        location change are checked to rebuild it. The table build and
+        lookup times are printed but not checked.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+#include <config.h>
+
+/*  ... Library include files
+*/
+
+/*  ... Local include files
+*/
+#include <htmlAstro.h>
+
+
+/*  ... local memory
+*/
+
+typedef struct
+{
+    char            *name;
+    int             latitude;               // tenths of a degree
+    int             longitude;
+} ASTRO_STATION;
+
+static char         *astroZones[] =
+{
+    "UTC0",
+    "MST7MDT,M3.2.0,M11.1.0",
+    "CET-1CEST,M3.5.0,M10.5.0/3",
+    "AEST-10AEDT,M10.1.0,M4.1.0/3"
+};
+
+static ASTRO_STATION astroStations[] =
+{
+    { "Phoenix",        334,    -1121 },
+    { "Helsinki",       602,    249 },
+    { "Sydney",         -339,   1512 },
+    { "Longyearbyen",   782,    156 }
+};
+
+static HTML_MGR     astroMgr;
+static int          astroFailures;
+
+
+static double getUsecs (void)
+{
+    struct timeval      tv;
+
+    gettimeofday (&tv, NULL);
+    return ((double)tv.tv_sec * 1000000.0) + (double)tv.tv_usec;
+}
+
+static float getGMTOffsetHours (void)
+{
+    time_t              timeNow = time (NULL);
+    struct tm           locTime;
+
+    localtime_r (&timeNow, &locTime);
+#ifdef HAVE_STRUCT_TM_TM_ZONE
+    return locTime.tm_gmtoff/(60.0*60.0);
+#else
+    return -timezone/(60.0*60.0);
+#endif
+}
+
+static void check (int condition, char *where, struct tm *day, char *what, double table, double direct)
+{
+    if (! condition)
+    {
+        printf ("astroTest: %s %4.4d%2.2d%2.2d: %s differs: table %g, direct %g - FAIL\n",
+                where, day->tm_year + 1900, day->tm_mon + 1, day->tm_mday,
+                what, table, direct);
+        astroFailures ++;
+    }
+    return;
+}
+
+// what htmlStates.c used to compute for the local day holding 'when':
+static void getDirect (int latitude, int longitude, time_t when, HTML_ASTRO_DAY *direct)
+{
+    struct tm           day;
+    short               tempShort;
+    float               lat = (float)latitude/10, lon = (float)longitude/10;
+    int                 year, month, mday, hour;
+
+    localtime_r (&when, &day);
+    year  = day.tm_year + 1900;
+    month = day.tm_mon + 1;
+    mday  = day.tm_mday;
+
+    sunTimesGetSunRiseSet (year, month, mday, lat, lon, RS_TYPE_SUN,
+                           &direct->sunrise, &direct->sunset);
+    sunTimesGetSunRiseSet (year, month, mday, lat, lon, RS_TYPE_CIVIL,
+                           &direct->civilrise, &direct->civilset);
+    sunTimesGetSunRiseSet (year, month, mday, lat, lon, RS_TYPE_ASTRO,
+                           &direct->astrorise, &direct->astroset);
+    sunTimesGetSunRiseSet (year, month, mday, lat, lon, RS_TYPE_MIDDAY,
+                           &direct->midday, &tempShort);
+    direct->dayLength = sunTimesGetDayLength (year, month, mday, lat, lon);
+
+    GetMoonRiseSetTimes (year, month, mday, getGMTOffsetHours (), lat, lon,
+                         &direct->moonrise, NULL, &direct->moonset, NULL);
+
+    for (hour = 0; hour < 24; hour ++)
+    {
+        direct->phase[hour] = (float)lunarPhaseCompute (year, month, mday, hour);
+    }
+
+    return;
+}
+
+// compare a table entry with the direct computation for the local day 'when':
+static void checkDay (char *where, int latitude, int longitude, time_t when, HTML_ASTRO_DAY *entry)
+{
+    HTML_ASTRO_DAY      direct;
+    struct tm           day;
+    int                 hour;
+
+    localtime_r (&when, &day);
+    if (entry == NULL)
+    {
+        check (FALSE, where, &day, "lookup", 0, 0);
+        return;
+    }
+
+    getDirect (latitude, longitude, when, &direct);
+    check (entry->sunrise == direct.sunrise, where, &day, "sunrise", entry->sunrise, direct.sunrise);
+    check (entry->sunset == direct.sunset, where, &day, "sunset", entry->sunset, direct.sunset);
+    check (entry->civilrise == direct.civilrise, where, &day, "civilrise", entry->civilrise, direct.civilrise);
+    check (entry->civilset == direct.civilset, where, &day, "civilset", entry->civilset, direct.civilset);
+    check (entry->astrorise == direct.astrorise, where, &day, "astrorise", entry->astrorise, direct.astrorise);
+    check (entry->astroset == direct.astroset, where, &day, "astroset", entry->astroset, direct.astroset);
+    check (entry->midday == direct.midday, where, &day, "midday", entry->midday, direct.midday);
+    check (entry->dayLength == direct.dayLength, where, &day, "dayLength", entry->dayLength, direct.dayLength);
+    check (entry->moonrise == direct.moonrise, where, &day, "moonrise", entry->moonrise, direct.moonrise);
+    check (entry->moonset == direct.moonset, where, &day, "moonset", entry->moonset, direct.moonset);
+
+    for (hour = 0; hour < 24; hour ++)
+    {
+        check (entry->phase[hour] == direct.phase[hour], where, &day, "phase",
+               entry->phase[hour], direct.phase[hour]);
+    }
+
+    return;
+}
+
+// noon on the local day 'days' after today:
+static time_t getDay (int days)
+{
+    time_t              timeNow = time (NULL);
+    struct tm           dayTime;
+
+    localtime_r (&timeNow, &dayTime);
+    dayTime.tm_mday  += days;
+    dayTime.tm_hour  = 12;
+    dayTime.tm_min   = 0;
+    dayTime.tm_sec   = 0;
+    dayTime.tm_isdst = -1;
+    return mktime (&dayTime);
+}
+
+static void runCase (char *zone, ASTRO_STATION *station)
+{
+    char                where[128];
+    double              startTime, buildTime, lookupTime, directTime;
+    HTML_ASTRO_DAY      *entry, direct;
+    time_t              when;
+    int                 i;
+
+    setenv ("TZ", zone, 1);
+    tzset ();
+    snprintf (where, sizeof(where), "%s %s", station->name, zone);
+
+    startTime = getUsecs ();
+    entry = htmlastroGetDay (station->latitude, station->longitude, getDay (0));
+    buildTime = getUsecs () - startTime;
+    checkDay (where, station->latitude, station->longitude, getDay (0), entry);
+
+    for (i = 1; i < HTML_ASTRO_DAYS; i ++)
+    {
+        when = getDay (i);
+        checkDay (where, station->latitude, station->longitude, when,
+                  htmlastroGetDay (station->latitude, station->longitude, when));
+    }
+
+    // time a lookup against the direct calls htmlStates.c used to make:
+    when = getDay (HTML_ASTRO_DAYS/2);
+    startTime = getUsecs ();
+    for (i = 0; i < 1000; i ++)
+    {
+        entry = htmlastroGetDay (station->latitude, station->longitude, when);
+    }
+    lookupTime = (getUsecs () - startTime)/1000;
+
+    startTime = getUsecs ();
+    getDirect (station->latitude, station->longitude, when, &direct);
+    directTime = getUsecs () - startTime;
+
+    printf ("astroTest: %-42s build %8.0f us, lookup %6.3f us vs %8.3f us direct\n",
+            where, buildTime, lookupTime, directTime);
+    return;
+}
+
+// the htmlgend entry points, for the current day and hour:
+static void checkManager (void)
+{
+    HTML_ASTRO_DAY      *entry;
+    time_t              timeNow = time (NULL);
+    struct tm           locTime, checkTime;
+    char                phase[128], direct[128];
+
+    astroMgr.stationLatitude  = astroStations[0].latitude;
+    astroMgr.stationLongitude = astroStations[0].longitude;
+    strcpy (astroMgr.mphaseIncrease, "Waxing");
+    strcpy (astroMgr.mphaseDecrease, "Waning");
+    strcpy (astroMgr.mphaseFull, "Full");
+
+    localtime_r (&timeNow, &locTime);
+    if (htmlastroUpdate (&astroMgr) == ERROR)
+    {
+        check (FALSE, "htmlastroUpdate", &locTime, "return", ERROR, OK);
+        return;
+    }
+
+    entry = htmlastroGetDay (astroMgr.stationLatitude, astroMgr.stationLongitude, timeNow);
+    checkDay ("htmlastroGetDay today", astroMgr.stationLatitude, astroMgr.stationLongitude,
+              timeNow, entry);
+    check (astroMgr.sunrise == entry->sunrise && astroMgr.sunset == entry->sunset &&
+           astroMgr.civilrise == entry->civilrise && astroMgr.civilset == entry->civilset &&
+           astroMgr.astrorise == entry->astrorise && astroMgr.astroset == entry->astroset &&
+           astroMgr.midday == entry->midday && astroMgr.dayLength == entry->dayLength &&
+           astroMgr.moonrise == entry->moonrise && astroMgr.moonset == entry->moonset,
+           "htmlastroUpdate", &locTime, "copied times", 0, 0);
+
+    // both read the clock; retry if the hour rolls over in between:
+    do
+    {
+        timeNow = time (NULL);
+        localtime_r (&timeNow, &locTime);
+        strcpy (phase, htmlastroGetPhase (&astroMgr));
+        strcpy (direct, lunarPhaseGet (astroMgr.mphaseIncrease,
+                                       astroMgr.mphaseDecrease,
+                                       astroMgr.mphaseFull));
+        timeNow = time (NULL);
+        localtime_r (&timeNow, &checkTime);
+    } while (checkTime.tm_hour != locTime.tm_hour);
+    if (strcmp (phase, direct) != 0)
+    {
+        printf ("astroTest: htmlastroGetPhase \"%s\" differs from lunarPhaseGet "
+                "\"%s\" - FAIL\n", phase, direct);
+        astroFailures ++;
+    }
+
+    // past the end of the table and a new location both rebuild it:
+    checkDay ("past the table end", astroStations[0].latitude, astroStations[0].longitude,
+              getDay (HTML_ASTRO_DAYS + 10),
+              htmlastroGetDay (astroStations[0].latitude, astroStations[0].longitude,
+                               getDay (HTML_ASTRO_DAYS + 10)));
+    checkDay ("new location", astroStations[1].latitude, astroStations[1].longitude,
+              getDay (0),
+              htmlastroGetDay (astroStations[1].latitude, astroStations[1].longitude,
+                               getDay (0)));
+    return;
+}
+
+int main (int argc, char *argv[])
+{
+    int                 zone, station;
+
+    printf ("astroTest: %d day sun and moon table vs sunTimes and lunarCycle\n",
+            HTML_ASTRO_DAYS);
+
+    for (zone = 0; zone < (int)(sizeof (astroZones) / sizeof (astroZones[0])); zone ++)
+    {
+        for (station = 0; station < (int)(sizeof (astroStations) / sizeof (astroStations[0])); station ++)
+        {
+            runCase (astroZones[zone], &astroStations[station]);
+        }
+    }
+
+    checkManager ();
+
+    printf ("astroTest: %d failures\n", astroFailures);
+    return ((astroFailures == 0) ? 0 : 1);
+}
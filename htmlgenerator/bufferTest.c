@@ -0,0 +1,414 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        bufferTest.c
+
+  PURPOSE:
+        Check the html generator file writes and file cache ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        htmlBuffer.c is built into this program with fopen counting the
+        opens of the file under test, so the checks can tell when a target
+        is read back. In a scratch directory under /tmp:
+            - a write goes through a temporary file which never stays behind
+            - unchanged bytes are not rewritten and, once written by us,
+              the target is not read back to tell (with and without file
+              caching)
+            - a target changed some other way is read back and replaced
+            - an entry holding only a hash is never served as the file
+            - text files of at least the compression size get a gzip
+              sibling holding the same bytes, which is only rewritten when
+              the file changes; smaller and binary files get none, a file
+              which shrinks loses its sibling and a missing one is put back
+            - a sibling older than its file changed in place is refreshed,
+              a newer one is left alone
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <utime.h>
+#include <sys/stat.h>
+
+/*  ... stand-ins for what htmlBuffer.c takes from wvutils and stdio
+*/
+static char         testWatchFile[256];
+static int          testReads;
+
+int wvstrncpy (char *d, const char *s, size_t bufsize)
+{
+    snprintf (d, bufsize, "%s", s);
+    return strlen (s);
+}
+
+static FILE *testFopen (const char *name, const char *mode)
+{
+    if (mode[0] == 'r' && !strcmp (name, testWatchFile))
+    {
+        testReads ++;
+    }
+    return fopen (name, mode);
+}
+
+/*  ... the code under test
+*/
+#define fopen       testFopen
+#include "htmlBuffer.c"
+#undef fopen
+
+
+/*  ... local memory
+*/
+
+#define TEST_FILE_SIZE          20000
+#define TEST_COMPRESS_SIZE      1024
+
+static char         testDir[64];
+static char         testData[2][TEST_FILE_SIZE];
+static int          testFailures;
+
+
+static void check (int condition, char *what)
+{
+    printf ("bufferTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static void makePath (char *path, const char *name)
+{
+    sprintf (path, "%s/%s", testDir, name);
+    return;
+}
+
+static int isFile (char *path, const char *data, int length)
+{
+    struct stat     fileStatus;
+    FILE            *file;
+    char            *contents;
+    int             isSame;
+
+    if (stat (path, &fileStatus) == -1 || fileStatus.st_size != length)
+    {
+        return FALSE;
+    }
+
+    contents = malloc (length + 1);
+    file = fopen (path, "rb");
+    isSame = (file != NULL && fread (contents, 1, length + 1, file) == (size_t)length &&
+              memcmp (contents, data, length) == 0);
+    if (file != NULL)
+    {
+        fclose (file);
+    }
+    free (contents);
+    return isSame;
+}
+
+static ino_t getInode (char *path)
+{
+    struct stat     fileStatus;
+
+    if (stat (path, &fileStatus) == -1)
+    {
+        return 0;
+    }
+    return fileStatus.st_ino;
+}
+
+static void writePlain (char *path, const char *data, int length)
+{
+    FILE            *file;
+
+    file = fopen (path, "wb");
+    if (file == NULL || fwrite (data, 1, length, file) != (size_t)length)
+    {
+        printf ("bufferTest: cannot write %s\n", path);
+    }
+    if (file != NULL)
+    {
+        fclose (file);
+    }
+    return;
+}
+
+// does 'path' hold the gzip of 'length' bytes of 'data'?
+static int isGzipOf (char *path, const char *data, int length)
+{
+    HTML_BUFFER     compressed;
+    z_stream        stream;
+    char            *out;
+    int             retVal, isSame;
+
+    htmlbufferInit (&compressed);
+    if (readData (path, &compressed) == ERROR)
+    {
+        return FALSE;
+    }
+
+    out = malloc (length + 1);
+    memset (&stream, 0, sizeof (stream));
+    if (inflateInit2 (&stream, 15 + 16) != Z_OK)
+    {
+        free (out);
+        htmlbufferFree (&compressed);
+        return FALSE;
+    }
+
+    stream.next_in      = (Bytef *)compressed.data;
+    stream.avail_in     = compressed.length;
+    stream.next_out     = (Bytef *)out;
+    stream.avail_out    = length + 1;
+    retVal = inflate (&stream, Z_FINISH);
+    isSame = (retVal == Z_STREAM_END && stream.total_out == (uLong)length &&
+              memcmp (out, data, length) == 0);
+    inflateEnd (&stream);
+    free (out);
+    htmlbufferFree (&compressed);
+    return isSame;
+}
+
+// move the modification time of 'path' by 'seconds':
+static void moveTime (char *path, int seconds)
+{
+    struct stat     fileStatus;
+    struct utimbuf  times;
+
+    stat (path, &fileStatus);
+    times.actime = times.modtime = fileStatus.st_mtime + seconds;
+    utime (path, &times);
+    return;
+}
+
+// rewrite 'path' in place (not through stdio) and move its time on:
+static void changeBehind (char *path, const char *data, int length)
+{
+    int             fd;
+
+    fd = open (path, O_WRONLY);
+    if (fd < 0 || write (fd, data, length) != length)
+    {
+        printf ("bufferTest: cannot rewrite %s\n", path);
+    }
+    if (fd >= 0)
+    {
+        close (fd);
+    }
+
+    moveTime (path, 10);
+    return;
+}
+
+static void checkWrites (void)
+{
+    char            path[_MAX_PATH], temp[_MAX_PATH + 8];
+    ino_t           inode;
+
+    makePath (path, "page.htm");
+    sprintf (temp, "%s%s", path, HTML_BUFFER_TEMP_EXT);
+    strcpy (testWatchFile, path);
+
+    check (htmlbufferWriteFile (path, testData[0], TEST_FILE_SIZE) == OK &&
+           isFile (path, testData[0], TEST_FILE_SIZE) && access (temp, F_OK) != 0,
+           "new file is written whole, no temporary left");
+
+    inode = getInode (path);
+    testReads = 0;
+    check (htmlbufferWriteFile (path, testData[0], TEST_FILE_SIZE) == OK &&
+           getInode (path) == inode,
+           "unchanged bytes are not rewritten");
+    check (testReads == 0, "unchanged check does not read the file");
+
+    check (htmlbufferWriteFile (path, testData[1], TEST_FILE_SIZE) == OK &&
+           getInode (path) != inode && isFile (path, testData[1], TEST_FILE_SIZE),
+           "changed bytes of the same size replace the file");
+
+    // someone else put the old bytes back:
+    changeBehind (path, testData[0], TEST_FILE_SIZE);
+    testReads = 0;
+    check (htmlbufferWriteFile (path, testData[1], TEST_FILE_SIZE) == OK &&
+           testReads == 1 && isFile (path, testData[1], TEST_FILE_SIZE),
+           "file changed some other way is read and replaced");
+
+    changeBehind (path, testData[1], TEST_FILE_SIZE);
+    inode = getInode (path);
+    testReads = 0;
+    check (htmlbufferWriteFile (path, testData[1], TEST_FILE_SIZE) == OK &&
+           testReads == 1 && getInode (path) == inode,
+           "file changed to the same bytes is kept");
+
+    // a directory in the way of the rename:
+    makePath (path, "page.dir");
+    mkdir (path, 0755);
+    sprintf (temp, "%s%s", path, HTML_BUFFER_TEMP_EXT);
+    check (htmlbufferWriteFile (path, testData[0], 100) == ERROR && access (temp, F_OK) != 0,
+           "failed write leaves no temporary file");
+
+    makePath (path, "report.txt");
+    sprintf (temp, "%s%s", path, HTML_BUFFER_TEMP_EXT);
+    writePlain (temp, testData[0], 1000);
+    check (htmlbufferCommitFile (path) == OK && isFile (path, testData[0], 1000) &&
+           access (temp, F_OK) != 0,
+           "committed temporary file replaces the file");
+    return;
+}
+
+static void checkCache (void)
+{
+    HTML_FILE       *file;
+    char            path[_MAX_PATH];
+
+    makePath (path, "cached.htm");
+    strcpy (testWatchFile, path);
+
+    htmlbufferSetFileCaching (TRUE);
+    htmlbufferWriteFile (path, testData[0], TEST_FILE_SIZE);
+    testReads = 0;
+    file = htmlbufferGetFile (path);
+    check (file != NULL && testReads == 0 && file->contents.length == TEST_FILE_SIZE &&
+           memcmp (file->contents.data, testData[0], TEST_FILE_SIZE) == 0,
+           "written file is served without reading it");
+
+    check (htmlbufferWriteFile (path, testData[0], TEST_FILE_SIZE) == OK && testReads == 0,
+           "cached file is not read to find it unchanged");
+
+    // only the hash is kept without caching:
+    htmlbufferSetFileCaching (FALSE);
+    htmlbufferWriteFile (path, testData[1], TEST_FILE_SIZE);
+    testReads = 0;
+    file = htmlbufferGetFile (path);
+    check (file != NULL && testReads == 1 && file->contents.length == TEST_FILE_SIZE &&
+           memcmp (file->contents.data, testData[1], TEST_FILE_SIZE) == 0,
+           "hash only entry is read before it is served");
+
+    htmlbufferFlushFiles ();
+    testReads = 0;
+    check (htmlbufferWriteFile (path, testData[1], TEST_FILE_SIZE) == OK && testReads == 1,
+           "file without a cache entry is read to compare");
+    return;
+}
+
+
+static void checkSiblings (void)
+{
+    char            path[_MAX_PATH], gzName[_MAX_PATH + 8];
+    ino_t           inode;
+    FILE            *file;
+
+    htmlbufferSetCompression (TEST_COMPRESS_SIZE);
+    makePath (path, "index.htm");
+    sprintf (gzName, "%s%s", path, HTML_BUFFER_GZIP_EXT);
+    strcpy (testWatchFile, path);
+
+    check (htmlbufferWriteFile (path, testData[0], TEST_FILE_SIZE) == OK &&
+           isGzipOf (gzName, testData[0], TEST_FILE_SIZE),
+           "text file gets a gzip sibling");
+
+    inode = getInode (gzName);
+    htmlbufferWriteFile (path, testData[0], TEST_FILE_SIZE);
+    check (getInode (gzName) == inode, "unchanged file keeps its sibling");
+
+    check (htmlbufferWriteFile (path, testData[1], TEST_FILE_SIZE) == OK &&
+           getInode (gzName) != inode && isGzipOf (gzName, testData[1], TEST_FILE_SIZE),
+           "changed file gets a new sibling");
+
+    unlink (gzName);
+    check (htmlbufferWriteFile (path, testData[1], TEST_FILE_SIZE) == OK &&
+           isGzipOf (gzName, testData[1], TEST_FILE_SIZE),
+           "missing sibling of an unchanged file is put back");
+
+    check (htmlbufferWriteFile (path, testData[1], TEST_COMPRESS_SIZE - 1) == OK &&
+           access (gzName, F_OK) != 0,
+           "file below the size loses its sibling");
+
+    makePath (path, "chart.png");
+    sprintf (gzName, "%s%s", path, HTML_BUFFER_GZIP_EXT);
+    check (htmlbufferWriteFile (path, testData[0], TEST_FILE_SIZE) == OK &&
+           access (gzName, F_OK) != 0,
+           "binary file gets no sibling");
+
+    // a report appended to in place:
+    makePath (path, "ARC-2026-10-19.txt");
+    sprintf (gzName, "%s%s", path, HTML_BUFFER_GZIP_EXT);
+    writePlain (path, testData[0], TEST_FILE_SIZE / 2);
+    check (htmlbufferCompressFile (path) == OK &&
+           isGzipOf (gzName, testData[0], TEST_FILE_SIZE / 2),
+           "file changed in place gets a sibling");
+
+    file = fopen (path, "ab");
+    fwrite (&testData[0][TEST_FILE_SIZE / 2], 1, TEST_FILE_SIZE / 2, file);
+    fclose (file);
+    moveTime (gzName, -10);
+    check (htmlbufferCompressFile (path) == OK &&
+           isGzipOf (gzName, testData[0], TEST_FILE_SIZE),
+           "older sibling is refreshed");
+
+    moveTime (path, -20);
+    inode = getInode (gzName);
+    check (htmlbufferCompressFile (path) == OK && getInode (gzName) == inode,
+           "newer sibling is left alone");
+
+    htmlbufferRemoveFile (path);
+    check (access (path, F_OK) != 0 && access (gzName, F_OK) != 0,
+           "removing a file removes its sibling");
+
+    htmlbufferSetCompression (0);
+    makePath (path, "other.htm");
+    sprintf (gzName, "%s%s", path, HTML_BUFFER_GZIP_EXT);
+    check (htmlbufferWriteFile (path, testData[0], TEST_FILE_SIZE) == OK &&
+           access (gzName, F_OK) != 0,
+           "no siblings once compression is off");
+    return;
+}
+
+
+int main (int argc, char *argv[])
+{
+    char            command[128];
+    int             i;
+
+    snprintf (testDir, sizeof (testDir), "/tmp/bufferTest.%d", (int)getpid ());
+    if (mkdir (testDir, 0755) != 0)
+    {
+        printf ("bufferTest: cannot create %s\n", testDir);
+        return 1;
+    }
+
+    for (i = 0; i < TEST_FILE_SIZE; i ++)
+    {
+        testData[0][i] = 'a' + (i % 26);
+        testData[1][i] = 'a' + ((i * 7) % 26);
+    }
+
+    checkWrites ();
+    checkCache ();
+    checkSiblings ();
+    htmlbufferFlushFiles ();
+
+    sprintf (command, "rm -rf %s", testDir);
+    if (system (command) != 0)
+    {
+        printf ("bufferTest: cannot remove %s\n", testDir);
+    }
+
+    printf ("bufferTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
@@ -13,6 +13,8 @@
                                                         side of bucket and at bottom
                                                         with label
         05/15/08        Werner Krenn    2               Add some metric units for dualUnits
+        10/19/2026      M.S. Teel       3               Cache the static layer
+        10/19/2026      M.S. Teel       4               Encode PNGs via glpng
  
   NOTES:
  
@@ -51,6 +53,8 @@
 /*  ... Local include files
 */
 #include <glbucket.h>
+#include <glcache.h>
+#include <glpng.h>
 
 
 /*  ... global memory declarations
@@ -64,6 +68,7 @@
 #define MAX_STEP_MULTIPLIER         9
 
 static BUCKET nonReentrantBucket;
+static GLCACHE_KEY backgroundKey;
 
 static double stepSizeMultipliers[MAX_STEP_MULTIPLIER] =
     {
@@ -363,6 +368,13 @@ static void drawBucket (BUCKET_ID id)
         }
     }
 
+}
+
+static void drawReadings (BUCKET_ID id)
+{
+    char    text[1][32];
+    char    ylabelfmt[24];
+
     //  ... finally, draw units and date
     sprintf (ylabelfmt, "%%.%1.1df %%s", id->decPlaces); // generate the format string with a variable number of decimal places
     sprintf (text[0], ylabelfmt, id-> value, id->units); // build the string with readig and units
@@ -461,6 +473,44 @@ static void drawTitle (BUCKET_ID id)
                    id->titleFGcolor);
 }
 
+// key everything the title and bucket are drawn from - call before
+// createImage replaces the colors with palette indexes:
+static void buildBackgroundKey (BUCKET_ID id)
+{
+    GLCACHE_KEY     *key = &backgroundKey;
+    ULONG           identity;
+
+    identity = glcacheHash (0, &id->width, sizeof(id->width));
+    identity = glcacheHash (identity, &id->height, sizeof(id->height));
+    identity = glcacheHash (identity, id->title, strlen(id->title));
+    identity = glcacheHash (identity, id->units, strlen(id->units));
+    glcacheKeyInit (key, identity);
+
+    glcacheKeyAdd (key, &id->width, sizeof(id->width));
+    glcacheKeyAdd (key, &id->height, sizeof(id->height));
+    glcacheKeyAdd (key, &id->bucketWidth, sizeof(id->bucketWidth));
+    glcacheKeyAdd (key, id->title, sizeof(id->title));
+    glcacheKeyAdd (key, id->units, sizeof(id->units));
+    glcacheKeyAdd (key, &id->imtx, sizeof(id->imtx));
+    glcacheKeyAdd (key, &id->imty, sizeof(id->imty));
+    glcacheKeyAdd (key, &id->imbx, sizeof(id->imbx));
+    glcacheKeyAdd (key, &id->imby, sizeof(id->imby));
+    glcacheKeyAdd (key, &id->min, sizeof(id->min));
+    glcacheKeyAdd (key, &id->max, sizeof(id->max));
+    glcacheKeyAdd (key, &id->stepSize, sizeof(id->stepSize));
+    glcacheKeyAdd (key, &id->decPlaces, sizeof(id->decPlaces));
+    glcacheKeyAdd (key, &id->bgcolor, sizeof(id->bgcolor));
+    glcacheKeyAdd (key, &id->bucketcolor, sizeof(id->bucketcolor));
+    glcacheKeyAdd (key, &id->contentcolor, sizeof(id->contentcolor));
+    glcacheKeyAdd (key, &id->highcolor, sizeof(id->highcolor));
+    glcacheKeyAdd (key, &id->lowcolor, sizeof(id->lowcolor));
+    glcacheKeyAdd (key, &id->titleFGcolor, sizeof(id->titleFGcolor));
+    glcacheKeyAdd (key, &id->titleBGcolor, sizeof(id->titleBGcolor));
+    glcacheKeyAdd (key, &id->textcolor, sizeof(id->textcolor));
+    glcacheKeyAdd (key, &id->isTransparent, sizeof(id->isTransparent));
+    glcacheKeyAdd (key, &id->isDualUnits, sizeof(id->isDualUnits));
+}
+
 static void drawContents (BUCKET_ID id)
 {
     int     y;
@@ -536,6 +586,7 @@ BUCKET_ID bucketCreate (int width, int height, int bucketWidth, char *title)
     newId->titleFGcolor = GLB_DFLT_TITLEFG;
     newId->titleBGcolor = GLB_DFLT_TITLEBG;
     newId->textcolor    = GLB_DFLT_TEXT;
+    newId->pngCompression = GLPNG_DEFAULT_COMPRESSION;
 
     return newId;
 }
@@ -632,6 +683,12 @@ void bucketSetTransparency (BUCKET_ID id, int isTransparent)
     return;
 }
 
+void bucketSetPngCompression (BUCKET_ID id, int compression)
+{
+    id->pngCompression = compression;
+    return;
+}
+
 void bucketSetDualUnits (BUCKET_ID id, int isDualUnits)
 {
     id->isDualUnits = isDualUnits;
@@ -640,13 +697,36 @@ void bucketSetDualUnits (BUCKET_ID id, int isDualUnits)
 
 int bucketRender (BUCKET_ID id)
 {
+    double      geometry[3];
+
+    buildBackgroundKey (id);
+
     if (createImage (id) == -1)
     {
         return -1;
     }
 
-    drawTitle (id);
-    drawBucket (id);
+    if (glcacheRestore (&backgroundKey, id->im, geometry, 3))
+    {
+        id->stepSize        = geometry[0];
+        id->max             = geometry[1];
+        id->pixelconstant   = geometry[2];
+
+        // as drawBucket leaves it:
+        gdImageSetThickness (id->im, 2);
+    }
+    else
+    {
+        drawTitle (id);
+        drawBucket (id);
+
+        geometry[0] = id->stepSize;
+        geometry[1] = id->max;
+        geometry[2] = id->pixelconstant;
+        glcacheStore (&backgroundKey, id->im, geometry, 3);
+    }
+
+    drawReadings (id);
     drawContents (id);
 
     return 0;
@@ -654,19 +734,7 @@ int bucketRender (BUCKET_ID id)
 
 int bucketSave (BUCKET_ID id, char *name)
 {
-    FILE    *out;
-
-    if ((out = fopen (name, "wb")) != NULL)
-    {
-        gdImagePng (id->im, out);
-        fflush (out);
-        fclose (out);
-        return 0;
-    }
-    else
-    {
-        return -1;
-    }
+    return glpngSave (id->im, name, id->pngCompression);
 }
 
 void bucketDestroy (BUCKET_ID id)
@@ -11,6 +11,7 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         09/05/03        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               PNG compression level
  
   NOTES:
         
@@ -76,6 +77,7 @@ typedef struct
     int         titleBGcolor;
     int         textcolor;
     int         isTransparent;
+    int         pngCompression;
     int         isDualUnits;
     int         isMetric;
 } BUCKET, *BUCKET_ID;
@@ -96,6 +98,7 @@ extern void bucketSetHighLowColors (BUCKET_ID id, int hcolor, int lcolor);
 extern void bucketSetTitleColors (BUCKET_ID id, int fg, int bg);
 extern void bucketSetTextColor (BUCKET_ID id, int color);
 extern void bucketSetTransparency (BUCKET_ID id, int isTransparent);
+extern void bucketSetPngCompression (BUCKET_ID id, int compression);
 extern int bucketRender (BUCKET_ID id);
 extern int bucketSave (BUCKET_ID id, char *filename);
 extern void bucketDestroy (BUCKET_ID id);
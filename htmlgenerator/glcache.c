@@ -0,0 +1,263 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        glcache.c
+
+  PURPOSE:
+        Provide the graphics lib background layer cache.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        See glcache.h.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radmsgLog.h>
+#include "gd.h"
+
+/*  ... Local include files
+*/
+#include <glcache.h>
+
+
+/*  ... global memory declarations
+*/
+
+/*  ... global memory referenced
+*/
+
+/*  ... static (local) memory declarations
+*/
+typedef struct
+{
+    ULONG       identity;                   // 0 if the entry is free
+    UCHAR       *key;
+    int         keyLength;
+    int         width;
+    int         height;
+    UCHAR       *pixels;                    // width * height
+    double      geometry[GLCACHE_GEOMETRY_MAX];
+} GLCACHE_ENTRY;
+
+static GLCACHE_ENTRY    cache[GLCACHE_SLOTS];
+static int              cacheHits;
+static int              cacheMisses;
+
+
+static void freeEntry (GLCACHE_ENTRY *entry)
+{
+    if (entry->key != NULL)
+        free (entry->key);
+    if (entry->pixels != NULL)
+        free (entry->pixels);
+
+    memset (entry, 0, sizeof (*entry));
+    return;
+}
+
+// find the entry for 'identity' or, if 'forStore', a free or victim entry:
+static GLCACHE_ENTRY *findEntry (ULONG identity, int forStore)
+{
+    GLCACHE_ENTRY   *freeSlot = NULL;
+    int             i, slot;
+
+    for (i = 0; i < GLCACHE_PROBES; i ++)
+    {
+        slot = (identity + i) % GLCACHE_SLOTS;
+        if (cache[slot].identity == identity)
+        {
+            return &cache[slot];
+        }
+        if (cache[slot].identity == 0 && freeSlot == NULL)
+        {
+            freeSlot = &cache[slot];
+        }
+    }
+
+    if (! forStore)
+    {
+        return NULL;
+    }
+
+    if (freeSlot == NULL)
+    {
+        freeSlot = &cache[identity % GLCACHE_SLOTS];
+    }
+
+    return freeSlot;
+}
+
+
+/*  ... API methods
+*/
+
+void glcacheKeyInit (GLCACHE_KEY *key, ULONG identity)
+{
+    key->length = 0;
+
+    // 0 marks a free entry:
+    key->identity = (identity == 0) ? 1 : identity;
+    return;
+}
+
+void glcacheKeyAdd (GLCACHE_KEY *key, const void *data, int length)
+{
+    if (key->length < 0)
+    {
+        return;
+    }
+
+    if (key->length + length > GLCACHE_KEY_MAX)
+    {
+        // too big to cache:
+        key->length = -1;
+        return;
+    }
+
+    memcpy (&key->buffer[key->length], data, length);
+    key->length += length;
+    return;
+}
+
+ULONG glcacheHash (ULONG hash, const void *data, int length)
+{
+    const UCHAR     *bytes = (const UCHAR *)data;
+    int             i;
+
+    // FNV-1a:
+    if (hash == 0)
+    {
+        hash = 2166136261U;
+    }
+    for (i = 0; i < length; i ++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619U;
+        hash &= 0xFFFFFFFF;
+    }
+
+    return hash;
+}
+
+int glcacheRestore
+(
+    GLCACHE_KEY     *key,
+    gdImagePtr      im,
+    double          *geometry,
+    int             numGeometry
+)
+{
+    GLCACHE_ENTRY   *entry;
+    int             y;
+
+    if (key->length <= 0 || im->trueColor || numGeometry > GLCACHE_GEOMETRY_MAX)
+    {
+        return FALSE;
+    }
+
+    entry = findEntry (key->identity, FALSE);
+    if (entry == NULL ||
+        entry->keyLength != key->length ||
+        entry->width != gdImageSX(im) ||
+        entry->height != gdImageSY(im) ||
+        memcmp (entry->key, key->buffer, key->length) != 0)
+    {
+        cacheMisses ++;
+        return FALSE;
+    }
+
+    cacheHits ++;
+
+    for (y = 0; y < entry->height; y ++)
+    {
+        memcpy (im->pixels[y], &entry->pixels[y * entry->width], entry->width);
+    }
+
+    memcpy (geometry, entry->geometry, numGeometry * sizeof(double));
+    return TRUE;
+}
+
+void glcacheStore
+(
+    GLCACHE_KEY     *key,
+    gdImagePtr      im,
+    double          *geometry,
+    int             numGeometry
+)
+{
+    GLCACHE_ENTRY   *entry;
+    int             y;
+
+    if (key->length <= 0 || im->trueColor || numGeometry > GLCACHE_GEOMETRY_MAX)
+    {
+        return;
+    }
+
+    entry = findEntry (key->identity, TRUE);
+    if (entry->keyLength != key->length ||
+        entry->width != gdImageSX(im) ||
+        entry->height != gdImageSY(im))
+    {
+        // (re)allocate:
+        freeEntry (entry);
+        entry->key = (UCHAR *)malloc (key->length);
+        entry->pixels = (UCHAR *)malloc (gdImageSX(im) * gdImageSY(im));
+        if (entry->key == NULL || entry->pixels == NULL)
+        {
+            radMsgLog (PRI_MEDIUM, "glcacheStore: cannot allocate %d bytes",
+                       key->length + (gdImageSX(im) * gdImageSY(im)));
+            freeEntry (entry);
+            return;
+        }
+        entry->keyLength = key->length;
+        entry->width = gdImageSX(im);
+        entry->height = gdImageSY(im);
+    }
+
+    entry->identity = key->identity;
+    memcpy (entry->key, key->buffer, key->length);
+    for (y = 0; y < entry->height; y ++)
+    {
+        memcpy (&entry->pixels[y * entry->width], im->pixels[y], entry->width);
+    }
+    memcpy (entry->geometry, geometry, numGeometry * sizeof(double));
+
+    return;
+}
+
+void glcacheFlush (void)
+{
+    int             i;
+
+    if (cacheHits + cacheMisses > 0)
+    {
+        radMsgLog (PRI_STATUS, "glcache: %d of %d static layers restored",
+                   cacheHits, cacheHits + cacheMisses);
+        cacheHits = cacheMisses = 0;
+    }
+
+    for (i = 0; i < GLCACHE_SLOTS; i ++)
+    {
+        freeEntry (&cache[i]);
+    }
+
+    return;
+}
@@ -0,0 +1,92 @@
+#ifndef INC_glcacheh
+#define INC_glcacheh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        glcache.h
+
+  PURPOSE:
+        Provide the graphics lib background layer cache definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The chart, multichart and bucket renderers draw their static layer
+        (title, frame, grid and y scales) first and the data last. The
+        static layer only changes when the scale, size or colors do, so it
+        is cached per chart "identity" (a hash of the type, size, title and
+        units) along with a key of everything it was drawn from. A render
+        with the same key just copies the cached pixels into the new image
+        and draws the data; a different key redraws and replaces the entry.
+
+        Anything that changes every generation cycle stays out of the static
+        layer and its key: the date line, the bucket readings and the chart
+        x-axis labels (the daily charts shift theirs with every archive
+        record). Only the widest x label is keyed, since it sets the x-axis
+        hashes. glcacheFlush logs how many renders hit the cache.
+
+        Only palette images (gdImageCreate) are cached. The image the pixels
+        are restored into must have had the same colors allocated in the same
+        order as the cached one - the colors are part of the key.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+#include "gd.h"
+#include <sysdefs.h>
+
+
+#define GLCACHE_SLOTS               128
+#define GLCACHE_PROBES              8
+#define GLCACHE_GEOMETRY_MAX        8
+#define GLCACHE_KEY_MAX             2048
+
+typedef struct
+{
+    UCHAR       buffer[GLCACHE_KEY_MAX];
+    int         length;
+    ULONG       identity;
+} GLCACHE_KEY;
+
+
+//  ... API prototypes
+
+// Start a key; 'identity' selects the cache entry of the chart:
+extern void glcacheKeyInit (GLCACHE_KEY *key, ULONG identity);
+
+// Append data the static layer is drawn from to the key:
+extern void glcacheKeyAdd (GLCACHE_KEY *key, const void *data, int length);
+
+// Hash 'length' bytes of 'data' into 'hash' (start with 0):
+extern ULONG glcacheHash (ULONG hash, const void *data, int length);
+
+// If the static layer for 'key' is cached, copy it into 'im' and restore the
+// 'numGeometry' values computed while drawing it; returns TRUE or FALSE:
+extern int glcacheRestore
+(
+    GLCACHE_KEY     *key,
+    gdImagePtr      im,
+    double          *geometry,
+    int             numGeometry
+);
+
+// Store the static layer just drawn in 'im' with its computed geometry:
+extern void glcacheStore
+(
+    GLCACHE_KEY     *key,
+    gdImagePtr      im,
+    double          *geometry,
+    int             numGeometry
+);
+
+// Release all cached layers:
+extern void glcacheFlush (void);
+
+#endif
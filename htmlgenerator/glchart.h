@@ -13,6 +13,8 @@
         09/05/03        M.S. Teel       0               Original
         05/15/08        Werner Krenn    1               dualUnits
         05/05/09        D. Pickett      2               Add scatter charts
+        10/19/2026      M.S. Teel       3               PNG compression level
+        10/19/2026      M.S. Teel       4               Keep the x-axis hashes
  
   NOTES:
         
@@ -78,6 +80,9 @@ typedef struct
     double      xmax;
     int         numpoints;
     double      pointpixels;
+    int         xhashcount;                 // x-axis hashes, set by drawGrid
+    double      xhashwidth;
+    int         xhashindexlen;
     char        pointnames[MAX_GRAPH_POINTS][16];
     double      valueset[MAX_GRAPH_POINTS];
     int         bgcolor;
@@ -88,6 +93,7 @@ typedef struct
     int         titleBGcolor;
     int         textcolor;
     int         isTransparent;
+    int         pngCompression;
     int         isMetric;
     char        DualUnit[6];
 } CHART, *CHART_ID;
@@ -119,6 +125,7 @@ extern void chartSetLineColor (CHART_ID id, int color);
 extern void chartSetTitleColors (CHART_ID id, int fg, int bg);
 extern void chartSetTextColor (CHART_ID id, int color);
 extern void chartSetTransparency (CHART_ID id, int isTransparent);
+extern void chartSetPngCompression (CHART_ID id, int compression);
 extern void chartSetDualUnits (CHART_ID id);
 extern int chartRender (CHART_ID id);
 extern int chartSave (CHART_ID id, char *filename);
@@ -9,6 +9,8 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         02/06/05        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Cache the static layer
+        10/19/2026      M.S. Teel       2               Encode PNGs via glpng
  
   NOTES:
         
@@ -47,6 +49,8 @@
 /*  ... Local include files
 */
 #include "glmultichart.h"
+#include "glcache.h"
+#include "glpng.h"
 
 
 /*  ... global memory declarations
@@ -60,6 +64,7 @@
 #define MAX_STEP_MULTIPLIER         9
 
 static MULTICHART nonReentrantMultiChart;
+static GLCACHE_KEY backgroundKey;
 
 static double stepSizeMultipliers[MAX_STEP_MULTIPLIER] =
     {
@@ -145,10 +150,25 @@ static int createImage (MULTICHART_ID id)
 }
 
 
+// the widest x-axis label, in characters:
+static int getXLabelWidth (MULTICHART_ID id)
+{
+    register int    i;
+    int             xlabelwidth = 0;
+
+    for (i = 0; i < id->numpoints; i ++)
+    {
+        if (strlen (id->pointnames[i]) > xlabelwidth)
+            xlabelwidth = strlen (id->pointnames[i]);
+    }
+
+    return xlabelwidth;
+}
+
 static void drawGrid (MULTICHART_ID id)
 {
     register int    i;
-    int             xlabelwidth = 0, ylabelwidth = 0;
+    int             xlabelwidth, ylabelwidth = 0;
     double          units, step;
     double          minR, stepR;
     int             dataPoints, xnumhash, xhashindexlen;
@@ -159,12 +179,8 @@ static void drawGrid (MULTICHART_ID id)
 
     //  ... calculate the maximum number of hash marks and the units per hash
     //  ... for the x-axis
-    //  build labels and calculate the maximum x-label width
-    for (i = 0; i < id->numpoints; i ++)
-    {
-        if (strlen (id->pointnames[i]) > xlabelwidth)
-            xlabelwidth = strlen (id->pointnames[i]);
-    }
+    //  calculate the maximum x-label width
+    xlabelwidth = getXLabelWidth (id);
 
     xhashwidth = (xlabelwidth*gdFontSmall->h)/2;
     dataPoints = id->numpoints - 1;
@@ -209,6 +225,10 @@ static void drawGrid (MULTICHART_ID id)
     id->pointpixels = (double)(id->imbx - id->imtx)/(double)dataPoints;
     xhashindexlen = dataPoints/xnumhash;
 
+    id->xhashcount = xnumhash;
+    id->xhashwidth = xhashwidth;
+    id->xhashindexlen = xhashindexlen;
+
 
     //  ... calculate the maximum number of hash marks and the units per hash
     //  ... for the y-axis
@@ -395,8 +415,6 @@ static void drawGrid (MULTICHART_ID id)
 
     for (i = 0; i <= xnumhash; i ++)            // one more for right-most
     {
-        int         dataPoint = i * xhashindexlen;
-
         x = id->imtx + (i * xhashwidth);
 
         gdImageLine (id->im,
@@ -405,6 +423,21 @@ static void drawGrid (MULTICHART_ID id)
                      x,
                      id->imby,
                      id->gridcolor);
+    }
+}
+
+// the x-axis labels move with the data, so they are not part of the
+// cached static layer:
+static void drawXLabels (MULTICHART_ID id)
+{
+    register int    i;
+    int             x;
+
+    for (i = 0; i <= id->xhashcount; i ++)      // one more for right-most
+    {
+        int         dataPoint = i * id->xhashindexlen;
+
+        x = id->imtx + (i * id->xhashwidth);
 
         if (strlen(id->pointnames[dataPoint]) < 2)
             x -= gdFontSmall->h/4;
@@ -417,9 +450,10 @@ static void drawGrid (MULTICHART_ID id)
                        (UCHAR *)id->pointnames[dataPoint],
                        id->textcolor);
     }
+}
 
-
-    //  ... finally, draw date
+static void drawDateTime (MULTICHART_ID id)
+{
     gdImageString (id->im,
                    gdFontSmall,
                    ((id->width - ((gdFontSmall->h/2) * strlen (id->datetime)))/2) - 2,
@@ -514,6 +548,58 @@ static void drawTitle (MULTICHART_ID id)
     }
 }
 
+// key everything the title and grid are drawn from - call before createImage
+// replaces the colors with palette indexes:
+static void buildBackgroundKey (MULTICHART_ID id)
+{
+    GLCACHE_KEY     *key = &backgroundKey;
+    ULONG           identity;
+    int             i, xlabelwidth;
+
+    identity = glcacheHash (0, &id->isBarChart, sizeof(id->isBarChart));
+    identity = glcacheHash (identity, &id->width, sizeof(id->width));
+    identity = glcacheHash (identity, &id->height, sizeof(id->height));
+    identity = glcacheHash (identity, &id->numpoints, sizeof(id->numpoints));
+    identity = glcacheHash (identity, &id->numdatasets, sizeof(id->numdatasets));
+    identity = glcacheHash (identity, id->title, strlen(id->title));
+    glcacheKeyInit (key, identity);
+
+    glcacheKeyAdd (key, &id->isBarChart, sizeof(id->isBarChart));
+    glcacheKeyAdd (key, &id->width, sizeof(id->width));
+    glcacheKeyAdd (key, &id->height, sizeof(id->height));
+    glcacheKeyAdd (key, id->title, sizeof(id->title));
+    glcacheKeyAdd (key, &id->numdatasets, sizeof(id->numdatasets));
+    for (i = 0; i < id->numdatasets; i ++)
+    {
+        glcacheKeyAdd (key, id->dataset[i].legend, sizeof(id->dataset[i].legend));
+        glcacheKeyAdd (key, &id->dataset[i].lineColor, sizeof(id->dataset[i].lineColor));
+    }
+    glcacheKeyAdd (key, &id->xnumhashes, sizeof(id->xnumhashes));
+    glcacheKeyAdd (key, &id->ydecPlaces, sizeof(id->ydecPlaces));
+    glcacheKeyAdd (key, &id->ystepSize, sizeof(id->ystepSize));
+    glcacheKeyAdd (key, &id->min, sizeof(id->min));
+    glcacheKeyAdd (key, &id->max, sizeof(id->max));
+    glcacheKeyAdd (key, &id->imtx, sizeof(id->imtx));
+    glcacheKeyAdd (key, &id->imty, sizeof(id->imty));
+    glcacheKeyAdd (key, &id->imbx, sizeof(id->imbx));
+    glcacheKeyAdd (key, &id->imby, sizeof(id->imby));
+    glcacheKeyAdd (key, &id->bgcolor, sizeof(id->bgcolor));
+    glcacheKeyAdd (key, &id->chartcolor, sizeof(id->chartcolor));
+    glcacheKeyAdd (key, &id->gridcolor, sizeof(id->gridcolor));
+    glcacheKeyAdd (key, &id->titleFGcolor, sizeof(id->titleFGcolor));
+    glcacheKeyAdd (key, &id->titleBGcolor, sizeof(id->titleBGcolor));
+    glcacheKeyAdd (key, &id->textcolor, sizeof(id->textcolor));
+    glcacheKeyAdd (key, &id->isTransparent, sizeof(id->isTransparent));
+    glcacheKeyAdd (key, &id->isMetric, sizeof(id->isMetric));
+    glcacheKeyAdd (key, id->DualUnit, sizeof(id->DualUnit));
+    glcacheKeyAdd (key, &id->numpoints, sizeof(id->numpoints));
+
+    // the labels themselves are drawn after the static layer, but their
+    // width sets the x-axis hashes:
+    xlabelwidth = getXLabelWidth (id);
+    glcacheKeyAdd (key, &xlabelwidth, sizeof(xlabelwidth));
+}
+
 static void drawLines (MULTICHART_ID id)
 {
     register int    i, j;
@@ -638,6 +724,7 @@ MULTICHART_ID multiChartCreate
     newId->titleFGcolor = GLC_DFLT_TITLEFG;
     newId->titleBGcolor = GLC_DFLT_TITLEBG;
     newId->textcolor    = GLC_DFLT_TEXT;
+    newId->pngCompression = GLPNG_DEFAULT_COMPRESSION;
 
     return newId;
 }
@@ -747,6 +834,12 @@ void multiChartSetTransparency (MULTICHART_ID id, int isTransparent)
     return;
 }
 
+void multiChartSetPngCompression (MULTICHART_ID id, int compression)
+{
+    id->pngCompression = compression;
+    return;
+}
+
 void multiChartSetDualUnits (MULTICHART_ID id)
 {
     htmlutilsSetDualUnits (id->isMetric, id->title, id->DualUnit);
@@ -755,13 +848,44 @@ void multiChartSetDualUnits (MULTICHART_ID id)
 
 int multiChartRender (MULTICHART_ID id)
 {
+    double      geometry[8];
+
+    buildBackgroundKey (id);
+
     if (createImage (id) == -1)
     {
         return -1;
     }
 
-    drawTitle (id);
-    drawGrid (id);
+    if (glcacheRestore (&backgroundKey, id->im, geometry, 8))
+    {
+        id->imbx            = (int)geometry[0];
+        id->ystepSize       = geometry[1];
+        id->max             = geometry[2];
+        id->ypixelconstant  = geometry[3];
+        id->pointpixels     = geometry[4];
+        id->xhashcount      = (int)geometry[5];
+        id->xhashwidth      = geometry[6];
+        id->xhashindexlen   = (int)geometry[7];
+    }
+    else
+    {
+        drawTitle (id);
+        drawGrid (id);
+
+        geometry[0] = id->imbx;
+        geometry[1] = id->ystepSize;
+        geometry[2] = id->max;
+        geometry[3] = id->ypixelconstant;
+        geometry[4] = id->pointpixels;
+        geometry[5] = id->xhashcount;
+        geometry[6] = id->xhashwidth;
+        geometry[7] = id->xhashindexlen;
+        glcacheStore (&backgroundKey, id->im, geometry, 8);
+    }
+
+    drawXLabels (id);
+    drawDateTime (id);
     drawLines (id);
 
     return 0;
@@ -769,18 +893,7 @@ int multiChartRender (MULTICHART_ID id)
 
 int multiChartSave (MULTICHART_ID id, char *name)
 {
-    FILE    *out;
-
-    if ((out = fopen (name, "wb")) != NULL)
-    {
-        gdImagePng (id->im, out);
-        fclose (out);
-        return 0;
-    }
-    else
-    {
-        return -1;
-    }
+    return glpngSave (id->im, name, id->pngCompression);
 }
 
 void multiChartDestroy (MULTICHART_ID id)
@@ -11,6 +11,8 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         02/06/05        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               PNG compression level
+        10/19/2026      M.S. Teel       2               Keep the x-axis hashes
  
   NOTES:
         
@@ -60,6 +62,9 @@ typedef struct
     MC_DATASET  dataset[MC_MAX_DATA_SETS];
     char        pointnames[MAX_GRAPH_POINTS][16];
     double      pointpixels;
+    int         xhashcount;                 // x-axis hashes, set by drawGrid
+    double      xhashwidth;
+    int         xhashindexlen;
     int         bgcolor;
     int         chartcolor;
     int         gridcolor;
@@ -67,6 +72,7 @@ typedef struct
     int         titleBGcolor;
     int         textcolor;
     int         isTransparent;
+    int         pngCompression;
     int         isMetric;
     char        DualUnit[6];
 } MULTICHART, *MULTICHART_ID;
@@ -98,6 +104,7 @@ extern void multiChartSetLineColor (MULTICHART_ID id, int dataset, int color);
 extern void multiChartSetTitleColors (MULTICHART_ID id, int fg, int bg);
 extern void multiChartSetTextColor (MULTICHART_ID id, int color);
 extern void multiChartSetTransparency (MULTICHART_ID id, int isTransparent);
+extern void multiChartSetPngCompression (MULTICHART_ID id, int compression);
 extern int multiChartRender (MULTICHART_ID id);
 extern int multiChartSave (MULTICHART_ID id, char *filename);
 extern void multiChartDestroy (MULTICHART_ID id);
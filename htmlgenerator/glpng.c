@@ -0,0 +1,78 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        glpng.c
+
+  PURPOSE:
+        Provide the graphics lib PNG encoder.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Write via htmlbufferWriteFile
+
+  NOTES:
+        See glpng.h.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radmsgLog.h>
+#include "gd.h"
+
+/*  ... Local include files
+*/
+#include <htmlBuffer.h>
+#include <glpng.h>
+
+
+/*  ... global memory declarations
+*/
+
+/*  ... global memory referenced
+*/
+
+/*  ... static (local) memory declarations
+*/
+
+
+/*  ... API methods
+*/
+
+int glpngSave (gdImagePtr im, char *filename, int compression)
+{
+    void            *data;
+    int             size, retVal = 0;
+
+    if (compression < -1 || compression > 9)
+    {
+        compression = GLPNG_DEFAULT_COMPRESSION;
+    }
+
+    data = gdImagePngPtrEx (im, &size, compression);
+    if (data == NULL)
+    {
+        return -1;
+    }
+
+    if (htmlbufferWriteFile (filename, data, size) == ERROR)
+    {
+        retVal = -1;
+    }
+
+    gdFree (data);
+    return retVal;
+}
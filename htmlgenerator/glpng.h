@@ -0,0 +1,42 @@
+#ifndef INC_glpngh
+#define INC_glpngh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        glpng.h
+
+  PURPOSE:
+        Provide the graphics lib PNG encoder definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Write via htmlbufferWriteFile
+
+  NOTES:
+        Images are encoded in memory at the configured zlib level and
+        committed with htmlbufferWriteFile (temporary file and rename, nothing
+        written if the target already holds exactly the encoded bytes).
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+#include "gd.h"
+
+
+// zlib compression level: 0 (none) to 9 (best), -1 for the zlib default (6)
+#define GLPNG_DEFAULT_COMPRESSION   -1
+
+
+//  ... API prototypes
+
+// Encode 'im' at 'compression' and write it to 'filename' unless it already
+// holds the same image; returns 0 or -1
+extern int glpngSave (gdImagePtr im, char *filename, int compression);
+
+#endif
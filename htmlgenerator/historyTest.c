@@ -0,0 +1,272 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        historyTest.c
+
+  PURPOSE:
+        Check the chart history ring ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        Each ring is driven the way htmlMgr.c drives it (load at init, then
+        an advance and a set of the newest value per field for each record,
+        with NULL records for a gap) next to a plain array that is shifted
+        left for each record, as the generator did before the ring. The
+        contiguous view must match the shifted array after every record,
+        across many wraps of the head.
+
+        The append and shift times are printed but not checked.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/*  ... Library include files
+*/
+
+/*  ... Local include files
+*/
+#include <sysdefs.h>
+#include <htmlHistory.h>
+
+
+/*  ... local memory
+*/
+
+#define TEST_FIELDS             4
+#define TEST_CAPACITY           1441        // MAX_DAILY_NUM_VALUES
+#define TEST_RECORDS            10000
+#define TEST_NULL               -100000     // ARCHIVE_VALUE_NULL
+
+static float        testStore[TEST_FIELDS][2 * TEST_CAPACITY];
+static float        testShifted[TEST_FIELDS][TEST_CAPACITY];
+static int          testFailures;
+
+
+static void check (int condition, char *what)
+{
+    printf ("historyTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static float testValue (int record, int field)
+{
+    return (float)((record * 10) + field);
+}
+
+// append a record to the ring and to the shifted reference:
+static void appendRecord (HTML_HISTORY *hist, int record, int isNull)
+{
+    int             field;
+    float           value;
+
+    htmlhistoryAdvance (hist);
+    for (field = 0; field < TEST_FIELDS; field ++)
+    {
+        value = (isNull ? TEST_NULL : testValue (record, field));
+        htmlhistorySet (hist, field, hist->length - 1, value);
+
+        memmove (&testShifted[field][0], &testShifted[field][1],
+                 (hist->length - 1) * sizeof (float));
+        testShifted[field][hist->length - 1] = value;
+    }
+    return;
+}
+
+static int isSame (HTML_HISTORY *hist)
+{
+    int             field;
+
+    for (field = 0; field < TEST_FIELDS; field ++)
+    {
+        if (memcmp (HTML_HISTORY_VALUES(hist, field), &testShifted[field][0],
+                    hist->length * sizeof (float)) != 0)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+// both copies of every slot must hold the same value:
+static int isMirrored (HTML_HISTORY *hist)
+{
+    int             field, slot;
+    float           *values;
+
+    for (field = 0; field < TEST_FIELDS; field ++)
+    {
+        values = hist->store + (field * 2 * hist->capacity);
+        for (slot = 0; slot < hist->length; slot ++)
+        {
+            if (values[slot] != values[slot + hist->length])
+            {
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
+// load 'length' records at init, as htmlmgrHistoryInit does:
+static void loadRing (HTML_HISTORY *hist, int length)
+{
+    int             field, i;
+
+    htmlhistoryInit (hist, &testStore[0][0], TEST_CAPACITY, length);
+    for (field = 0; field < TEST_FIELDS; field ++)
+    {
+        for (i = 0; i < length; i ++)
+        {
+            htmlhistorySet (hist, field, i, testValue (i - length, field));
+            testShifted[field][i] = testValue (i - length, field);
+        }
+    }
+    return;
+}
+
+static void checkRing (int length, char *what)
+{
+    HTML_HISTORY    hist;
+    char            text[128];
+    int             record, isRight = TRUE;
+
+    loadRing (&hist, length);
+    isRight = isSame (&hist) && isMirrored (&hist);
+
+    for (record = 0; record < TEST_RECORDS && isRight; record ++)
+    {
+        appendRecord (&hist, record, FALSE);
+        if (! isSame (&hist) || ! isMirrored (&hist))
+        {
+            printf ("historyTest: length %d differs after record %d (head %d)\n",
+                    length, record, hist.head);
+            isRight = FALSE;
+        }
+    }
+
+    sprintf (text, "%s matches a shifted array", what);
+    check (isRight, text);
+    return;
+}
+
+// a gap of 'missed' records, then a record, as htmlmgrAddSampleValue does:
+static void checkGap (int length, int missed, char *what)
+{
+    HTML_HISTORY    hist;
+    int             field, i, numIntervals = missed + 1, isRight;
+
+    loadRing (&hist, length);
+    for (i = 0; i < length / 3; i ++)
+    {
+        appendRecord (&hist, i, FALSE);
+    }
+
+    if (numIntervals > hist.length)
+    {
+        numIntervals = hist.length;
+    }
+    while (numIntervals > 1)
+    {
+        appendRecord (&hist, 0, TRUE);
+        numIntervals --;
+    }
+    appendRecord (&hist, length, FALSE);
+
+    isRight = isSame (&hist) && isMirrored (&hist);
+    for (field = 0; field < TEST_FIELDS; field ++)
+    {
+        for (i = 0; i < length - 1; i ++)
+        {
+            if ((i >= length - 1 - missed) !=
+                (HTML_HISTORY_VALUES(&hist, field)[i] == TEST_NULL))
+            {
+                isRight = FALSE;
+            }
+        }
+        if (HTML_HISTORY_VALUES(&hist, field)[length - 1] != testValue (length, field))
+        {
+            isRight = FALSE;
+        }
+    }
+
+    check (isRight, what);
+    return;
+}
+
+static double getUsecs (void)
+{
+    struct timeval      tv;
+
+    gettimeofday (&tv, NULL);
+    return ((double)tv.tv_sec * 1000000.0) + (double)tv.tv_usec;
+}
+
+static void printTimes (void)
+{
+    HTML_HISTORY    hist;
+    double          ringTime, shiftTime;
+    int             field, record;
+
+    loadRing (&hist, TEST_CAPACITY);
+    ringTime = getUsecs ();
+    for (record = 0; record < TEST_RECORDS; record ++)
+    {
+        htmlhistoryAdvance (&hist);
+        for (field = 0; field < TEST_FIELDS; field ++)
+        {
+            htmlhistorySet (&hist, field, hist.length - 1, testValue (record, field));
+        }
+    }
+    ringTime = getUsecs () - ringTime;
+
+    shiftTime = getUsecs ();
+    for (record = 0; record < TEST_RECORDS; record ++)
+    {
+        for (field = 0; field < TEST_FIELDS; field ++)
+        {
+            memmove (&testShifted[field][0], &testShifted[field][1],
+                     (TEST_CAPACITY - 1) * sizeof (float));
+            testShifted[field][TEST_CAPACITY - 1] = testValue (record, field);
+        }
+    }
+    shiftTime = getUsecs () - shiftTime;
+
+    printf ("historyTest: %d records of %d: ring %.0f us, shift %.0f us\n",
+            TEST_RECORDS, TEST_CAPACITY, ringTime, shiftTime);
+    return;
+}
+
+
+int main (int argc, char *argv[])
+{
+    checkRing (TEST_CAPACITY, "full capacity ring");
+    checkRing (289, "day ring below capacity");
+    checkRing (169, "week ring");
+    checkRing (1, "single value ring");
+    checkGap (289, 5, "gap fills the missed records with NULL");
+    checkGap (289, 1000, "gap longer than the ring empties it");
+
+    printTimes ();
+
+    printf ("historyTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
@@ -9,6 +9,10 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         08/27/03        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Coalesced archive generation
+        10/19/2026      M.S. Teel       2               Live data documents
+        10/19/2026      M.S. Teel       3               Embedded HTTP server
+        10/19/2026      M.S. Teel       4               Pre-compressed siblings
  
   NOTES:
         
@@ -60,6 +64,9 @@ static char*                    htmlStatusLabels[STATUS_STATS_MAX] =
     "Templates generated"
 };
 
+static int                      htmlGenerateLimits[STATUS_HISTOGRAM_BINS - 1] =
+    HTML_GENERATE_MS_LIMITS;
+
 /* ... methods
 */
 /*  ... system initialization
@@ -243,6 +250,13 @@ static void msgHandler
         wvutilsSendPMONPollResponse(pPoll->mask, PMON_PROCESS_HTMLGEND);
         return;
     }
+    else if (msgType == WVIEW_MSG_TYPE_LOOP_DATA_SVC)
+    {
+        // only registered for when serving the event stream:
+        LOOP_PKT            loop = ((WVIEW_MSG_LOOP_DATA*)msg)->loopData;
+        htmlserverPushLoop (&loop);
+        return;
+    }
     else if (msgType == WVIEW_MSG_TYPE_SHUTDOWN)
     {
         radMsgLog (PRI_HIGH, "htmlgend: received shutdown from wviewd"); 
@@ -321,6 +335,20 @@ static void rxtimerHandler (void *parm)
     return;
 }
 
+static void coalesceTimerHandler (void *parm)
+{
+    STIM            stim;
+
+    memset(&stim, 0, sizeof (stim));
+
+    stim.type           = STIM_TIMER;
+    stim.timerNumber    = TIMER_COALESCE;
+
+    radStatesProcess(htmlWork.stateMachine, &stim);
+
+    return;
+}
+
 static void noaaTimerHandler (void *parm)
 {
     noaaGenerate(htmlWork.noaaId, time(NULL));
@@ -672,6 +700,35 @@ int main (int argc, char *argv[])
         htmlWork.isDualUnits = 0;
     }
 
+    // Which live data documents?..
+    htmlWork.dataFormats = HTML_DATA_JSON;
+    iValue = wvconfigGetBooleanValue(configItem_HTMLGEN_DATA_JSON);
+    if (iValue == 0)
+    {
+        htmlWork.dataFormats &= ~HTML_DATA_JSON;
+    }
+    iValue = wvconfigGetBooleanValue(configItem_HTMLGEN_DATA_BINARY);
+    if (iValue > 0)
+    {
+        htmlWork.dataFormats |= HTML_DATA_BINARY;
+    }
+
+    // Do the text files get a gzip sibling?..
+    iValue = wvconfigGetINTValue(configItem_HTMLGEN_PRECOMPRESS_SIZE);
+    if (iValue > 0)
+    {
+        htmlbufferSetCompression (iValue);
+        radMsgLog (PRI_STATUS, "writing gzip copies of text files of %d bytes or more",
+                   iValue);
+    }
+
+    // Are we serving the pages ourselves?..
+    iValue = wvconfigGetINTValue(configItem_HTMLGEN_HTTP_PORT);
+    if (iValue > 0 && iValue <= 65535)
+    {
+        htmlWork.httpPort = iValue;
+    }
+
     wvconfigExit ();
 
     if (statusInit(htmlWork.statusFile, htmlStatusLabels) == ERROR)
@@ -683,6 +740,7 @@ int main (int argc, char *argv[])
         exit (1);
     }
     statusUpdate(STATUS_BOOTING);
+    statusHistogramInit(HTML_HISTOGRAM_GENERATE_MS, "Generation ms", htmlGenerateLimits);
 
 
     // ... Initialize the generator:
@@ -812,6 +870,33 @@ int main (int argc, char *argv[])
         exit (1);
     }
 
+    htmlWork.coalesceTimer = radTimerCreate (NULL, coalesceTimerHandler, NULL);
+    if (htmlWork.coalesceTimer == NULL)
+    {
+        radMsgLog (PRI_HIGH, "radTimerCreate 4 failed");
+        statusUpdateMessage("radTimerCreate 4 failed");
+        statusUpdate(STATUS_ERROR);
+        radTimerDelete (htmlWork.noaaTimer);
+        radTimerDelete (htmlWork.rxTimer);
+        radTimerDelete (htmlWork.timer);
+        radStatesExit (htmlWork.stateMachine);
+        htmlSysExit (&htmlWork);
+        radProcessExit ();
+        radSystemExit (WVIEW_SYSTEM_ID);
+        exit (1);
+    }
+
+    if (htmlWork.httpPort > 0)
+    {
+        if (htmlserverInit (htmlWork.httpPort, htmlWork.imagePath) == ERROR)
+        {
+            // the files are still generated for another web server
+            radMsgLog (PRI_HIGH, "htmlserverInit failed - not serving on port %d",
+                       htmlWork.httpPort);
+            htmlWork.httpPort = 0;
+        }
+    }
+
     // wait a bit here before continuing
     radUtilsSleep (500);
 
@@ -821,6 +906,8 @@ int main (int argc, char *argv[])
         radMsgLog (PRI_HIGH, "radMsgRouterInit failed!");
         statusUpdateMessage("radMsgRouterInit failed");
         statusUpdate(STATUS_ERROR);
+        htmlserverExit ();
+        radTimerDelete (htmlWork.coalesceTimer);
         radTimerDelete (htmlWork.noaaTimer);
         radTimerDelete (htmlWork.rxTimer);
         radTimerDelete (htmlWork.timer);
@@ -837,6 +924,12 @@ int main (int argc, char *argv[])
     radMsgRouterMessageRegister (WVIEW_MSG_TYPE_LOOP_DATA);
     radMsgRouterMessageRegister (WVIEW_MSG_TYPE_ARCHIVE_NOTIFY);
 
+    // the event stream follows every LOOP packet wviewd broadcasts
+    if (htmlWork.httpPort > 0)
+    {
+        radMsgRouterMessageRegister (WVIEW_MSG_TYPE_LOOP_DATA_SVC);
+    }
+
     // enable message reception from the radlib router for POLL msgs
     radMsgRouterMessageRegister (WVIEW_MSG_TYPE_POLL);
 
@@ -867,6 +960,8 @@ int main (int argc, char *argv[])
     statusUpdate(STATUS_SHUTDOWN);
 
     radMsgRouterExit ();
+    htmlserverExit ();
+    radTimerDelete (htmlWork.coalesceTimer);
     radTimerDelete (htmlWork.noaaTimer);
     radTimerDelete (htmlWork.rxTimer);
     radTimerDelete (htmlWork.timer);
@@ -11,9 +11,19 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         08/27/03        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Coalesced archive generation
+        10/19/2026      M.S. Teel       2               Live data documents
+        10/19/2026      M.S. Teel       3               Embedded HTTP server
+        10/19/2026      M.S. Teel       4               Sun and moon table
+        10/19/2026      M.S. Teel       5               Keep the burst wait across
+                                                        a data request
  
   NOTES:
-        
+        Generation runs every generation interval (to pick up new LOOP data)
+        and HTML_COALESCE_DELAY after the last of a burst of archive records;
+        htmlmgrGenerate only rebuilds what the new data affects. A record
+        which arrives (or a burst which ends) while a generation waits for
+        its data restarts the burst wait once that generation is done.
  
   LICENSE:
         Copyright (c) 2004, Mark S. Teel (mark@teel.ws)
@@ -57,6 +67,9 @@
 #include <services.h>
 #include <status.h>
 #include <htmlMgr.h>
+#include <htmlData.h>
+#include <htmlServer.h>
+#include <htmlAstro.h>
 #include <noaaGenerate.h>
 #include <arcrecGenerate.h>
 
@@ -70,11 +83,14 @@
 */
 #define TIMER_GENERATE              1
 #define TIMER_RX_PACKETS            2
+#define TIMER_COALESCE              3
 
 #define HTML_NOAA_UPDATE_DELAY      30000           // 30 secs
 
 #define HTML_RX_PACKETS_TIMEOUT     60000           // 60 secs
 
+#define HTML_COALESCE_DELAY         5000            // 5 secs after the last record
+
 
 typedef enum
 {
@@ -84,6 +100,9 @@ typedef enum
     HTML_STATS_TEMPLATES_GENERATED
 } HTML_STATS;
 
+// status histogram upper bounds in ms, the last bin is everything slower:
+#define HTML_GENERATE_MS_LIMITS         {250, 500, 1000, 2000, 5000, 10000, 30000}
+
 
 typedef struct
 {
@@ -112,6 +131,7 @@ typedef struct
     TIMER_ID        timer;
     TIMER_ID        rxTimer;
     TIMER_ID        noaaTimer;
+    TIMER_ID        coalesceTimer;
     struct timeval  nextGenerationTime;
     int             timerInterval;
     int             startOffset;
@@ -121,9 +141,13 @@ typedef struct
     HTML_MGR_ID     mgrId;
     NOAA_ID         noaaId;
     int             numDataReceived;
+    int             isPeriodic;
+    int             isCoalescePending;
     int             exiting;
     char            dateFormat[WVIEW_STRING1_SIZE];
     int             isDualUnits;
+    int             dataFormats;
+    int             httpPort;                   // 0 if not serving
 } HTML_WORK;
 
 
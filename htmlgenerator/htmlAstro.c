@@ -0,0 +1,241 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        htmlAstro.c
+
+  PURPOSE:
+        Provide the wview html generator sun and moon table.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        See htmlAstro.h.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <config.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+
+/*  ... Local include files
+*/
+#include <htmlAstro.h>
+
+
+/*  ... global memory declarations
+*/
+
+/*  ... global memory referenced
+*/
+
+/*  ... static (local) memory declarations
+*/
+
+// days elapsed since 1/1/2000, as in sunTimes.c
+#define DAYS_THIS_MILLENIUM(y,m,d) \
+    (367L*(y)-((7*((y)+(((m)+9)/12)))/4)+((275*(m))/9)+(d)-730530L)
+
+typedef struct
+{
+    int             isValid;
+    int             latitude;
+    int             longitude;
+    long            gmtOffset;              // seconds east when built
+    long            firstDay;               // DAYS_THIS_MILLENIUM of days[0]
+    HTML_ASTRO_DAY  days[HTML_ASTRO_DAYS];
+} HTML_ASTRO;
+
+static HTML_ASTRO   astroWork;
+
+
+static long getGMTOffset (struct tm *locTime)
+{
+#ifdef HAVE_STRUCT_TM_TM_ZONE
+    return locTime->tm_gmtoff;
+#else
+    return -timezone;
+#endif
+}
+
+static void computeDay
+(
+    int             year,
+    int             month,
+    int             day,
+    float           latitude,
+    float           longitude,
+    float           gmtOffsetHours,
+    HTML_ASTRO_DAY  *entry
+)
+{
+    short           tempShort;
+    int             hour;
+
+    sunTimesGetSunRiseSet (year, month, day, latitude, longitude,
+                           RS_TYPE_SUN,
+                           &entry->sunrise, &entry->sunset);
+    sunTimesGetSunRiseSet (year, month, day, latitude, longitude,
+                           RS_TYPE_CIVIL,
+                           &entry->civilrise, &entry->civilset);
+    sunTimesGetSunRiseSet (year, month, day, latitude, longitude,
+                           RS_TYPE_ASTRO,
+                           &entry->astrorise, &entry->astroset);
+    sunTimesGetSunRiseSet (year, month, day, latitude, longitude,
+                           RS_TYPE_MIDDAY,
+                           &entry->midday, &tempShort);
+    entry->dayLength = sunTimesGetDayLength (year, month, day, latitude, longitude);
+
+    GetMoonRiseSetTimes (year, month, day,
+                         gmtOffsetHours,
+                         latitude,
+                         longitude,
+                         &entry->moonrise,
+                         NULL,
+                         &entry->moonset,
+                         NULL);
+
+    for (hour = 0; hour < 24; hour ++)
+    {
+        entry->phase[hour] = (float)lunarPhaseCompute (year, month, day, hour);
+    }
+
+    return;
+}
+
+static int buildTable (int latitude, int longitude, time_t when)
+{
+    time_t          timeNow;
+    struct tm       locTime, nowTime, dayTime;
+    float           gmtOffsetHours;
+    int             i;
+
+    timeNow = time (NULL);
+    localtime_r (&timeNow, &nowTime);
+    localtime_r (&when, &locTime);
+    astroWork.isValid   = FALSE;
+    astroWork.latitude  = latitude;
+    astroWork.longitude = longitude;
+    astroWork.gmtOffset = getGMTOffset (&nowTime);
+    astroWork.firstDay  = DAYS_THIS_MILLENIUM(locTime.tm_year + 1900,
+                                              locTime.tm_mon + 1,
+                                              locTime.tm_mday);
+    gmtOffsetHours      = astroWork.gmtOffset/(60.0*60.0);
+
+    for (i = 0; i < HTML_ASTRO_DAYS; i ++)
+    {
+        // let mktime roll the date over the month and year ends:
+        memset (&dayTime, 0, sizeof (dayTime));
+        dayTime.tm_mday  = locTime.tm_mday + i;
+        dayTime.tm_mon   = locTime.tm_mon;
+        dayTime.tm_year  = locTime.tm_year;
+        dayTime.tm_hour  = 12;
+        dayTime.tm_isdst = -1;
+        if (mktime (&dayTime) == (time_t)-1)
+        {
+            radMsgLog (PRI_HIGH, "htmlastro: mktime failed for day %d", i);
+            return ERROR;
+        }
+
+        computeDay (dayTime.tm_year + 1900, dayTime.tm_mon + 1, dayTime.tm_mday,
+                    (float)latitude/10, (float)longitude/10, gmtOffsetHours,
+                    &astroWork.days[i]);
+    }
+
+    astroWork.isValid = TRUE;
+    radMsgLog (PRI_STATUS, "htmlastro: computed %d days of sun and moon times "
+                           "from %4.4d%2.2d%2.2d",
+               HTML_ASTRO_DAYS,
+               locTime.tm_year + 1900, locTime.tm_mon + 1, locTime.tm_mday);
+    return OK;
+}
+
+
+//  ... API methods
+
+HTML_ASTRO_DAY *htmlastroGetDay (int latitude, int longitude, time_t when)
+{
+    time_t          timeNow = time (NULL);
+    struct tm       locTime, nowTime;
+    long            index;
+
+    // the packed times follow the UTC offset in effect now, not on 'when':
+    localtime_r (&timeNow, &nowTime);
+    localtime_r (&when, &locTime);
+    index = DAYS_THIS_MILLENIUM(locTime.tm_year + 1900,
+                                locTime.tm_mon + 1,
+                                locTime.tm_mday)
+            - astroWork.firstDay;
+
+    if (! astroWork.isValid ||
+        astroWork.latitude != latitude ||
+        astroWork.longitude != longitude ||
+        astroWork.gmtOffset != getGMTOffset (&nowTime) ||
+        index < 0 || index >= HTML_ASTRO_DAYS)
+    {
+        if (buildTable (latitude, longitude, when) == ERROR)
+        {
+            return NULL;
+        }
+        index = 0;
+    }
+
+    return &astroWork.days[index];
+}
+
+int htmlastroUpdate (HTML_MGR_ID id)
+{
+    HTML_ASTRO_DAY  *today;
+
+    today = htmlastroGetDay (id->stationLatitude, id->stationLongitude, time (NULL));
+    if (today == NULL)
+    {
+        return ERROR;
+    }
+
+    id->sunrise     = today->sunrise;
+    id->sunset      = today->sunset;
+    id->civilrise   = today->civilrise;
+    id->civilset    = today->civilset;
+    id->astrorise   = today->astrorise;
+    id->astroset    = today->astroset;
+    id->midday      = today->midday;
+    id->dayLength   = today->dayLength;
+    id->moonrise    = today->moonrise;
+    id->moonset     = today->moonset;
+
+    return OK;
+}
+
+char *htmlastroGetPhase (HTML_MGR_ID id)
+{
+    HTML_ASTRO_DAY  *today;
+    time_t          timeNow = time (NULL);
+    struct tm       locTime;
+
+    today = htmlastroGetDay (id->stationLatitude, id->stationLongitude, timeNow);
+    if (today == NULL)
+    {
+        return lunarPhaseGet (id->mphaseIncrease, id->mphaseDecrease, id->mphaseFull);
+    }
+
+    localtime_r (&timeNow, &locTime);
+    return lunarPhaseFormat (today->phase[locTime.tm_hour],
+                             id->mphaseIncrease,
+                             id->mphaseDecrease,
+                             id->mphaseFull);
+}
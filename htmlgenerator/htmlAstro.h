@@ -0,0 +1,82 @@
+#ifndef INC_htmlastroh
+#define INC_htmlastroh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        htmlAstro.h
+
+  PURPOSE:
+        Provide the wview html generator sun and moon table definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The sun and moon times only depend on the station location and the
+        local date, so htmlgend computes them once for HTML_ASTRO_DAYS days
+        starting today and looks them up by date after that. The table also
+        holds the moon phase for each local hour of each day.
+
+        The packed times are local times computed with the UTC offset in
+        effect when the table is built (as sunTimesGetSunRiseSet and
+        GetMoonRiseSetTimes do), so the table is rebuilt when the offset
+        changes (DST), when the station location changes or when the
+        requested day is outside it. A build takes a few milliseconds.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <time.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+
+/*  ... Local include files
+*/
+#include <htmlMgr.h>
+
+
+/*  ... API definitions
+*/
+#define HTML_ASTRO_DAYS             366
+
+typedef struct
+{
+    short           sunrise;
+    short           sunset;
+    short           civilrise;
+    short           civilset;
+    short           astrorise;
+    short           astroset;
+    short           midday;
+    short           dayLength;
+    short           moonrise;
+    short           moonset;
+    float           phase[24];              // lunarPhaseCompute by local hour
+} HTML_ASTRO_DAY;
+
+
+/* ... function prototypes
+*/
+
+//  ... return the table entry for the local day holding 'when' at 'latitude'
+//  ... and 'longitude' (tenths of a degree), building the table if needed;
+//  ... returns NULL on error
+extern HTML_ASTRO_DAY *htmlastroGetDay (int latitude, int longitude, time_t when);
+
+//  ... copy today's sun and moon times into id; returns OK or ERROR
+extern int htmlastroUpdate (HTML_MGR_ID id);
+
+//  ... return the lunarPhaseGet string for the current hour from the table
+extern char *htmlastroGetPhase (HTML_MGR_ID id);
+
+#endif
@@ -0,0 +1,745 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        htmlBuffer.c
+
+  PURPOSE:
+        Provide the wview html generator output buffer utilities.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Served file cache
+        10/19/2026      M.S. Teel       2               Pre-compressed siblings
+        10/19/2026      M.S. Teel       3               Unchanged check from the cache
+
+  NOTES:
+        See htmlBuffer.h.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radlist.h>
+
+/*  ... Local include files
+*/
+#include <htmlBuffer.h>
+
+
+/*  ... global memory declarations
+*/
+
+/*  ... global memory referenced
+*/
+
+/*  ... static (local) memory declarations
+*/
+static RADLIST      fileList;               // least recently used first
+static int          fileListIsInit;
+static int          fileCacheBytes;
+static int          fileCachingIsEnabled;
+static int          compressMinSize;        // 0 if no siblings are written
+static HTML_BUFFER  compressBuffer;         // the sibling being written
+static HTML_BUFFER  readBuffer;             // a file being committed
+
+//  ... These are the files worth a gzip sibling:
+static char         *compressExtensions[] =
+    {
+        "htm", "html", "xml", "txt", "json", "csv", "js", "css", "svg", NULL
+    };
+
+
+// make room for 'length' more bytes and the terminating NULL:
+static int growBuffer (HTML_BUFFER *buffer, int length)
+{
+    char            *newData;
+    int             newSize;
+
+    if (buffer->length + length + 1 > buffer->size)
+    {
+        newSize = (buffer->size > 0) ? buffer->size : HTML_BUFFER_INITIAL_SIZE;
+        while (buffer->length + length + 1 > newSize)
+        {
+            newSize *= 2;
+        }
+
+        newData = (char *)realloc (buffer->data, newSize);
+        if (newData == NULL)
+        {
+            radMsgLog (PRI_HIGH, "htmlbufferAppend: cannot allocate %d bytes",
+                       newSize);
+            return ERROR;
+        }
+        buffer->data = newData;
+        buffer->size = newSize;
+    }
+
+    return OK;
+}
+
+// FNV-1a:
+static ULONG hashData (const char *data, int length)
+{
+    ULONG           hash = 2166136261UL;
+    int             i;
+
+    for (i = 0; i < length; i ++)
+    {
+        hash ^= (UCHAR)data[i];
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+    }
+
+    return hash;
+}
+
+static int fileBytes (HTML_FILE *file)
+{
+    return file->contents.size + file->compressed.size;
+}
+
+static void setFileContents (HTML_FILE *file, struct stat *fileStatus, ULONG hash)
+{
+    file->mtime         = fileStatus->st_mtime;
+    file->size          = fileStatus->st_size;
+    file->inode         = fileStatus->st_ino;
+    file->hash          = hash;
+    file->isCompressed  = FALSE;
+    htmlbufferFree (&file->compressed);
+    return;
+}
+
+static int readData (char *filename, HTML_BUFFER *buffer)
+{
+    FILE            *in;
+    char            data[4096];
+    int             count;
+
+    htmlbufferReset (buffer);
+
+    in = fopen (filename, "r");
+    if (in == NULL)
+    {
+        return ERROR;
+    }
+
+    while ((count = fread (data, 1, sizeof(data), in)) > 0)
+    {
+        if (htmlbufferAppend (buffer, data, count) == ERROR)
+        {
+            fclose (in);
+            return ERROR;
+        }
+    }
+
+    fclose (in);
+    return OK;
+}
+
+static int readFile (HTML_FILE *file, struct stat *fileStatus)
+{
+    if (readData (file->filename, &file->contents) == ERROR)
+    {
+        return ERROR;
+    }
+
+    setFileContents (file, fileStatus,
+                     hashData (file->contents.data, file->contents.length));
+    return OK;
+}
+
+// write through a temporary file and rename:
+static int replaceFile (char *filename, const void *data, int length)
+{
+    FILE            *out;
+    char            temp[_MAX_PATH];
+    int             retVal = OK;
+
+    snprintf (temp, sizeof(temp), "%s%s", filename, HTML_BUFFER_TEMP_EXT);
+    out = fopen (temp, "wb");
+    if (out == NULL)
+    {
+        radMsgLog (PRI_MEDIUM, "htmlbufferWriteFile: cannot open %s for writing!",
+                   temp);
+        return ERROR;
+    }
+
+    if (fwrite (data, 1, length, out) != length)
+    {
+        retVal = ERROR;
+    }
+    if (fclose (out) != 0)
+    {
+        retVal = ERROR;
+    }
+
+    if (retVal == OK && rename (temp, filename) == -1)
+    {
+        retVal = ERROR;
+    }
+    if (retVal == ERROR)
+    {
+        radMsgLog (PRI_MEDIUM, "htmlbufferWriteFile: cannot write %s", filename);
+        unlink (temp);
+    }
+
+    return retVal;
+}
+
+static int isCompressible (char *filename)
+{
+    char            *extension = strrchr (filename, '.');
+    int             i;
+
+    if (compressMinSize == 0 || extension == NULL)
+    {
+        return FALSE;
+    }
+
+    for (i = 0; compressExtensions[i] != NULL; i ++)
+    {
+        if (!strcasecmp (extension + 1, compressExtensions[i]))
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+static void siblingName (char *filename, char *store, int size)
+{
+    snprintf (store, size, "%s%s", filename, HTML_BUFFER_GZIP_EXT);
+    return;
+}
+
+// bring the gzip sibling of 'filename' in line with 'data'; returns TRUE if
+// compressBuffer holds the new sibling
+static int writeSibling (char *filename, const char *data, int length)
+{
+    char            gzName[_MAX_PATH];
+
+    if (! isCompressible (filename))
+    {
+        return FALSE;
+    }
+
+    siblingName (filename, gzName, sizeof(gzName));
+    if (length < compressMinSize)
+    {
+        // not worth it, but never leave an old copy behind
+        unlink (gzName);
+        return FALSE;
+    }
+
+    if (htmlbufferCompress (data, length, &compressBuffer) == ERROR ||
+        replaceFile (gzName, compressBuffer.data, compressBuffer.length) == ERROR)
+    {
+        unlink (gzName);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static HTML_FILE *findFile (char *filename)
+{
+    HTML_FILE       *file;
+
+    if (! fileListIsInit)
+    {
+        radListReset (&fileList);
+        fileListIsInit = TRUE;
+    }
+
+    for (file = (HTML_FILE *)radListGetFirst (&fileList);
+         file != NULL;
+         file = (HTML_FILE *)radListGetNext (&fileList, (NODE_PTR)file))
+    {
+        if (!strcmp (file->filename, filename))
+        {
+            // most recently used goes last:
+            radListRemove (&fileList, (NODE_PTR)file);
+            radListAddToEnd (&fileList, (NODE_PTR)file);
+            return file;
+        }
+    }
+
+    return NULL;
+}
+
+// does 'filename' hold exactly 'length' bytes of 'data' (hashing to 'hash')?
+// The cache entry answers that while the file is as we last wrote or read
+// it; the file is only read back when it has no entry or was changed since
+static int isUnchanged (char *filename, const char *data, int length, ULONG hash)
+{
+    struct stat     fileStatus;
+    HTML_FILE       *cached;
+    FILE            *file;
+    char            buffer[4096];
+    int             offset = 0, count;
+
+    if (stat (filename, &fileStatus) == -1 || fileStatus.st_size != length)
+    {
+        return FALSE;
+    }
+
+    cached = findFile (filename);
+    if (cached != NULL &&
+        cached->mtime == fileStatus.st_mtime &&
+        cached->size == fileStatus.st_size &&
+        cached->inode == fileStatus.st_ino)
+    {
+        if (cached->hash != hash)
+        {
+            return FALSE;
+        }
+
+        // a held copy also rules out a hash collision:
+        if (length > 0 && cached->contents.length == length)
+        {
+            return (memcmp (cached->contents.data, data, length) == 0);
+        }
+        return TRUE;
+    }
+
+    file = fopen (filename, "rb");
+    if (file == NULL)
+    {
+        return FALSE;
+    }
+
+    while ((count = fread (buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        if (offset + count > length ||
+            memcmp (buffer, &data[offset], count) != 0)
+        {
+            fclose (file);
+            return FALSE;
+        }
+        offset += count;
+    }
+
+    fclose (file);
+    return (offset == length);
+}
+
+static HTML_FILE *newFile (char *filename)
+{
+    HTML_FILE       *file;
+
+    file = (HTML_FILE *)malloc (sizeof (*file));
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    memset (file, 0, sizeof (*file));
+    wvstrncpy (file->filename, filename, sizeof(file->filename));
+    htmlbufferInit (&file->contents);
+    htmlbufferInit (&file->compressed);
+    radListAddToEnd (&fileList, (NODE_PTR)file);
+    return file;
+}
+
+static void deleteFile (HTML_FILE *file)
+{
+    radListRemove (&fileList, (NODE_PTR)file);
+    htmlbufferFree (&file->contents);
+    htmlbufferFree (&file->compressed);
+    free (file);
+    return;
+}
+
+// recount the cache and drop the least recently used files (but never
+// 'keep', which the caller is about to use) until it fits again
+static void trimFiles (HTML_FILE *keep)
+{
+    HTML_FILE       *file, *next;
+
+    fileCacheBytes = 0;
+    for (file = (HTML_FILE *)radListGetFirst (&fileList);
+         file != NULL;
+         file = (HTML_FILE *)radListGetNext (&fileList, (NODE_PTR)file))
+    {
+        fileCacheBytes += fileBytes (file);
+    }
+
+    for (file = (HTML_FILE *)radListGetFirst (&fileList);
+         file != NULL && fileCacheBytes > HTML_FILE_CACHE_MAX;
+         file = next)
+    {
+        next = (HTML_FILE *)radListGetNext (&fileList, (NODE_PTR)file);
+        if (file != keep)
+        {
+            fileCacheBytes -= fileBytes (file);
+            deleteFile (file);
+        }
+    }
+
+    return;
+}
+
+// keep what htmlbufferWriteFile just wrote to 'filename' (and its gzip
+// copy if not NULL); without file caching only the hash is kept, for the
+// next isUnchanged
+static void storeFile
+(
+    char            *filename,
+    const char      *data,
+    int             length,
+    ULONG           hash,
+    HTML_BUFFER     *compressed
+)
+{
+    HTML_FILE       *file;
+    struct stat     fileStatus;
+
+    file = findFile (filename);
+    if (file == NULL)
+    {
+        file = newFile (filename);
+        if (file == NULL)
+        {
+            return;
+        }
+    }
+
+    if (stat (filename, &fileStatus) == -1)
+    {
+        deleteFile (file);
+        return;
+    }
+
+    if (fileCachingIsEnabled)
+    {
+        htmlbufferReset (&file->contents);
+        if (htmlbufferAppend (&file->contents, data, length) == ERROR)
+        {
+            deleteFile (file);
+            return;
+        }
+    }
+    else
+    {
+        htmlbufferFree (&file->contents);
+    }
+
+    setFileContents (file, &fileStatus, hash);
+    if (fileCachingIsEnabled && compressed != NULL &&
+        htmlbufferAppend (&file->compressed, compressed->data, compressed->length) == OK)
+    {
+        file->isCompressed = TRUE;
+    }
+
+    trimFiles (file);
+    return;
+}
+
+
+/*  ... API methods
+*/
+
+void htmlbufferInit (HTML_BUFFER *buffer)
+{
+    memset (buffer, 0, sizeof (*buffer));
+    return;
+}
+
+int htmlbufferAppend (HTML_BUFFER *buffer, const char *data, int length)
+{
+    if (growBuffer (buffer, length) == ERROR)
+    {
+        return ERROR;
+    }
+
+    memcpy (&buffer->data[buffer->length], data, length);
+    buffer->length += length;
+
+    // keep it a valid string:
+    buffer->data[buffer->length] = 0;
+    return OK;
+}
+
+int htmlbufferAppendString (HTML_BUFFER *buffer, const char *string)
+{
+    return htmlbufferAppend (buffer, string, strlen (string));
+}
+
+void htmlbufferReset (HTML_BUFFER *buffer)
+{
+    buffer->length = 0;
+    if (buffer->data != NULL)
+    {
+        buffer->data[0] = 0;
+    }
+    return;
+}
+
+void htmlbufferFree (HTML_BUFFER *buffer)
+{
+    if (buffer->data != NULL)
+    {
+        free (buffer->data);
+    }
+    htmlbufferInit (buffer);
+    return;
+}
+
+int htmlbufferWriteFile (char *filename, const void *data, int length)
+{
+    struct stat     fileStatus;
+    char            gzName[_MAX_PATH];
+    ULONG           hash = hashData ((const char *)data, length);
+    int             isCompressed;
+
+    if (isUnchanged (filename, (const char *)data, length, hash))
+    {
+        // so is the sibling, unless there should be one and is not yet:
+        siblingName (filename, gzName, sizeof(gzName));
+        if (isCompressible (filename) && length >= compressMinSize &&
+            stat (gzName, &fileStatus) == -1)
+        {
+            writeSibling (filename, (const char *)data, length);
+        }
+        return OK;
+    }
+
+    // the sibling goes first so it is never older than the file:
+    isCompressed = writeSibling (filename, (const char *)data, length);
+
+    if (replaceFile (filename, data, length) == ERROR)
+    {
+        if (isCompressed)
+        {
+            siblingName (filename, gzName, sizeof(gzName));
+            unlink (gzName);
+        }
+        return ERROR;
+    }
+
+    storeFile (filename, (const char *)data, length, hash,
+               (isCompressed ? &compressBuffer : NULL));
+    return OK;
+}
+
+int htmlbufferCommitFile (char *filename)
+{
+    char            temp[_MAX_PATH];
+    int             retVal;
+
+    snprintf (temp, sizeof(temp), "%s%s", filename, HTML_BUFFER_TEMP_EXT);
+    retVal = readData (temp, &readBuffer);
+    unlink (temp);
+    if (retVal == ERROR)
+    {
+        radMsgLog (PRI_MEDIUM, "htmlbufferCommitFile: cannot read %s", temp);
+        return ERROR;
+    }
+
+    return htmlbufferWriteFile (filename, readBuffer.data, readBuffer.length);
+}
+
+int htmlbufferCompressFile (char *filename)
+{
+    struct stat     fileStatus, gzStatus;
+    char            gzName[_MAX_PATH];
+
+    if (! isCompressible (filename))
+    {
+        return OK;
+    }
+
+    if (stat (filename, &fileStatus) == -1)
+    {
+        return ERROR;
+    }
+
+    siblingName (filename, gzName, sizeof(gzName));
+    if (fileStatus.st_size < compressMinSize)
+    {
+        unlink (gzName);
+        return OK;
+    }
+
+    // written after the last change (not just in the same second)?
+    if (stat (gzName, &gzStatus) == 0 && gzStatus.st_mtime > fileStatus.st_mtime)
+    {
+        return OK;
+    }
+
+    if (readData (filename, &readBuffer) == ERROR)
+    {
+        return ERROR;
+    }
+
+    return (writeSibling (filename, readBuffer.data, readBuffer.length) ? OK : ERROR);
+}
+
+void htmlbufferRemoveFile (char *filename)
+{
+    char            gzName[_MAX_PATH];
+
+    siblingName (filename, gzName, sizeof(gzName));
+    unlink (gzName);
+    unlink (filename);
+    return;
+}
+
+void htmlbufferSetCompression (int minSize)
+{
+    compressMinSize = (minSize > 0) ? minSize : 0;
+    return;
+}
+
+int htmlbufferCompress (const char *data, int length, HTML_BUFFER *out)
+{
+    z_stream        stream;
+    int             bound, retVal;
+
+    memset (&stream, 0, sizeof (stream));
+
+    // windowBits + 16 asks for a gzip header and trailer:
+    if (deflateInit2 (&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                      Z_DEFAULT_STRATEGY)
+        != Z_OK)
+    {
+        radMsgLog (PRI_MEDIUM, "htmlbufferCompress: deflateInit2 failed!");
+        return ERROR;
+    }
+
+    // make room for the worst case so deflate finishes in one call:
+    bound = deflateBound (&stream, length);
+    htmlbufferReset (out);
+    if (growBuffer (out, bound) == ERROR)
+    {
+        deflateEnd (&stream);
+        return ERROR;
+    }
+
+    stream.next_in      = (Bytef *)data;
+    stream.avail_in     = length;
+    stream.next_out     = (Bytef *)out->data;
+    stream.avail_out    = bound;
+
+    retVal = deflate (&stream, Z_FINISH);
+    deflateEnd (&stream);
+    if (retVal != Z_STREAM_END)
+    {
+        radMsgLog (PRI_MEDIUM, "htmlbufferCompress: deflate failed: %d", retVal);
+        htmlbufferReset (out);
+        return ERROR;
+    }
+
+    out->length = stream.total_out;
+    out->data[out->length] = 0;
+    return OK;
+}
+
+void htmlbufferSetFileCaching (int isEnabled)
+{
+    fileCachingIsEnabled = isEnabled;
+    return;
+}
+
+HTML_FILE *htmlbufferGetFile (char *filename)
+{
+    HTML_FILE       *file;
+    struct stat     fileStatus;
+
+    if (stat (filename, &fileStatus) == -1 || ! S_ISREG (fileStatus.st_mode))
+    {
+        return NULL;
+    }
+
+    file = findFile (filename);
+    if (file == NULL)
+    {
+        file = newFile (filename);
+        if (file == NULL)
+        {
+            return NULL;
+        }
+    }
+    else if (file->mtime == fileStatus.st_mtime &&
+             file->size == fileStatus.st_size &&
+             file->inode == fileStatus.st_ino &&
+             file->contents.length == file->size)
+    {
+        // cached copy is current (and held, not just its hash)
+        return file;
+    }
+
+    if (readFile (file, &fileStatus) == ERROR)
+    {
+        deleteFile (file);
+        return NULL;
+    }
+
+    trimFiles (file);
+    return file;
+}
+
+HTML_BUFFER *htmlbufferGetCompressed (HTML_FILE *file)
+{
+    if (! file->isCompressed)
+    {
+        if (htmlbufferCompress (file->contents.data,
+                                file->contents.length,
+                                &file->compressed)
+            == ERROR)
+        {
+            return NULL;
+        }
+        file->isCompressed = TRUE;
+        trimFiles (file);
+    }
+
+    return &file->compressed;
+}
+
+HTML_BUFFER *htmlbufferGetInclude (char *filename)
+{
+    HTML_FILE       *file = htmlbufferGetFile (filename);
+
+    return ((file != NULL) ? &file->contents : NULL);
+}
+
+void htmlbufferFlushFiles (void)
+{
+    HTML_FILE       *file;
+
+    htmlbufferFree (&compressBuffer);
+    htmlbufferFree (&readBuffer);
+
+    if (! fileListIsInit)
+    {
+        return;
+    }
+
+    for (file = (HTML_FILE *)radListGetFirst (&fileList);
+         file != NULL;
+         file = (HTML_FILE *)radListGetFirst (&fileList))
+    {
+        deleteFile (file);
+    }
+
+    fileCacheBytes = 0;
+    return;
+}
@@ -0,0 +1,155 @@
+#ifndef INC_htmlbufferh
+#define INC_htmlbufferh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        htmlBuffer.h
+
+  PURPOSE:
+        Provide the wview html generator output buffer definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Served file cache
+        10/19/2026      M.S. Teel       2               Pre-compressed siblings
+        10/19/2026      M.S. Teel       3               Unchanged check from the cache
+
+  NOTES:
+        Generated files (templates and images) are built in memory and
+        committed with htmlbufferWriteFile: the bytes go to a temporary file
+        which is then renamed over the target, so the web server (or an FTP
+        or rsync pass) never picks up a partially written file. If the target
+        already holds exactly those bytes nothing is written at all. That is
+        decided from the content hash kept in the file cache for every file
+        written (and the cached copy, when file caching is enabled); the
+        target is only read back when it has no cache entry or was changed
+        some other way since.
+
+        Once htmlbufferSetCompression is given a size, text files (.htm,
+        .xml, .txt, .json ...) of at least that size also get a gzip
+        compressed sibling, <file>.gz, for web servers which serve those
+        directly (nginx gzip_static, Apache MultiViews/mod_rewrite). The
+        sibling is compressed only when the file changes and is renamed in
+        just before the file; a file which shrinks below the size loses its
+        sibling. Files written some other way (the NOAA reports are written
+        to <file>.tmp and committed with htmlbufferCommitFile, the daily
+        archive reports are appended to in place) are brought in line with
+        htmlbufferCommitFile or htmlbufferCompressFile.
+
+        Template <!--include ...--> files and the files served by the
+        embedded HTTP server are kept in one cache by path and re-read only
+        when their modification time, size or inode change. Once file caching
+        is enabled htmlbufferWriteFile also stores what it writes, so the
+        latest generated files are served without reading them back. The
+        least recently used files are dropped when the cache grows past
+        HTML_FILE_CACHE_MAX bytes. The gzip copy of a cached file is built
+        the first time it is asked for after each change.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <sys/types.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radlist.h>
+
+
+/*  ... API definitions
+*/
+#define HTML_BUFFER_INITIAL_SIZE    (64 * 1024)
+#define HTML_BUFFER_TEMP_EXT        ".tmp"
+#define HTML_BUFFER_GZIP_EXT        ".gz"
+#define HTML_FILE_CACHE_MAX         (16 * 1024 * 1024)
+
+typedef struct
+{
+    char        *data;
+    int         length;
+    int         size;
+} HTML_BUFFER;
+
+typedef struct
+{
+    NODE            node;
+    char            filename[_MAX_PATH];
+    time_t          mtime;
+    off_t           size;
+    ino_t           inode;
+    ULONG           hash;                   // of the contents, for ETags
+                                            // and unchanged writes
+    HTML_BUFFER     contents;
+    HTML_BUFFER     compressed;             // gzip of contents once built
+    int             isCompressed;
+} HTML_FILE;
+
+
+/* ... function prototypes
+*/
+
+//  ... initialize an empty buffer (no allocation until the first append)
+extern void htmlbufferInit (HTML_BUFFER *buffer);
+
+//  ... append 'length' bytes of 'data', growing the buffer as needed;
+//  ... returns OK or ERROR
+extern int htmlbufferAppend (HTML_BUFFER *buffer, const char *data, int length);
+
+//  ... append a NULL-terminated string; returns OK or ERROR
+extern int htmlbufferAppendString (HTML_BUFFER *buffer, const char *string);
+
+//  ... empty the buffer but keep its memory for the next use
+extern void htmlbufferReset (HTML_BUFFER *buffer);
+
+//  ... release the buffer memory
+extern void htmlbufferFree (HTML_BUFFER *buffer);
+
+//  ... write 'length' bytes of 'data' to 'filename' through a temporary file
+//  ... and rename, unless 'filename' already holds them; returns OK or ERROR
+extern int htmlbufferWriteFile (char *filename, const void *data, int length);
+
+//  ... commit 'filename'HTML_BUFFER_TEMP_EXT, written by the caller, as
+//  ... 'filename' just like htmlbufferWriteFile; returns OK or ERROR
+extern int htmlbufferCommitFile (char *filename);
+
+//  ... refresh the gzip sibling of a file changed in place if it is older
+//  ... than the file; returns OK or ERROR
+extern int htmlbufferCompressFile (char *filename);
+
+//  ... delete 'filename' and its gzip sibling
+extern void htmlbufferRemoveFile (char *filename);
+
+//  ... write gzip siblings for text files of at least 'minSize' bytes
+//  ... (0 to stop writing them)
+extern void htmlbufferSetCompression (int minSize);
+
+//  ... gzip 'length' bytes of 'data' into 'out' (replacing its contents);
+//  ... returns OK or ERROR
+extern int htmlbufferCompress (const char *data, int length, HTML_BUFFER *out);
+
+//  ... enable or disable keeping the files written by htmlbufferWriteFile
+extern void htmlbufferSetFileCaching (int isEnabled);
+
+//  ... get the (cached) regular file 'filename';
+//  ... returns NULL if it cannot be read
+extern HTML_FILE *htmlbufferGetFile (char *filename);
+
+//  ... get the gzip copy of a cached file; returns NULL on error
+extern HTML_BUFFER *htmlbufferGetCompressed (HTML_FILE *file);
+
+//  ... get the (cached) contents of an include file;
+//  ... returns NULL if it cannot be read
+extern HTML_BUFFER *htmlbufferGetInclude (char *filename);
+
+//  ... release all cached files and work buffers
+extern void htmlbufferFlushFiles (void);
+
+#endif
@@ -0,0 +1,619 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        htmlData.c
+
+  PURPOSE:
+        Provide the wview html generator live data documents.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Loop object for the event stream
+
+  NOTES:
+        See htmlData.h.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdint.h>
+#include <arpa/inet.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+
+/*  ... Local include files
+*/
+#include <htmlData.h>
+#include <htmlBuffer.h>
+
+
+/*  ... global memory declarations
+*/
+
+/*  ... global memory referenced
+*/
+
+/*  ... static (local) memory declarations
+*/
+typedef enum
+{
+    DATA_FLOAT                  = 0,
+    DATA_USHORT,
+    DATA_UCHAR,
+    DATA_TIME
+} DATA_TYPES;
+
+//  ... This is the table of the LOOP_PKT fields in the documents:
+typedef struct
+{
+    char        *name;
+    int         offset;
+    DATA_TYPES  type;
+    int         decimalPlaces;
+} DATA_LOOP_ENTRY;
+
+#define LOOP_FIELD(f,t,d)       { #f, offsetof(LOOP_PKT, f), t, d }
+
+static DATA_LOOP_ENTRY dataLoopFields[] =
+    {
+        LOOP_FIELD(barometer,               DATA_FLOAT,     3),
+        LOOP_FIELD(stationPressure,         DATA_FLOAT,     3),
+        LOOP_FIELD(altimeter,               DATA_FLOAT,     3),
+        LOOP_FIELD(inTemp,                  DATA_FLOAT,     1),
+        LOOP_FIELD(outTemp,                 DATA_FLOAT,     1),
+        LOOP_FIELD(inHumidity,              DATA_USHORT,    0),
+        LOOP_FIELD(outHumidity,             DATA_USHORT,    0),
+        LOOP_FIELD(windSpeed,               DATA_USHORT,    0),
+        LOOP_FIELD(windDir,                 DATA_USHORT,    0),
+        LOOP_FIELD(windGust,                DATA_USHORT,    0),
+        LOOP_FIELD(windGustDir,             DATA_USHORT,    0),
+        LOOP_FIELD(rainRate,                DATA_FLOAT,     2),
+        LOOP_FIELD(radiation,               DATA_USHORT,    0),
+        LOOP_FIELD(UV,                      DATA_FLOAT,     1),
+        LOOP_FIELD(dewpoint,                DATA_FLOAT,     1),
+        LOOP_FIELD(windchill,               DATA_FLOAT,     1),
+        LOOP_FIELD(heatindex,               DATA_FLOAT,     1),
+        LOOP_FIELD(stormRain,               DATA_FLOAT,     2),
+        LOOP_FIELD(stormStart,              DATA_TIME,      0),
+        LOOP_FIELD(dayRain,                 DATA_FLOAT,     2),
+        LOOP_FIELD(monthRain,               DATA_FLOAT,     2),
+        LOOP_FIELD(yearRain,                DATA_FLOAT,     2),
+        LOOP_FIELD(dayET,                   DATA_FLOAT,     3),
+        LOOP_FIELD(monthET,                 DATA_FLOAT,     2),
+        LOOP_FIELD(yearET,                  DATA_FLOAT,     2),
+        LOOP_FIELD(twoMinuteAvgWindSpeed,   DATA_USHORT,    0),
+        LOOP_FIELD(twoMinuteAvgWindDir,     DATA_USHORT,    0),
+        LOOP_FIELD(tenMinuteAvgWindSpeed,   DATA_USHORT,    0),
+        LOOP_FIELD(tenMinuteAvgWindDir,     DATA_USHORT,    0),
+        LOOP_FIELD(tenMinuteWindGust,       DATA_USHORT,    0),
+        LOOP_FIELD(tenMinuteWindGustDir,    DATA_USHORT,    0),
+        LOOP_FIELD(rxCheckPercent,          DATA_USHORT,    0),
+        LOOP_FIELD(forecastIcon,            DATA_USHORT,    0),
+        LOOP_FIELD(forecastRule,            DATA_USHORT,    0),
+        LOOP_FIELD(extraTemp1,              DATA_FLOAT,     1),
+        LOOP_FIELD(extraTemp2,              DATA_FLOAT,     1),
+        LOOP_FIELD(extraTemp3,              DATA_FLOAT,     1),
+        LOOP_FIELD(soilTemp1,               DATA_FLOAT,     1),
+        LOOP_FIELD(soilTemp2,               DATA_FLOAT,     1),
+        LOOP_FIELD(soilTemp3,               DATA_FLOAT,     1),
+        LOOP_FIELD(soilTemp4,               DATA_FLOAT,     1),
+        LOOP_FIELD(leafTemp1,               DATA_FLOAT,     1),
+        LOOP_FIELD(leafTemp2,               DATA_FLOAT,     1),
+        LOOP_FIELD(extraHumid1,             DATA_UCHAR,     0),
+        LOOP_FIELD(extraHumid2,             DATA_UCHAR,     0),
+        LOOP_FIELD(soilMoist1,              DATA_UCHAR,     0),
+        LOOP_FIELD(soilMoist2,              DATA_UCHAR,     0),
+        LOOP_FIELD(leafWet1,                DATA_UCHAR,     0),
+        LOOP_FIELD(leafWet2,                DATA_UCHAR,     0)
+    };
+
+#define DATA_LOOP_ENTRIES       (sizeof(dataLoopFields)/sizeof(DATA_LOOP_ENTRY))
+
+//  ... This is the table of the HILOW sensors in the documents:
+typedef enum
+{
+    HILOW_RANGE                 = 0,                // low and high
+    HILOW_RANGE_DIR,                                // plus the direction at the high
+    HILOW_TOTAL                                     // cumulative
+} HILOW_KIND;
+
+typedef struct
+{
+    char            *name;
+    SENSOR_TYPES    sensor;
+    HILOW_KIND      kind;
+    int             decimalPlaces;
+} DATA_HILOW_ENTRY;
+
+static DATA_HILOW_ENTRY dataHilowSensors[] =
+    {
+        { "inTemp",         SENSOR_INTEMP,      HILOW_RANGE,        1 },
+        { "outTemp",        SENSOR_OUTTEMP,     HILOW_RANGE,        1 },
+        { "inHumidity",     SENSOR_INHUMID,     HILOW_RANGE,        0 },
+        { "outHumidity",    SENSOR_OUTHUMID,    HILOW_RANGE,        0 },
+        { "barometer",      SENSOR_BP,          HILOW_RANGE,        3 },
+        { "windSpeed",      SENSOR_WSPEED,      HILOW_RANGE,        0 },
+        { "windGust",       SENSOR_WGUST,       HILOW_RANGE_DIR,    0 },
+        { "dewpoint",       SENSOR_DEWPOINT,    HILOW_RANGE,        1 },
+        { "rain",           SENSOR_RAIN,        HILOW_TOTAL,        2 },
+        { "rainRate",       SENSOR_RAINRATE,    HILOW_RANGE,        2 },
+        { "windchill",      SENSOR_WCHILL,      HILOW_RANGE,        1 },
+        { "heatindex",      SENSOR_HINDEX,      HILOW_RANGE,        1 },
+        { "ET",             SENSOR_ET,          HILOW_TOTAL,        3 },
+        { "UV",             SENSOR_UV,          HILOW_RANGE,        1 },
+        { "radiation",      SENSOR_SOLRAD,      HILOW_RANGE,        0 }
+    };
+
+#define DATA_HILOW_ENTRIES      (sizeof(dataHilowSensors)/sizeof(DATA_HILOW_ENTRY))
+
+static char *dataTimeFrameNames[] = { "day", "month", "year" };
+#define DATA_TIMEFRAMES         (sizeof(dataTimeFrameNames)/sizeof(char *))
+
+//  ... This is the table of the archive fields whose day history is included:
+typedef struct
+{
+    char        *name;
+    int         field;                              // Data_Indices
+    int         decimalPlaces;
+} DATA_HISTORY_ENTRY;
+
+static DATA_HISTORY_ENTRY dataHistoryFields[] =
+    {
+        { "outTemp",        DATA_INDEX_outTemp,         1 },
+        { "outHumidity",    DATA_INDEX_outHumidity,     0 },
+        { "dewpoint",       DATA_INDEX_dewpoint,        1 },
+        { "barometer",      DATA_INDEX_barometer,       3 },
+        { "windSpeed",      DATA_INDEX_windSpeed,       0 },
+        { "windGust",       DATA_INDEX_windGust,        0 },
+        { "windDir",        DATA_INDEX_windDir,         0 },
+        { "rain",           DATA_INDEX_rain,            2 },
+        { "rainRate",       DATA_INDEX_rainRate,        2 },
+        { "radiation",      DATA_INDEX_radiation,       0 },    // extended
+        { "UV",             DATA_INDEX_UV,              1 }     // extended
+    };
+
+#define DATA_HISTORY_ENTRIES    (sizeof(dataHistoryFields)/sizeof(DATA_HISTORY_ENTRY))
+
+static HTML_BUFFER      dataBuffer;
+
+
+static float loopValue (LOOP_PKT *loop, DATA_LOOP_ENTRY *entry)
+{
+    char            *address = (char *)loop + entry->offset;
+
+    switch (entry->type)
+    {
+        case DATA_FLOAT:
+            return *(float *)address;
+        case DATA_USHORT:
+            return (float)(*(USHORT *)address);
+        case DATA_UCHAR:
+            return (float)(*(UCHAR *)address);
+        case DATA_TIME:
+            return (float)(*(time_t *)address);
+    }
+
+    return ARCHIVE_VALUE_NULL;
+}
+
+// the day values include the current archive interval:
+static void getSensor (HTML_MGR_ID id, SENSOR_TYPES type, int frame, WV_SENSOR *sensor)
+{
+    switch (frame)
+    {
+        case 0:
+            *sensor = id->hilowStore.sensor[STF_DAY][type];
+            sensorAddSample (sensor, &id->hilowStore.sensor[STF_INTERVAL][type]);
+            break;
+        case 1:
+            *sensor = id->hilowStore.sensor[STF_MONTH][type];
+            break;
+        default:
+            *sensor = id->hilowStore.sensor[STF_YEAR][type];
+            break;
+    }
+
+    return;
+}
+
+static void appendString (HTML_BUFFER *buffer, const char *string)
+{
+    char            temp[8];
+
+    htmlbufferAppend (buffer, "\"", 1);
+    for (; *string != 0; string ++)
+    {
+        if (*string == '"' || *string == '\\')
+        {
+            temp[0] = '\\';
+            temp[1] = *string;
+            htmlbufferAppend (buffer, temp, 2);
+        }
+        else if ((UCHAR)*string < 0x20)
+        {
+            sprintf (temp, "\\u%4.4x", (UCHAR)*string);
+            htmlbufferAppendString (buffer, temp);
+        }
+        else
+        {
+            htmlbufferAppend (buffer, string, 1);
+        }
+    }
+    htmlbufferAppend (buffer, "\"", 1);
+    return;
+}
+
+static void appendValue (HTML_BUFFER *buffer, float value, int decimalPlaces)
+{
+    char            temp[64];
+
+    if (value <= ARCHIVE_VALUE_NULL)
+    {
+        htmlbufferAppendString (buffer, "null");
+        return;
+    }
+
+    snprintf (temp, sizeof(temp), "%.*f", decimalPlaces, value);
+    htmlbufferAppendString (buffer, temp);
+    return;
+}
+
+static void appendTime (HTML_BUFFER *buffer, time_t value)
+{
+    char            temp[32];
+
+    if (value == (time_t)0)
+    {
+        htmlbufferAppendString (buffer, "null");
+        return;
+    }
+
+    snprintf (temp, sizeof(temp), "%lu", (ULONG)value);
+    htmlbufferAppendString (buffer, temp);
+    return;
+}
+
+static void appendPackedTime (HTML_BUFFER *buffer, short value)
+{
+    char            temp[16];
+
+    if (value < 0)
+    {
+        htmlbufferAppendString (buffer, "null");
+        return;
+    }
+
+    sprintf (temp, "\"%2.2d:%2.2d\"",
+             EXTRACT_PACKED_HOUR(value), EXTRACT_PACKED_MINUTE(value));
+    htmlbufferAppendString (buffer, temp);
+    return;
+}
+
+static int appendLoop (LOOP_PKT *loop, HTML_BUFFER *buffer)
+{
+    int             i;
+    float           value;
+
+    htmlbufferAppend (buffer, "{", 1);
+    for (i = 0; i < DATA_LOOP_ENTRIES; i ++)
+    {
+        if (i > 0)
+        {
+            htmlbufferAppend (buffer, ",", 1);
+        }
+        appendString (buffer, dataLoopFields[i].name);
+        htmlbufferAppend (buffer, ":", 1);
+
+        if (dataLoopFields[i].type == DATA_TIME)
+        {
+            appendTime (buffer,
+                        *(time_t *)((char *)loop + dataLoopFields[i].offset));
+        }
+        else
+        {
+            value = loopValue (loop, &dataLoopFields[i]);
+            appendValue (buffer, value, dataLoopFields[i].decimalPlaces);
+        }
+    }
+
+    // out of memory along the way?
+    return htmlbufferAppend (buffer, "}", 1);
+}
+
+static void appendHilow (HTML_MGR_ID id, HTML_BUFFER *buffer)
+{
+    DATA_HILOW_ENTRY    *entry;
+    WV_SENSOR           sensor;
+    int                 i, frame;
+
+    htmlbufferAppendString (buffer, "\"hilow\":{");
+    for (i = 0; i < DATA_HILOW_ENTRIES; i ++)
+    {
+        entry = &dataHilowSensors[i];
+        if (i > 0)
+        {
+            htmlbufferAppend (buffer, ",", 1);
+        }
+        appendString (buffer, entry->name);
+        htmlbufferAppend (buffer, ":{", 2);
+
+        for (frame = 0; frame < DATA_TIMEFRAMES; frame ++)
+        {
+            getSensor (id, entry->sensor, frame, &sensor);
+
+            if (frame > 0)
+            {
+                htmlbufferAppend (buffer, ",", 1);
+            }
+            appendString (buffer, dataTimeFrameNames[frame]);
+            htmlbufferAppend (buffer, ":{", 2);
+
+            if (entry->kind == HILOW_TOTAL)
+            {
+                htmlbufferAppendString (buffer, "\"total\":");
+                appendValue (buffer, sensorGetCumulative (&sensor), entry->decimalPlaces);
+            }
+            else if (sensorGetSamples (&sensor) == 0)
+            {
+                htmlbufferAppendString (buffer,
+                    "\"low\":null,\"lowTime\":null,\"high\":null,\"highTime\":null");
+                if (entry->kind == HILOW_RANGE_DIR)
+                {
+                    htmlbufferAppendString (buffer, ",\"highDir\":null");
+                }
+            }
+            else
+            {
+                htmlbufferAppendString (buffer, "\"low\":");
+                appendValue (buffer, sensorGetLow (&sensor), entry->decimalPlaces);
+                htmlbufferAppendString (buffer, ",\"lowTime\":");
+                appendTime (buffer, sensor.time_low);
+                htmlbufferAppendString (buffer, ",\"high\":");
+                appendValue (buffer, sensorGetHigh (&sensor), entry->decimalPlaces);
+                htmlbufferAppendString (buffer, ",\"highTime\":");
+                appendTime (buffer, sensor.time_high);
+                if (entry->kind == HILOW_RANGE_DIR)
+                {
+                    htmlbufferAppendString (buffer, ",\"highDir\":");
+                    appendValue (buffer, sensorGetWhenHigh (&sensor), 0);
+                }
+            }
+
+            htmlbufferAppend (buffer, "}", 1);
+        }
+
+        htmlbufferAppend (buffer, "}", 1);
+    }
+    htmlbufferAppend (buffer, "}", 1);
+    return;
+}
+
+static void appendAstro (HTML_MGR_ID id, HTML_BUFFER *buffer)
+{
+    htmlbufferAppendString (buffer, "\"astro\":{\"sunrise\":");
+    appendPackedTime (buffer, id->sunrise);
+    htmlbufferAppendString (buffer, ",\"sunset\":");
+    appendPackedTime (buffer, id->sunset);
+    htmlbufferAppendString (buffer, ",\"midday\":");
+    appendPackedTime (buffer, id->midday);
+    htmlbufferAppendString (buffer, ",\"dayLength\":");
+    appendPackedTime (buffer, id->dayLength);
+    htmlbufferAppendString (buffer, ",\"civilrise\":");
+    appendPackedTime (buffer, id->civilrise);
+    htmlbufferAppendString (buffer, ",\"civilset\":");
+    appendPackedTime (buffer, id->civilset);
+    htmlbufferAppendString (buffer, ",\"astrorise\":");
+    appendPackedTime (buffer, id->astrorise);
+    htmlbufferAppendString (buffer, ",\"astroset\":");
+    appendPackedTime (buffer, id->astroset);
+    htmlbufferAppendString (buffer, ",\"moonrise\":");
+    appendPackedTime (buffer, id->moonrise);
+    htmlbufferAppendString (buffer, ",\"moonset\":");
+    appendPackedTime (buffer, id->moonset);
+    htmlbufferAppendString (buffer, ",\"isDayTime\":");
+    htmlbufferAppendString (buffer,
+                            wvutilsIsDayTime (id->sunrise, id->sunset) ? "true" : "false");
+    htmlbufferAppend (buffer, "}", 1);
+    return;
+}
+
+static void appendHistory (HTML_MGR_ID id, HTML_BUFFER *buffer)
+{
+    float           *values;
+    int             i, j, count = 0;
+
+    htmlbufferAppendString (buffer, "\"history\":{");
+    for (i = 0; i < DATA_HISTORY_ENTRIES; i ++)
+    {
+        if (dataHistoryFields[i].field >= DATA_INDEX_BASIC_MAX && ! id->isExtendedData)
+        {
+            continue;
+        }
+
+        if (count ++ > 0)
+        {
+            htmlbufferAppend (buffer, ",", 1);
+        }
+        appendString (buffer, dataHistoryFields[i].name);
+        htmlbufferAppend (buffer, ":[", 2);
+
+        values = DAY_VALUES(id, dataHistoryFields[i].field);
+        for (j = 0; j < id->dayHistory.length; j ++)
+        {
+            if (j > 0)
+            {
+                htmlbufferAppend (buffer, ",", 1);
+            }
+            appendValue (buffer, values[j], dataHistoryFields[i].decimalPlaces);
+        }
+
+        htmlbufferAppend (buffer, "]", 1);
+    }
+    htmlbufferAppend (buffer, "}", 1);
+    return;
+}
+
+static int generateJSON (HTML_MGR_ID id)
+{
+    char            temp[_MAX_PATH];
+
+    htmlbufferReset (&dataBuffer);
+
+    htmlbufferAppendString (&dataBuffer, "{\"station\":");
+    appendString (&dataBuffer, id->stationName);
+    // the values are always US units, whatever the display units are:
+    snprintf (temp, sizeof(temp), ",\"interval\":%d,\"units\":\"US\",",
+              id->archiveInterval);
+    htmlbufferAppendString (&dataBuffer, temp);
+
+    htmlbufferAppendString (&dataBuffer, "\"loop\":");
+    appendLoop (&id->loopStore, &dataBuffer);
+    htmlbufferAppend (&dataBuffer, ",", 1);
+    appendHilow (id, &dataBuffer);
+    htmlbufferAppend (&dataBuffer, ",", 1);
+    appendAstro (id, &dataBuffer);
+    htmlbufferAppend (&dataBuffer, ",", 1);
+    appendHistory (id, &dataBuffer);
+    if (htmlbufferAppendString (&dataBuffer, "}\n") == ERROR)
+    {
+        // out of memory along the way
+        return ERROR;
+    }
+
+    snprintf (temp, sizeof(temp), "%s/%s", id->imagePath, HTML_DATA_JSON_FILE);
+    return htmlbufferWriteFile (temp, dataBuffer.data, dataBuffer.length);
+}
+
+static void appendBinaryValue (HTML_BUFFER *buffer, float value)
+{
+    union
+    {
+        float       value;
+        uint32_t    bits;
+    }               netValue;
+
+    netValue.value = value;
+    netValue.bits = htonl (netValue.bits);
+    htmlbufferAppend (buffer, (char *)&netValue.bits, sizeof(netValue.bits));
+    return;
+}
+
+static int generateBinary (HTML_MGR_ID id)
+{
+    WV_SENSOR       sensor;
+    uint32_t        count, netCount;
+    int             i, frame;
+    char            temp[_MAX_PATH];
+
+    htmlbufferReset (&dataBuffer);
+
+    // times do not fit a float:
+    for (i = 0, count = 0; i < DATA_LOOP_ENTRIES; i ++)
+    {
+        if (dataLoopFields[i].type != DATA_TIME)
+        {
+            count ++;
+        }
+    }
+    count += DATA_HILOW_ENTRIES * DATA_TIMEFRAMES * 2;
+
+    netCount = htonl (count);
+    htmlbufferAppend (&dataBuffer, HTML_DATA_BINARY_MAGIC, 4);
+    htmlbufferAppend (&dataBuffer, (char *)&netCount, sizeof(netCount));
+
+    for (i = 0; i < DATA_LOOP_ENTRIES; i ++)
+    {
+        if (dataLoopFields[i].type != DATA_TIME)
+        {
+            appendBinaryValue (&dataBuffer, loopValue (&id->loopStore, &dataLoopFields[i]));
+        }
+    }
+
+    for (i = 0; i < DATA_HILOW_ENTRIES; i ++)
+    {
+        for (frame = 0; frame < DATA_TIMEFRAMES; frame ++)
+        {
+            getSensor (id, dataHilowSensors[i].sensor, frame, &sensor);
+            if (dataHilowSensors[i].kind == HILOW_TOTAL)
+            {
+                appendBinaryValue (&dataBuffer, sensorGetCumulative (&sensor));
+                appendBinaryValue (&dataBuffer, sensorGetCumulative (&sensor));
+            }
+            else if (sensorGetSamples (&sensor) == 0)
+            {
+                appendBinaryValue (&dataBuffer, ARCHIVE_VALUE_NULL);
+                appendBinaryValue (&dataBuffer, ARCHIVE_VALUE_NULL);
+            }
+            else
+            {
+                appendBinaryValue (&dataBuffer, sensorGetLow (&sensor));
+                appendBinaryValue (&dataBuffer, sensorGetHigh (&sensor));
+            }
+        }
+    }
+
+    if (dataBuffer.length != 8 + (count * 4))
+    {
+        // out of memory along the way
+        return ERROR;
+    }
+
+    snprintf (temp, sizeof(temp), "%s/%s", id->imagePath, HTML_DATA_BINARY_FILE);
+    return htmlbufferWriteFile (temp, dataBuffer.data, dataBuffer.length);
+}
+
+
+/*  ... API methods
+*/
+
+int htmldataGenerate (HTML_MGR_ID id)
+{
+    int             count = 0;
+
+    if (id->dataFormats & HTML_DATA_JSON)
+    {
+        if (generateJSON (id) == ERROR)
+        {
+            radMsgLog (PRI_MEDIUM, "htmldataGenerate: %s failed!", HTML_DATA_JSON_FILE);
+            return ERROR;
+        }
+        count ++;
+    }
+
+    if (id->dataFormats & HTML_DATA_BINARY)
+    {
+        if (generateBinary (id) == ERROR)
+        {
+            radMsgLog (PRI_MEDIUM, "htmldataGenerate: %s failed!", HTML_DATA_BINARY_FILE);
+            return ERROR;
+        }
+        count ++;
+    }
+
+    return count;
+}
+
+int htmldataFormatLoop (LOOP_PKT *loop, HTML_BUFFER *buffer)
+{
+    return appendLoop (loop, buffer);
+}
+
+void htmldataExit (void)
+{
+    htmlbufferFree (&dataBuffer);
+    return;
+}
@@ -0,0 +1,97 @@
+#ifndef INC_htmldatah
+#define INC_htmldatah
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        htmlData.h
+
+  PURPOSE:
+        Provide the wview html generator live data document definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Loop object for the event stream
+
+  NOTES:
+        htmlgend writes the current conditions, the day/month/year highs and
+        lows, the sun and moon times and the last 24 hours of selected archive
+        fields to HTML_DATA_JSON_FILE in the image path each time one of its
+        inputs changes - AJAX pages can poll it instead of a data-only
+        template. The fields come from the tables in htmlData.c. All values
+        are in the wview native (US) units, as in the archive database, even
+        when the station displays metric units ("units" says so); a missing
+        value is null. The file is only rewritten when its contents change,
+        so its modification time is the time of the last change:
+
+        {
+          "station": "...", "interval": 5, "units": "US",
+          "loop": { "barometer": 29.921, "outTemp": 71.3, ... },
+          "hilow": {
+            "outTemp": { "day":   { "low": 60.1, "lowTime": 1792300000,
+                                    "high": 75.4, "highTime": 1792340000 },
+                         "month": { ... }, "year": { ... } },
+            "rain":    { "day": { "total": 0.12 }, ... },
+            ...
+          },
+          "astro": { "sunrise": "07:31", "sunset": "18:52", ... },
+          "history": { "outTemp": [ ... oldest first, one per interval ], ... }
+        }
+
+        If enabled, HTML_DATA_BINARY_FILE holds the same loop and hilow values
+        as IEEE 754 floats for clients that would rather not parse JSON: the
+        4 bytes "WVD1", a 32-bit value count, then the values - every loop
+        field but stormStart in table order followed by, for each hilow
+        sensor, the day, month and year low and high (or total and total for
+        the cumulative sensors). All 32-bit quantities are in network byte
+        order and missing values are ARCHIVE_VALUE_NULL.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+
+/*  ... Local include files
+*/
+#include <htmlMgr.h>
+#include <htmlBuffer.h>
+
+
+/*  ... API definitions
+*/
+#define HTML_DATA_JSON_FILE         "wview-data.json"
+#define HTML_DATA_BINARY_FILE       "wview-data.bin"
+#define HTML_DATA_BINARY_MAGIC      "WVD1"
+
+typedef enum
+{
+    HTML_DATA_JSON              = 0x1,
+    HTML_DATA_BINARY            = 0x2
+} HTML_DATA_FORMATS;
+
+
+/* ... function prototypes
+*/
+
+//  ... write the data documents enabled in id->dataFormats;
+//  ... returns the number of files written (unchanged ones included) or ERROR
+extern int htmldataGenerate (HTML_MGR_ID id);
+
+//  ... append the "loop" object of the JSON document for 'loop' to 'buffer';
+//  ... returns OK or ERROR
+extern int htmldataFormatLoop (LOOP_PKT *loop, HTML_BUFFER *buffer);
+
+//  ... release the document buffers
+extern void htmldataExit (void);
+
+#endif
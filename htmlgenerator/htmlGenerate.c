@@ -16,6 +16,15 @@
                                                         graphics.conf settings
         03/24/2008      W. Krenn        3               metric adaptations
         12/01/2009      M. Hornsby      4               Add Moon Rise and Set
+        10/19/2026      M.S. Teel       5               Encode PNGs via glpng with
+                                                        configurable compression
+        10/19/2026      M.S. Teel       6               Render templates in memory,
+                                                        cache include files
+        10/19/2026      M.S. Teel       7               Only regenerate templates
+                                                        with changed inputs
+        10/19/2026      M.S. Teel       8               Flush the served file cache
+        10/19/2026      M.S. Teel       9               Moon phase from the sun and
+                                                        moon table
  
   NOTES:
         This is by far the ugliest code in the wview source. Shortcuts are taken
@@ -51,6 +60,8 @@
 #include <glbucket.h>
 #include <glchart.h>
 #include <glmultichart.h>
+#include <glpng.h>
+#include <htmlBuffer.h>
 #include <htmlGenerate.h>
 
 
@@ -68,6 +79,8 @@ static TEXT_SEARCH_ID   tagSearchEngine;
 
 static PLOT_PREFS       plotPrefs;
 
+static HTML_BUFFER      outBuffer;                  // reused for each template
+
 enum ConfigIds
 {
     CFG_ID_BUCKET_TRANSPARENT               = 0,
@@ -83,6 +96,7 @@ enum ConfigIds
     CFG_ID_BUCKET_IMAGE_WIDTH ,
     CFG_ID_BUCKET_IMAGE_HEIGHT,
     CFG_ID_BUCKET_WIDTH,
+    CFG_ID_BUCKET_PNG_COMPRESSION,
 
     CFG_ID_CHART_TRANSPARENT,
     CFG_ID_CHART_IMAGE_BG_COLOR,
@@ -97,6 +111,7 @@ enum ConfigIds
     CFG_ID_CHART_TEXT_COLOR,
     CFG_ID_CHART_WIDTH,
     CFG_ID_CHART_HEIGHT,
+    CFG_ID_CHART_PNG_COMPRESSION,
 
     CFG_ID_BAR_IMAGE_BG_COLOR,
     CFG_ID_BAR_GRAPH_BG_COLOR ,
@@ -107,6 +122,7 @@ enum ConfigIds
     CFG_ID_BAR_TEXT_COLOR,
     CFG_ID_BAR_WIDTH,
     CFG_ID_BAR_HEIGHT,
+    CFG_ID_BAR_PNG_COMPRESSION,
 
     CFG_ID_DIAL_TRANSPARENT,
     CFG_ID_DIAL_BG_COLOR,
@@ -123,6 +139,7 @@ enum ConfigIds
     CFG_ID_DIAL_IMAGE_WIDTH,
     CFG_ID_DIAL_DIAMETER,
     CFG_ID_DIAL_CTR_DIAMETER,
+    CFG_ID_DIAL_PNG_COMPRESSION,
 
     CFG_ID_MULTICHART_FIRST_LINE_COLOR,
     CFG_ID_MULTICHART_SECOND_LINE_COLOR,
@@ -146,6 +163,7 @@ static char *configIDs[] =
         "BUCKET_IMAGE_WIDTH",                   // Width of entire image
         "BUCKET_IMAGE_HEIGHT",                  // Height of enitre image
         "BUCKET_WIDTH",                         // Width of bucket itself
+        "BUCKET_PNG_COMPRESSION",               // zlib level 0-9, -1 for default
 
         "CHART_TRANSPARENT",                    // Background transparent?
         "CHART_IMAGE_BG_COLOR",                 // Background color of image
@@ -160,6 +178,7 @@ static char *configIDs[] =
         "CHART_TEXT_COLOR",                     // Color of text labels
         "CHART_WIDTH",                          // Width of entire image
         "CHART_HEIGHT",                         // Height of entire image
+        "CHART_PNG_COMPRESSION",                // zlib level 0-9, -1 for default
 
         "BAR_IMAGE_BG_COLOR",                   // Background color of image
         "BAR_GRAPH_BG_COLOR",                   // Background color of plot
@@ -170,6 +189,7 @@ static char *configIDs[] =
         "BAR_TEXT_COLOR",                       // Color of text labels
         "BAR_WIDTH",                            // Width of entire image
         "BAR_HEIGHT",                           // Height of entire image
+        "BAR_PNG_COMPRESSION",                  // zlib level 0-9, -1 for default
 
         "DIAL_TRANSPARENT",                     // Background transparent?
         "DIAL_BG_COLOR",                        // Background color of dial
@@ -186,6 +206,7 @@ static char *configIDs[] =
         "DIAL_IMAGE_WIDTH",                     // Width of image
         "DIAL_DIAMETER",                        // Diameter of dial
         "DIAL_CTR_DIAMETER",                     // Diameter of center circle
+        "DIAL_PNG_COMPRESSION",                 // zlib level 0-9, -1 for default
 
         "MULTICHART_FIRST_LINE_COLOR",          // Color of first line
         "MULTICHART_SECOND_LINE_COLOR",         // Color of second line
@@ -2123,9 +2144,7 @@ static void computeTag (HTML_MGR_ID id, char *tag, int len, char *store)
         sprintf (store, "%.1f", sensorGetHigh(&sensors->sensor[STF_YEAR][SENSOR_UV]));
         break;
     case 189:
-        sprintf (store, "%s", lunarPhaseGet (id->mphaseIncrease,
-                                             id->mphaseDecrease,
-                                             id->mphaseFull));
+        sprintf (store, "%s", htmlastroGetPhase (id));
         break;
     case 190:
         sprintf (store, " kg/m^3");
@@ -3500,7 +3519,8 @@ static int replaceDataTags (HTML_MGR_ID id, char *oldline, char *newline)
 
 static int createOutFile (HTML_MGR_ID id, char *templatefile, ULONGLONG startTime)
 {
-    FILE        *infile, *outfile, *incfile;
+    FILE        *infile;
+    HTML_BUFFER *include;
     char        *ptr;
     char        oldfname[WVIEW_STRING2_SIZE];
     char        newfname[WVIEW_STRING2_SIZE];
@@ -3566,7 +3586,7 @@ static int createOutFile (HTML_MGR_ID id, char *templatefile, ULONGLONG startTim
                     oldfname, (ULONG)(radTimeGetMSSinceEpoch() - startTime));
 #endif
 
-    //  ... now open the files up
+    //  ... now open the template
     infile = fopen (oldfname, "r");
     if (infile == NULL)
     {
@@ -3575,20 +3595,6 @@ static int createOutFile (HTML_MGR_ID id, char *templatefile, ULONGLONG startTim
         return ERROR;
     }
 
-#if _DEBUG_GENERATION
-    wvutilsLogEvent(PRI_HIGH, "GENERATION: TEMPLATE: %s OPEN OUTFILE: %u", 
-                    oldfname, (ULONG)(radTimeGetMSSinceEpoch() - startTime));
-#endif
-
-    outfile = fopen (newfname, "w");
-    if (outfile == NULL)
-    {
-        radMsgLog (PRI_MEDIUM, "createOutFile: cannot open %s for writing!",
-                   newfname);
-        fclose (infile);
-        return ERROR;
-    }
-
 #if _DEBUG_GENERATION
     wvutilsLogEvent(PRI_HIGH, "GENERATION: TEMPLATE: %s START: %u", 
                     oldfname, (ULONG)(radTimeGetMSSinceEpoch() - startTime));
@@ -3596,7 +3602,8 @@ static int createOutFile (HTML_MGR_ID id, char *templatefile, ULONGLONG startTim
 
     //  ... now read each line of the template -
     //  ... replacing any data tags
-    //  ... then writing to the output file
+    //  ... then appending to the output buffer
+    htmlbufferReset (&outBuffer);
     while (fgets (line, HTML_MAX_LINE_LENGTH, infile) != NULL)
     {
         if (replaceDataTags (id, line, newline) == TRUE)
@@ -3604,47 +3611,48 @@ static int createOutFile (HTML_MGR_ID id, char *templatefile, ULONGLONG startTim
             // we must include an external file here, we expect to find it
             // in the output directory for images and expansions...
             sprintf (includefname, "%s/%s", id->imagePath, newline);
-            incfile = fopen (includefname, "r");
-            if (incfile == NULL)
+            include = htmlbufferGetInclude (includefname);
+            if (include == NULL)
             {
                 radMsgLog (PRI_MEDIUM, "createOutFile: cannot open %s for reading!",
                            includefname);
                 fclose (infile);
-                fclose (outfile);
                 return ERROR;
             }
-            while (fgets (line, HTML_MAX_LINE_LENGTH, incfile) != NULL)
+            if (htmlbufferAppend (&outBuffer, include->data, include->length) == ERROR)
             {
-                if (fputs (line, outfile) == EOF)
-                {
-                    fclose (incfile);
-                    fclose (infile);
-                    fclose (outfile);
-                    return ERROR;
-                }
+                fclose (infile);
+                return ERROR;
             }
-
-            // done
-            fclose (incfile);
         }
         else
         {
-            if (fputs (newline, outfile) == EOF)
+            if (htmlbufferAppendString (&outBuffer, newline) == ERROR)
             {
                 fclose (infile);
-                fclose (outfile);
                 return ERROR;
             }
         }
     }
 
+    fclose (infile);
+
+#if _DEBUG_GENERATION
+    wvutilsLogEvent(PRI_HIGH, "GENERATION: TEMPLATE: %s WRITE: %u", 
+                    oldfname, (ULONG)(radTimeGetMSSinceEpoch() - startTime));
+#endif
+
+    //  ... replace the output file in one go (if it changed)
+    if (htmlbufferWriteFile (newfname, outBuffer.data, outBuffer.length) == ERROR)
+    {
+        return ERROR;
+    }
+
 #if _DEBUG_GENERATION
 wvutilsLogEvent(PRI_HIGH, "GENERATION: TEMPLATE: %s FINISH: %u", 
                 oldfname, (ULONG)(radTimeGetMSSinceEpoch() - startTime));
 #endif
 
-    fclose (infile);
-    fclose (outfile);
     return OK;
 }
 
@@ -3751,6 +3759,11 @@ int htmlGenerateInit (void)
     plotPrefs.dialDiameter              = 156;
     plotPrefs.dialCtrDiameter           = 15;
 
+    plotPrefs.bucketPngCompression      = GLPNG_DEFAULT_COMPRESSION;
+    plotPrefs.chartPngCompression       = GLPNG_DEFAULT_COMPRESSION;
+    plotPrefs.barPngCompression         = GLPNG_DEFAULT_COMPRESSION;
+    plotPrefs.dialPngCompression        = GLPNG_DEFAULT_COMPRESSION;
+
     plotPrefs.multichartFirstLineColor       = 0xF4875300;
     plotPrefs.multichartSecondLineColor      = 0x40C62D00;
     plotPrefs.multichartThirdLineColor       = 0x0000FF00;
@@ -3847,6 +3860,12 @@ int htmlGenerateInit (void)
                 sscanf(value, "%d", &plotPrefs.bucketWidth);
             }
 
+            if (radCfGetFirstEntry (configFileId, configIDs[CFG_ID_BUCKET_PNG_COMPRESSION],
+                                    instance, value) != ERROR)
+            {
+                sscanf(value, "%d", &plotPrefs.bucketPngCompression);
+            }
+
 
             // Chart Plots
             if (radCfGetFirstEntry (configFileId, configIDs[CFG_ID_CHART_TRANSPARENT],
@@ -3929,6 +3948,12 @@ int htmlGenerateInit (void)
                 sscanf(value, "%d", &plotPrefs.chartHeight);
             }
 
+            if (radCfGetFirstEntry (configFileId, configIDs[CFG_ID_CHART_PNG_COMPRESSION],
+                                    instance, value) != ERROR)
+            {
+                sscanf(value, "%d", &plotPrefs.chartPngCompression);
+            }
+
 
 
             // Bar Charts
@@ -3988,6 +4013,12 @@ int htmlGenerateInit (void)
                 sscanf(value, "%d", &plotPrefs.barHeight);
             }
 
+            if (radCfGetFirstEntry (configFileId, configIDs[CFG_ID_BAR_PNG_COMPRESSION],
+                                    instance, value) != ERROR)
+            {
+                sscanf(value, "%d", &plotPrefs.barPngCompression);
+            }
+
 
             // Dial Charts
             if (radCfGetFirstEntry (configFileId, configIDs[CFG_ID_DIAL_TRANSPARENT],
@@ -4082,6 +4113,12 @@ int htmlGenerateInit (void)
                 sscanf(value, "%d", &plotPrefs.dialCtrDiameter);
             }
 
+            if (radCfGetFirstEntry (configFileId, configIDs[CFG_ID_DIAL_PNG_COMPRESSION],
+                                    instance, value) != ERROR)
+            {
+                sscanf(value, "%d", &plotPrefs.dialPngCompression);
+            }
+
             // MultiChart Line Color
             if (radCfGetFirstEntry (configFileId, configIDs[CFG_ID_MULTICHART_FIRST_LINE_COLOR],
                                     instance, value) != ERROR)
@@ -4114,6 +4151,13 @@ int htmlGenerateInit (void)
     return OK;
 }
 
+void htmlGenerateExit (void)
+{
+    htmlbufferFree (&outBuffer);
+    htmlbufferFlushFiles ();
+    return;
+}
+
 int htmlgenGetChartDefaultLine (void)
 {
     return plotPrefs.chartFirstLineColor;
@@ -4152,7 +4196,7 @@ int htmlgenGetMultiChartDefaultFourthLine (void)
     return plotPrefs.multichartFourthLineColor;
 }
 
-int htmlgenOutputFiles (HTML_MGR_ID id, ULONGLONG startTime)
+int htmlgenOutputFiles (HTML_MGR_ID id, ULONGLONG startTime, int changedInputs)
 {
     register HTML_TMPL  *tmpl;
     int                 count = 0;
@@ -4161,6 +4205,12 @@ int htmlgenOutputFiles (HTML_MGR_ID id, ULONGLONG startTime)
             tmpl != NULL;
             tmpl = (HTML_TMPL *)radListGetNext (&id->templateList, (NODE_PTR)tmpl))
     {
+        if (!(tmpl->inputs & changedInputs))
+        {
+            // nothing it depends on has changed
+            continue;
+        }
+
 #if _DEBUG_GENERATION
         wvutilsLogEvent(PRI_HIGH, "GENERATION: TEMPLATE: %s: %u ms",
                         tmpl->fname, (ULONG)(radTimeGetMSSinceEpoch() - startTime));
@@ -4281,6 +4331,7 @@ int htmlGenPngBucket
     bucketSetTitleColors (id, plotPrefs.bucketTitleFgColor, plotPrefs.bucketTitleBgColor);
     bucketSetTextColor (id, plotPrefs.bucketTextColor);
     bucketSetTransparency (id, plotPrefs.bucketTransparent);
+    bucketSetPngCompression (id, plotPrefs.bucketPngCompression);
     bucketSetDualUnits (id, isDualUnits);
     id->isMetric = isMetric;
 
@@ -4342,6 +4393,7 @@ int htmlGenPngRainBucket
     bucketSetTitleColors (id, plotPrefs.bucketTitleFgColor, plotPrefs.bucketTitleBgColor);
     bucketSetTextColor (id, plotPrefs.bucketTextColor);
     bucketSetTransparency (id, plotPrefs.bucketTransparent);
+    bucketSetPngCompression (id, plotPrefs.bucketPngCompression);
     bucketSetDualUnits (id, isDualUnits);
     // id->isMetric = 0;
 
@@ -4397,6 +4449,7 @@ int htmlGenPngBaromBucket
     bucketSetTitleColors (id, plotPrefs.bucketTitleFgColor, plotPrefs.bucketTitleBgColor);
     bucketSetTextColor (id, plotPrefs.bucketTextColor);
     bucketSetTransparency (id, plotPrefs.bucketTransparent);
+    bucketSetPngCompression (id, plotPrefs.bucketPngCompression);
     bucketSetDualUnits (id, isDualUnits);
 
     bucketRender (id);
@@ -4451,6 +4504,7 @@ int htmlGenMetricPngBaromBucket
     bucketSetTitleColors (id, plotPrefs.bucketTitleFgColor, plotPrefs.bucketTitleBgColor);
     bucketSetTextColor (id, plotPrefs.bucketTextColor);
     bucketSetTransparency (id, plotPrefs.bucketTransparent);
+    bucketSetPngCompression (id, plotPrefs.bucketPngCompression);
     bucketSetDualUnits (id, isDualUnits);
 
     bucketRender (id);
@@ -4506,6 +4560,7 @@ int htmlGenPngPercentBucket
     bucketSetTitleColors (id, plotPrefs.bucketTitleFgColor, plotPrefs.bucketTitleBgColor);
     bucketSetTextColor (id, plotPrefs.bucketTextColor);
     bucketSetTransparency (id, plotPrefs.bucketTransparent);
+    bucketSetPngCompression (id, plotPrefs.bucketPngCompression);
 
 
     bucketRender (id);
@@ -4555,6 +4610,7 @@ int htmlGenPngChart
     chartSetTitleColors (id, plotPrefs.chartTitleFgColor, plotPrefs.chartTitleBgColor);
     chartSetTextColor (id, plotPrefs.chartTextColor);
     chartSetTransparency (id, plotPrefs.chartTransparent);
+    chartSetPngCompression (id, plotPrefs.chartPngCompression);
 
     chartSetXScale (id, 0);
     chartSetXHashes (id, xHashes);
@@ -4628,6 +4684,7 @@ int htmlGenPngBarChart
     chartSetTitleColors (id, plotPrefs.barTitleFgColor, plotPrefs.barTitleBgColor);
     chartSetTextColor (id, plotPrefs.barTextColor);
     chartSetTransparency (id, plotPrefs.chartTransparent);
+    chartSetPngCompression (id, plotPrefs.barPngCompression);
 
     chartSetXScale (id, 0);
     chartSetXHashes (id, xHashes);
@@ -4725,6 +4782,7 @@ int htmlGenPngPercentChart
     chartSetTitleColors (id, plotPrefs.chartTitleFgColor, plotPrefs.chartTitleBgColor);
     chartSetTextColor (id, plotPrefs.chartTextColor);
     chartSetTransparency (id, plotPrefs.chartTransparent);
+    chartSetPngCompression (id, plotPrefs.chartPngCompression);
 
     chartSetXScale (id, 0);
     chartSetXHashes (id, xHashes);
@@ -4784,6 +4842,7 @@ int htmlGenPngWDIRChart
     chartSetTitleColors (id, plotPrefs.chartTitleFgColor, plotPrefs.chartTitleBgColor);
     chartSetTextColor (id, plotPrefs.chartTextColor);
     chartSetTransparency (id, plotPrefs.chartTransparent);
+    chartSetPngCompression (id, plotPrefs.chartPngCompression);
 
     chartSetXScale (id, 0);
     chartSetXHashes (id, xHashes);
@@ -4859,6 +4918,7 @@ int htmlGenPngMultiChart
     multiChartSetTitleColors (id, plotPrefs.chartTitleFgColor, plotPrefs.chartTitleBgColor);
     multiChartSetTextColor (id, plotPrefs.chartTextColor);
     multiChartSetTransparency (id, plotPrefs.chartTransparent);
+    multiChartSetPngCompression (id, plotPrefs.chartPngCompression);
 
     multiChartSetXScale (id, 0);
     multiChartSetXHashes (id, xHashes);
@@ -5084,7 +5144,8 @@ int htmlGenPngDialWind
     float               x, y;
     register double     angle, perpangle, cosine, sine;
     char                text[64];
-    register FILE       *pngFile, *inFile;
+    register FILE       *inFile;
+    int                 retVal;
 
     // suck in the dial palette
     inFile = fopen (dialPaletteFile, "rb");
@@ -5100,13 +5161,6 @@ int htmlGenPngDialWind
         return ERROR;
     }
 
-    pngFile = fopen (fname, "wb");
-    if (pngFile == NULL)
-    {
-        gdImageDestroy (im);
-        return ERROR;
-    }
-
 
     direction       = direction + 270;
     highDirection   = highDirection + 270;
@@ -5203,11 +5257,10 @@ int htmlGenPngDialWind
                    (UCHAR *)text,
                    tickcolor);
 
-    gdImagePng (im, pngFile);
-    fclose (pngFile);
+    retVal = glpngSave (im, fname, plotPrefs.dialPngCompression);
     gdImageDestroy (im);
 
-    return OK;
+    return ((retVal == 0) ? OK : ERROR);
 }
 
 
@@ -5289,7 +5342,8 @@ int htmlGenPngDialTemperature
     float               degAngle, angle, perpangle, cosine, sine;
     char                text[64];
     float               baseTemp, mult;
-    register FILE       *pngFile, *inFile;
+    register FILE       *inFile;
+    int                 retVal;
 
     // suck in the dial palette
     inFile = fopen (dialPaletteFile, "rb");
@@ -5305,12 +5359,6 @@ int htmlGenPngDialTemperature
         return ERROR;
     }
 
-    pngFile = fopen (fname, "wb");
-    if (pngFile == NULL)
-    {
-        return ERROR;
-    }
-
     // prepare to plot in metric or English
     if (isMetricUnits)
     {
@@ -5495,11 +5543,10 @@ int htmlGenPngDialTemperature
                    (UCHAR *)text,
                    tickcolor);
 
-    gdImagePng (im, pngFile);
-    fclose (pngFile);
+    retVal = glpngSave (im, fname, plotPrefs.dialPngCompression);
     gdImageDestroy (im);
 
-    return OK;
+    return ((retVal == 0) ? OK : ERROR);
 }
 
 //////////////////////////////
@@ -5560,7 +5607,8 @@ int htmlGenPngDialHumidity
     float               x, y;
     float               degAngle, angle, perpangle, cosine, sine;
     char                text[64];
-    register FILE       *pngFile, *inFile;
+    register FILE       *inFile;
+    int                 retVal;
 
     // suck in the dial palette
     inFile = fopen (dialPaletteFile, "rb");
@@ -5576,12 +5624,6 @@ int htmlGenPngDialHumidity
         return ERROR;
     }
 
-    pngFile = fopen (fname, "wb");
-    if (pngFile == NULL)
-    {
-        return ERROR;
-    }
-
     // normalize the values given
     humidity    += 10;
     low         += 10;
@@ -5692,11 +5734,10 @@ int htmlGenPngDialHumidity
                    (UCHAR *)text,
                    tickcolor);
 
-    gdImagePng (im, pngFile);
-    fclose (pngFile);
+    retVal = glpngSave (im, fname, plotPrefs.dialPngCompression);
     gdImageDestroy (im);
 
-    return OK;
+    return ((retVal == 0) ? OK : ERROR);
 }
 //////////////////////////////
 /// Day Net Rain Dial ////////
@@ -5834,7 +5875,8 @@ int htmlGenPngDialNetRain
     char                text[64];
     float               baserain, mult, precip, minval, maxval;
     char                *labels[12];
-    register FILE       *pngFile, *inFile;
+    register FILE       *inFile;
+    int                 retVal;
     int                 IsET = (((isExtendedData) && (et > 0)) ? 1 : 0);
 
     // suck in the dial palette
@@ -5863,12 +5905,6 @@ int htmlGenPngDialNetRain
         minval = 0;
     }
 
-    pngFile = fopen (fname, "wb");
-    if (pngFile == NULL)
-    {
-        return ERROR;
-    }
-
     // prepare to plot in metric or English
     if (isMetricUnits)
     {
@@ -6148,11 +6184,10 @@ int htmlGenPngDialNetRain
                    (UCHAR *)text,
                    tickcolor);
 
-    gdImagePng (im, pngFile);
-    fclose (pngFile);
+    retVal = glpngSave (im, fname, plotPrefs.dialPngCompression);
     gdImageDestroy (im);
 
-    return OK;
+    return ((retVal == 0) ? OK : ERROR);
 }
 
 int htmlGenPngDialWindRose
@@ -6167,7 +6202,8 @@ int htmlGenPngDialWindRose
     register int        i, bucket;
     register gdImagePtr im;
     char                text[64];
-    register FILE       *pngFile, *inFile;
+    register FILE       *inFile;
+    int                 retVal;
     int                 counters[WR_MAX_COUNTERS];
     int                 numCounters = 360/sampleWidth;
     int                 maxCount, numSamples;
@@ -6188,13 +6224,6 @@ int htmlGenPngDialWindRose
         return ERROR;
     }
 
-    pngFile = fopen (fname, "wb");
-    if (pngFile == NULL)
-    {
-        gdImageDestroy (im);
-        return ERROR;
-    }
-
     // populate the counts in each direction
     memset((void *) counters, 0, sizeof counters);
     numSamples = 0;
@@ -6304,10 +6333,9 @@ int htmlGenPngDialWindRose
     // draw it
     gdImageString (im, gdFontGiant, i, (plotPrefs.dialImageWidth/2)-52, (UCHAR *)text, tickcolor);
 
-    gdImagePng (im, pngFile);
-    fclose (pngFile);
+    retVal = glpngSave (im, fname, plotPrefs.dialPngCompression);
     gdImageDestroy (im);
 
-    return OK;
+    return ((retVal == 0) ? OK : ERROR);
 }
 
@@ -14,6 +14,10 @@
         02/16/2008      M.B. Clark      1               Added ability to customize color/size
                                                           of plots using graphics.conf
 	05/16/2008       W. Krenn        2               isDualUnits for Chart	   
+        10/19/2026      M.S. Teel       3               PNG compression levels
+        10/19/2026      M.S. Teel       4               htmlGenerateExit
+        10/19/2026      M.S. Teel       5               Only regenerate templates
+                                                          with changed inputs
  
   NOTES:
         
@@ -73,6 +77,7 @@ typedef struct
     int bucketImageWidth;
     int bucketImageHeight;
     int bucketWidth;
+    int bucketPngCompression;
 
     int chartTransparent;
     int chartImageBgColor;
@@ -87,6 +92,7 @@ typedef struct
     int chartTextColor;
     int chartWidth;
     int chartHeight;
+    int chartPngCompression;
 
     int barImageBgColor;
     int barGraphBgColor;
@@ -97,6 +103,7 @@ typedef struct
     int barTextColor;
     int barWidth;
     int barHeight;
+    int barPngCompression;
 
     int dialTransparent;
     int dialBgColor;
@@ -115,6 +122,7 @@ typedef struct
     int dialImageWidth;
     int dialDiameter;
     int dialCtrDiameter;
+    int dialPngCompression;
     
     int multichartFirstLineColor;
     int multichartSecondLineColor;
@@ -147,6 +155,7 @@ struct xyCoords
 /* ... API function prototypes
 */
 int htmlGenerateInit (void);
+void htmlGenerateExit (void);
 int htmlgenGetChartDefaultLine (void);
 int htmlgenGetChartDefaultSecondLine (void);
 int htmlgenGetChartDefaultThirdLine (void);
@@ -156,7 +165,9 @@ int htmlgenGetMultiChartDefaultSecondLine (void);
 int htmlgenGetMultiChartDefaultThirdLine (void);
 int htmlgenGetMultiChartDefaultFourthLine (void);
 
-extern int htmlgenOutputFiles (HTML_MGR_ID id, ULONGLONG startTime);
+//  ... generate the templates depending on any of the 'changedInputs'
+//  ... (HTML_INPUT_BITS); returns the number generated or ERROR
+extern int htmlgenOutputFiles (HTML_MGR_ID id, ULONGLONG startTime, int changedInputs);
 
 extern int htmlgenMesonetFile (HTML_MGR_ID id, WVIEW_MSG_ARCHIVE_NOTIFY *armsg);
 
@@ -0,0 +1,69 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        htmlHistory.c
+
+  PURPOSE:
+        Provide the wview html generator chart history ring.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        See htmlHistory.h.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+
+/*  ... Library include files
+*/
+
+/*  ... Local include files
+*/
+#include <htmlHistory.h>
+
+
+/*  ... global memory declarations
+*/
+
+/*  ... global memory referenced
+*/
+
+/*  ... static (local) memory declarations
+*/
+
+
+//  ... API methods
+
+void htmlhistoryInit (HTML_HISTORY *hist, float *store, int capacity, int length)
+{
+    hist->store     = store;
+    hist->capacity  = capacity;
+    hist->length    = length;
+    hist->head      = 0;
+}
+
+void htmlhistorySet (HTML_HISTORY *hist, int field, int index, float value)
+{
+    float           *values = hist->store + (field * 2 * hist->capacity);
+    int             slot = (hist->head + index) % hist->length;
+
+    values[slot] = value;
+    values[slot + hist->length] = value;
+}
+
+void htmlhistoryAdvance (HTML_HISTORY *hist)
+{
+    hist->head ++;
+    if (hist->head >= hist->length)
+        hist->head = 0;
+}
@@ -0,0 +1,70 @@
+#ifndef INC_htmlhistoryh
+#define INC_htmlhistoryh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        htmlHistory.h
+
+  PURPOSE:
+        Provide the wview html generator chart history ring definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The history values of each field are stored twice, at slot n and
+        slot n + length, so that the 'length' most recent values are always
+        contiguous (oldest first) from slot 'head' and the chart code can
+        take them as a plain array. Appending a value is O(1) instead of a
+        shift of the whole period.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+
+/*  ... Library include files
+*/
+
+/*  ... Local include files
+*/
+
+
+/*  ... API definitions
+*/
+
+typedef struct
+{
+    float               *store;             // [fields][2 * capacity]
+    int                 capacity;
+    int                 length;
+    int                 head;
+} HTML_HISTORY;
+
+// Pointer to the 'length' values of 'field', valid until the next append:
+#define HTML_HISTORY_VALUES(hist,field)                                 \
+    ((hist)->store + ((field) * 2 * (hist)->capacity) + (hist)->head)
+
+
+/* ... function prototypes
+*/
+
+//  ... use 'store' (2 * capacity floats per field) for a ring of 'length'
+//  ... values per field, length <= capacity
+extern void htmlhistoryInit (HTML_HISTORY *hist, float *store, int capacity, int length);
+
+//  ... set the value at 'index' (0 is the oldest) and its mirror
+extern void htmlhistorySet (HTML_HISTORY *hist, int field, int index, float value);
+
+//  ... drop the oldest value of all fields; the newest (index length-1)
+//  ... must be set for each field after this
+extern void htmlhistoryAdvance (HTML_HISTORY *hist);
+
+#endif
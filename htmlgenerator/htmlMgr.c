@@ -9,6 +9,14 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         08/30/03        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Ring buffer history
+        10/19/2026      M.S. Teel       2               Flush the chart cache on exit
+        10/19/2026      M.S. Teel       3               Table-driven charts
+        10/19/2026      M.S. Teel       4               Release the template buffers on exit
+        10/19/2026      M.S. Teel       5               Only regenerate images and templates
+                                                        with changed inputs
+        10/19/2026      M.S. Teel       6               Live data documents
+        10/19/2026      M.S. Teel       7               History ring in htmlHistory.c
  
   NOTES:
         
@@ -35,8 +43,11 @@
 #include <dbsqlite.h>
 #include <html.h>
 #include <htmlMgr.h>
+#include <htmlGenerate.h>
+#include <htmlData.h>
 #include <glbucket.h>
 #include <glchart.h>
+#include <glcache.h>
 #include <images.h>
 #include <images-user.h>
 
@@ -60,6 +71,17 @@ static ULONGLONG    GenerateTime;
 
 //  ... local utilities
 
+static float historyValue (HISTORY_DATA *data, int field)
+{
+    if (data->values[field] > ARCHIVE_VALUE_NULL && data->samples[field] != 0 &&
+        field != DATA_INDEX_rain && field != DATA_INDEX_windDir && field != DATA_INDEX_ET)
+    {
+        return (data->values[field] / data->samples[field]);
+    }
+
+    return data->values[field];
+}
+
 static int readImageConfFile (HTML_MGR *mgr, char *filename, int isUser)
 {
     HTML_IMG        *img;
@@ -185,16 +207,37 @@ static int readImageConfFile (HTML_MGR *mgr, char *filename, int isUser)
             free (img);
             goto line_loop_end;
         }
-        i = atoi (token);
-        if (isUser)
+        if (!strncmp (token, IMAGES_CHART_PREFIX, strlen(IMAGES_CHART_PREFIX)))
         {
-            img->generator = user_generators[i];
+            // generic chart of any archive field:
+            if (imagesParseChart (token, &img->chart) == ERROR)
+            {
+                radMsgLog (PRI_HIGH, "%s: %s: bad chart spec %s",
+                           filename, img->fname, token);
+                free (img);
+                goto line_loop_end;
+            }
+            img->generator = imagesGenerateChart;
         }
         else
         {
-            img->generator = images_generators[i];
+            i = atoi (token);
+            if (isUser)
+            {
+                img->generator = user_generators[i];
+            }
+            else
+            {
+                img->generator = images_generators[i];
+                if (img->generator == imagesGenerateChart)
+                {
+                    imagesGetBuiltinChart (i, &img->chart);
+                }
+            }
         }
 
+        img->inputs = imagesGetInputs (img);
+
         radListAddToEnd (&mgr->imgList, (NODE_PTR)img);
 
 // Loop end label:
@@ -206,6 +249,41 @@ line_loop_end:
     return OK;
 }
 
+// parse a comma separated html-templates.conf inputs list;
+// returns the HTML_INPUT_BITS or ERROR
+static int parseInputs (char *list)
+{
+    static char     *names[] = { "archive", "hour", "day", "loop", "astro", "all" };
+    static int      bits[] = { HTML_INPUT_ARCHIVE, HTML_INPUT_HOUR, HTML_INPUT_DAY,
+                               HTML_INPUT_LOOP, HTML_INPUT_ASTRO, HTML_INPUT_ALL };
+    char            *name, *next;
+    int             i, inputs = 0;
+
+    for (name = list; name != NULL; name = next)
+    {
+        next = strchr (name, ',');
+        if (next != NULL)
+        {
+            *next++ = 0;
+        }
+
+        for (i = 0; i < sizeof(bits)/sizeof(bits[0]); i ++)
+        {
+            if (!strcmp (name, names[i]))
+            {
+                inputs |= bits[i];
+                break;
+            }
+        }
+        if (i == sizeof(bits)/sizeof(bits[0]))
+        {
+            return ERROR;
+        }
+    }
+
+    return inputs;
+}
+
 static int readHtmlTemplateFile (HTML_MGR *mgr, char *filename)
 {
     HTML_TMPL       *html;
@@ -252,6 +330,24 @@ static int readHtmlTemplateFile (HTML_MGR *mgr, char *filename)
         }
         wvstrncpy (html->fname, token, sizeof(html->fname));
 
+        // optional inputs, default is everything
+        token = strtok (NULL, " \t\n");
+        if (token == NULL)
+        {
+            html->inputs = HTML_INPUT_ALL;
+        }
+        else
+        {
+            html->inputs = parseInputs (token);
+            if (html->inputs == ERROR)
+            {
+                radMsgLog (PRI_HIGH, "%s: %s: bad inputs %s",
+                           filename, html->fname, token);
+                free (html);
+                continue;
+            }
+        }
+
         radListAddToEnd (&mgr->templateList, (NODE_PTR)html);
     }
 
@@ -483,6 +579,16 @@ HTML_MGR_ID htmlmgrInit
     newId->stationElevation = elevation;
     newId->stationLatitude  = latitude;
     newId->stationLongitude = longitude;
+
+    htmlhistoryInit (&newId->dayHistory, &newId->dayStore[0][0],
+                     MAX_DAILY_NUM_VALUES, DAILY_NUM_VALUES(newId));
+    htmlhistoryInit (&newId->weekHistory, &newId->weekStore[0][0],
+                     WEEKLY_NUM_VALUES, WEEKLY_NUM_VALUES);
+    htmlhistoryInit (&newId->monthHistory, &newId->monthStore[0][0],
+                     MONTHLY_NUM_VALUES, MONTHLY_NUM_VALUES);
+    htmlhistoryInit (&newId->yearHistory, &newId->yearStore[0][0],
+                     YEARLY_NUM_VALUES, YEARLY_NUM_VALUES);
+
     wvstrncpy (newId->stationName, name, sizeof(newId->stationName));
     wvstrncpy (newId->stationCity, city, sizeof(newId->stationCity));
     wvstrncpy (newId->stationState, state, sizeof(newId->stationState));
@@ -560,6 +666,11 @@ HTML_MGR_ID htmlmgrInit
         return NULL;
     }
 
+    //  ... pick up the last published manifest so unchanged files are not rehashed
+    manifestInit (&newId->manifest, NULL);
+    sprintf (confFilePath, "%s/%s", WVIEW_RUN_DIR, HTML_MANIFEST_FILE);
+    manifestLoad (&newId->manifest, confFilePath);
+
     statusUpdateStat(HTML_STATS_IMAGES_DEFINED, numImages);
     statusUpdateStat(HTML_STATS_TEMPLATES_DEFINED, numTemplates);
 
@@ -643,6 +754,14 @@ void htmlmgrExit
 
     emptyWorkLists (id);
 
+    manifestExit (&id->manifest);
+
+    glcacheFlush ();
+
+    htmlGenerateExit ();
+
+    htmldataExit ();
+
     return;
 }
 
@@ -759,13 +878,57 @@ static int newProcessEntryPoint (void * pargs)
 
 
 
+static void getAstroState (HTML_MGR_ID id, short *astro)
+{
+    astro[0]  = id->sunrise;
+    astro[1]  = id->sunset;
+    astro[2]  = id->midday;
+    astro[3]  = id->dayLength;
+    astro[4]  = id->civilrise;
+    astro[5]  = id->civilset;
+    astro[6]  = id->astrorise;
+    astro[7]  = id->astroset;
+    astro[8]  = id->moonrise;
+    astro[9]  = id->moonset;
+    astro[10] = wvutilsIsDayTime (id->sunrise, id->sunset);
+    return;
+}
+
+// which inputs (HTML_INPUT_BITS) changed since the last generation?
+static int getChangedInputs (HTML_MGR_ID id, short *astro, int baromTrend)
+{
+    int                 changed = id->newArchiveMask;
+
+    if (! id->isBuilt)
+    {
+        return HTML_INPUT_ALL;
+    }
+
+    if (memcmp (&id->loopStore, &id->builtLoop, sizeof(id->loopStore)) ||
+        memcmp (&id->hilowStore, &id->builtHilow, sizeof(id->hilowStore)) ||
+        id->baromTrendIndicator != baromTrend)
+    {
+        changed |= HTML_INPUT_LOOP;
+    }
+
+    if (memcmp (astro, id->builtAstro, sizeof(id->builtAstro)))
+    {
+        changed |= HTML_INPUT_ASTRO;
+    }
+
+    return changed;
+}
+
 int htmlmgrGenerate
 (
-    HTML_MGR_ID         id
+    HTML_MGR_ID         id,
+    int                 isPeriodic
 )
 {
     register HTML_IMG   *img;
-    int                 retVal, imgs = 0, htmls = 0;
+    int                 retVal, imgs = 0, htmls = 0, elapsed;
+    int                 changed, baromTrend;
+    short               astro[HTML_ASTRO_MAX];
     char                temp[256];
     struct stat         fileData;
 
@@ -777,11 +940,26 @@ int htmlmgrGenerate
                buffersGetTotal ());
 #endif
 
-    //  ... compute the Barometric Pressure trend
-    computeBPTrend (id);
+    //  ... compute the Barometric Pressure trend (sampled once per interval)
+    baromTrend = id->baromTrendIndicator;
+    if (isPeriodic)
+    {
+        computeBPTrend (id);
+    }
+
+    //  ... anything to do?
+    getAstroState (id, astro);
+    changed = getChangedInputs (id, astro, baromTrend);
+    if (changed == 0)
+    {
+#if DEBUG_GENERATION
+        radMsgLog (PRI_MEDIUM, "GENERATE: no inputs changed");
+#endif
+        return OK;
+    }
 
 #if DEBUG_GENERATION
-    radMsgLog (PRI_MEDIUM, "GENERATE: images");
+    radMsgLog (PRI_MEDIUM, "GENERATE: images: inputs 0x%X", changed);
 #endif
 
     //  ... generate the weather images
@@ -789,6 +967,12 @@ int htmlmgrGenerate
          img != NULL;
          img = (HTML_IMG *)radListGetNext (&id->imgList, (NODE_PTR)img))
     {
+        if (!(img->inputs & changed))
+        {
+            // nothing it depends on has changed
+            continue;
+        }
+
         retVal = (*img->generator) (img);
         if (retVal == OK)
         {
@@ -807,6 +991,12 @@ int htmlmgrGenerate
     //  ... clear the archiveAvailable flag (must be after generator loop)
     id->newArchiveMask = 0;
 
+    //  ... remember what this generation was built from
+    id->builtLoop   = id->loopStore;
+    id->builtHilow  = id->hilowStore;
+    memcpy (id->builtAstro, astro, sizeof(id->builtAstro));
+    id->isBuilt     = TRUE;
+
 #if DEBUG_GENERATION
     radMsgLog (PRI_MEDIUM, "GENERATE: pre-generate script");
 #endif
@@ -824,19 +1014,37 @@ int htmlmgrGenerate
 #endif
 
     //  ... now generate the HTML
-    if ((htmls = htmlgenOutputFiles(id, GenerateTime)) == ERROR)
+    if ((htmls = htmlgenOutputFiles(id, GenerateTime, changed)) == ERROR)
     {
         return ERROR;
     }
 
+    //  ... and the live data documents
+    if (id->dataFormats)
+    {
+        htmldataGenerate (id);
+    }
+
+    elapsed = (int)(radTimeGetMSSinceEpoch() - GenerateTime);
     wvutilsLogEvent(PRI_STATUS, "Generated: %u ms: %d images, %d template files",
-                    (ULONG)(radTimeGetMSSinceEpoch() - GenerateTime), imgs, htmls);
+                    (ULONG)elapsed, imgs, htmls);
+    statusHistogramAdd(HTML_HISTOGRAM_GENERATE_MS, elapsed);
 
     id->imagesGenerated += imgs;
     id->templatesGenerated += htmls;
     statusUpdateStat(HTML_STATS_IMAGES_GENERATED, id->imagesGenerated);
     statusUpdateStat(HTML_STATS_TEMPLATES_GENERATED, id->templatesGenerated);
 
+    //  ... publish the content hashes for wviewftpd and wviewsshd
+    retVal = manifestUpdate (&id->manifest, id->imagePath);
+    if (retVal != ERROR)
+    {
+        sprintf (temp, "%s/%s", WVIEW_RUN_DIR, HTML_MANIFEST_FILE);
+        manifestSave (&id->manifest, temp);
+        wvutilsLogEvent(PRI_STATUS, "Manifest: %d of %d files rehashed",
+                        retVal, id->manifest.count);
+    }
+
 #if __DEBUG_BUFFERS
     radMsgLog (PRI_STATUS, "DBG BFRS: HTML END: %u of %u available",
                buffersGetAvailable (),
@@ -907,7 +1115,7 @@ int htmlmgrHistoryInit (HTML_MGR_ID id)
         {
             for (j = 0; j < DATA_INDEX_MAX(id->isExtendedData); j ++)
             {
-                id->dayValues[j][i] = ARCHIVE_VALUE_NULL;
+                htmlhistorySet (&id->dayHistory, j, i, ARCHIVE_VALUE_NULL);
             }
         }
         else
@@ -916,15 +1124,15 @@ int htmlmgrHistoryInit (HTML_MGR_ID id)
             {
                 if (data.values[j] <= ARCHIVE_VALUE_NULL || data.samples[j] == 0)
                 {
-                    id->dayValues[j][i] = ARCHIVE_VALUE_NULL;
+                    htmlhistorySet (&id->dayHistory, j, i, ARCHIVE_VALUE_NULL);
                 }
                 else if (j == DATA_INDEX_rain || j == DATA_INDEX_windDir || j == DATA_INDEX_ET)
                 {
-                    id->dayValues[j][i] = data.values[j];
+                    htmlhistorySet (&id->dayHistory, j, i, data.values[j]);
                 }
                 else
                 {
-                    id->dayValues[j][i] = data.values[j]/data.samples[j];
+                    htmlhistorySet (&id->dayHistory, j, i, data.values[j]/data.samples[j]);
                 }
             }
         }
@@ -951,7 +1159,7 @@ int htmlmgrHistoryInit (HTML_MGR_ID id)
         {
             for (j = 0; j < DATA_INDEX_MAX(id->isExtendedData); j ++)
             {
-                id->weekValues[j][i] = ARCHIVE_VALUE_NULL;
+                htmlhistorySet (&id->weekHistory, j, i, ARCHIVE_VALUE_NULL);
             }
         }
         else
@@ -960,15 +1168,15 @@ int htmlmgrHistoryInit (HTML_MGR_ID id)
             {
                 if (data.values[j] <= ARCHIVE_VALUE_NULL || data.samples[j] == 0)
                 {
-                    id->weekValues[j][i] = ARCHIVE_VALUE_NULL;
+                    htmlhistorySet (&id->weekHistory, j, i, ARCHIVE_VALUE_NULL);
                 }
                 else if (j == DATA_INDEX_rain || j == DATA_INDEX_windDir || j == DATA_INDEX_ET)
                 {
-                    id->weekValues[j][i] = data.values[j];
+                    htmlhistorySet (&id->weekHistory, j, i, data.values[j]);
                 }
                 else
                 {
-                    id->weekValues[j][i] = data.values[j]/data.samples[j];
+                    htmlhistorySet (&id->weekHistory, j, i, data.values[j]/data.samples[j]);
                 }
             }
         }
@@ -997,7 +1205,7 @@ int htmlmgrHistoryInit (HTML_MGR_ID id)
         {
             for (j = 0; j < DATA_INDEX_MAX(id->isExtendedData); j ++)
             {
-                id->monthValues[j][i] = ARCHIVE_VALUE_NULL;
+                htmlhistorySet (&id->monthHistory, j, i, ARCHIVE_VALUE_NULL);
             }
         }
         else
@@ -1006,15 +1214,15 @@ int htmlmgrHistoryInit (HTML_MGR_ID id)
             {
                 if (data.values[j] <= ARCHIVE_VALUE_NULL || data.samples[j] == 0)
                 {
-                    id->monthValues[j][i] = ARCHIVE_VALUE_NULL;
+                    htmlhistorySet (&id->monthHistory, j, i, ARCHIVE_VALUE_NULL);
                 }
                 else if (j == DATA_INDEX_rain || j == DATA_INDEX_windDir || j == DATA_INDEX_ET)
                 {
-                    id->monthValues[j][i] = data.values[j];
+                    htmlhistorySet (&id->monthHistory, j, i, data.values[j]);
                 }
                 else
                 {
-                    id->monthValues[j][i] = data.values[j]/data.samples[j];
+                    htmlhistorySet (&id->monthHistory, j, i, data.values[j]/data.samples[j]);
                 }
             }
         }
@@ -1075,15 +1283,15 @@ int htmlmgrHistoryInit (HTML_MGR_ID id)
         {
             if (data.values[j] <= ARCHIVE_VALUE_NULL || data.samples[j] == 0)
             {
-                id->yearValues[j][i] = ARCHIVE_VALUE_NULL;
+                htmlhistorySet (&id->yearHistory, j, i, ARCHIVE_VALUE_NULL);
             }
             else if (j == DATA_INDEX_rain || j == DATA_INDEX_windDir || j == DATA_INDEX_ET)
             {
-                id->yearValues[j][i] = data.values[j];
+                htmlhistorySet (&id->yearHistory, j, i, data.values[j]);
             }
             else
             {
-                id->yearValues[j][i] = data.values[j]/data.samples[j];
+                htmlhistorySet (&id->yearHistory, j, i, data.values[j]/data.samples[j]);
             }
         }
 
@@ -1101,27 +1309,25 @@ int htmlmgrHistoryInit (HTML_MGR_ID id)
 
 int htmlmgrAddSampleValue (HTML_MGR_ID id, HISTORY_DATA *data, int numIntervals)
 {
-    register int    i, j;
+    register int    i;
+
+    // a gap longer than the day just empties it:
+    if (numIntervals > id->dayHistory.length)
+    {
+        numIntervals = id->dayHistory.length;
+    }
 
     // check for data gap
     while (numIntervals > 1)
     {
         // we have apparently missed some archive records - add empty data in 
         // the "gap"
-        
-        // do the normal new record stuff first
-        for (i = 0; i < DATA_INDEX_MAX(id->isExtendedData); i ++)
-        {
-            for (j = 0; j < DAILY_NUM_VALUES(id) - 1; j ++)
-            {
-                id->dayValues[i][j] = id->dayValues[i][j+1];
-            }
-        }
+        htmlhistoryAdvance (&id->dayHistory);
 
         // populate history data with ARCHIVE_VALUE_NULL
         for (i = 0; i < DATA_INDEX_MAX(id->isExtendedData); i ++)
         {
-            id->dayValues[i][DAILY_NUM_VALUES(id)-1] = ARCHIVE_VALUE_NULL;
+            htmlhistorySet (&id->dayHistory, i, id->dayHistory.length-1, ARCHIVE_VALUE_NULL);
         }
 
         // decrement interval count
@@ -1129,23 +1335,11 @@ int htmlmgrAddSampleValue (HTML_MGR_ID id, HISTORY_DATA *data, int numIntervals)
     }
 
     // now add the new record data
-    for (i = 0; i < DATA_INDEX_MAX(id->isExtendedData); i ++)
-    {
-        for (j = 0; j < DAILY_NUM_VALUES(id) - 1; j ++)
-        {
-            id->dayValues[i][j] = id->dayValues[i][j+1];
-        }
-    }
+    htmlhistoryAdvance (&id->dayHistory);
 
     for (i = 0; i < DATA_INDEX_MAX(id->isExtendedData); i ++)
     {
-        id->dayValues[i][DAILY_NUM_VALUES(id)-1] = data->values[i];
-
-        if (data->values[i] > ARCHIVE_VALUE_NULL && data->samples[i] != 0 &&
-            i != DATA_INDEX_rain && i != DATA_INDEX_windDir && i != DATA_INDEX_ET)
-        {
-            id->dayValues[i][DAILY_NUM_VALUES(id)-1] /= data->samples[i];
-        }
+        htmlhistorySet (&id->dayHistory, i, id->dayHistory.length-1, historyValue (data, i));
     }
 
     // Compute the new day start interval:
@@ -1159,34 +1353,20 @@ int htmlmgrAddSampleValue (HTML_MGR_ID id, HISTORY_DATA *data, int numIntervals)
 
 int htmlmgrAddHourValue (HTML_MGR_ID id, HISTORY_DATA *data)
 {
-    register int    i, j;
+    register int    i;
+    float           value;
 
-    for (i = 0; i < DATA_INDEX_MAX(id->isExtendedData); i ++)
-    {
-        for (j = 0; j < WEEKLY_NUM_VALUES-1; j ++)
-        {
-            id->weekValues[i][j] = id->weekValues[i][j+1];
-        }
-        for (j = 0; j < MONTHLY_NUM_VALUES-1; j ++)
-        {
-            id->monthValues[i][j] = id->monthValues[i][j+1];
-        }
-    }
+    htmlhistoryAdvance (&id->weekHistory);
+    htmlhistoryAdvance (&id->monthHistory);
 
     id->weekStartTime_T = wvutilsGetWeekStartTime (id->archiveInterval);
     id->monthStartTime_T = wvutilsGetMonthStartTime (id->archiveInterval);
 
     for (i = 0; i < DATA_INDEX_MAX(id->isExtendedData); i ++)
     {
-        id->weekValues[i][WEEKLY_NUM_VALUES-1] = data->values[i];
-        id->monthValues[i][MONTHLY_NUM_VALUES-1] = data->values[i];
-
-        if (data->values[i] > ARCHIVE_VALUE_NULL && data->samples[i] != 0  &&
-            i != DATA_INDEX_rain && i != DATA_INDEX_windDir && i != DATA_INDEX_ET)
-        {
-            id->weekValues[i][WEEKLY_NUM_VALUES-1] /= data->samples[i];
-            id->monthValues[i][MONTHLY_NUM_VALUES-1] /= data->samples[i];
-        }
+        value = historyValue (data, i);
+        htmlhistorySet (&id->weekHistory, i, WEEKLY_NUM_VALUES-1, value);
+        htmlhistorySet (&id->monthHistory, i, MONTHLY_NUM_VALUES-1, value);
     }
 
     return OK;
@@ -1194,27 +1374,15 @@ int htmlmgrAddHourValue (HTML_MGR_ID id, HISTORY_DATA *data)
 
 int htmlmgrAddDayValue (HTML_MGR_ID id, HISTORY_DATA *data)
 {
-    register int    i, j;
+    register int    i;
 
-    for (i = 0; i < DATA_INDEX_MAX(id->isExtendedData); i ++)
-    {
-        for (j = 0; j < YEARLY_NUM_VALUES-1; j ++)
-        {
-            id->yearValues[i][j] = id->yearValues[i][j+1];
-        }
-    }
+    htmlhistoryAdvance (&id->yearHistory);
 
     id->yearStartTime_T += WV_SECONDS_IN_DAY;
 
     for (i = 0; i < DATA_INDEX_MAX(id->isExtendedData); i ++)
     {
-        id->yearValues[i][YEARLY_NUM_VALUES-1] = data->values[i];
-
-        if (data->values[i] > ARCHIVE_VALUE_NULL && data->samples[i] != 0  &&
-            i != DATA_INDEX_rain && i != DATA_INDEX_windDir && i != DATA_INDEX_ET)
-        {
-            id->yearValues[i][YEARLY_NUM_VALUES-1] /= data->samples[i];
-        }
+        htmlhistorySet (&id->yearHistory, i, YEARLY_NUM_VALUES-1, historyValue (data, i));
     }
 
     return OK;
@@ -11,9 +11,20 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         08/30/03        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Ring buffer history
+        10/19/2026      M.S. Teel       2               Table-driven charts
+        10/19/2026      M.S. Teel       3               Input-driven generation
+        10/19/2026      M.S. Teel       4               Live data documents
+        10/19/2026      M.S. Teel       5               History ring in htmlHistory.c
  
   NOTES:
-        
+        The day/week/month/year history is kept in HTML_HISTORY ring buffers;
+        use DAY_VALUES, WEEK_VALUES, MONTH_VALUES and YEAR_VALUES to get the
+        contiguous (oldest first) values of a field.
+
+        Each image and template declares the inputs it is built from
+        (HTML_INPUT_BITS); htmlmgrGenerate only rebuilds the ones with an
+        input that changed since the last generation.
  
   LICENSE:
         Copyright (c) 2004, Mark S. Teel (mark@teel.ws)
@@ -48,6 +59,8 @@
 #include <datadefs.h>
 #include <services.h>
 #include <status.h>
+#include <manifest.h>
+#include <htmlHistory.h>
 
 
 
@@ -78,6 +91,11 @@
 
 #define FORECAST_ICON_FN_MAX    128
 
+#define DAY_VALUES(x,field)     HTML_HISTORY_VALUES(&(x)->dayHistory, field)
+#define WEEK_VALUES(x,field)    HTML_HISTORY_VALUES(&(x)->weekHistory, field)
+#define MONTH_VALUES(x,field)   HTML_HISTORY_VALUES(&(x)->monthHistory, field)
+#define YEAR_VALUES(x,field)    HTML_HISTORY_VALUES(&(x)->yearHistory, field)
+
 
 /*  !!!!!!!!!!!!!!!!!!  HIDDEN, NOT FOR API USE  !!!!!!!!!!!!!!!!!!
 */
@@ -93,6 +111,21 @@ typedef enum
     NEW_ARCHIVE_ALL             = 0x7
 } NEW_ARCHIVE_BITS;
 
+//  ... define the generation inputs an image or template depends on
+//  ... (the archive bits are the NEW_ARCHIVE_BITS)
+typedef enum
+{
+    HTML_INPUT_ARCHIVE          = NEW_ARCHIVE_SAMPLE,       // new archive record
+    HTML_INPUT_HOUR             = NEW_ARCHIVE_HOUR,         // new hour
+    HTML_INPUT_DAY              = NEW_ARCHIVE_DAY,          // new day
+    HTML_INPUT_LOOP             = 0x8,                      // LOOP or HILOW data
+    HTML_INPUT_ASTRO            = 0x10,                     // sun/moon, day/night
+    HTML_INPUT_ALL              = 0x1F
+} HTML_INPUT_BITS;
+
+// sunrise, sunset, midday, day length, civil, astro, moon and day/night:
+#define HTML_ASTRO_MAX              11
+
 //  ... define the work area for this beast
 typedef struct
 {
@@ -127,13 +160,17 @@ typedef struct
     short               moonset;
     RADLIST             imgList;
     RADLIST             templateList;
-    float               dayValues[DATA_INDEX_MAX][MAX_DAILY_NUM_VALUES];
+    float               dayStore[DATA_INDEX_MAX][2*MAX_DAILY_NUM_VALUES];
+    HTML_HISTORY        dayHistory;
     int                 dayStart;
-    float               weekValues[DATA_INDEX_MAX][WEEKLY_NUM_VALUES];
+    float               weekStore[DATA_INDEX_MAX][2*WEEKLY_NUM_VALUES];
+    HTML_HISTORY        weekHistory;
     time_t              weekStartTime_T;
-    float               monthValues[DATA_INDEX_MAX][MONTHLY_NUM_VALUES];
+    float               monthStore[DATA_INDEX_MAX][2*MONTHLY_NUM_VALUES];
+    HTML_HISTORY        monthHistory;
     time_t              monthStartTime_T;
-    float               yearValues[DATA_INDEX_MAX][YEARLY_NUM_VALUES];
+    float               yearStore[DATA_INDEX_MAX][2*YEARLY_NUM_VALUES];
+    HTML_HISTORY        yearHistory;
     time_t              yearStartTime_T;
     int                 newArchiveMask;
     float               baromTrendValues[BP_MAX_VALUES];    // 4 hours
@@ -147,9 +184,51 @@ typedef struct
     int                 isDualUnits;
     int                 imagesGenerated;
     int                 templatesGenerated;
+    MANIFEST            manifest;                           // of imagePath
+    int                 isBuilt;                            // built* are valid
+    LOOP_PKT            builtLoop;                          // as last generated
+    SENSOR_STORE        builtHilow;
+    short               builtAstro[HTML_ASTRO_MAX];
+    int                 dataFormats;                        // HTML_DATA_FORMATS
 } HTML_MGR, *HTML_MGR_ID;
 
 
+//  ... define the table-driven (generic) chart spans, kinds and scales
+typedef enum
+{
+    HTML_CHART_SPAN_DAY         = 0,
+    HTML_CHART_SPAN_WEEK,
+    HTML_CHART_SPAN_MONTH,
+    HTML_CHART_SPAN_YEAR,
+    HTML_CHART_SPAN_MAX
+} HTML_CHART_SPAN;
+
+typedef enum
+{
+    HTML_CHART_KIND_LINE        = 0,
+    HTML_CHART_KIND_PERCENT
+} HTML_CHART_KIND;
+
+typedef enum
+{
+    HTML_CHART_SCALE_FIXED      = 0,                        // min, max, step
+    HTML_CHART_SCALE_TEMP                                   // CHART_MIN/MAX_TEMP
+} HTML_CHART_SCALE;
+
+//  ... define a table-driven chart: which field over which span and how
+typedef struct
+{
+    int                 field;                              // Data_Indices
+    HTML_CHART_SPAN     span;
+    HTML_CHART_KIND     kind;
+    HTML_CHART_SCALE    scale;
+    float               min;
+    float               max;
+    float               step;
+    int                 isDualUnits;
+} HTML_CHART;
+
+
 //  ... define the image data "node"
 typedef struct htmlImageTag
 {
@@ -160,6 +239,8 @@ typedef struct htmlImageTag
     char                units[32];
     int                 decimalPlaces;
     int                 (*generator) (struct htmlImageTag *);
+    HTML_CHART          chart;                              // generic charts
+    int                 inputs;                             // HTML_INPUT_BITS
 } HTML_IMG;
 
 
@@ -168,6 +249,7 @@ typedef struct htmlTemplateTag
 {
     NODE                node;
     char                fname[128];
+    int                 inputs;                             // HTML_INPUT_BITS
 } HTML_TMPL;
 
 
@@ -218,9 +300,12 @@ extern int htmlmgrBPTrendInit
     int                 timerIntervalMINs
 );
 
+//  ... regenerate the images and templates whose inputs changed;
+//  ... 'isPeriodic' is TRUE for the generation interval timer
 extern int htmlmgrGenerate
 (
-    HTML_MGR_ID     id
+    HTML_MGR_ID     id,
+    int             isPeriodic
 );
 
 extern int htmlmgrHistoryInit (HTML_MGR_ID id);
@@ -0,0 +1,768 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        htmlServer.c
+
+  PURPOSE:
+        Provide the wview html generator embedded HTTP server.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        See htmlServer.h.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radprocess.h>
+
+/*  ... Local include files
+*/
+#include <htmlServer.h>
+#include <htmlData.h>
+
+
+/*  ... global memory declarations
+*/
+
+/*  ... global memory referenced
+*/
+
+/*  ... static (local) memory declarations
+*/
+typedef struct
+{
+    int             fd;                     // -1 when free
+    HTML_BUFFER     request;
+    HTML_BUFFER     output;
+    int             outputOffset;           // bytes of output already sent
+    int             isEvents;
+    int             closeWhenSent;
+    time_t          lastActive;
+} HTML_CLIENT;
+
+typedef struct
+{
+    int             listenFd;
+    TIMER_ID        timer;
+    char            rootPath[_MAX_PATH];
+    HTML_CLIENT     clients[HTML_SERVER_MAX_CLIENTS];
+    HTML_BUFFER     event;
+    LOOP_PKT        lastLoop;
+    int             haveLoop;
+} HTML_SERVER;
+
+static HTML_SERVER      server;
+static int              serverIsRunning;
+
+//  ... This is the table of content types by file extension:
+typedef struct
+{
+    char        *extension;
+    char        *type;
+    int         isText;                     // worth compressing
+} SERVER_TYPE;
+
+static SERVER_TYPE serverTypes[] =
+    {
+        { "htm",    "text/html",                TRUE  },
+        { "html",   "text/html",                TRUE  },
+        { "css",    "text/css",                 TRUE  },
+        { "js",     "application/javascript",   TRUE  },
+        { "json",   "application/json",         TRUE  },
+        { "xml",    "text/xml",                 TRUE  },
+        { "txt",    "text/plain",               TRUE  },
+        { "csv",    "text/csv",                 TRUE  },
+        { "svg",    "image/svg+xml",            TRUE  },
+        { "png",    "image/png",                FALSE },
+        { "gif",    "image/gif",                FALSE },
+        { "jpg",    "image/jpeg",               FALSE },
+        { "jpeg",   "image/jpeg",               FALSE },
+        { "ico",    "image/x-icon",             FALSE },
+        { NULL,     "application/octet-stream", FALSE }
+    };
+
+
+static SERVER_TYPE *getType (char *path)
+{
+    char            *extension = strrchr (path, '.');
+    int             i;
+
+    for (i = 0; serverTypes[i].extension != NULL; i ++)
+    {
+        if (extension != NULL && !strcasecmp (extension + 1, serverTypes[i].extension))
+        {
+            break;
+        }
+    }
+
+    return &serverTypes[i];
+}
+
+// copy the value of header 'name' (empty if missing) to 'value':
+static void getHeader (char *request, char *name, char *value, int size)
+{
+    char            search[64];
+    char            *start, *end;
+    int             length;
+
+    value[0] = 0;
+    snprintf (search, sizeof(search), "\r\n%s:", name);
+    start = strcasestr (request, search);
+    if (start == NULL)
+    {
+        return;
+    }
+
+    start += strlen (search);
+    while (*start == ' ' || *start == '\t')
+    {
+        start ++;
+    }
+    end = strstr (start, "\r\n");
+    length = (end != NULL) ? (end - start) : strlen (start);
+    if (length >= size)
+    {
+        length = size - 1;
+    }
+
+    memcpy (value, start, length);
+    value[length] = 0;
+    return;
+}
+
+static void formatDate (time_t when, char *store, int size)
+{
+    struct tm       gmTime;
+
+    gmtime_r (&when, &gmTime);
+    strftime (store, size, "%a, %d %b %Y %H:%M:%S GMT", &gmTime);
+    return;
+}
+
+static void closeClient (HTML_CLIENT *client)
+{
+    radProcessIODeRegisterDescriptorByFd (client->fd);
+    close (client->fd);
+    htmlbufferFree (&client->request);
+    htmlbufferFree (&client->output);
+    memset (client, 0, sizeof (*client));
+    client->fd = -1;
+    return;
+}
+
+// (re)start the process timer; queued output is polled since radProcess
+// only watches for input
+static void armTimer (void)
+{
+    int             i, timeoutMS = 0;
+
+    for (i = 0; i < HTML_SERVER_MAX_CLIENTS; i ++)
+    {
+        if (server.clients[i].fd == -1)
+        {
+            continue;
+        }
+        if (server.clients[i].output.length > server.clients[i].outputOffset)
+        {
+            timeoutMS = HTML_SERVER_POLL_MS;
+            break;
+        }
+        timeoutMS = HTML_SERVER_IDLE_CHECK_MS;
+    }
+
+    radProcessTimerStop (server.timer);
+    if (timeoutMS > 0)
+    {
+        radProcessTimerStart (server.timer, timeoutMS);
+    }
+
+    return;
+}
+
+// send what the socket will take; returns ERROR if the client was closed
+static int sendOutput (HTML_CLIENT *client)
+{
+    int             count;
+
+    while (client->outputOffset < client->output.length)
+    {
+        count = send (client->fd,
+                      &client->output.data[client->outputOffset],
+                      client->output.length - client->outputOffset,
+                      MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (count > 0)
+        {
+            client->outputOffset += count;
+            client->lastActive = time (NULL);
+        }
+        else if (count == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (count == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            // the process timer will finish it
+            return OK;
+        }
+        else
+        {
+            closeClient (client);
+            return ERROR;
+        }
+    }
+
+    htmlbufferReset (&client->output);
+    client->outputOffset = 0;
+
+    if (client->closeWhenSent)
+    {
+        closeClient (client);
+        return ERROR;
+    }
+
+    return OK;
+}
+
+// returns ERROR if the client was closed
+static int queueOutput (HTML_CLIENT *client, const char *data, int length)
+{
+    if (client->output.length - client->outputOffset + length > HTML_SERVER_OUTPUT_MAX)
+    {
+        // not keeping up - an event stream would only fall further behind
+        if (client->isEvents)
+        {
+            closeClient (client);
+            return ERROR;
+        }
+    }
+
+    if (htmlbufferAppend (&client->output, data, length) == ERROR)
+    {
+        closeClient (client);
+        return ERROR;
+    }
+
+    return OK;
+}
+
+static void queueHeader
+(
+    HTML_CLIENT     *client,
+    char            *status,
+    char            *extraHeaders,
+    int             contentLength
+)
+{
+    char            header[1024], date[64], length[64];
+
+    formatDate (time (NULL), date, sizeof(date));
+    if (contentLength >= 0)
+    {
+        snprintf (length, sizeof(length), "Content-Length: %d\r\n", contentLength);
+    }
+    else
+    {
+        length[0] = 0;
+    }
+
+    snprintf (header, sizeof(header),
+              "HTTP/1.1 %s\r\n"
+              "Server: %s\r\n"
+              "Date: %s\r\n"
+              "%s"
+              "%s"
+              "Connection: %s\r\n"
+              "\r\n",
+              status, HTML_SERVER_NAME, date, extraHeaders, length,
+              ((client->closeWhenSent || client->isEvents) ? "close" : "keep-alive"));
+
+    queueOutput (client, header, strlen (header));
+    return;
+}
+
+static void queueError (HTML_CLIENT *client, char *status)
+{
+    char            body[128];
+
+    snprintf (body, sizeof(body), "%s\n", status);
+    queueHeader (client, status, "Content-Type: text/plain\r\n", strlen (body));
+    if (client->fd != -1)
+    {
+        queueOutput (client, body, strlen (body));
+    }
+    return;
+}
+
+static void formatEvent (LOOP_PKT *loop)
+{
+    htmlbufferReset (&server.event);
+    htmlbufferAppendString (&server.event, "event: loop\ndata: ");
+    htmldataFormatLoop (loop, &server.event);
+    htmlbufferAppendString (&server.event, "\n\n");
+    return;
+}
+
+static void startEvents (HTML_CLIENT *client)
+{
+    // the stream ends when the connection does:
+    client->isEvents = TRUE;
+    queueHeader (client, "200 OK",
+                 "Content-Type: text/event-stream\r\n"
+                 "Cache-Control: no-cache\r\n",
+                 -1);
+
+    if (client->fd != -1 && server.haveLoop)
+    {
+        formatEvent (&server.lastLoop);
+        queueOutput (client, server.event.data, server.event.length);
+    }
+
+    return;
+}
+
+static void handleRequest (HTML_CLIENT *client, char *request)
+{
+    HTML_FILE       *file;
+    HTML_BUFFER     *body;
+    SERVER_TYPE     *type;
+    char            method[16], uri[1024], version[16];
+    char            path[_MAX_PATH], value[256], etag[64];
+    char            headers[512], modified[64];
+    char            *query;
+    int             isHead, isGzip;
+
+    if (sscanf (request, "%15s %1023s %15s", method, uri, version) != 3 ||
+        strncmp (version, "HTTP/1.", 7))
+    {
+        client->closeWhenSent = TRUE;
+        queueError (client, "400 Bad Request");
+        return;
+    }
+
+    // HTTP/1.1 connections persist unless the client says otherwise:
+    getHeader (request, "Connection", value, sizeof(value));
+    if (!strcmp (version, "HTTP/1.0"))
+    {
+        client->closeWhenSent = (strcasestr (value, "keep-alive") == NULL);
+    }
+    else
+    {
+        client->closeWhenSent = (strcasestr (value, "close") != NULL);
+    }
+
+    isHead = !strcmp (method, "HEAD");
+    if (strcmp (method, "GET") && ! isHead)
+    {
+        client->closeWhenSent = TRUE;
+        queueError (client, "405 Method Not Allowed");
+        return;
+    }
+
+    query = strchr (uri, '?');
+    if (query != NULL)
+    {
+        *query = 0;
+    }
+
+    if (!strcmp (uri, HTML_SERVER_EVENTS_PATH) && ! isHead)
+    {
+        startEvents (client);
+        return;
+    }
+
+    // stay inside the image path:
+    if (uri[0] != '/' || strstr (uri, "..") != NULL)
+    {
+        queueError (client, "404 Not Found");
+        return;
+    }
+
+    if (snprintf (path, sizeof(path), "%s%s%s", server.rootPath, uri,
+                  ((uri[strlen(uri) - 1] == '/') ? HTML_SERVER_INDEX_FILE : ""))
+        >= sizeof(path))
+    {
+        queueError (client, "404 Not Found");
+        return;
+    }
+
+    file = htmlbufferGetFile (path);
+    if (file == NULL)
+    {
+        queueError (client, "404 Not Found");
+        return;
+    }
+
+    type = getType (path);
+    getHeader (request, "Accept-Encoding", value, sizeof(value));
+    isGzip = (type->isText &&
+              file->contents.length >= HTML_SERVER_GZIP_MIN &&
+              strcasestr (value, "gzip") != NULL);
+
+    body = NULL;
+    if (isGzip)
+    {
+        body = htmlbufferGetCompressed (file);
+    }
+    if (body == NULL)
+    {
+        isGzip = FALSE;
+        body = &file->contents;
+    }
+
+    snprintf (etag, sizeof(etag), "\"%8.8lx-%x%s\"",
+              file->hash, file->contents.length, (isGzip ? "-gz" : ""));
+    formatDate (file->mtime, modified, sizeof(modified));
+    snprintf (headers, sizeof(headers),
+              "Content-Type: %s\r\n"
+              "ETag: %s\r\n"
+              "Last-Modified: %s\r\n"
+              "Cache-Control: no-cache\r\n"
+              "%s%s",
+              type->type, etag, modified,
+              (type->isText ? "Vary: Accept-Encoding\r\n" : ""),
+              (isGzip ? "Content-Encoding: gzip\r\n" : ""));
+
+    getHeader (request, "If-None-Match", value, sizeof(value));
+    if (strstr (value, etag) != NULL)
+    {
+        queueHeader (client, "304 Not Modified", headers, -1);
+        return;
+    }
+
+    queueHeader (client, "200 OK", headers, body->length);
+    if (! isHead && client->fd != -1)
+    {
+        queueOutput (client, body->data, body->length);
+    }
+
+    return;
+}
+
+// radProcess input callback for a client socket
+static void clientDataCallback (int fd, void *userData)
+{
+    HTML_CLIENT     *client = (HTML_CLIENT *)userData;
+    char            buffer[4096];
+    char            *end;
+    int             count, used;
+
+    count = recv (fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (count == -1 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+    {
+        return;
+    }
+    if (count <= 0)
+    {
+        // closed by the client (or broken)
+        closeClient (client);
+        armTimer ();
+        return;
+    }
+
+    client->lastActive = time (NULL);
+    if (client->isEvents || client->closeWhenSent)
+    {
+        // nothing more is expected from this one
+        return;
+    }
+
+    if (htmlbufferAppend (&client->request, buffer, count) == ERROR)
+    {
+        closeClient (client);
+        armTimer ();
+        return;
+    }
+
+    // answer each complete request:
+    while (client->fd != -1 &&
+           ! client->isEvents &&
+           ! client->closeWhenSent &&
+           (end = strstr (client->request.data, "\r\n\r\n")) != NULL)
+    {
+        end[2] = 0;
+        used = (end + 4) - client->request.data;
+        handleRequest (client, client->request.data);
+        if (client->fd == -1)
+        {
+            break;
+        }
+
+        memmove (client->request.data,
+                 &client->request.data[used],
+                 client->request.length - used);
+        client->request.length -= used;
+        client->request.data[client->request.length] = 0;
+    }
+
+    if (client->fd != -1 &&
+        ! client->closeWhenSent &&
+        client->request.length > HTML_SERVER_REQUEST_MAX)
+    {
+        client->closeWhenSent = TRUE;
+        queueError (client, "431 Request Header Fields Too Large");
+    }
+
+    if (client->fd != -1)
+    {
+        sendOutput (client);
+    }
+
+    armTimer ();
+    return;
+}
+
+// radProcess input callback for the listening socket
+static void listenCallback (int fd, void *userData)
+{
+    HTML_CLIENT     *client;
+    int             newFd, i;
+
+    while ((newFd = accept (fd, NULL, NULL)) != -1)
+    {
+        for (i = 0; i < HTML_SERVER_MAX_CLIENTS; i ++)
+        {
+            if (server.clients[i].fd == -1)
+            {
+                break;
+            }
+        }
+        if (i == HTML_SERVER_MAX_CLIENTS)
+        {
+            radMsgLog (PRI_MEDIUM, "htmlserver: too many clients - connection refused");
+            close (newFd);
+            continue;
+        }
+
+        client = &server.clients[i];
+        if (fcntl (newFd, F_SETFL, fcntl (newFd, F_GETFL, 0) | O_NONBLOCK) == -1 ||
+            radProcessIORegisterDescriptor (newFd, clientDataCallback, (void *)client)
+            == ERROR)
+        {
+            radMsgLog (PRI_MEDIUM, "htmlserver: cannot register client socket");
+            close (newFd);
+            continue;
+        }
+
+        client->fd = newFd;
+        client->lastActive = time (NULL);
+    }
+
+    armTimer ();
+    return;
+}
+
+static void timerHandler (void *parm)
+{
+    struct pollfd   fds[HTML_SERVER_MAX_CLIENTS];
+    HTML_CLIENT     *polled[HTML_SERVER_MAX_CLIENTS];
+    HTML_CLIENT     *client;
+    time_t          now = time (NULL);
+    int             i, numFds = 0;
+
+    for (i = 0; i < HTML_SERVER_MAX_CLIENTS; i ++)
+    {
+        client = &server.clients[i];
+        if (client->fd == -1)
+        {
+            continue;
+        }
+
+        if (client->output.length > client->outputOffset)
+        {
+            if (now - client->lastActive > HTML_SERVER_IDLE_TIMEOUT)
+            {
+                // not reading its reply
+                closeClient (client);
+                continue;
+            }
+
+            fds[numFds].fd      = client->fd;
+            fds[numFds].events  = POLLOUT;
+            fds[numFds].revents = 0;
+            polled[numFds]      = client;
+            numFds ++;
+        }
+        else if (! client->isEvents &&
+                 now - client->lastActive > HTML_SERVER_IDLE_TIMEOUT)
+        {
+            closeClient (client);
+        }
+    }
+
+    if (numFds > 0 && poll (fds, numFds, 0) > 0)
+    {
+        for (i = 0; i < numFds; i ++)
+        {
+            if (fds[i].revents & POLLOUT)
+            {
+                sendOutput (polled[i]);
+            }
+            else if (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL))
+            {
+                closeClient (polled[i]);
+            }
+        }
+    }
+
+    armTimer ();
+    return;
+}
+
+
+/*  ... API methods
+*/
+
+int htmlserverInit (int port, char *rootPath)
+{
+    struct sockaddr_in  address;
+    int                 i, on = 1;
+
+    memset (&server, 0, sizeof (server));
+    wvstrncpy (server.rootPath, rootPath, sizeof(server.rootPath));
+    for (i = 0; i < HTML_SERVER_MAX_CLIENTS; i ++)
+    {
+        server.clients[i].fd = -1;
+    }
+
+    server.timer = radTimerCreate (NULL, timerHandler, NULL);
+    if (server.timer == NULL)
+    {
+        radMsgLog (PRI_HIGH, "htmlserverInit: radTimerCreate failed");
+        return ERROR;
+    }
+
+    server.listenFd = socket (AF_INET, SOCK_STREAM, 0);
+    if (server.listenFd == -1)
+    {
+        radMsgLog (PRI_HIGH, "htmlserverInit: socket failed: %s", strerror (errno));
+        radTimerDelete (server.timer);
+        return ERROR;
+    }
+
+    setsockopt (server.listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    memset (&address, 0, sizeof (address));
+    address.sin_family      = AF_INET;
+    address.sin_addr.s_addr = htonl (INADDR_ANY);
+    address.sin_port        = htons ((USHORT)port);
+
+    if (bind (server.listenFd, (struct sockaddr *)&address, sizeof(address)) == -1 ||
+        listen (server.listenFd, HTML_SERVER_MAX_CLIENTS) == -1 ||
+        fcntl (server.listenFd, F_SETFL,
+               fcntl (server.listenFd, F_GETFL, 0) | O_NONBLOCK) == -1)
+    {
+        radMsgLog (PRI_HIGH, "htmlserverInit: cannot listen on port %d: %s",
+                   port, strerror (errno));
+        close (server.listenFd);
+        radTimerDelete (server.timer);
+        return ERROR;
+    }
+
+    if (radProcessIORegisterDescriptor (server.listenFd, listenCallback, NULL)
+        == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "htmlserverInit: radProcessIORegisterDescriptor failed");
+        close (server.listenFd);
+        radTimerDelete (server.timer);
+        return ERROR;
+    }
+
+    // serve the generated files from memory:
+    htmlbufferSetFileCaching (TRUE);
+
+    serverIsRunning = TRUE;
+    radMsgLog (PRI_STATUS, "htmlserver: serving %s on port %d", rootPath, port);
+    return OK;
+}
+
+void htmlserverPushLoop (LOOP_PKT *loop)
+{
+    HTML_CLIENT     *client;
+    int             i, isFormatted = FALSE;
+
+    if (! serverIsRunning)
+    {
+        return;
+    }
+
+    server.lastLoop = *loop;
+    server.haveLoop = TRUE;
+
+    for (i = 0; i < HTML_SERVER_MAX_CLIENTS; i ++)
+    {
+        client = &server.clients[i];
+        if (client->fd == -1 || ! client->isEvents)
+        {
+            continue;
+        }
+
+        if (! isFormatted)
+        {
+            formatEvent (loop);
+            isFormatted = TRUE;
+        }
+
+        if (queueOutput (client, server.event.data, server.event.length) == OK)
+        {
+            sendOutput (client);
+        }
+    }
+
+    if (isFormatted)
+    {
+        armTimer ();
+    }
+
+    return;
+}
+
+void htmlserverExit (void)
+{
+    int             i;
+
+    if (! serverIsRunning)
+    {
+        return;
+    }
+
+    for (i = 0; i < HTML_SERVER_MAX_CLIENTS; i ++)
+    {
+        if (server.clients[i].fd != -1)
+        {
+            closeClient (&server.clients[i]);
+        }
+    }
+
+    radProcessIODeRegisterDescriptorByFd (server.listenFd);
+    close (server.listenFd);
+    radTimerDelete (server.timer);
+    htmlbufferFree (&server.event);
+    htmlbufferSetFileCaching (FALSE);
+    serverIsRunning = FALSE;
+    return;
+}
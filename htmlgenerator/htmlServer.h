@@ -0,0 +1,90 @@
+#ifndef INC_htmlserverh
+#define INC_htmlserverh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        htmlServer.h
+
+  PURPOSE:
+        Provide the wview html generator embedded HTTP server definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        If HTMLGEN_HTTP_PORT is not 0 htmlgend also serves the image path
+        over HTTP/1.1 on that port, so a small installation needs no other
+        web server. It is driven from the radProcess loop like everything
+        else in htmlgend: the listening socket and the client sockets are
+        registered with radProcessIORegisterDescriptor and replies which do
+        not fit the socket buffer are finished from a process timer which
+        polls for output.
+
+        Files come from the htmlBuffer file cache, which holds the latest
+        generated pages and images as they are written, so nothing is read
+        back from disk. Each reply carries an ETag built from the contents
+        and If-None-Match is answered with 304. Text files larger than
+        HTML_SERVER_GZIP_MIN are sent gzip compressed to clients which
+        accept it, compressing once per content change.
+
+        GET HTML_SERVER_EVENTS_PATH opens a Server-Sent Events stream; each
+        LOOP packet wviewd broadcasts is pushed as one "loop" event holding
+        the "loop" object of the live data document (see htmlData.h):
+
+            event: loop
+            data: {"barometer":29.921,"outTemp":71.3, ... }
+
+        Try it with:
+            curl -v --compressed http://localhost:<port>/index.htm
+            curl -N http://localhost:<port>/events
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radtimers.h>
+
+/*  ... Local include files
+*/
+#include <datadefs.h>
+#include <htmlBuffer.h>
+
+
+/*  ... API definitions
+*/
+#define HTML_SERVER_MAX_CLIENTS     32
+#define HTML_SERVER_REQUEST_MAX     8192            // bytes of request headers
+#define HTML_SERVER_OUTPUT_MAX      (1024 * 1024)   // queued for one client
+#define HTML_SERVER_POLL_MS         50              // while output is queued
+#define HTML_SERVER_IDLE_CHECK_MS   5000
+#define HTML_SERVER_IDLE_TIMEOUT    60              // seconds, keep-alive
+#define HTML_SERVER_GZIP_MIN        512             // bytes
+#define HTML_SERVER_INDEX_FILE      "index.htm"
+#define HTML_SERVER_EVENTS_PATH     "/events"
+#define HTML_SERVER_NAME            "wview-htmlgend"
+
+
+/* ... function prototypes
+*/
+
+//  ... start serving 'rootPath' on 'port'; returns OK or ERROR
+extern int htmlserverInit (int port, char *rootPath);
+
+//  ... push 'loop' to the event stream clients
+extern void htmlserverPushLoop (LOOP_PKT *loop);
+
+//  ... close all connections and the listening socket
+extern void htmlserverExit (void);
+
+#endif
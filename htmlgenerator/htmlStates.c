@@ -10,6 +10,12 @@
         Date            Engineer        Revision        Remarks
         08/30/03        M.S. Teel       0               Original
         12/01/2009      M. Hornsby      1               Moon Rise and Set
+        10/19/2026      M.S. Teel       2               Coalesced archive generation
+        10/19/2026      M.S. Teel       3               Live data documents
+        10/19/2026      M.S. Teel       4               Sun and moon times from the
+                                                        htmlAstro table
+        10/19/2026      M.S. Teel       5               Keep the burst wait across
+                                                        a data request
  
   NOTES:
         
@@ -50,10 +56,8 @@ static void processNewArchiveRecord (HTML_WORK *work, WVIEW_MSG_ARCHIVE_NOTIFY *
     HISTORY_DATA        data;
     ARCHIVE_PKT         arcRecord;
     int                 currHour, currDay, currMonth, currYear;
-    float               gmtOffsetHours;
     int                 startmin, starthour, startday, startmonth, startyear;
     int                 i, DSTFlag;
-    short               tempShort;
     time_t              ntime, baseTime;
     struct tm           locTime;
     int                 deltaArchiveIntervals;
@@ -67,52 +71,11 @@ static void processNewArchiveRecord (HTML_WORK *work, WVIEW_MSG_ARCHIVE_NOTIFY *
     {
         radMsgLog (PRI_STATUS, "DST change: updating astronomical times for new local time...");
 
-        ntime = time (NULL);
-        localtime_r (&ntime, &locTime);
-        currDay     = locTime.tm_mday;
-        currMonth   = locTime.tm_mon + 1;
-        currYear    = locTime.tm_year + 1900;
-
-        gmtOffsetHours = locTime.tm_gmtoff/(60.0*60.0);
-
-        //  ... update the sun times:
-        sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                               (float)work->mgrId->stationLatitude/10,
-                               (float)work->mgrId->stationLongitude/10,
-                               RS_TYPE_SUN,
-                               &work->mgrId->sunrise,
-                               &work->mgrId->sunset);
-        sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                               (float)work->mgrId->stationLatitude/10,
-                               (float)work->mgrId->stationLongitude/10,
-                               RS_TYPE_CIVIL,
-                               &work->mgrId->civilrise,
-                               &work->mgrId->civilset);
-        sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                               (float)work->mgrId->stationLatitude/10,
-                               (float)work->mgrId->stationLongitude/10,
-                               RS_TYPE_ASTRO,
-                               &work->mgrId->astrorise,
-                               &work->mgrId->astroset);
-        sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                               (float)work->mgrId->stationLatitude/10,
-                               (float)work->mgrId->stationLongitude/10,
-                               RS_TYPE_MIDDAY,
-                               &work->mgrId->midday,
-                               &tempShort);
-        work->mgrId->dayLength = 
-                sunTimesGetDayLength (currYear, currMonth, currDay,
-                                      (float)work->mgrId->stationLatitude/10,
-                                      (float)work->mgrId->stationLongitude/10);
-
-        GetMoonRiseSetTimes (currYear, currMonth, currDay,
-                             (float)gmtOffsetHours,
-                             (float)work->mgrId->stationLatitude/10,
-                             (float)work->mgrId->stationLongitude/10,
-                             &work->mgrId->moonrise,
-                             NULL,
-                             &work->mgrId->moonset,
-                             NULL);
+        //  ... the table is rebuilt for the new UTC offset:
+        if (htmlastroUpdate (work->mgrId) == ERROR)
+        {
+            radMsgLog (PRI_MEDIUM, "DST change: htmlastroUpdate failed!");
+        }
 
         // restart the generation timer as the change may leave it in limbo
         radProcessTimerStart (work->timer, 5000L);
@@ -256,7 +219,6 @@ static void processNewArchiveRecord (HTML_WORK *work, WVIEW_MSG_ARCHIVE_NOTIFY *
         locTime.tm_mon   = currMonth - 1;
         locTime.tm_year  = currYear - 1900;
         locTime.tm_isdst = -1;
-		gmtOffsetHours = locTime.tm_gmtoff/(60.0*60.0);
 
         ntime = mktime (&locTime);
         ntime -= WV_SECONDS_IN_DAY;
@@ -296,43 +258,10 @@ static void processNewArchiveRecord (HTML_WORK *work, WVIEW_MSG_ARCHIVE_NOTIFY *
         radProcessTimerStart(work->noaaTimer, HTML_NOAA_UPDATE_DELAY);
 
         //  ... update the sun times
-        sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                               (float)work->mgrId->stationLatitude/10,
-                               (float)work->mgrId->stationLongitude/10,
-                               RS_TYPE_SUN,
-                               &work->mgrId->sunrise,
-                               &work->mgrId->sunset);
-        sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                               (float)work->mgrId->stationLatitude/10,
-                               (float)work->mgrId->stationLongitude/10,
-                               RS_TYPE_CIVIL,
-                               &work->mgrId->civilrise,
-                               &work->mgrId->civilset);
-        sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                               (float)work->mgrId->stationLatitude/10,
-                               (float)work->mgrId->stationLongitude/10,
-                               RS_TYPE_ASTRO,
-                               &work->mgrId->astrorise,
-                               &work->mgrId->astroset);
-        sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                               (float)work->mgrId->stationLatitude/10,
-                               (float)work->mgrId->stationLongitude/10,
-                               RS_TYPE_MIDDAY,
-                               &work->mgrId->midday,
-                               &tempShort);
-        work->mgrId->dayLength = 
-                sunTimesGetDayLength (currYear, currMonth, currDay,
-                                      (float)work->mgrId->stationLatitude/10,
-                                      (float)work->mgrId->stationLongitude/10);
-
-        GetMoonRiseSetTimes (currYear, currMonth, currDay,
-                             (float)gmtOffsetHours,
-                             (float)work->mgrId->stationLatitude/10,
-                             (float)work->mgrId->stationLongitude/10,
-                             &work->mgrId->moonrise,
-                             NULL,
-                             &work->mgrId->moonset,
-                             NULL);
+        if (htmlastroUpdate (work->mgrId) == ERROR)
+        {
+            radMsgLog (PRI_MEDIUM, "htmlastroUpdate failed!");
+        }
 
     }
 
@@ -362,6 +291,23 @@ static int requestDataPackets (HTML_WORK *work)
 
 
 
+// generate with the data just received; a record or burst end seen while
+// waiting for it restarts the burst wait as htmlRunState would have
+static int generateHtml (HTML_WORK *work)
+{
+    radProcessTimerStop(work->rxTimer);
+    htmlmgrGenerate (work->mgrId, work->isPeriodic);
+
+    if (work->isCoalescePending)
+    {
+        work->isCoalescePending = FALSE;
+        radProcessTimerStop(work->coalesceTimer);
+        radProcessTimerStart(work->coalesceTimer, HTML_COALESCE_DELAY);
+    }
+
+    return HTML_STATE_RUN;
+}
+
 int htmlIdleState (int state, void *stimulus, void *data)
 {
     STIM                *stim = (STIM *)stimulus;
@@ -402,18 +348,8 @@ int htmlStationInfoState (int state, void *stimulus, void *data)
     struct tm                   locTime;
     long                        offset, msOffset;
     long                        oldSecs, newSecs;
-    int                         currDay, currMonth, currYear;
-    float                       gmtOffsetHours;
-    short                       tempShort;
     FILE*                       indicateFile;
 
-    ntime = time (NULL);
-    localtime_r (&ntime, &locTime);
-    currDay     = locTime.tm_mday;
-    currMonth   = locTime.tm_mon + 1;
-    currYear    = locTime.tm_year + 1900;
-    gmtOffsetHours = locTime.tm_gmtoff/(60.0*60.0);
-
     switch (stim->type)
     {
     case STIM_QMSG:
@@ -475,45 +411,16 @@ int htmlStationInfoState (int state, void *stimulus, void *data)
             wvstrncpy (work->mgrId->stationType,
                        msg->stationType,
                        sizeof(work->mgrId->stationType));
+            work->mgrId->dataFormats = work->dataFormats;
 
-            //  ... initialize the sun times now
-            sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                                   (float)work->mgrId->stationLatitude/10,
-                                   (float)work->mgrId->stationLongitude/10,
-                                   RS_TYPE_SUN,
-                                   &work->mgrId->sunrise,
-                                   &work->mgrId->sunset);
-            sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                                   (float)work->mgrId->stationLatitude/10,
-                                   (float)work->mgrId->stationLongitude/10,
-                                   RS_TYPE_CIVIL,
-                                   &work->mgrId->civilrise,
-                                   &work->mgrId->civilset);
-            sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                                   (float)work->mgrId->stationLatitude/10,
-                                   (float)work->mgrId->stationLongitude/10,
-                                   RS_TYPE_ASTRO,
-                                   &work->mgrId->astrorise,
-                                   &work->mgrId->astroset);
-            sunTimesGetSunRiseSet (currYear, currMonth, currDay,
-                                   (float)work->mgrId->stationLatitude/10,
-                                   (float)work->mgrId->stationLongitude/10,
-                                   RS_TYPE_MIDDAY,
-                                   &work->mgrId->midday,
-                                   &tempShort);
-            work->mgrId->dayLength = 
-                    sunTimesGetDayLength (currYear, currMonth, currDay,
-                                          (float)work->mgrId->stationLatitude/10,
-                                          (float)work->mgrId->stationLongitude/10);
-
-            GetMoonRiseSetTimes (currYear, currMonth, currDay,
-                                 (float)gmtOffsetHours,
-                                 (float)work->mgrId->stationLatitude/10,
-                                 (float)work->mgrId->stationLongitude/10,
-                                 &work->mgrId->moonrise,
-                                 NULL,
-                                 &work->mgrId->moonset,
-                                 NULL);
+            //  ... build the sun and moon table and initialize the sun times now
+            if (htmlastroUpdate (work->mgrId) == ERROR)
+            {
+                radMsgLog (PRI_HIGH, "htmlastroUpdate failed!");
+                statusUpdateMessage("htmlastroUpdate failed!");
+                statusUpdate(STATUS_ERROR);
+                return HTML_STATE_ERROR;
+            }
 
 
 
@@ -662,6 +569,7 @@ int htmlStationInfoState (int state, void *stimulus, void *data)
             // for the first generation
             radMsgLog (PRI_STATUS, "doing initial html generation now...");
             work->numDataReceived = 0;
+            work->isPeriodic = TRUE;
 
             statusUpdate(STATUS_RUNNING);
             statusUpdateMessage("Normal operation");
@@ -711,13 +619,18 @@ int htmlRunState (int state, void *stimulus, void *data)
             else if (stim->msgType == WVIEW_MSG_TYPE_ARCHIVE_NOTIFY)
             {
                 processNewArchiveRecord (work, arcNot);
+
+                //  ... generate once the burst of records (if any) is over
+                radProcessTimerStop(work->coalesceTimer);
+                radProcessTimerStart(work->coalesceTimer, HTML_COALESCE_DELAY);
                 return state;
             }
 
         break;
 
         case STIM_TIMER:
-            if (stim->timerNumber == TIMER_GENERATE)
+            if (stim->timerNumber == TIMER_GENERATE ||
+                stim->timerNumber == TIMER_COALESCE)
             {
                 //  ... request the next batch of data
                 if (requestDataPackets (work) == ERROR)
@@ -728,8 +641,11 @@ int htmlRunState (int state, void *stimulus, void *data)
                     return HTML_STATE_ERROR;
                 }
     
+                radProcessTimerStop(work->coalesceTimer);
                 radProcessTimerStart(work->rxTimer, HTML_RX_PACKETS_TIMEOUT);
                 work->numDataReceived = 0;
+                work->isPeriodic = (stim->timerNumber == TIMER_GENERATE);
+                work->isCoalescePending = FALSE;
     
                 return HTML_STATE_DATA;
             }
@@ -758,10 +674,7 @@ int htmlDataState (int state, void *stimulus, void *data)
                 if (++ work->numDataReceived == 2)
                 {
                     // we've got the data, generate some html
-                    radProcessTimerStop(work->rxTimer);
-                    htmlmgrGenerate (work->mgrId);
-    
-                    return HTML_STATE_RUN;
+                    return generateHtml (work);
                 }
             }
             else if (stim->msgType == WVIEW_MSG_TYPE_HILOW_DATA)
@@ -770,22 +683,34 @@ int htmlDataState (int state, void *stimulus, void *data)
                 if (++ work->numDataReceived == 2)
                 {
                     // we've got the data, generate some html
-                    radProcessTimerStop(work->rxTimer);
-                    htmlmgrGenerate (work->mgrId);
-    
-                    return HTML_STATE_RUN;
+                    return generateHtml (work);
                 }
             }
             else if (stim->msgType == WVIEW_MSG_TYPE_ARCHIVE_NOTIFY)
             {
                 processNewArchiveRecord (work, arcNot);
+
+                //  ... the burst may go on past this generation
+                work->isCoalescePending = TRUE;
                 return state;
             }
     
             return state;
 
         case STIM_TIMER:
-            if (stim->timerNumber == TIMER_RX_PACKETS)
+            if (stim->timerNumber == TIMER_GENERATE)
+            {
+                // the generation in progress will do
+                work->isPeriodic = TRUE;
+                return state;
+            }
+            else if (stim->timerNumber == TIMER_COALESCE)
+            {
+                // a burst ended since the data request, see generateHtml
+                work->isCoalescePending = TRUE;
+                return state;
+            }
+            else if (stim->timerNumber == TIMER_RX_PACKETS)
             {
                 // We have timed out waiting for pkts from wviewd -
                 // Raise a stink:
@@ -9,6 +9,9 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         01/20/04        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Ring buffer history
+        10/19/2026      M.S. Teel       2               Table-driven charts
+        10/19/2026      M.S. Teel       3               Generator inputs
  
   NOTES:
         
@@ -493,11 +496,11 @@ static int generateWind (HTML_IMG *img)
     return retVal;
 }
 
-static int generateTempDay (HTML_IMG *img)
+static int generateWDirDay (HTML_IMG *img)
 {
     int         i, j;
     char        temp[256];
-            
+
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
     {
         // nothing for us here
@@ -515,24 +518,20 @@ static int generateTempDay (HTML_IMG *img)
     }
     labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_outTemp],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    return (htmlGenPngWDIRChart (temp,
+                         img->mgrWork->isMetricUnits,
+                         DAY_VALUES(img->mgrWork, DATA_INDEX_windDir),
+                         6,
+                         labels,
+                         DAILY_NUM_VALUES(img->mgrWork),
+                         DAILY_NUM_VALUES(img->mgrWork),
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat));
 }
 
-static int generateTempWeek (HTML_IMG *img)
+static int generateWDirWeek (HTML_IMG *img)
 {
     int         i, skipNo;
     char        lbls[WEEKLY_NUM_VALUES][8];
@@ -580,24 +579,20 @@ static int generateTempWeek (HTML_IMG *img)
         ntime += WV_SECONDS_IN_HOUR;
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->weekValues[DATA_INDEX_outTemp][skipNo],
-                     7,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     WEEKLY_NUM_VALUES-skipNo,
-                     WEEKLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    return (htmlGenPngWDIRChart (temp,
+                         img->mgrWork->isMetricUnits,
+                         &WEEK_VALUES(img->mgrWork, DATA_INDEX_windDir)[skipNo],
+                         7,
+                         labels,
+                         WEEKLY_NUM_VALUES-skipNo,
+                         WEEKLY_NUM_VALUES,
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat));
 }
 
-static int generateTempMonth (HTML_IMG *img)
+static int generateWDirMonth (HTML_IMG *img)
 {
     int         i, skipNo;
     char        lbls[MONTHLY_NUM_VALUES][8];
@@ -645,24 +640,20 @@ static int generateTempMonth (HTML_IMG *img)
         ntime += WV_SECONDS_IN_HOUR;
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->monthValues[DATA_INDEX_outTemp][skipNo],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES-skipNo,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    return (htmlGenPngWDIRChart (temp,
+                         img->mgrWork->isMetricUnits,
+                         &MONTH_VALUES(img->mgrWork, DATA_INDEX_windDir)[skipNo],
+                         14,
+                         labels,
+                         MONTHLY_NUM_VALUES-skipNo,
+                         MONTHLY_NUM_VALUES,
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat));
 }
 
-static int generateTempYear (HTML_IMG *img)
+static int generateWDirYear (HTML_IMG *img)
 {
     int         i;
     char        lbls[YEARLY_NUM_VALUES][8];
@@ -687,24 +678,20 @@ static int generateTempYear (HTML_IMG *img)
         ntime += WV_SECONDS_IN_DAY;
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_outTemp],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    return (htmlGenPngWDIRChart (temp,
+                         img->mgrWork->isMetricUnits,
+                         YEAR_VALUES(img->mgrWork, DATA_INDEX_windDir),
+                         4,
+                         labels,
+                         YEARLY_NUM_VALUES,
+                         YEARLY_NUM_VALUES,
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat));
 }
 
-static int generateHumidDay (HTML_IMG *img)
+static int generateBaromDay (HTML_IMG *img)
 {
     int         i, j;
     char        temp[256];
@@ -726,20 +713,47 @@ static int generateHumidDay (HTML_IMG *img)
     }
     labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
 
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            img->mgrWork->dayValues[DATA_INDEX_outHumidity],
-                            6,
-                            labels,
-                            DAILY_NUM_VALUES(img->mgrWork),
-                            DAILY_NUM_VALUES(img->mgrWork),
-                            img->title,
-                            img->mgrWork->dateFormat));
+    if (img->mgrWork->isMetricUnits)
+    {
+        return (htmlGenPngChart (temp,
+                         1,
+                         DAY_VALUES(img->mgrWork, DATA_INDEX_barometer),
+                         6,
+                         1000.0,
+                         1039.9,
+                         10.0,
+                         labels,
+                         DAILY_NUM_VALUES(img->mgrWork),
+                         DAILY_NUM_VALUES(img->mgrWork),
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat,
+                         img->mgrWork->isDualUnits));
+    }
+    else
+    {
+        return (htmlGenPngChart (temp,
+                         0,
+                         DAY_VALUES(img->mgrWork, DATA_INDEX_barometer),
+                         6,
+                         29.7,
+                         30.3,
+                         0.1,
+                         labels,
+                         DAILY_NUM_VALUES(img->mgrWork),
+                         DAILY_NUM_VALUES(img->mgrWork),
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat,
+                         img->mgrWork->isDualUnits));
+    }
 }
 
-static int generateHumidWeek (HTML_IMG *img)
+static int generateBaromWeek (HTML_IMG *img)
 {
-    int         i,skipNo;
+    int         i, skipNo;
     char        lbls[WEEKLY_NUM_VALUES][8];
     char        temp[256];
     time_t      ntime = img->mgrWork->weekStartTime_T;
@@ -785,18 +799,45 @@ static int generateHumidWeek (HTML_IMG *img)
         ntime += WV_SECONDS_IN_HOUR;
     }
 
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            &img->mgrWork->weekValues[DATA_INDEX_outHumidity][skipNo],
-                            7,
-                            labels,
-                            WEEKLY_NUM_VALUES-skipNo,
-                            WEEKLY_NUM_VALUES,
-                            img->title,
-                            img->mgrWork->dateFormat));
+    if (img->mgrWork->isMetricUnits)
+    {
+        return (htmlGenPngChart (temp,
+                         1,
+                         &WEEK_VALUES(img->mgrWork, DATA_INDEX_barometer)[skipNo],
+                         7,
+                         1000.0,
+                         1039.9,
+                         10.0,
+                         labels,
+                         WEEKLY_NUM_VALUES-skipNo,
+                         WEEKLY_NUM_VALUES,
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat,
+                         img->mgrWork->isDualUnits));
+    }
+    else
+    {
+        return (htmlGenPngChart (temp,
+                         0,
+                         WEEK_VALUES(img->mgrWork, DATA_INDEX_barometer),
+                         7,
+                         29.7,
+                         30.3,
+                         0.1,
+                         labels,
+                         WEEKLY_NUM_VALUES-skipNo,
+                         WEEKLY_NUM_VALUES,
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat,
+                         img->mgrWork->isDualUnits));
+    }
 }
 
-static int generateHumidMonth (HTML_IMG *img)
+static int generateBaromMonth (HTML_IMG *img)
 {
     int         i, skipNo;
     char        lbls[MONTHLY_NUM_VALUES][8];
@@ -844,18 +885,45 @@ static int generateHumidMonth (HTML_IMG *img)
         ntime += WV_SECONDS_IN_HOUR;
     }
 
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            &img->mgrWork->monthValues[DATA_INDEX_outHumidity][skipNo],
-                            14,
-                            labels,
-                            MONTHLY_NUM_VALUES-skipNo,
-                            MONTHLY_NUM_VALUES,
-                            img->title,
-                            img->mgrWork->dateFormat));
+    if (img->mgrWork->isMetricUnits)
+    {
+        return (htmlGenPngChart (temp,
+                         1,
+                         &MONTH_VALUES(img->mgrWork, DATA_INDEX_barometer)[skipNo],
+                         14,
+                         1000.0,
+                         1039.9,
+                         10.0,
+                         labels,
+                         MONTHLY_NUM_VALUES-skipNo,
+                         MONTHLY_NUM_VALUES,
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat,
+                         img->mgrWork->isDualUnits));
+    }
+    else
+    {
+        return (htmlGenPngChart (temp,
+                         0,
+                         &MONTH_VALUES(img->mgrWork, DATA_INDEX_barometer)[skipNo],
+                         14,
+                         29.7,
+                         30.3,
+                         0.1,
+                         labels,
+                         MONTHLY_NUM_VALUES-skipNo,
+                         MONTHLY_NUM_VALUES,
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat,
+                         img->mgrWork->isDualUnits));
+    }
 }
 
-static int generateHumidYear (HTML_IMG *img)
+static int generateBaromYear (HTML_IMG *img)
 {
     int         i;
     char        lbls[YEARLY_NUM_VALUES][8];
@@ -870,7 +938,6 @@ static int generateHumidYear (HTML_IMG *img)
     }
     
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
     ntime += 4*WV_SECONDS_IN_HOUR;
     for (i = 0; i < YEARLY_NUM_VALUES; i ++)
     {
@@ -880,21 +947,50 @@ static int generateHumidYear (HTML_IMG *img)
         ntime += WV_SECONDS_IN_DAY;
     }
 
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            img->mgrWork->yearValues[DATA_INDEX_outHumidity],
-                            4,
-                            labels,
-                            YEARLY_NUM_VALUES,
-                            YEARLY_NUM_VALUES,
-                            img->title,
-                            img->mgrWork->dateFormat));
+    if (img->mgrWork->isMetricUnits)
+    {
+        return (htmlGenPngChart (temp,
+                         1,
+                         YEAR_VALUES(img->mgrWork, DATA_INDEX_barometer),
+                         4,
+                         1000.0,
+                         1039.9,
+                         10.0,
+                         labels,
+                         YEARLY_NUM_VALUES,
+                         YEARLY_NUM_VALUES,
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat,
+                         img->mgrWork->isDualUnits));
+    }
+    else
+    {
+        return (htmlGenPngChart (temp,
+                         0,
+                         YEAR_VALUES(img->mgrWork, DATA_INDEX_barometer),
+                         4,
+                         29.7,
+                         30.3,
+                         0.1,
+                         labels,
+                         YEARLY_NUM_VALUES,
+                         YEARLY_NUM_VALUES,
+                         img->title,
+                         img->units,
+                         img->decimalPlaces,
+                         img->mgrWork->dateFormat,
+                         img->mgrWork->isDualUnits));
+    }
 }
 
-static int generateDewDay (HTML_IMG *img)
+static int generateRainDay (HTML_IMG *img)
 {
-    int         i, j;
+    int         i, j, skipNo = 0;
+    int         samplesInHour = (60/img->mgrWork->archiveInterval);
     char        temp[256];
+    float       max = 0;
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
     {
@@ -904,39 +1000,55 @@ static int generateDewDay (HTML_IMG *img)
     
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
+    j = img->mgrWork->dayStart;
+    while ((j % samplesInHour) != 0)
     {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
+        skipNo ++;
+        if (++ j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
             j = 0;
-
-        labels[i] = sampleLabels[j];
     }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_dewpoint],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork)-skipNo; i ++)
+    {
+        labels[i] = sampleHourLabels[j];
+
+        if (DAY_VALUES(img->mgrWork, DATA_INDEX_rain)[i+skipNo] > max)
+            max = DAY_VALUES(img->mgrWork, DATA_INDEX_rain)[i+skipNo];
+
+        if (++ j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
+            j = 0;
+    }
+    
+    // tack on the extra label
+    labels[(DAILY_NUM_VALUES(img->mgrWork)-skipNo)] = sampleHourLabels[(DAILY_NUM_VALUES(img->mgrWork)-1)];
+    
+    return (htmlGenPngBarChart (temp,
+                        img->mgrWork->isMetricUnits,
+                        &DAY_VALUES(img->mgrWork, DATA_INDEX_rain)[skipNo+1],
+                        6,
+                        0,
+                        MAX(0.1,max),
+                        0.01,
+                        labels,
+                        DAILY_NUM_VALUES(img->mgrWork)-skipNo,
+                        img->title,
+                        img->units,
+                        img->decimalPlaces,
+                        60/img->mgrWork->archiveInterval,
+                        24,
+                        60/img->mgrWork->archiveInterval,
+                        img->mgrWork->dateFormat,
+                        img->mgrWork->isDualUnits));
 }
 
-static int generateDewWeek (HTML_IMG *img)
+static int generateRainWeek (HTML_IMG *img)
 {
     int         i, skipNo;
     char        lbls[WEEKLY_NUM_VALUES][8];
     char        temp[256];
     time_t      ntime = img->mgrWork->weekStartTime_T;
     struct tm   loctime;
+    float       max = 0;
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
@@ -960,48 +1072,63 @@ static int generateDewWeek (HTML_IMG *img)
         }
     }
 
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
+    // kludge this for aggregate values
+    if (skipNo == 0)
     {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
+        // push forward one day
+        skipNo = 24;
+        ntime += WV_SECONDS_IN_DAY;
+    }
+
+    for (i = 0; i < WEEKLY_NUM_VALUES-skipNo; i ++)
+    {
+        localtime_r (&ntime, &loctime);
         sprintf (lbls[i], "%d", loctime.tm_mday);
         labels[i] = lbls[i];
 
         ntime += WV_SECONDS_IN_HOUR;
+
+        if (WEEK_VALUES(img->mgrWork, DATA_INDEX_rain)[i+skipNo] > max)
+            max = WEEK_VALUES(img->mgrWork, DATA_INDEX_rain)[i+skipNo];
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->weekValues[DATA_INDEX_dewpoint][skipNo],
-                     7,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     WEEKLY_NUM_VALUES-skipNo,
-                     WEEKLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    // tack on the extra label
+    if (skipNo > 1)
+    {
+        ntime += WV_SECONDS_IN_DAY;
+    }
+
+    localtime_r (&ntime, &loctime);
+    sprintf (lbls[WEEKLY_NUM_VALUES-skipNo], "%d", loctime.tm_mday);
+    labels[WEEKLY_NUM_VALUES-skipNo] = lbls[WEEKLY_NUM_VALUES-skipNo];
+
+    return (htmlGenPngBarChart (temp,
+                        img->mgrWork->isMetricUnits,
+                        &WEEK_VALUES(img->mgrWork, DATA_INDEX_rain)[skipNo],
+                        7,
+                        0,
+                        MAX(0.1,max),
+                        0.1,
+                        labels,
+                        WEEKLY_NUM_VALUES-skipNo,
+                        img->title,
+                        img->units,
+                        img->decimalPlaces,
+                        24,
+                        7,
+                        24,
+                        img->mgrWork->dateFormat,
+                        img->mgrWork->isDualUnits));
 }
 
-static int generateDewMonth (HTML_IMG *img)
+static int generateRainMonth (HTML_IMG *img)
 {
     int         i, skipNo;
     char        lbls[MONTHLY_NUM_VALUES][8];
     char        temp[256];
     time_t      ntime = img->mgrWork->monthStartTime_T;
     struct tm   loctime;
+    float       max = 0;
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
@@ -1025,48 +1152,62 @@ static int generateDewMonth (HTML_IMG *img)
         }
     }
 
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
+    // kludge this for aggregate values
+    if (skipNo == 0)
+    {
+        // push forward one day
+        skipNo = 24;
+        ntime += WV_SECONDS_IN_DAY;
+    }
+
+    for (i = 0; i < MONTHLY_NUM_VALUES-skipNo; i ++)
     {
         localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
         sprintf (lbls[i], "%d", loctime.tm_mday);
         labels[i] = lbls[i];
 
         ntime += WV_SECONDS_IN_HOUR;
+        if (MONTH_VALUES(img->mgrWork, DATA_INDEX_rain)[i+skipNo] > max)
+            max = MONTH_VALUES(img->mgrWork, DATA_INDEX_rain)[i+skipNo];
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->monthValues[DATA_INDEX_dewpoint][skipNo],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES-skipNo,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    // tack on the extra label
+    if (skipNo > 1)
+    {
+        ntime += WV_SECONDS_IN_DAY;
+    }
+
+    localtime_r (&ntime, &loctime);
+    sprintf (lbls[MONTHLY_NUM_VALUES-skipNo], "%d", loctime.tm_mday);
+    labels[MONTHLY_NUM_VALUES-skipNo] = lbls[MONTHLY_NUM_VALUES-skipNo];
+
+    return (htmlGenPngBarChart (temp,
+                        img->mgrWork->isMetricUnits,
+                        &MONTH_VALUES(img->mgrWork, DATA_INDEX_rain)[skipNo],
+                        14,
+                        0,
+                        MAX(0.1,max),
+                        0.1,
+                        labels,
+                        MONTHLY_NUM_VALUES-skipNo,
+                        img->title,
+                        img->units,
+                        img->decimalPlaces,
+                        24,
+                        28,
+                        24,
+                        img->mgrWork->dateFormat,
+                        img->mgrWork->isDualUnits));
 }
 
-static int generateDewYear (HTML_IMG *img)
+static int generateRainYear (HTML_IMG *img)
 {
-    int         i;
+    int         i, j, skipNo;
     char        lbls[YEARLY_NUM_VALUES][8];
     char        temp[256];
     time_t      ntime = img->mgrWork->yearStartTime_T;
     struct tm   loctime;
+    float       max = 0;
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
     {
@@ -1076,36 +1217,116 @@ static int generateDewYear (HTML_IMG *img)
     
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
+    // move forward 1 day to land on 52 weeks ago
+    ntime += WV_SECONDS_IN_DAY;
+    skipNo = 1;
+    
+    // if we are sitting on Sunday, bump it another day
+    localtime_r (&ntime, &loctime);
+    if (loctime.tm_wday == 0)
+    {
+        ntime += WV_SECONDS_IN_DAY;
+        skipNo ++;
+    }
+    
+    // move to the next Sunday
+    for (i = 0; i < 7; i ++)
+    {
+        localtime_r (&ntime, &loctime);
+        if (loctime.tm_wday == 0)
+        {
+            break;
+        }
+        else
+        {
+            skipNo ++;
+            ntime += WV_SECONDS_IN_DAY;
+        }
+    }
+
+    for (i = 0; i < YEARLY_NUM_VALUES-skipNo; i ++)
     {
         localtime_r (&ntime, &loctime);
         sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
         labels[i] = lbls[i];
+
         ntime += WV_SECONDS_IN_DAY;
+        if (YEAR_VALUES(img->mgrWork, DATA_INDEX_rain)[i+skipNo] > max)
+            max = YEAR_VALUES(img->mgrWork, DATA_INDEX_rain)[i+skipNo];
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_dewpoint],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    for (j = 0; j < 7; j ++)
+    {
+        localtime_r (&ntime, &loctime);
+        if (loctime.tm_wday == 0)
+        {
+            break;
+        }
+        else
+        {
+            ntime += WV_SECONDS_IN_DAY;
+        }
+    }
+
+    localtime_r (&ntime, &loctime);
+    sprintf (lbls[YEARLY_NUM_VALUES-skipNo], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
+    labels[YEARLY_NUM_VALUES-skipNo] = lbls[YEARLY_NUM_VALUES-skipNo];
+
+    return (htmlGenPngBarChart (temp,
+                        img->mgrWork->isMetricUnits,
+                        &YEAR_VALUES(img->mgrWork, DATA_INDEX_rain)[skipNo],
+                        4,
+                        0,
+                        MAX(0.1,max),
+                        0.1,
+                        labels,
+                        YEARLY_NUM_VALUES-skipNo,
+                        img->title,
+                        img->units,
+                        img->decimalPlaces,
+                        7,
+                        52,
+                        7,
+                        img->mgrWork->dateFormat,
+                        img->mgrWork->isDualUnits));
+}
+
+////////////////////////////////////////////////////////////////////////////
+//  Composite Charts
+
+// utility to determine max of 4 values
+static void setMax(float *maxStore, float v1, float v2, float v3, float v4)
+{
+    if (v1 > *maxStore)
+        *maxStore = v1;
+    if (v2 > *maxStore)
+        *maxStore = v2;
+    if (v3 > *maxStore)
+        *maxStore = v3;
+    if (v4 > *maxStore)
+        *maxStore = v4;
+}
+
+// utility to determine min of 4 values
+static void setMin(float *minStore, float v1, float v2, float v3, float v4)
+{
+    if (v1 < *minStore)
+        *minStore = v1;
+    if (v2 < *minStore)
+        *minStore = v2;
+    if (v3 < *minStore)
+        *minStore = v3;
+    if (v4 < *minStore)
+        *minStore = v4;
 }
 
-static int generateWSpeedDay (HTML_IMG *img)
+
+static int generateCompositeTempDay (HTML_IMG *img)
 {
     int         i, j;
     char        temp[256];
+    MC_DATASET  datasets[2];
+    float       min = 10000.0, max = -10000.0;
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
     {
@@ -1123,98 +1344,82 @@ static int generateWSpeedDay (HTML_IMG *img)
         labels[i] = sampleLabels[j];
     }
     labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_windSpeed],
-                     6,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateWSpeedWeek (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[WEEKLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
+    
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
+    
+    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
+    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
     {
-        // nothing for us here
-        return ERROR_ABORT;
+        if (img->title[i] == '/')
+            break;
+    
+        datasets[0].legend[i] = img->title[i];
+    }
+    if (i < strlen (img->title) - 1)
+    {
+        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
     }
     
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
+    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork); i ++)
     {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
+        datasets[0].valueset[i] = DAY_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i];
+        datasets[1].valueset[i] = DAY_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i];
+
+        if (DAY_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i] <= ARCHIVE_VALUE_NULL ||
+            DAY_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i] <= ARCHIVE_VALUE_NULL ||
+            DAY_VALUES(img->mgrWork, DATA_INDEX_windchill)[i] <= ARCHIVE_VALUE_NULL ||
+            DAY_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i] <= ARCHIVE_VALUE_NULL)
         {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
+            continue;
         }
+                
+        setMin (&min, 
+                DAY_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
+                
+        setMax (&max, 
+                DAY_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
     }
 
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
+    // if there is no data yet, pick default min/max
+    if (min > max)
     {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
+        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
+        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->weekValues[DATA_INDEX_windSpeed][skipNo],
-                     7,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     WEEKLY_NUM_VALUES-skipNo,
-                     WEEKLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          6,
+                          min,
+                          max,
+                          1.0,
+                          labels,
+                          DAILY_NUM_VALUES(img->mgrWork),
+                          DAILY_NUM_VALUES(img->mgrWork),
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateWSpeedMonth (HTML_IMG *img)
+static int generateCompositeHIndexWChillDay (HTML_IMG *img)
 {
-    int         i, skipNo;
-    char        lbls[MONTHLY_NUM_VALUES][8];
+    int         i, j;
     char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
+    MC_DATASET  datasets[2];
+    float       min = 10000.0, max = -10000.0;
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
+    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
     {
         // nothing for us here
         return ERROR_ABORT;
@@ -1222,101 +1427,87 @@ static int generateWSpeedMonth (HTML_IMG *img)
     
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
+    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
     {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
+        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
+            j = 0;
 
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
+        labels[i] = sampleLabels[j];
+    }
+    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
+    
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
+    
+    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
+    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
     {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
+        if (img->title[i] == '/')
+            break;
+    
+        datasets[0].legend[i] = img->title[i];
     }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->monthValues[DATA_INDEX_windSpeed][skipNo],
-                     14,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES-skipNo,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateWSpeedYear (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
+    if (i < strlen (img->title) - 1)
     {
-        // nothing for us here
-        return ERROR_ABORT;
+        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
     }
     
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
+    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork); i ++)
+    {
+        datasets[0].valueset[i] = DAY_VALUES(img->mgrWork, DATA_INDEX_windchill)[i];
+        datasets[1].valueset[i] = DAY_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i];
+        
+        if (DAY_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i] <= ARCHIVE_VALUE_NULL ||
+            DAY_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i] <= ARCHIVE_VALUE_NULL ||
+            DAY_VALUES(img->mgrWork, DATA_INDEX_windchill)[i] <= ARCHIVE_VALUE_NULL ||
+            DAY_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i] <= ARCHIVE_VALUE_NULL)
+        {
+            continue;
+        }
+        
+        setMin (&min, 
+                DAY_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
+                
+        setMax (&max, 
+                DAY_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                DAY_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
+    }
 
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
+    // if there is no data yet, pick default min/max
+    if (min > max)
     {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
+        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
+        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_windSpeed],
-                     4,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          6,
+                          min,
+                          max,
+                          1.0,
+                          labels,
+                          DAILY_NUM_VALUES(img->mgrWork),
+                          DAILY_NUM_VALUES(img->mgrWork),
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateWDirDay (HTML_IMG *img)
+static int generateCompositeInTempHumidDay (HTML_IMG *img)
 {
     int         i, j;
     char        temp[256];
+    MC_DATASET  datasets[2];
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
     {
@@ -1334,27 +1525,56 @@ static int generateWDirDay (HTML_IMG *img)
         labels[i] = sampleLabels[j];
     }
     labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
+    
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
+    
+    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
+    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
+    {
+        if (img->title[i] == '/')
+            break;
+    
+        datasets[0].legend[i] = img->title[i];
+    }
+    if (i < strlen (img->title) - 1)
+    {
+        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
+    }
+    
+    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork); i ++)
+    {
+        datasets[0].valueset[i] = DAY_VALUES(img->mgrWork, DATA_INDEX_inTemp)[i];
+        datasets[1].valueset[i] = DAY_VALUES(img->mgrWork, DATA_INDEX_inHumidity)[i];
+    }
 
-    return (htmlGenPngWDIRChart (temp,
-                         img->mgrWork->isMetricUnits,
-                         img->mgrWork->dayValues[DATA_INDEX_windDir],
-                         6,
-                         labels,
-                         DAILY_NUM_VALUES(img->mgrWork),
-                         DAILY_NUM_VALUES(img->mgrWork),
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat));
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          6,
+                          CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
+                          CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
+                          1.0,
+                          labels,
+                          DAILY_NUM_VALUES(img->mgrWork),
+                          DAILY_NUM_VALUES(img->mgrWork),
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateWDirWeek (HTML_IMG *img)
+static int generateCompositeTempWeek (HTML_IMG *img)
 {
-    int         i, skipNo;
-    char        lbls[WEEKLY_NUM_VALUES][8];
+    int         i, j, skipNo;
     char        temp[256];
+    char        lbls[WEEKLY_NUM_VALUES][8];
     time_t      ntime = img->mgrWork->weekStartTime_T;
     struct tm   loctime;
+    float       min = 10000.0, max = -10000.0;
+    MC_DATASET  datasets[2];
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
@@ -1396,89 +1616,84 @@ static int generateWDirWeek (HTML_IMG *img)
         ntime += WV_SECONDS_IN_HOUR;
     }
 
-    return (htmlGenPngWDIRChart (temp,
-                         img->mgrWork->isMetricUnits,
-                         &img->mgrWork->weekValues[DATA_INDEX_windDir][skipNo],
-                         7,
-                         labels,
-                         WEEKLY_NUM_VALUES-skipNo,
-                         WEEKLY_NUM_VALUES,
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat));
-}
-
-static int generateWDirMonth (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
+    
+    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
+    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
     {
-        // nothing for us here
-        return ERROR_ABORT;
+        if (img->title[i] == '/')
+            break;
+    
+        datasets[0].legend[i] = img->title[i];
+    }
+    if (i < strlen (img->title) - 1)
+    {
+        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
     }
     
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
+    for (i = skipNo; i < WEEKLY_NUM_VALUES; i ++)
     {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
+        datasets[0].valueset[i-skipNo] = WEEK_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i];
+        datasets[1].valueset[i-skipNo] = WEEK_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i];
+
+        if (WEEK_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i] <= ARCHIVE_VALUE_NULL ||
+            WEEK_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i] <= ARCHIVE_VALUE_NULL ||
+            WEEK_VALUES(img->mgrWork, DATA_INDEX_windchill)[i] <= ARCHIVE_VALUE_NULL ||
+            WEEK_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i] <= ARCHIVE_VALUE_NULL)
         {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
+            continue;
         }
+        
+        setMin (&min, 
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
+                
+        setMax (&max, 
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
     }
 
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
+    // if there is no data yet, pick default min/max
+    if (min > max)
     {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
+        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
+        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
     }
 
-    return (htmlGenPngWDIRChart (temp,
-                         img->mgrWork->isMetricUnits,
-                         &img->mgrWork->monthValues[DATA_INDEX_windDir][skipNo],
-                         14,
-                         labels,
-                         MONTHLY_NUM_VALUES-skipNo,
-                         MONTHLY_NUM_VALUES,
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat));
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          7,
+                          min,
+                          max,
+                          1.0,
+                          labels,
+                          WEEKLY_NUM_VALUES-skipNo,
+                          WEEKLY_NUM_VALUES,
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateWDirYear (HTML_IMG *img)
+static int generateCompositeHIndexWChillWeek (HTML_IMG *img)
 {
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
+    int         i, j, skipNo;
     char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
+    char        lbls[WEEKLY_NUM_VALUES][8];
+    time_t      ntime = img->mgrWork->weekStartTime_T;
     struct tm   loctime;
+    float       min = 10000.0, max = -10000.0;
+    MC_DATASET  datasets[2];
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
+    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
         // nothing for us here
         return ERROR_ABORT;
@@ -1486,74 +1701,113 @@ static int generateWDirYear (HTML_IMG *img)
     
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
+    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
     {
         localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
+        if (loctime.tm_hour == 0)
+        {
+            break;
+        }
+        else
+        {
+            skipNo ++;
+            ntime += WV_SECONDS_IN_HOUR;
+        }
     }
 
-    return (htmlGenPngWDIRChart (temp,
-                         img->mgrWork->isMetricUnits,
-                         img->mgrWork->yearValues[DATA_INDEX_windDir],
-                         4,
-                         labels,
-                         YEARLY_NUM_VALUES,
-                         YEARLY_NUM_VALUES,
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat));
-}
-
-static int generateHiWSpeedDay (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
+    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
+    {
+        localtime_r (&ntime, &loctime);
+        if ((i % 24) == 0)
+        {
+            if (loctime.tm_hour != 0)
+            {
+                // DST fall back nonsense:
+                ntime += WV_SECONDS_IN_HOUR;
+                localtime_r (&ntime, &loctime);
+            }
+        }
+        sprintf (lbls[i], "%d", loctime.tm_mday);
+        labels[i] = lbls[i];
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
+        ntime += WV_SECONDS_IN_HOUR;
+    }
+    
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
+    
+    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
+    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
     {
-        // nothing for us here
-        return ERROR_ABORT;
+        if (img->title[i] == '/')
+            break;
+    
+        datasets[0].legend[i] = img->title[i];
+    }
+    if (i < strlen (img->title) - 1)
+    {
+        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
     }
     
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
+    for (i = skipNo; i < WEEKLY_NUM_VALUES; i ++)
     {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
+        datasets[0].valueset[i-skipNo] = WEEK_VALUES(img->mgrWork, DATA_INDEX_windchill)[i];
+        datasets[1].valueset[i-skipNo] = WEEK_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i];
+        
+        if (WEEK_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i] <= ARCHIVE_VALUE_NULL ||
+            WEEK_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i] <= ARCHIVE_VALUE_NULL ||
+            WEEK_VALUES(img->mgrWork, DATA_INDEX_windchill)[i] <= ARCHIVE_VALUE_NULL ||
+            WEEK_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i] <= ARCHIVE_VALUE_NULL)
+        {
+            continue;
+        }
+        
+        setMin (&min, 
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
+                
+        setMax (&max, 
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                WEEK_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
+    }
 
-        labels[i] = sampleLabels[j];
+    // if there is no data yet, pick default min/max
+    if (min > max)
+    {
+        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
+        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
     }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_windGust],
-                     6,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          7,
+                          min,
+                          max,
+                          1.0,
+                          labels,
+                          WEEKLY_NUM_VALUES-skipNo,
+                          WEEKLY_NUM_VALUES,
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateHiWSpeedWeek (HTML_IMG *img)
+static int generateCompositeInTempHumidWeek (HTML_IMG *img)
 {
-    int         i, skipNo;
-    char        lbls[WEEKLY_NUM_VALUES][8];
+    int         i, j, skipNo;
     char        temp[256];
+    char        lbls[WEEKLY_NUM_VALUES][8];
     time_t      ntime = img->mgrWork->weekStartTime_T;
     struct tm   loctime;
+    MC_DATASET  datasets[2];
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
@@ -1594,31 +1848,56 @@ static int generateHiWSpeedWeek (HTML_IMG *img)
 
         ntime += WV_SECONDS_IN_HOUR;
     }
+    
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
+    
+    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
+    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
+    {
+        if (img->title[i] == '/')
+            break;
+    
+        datasets[0].legend[i] = img->title[i];
+    }
+    if (i < strlen (img->title) - 1)
+    {
+        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
+    }
+    
+    for (i = skipNo; i < WEEKLY_NUM_VALUES; i ++)
+    {
+        datasets[0].valueset[i-skipNo] = WEEK_VALUES(img->mgrWork, DATA_INDEX_inTemp)[i];
+        datasets[1].valueset[i-skipNo] = WEEK_VALUES(img->mgrWork, DATA_INDEX_inHumidity)[i];
+    }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->weekValues[DATA_INDEX_windGust][skipNo],
-                     7,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     WEEKLY_NUM_VALUES-skipNo,
-                     WEEKLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          7,
+                          CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
+                          CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
+                          1.0,
+                          labels,
+                          WEEKLY_NUM_VALUES-skipNo,
+                          WEEKLY_NUM_VALUES,
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateHiWSpeedMonth (HTML_IMG *img)
+static int generateCompositeTempMonth (HTML_IMG *img)
 {
-    int         i, skipNo;
-    char        lbls[MONTHLY_NUM_VALUES][8];
+    int         i, j, skipNo;
     char        temp[256];
+    char        lbls[MONTHLY_NUM_VALUES][8];
     time_t      ntime = img->mgrWork->monthStartTime_T;
     struct tm   loctime;
+    float       min = 10000.0, max = -10000.0;
+    MC_DATASET  datasets[2];
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
@@ -1660,132 +1939,82 @@ static int generateHiWSpeedMonth (HTML_IMG *img)
         ntime += WV_SECONDS_IN_HOUR;
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->monthValues[DATA_INDEX_windGust][skipNo],
-                     14,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES-skipNo,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateHiWSpeedYear (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
+    
+    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
+    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
     {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
+        if (img->title[i] == '/')
+            break;
     
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
+        datasets[0].legend[i] = img->title[i];
+    }
+    if (i < strlen (img->title) - 1)
     {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_windGust],
-                     4,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateBaromDay (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
+        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
     }
     
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
+    for (i = skipNo; i < MONTHLY_NUM_VALUES; i ++)
     {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
+        datasets[0].valueset[i-skipNo] = MONTH_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i];
+        datasets[1].valueset[i-skipNo] = MONTH_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i];
 
-        labels[i] = sampleLabels[j];
+        if (MONTH_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i] <= ARCHIVE_VALUE_NULL ||
+            MONTH_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i] <= ARCHIVE_VALUE_NULL ||
+            MONTH_VALUES(img->mgrWork, DATA_INDEX_windchill)[i] <= ARCHIVE_VALUE_NULL ||
+            MONTH_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i] <= ARCHIVE_VALUE_NULL)
+        {
+            continue;
+        }
+        
+        setMin (&min, 
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
+                
+        setMax (&max, 
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
     }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
 
-    if (img->mgrWork->isMetricUnits)
-    {
-        return (htmlGenPngChart (temp,
-                         1,
-                         img->mgrWork->dayValues[DATA_INDEX_barometer],
-                         6,
-                         1000.0,
-                         1039.9,
-                         10.0,
-                         labels,
-                         DAILY_NUM_VALUES(img->mgrWork),
-                         DAILY_NUM_VALUES(img->mgrWork),
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat,
-                         img->mgrWork->isDualUnits));
-    }
-    else
+    // if there is no data yet, pick default min/max
+    if (min > max)
     {
-        return (htmlGenPngChart (temp,
-                         0,
-                         img->mgrWork->dayValues[DATA_INDEX_barometer],
-                         6,
-                         29.7,
-                         30.3,
-                         0.1,
-                         labels,
-                         DAILY_NUM_VALUES(img->mgrWork),
-                         DAILY_NUM_VALUES(img->mgrWork),
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat,
-                         img->mgrWork->isDualUnits));
+        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
+        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
     }
+
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          14,
+                          min,
+                          max,
+                          1.0,
+                          labels,
+                          MONTHLY_NUM_VALUES-skipNo,
+                          MONTHLY_NUM_VALUES,
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateBaromWeek (HTML_IMG *img)
+static int generateCompositeHIndexWChillMonth (HTML_IMG *img)
 {
-    int         i, skipNo;
-    char        lbls[WEEKLY_NUM_VALUES][8];
+    int         i, j, skipNo;
     char        temp[256];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
+    char        lbls[MONTHLY_NUM_VALUES][8];
+    time_t      ntime = img->mgrWork->monthStartTime_T;
     struct tm   loctime;
+    float       min = 10000.0, max = -10000.0;
+    MC_DATASET  datasets[2];
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
@@ -1795,7 +2024,7 @@ static int generateBaromWeek (HTML_IMG *img)
     
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
+    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
     {
         localtime_r (&ntime, &loctime);
         if (loctime.tm_hour == 0)
@@ -1809,7 +2038,7 @@ static int generateBaromWeek (HTML_IMG *img)
         }
     }
 
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
+    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
     {
         localtime_r (&ntime, &loctime);
         if ((i % 24) == 0)
@@ -1827,51 +2056,81 @@ static int generateBaromWeek (HTML_IMG *img)
         ntime += WV_SECONDS_IN_HOUR;
     }
 
-    if (img->mgrWork->isMetricUnits)
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
+    
+    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
+    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
     {
-        return (htmlGenPngChart (temp,
-                         1,
-                         &img->mgrWork->weekValues[DATA_INDEX_barometer][skipNo],
-                         7,
-                         1000.0,
-                         1039.9,
-                         10.0,
-                         labels,
-                         WEEKLY_NUM_VALUES-skipNo,
-                         WEEKLY_NUM_VALUES,
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat,
-                         img->mgrWork->isDualUnits));
+        if (img->title[i] == '/')
+            break;
+    
+        datasets[0].legend[i] = img->title[i];
     }
-    else
+    if (i < strlen (img->title) - 1)
     {
-        return (htmlGenPngChart (temp,
-                         0,
-                         img->mgrWork->weekValues[DATA_INDEX_barometer],
-                         7,
-                         29.7,
-                         30.3,
-                         0.1,
-                         labels,
-                         WEEKLY_NUM_VALUES-skipNo,
-                         WEEKLY_NUM_VALUES,
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat,
-                         img->mgrWork->isDualUnits));
+        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
+    }
+    
+    for (i = skipNo; i < MONTHLY_NUM_VALUES; i ++)
+    {
+        datasets[0].valueset[i-skipNo] = MONTH_VALUES(img->mgrWork, DATA_INDEX_windchill)[i];
+        datasets[1].valueset[i-skipNo] = MONTH_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i];
+        
+        if (MONTH_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i] <= ARCHIVE_VALUE_NULL ||
+            MONTH_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i] <= ARCHIVE_VALUE_NULL ||
+            MONTH_VALUES(img->mgrWork, DATA_INDEX_windchill)[i] <= ARCHIVE_VALUE_NULL ||
+            MONTH_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i] <= ARCHIVE_VALUE_NULL)
+        {
+            continue;
+        }
+        
+        setMin (&min, 
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
+                
+        setMax (&max, 
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_outTemp)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_dewpoint)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_windchill)[i],
+                MONTH_VALUES(img->mgrWork, DATA_INDEX_heatindex)[i]);
     }
+
+    // if there is no data yet, pick default min/max
+    if (min > max)
+    {
+        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
+        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
+    }
+
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          14,
+                          min,
+                          max,
+                          1.0,
+                          labels,
+                          MONTHLY_NUM_VALUES-skipNo,
+                          MONTHLY_NUM_VALUES,
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateBaromMonth (HTML_IMG *img)
+static int generateCompositeInTempHumidMonth (HTML_IMG *img)
 {
-    int         i, skipNo;
-    char        lbls[MONTHLY_NUM_VALUES][8];
+    int         i, j, skipNo;
     char        temp[256];
+    char        lbls[MONTHLY_NUM_VALUES][8];
     time_t      ntime = img->mgrWork->monthStartTime_T;
     struct tm   loctime;
+    MC_DATASET  datasets[2];
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
@@ -1913,177 +2172,148 @@ static int generateBaromMonth (HTML_IMG *img)
         ntime += WV_SECONDS_IN_HOUR;
     }
 
-    if (img->mgrWork->isMetricUnits)
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
+    
+    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
+    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
     {
-        return (htmlGenPngChart (temp,
-                         1,
-                         &img->mgrWork->monthValues[DATA_INDEX_barometer][skipNo],
-                         14,
-                         1000.0,
-                         1039.9,
-                         10.0,
-                         labels,
-                         MONTHLY_NUM_VALUES-skipNo,
-                         MONTHLY_NUM_VALUES,
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat,
-                         img->mgrWork->isDualUnits));
+        if (img->title[i] == '/')
+            break;
+    
+        datasets[0].legend[i] = img->title[i];
     }
-    else
+    if (i < strlen (img->title) - 1)
     {
-        return (htmlGenPngChart (temp,
-                         0,
-                         &img->mgrWork->monthValues[DATA_INDEX_barometer][skipNo],
-                         14,
-                         29.7,
-                         30.3,
-                         0.1,
-                         labels,
-                         MONTHLY_NUM_VALUES-skipNo,
-                         MONTHLY_NUM_VALUES,
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat,
-                         img->mgrWork->isDualUnits));
+        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
     }
+    
+    for (i = skipNo; i < MONTHLY_NUM_VALUES; i ++)
+    {
+        datasets[0].valueset[i-skipNo] = MONTH_VALUES(img->mgrWork, DATA_INDEX_inTemp)[i];
+        datasets[1].valueset[i-skipNo] = MONTH_VALUES(img->mgrWork, DATA_INDEX_inHumidity)[i];
+    }
+
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          14,
+                          CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
+                          CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
+                          1.0,
+                          labels,
+                          MONTHLY_NUM_VALUES-skipNo,
+                          MONTHLY_NUM_VALUES,
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateBaromYear (HTML_IMG *img)
+static int generateCompositeWindDay (HTML_IMG *img)
 {
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
+    int         i, j;
     char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
+    MC_DATASET  datasets[2];
+    float       min = 10000.0, max = -10000.0;
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
+    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
     {
         // nothing for us here
         return ERROR_ABORT;
     }
-    
+
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
 
-    if (img->mgrWork->isMetricUnits)
-    {
-        return (htmlGenPngChart (temp,
-                         1,
-                         img->mgrWork->yearValues[DATA_INDEX_barometer],
-                         4,
-                         1000.0,
-                         1039.9,
-                         10.0,
-                         labels,
-                         YEARLY_NUM_VALUES,
-                         YEARLY_NUM_VALUES,
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat,
-                         img->mgrWork->isDualUnits));
-    }
-    else
+    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork); i ++, j ++)
     {
-        return (htmlGenPngChart (temp,
-                         0,
-                         img->mgrWork->yearValues[DATA_INDEX_barometer],
-                         4,
-                         29.7,
-                         30.3,
-                         0.1,
-                         labels,
-                         YEARLY_NUM_VALUES,
-                         YEARLY_NUM_VALUES,
-                         img->title,
-                         img->units,
-                         img->decimalPlaces,
-                         img->mgrWork->dateFormat,
-                         img->mgrWork->isDualUnits));
+        if (j >= DAILY_NUM_VALUES(img->mgrWork)-1)
+            j = 0;
+
+        labels[i] = sampleLabels[j];
     }
-}
 
-static int generateRainDay (HTML_IMG *img)
-{
-    int         i, j, skipNo = 0;
-    int         samplesInHour = (60/img->mgrWork->archiveInterval);
-    char        temp[256];
-    float       max = 0;
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
+    memset (datasets[0].legend, 0, 16);
+    memset (datasets[1].legend, 0, 16);
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
     {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
+        if (img->title[i] == '/')
+            break;
 
-    j = img->mgrWork->dayStart;
-    while ((j % samplesInHour) != 0)
+        datasets[0].legend[i] = img->title[i];
+    }
+    if (i < strlen (img->title) - 1)
     {
-        skipNo ++;
-        if (++ j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
+        strncpy (datasets[1].legend, &img->title[i+1], 15);
     }
 
-    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork)-skipNo; i ++)
+    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork); i ++)
     {
-        labels[i] = sampleHourLabels[j];
+        datasets[0].valueset[i] = DAY_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        datasets[1].valueset[i] = DAY_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
+
+        if (DAY_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] == ARCHIVE_VALUE_NULL ||
+            DAY_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] == ARCHIVE_VALUE_NULL)
+        {
+            continue;
+        }
 
-        if (img->mgrWork->dayValues[DATA_INDEX_rain][i+skipNo] > max)
-            max = img->mgrWork->dayValues[DATA_INDEX_rain][i+skipNo];
+        if (DAY_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] < min)
+            min = DAY_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        if (DAY_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] < min)
+            min = DAY_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
 
-        if (++ j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
+        if (DAY_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] > max)
+            max = DAY_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        if (DAY_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] > max)
+            max = DAY_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
     }
-    
-    // tack on the extra label
-    labels[(DAILY_NUM_VALUES(img->mgrWork)-skipNo)] = sampleHourLabels[(DAILY_NUM_VALUES(img->mgrWork)-1)];
-    
-    return (htmlGenPngBarChart (temp,
-                        img->mgrWork->isMetricUnits,
-                        &img->mgrWork->dayValues[DATA_INDEX_rain][skipNo+1],
-                        6,
-                        0,
-                        MAX(0.1,max),
-                        0.01,
-                        labels,
-                        DAILY_NUM_VALUES(img->mgrWork)-skipNo,
-                        img->title,
-                        img->units,
-                        img->decimalPlaces,
-                        60/img->mgrWork->archiveInterval,
-                        24,
-                        60/img->mgrWork->archiveInterval,
-                        img->mgrWork->dateFormat,
-                        img->mgrWork->isDualUnits));
+
+    // if there is no data yet, pick default min/max
+    if (min > max)
+    {
+        min = CHART_MIN_WSPEED(img->mgrWork->isMetricUnits);
+        max = CHART_MAX_WSPEED(img->mgrWork->isMetricUnits);
+    }
+
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          6,
+                          min,
+                          max,
+                          1.0,
+                          labels,
+                          DAILY_NUM_VALUES(img->mgrWork),
+                          DAILY_NUM_VALUES(img->mgrWork),
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateRainWeek (HTML_IMG *img)
+static int generateCompositeWindWeek (HTML_IMG *img)
 {
-    int         i, skipNo;
-    char        lbls[WEEKLY_NUM_VALUES][8];
+    int         i, j, skipNo;
     char        temp[256];
+    char        lbls[WEEKLY_NUM_VALUES][8];
     time_t      ntime = img->mgrWork->weekStartTime_T;
     struct tm   loctime;
-    float       max = 0;
+    float       min = 10000.0, max = -10000.0;
+    MC_DATASET  datasets[2];
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
         // nothing for us here
         return ERROR_ABORT;
     }
-    
+
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
     for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
@@ -2100,70 +2330,94 @@ static int generateRainWeek (HTML_IMG *img)
         }
     }
 
-    // kludge this for aggregate values
-    if (skipNo == 0)
-    {
-        // push forward one day
-        skipNo = 24;
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    for (i = 0; i < WEEKLY_NUM_VALUES-skipNo; i ++)
+    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
     {
         localtime_r (&ntime, &loctime);
         sprintf (lbls[i], "%d", loctime.tm_mday);
         labels[i] = lbls[i];
 
         ntime += WV_SECONDS_IN_HOUR;
+    }
+
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
 
-        if (img->mgrWork->weekValues[DATA_INDEX_rain][i+skipNo] > max)
-            max = img->mgrWork->weekValues[DATA_INDEX_rain][i+skipNo];
+    memset (datasets[0].legend, 0, 16);
+    memset (datasets[1].legend, 0, 16);
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
+    {
+        if (img->title[i] == '/')
+            break;
+
+        datasets[0].legend[i] = img->title[i];
+    }
+    if (i < strlen (img->title) - 1)
+    {
+        strncpy (datasets[1].legend, &img->title[i+1], 15);
     }
 
-    // tack on the extra label
-    if (skipNo > 1)
+    for (i = skipNo; i < WEEKLY_NUM_VALUES; i ++)
     {
-        ntime += WV_SECONDS_IN_DAY;
+        datasets[0].valueset[i-skipNo] = WEEK_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        datasets[1].valueset[i-skipNo] = WEEK_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
+
+        if (WEEK_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] == ARCHIVE_VALUE_NULL ||
+            WEEK_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] == ARCHIVE_VALUE_NULL)
+        {
+            continue;
+        }
+
+        if (WEEK_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] < min)
+            min = WEEK_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        if (WEEK_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] < min)
+            WEEK_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
+
+        if (WEEK_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] > max)
+            max = WEEK_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        if (WEEK_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] > max)
+            max = WEEK_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
     }
 
-    localtime_r (&ntime, &loctime);
-    sprintf (lbls[WEEKLY_NUM_VALUES-skipNo], "%d", loctime.tm_mday);
-    labels[WEEKLY_NUM_VALUES-skipNo] = lbls[WEEKLY_NUM_VALUES-skipNo];
+    // if there is no data yet, pick default min/max
+    if (min > max)
+    {
+        min = CHART_MIN_WSPEED(img->mgrWork->isMetricUnits);
+        max = CHART_MAX_WSPEED(img->mgrWork->isMetricUnits);
+    }
 
-    return (htmlGenPngBarChart (temp,
-                        img->mgrWork->isMetricUnits,
-                        &img->mgrWork->weekValues[DATA_INDEX_rain][skipNo],
-                        7,
-                        0,
-                        MAX(0.1,max),
-                        0.1,
-                        labels,
-                        WEEKLY_NUM_VALUES-skipNo,
-                        img->title,
-                        img->units,
-                        img->decimalPlaces,
-                        24,
-                        7,
-                        24,
-                        img->mgrWork->dateFormat,
-                        img->mgrWork->isDualUnits));
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          7,
+                          min,
+                          max,
+                          1.0,
+                          labels,
+                          WEEKLY_NUM_VALUES-skipNo,
+                          WEEKLY_NUM_VALUES,
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateRainMonth (HTML_IMG *img)
+static int generateCompositeWindMonth (HTML_IMG *img)
 {
-    int         i, skipNo;
-    char        lbls[MONTHLY_NUM_VALUES][8];
+    int         i, j, skipNo;
     char        temp[256];
+    char        lbls[MONTHLY_NUM_VALUES][8];
     time_t      ntime = img->mgrWork->monthStartTime_T;
     struct tm   loctime;
-    float       max = 0;
+    float       min = 10000.0, max = -10000.0;
+    MC_DATASET  datasets[2];
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
         // nothing for us here
         return ERROR_ABORT;
     }
-    
+
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
     for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
@@ -2180,4101 +2434,96 @@ static int generateRainMonth (HTML_IMG *img)
         }
     }
 
-    // kludge this for aggregate values
-    if (skipNo == 0)
-    {
-        // push forward one day
-        skipNo = 24;
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    for (i = 0; i < MONTHLY_NUM_VALUES-skipNo; i ++)
+    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
     {
         localtime_r (&ntime, &loctime);
         sprintf (lbls[i], "%d", loctime.tm_mday);
         labels[i] = lbls[i];
 
         ntime += WV_SECONDS_IN_HOUR;
-        if (img->mgrWork->monthValues[DATA_INDEX_rain][i+skipNo] > max)
-            max = img->mgrWork->monthValues[DATA_INDEX_rain][i+skipNo];
     }
 
-    // tack on the extra label
-    if (skipNo > 1)
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
+
+    memset (datasets[0].legend, 0, 16);
+    memset (datasets[1].legend, 0, 16);
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
     {
-        ntime += WV_SECONDS_IN_DAY;
-    }
+        if (img->title[i] == '/')
+            break;
 
-    localtime_r (&ntime, &loctime);
-    sprintf (lbls[MONTHLY_NUM_VALUES-skipNo], "%d", loctime.tm_mday);
-    labels[MONTHLY_NUM_VALUES-skipNo] = lbls[MONTHLY_NUM_VALUES-skipNo];
+        datasets[0].legend[i] = img->title[i];
+    }
+    if (i < strlen (img->title) - 1)
+    {
+        strncpy (datasets[1].legend, &img->title[i+1], 15);
+    }
 
-    return (htmlGenPngBarChart (temp,
-                        img->mgrWork->isMetricUnits,
-                        &img->mgrWork->monthValues[DATA_INDEX_rain][skipNo],
-                        14,
-                        0,
-                        MAX(0.1,max),
-                        0.1,
-                        labels,
-                        MONTHLY_NUM_VALUES-skipNo,
-                        img->title,
-                        img->units,
-                        img->decimalPlaces,
-                        24,
-                        28,
-                        24,
-                        img->mgrWork->dateFormat,
-                        img->mgrWork->isDualUnits));
-}
-
-static int generateRainYear (HTML_IMG *img)
-{
-    int         i, j, skipNo;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-    float       max = 0;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    // move forward 1 day to land on 52 weeks ago
-    ntime += WV_SECONDS_IN_DAY;
-    skipNo = 1;
-    
-    // if we are sitting on Sunday, bump it another day
-    localtime_r (&ntime, &loctime);
-    if (loctime.tm_wday == 0)
-    {
-        ntime += WV_SECONDS_IN_DAY;
-        skipNo ++;
-    }
-    
-    // move to the next Sunday
-    for (i = 0; i < 7; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_wday == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_DAY;
-        }
-    }
-
-    for (i = 0; i < YEARLY_NUM_VALUES-skipNo; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_DAY;
-        if (img->mgrWork->yearValues[DATA_INDEX_rain][i+skipNo] > max)
-            max = img->mgrWork->yearValues[DATA_INDEX_rain][i+skipNo];
-    }
-
-    for (j = 0; j < 7; j ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_wday == 0)
-        {
-            break;
-        }
-        else
-        {
-            ntime += WV_SECONDS_IN_DAY;
-        }
-    }
-
-    localtime_r (&ntime, &loctime);
-    sprintf (lbls[YEARLY_NUM_VALUES-skipNo], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-    labels[YEARLY_NUM_VALUES-skipNo] = lbls[YEARLY_NUM_VALUES-skipNo];
-
-    return (htmlGenPngBarChart (temp,
-                        img->mgrWork->isMetricUnits,
-                        &img->mgrWork->yearValues[DATA_INDEX_rain][skipNo],
-                        4,
-                        0,
-                        MAX(0.1,max),
-                        0.1,
-                        labels,
-                        YEARLY_NUM_VALUES-skipNo,
-                        img->title,
-                        img->units,
-                        img->decimalPlaces,
-                        7,
-                        52,
-                        7,
-                        img->mgrWork->dateFormat,
-                        img->mgrWork->isDualUnits));
-}
-
-static int generateWChillDay (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_windchill],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateWChillWeek (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[WEEKLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->weekValues[DATA_INDEX_windchill][skipNo],
-                     7,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     WEEKLY_NUM_VALUES-skipNo,
-                     WEEKLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateWChillMonth (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
+    for (i = skipNo; i < MONTHLY_NUM_VALUES; i ++)
     {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
+        datasets[0].valueset[i-skipNo] = MONTH_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        datasets[1].valueset[i-skipNo] = MONTH_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
 
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
+        if (MONTH_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] == ARCHIVE_VALUE_NULL ||
+            MONTH_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] == ARCHIVE_VALUE_NULL)
         {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
+            continue;
         }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->monthValues[DATA_INDEX_windchill][skipNo],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES-skipNo,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
 
-static int generateWChillYear (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
+        if (MONTH_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] < min)
+            min = MONTH_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        if (MONTH_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] < min)
+            min = MONTH_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
+        if (MONTH_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] > max)
+            max = MONTH_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        if (MONTH_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] > max)
+            max = MONTH_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_windchill],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateHIndexDay (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_heatindex],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateHIndexWeek (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[WEEKLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->weekValues[DATA_INDEX_heatindex][skipNo],
-                     7,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     WEEKLY_NUM_VALUES-skipNo,
-                     WEEKLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateHIndexMonth (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->monthValues[DATA_INDEX_heatindex][skipNo],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES-skipNo,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateHIndexYear (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_heatindex],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-
-////////////////////////////////////////////////////////////////////////////
-//  Composite Charts
-
-// utility to determine max of 4 values
-static void setMax(float *maxStore, float v1, float v2, float v3, float v4)
-{
-    if (v1 > *maxStore)
-        *maxStore = v1;
-    if (v2 > *maxStore)
-        *maxStore = v2;
-    if (v3 > *maxStore)
-        *maxStore = v3;
-    if (v4 > *maxStore)
-        *maxStore = v4;
-}
-
-// utility to determine min of 4 values
-static void setMin(float *minStore, float v1, float v2, float v3, float v4)
-{
-    if (v1 < *minStore)
-        *minStore = v1;
-    if (v2 < *minStore)
-        *minStore = v2;
-    if (v3 < *minStore)
-        *minStore = v3;
-    if (v4 < *minStore)
-        *minStore = v4;
-}
-
-
-static int generateCompositeTempDay (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-    MC_DATASET  datasets[2];
-    float       min = 10000.0, max = -10000.0;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-    
-    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
-    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-    
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
-    }
-    
-    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork); i ++)
-    {
-        datasets[0].valueset[i] = img->mgrWork->dayValues[DATA_INDEX_outTemp][i];
-        datasets[1].valueset[i] = img->mgrWork->dayValues[DATA_INDEX_dewpoint][i];
-
-        if (img->mgrWork->dayValues[DATA_INDEX_outTemp][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->dayValues[DATA_INDEX_dewpoint][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->dayValues[DATA_INDEX_windchill][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->dayValues[DATA_INDEX_heatindex][i] <= ARCHIVE_VALUE_NULL)
-        {
-            continue;
-        }
-                
-        setMin (&min, 
-                img->mgrWork->dayValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->dayValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->dayValues[DATA_INDEX_windchill][i],
-                img->mgrWork->dayValues[DATA_INDEX_heatindex][i]);
-                
-        setMax (&max, 
-                img->mgrWork->dayValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->dayValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->dayValues[DATA_INDEX_windchill][i],
-                img->mgrWork->dayValues[DATA_INDEX_heatindex][i]);
-    }
-
-    // if there is no data yet, pick default min/max
-    if (min > max)
-    {
-        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
-        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          6,
-                          min,
-                          max,
-                          1.0,
-                          labels,
-                          DAILY_NUM_VALUES(img->mgrWork),
-                          DAILY_NUM_VALUES(img->mgrWork),
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeHIndexWChillDay (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-    MC_DATASET  datasets[2];
-    float       min = 10000.0, max = -10000.0;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-    
-    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
-    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-    
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
-    }
-    
-    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork); i ++)
-    {
-        datasets[0].valueset[i] = img->mgrWork->dayValues[DATA_INDEX_windchill][i];
-        datasets[1].valueset[i] = img->mgrWork->dayValues[DATA_INDEX_heatindex][i];
-        
-        if (img->mgrWork->dayValues[DATA_INDEX_outTemp][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->dayValues[DATA_INDEX_dewpoint][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->dayValues[DATA_INDEX_windchill][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->dayValues[DATA_INDEX_heatindex][i] <= ARCHIVE_VALUE_NULL)
-        {
-            continue;
-        }
-        
-        setMin (&min, 
-                img->mgrWork->dayValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->dayValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->dayValues[DATA_INDEX_windchill][i],
-                img->mgrWork->dayValues[DATA_INDEX_heatindex][i]);
-                
-        setMax (&max, 
-                img->mgrWork->dayValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->dayValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->dayValues[DATA_INDEX_windchill][i],
-                img->mgrWork->dayValues[DATA_INDEX_heatindex][i]);
-    }
-
-    // if there is no data yet, pick default min/max
-    if (min > max)
-    {
-        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
-        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          6,
-                          min,
-                          max,
-                          1.0,
-                          labels,
-                          DAILY_NUM_VALUES(img->mgrWork),
-                          DAILY_NUM_VALUES(img->mgrWork),
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeInTempHumidDay (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-    MC_DATASET  datasets[2];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-    
-    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
-    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-    
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
-    }
-    
-    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork); i ++)
-    {
-        datasets[0].valueset[i] = img->mgrWork->dayValues[DATA_INDEX_inTemp][i];
-        datasets[1].valueset[i] = img->mgrWork->dayValues[DATA_INDEX_inHumidity][i];
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          6,
-                          CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                          CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                          1.0,
-                          labels,
-                          DAILY_NUM_VALUES(img->mgrWork),
-                          DAILY_NUM_VALUES(img->mgrWork),
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeTempWeek (HTML_IMG *img)
-{
-    int         i, j, skipNo;
-    char        temp[256];
-    char        lbls[WEEKLY_NUM_VALUES][8];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
-    struct tm   loctime;
-    float       min = 10000.0, max = -10000.0;
-    MC_DATASET  datasets[2];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-    
-    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
-    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-    
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
-    }
-    
-    for (i = skipNo; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        datasets[0].valueset[i-skipNo] = img->mgrWork->weekValues[DATA_INDEX_outTemp][i];
-        datasets[1].valueset[i-skipNo] = img->mgrWork->weekValues[DATA_INDEX_dewpoint][i];
-
-        if (img->mgrWork->weekValues[DATA_INDEX_outTemp][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->weekValues[DATA_INDEX_dewpoint][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->weekValues[DATA_INDEX_windchill][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->weekValues[DATA_INDEX_heatindex][i] <= ARCHIVE_VALUE_NULL)
-        {
-            continue;
-        }
-        
-        setMin (&min, 
-                img->mgrWork->weekValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->weekValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->weekValues[DATA_INDEX_windchill][i],
-                img->mgrWork->weekValues[DATA_INDEX_heatindex][i]);
-                
-        setMax (&max, 
-                img->mgrWork->weekValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->weekValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->weekValues[DATA_INDEX_windchill][i],
-                img->mgrWork->weekValues[DATA_INDEX_heatindex][i]);
-    }
-
-    // if there is no data yet, pick default min/max
-    if (min > max)
-    {
-        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
-        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          7,
-                          min,
-                          max,
-                          1.0,
-                          labels,
-                          WEEKLY_NUM_VALUES-skipNo,
-                          WEEKLY_NUM_VALUES,
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeHIndexWChillWeek (HTML_IMG *img)
-{
-    int         i, j, skipNo;
-    char        temp[256];
-    char        lbls[WEEKLY_NUM_VALUES][8];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
-    struct tm   loctime;
-    float       min = 10000.0, max = -10000.0;
-    MC_DATASET  datasets[2];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-    
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-    
-    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
-    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-    
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
-    }
-    
-    for (i = skipNo; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        datasets[0].valueset[i-skipNo] = img->mgrWork->weekValues[DATA_INDEX_windchill][i];
-        datasets[1].valueset[i-skipNo] = img->mgrWork->weekValues[DATA_INDEX_heatindex][i];
-        
-        if (img->mgrWork->weekValues[DATA_INDEX_outTemp][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->weekValues[DATA_INDEX_dewpoint][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->weekValues[DATA_INDEX_windchill][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->weekValues[DATA_INDEX_heatindex][i] <= ARCHIVE_VALUE_NULL)
-        {
-            continue;
-        }
-        
-        setMin (&min, 
-                img->mgrWork->weekValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->weekValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->weekValues[DATA_INDEX_windchill][i],
-                img->mgrWork->weekValues[DATA_INDEX_heatindex][i]);
-                
-        setMax (&max, 
-                img->mgrWork->weekValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->weekValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->weekValues[DATA_INDEX_windchill][i],
-                img->mgrWork->weekValues[DATA_INDEX_heatindex][i]);
-    }
-
-    // if there is no data yet, pick default min/max
-    if (min > max)
-    {
-        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
-        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          7,
-                          min,
-                          max,
-                          1.0,
-                          labels,
-                          WEEKLY_NUM_VALUES-skipNo,
-                          WEEKLY_NUM_VALUES,
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeInTempHumidWeek (HTML_IMG *img)
-{
-    int         i, j, skipNo;
-    char        temp[256];
-    char        lbls[WEEKLY_NUM_VALUES][8];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
-    struct tm   loctime;
-    MC_DATASET  datasets[2];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-    
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-    
-    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
-    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-    
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
-    }
-    
-    for (i = skipNo; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        datasets[0].valueset[i-skipNo] = img->mgrWork->weekValues[DATA_INDEX_inTemp][i];
-        datasets[1].valueset[i-skipNo] = img->mgrWork->weekValues[DATA_INDEX_inHumidity][i];
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          7,
-                          CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                          CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                          1.0,
-                          labels,
-                          WEEKLY_NUM_VALUES-skipNo,
-                          WEEKLY_NUM_VALUES,
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeTempMonth (HTML_IMG *img)
-{
-    int         i, j, skipNo;
-    char        temp[256];
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-    float       min = 10000.0, max = -10000.0;
-    MC_DATASET  datasets[2];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-    
-    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
-    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-    
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
-    }
-    
-    for (i = skipNo; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        datasets[0].valueset[i-skipNo] = img->mgrWork->monthValues[DATA_INDEX_outTemp][i];
-        datasets[1].valueset[i-skipNo] = img->mgrWork->monthValues[DATA_INDEX_dewpoint][i];
-
-        if (img->mgrWork->monthValues[DATA_INDEX_outTemp][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->monthValues[DATA_INDEX_dewpoint][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->monthValues[DATA_INDEX_windchill][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->monthValues[DATA_INDEX_heatindex][i] <= ARCHIVE_VALUE_NULL)
-        {
-            continue;
-        }
-        
-        setMin (&min, 
-                img->mgrWork->monthValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->monthValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->monthValues[DATA_INDEX_windchill][i],
-                img->mgrWork->monthValues[DATA_INDEX_heatindex][i]);
-                
-        setMax (&max, 
-                img->mgrWork->monthValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->monthValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->monthValues[DATA_INDEX_windchill][i],
-                img->mgrWork->monthValues[DATA_INDEX_heatindex][i]);
-    }
-
-    // if there is no data yet, pick default min/max
-    if (min > max)
-    {
-        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
-        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          14,
-                          min,
-                          max,
-                          1.0,
-                          labels,
-                          MONTHLY_NUM_VALUES-skipNo,
-                          MONTHLY_NUM_VALUES,
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeHIndexWChillMonth (HTML_IMG *img)
-{
-    int         i, j, skipNo;
-    char        temp[256];
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-    float       min = 10000.0, max = -10000.0;
-    MC_DATASET  datasets[2];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-    
-    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
-    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-    
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
-    }
-    
-    for (i = skipNo; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        datasets[0].valueset[i-skipNo] = img->mgrWork->monthValues[DATA_INDEX_windchill][i];
-        datasets[1].valueset[i-skipNo] = img->mgrWork->monthValues[DATA_INDEX_heatindex][i];
-        
-        if (img->mgrWork->monthValues[DATA_INDEX_outTemp][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->monthValues[DATA_INDEX_dewpoint][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->monthValues[DATA_INDEX_windchill][i] <= ARCHIVE_VALUE_NULL ||
-            img->mgrWork->monthValues[DATA_INDEX_heatindex][i] <= ARCHIVE_VALUE_NULL)
-        {
-            continue;
-        }
-        
-        setMin (&min, 
-                img->mgrWork->monthValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->monthValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->monthValues[DATA_INDEX_windchill][i],
-                img->mgrWork->monthValues[DATA_INDEX_heatindex][i]);
-                
-        setMax (&max, 
-                img->mgrWork->monthValues[DATA_INDEX_outTemp][i],
-                img->mgrWork->monthValues[DATA_INDEX_dewpoint][i],
-                img->mgrWork->monthValues[DATA_INDEX_windchill][i],
-                img->mgrWork->monthValues[DATA_INDEX_heatindex][i]);
-    }
-
-    // if there is no data yet, pick default min/max
-    if (min > max)
-    {
-        min = CHART_MIN_TEMP(img->mgrWork->isMetricUnits);
-        max = CHART_MAX_TEMP(img->mgrWork->isMetricUnits);
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          14,
-                          min,
-                          max,
-                          1.0,
-                          labels,
-                          MONTHLY_NUM_VALUES-skipNo,
-                          MONTHLY_NUM_VALUES,
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeInTempHumidMonth (HTML_IMG *img)
-{
-    int         i, j, skipNo;
-    char        temp[256];
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-    MC_DATASET  datasets[2];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-    
-    memset (datasets[0].legend, 0, sizeof(datasets[0].legend));
-    memset (datasets[1].legend, 0, sizeof(datasets[1].legend));
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-    
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        wvstrncpy (datasets[1].legend, &img->title[i+1], sizeof(datasets[1].legend));
-    }
-    
-    for (i = skipNo; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        datasets[0].valueset[i-skipNo] = img->mgrWork->monthValues[DATA_INDEX_inTemp][i];
-        datasets[1].valueset[i-skipNo] = img->mgrWork->monthValues[DATA_INDEX_inHumidity][i];
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          14,
-                          CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                          CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                          1.0,
-                          labels,
-                          MONTHLY_NUM_VALUES-skipNo,
-                          MONTHLY_NUM_VALUES,
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeWindDay (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-    MC_DATASET  datasets[2];
-    float       min = 10000.0, max = -10000.0;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork); i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork)-1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-
-    memset (datasets[0].legend, 0, 16);
-    memset (datasets[1].legend, 0, 16);
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        strncpy (datasets[1].legend, &img->title[i+1], 15);
-    }
-
-    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork); i ++)
-    {
-        datasets[0].valueset[i] = img->mgrWork->dayValues[DATA_INDEX_windSpeed][i];
-        datasets[1].valueset[i] = img->mgrWork->dayValues[DATA_INDEX_windGust][i];
-
-        if (img->mgrWork->dayValues[DATA_INDEX_windSpeed][i] == ARCHIVE_VALUE_NULL ||
-            img->mgrWork->dayValues[DATA_INDEX_windGust][i] == ARCHIVE_VALUE_NULL)
-        {
-            continue;
-        }
-
-        if (img->mgrWork->dayValues[DATA_INDEX_windSpeed][i] < min)
-            min = img->mgrWork->dayValues[DATA_INDEX_windSpeed][i];
-        if (img->mgrWork->dayValues[DATA_INDEX_windGust][i] < min)
-            min = img->mgrWork->dayValues[DATA_INDEX_windGust][i];
-
-        if (img->mgrWork->dayValues[DATA_INDEX_windSpeed][i] > max)
-            max = img->mgrWork->dayValues[DATA_INDEX_windSpeed][i];
-        if (img->mgrWork->dayValues[DATA_INDEX_windGust][i] > max)
-            max = img->mgrWork->dayValues[DATA_INDEX_windGust][i];
-    }
-
-    // if there is no data yet, pick default min/max
-    if (min > max)
-    {
-        min = CHART_MIN_WSPEED(img->mgrWork->isMetricUnits);
-        max = CHART_MAX_WSPEED(img->mgrWork->isMetricUnits);
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          6,
-                          min,
-                          max,
-                          1.0,
-                          labels,
-                          DAILY_NUM_VALUES(img->mgrWork),
-                          DAILY_NUM_VALUES(img->mgrWork),
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeWindWeek (HTML_IMG *img)
-{
-    int         i, j, skipNo;
-    char        temp[256];
-    char        lbls[WEEKLY_NUM_VALUES][8];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
-    struct tm   loctime;
-    float       min = 10000.0, max = -10000.0;
-    MC_DATASET  datasets[2];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-
-    memset (datasets[0].legend, 0, 16);
-    memset (datasets[1].legend, 0, 16);
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        strncpy (datasets[1].legend, &img->title[i+1], 15);
-    }
-
-    for (i = skipNo; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        datasets[0].valueset[i-skipNo] = img->mgrWork->weekValues[DATA_INDEX_windSpeed][i];
-        datasets[1].valueset[i-skipNo] = img->mgrWork->weekValues[DATA_INDEX_windGust][i];
-
-        if (img->mgrWork->weekValues[DATA_INDEX_windSpeed][i] == ARCHIVE_VALUE_NULL ||
-            img->mgrWork->weekValues[DATA_INDEX_windGust][i] == ARCHIVE_VALUE_NULL)
-        {
-            continue;
-        }
-
-        if (img->mgrWork->weekValues[DATA_INDEX_windSpeed][i] < min)
-            min = img->mgrWork->weekValues[DATA_INDEX_windSpeed][i];
-        if (img->mgrWork->weekValues[DATA_INDEX_windGust][i] < min)
-            img->mgrWork->weekValues[DATA_INDEX_windGust][i];
-
-        if (img->mgrWork->weekValues[DATA_INDEX_windSpeed][i] > max)
-            max = img->mgrWork->weekValues[DATA_INDEX_windSpeed][i];
-        if (img->mgrWork->weekValues[DATA_INDEX_windGust][i] > max)
-            max = img->mgrWork->weekValues[DATA_INDEX_windGust][i];
-    }
-
-    // if there is no data yet, pick default min/max
-    if (min > max)
-    {
-        min = CHART_MIN_WSPEED(img->mgrWork->isMetricUnits);
-        max = CHART_MAX_WSPEED(img->mgrWork->isMetricUnits);
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          7,
-                          min,
-                          max,
-                          1.0,
-                          labels,
-                          WEEKLY_NUM_VALUES-skipNo,
-                          WEEKLY_NUM_VALUES,
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeWindMonth (HTML_IMG *img)
-{
-    int         i, j, skipNo;
-    char        temp[256];
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-    float       min = 10000.0, max = -10000.0;
-    MC_DATASET  datasets[2];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-
-    memset (datasets[0].legend, 0, 16);
-    memset (datasets[1].legend, 0, 16);
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        strncpy (datasets[1].legend, &img->title[i+1], 15);
-    }
-
-    for (i = skipNo; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        datasets[0].valueset[i-skipNo] = img->mgrWork->monthValues[DATA_INDEX_windSpeed][i];
-        datasets[1].valueset[i-skipNo] = img->mgrWork->monthValues[DATA_INDEX_windGust][i];
-
-        if (img->mgrWork->monthValues[DATA_INDEX_windSpeed][i] == ARCHIVE_VALUE_NULL ||
-            img->mgrWork->monthValues[DATA_INDEX_windGust][i] == ARCHIVE_VALUE_NULL)
-        {
-            continue;
-        }
-
-        if (img->mgrWork->monthValues[DATA_INDEX_windSpeed][i] < min)
-            min = img->mgrWork->monthValues[DATA_INDEX_windSpeed][i];
-        if (img->mgrWork->monthValues[DATA_INDEX_windGust][i] < min)
-            min = img->mgrWork->monthValues[DATA_INDEX_windGust][i];
-
-        if (img->mgrWork->monthValues[DATA_INDEX_windSpeed][i] > max)
-            max = img->mgrWork->monthValues[DATA_INDEX_windSpeed][i];
-        if (img->mgrWork->monthValues[DATA_INDEX_windGust][i] > max)
-            max = img->mgrWork->monthValues[DATA_INDEX_windGust][i];
-    }
-
-    // if there is no data yet, pick default min/max
-    if (min > max)
-    {
-        min = CHART_MIN_WSPEED(img->mgrWork->isMetricUnits);
-        max = CHART_MAX_WSPEED(img->mgrWork->isMetricUnits);
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          14,
-                          min,
-                          max,
-                          1.0,
-                          labels,
-                          MONTHLY_NUM_VALUES-skipNo,
-                          MONTHLY_NUM_VALUES,
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-static int generateCompositeWindYear (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-    MC_DATASET  datasets[2];
-    float       min = 10000.0, max = -10000.0;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    datasets[0].lineColor = htmlgenGetChartDefaultLine();
-    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
-
-    memset (datasets[0].legend, 0, 16);
-    memset (datasets[1].legend, 0, 16);
-    for (i = 0; i < 15 && i < strlen (img->title); i ++)
-    {
-        if (img->title[i] == '/')
-            break;
-
-        datasets[0].legend[i] = img->title[i];
-    }
-    if (i < strlen (img->title) - 1)
-    {
-        strncpy (datasets[1].legend, &img->title[i+1], 15);
-    }
-
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        datasets[0].valueset[i] = img->mgrWork->yearValues[DATA_INDEX_windSpeed][i];
-        datasets[1].valueset[i] = img->mgrWork->yearValues[DATA_INDEX_windGust][i];
-
-        if (img->mgrWork->yearValues[DATA_INDEX_windSpeed][i] == ARCHIVE_VALUE_NULL ||
-            img->mgrWork->yearValues[DATA_INDEX_windGust][i] == ARCHIVE_VALUE_NULL)
-        {
-            continue;
-        }
-
-        if (img->mgrWork->yearValues[DATA_INDEX_windSpeed][i] < min)
-            min = img->mgrWork->yearValues[DATA_INDEX_windSpeed][i];
-        if (img->mgrWork->yearValues[DATA_INDEX_windGust][i] < min)
-            min = img->mgrWork->yearValues[DATA_INDEX_windGust][i];
-
-        if (img->mgrWork->yearValues[DATA_INDEX_windSpeed][i] > max)
-            max = img->mgrWork->yearValues[DATA_INDEX_windSpeed][i];
-        if (img->mgrWork->yearValues[DATA_INDEX_windGust][i] > max)
-            max = img->mgrWork->yearValues[DATA_INDEX_windGust][i];
-    }
-
-    // if there is no data yet, pick default min/max
-    if (min > max)
-    {
-        min = CHART_MIN_WSPEED(img->mgrWork->isMetricUnits);
-        max = CHART_MAX_WSPEED(img->mgrWork->isMetricUnits);
-    }
-
-    return (htmlGenPngMultiChart (temp,
-                          img->mgrWork->isMetricUnits,
-                          datasets,
-                          2,
-                          4,
-                          min,
-                          max,
-                          1.0,
-                          labels,
-                          YEARLY_NUM_VALUES,
-                          YEARLY_NUM_VALUES,
-                          img->units,
-                          img->decimalPlaces,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-}
-
-//////////////////////////////////////////////////////////////////////////////
-//////////////  E X T E N D E D   D A T A   B E G I N  ///////////////////////
-//////////////////////////////////////////////////////////////////////////////
-
-// first a few buckets for common extended items
-
-static int generateUV (HTML_IMG *img)
-{
-    char        temp[256];
-
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    return (htmlGenPngBucket (temp,
-                      0,
-                      (float)img->mgrWork->loopStore.UV,
-                      (float)GLB_HILOW_NONE,
-                      (float)GLB_HILOW_NONE,
-                      img->title,
-                      img->units,
-                      img->decimalPlaces,
-                      0.0,
-                      4.0,
-                      img->mgrWork->dateFormat,
-                      img->mgrWork->isDualUnits));
-}
-
-static int generateRadiation (HTML_IMG *img)
-{
-    char        temp[256];
-
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    return (htmlGenPngBucket (temp,
-                      0,
-                      (float)img->mgrWork->loopStore.radiation,
-                      (float)GLB_HILOW_NONE,
-                      (float)GLB_HILOW_NONE,
-                      img->title,
-                      img->units,
-                      img->decimalPlaces,
-                      0.0,
-                      4.0,
-                      img->mgrWork->dateFormat,
-                      img->mgrWork->isDualUnits));
-}
-
-static int generateET (HTML_IMG *img)
-{
-    char        temp[256];
-    float       tempfloat;
-
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    if (img->mgrWork->isMetricUnits)
-    {
-        tempfloat = wvutilsConvertRainINToMetric (img->mgrWork->loopStore.dayET);
-
-        return (htmlGenPngBucket (temp,
-                          1,
-                          tempfloat,
-                          (float)GLB_HILOW_NONE,
-                          (float)GLB_HILOW_NONE,
-                          img->title,
-                          img->units,
-                          img->decimalPlaces,
-                          0.0,
-                          0.01,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-    }
-    else
-    {
-        return (htmlGenPngBucket (temp,
-                          0,
-                          img->mgrWork->loopStore.dayET,
-                          (float)GLB_HILOW_NONE,
-                          (float)GLB_HILOW_NONE,
-                          img->title,
-                          img->units,
-                          img->decimalPlaces,
-                          0.0,
-                          0.01,
-                          img->mgrWork->dateFormat,
-                          img->mgrWork->isDualUnits));
-    }
-}
-
-static int generateRadiationDay (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_radiation],
-                     6,
-                     0,
-                     10,
-                     10,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateRadiationWeek (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[WEEKLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->weekValues[DATA_INDEX_radiation][skipNo],
-                     7,
-                     0,
-                     100,
-                     100,
-                     labels,
-                     WEEKLY_NUM_VALUES-skipNo,
-                     WEEKLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateRadiationMonth (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->monthValues[DATA_INDEX_radiation][skipNo],
-                     14,
-                     0,
-                     100,
-                     100,
-                     labels,
-                     MONTHLY_NUM_VALUES-skipNo,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateRadiationYear (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_radiation],
-                     4,
-                     0,
-                     100,
-                     100,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-
-static int generateUVDay (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_UV],
-                     6,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateUVWeek (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[WEEKLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->weekValues[DATA_INDEX_UV][skipNo],
-                     7,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     WEEKLY_NUM_VALUES-skipNo,
-                     WEEKLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateUVMonth (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if ((i % 24) == 0)
-        {
-            if (loctime.tm_hour != 0)
-            {
-                // DST fall back nonsense:
-                ntime += WV_SECONDS_IN_HOUR;
-                localtime_r (&ntime, &loctime);
-            }
-        }
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     &img->mgrWork->monthValues[DATA_INDEX_UV][skipNo],
-                     14,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES-skipNo,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateUVYear (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_UV],
-                     4,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-
-static int generateETDay (HTML_IMG *img)
-{
-    int         i, j, skipNo = 0;
-    int         samplesInHour = (60/img->mgrWork->archiveInterval);
-    char        temp[256];
-    float       max = 0;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    j = img->mgrWork->dayStart;
-    while ((j % samplesInHour) != 0)
-    {
-        skipNo ++;
-        if (++ j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-    }
-
-    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork)-skipNo; i ++)
-    {
-        labels[i] = sampleHourLabels[j];
-
-        if (img->mgrWork->dayValues[DATA_INDEX_ET][i+skipNo] > max)
-            max = img->mgrWork->dayValues[DATA_INDEX_ET][i+skipNo];
-
-        if (++ j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-    }
-    
-    // tack on the extra label
-    labels[(DAILY_NUM_VALUES(img->mgrWork)-skipNo)] = sampleHourLabels[(DAILY_NUM_VALUES(img->mgrWork)-1)];
-
-    // add 2 to the skipNo since the VP console burps out ET at :00 -OR- :05 !!!
-    return (htmlGenPngBarChart (temp,
-                        img->mgrWork->isMetricUnits,
-                        &img->mgrWork->dayValues[DATA_INDEX_ET][skipNo+2],
-                        6,
-                        0,
-                        MAX(0.03,max),
-                        0.01,
-                        labels,
-                        DAILY_NUM_VALUES(img->mgrWork)-skipNo,
-                        img->title,
-                        img->units,
-                        img->decimalPlaces,
-                        60/img->mgrWork->archiveInterval,
-                        24,
-                        60/img->mgrWork->archiveInterval,
-                        img->mgrWork->dateFormat,
-                        img->mgrWork->isDualUnits));
-}
-
-static int generateETWeek (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[WEEKLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->weekStartTime_T;
-    struct tm   loctime;
-    float       max = 0;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    // kludge this for aggregate values
-    if (skipNo == 0)
-    {
-        // push forward one day
-        skipNo = 24;
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    for (i = 0; i < WEEKLY_NUM_VALUES-skipNo; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-        if (img->mgrWork->weekValues[DATA_INDEX_ET][i] > max)
-            max = img->mgrWork->weekValues[DATA_INDEX_ET][i];
-    }
-
-    // tack on the extra label
-    if (skipNo > 1)
-    {
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    localtime_r (&ntime, &loctime);
-    sprintf (lbls[WEEKLY_NUM_VALUES-skipNo], "%d", loctime.tm_mday);
-    labels[WEEKLY_NUM_VALUES-skipNo] = lbls[WEEKLY_NUM_VALUES-skipNo];
-
-    return (htmlGenPngBarChart (temp,
-                        img->mgrWork->isMetricUnits,
-                        &img->mgrWork->weekValues[DATA_INDEX_ET][skipNo],
-                        7,
-                        0,
-                        MAX(0.03,max),
-                        0.01,
-                        labels,
-                        WEEKLY_NUM_VALUES-skipNo,
-                        img->title,
-                        img->units,
-                        img->decimalPlaces,
-                        24,
-                        7,
-                        24,
-                        img->mgrWork->dateFormat,
-                        img->mgrWork->isDualUnits));
-}
-
-static int generateETMonth (HTML_IMG *img)
-{
-    int         i, skipNo;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-    float       max = 0;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_hour == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_HOUR;
-        }
-    }
-
-    // kludge this for aggregate values
-    if (skipNo == 0)
-    {
-        // push forward one day
-        skipNo = 24;
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    for (i = 0; i < MONTHLY_NUM_VALUES-skipNo; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_HOUR;
-        if (img->mgrWork->monthValues[DATA_INDEX_ET][i] > max)
-            max = img->mgrWork->monthValues[DATA_INDEX_ET][i];
-    }
-
-    // tack on the extra label
-    if (skipNo > 1)
-    {
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    localtime_r (&ntime, &loctime);
-    sprintf (lbls[MONTHLY_NUM_VALUES-skipNo], "%d", loctime.tm_mday);
-    labels[MONTHLY_NUM_VALUES-skipNo] = lbls[MONTHLY_NUM_VALUES-skipNo];
-
-    return (htmlGenPngBarChart (temp,
-                        img->mgrWork->isMetricUnits,
-                        &img->mgrWork->monthValues[DATA_INDEX_ET][skipNo],
-                        14,
-                        0,
-                        MAX(0.03,max),
-                        0.01,
-                        labels,
-                        MONTHLY_NUM_VALUES-skipNo,
-                        img->title,
-                        img->units,
-                        img->decimalPlaces,
-                        24,
-                        28,
-                        24,
-                        img->mgrWork->dateFormat,
-                        img->mgrWork->isDualUnits));
-}
-
-static int generateETYear (HTML_IMG *img)
-{
-    int         i, j, skipNo;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-    float       max = 0;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    // move forward 1 day to land on 52 weeks ago
-    ntime += WV_SECONDS_IN_DAY;
-    skipNo = 1;
-    
-    // if we are sitting on Sunday, bump it another day
-    localtime_r (&ntime, &loctime);
-    if (loctime.tm_wday == 0)
-    {
-        ntime += WV_SECONDS_IN_DAY;
-        skipNo ++;
-    }
-    
-    // move to the next Sunday
-    for (i = 0; i < 7; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_wday == 0)
-        {
-            break;
-        }
-        else
-        {
-            skipNo ++;
-            ntime += WV_SECONDS_IN_DAY;
-        }
-    }
-
-    for (i = 0; i < YEARLY_NUM_VALUES-skipNo; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-
-        ntime += WV_SECONDS_IN_DAY;
-        if (img->mgrWork->yearValues[DATA_INDEX_ET][i] > max)
-            max = img->mgrWork->yearValues[DATA_INDEX_ET][i];
-    }
-
-    for (j = 0; j < 7; j ++)
-    {
-        localtime_r (&ntime, &loctime);
-        if (loctime.tm_wday == 0)
-        {
-            break;
-        }
-        else
-        {
-            ntime += WV_SECONDS_IN_DAY;
-        }
-    }
-    
-    localtime_r (&ntime, &loctime);
-    sprintf (lbls[YEARLY_NUM_VALUES-skipNo], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-    labels[YEARLY_NUM_VALUES-skipNo] = lbls[YEARLY_NUM_VALUES-skipNo];
-
-    return (htmlGenPngBarChart (temp,
-                        img->mgrWork->isMetricUnits,
-                        &img->mgrWork->yearValues[DATA_INDEX_ET][skipNo],
-                        4,
-                        0,
-                        MAX(0.3,max),
-                        0.1,
-                        labels,
-                        YEARLY_NUM_VALUES-skipNo,
-                        img->title,
-                        img->units,
-                        img->decimalPlaces,
-                        7,
-                        52,
-                        7,
-                        img->mgrWork->dateFormat,
-                        img->mgrWork->isDualUnits));
-}
-
-
-static int generateLeafTemp1Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_leafTemp1],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateLeafTemp1Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_leafTemp1],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateLeafTemp1Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_leafTemp1],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-
-static int generateLeafTemp2Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_leafTemp2],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateLeafTemp2Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_leafTemp2],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateLeafTemp2Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_leafTemp2],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-
-static int generateLeafWetness1Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_leafWet1],
-                     6,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateLeafWetness1Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_leafWet1],
-                     14,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-
-    return OK;
-}
-
-static int generateLeafWetness1Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_leafWet1],
-                     4,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-
-static int generateLeafWetness2Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_leafWet2],
-                     6,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateLeafWetness2Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_leafWet2],
-                     14,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateLeafWetness2Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_leafWet2],
-                     4,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-
-static int generateSoilTemp1Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_soilTemp1],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateSoilTemp1Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_soilTemp1],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateSoilTemp1Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_soilTemp1],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-
-static int generateSoilTemp2Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_soilTemp2],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateSoilTemp2Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_soilTemp2],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateSoilTemp2Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_soilTemp2],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-
-static int generateSoilTemp3Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_soilTemp3],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateSoilTemp3Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_soilTemp3],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateSoilTemp3Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_soilTemp3],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-
-static int generateSoilTemp4Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_soilTemp4],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateSoilTemp4Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_soilTemp4],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateSoilTemp4Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_soilTemp4],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-
-static int generateExtraHumid1Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            img->mgrWork->dayValues[DATA_INDEX_extraHumid1],
-                            6,
-                            labels,
-                            DAILY_NUM_VALUES(img->mgrWork),
-                            DAILY_NUM_VALUES(img->mgrWork),
-                            img->title,
-                            img->mgrWork->dateFormat));
-}
-
-static int generateExtraHumid1Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            img->mgrWork->monthValues[DATA_INDEX_extraHumid1],
-                            14,
-                            labels,
-                            MONTHLY_NUM_VALUES,
-                            MONTHLY_NUM_VALUES,
-                            img->title,
-                            img->mgrWork->dateFormat));
-}
-
-static int generateExtraHumid1Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            img->mgrWork->yearValues[DATA_INDEX_extraHumid1],
-                            4,
-                            labels,
-                            YEARLY_NUM_VALUES,
-                            YEARLY_NUM_VALUES,
-                            img->title,
-                            img->mgrWork->dateFormat));
-}
-
-
-static int generateExtraHumid2Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            img->mgrWork->dayValues[DATA_INDEX_extraHumid2],
-                            6,
-                            labels,
-                            DAILY_NUM_VALUES(img->mgrWork),
-                            DAILY_NUM_VALUES(img->mgrWork),
-                            img->title,
-                            img->mgrWork->dateFormat));
-}
-
-static int generateExtraHumid2Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            img->mgrWork->monthValues[DATA_INDEX_extraHumid2],
-                            14,
-                            labels,
-                            MONTHLY_NUM_VALUES,
-                            MONTHLY_NUM_VALUES,
-                            img->title,
-                            img->mgrWork->dateFormat));
-}
-
-static int generateExtraHumid2Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            img->mgrWork->yearValues[DATA_INDEX_extraHumid2],
-                            4,
-                            labels,
-                            YEARLY_NUM_VALUES,
-                            YEARLY_NUM_VALUES,
-                            img->title,
-                            img->mgrWork->dateFormat));
-}
-
-
-static int generateExtraTemp1Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_extraTemp1],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateExtraTemp1Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_extraTemp1],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateExtraTemp1Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_extraTemp1],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-
-static int generateExtraTemp2Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_extraTemp2],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateExtraTemp2Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
-
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
+    // if there is no data yet, pick default min/max
+    if (min > max)
+    {
+        min = CHART_MIN_WSPEED(img->mgrWork->isMetricUnits);
+        max = CHART_MAX_WSPEED(img->mgrWork->isMetricUnits);
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_extraTemp2],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          14,
+                          min,
+                          max,
+                          1.0,
+                          labels,
+                          MONTHLY_NUM_VALUES-skipNo,
+                          MONTHLY_NUM_VALUES,
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
-static int generateExtraTemp2Year (HTML_IMG *img)
+static int generateCompositeWindYear (HTML_IMG *img)
 {
     int         i;
     char        lbls[YEARLY_NUM_VALUES][8];
     char        temp[256];
     time_t      ntime = img->mgrWork->yearStartTime_T;
     struct tm   loctime;
+    MC_DATASET  datasets[2];
+    float       min = 10000.0, max = -10000.0;
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
     {
         // nothing for us here
         return ERROR_ABORT;
     }
-    
+
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    ntime += 4*WV_SECONDS_IN_HOUR;
     for (i = 0; i < YEARLY_NUM_VALUES; i ++)
     {
         localtime_r (&ntime, &loctime);
@@ -6283,274 +2532,162 @@ static int generateExtraTemp2Year (HTML_IMG *img)
         ntime += WV_SECONDS_IN_DAY;
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_extraTemp2],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-
-static int generateExtraTemp3Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
+    datasets[0].lineColor = htmlgenGetChartDefaultLine();
+    datasets[1].lineColor = htmlgenGetChartDefaultSecondLine();
 
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
+    memset (datasets[0].legend, 0, 16);
+    memset (datasets[1].legend, 0, 16);
+    for (i = 0; i < 15 && i < strlen (img->title); i ++)
     {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
+        if (img->title[i] == '/')
+            break;
 
-        labels[i] = sampleLabels[j];
+        datasets[0].legend[i] = img->title[i];
     }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_extraTemp3],
-                     6,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
-
-static int generateExtraTemp3Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
+    if (i < strlen (img->title) - 1)
     {
-        // nothing for us here
-        return ERROR_ABORT;
+        strncpy (datasets[1].legend, &img->title[i+1], 15);
     }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
+    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
     {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
+        datasets[0].valueset[i] = YEAR_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        datasets[1].valueset[i] = YEAR_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_extraTemp3],
-                     14,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
-}
+        if (YEAR_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] == ARCHIVE_VALUE_NULL ||
+            YEAR_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] == ARCHIVE_VALUE_NULL)
+        {
+            continue;
+        }
 
-static int generateExtraTemp3Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
+        if (YEAR_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] < min)
+            min = YEAR_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        if (YEAR_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] < min)
+            min = YEAR_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
+        if (YEAR_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i] > max)
+            max = YEAR_VALUES(img->mgrWork, DATA_INDEX_windSpeed)[i];
+        if (YEAR_VALUES(img->mgrWork, DATA_INDEX_windGust)[i] > max)
+            max = YEAR_VALUES(img->mgrWork, DATA_INDEX_windGust)[i];
     }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
+    // if there is no data yet, pick default min/max
+    if (min > max)
     {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
+        min = CHART_MIN_WSPEED(img->mgrWork->isMetricUnits);
+        max = CHART_MAX_WSPEED(img->mgrWork->isMetricUnits);
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_extraTemp3],
-                     4,
-                     CHART_MIN_TEMP(img->mgrWork->isMetricUnits),
-                     CHART_MAX_TEMP(img->mgrWork->isMetricUnits),
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     img->mgrWork->isDualUnits));
+    return (htmlGenPngMultiChart (temp,
+                          img->mgrWork->isMetricUnits,
+                          datasets,
+                          2,
+                          4,
+                          min,
+                          max,
+                          1.0,
+                          labels,
+                          YEARLY_NUM_VALUES,
+                          YEARLY_NUM_VALUES,
+                          img->units,
+                          img->decimalPlaces,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
 }
 
+//////////////////////////////////////////////////////////////////////////////
+//////////////  E X T E N D E D   D A T A   B E G I N  ///////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// first a few buckets for common extended items
 
-static int generateSoilMoisture1Day (HTML_IMG *img)
+static int generateUV (HTML_IMG *img)
 {
-    int         i, j;
     char        temp[256];
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_soilMoist1],
-                     6,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
+    return (htmlGenPngBucket (temp,
+                      0,
+                      (float)img->mgrWork->loopStore.UV,
+                      (float)GLB_HILOW_NONE,
+                      (float)GLB_HILOW_NONE,
+                      img->title,
+                      img->units,
+                      img->decimalPlaces,
+                      0.0,
+                      4.0,
+                      img->mgrWork->dateFormat,
+                      img->mgrWork->isDualUnits));
 }
 
-static int generateSoilMoisture1Month (HTML_IMG *img)
+static int generateRadiation (HTML_IMG *img)
 {
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
     char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
-    {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_soilMoist1],
-                     14,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
+    return (htmlGenPngBucket (temp,
+                      0,
+                      (float)img->mgrWork->loopStore.radiation,
+                      (float)GLB_HILOW_NONE,
+                      (float)GLB_HILOW_NONE,
+                      img->title,
+                      img->units,
+                      img->decimalPlaces,
+                      0.0,
+                      4.0,
+                      img->mgrWork->dateFormat,
+                      img->mgrWork->isDualUnits));
 }
 
-static int generateSoilMoisture1Year (HTML_IMG *img)
+static int generateET (HTML_IMG *img)
 {
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
     char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
+    float       tempfloat;
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
+    if (img->mgrWork->isMetricUnits)
     {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
+        tempfloat = wvutilsConvertRainINToMetric (img->mgrWork->loopStore.dayET);
+
+        return (htmlGenPngBucket (temp,
+                          1,
+                          tempfloat,
+                          (float)GLB_HILOW_NONE,
+                          (float)GLB_HILOW_NONE,
+                          img->title,
+                          img->units,
+                          img->decimalPlaces,
+                          0.0,
+                          0.01,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
+    }
+    else
+    {
+        return (htmlGenPngBucket (temp,
+                          0,
+                          img->mgrWork->loopStore.dayET,
+                          (float)GLB_HILOW_NONE,
+                          (float)GLB_HILOW_NONE,
+                          img->title,
+                          img->units,
+                          img->decimalPlaces,
+                          0.0,
+                          0.01,
+                          img->mgrWork->dateFormat,
+                          img->mgrWork->isDualUnits));
     }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_soilMoist1],
-                     4,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
 }
 
-
-static int generateSoilMoisture2Day (HTML_IMG *img)
+static int generateETDay (HTML_IMG *img)
 {
-    int         i, j;
+    int         i, j, skipNo = 0;
+    int         samplesInHour = (60/img->mgrWork->archiveInterval);
     char        temp[256];
+    float       max = 0;
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
     {
@@ -6560,39 +2697,56 @@ static int generateSoilMoisture2Day (HTML_IMG *img)
     
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
+    j = img->mgrWork->dayStart;
+    while ((j % samplesInHour) != 0)
     {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
+        skipNo ++;
+        if (++ j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
             j = 0;
+    }
 
-        labels[i] = sampleLabels[j];
+    for (i = 0; i < DAILY_NUM_VALUES(img->mgrWork)-skipNo; i ++)
+    {
+        labels[i] = sampleHourLabels[j];
+
+        if (DAY_VALUES(img->mgrWork, DATA_INDEX_ET)[i+skipNo] > max)
+            max = DAY_VALUES(img->mgrWork, DATA_INDEX_ET)[i+skipNo];
+
+        if (++ j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
+            j = 0;
     }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
     
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_soilMoist2],
-                     6,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
+    // tack on the extra label
+    labels[(DAILY_NUM_VALUES(img->mgrWork)-skipNo)] = sampleHourLabels[(DAILY_NUM_VALUES(img->mgrWork)-1)];
+
+    // add 2 to the skipNo since the VP console burps out ET at :00 -OR- :05 !!!
+    return (htmlGenPngBarChart (temp,
+                        img->mgrWork->isMetricUnits,
+                        &DAY_VALUES(img->mgrWork, DATA_INDEX_ET)[skipNo+2],
+                        6,
+                        0,
+                        MAX(0.03,max),
+                        0.01,
+                        labels,
+                        DAILY_NUM_VALUES(img->mgrWork)-skipNo,
+                        img->title,
+                        img->units,
+                        img->decimalPlaces,
+                        60/img->mgrWork->archiveInterval,
+                        24,
+                        60/img->mgrWork->archiveInterval,
+                        img->mgrWork->dateFormat,
+                        img->mgrWork->isDualUnits));
 }
 
-static int generateSoilMoisture2Month (HTML_IMG *img)
+static int generateETWeek (HTML_IMG *img)
 {
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
+    int         i, skipNo;
+    char        lbls[WEEKLY_NUM_VALUES][8];
     char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
+    time_t      ntime = img->mgrWork->weekStartTime_T;
     struct tm   loctime;
+    float       max = 0;
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
@@ -6602,120 +2756,76 @@ static int generateSoilMoisture2Month (HTML_IMG *img)
     
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
+    for (i = 0, skipNo = 0; i < WEEKLY_NUM_VALUES; i ++)
     {
         localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
+        if (loctime.tm_hour == 0)
+        {
+            break;
+        }
+        else
+        {
+            skipNo ++;
+            ntime += WV_SECONDS_IN_HOUR;
+        }
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_soilMoist2],
-                     14,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateSoilMoisture2Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
+    // kludge this for aggregate values
+    if (skipNo == 0)
     {
-        // nothing for us here
-        return ERROR_ABORT;
+        // push forward one day
+        skipNo = 24;
+        ntime += WV_SECONDS_IN_DAY;
     }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
+    for (i = 0; i < WEEKLY_NUM_VALUES-skipNo; i ++)
     {
         localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
+        sprintf (lbls[i], "%d", loctime.tm_mday);
         labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_soilMoist2],
-                     4,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
 
+        ntime += WV_SECONDS_IN_HOUR;
+        if (WEEK_VALUES(img->mgrWork, DATA_INDEX_ET)[i] > max)
+            max = WEEK_VALUES(img->mgrWork, DATA_INDEX_ET)[i];
+    }
 
-static int generateSoilMoisture3Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
+    // tack on the extra label
+    if (skipNo > 1)
     {
-        // nothing for us here
-        return ERROR_ABORT;
+        ntime += WV_SECONDS_IN_DAY;
     }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
+    localtime_r (&ntime, &loctime);
+    sprintf (lbls[WEEKLY_NUM_VALUES-skipNo], "%d", loctime.tm_mday);
+    labels[WEEKLY_NUM_VALUES-skipNo] = lbls[WEEKLY_NUM_VALUES-skipNo];
 
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_soilMoist3],
-                     6,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
+    return (htmlGenPngBarChart (temp,
+                        img->mgrWork->isMetricUnits,
+                        &WEEK_VALUES(img->mgrWork, DATA_INDEX_ET)[skipNo],
+                        7,
+                        0,
+                        MAX(0.03,max),
+                        0.01,
+                        labels,
+                        WEEKLY_NUM_VALUES-skipNo,
+                        img->title,
+                        img->units,
+                        img->decimalPlaces,
+                        24,
+                        7,
+                        24,
+                        img->mgrWork->dateFormat,
+                        img->mgrWork->isDualUnits));
 }
 
-static int generateSoilMoisture3Month (HTML_IMG *img)
+static int generateETMonth (HTML_IMG *img)
 {
-    int         i;
+    int         i, skipNo;
     char        lbls[MONTHLY_NUM_VALUES][8];
     char        temp[256];
     time_t      ntime = img->mgrWork->monthStartTime_T;
     struct tm   loctime;
+    float       max = 0;
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
     {
@@ -6725,161 +2835,76 @@ static int generateSoilMoisture3Month (HTML_IMG *img)
     
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
+    for (i = 0, skipNo = 0; i < MONTHLY_NUM_VALUES; i ++)
     {
         localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
+        if (loctime.tm_hour == 0)
+        {
+            break;
+        }
+        else
+        {
+            skipNo ++;
+            ntime += WV_SECONDS_IN_HOUR;
+        }
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_soilMoist3],
-                     14,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateSoilMoisture3Year (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[YEARLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->yearStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
+    // kludge this for aggregate values
+    if (skipNo == 0)
     {
-        // nothing for us here
-        return ERROR_ABORT;
+        // push forward one day
+        skipNo = 24;
+        ntime += WV_SECONDS_IN_DAY;
     }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
+    for (i = 0; i < MONTHLY_NUM_VALUES-skipNo; i ++)
     {
         localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
+        sprintf (lbls[i], "%d", loctime.tm_mday);
         labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_DAY;
-    }
-
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_soilMoist3],
-                     4,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-
-static int generateSoilMoisture4Day (HTML_IMG *img)
-{
-    int         i, j;
-    char        temp[256];
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
-    }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
-    {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
-
-        labels[i] = sampleLabels[j];
-    }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
-    
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->dayValues[DATA_INDEX_soilMoist4],
-                     6,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     DAILY_NUM_VALUES(img->mgrWork),
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
-}
-
-static int generateSoilMoisture4Month (HTML_IMG *img)
-{
-    int         i;
-    char        lbls[MONTHLY_NUM_VALUES][8];
-    char        temp[256];
-    time_t      ntime = img->mgrWork->monthStartTime_T;
-    struct tm   loctime;
-
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_HOUR))
-    {
-        // nothing for us here
-        return ERROR_ABORT;
+        ntime += WV_SECONDS_IN_HOUR;
+        if (MONTH_VALUES(img->mgrWork, DATA_INDEX_ET)[i] > max)
+            max = MONTH_VALUES(img->mgrWork, DATA_INDEX_ET)[i];
     }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0; i < MONTHLY_NUM_VALUES; i ++)
+    // tack on the extra label
+    if (skipNo > 1)
     {
-        localtime_r (&ntime, &loctime);
-        sprintf (lbls[i], "%d", loctime.tm_mday);
-        labels[i] = lbls[i];
-        ntime += WV_SECONDS_IN_HOUR;
+        ntime += WV_SECONDS_IN_DAY;
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->monthValues[DATA_INDEX_soilMoist4],
-                     14,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     MONTHLY_NUM_VALUES,
-                     MONTHLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
+    localtime_r (&ntime, &loctime);
+    sprintf (lbls[MONTHLY_NUM_VALUES-skipNo], "%d", loctime.tm_mday);
+    labels[MONTHLY_NUM_VALUES-skipNo] = lbls[MONTHLY_NUM_VALUES-skipNo];
+
+    return (htmlGenPngBarChart (temp,
+                        img->mgrWork->isMetricUnits,
+                        &MONTH_VALUES(img->mgrWork, DATA_INDEX_ET)[skipNo],
+                        14,
+                        0,
+                        MAX(0.03,max),
+                        0.01,
+                        labels,
+                        MONTHLY_NUM_VALUES-skipNo,
+                        img->title,
+                        img->units,
+                        img->decimalPlaces,
+                        24,
+                        28,
+                        24,
+                        img->mgrWork->dateFormat,
+                        img->mgrWork->isDualUnits));
 }
 
-static int generateSoilMoisture4Year (HTML_IMG *img)
+static int generateETYear (HTML_IMG *img)
 {
-    int         i;
+    int         i, j, skipNo;
     char        lbls[YEARLY_NUM_VALUES][8];
     char        temp[256];
     time_t      ntime = img->mgrWork->yearStartTime_T;
     struct tm   loctime;
+    float       max = 0;
 
     if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_DAY))
     {
@@ -6889,32 +2914,81 @@ static int generateSoilMoisture4Year (HTML_IMG *img)
     
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    ntime += 4*WV_SECONDS_IN_HOUR;
-    for (i = 0; i < YEARLY_NUM_VALUES; i ++)
+    // move forward 1 day to land on 52 weeks ago
+    ntime += WV_SECONDS_IN_DAY;
+    skipNo = 1;
+    
+    // if we are sitting on Sunday, bump it another day
+    localtime_r (&ntime, &loctime);
+    if (loctime.tm_wday == 0)
+    {
+        ntime += WV_SECONDS_IN_DAY;
+        skipNo ++;
+    }
+    
+    // move to the next Sunday
+    for (i = 0; i < 7; i ++)
+    {
+        localtime_r (&ntime, &loctime);
+        if (loctime.tm_wday == 0)
+        {
+            break;
+        }
+        else
+        {
+            skipNo ++;
+            ntime += WV_SECONDS_IN_DAY;
+        }
+    }
+
+    for (i = 0; i < YEARLY_NUM_VALUES-skipNo; i ++)
     {
         localtime_r (&ntime, &loctime);
         sprintf (lbls[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
         labels[i] = lbls[i];
+
         ntime += WV_SECONDS_IN_DAY;
+        if (YEAR_VALUES(img->mgrWork, DATA_INDEX_ET)[i] > max)
+            max = YEAR_VALUES(img->mgrWork, DATA_INDEX_ET)[i];
     }
 
-    return (htmlGenPngChart (temp,
-                     img->mgrWork->isMetricUnits,
-                     img->mgrWork->yearValues[DATA_INDEX_soilMoist4],
-                     4,
-                     0,
-                     5,
-                     1.0,
-                     labels,
-                     YEARLY_NUM_VALUES,
-                     YEARLY_NUM_VALUES,
-                     img->title,
-                     img->units,
-                     img->decimalPlaces,
-                     img->mgrWork->dateFormat,
-                     0));
+    for (j = 0; j < 7; j ++)
+    {
+        localtime_r (&ntime, &loctime);
+        if (loctime.tm_wday == 0)
+        {
+            break;
+        }
+        else
+        {
+            ntime += WV_SECONDS_IN_DAY;
+        }
+    }
+    
+    localtime_r (&ntime, &loctime);
+    sprintf (lbls[YEARLY_NUM_VALUES-skipNo], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
+    labels[YEARLY_NUM_VALUES-skipNo] = lbls[YEARLY_NUM_VALUES-skipNo];
+
+    return (htmlGenPngBarChart (temp,
+                        img->mgrWork->isMetricUnits,
+                        &YEAR_VALUES(img->mgrWork, DATA_INDEX_ET)[skipNo],
+                        4,
+                        0,
+                        MAX(0.3,max),
+                        0.1,
+                        labels,
+                        YEARLY_NUM_VALUES-skipNo,
+                        img->title,
+                        img->units,
+                        img->decimalPlaces,
+                        7,
+                        52,
+                        7,
+                        img->mgrWork->dateFormat,
+                        img->mgrWork->isDualUnits));
 }
 
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////  E X T E N D E D   D A T A   E N D      ///////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -7036,7 +3110,7 @@ static int generateWindroseDay (HTML_IMG *img)
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
     retVal = htmlGenPngDialWindRose (temp,
-                                     img->mgrWork->dayValues[DATA_INDEX_windDir],
+                                     DAY_VALUES(img->mgrWork, DATA_INDEX_windDir),
                                      DAILY_NUM_VALUES(img->mgrWork),
                                      img->title,
                                      WR_SAMPLE_WIDTH_DAY);
@@ -7075,7 +3149,7 @@ static int generateWindroseWeek (HTML_IMG *img)
     }
 
     retVal = htmlGenPngDialWindRose (temp,
-                                     &img->mgrWork->weekValues[DATA_INDEX_windDir][skipNo],
+                                     &WEEK_VALUES(img->mgrWork, DATA_INDEX_windDir)[skipNo],
                                      WEEKLY_NUM_VALUES - skipNo,
                                      img->title,
                                      WR_SAMPLE_WIDTH_WEEK);
@@ -7114,7 +3188,7 @@ static int generateWindroseMonth (HTML_IMG *img)
     }
 
     retVal = htmlGenPngDialWindRose (temp,
-                                     &img->mgrWork->monthValues[DATA_INDEX_windDir][skipNo],
+                                     &MONTH_VALUES(img->mgrWork, DATA_INDEX_windDir)[skipNo],
                                      MONTHLY_NUM_VALUES - skipNo,
                                      img->title,
                                      WR_SAMPLE_WIDTH_MONTH);
@@ -7136,7 +3210,7 @@ static int generateWindroseYear (HTML_IMG *img)
     sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
     retVal = htmlGenPngDialWindRose (temp,
-                                     img->mgrWork->yearValues[DATA_INDEX_windDir],
+                                     YEAR_VALUES(img->mgrWork, DATA_INDEX_windDir),
                                      YEARLY_NUM_VALUES,
                                      img->title,
                                      WR_SAMPLE_WIDTH_YEAR);
@@ -7159,8 +3233,8 @@ static int generateWindroseDay (HTML_IMG *img)
 
     return (htmlGenPngWindRoseSmall(temp,
                                     img->mgrWork->isMetricUnits,
-                                    img->mgrWork->dayValues[DATA_INDEX_windSpeed],
-                                    img->mgrWork->dayValues[DATA_INDEX_windDir],
+                                    DAY_VALUES(img->mgrWork, DATA_INDEX_windSpeed),
+                                    DAY_VALUES(img->mgrWork, DATA_INDEX_windDir),
                                     DAILY_NUM_VALUES(img->mgrWork),
                                     start,
                                     time(NULL),
@@ -7176,8 +3250,8 @@ static int generateWindroseWeek (HTML_IMG *img)
 
     return (htmlGenPngWindRoseSmall(temp,
                                     img->mgrWork->isMetricUnits,
-                                    img->mgrWork->weekValues[DATA_INDEX_windSpeed],
-                                    img->mgrWork->weekValues[DATA_INDEX_windDir],
+                                    WEEK_VALUES(img->mgrWork, DATA_INDEX_windSpeed),
+                                    WEEK_VALUES(img->mgrWork, DATA_INDEX_windDir),
                                     WEEKLY_NUM_VALUES,
                                     start,
                                     time(NULL),
@@ -7199,8 +3273,8 @@ static int generateWindroseMonth (HTML_IMG *img)
 
     return (htmlGenPngWindRoseSmall(temp,
                                     img->mgrWork->isMetricUnits,
-                                    img->mgrWork->monthValues[DATA_INDEX_windSpeed],
-                                    img->mgrWork->monthValues[DATA_INDEX_windDir],
+                                    MONTH_VALUES(img->mgrWork, DATA_INDEX_windSpeed),
+                                    MONTH_VALUES(img->mgrWork, DATA_INDEX_windDir),
                                     MONTHLY_NUM_VALUES,
                                     start,
                                     time(NULL),
@@ -7221,8 +3295,8 @@ static int generateWindroseYear (HTML_IMG *img)
 
     return (htmlGenPngWindRoseSmall(temp,
                                     img->mgrWork->isMetricUnits,
-                                    img->mgrWork->yearValues[DATA_INDEX_windSpeed],
-                                    img->mgrWork->yearValues[DATA_INDEX_windDir],
+                                    YEAR_VALUES(img->mgrWork, DATA_INDEX_windSpeed),
+                                    YEAR_VALUES(img->mgrWork, DATA_INDEX_windDir),
                                     YEARLY_NUM_VALUES,
                                     start,
                                     time(NULL),
@@ -7244,8 +3318,8 @@ static int generateWindroseBigDay (HTML_IMG *img)
 
     return (htmlGenPngWindRoseBig(temp,
                                   img->mgrWork->isMetricUnits,
-                                  img->mgrWork->dayValues[DATA_INDEX_windSpeed],
-                                  img->mgrWork->dayValues[DATA_INDEX_windDir],
+                                  DAY_VALUES(img->mgrWork, DATA_INDEX_windSpeed),
+                                  DAY_VALUES(img->mgrWork, DATA_INDEX_windDir),
                                   DAILY_NUM_VALUES(img->mgrWork),
                                   start,
                                   time(NULL),
@@ -7261,8 +3335,8 @@ static int generateWindroseBigWeek (HTML_IMG *img)
 
     return (htmlGenPngWindRoseBig(temp,
                                   img->mgrWork->isMetricUnits,
-                                  img->mgrWork->weekValues[DATA_INDEX_windSpeed],
-                                  img->mgrWork->weekValues[DATA_INDEX_windDir],
+                                  WEEK_VALUES(img->mgrWork, DATA_INDEX_windSpeed),
+                                  WEEK_VALUES(img->mgrWork, DATA_INDEX_windDir),
                                   WEEKLY_NUM_VALUES,
                                   start,
                                   time(NULL),
@@ -7284,8 +3358,8 @@ static int generateWindroseBigMonth (HTML_IMG *img)
 
     return (htmlGenPngWindRoseBig(temp,
                                   img->mgrWork->isMetricUnits,
-                                  img->mgrWork->monthValues[DATA_INDEX_windSpeed],
-                                  img->mgrWork->monthValues[DATA_INDEX_windDir],
+                                  MONTH_VALUES(img->mgrWork, DATA_INDEX_windSpeed),
+                                  MONTH_VALUES(img->mgrWork, DATA_INDEX_windDir),
                                   MONTHLY_NUM_VALUES,
                                   start,
                                   time(NULL),
@@ -7306,8 +3380,8 @@ static int generateWindroseBigYear (HTML_IMG *img)
 
     return (htmlGenPngWindRoseBig(temp,
                                   img->mgrWork->isMetricUnits,
-                                  img->mgrWork->yearValues[DATA_INDEX_windSpeed],
-                                  img->mgrWork->yearValues[DATA_INDEX_windDir],
+                                  YEAR_VALUES(img->mgrWork, DATA_INDEX_windSpeed),
+                                  YEAR_VALUES(img->mgrWork, DATA_INDEX_windDir),
                                   YEARLY_NUM_VALUES,
                                   start,
                                   time(NULL),
@@ -7322,44 +3396,224 @@ static int generateWindroseBigYear (HTML_IMG *img)
 
 
 //////////////////////////////////////////////////////////////////////////////
-//////////////  D I A G N O S T I C S   S T A R T      ///////////////////////
+//////////////  G E N E R I C   C H A R T S   S T A R T    ///////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-static int generateRxCheck (HTML_IMG *img)
+//  ... The single-field day/week/month/year charts are all drawn by
+//  ... imagesGenerateChart from an HTML_CHART (field, span, kind, scale);
+//  ... the built-in ones come from images_charts below, others can be given
+//  ... in images.conf as "chart:<field>:<span>:<scale>[:dual]".
+
+//  ... the x-axis labels of a span; built when the span start moves and then
+//  ... shared by every chart of that span
+typedef struct
 {
-    int         i, j;
-    char        temp[256];
+    int         isValid;
+    time_t      start;                  // dayStart for the day span
+    int         numValues;
+    int         skip;                   // leading values before midnight
+    char        *labels[MAX_DAILY_NUM_VALUES];
+    char        text[MONTHLY_NUM_VALUES][8];
+} CHART_LABELS;
 
-    if (!(img->mgrWork->newArchiveMask & NEW_ARCHIVE_SAMPLE))
+static CHART_LABELS chartLabels[HTML_CHART_SPAN_MAX];
+
+static char *chartSpanNames[HTML_CHART_SPAN_MAX] =
+    {
+        "day", "week", "month", "year"
+    };
+
+static int chartArchiveMask[HTML_CHART_SPAN_MAX] =
+    {
+        NEW_ARCHIVE_SAMPLE, NEW_ARCHIVE_HOUR, NEW_ARCHIVE_HOUR, NEW_ARCHIVE_DAY
+    };
+
+static int chartHashes[HTML_CHART_SPAN_MAX] =
+    {
+        6, 7, 14, 4
+    };
+
+
+static CHART_LABELS *getChartLabels (HTML_MGR_ID mgr, HTML_CHART_SPAN span)
+{
+    CHART_LABELS    *set = &chartLabels[span];
+    int             i, j, numValues;
+    time_t          start, ntime;
+    struct tm       loctime;
+
+    switch (span)
+    {
+        case HTML_CHART_SPAN_DAY:
+            start = mgr->dayStart;
+            numValues = DAILY_NUM_VALUES(mgr);
+            break;
+        case HTML_CHART_SPAN_WEEK:
+            start = mgr->weekStartTime_T;
+            numValues = WEEKLY_NUM_VALUES;
+            break;
+        case HTML_CHART_SPAN_MONTH:
+            start = mgr->monthStartTime_T;
+            numValues = MONTHLY_NUM_VALUES;
+            break;
+        default:
+            start = mgr->yearStartTime_T;
+            numValues = YEARLY_NUM_VALUES;
+            break;
+    }
+
+    if (set->isValid && set->start == start && set->numValues == numValues)
+    {
+        // still current
+        return set;
+    }
+
+    set->skip = 0;
+
+    switch (span)
+    {
+        case HTML_CHART_SPAN_DAY:
+            // point into the sample labels (they are updated in place):
+            for (i = 0, j = mgr->dayStart; i < numValues - 1; i ++, j ++)
+            {
+                if (j >= numValues - 1)
+                    j = 0;
+
+                set->labels[i] = sampleLabels[j];
+            }
+            set->labels[i] = sampleLabels[numValues - 1];
+            break;
+
+        case HTML_CHART_SPAN_WEEK:
+        case HTML_CHART_SPAN_MONTH:
+            // start the chart at the first midnight:
+            ntime = start;
+            for (i = 0; i < numValues; i ++)
+            {
+                localtime_r (&ntime, &loctime);
+                if (loctime.tm_hour == 0)
+                {
+                    break;
+                }
+
+                set->skip ++;
+                ntime += WV_SECONDS_IN_HOUR;
+            }
+
+            for (i = 0; i < numValues; i ++)
+            {
+                localtime_r (&ntime, &loctime);
+                if ((i % 24) == 0)
+                {
+                    if (loctime.tm_hour != 0)
+                    {
+                        // DST fall back nonsense:
+                        ntime += WV_SECONDS_IN_HOUR;
+                        localtime_r (&ntime, &loctime);
+                    }
+                }
+                sprintf (set->text[i], "%d", loctime.tm_mday);
+                set->labels[i] = set->text[i];
+
+                ntime += WV_SECONDS_IN_HOUR;
+            }
+            break;
+
+        default:
+            ntime = start + (4*WV_SECONDS_IN_HOUR);
+            for (i = 0; i < numValues; i ++)
+            {
+                localtime_r (&ntime, &loctime);
+                sprintf (set->text[i], "%s %d", monthLabels[loctime.tm_mon], loctime.tm_mday);
+                set->labels[i] = set->text[i];
+                ntime += WV_SECONDS_IN_DAY;
+            }
+            break;
+    }
+
+    set->start      = start;
+    set->numValues  = numValues;
+    set->isValid    = TRUE;
+    return set;
+}
+
+int imagesGenerateChart (HTML_IMG *img)
+{
+    HTML_MGR_ID     mgr = img->mgrWork;
+    HTML_CHART      *chart = &img->chart;
+    CHART_LABELS    *set;
+    float           *values;
+    float           min, max;
+    char            temp[256];
+
+    if (!(mgr->newArchiveMask & chartArchiveMask[chart->span]))
     {
         // nothing for us here
         return ERROR_ABORT;
     }
-    
-    sprintf (temp, "%s/%s", img->mgrWork->imagePath, img->fname);
 
-    for (i = 0, j = img->mgrWork->dayStart; i < DAILY_NUM_VALUES(img->mgrWork) - 1; i ++, j ++)
+    sprintf (temp, "%s/%s", mgr->imagePath, img->fname);
+
+    set = getChartLabels (mgr, chart->span);
+
+    switch (chart->span)
     {
-        if (j >= DAILY_NUM_VALUES(img->mgrWork) - 1)
-            j = 0;
+        case HTML_CHART_SPAN_DAY:
+            values = DAY_VALUES(mgr, chart->field);
+            break;
+        case HTML_CHART_SPAN_WEEK:
+            values = &WEEK_VALUES(mgr, chart->field)[set->skip];
+            break;
+        case HTML_CHART_SPAN_MONTH:
+            values = &MONTH_VALUES(mgr, chart->field)[set->skip];
+            break;
+        default:
+            values = YEAR_VALUES(mgr, chart->field);
+            break;
+    }
 
-        labels[i] = sampleLabels[j];
+    if (chart->kind == HTML_CHART_KIND_PERCENT)
+    {
+        return (htmlGenPngPercentChart (temp,
+                                mgr->isMetricUnits,
+                                values,
+                                chartHashes[chart->span],
+                                set->labels,
+                                set->numValues - set->skip,
+                                set->numValues,
+                                img->title,
+                                mgr->dateFormat));
+    }
+
+    if (chart->scale == HTML_CHART_SCALE_TEMP)
+    {
+        min = CHART_MIN_TEMP(mgr->isMetricUnits);
+        max = CHART_MAX_TEMP(mgr->isMetricUnits);
+    }
+    else
+    {
+        min = chart->min;
+        max = chart->max;
     }
-    labels[i] = sampleLabels[DAILY_NUM_VALUES(img->mgrWork) - 1];
 
-    return (htmlGenPngPercentChart (temp,
-                            img->mgrWork->isMetricUnits,
-                            img->mgrWork->dayValues[DATA_INDEX_rxCheckPercent],
-                            6,
-                            labels,
-                            DAILY_NUM_VALUES(img->mgrWork),
-                            DAILY_NUM_VALUES(img->mgrWork),
-                            img->title,
-                            img->mgrWork->dateFormat));
+    return (htmlGenPngChart (temp,
+                     mgr->isMetricUnits,
+                     values,
+                     chartHashes[chart->span],
+                     min,
+                     max,
+                     chart->step,
+                     set->labels,
+                     set->numValues - set->skip,
+                     set->numValues,
+                     img->title,
+                     img->units,
+                     img->decimalPlaces,
+                     mgr->dateFormat,
+                     (chart->isDualUnits ? mgr->isDualUnits : 0)));
 }
 
 //////////////////////////////////////////////////////////////////////////////
-//////////////  D I A G N O S T I C S   S T O P        ///////////////////////
+//////////////  G E N E R I C   C H A R T S   S T O P      ///////////////////
 //////////////////////////////////////////////////////////////////////////////
 
 //  ... This is the generator jump table:
@@ -7379,126 +3633,126 @@ int (*images_generators[]) (HTML_IMG *img) =
         generateMonthRain,
         generateYearRain,                       // 10
         generateWind,
-        generateTempDay,
-        generateTempMonth,
-        generateTempYear,
-        generateHumidDay,
-        generateHumidMonth,
-        generateHumidYear,
-        generateDewDay,
-        generateDewMonth,
-        generateDewYear,                        // 20
-        generateWSpeedDay,
-        generateWSpeedMonth,
-        generateWSpeedYear,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,                    // 20
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
         generateWDirDay,
         generateWDirMonth,
         generateWDirYear,
-        generateHiWSpeedDay,
-        generateHiWSpeedMonth,
-        generateHiWSpeedYear,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
         generateBaromDay,                       // 30
         generateBaromMonth,
         generateBaromYear,
         generateRainDay,
         generateRainMonth,
         generateRainYear,
-        generateWChillDay,
-        generateWChillMonth,
-        generateWChillYear,
-        generateHIndexDay,
-        generateHIndexMonth,                    // 40
-        generateHIndexYear,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,                    // 40
+        imagesGenerateChart,
         generateCompositeTempDay,
         generateCompositeHIndexWChillDay,
         generateCompositeTempMonth,
         generateCompositeHIndexWChillMonth,
-        generateRadiationDay,
-        generateRadiationMonth,
-        generateRadiationYear,
-        generateUVDay,
-        generateUVMonth,                        // 50
-        generateUVYear,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,                    // 50
+        imagesGenerateChart,
         generateETDay,
         generateETMonth,
         generateETYear,
-        generateLeafTemp1Day,
-        generateLeafTemp1Month,
-        generateLeafTemp1Year,
-        generateLeafTemp2Day,
-        generateLeafTemp2Month,
-        generateLeafTemp2Year,                  // 60
-        generateLeafWetness1Day,
-        generateLeafWetness1Month,
-        generateLeafWetness1Year,
-        generateLeafWetness2Day,
-        generateLeafWetness2Month,
-        generateLeafWetness2Year,
-        generateSoilTemp1Day,
-        generateSoilTemp1Month,
-        generateSoilTemp1Year,
-        generateSoilTemp2Day,                   // 70
-        generateSoilTemp2Month,
-        generateSoilTemp2Year,
-        generateSoilTemp3Day,
-        generateSoilTemp3Month,
-        generateSoilTemp3Year,
-        generateSoilTemp4Day,
-        generateSoilTemp4Month,
-        generateSoilTemp4Year,
-        generateExtraHumid1Day,
-        generateExtraHumid1Month,               // 80
-        generateExtraHumid1Year,
-        generateExtraHumid2Day,
-        generateExtraHumid2Month,
-        generateExtraHumid2Year,
-        generateExtraTemp1Day,
-        generateExtraTemp1Month,
-        generateExtraTemp1Year,
-        generateExtraTemp2Day,
-        generateExtraTemp2Month,
-        generateExtraTemp2Year,                 // 90
-        generateExtraTemp3Day,
-        generateExtraTemp3Month,
-        generateExtraTemp3Year,
-        generateSoilMoisture1Day,
-        generateSoilMoisture1Month,
-        generateSoilMoisture1Year,
-        generateSoilMoisture2Day,
-        generateSoilMoisture2Month,
-        generateSoilMoisture2Year,
-        generateSoilMoisture3Day,               // 100
-        generateSoilMoisture3Month,
-        generateSoilMoisture3Year,
-        generateSoilMoisture4Day,
-        generateSoilMoisture4Month,
-        generateSoilMoisture4Year,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,                    // 60
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,                    // 70
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,                    // 80
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,                    // 90
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,                    // 100
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
         generateUV,
         generateRadiation,
         generateET,
         generateDialTemp,
         generateDialHumidity,                   // 110
-        generateRxCheck,
+        imagesGenerateChart,
         generateDialNetRainDay,
         generateDialNetRainMonth,
         generateDialNetRainYear,
         generateCompositeInTempHumidDay,
         generateCompositeInTempHumidMonth,
-        generateTempWeek,
-        generateHumidWeek,
-        generateDewWeek,
-        generateWSpeedWeek,                     // 120
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,
+        imagesGenerateChart,                    // 120
         generateWDirWeek,
-        generateHiWSpeedWeek,
+        imagesGenerateChart,
         generateBaromWeek,
         generateRainWeek,
-        generateWChillWeek,
-        generateHIndexWeek,
+        imagesGenerateChart,
+        imagesGenerateChart,
         generateCompositeTempWeek,
         generateCompositeHIndexWChillWeek,
         generateCompositeInTempHumidWeek,
-        generateRadiationWeek,                  // 130
-        generateUVWeek,
+        imagesGenerateChart,                    // 130
+        imagesGenerateChart,
         generateETWeek,
         generateWindroseDay,
         generateWindroseWeek,
@@ -7511,4 +3765,309 @@ int (*images_generators[]) (HTML_IMG *img) =
         NULL
     };
 
+//  ... This is the table of the built-in generic charts:
+//  ... Each entry is the images_generators index (images.conf FNIndex) of an
+//  ... imagesGenerateChart slot and the chart it draws.
+typedef struct
+{
+    int         index;
+    HTML_CHART  chart;
+} IMAGE_CHART_ENTRY;
+
+// line chart on the temperature scale:
+#define CHART_TEMP(i,f,s)               \
+    { i, { f, HTML_CHART_SPAN_##s, HTML_CHART_KIND_LINE, HTML_CHART_SCALE_TEMP, 0, 0, 1.0, TRUE } }
+
+// line chart with a fixed starting scale:
+#define CHART_FIXED(i,f,s,mn,mx,st,d)   \
+    { i, { f, HTML_CHART_SPAN_##s, HTML_CHART_KIND_LINE, HTML_CHART_SCALE_FIXED, mn, mx, st, d } }
+
+// 0 - 100% chart:
+#define CHART_PERCENT(i,f,s)            \
+    { i, { f, HTML_CHART_SPAN_##s, HTML_CHART_KIND_PERCENT, HTML_CHART_SCALE_FIXED, 0, 100, 10, FALSE } }
+
+static IMAGE_CHART_ENTRY images_charts[] =
+    {
+        CHART_TEMP      ( 12, DATA_INDEX_outTemp,        DAY),
+        CHART_TEMP      ( 13, DATA_INDEX_outTemp,        MONTH),
+        CHART_TEMP      ( 14, DATA_INDEX_outTemp,        YEAR),
+        CHART_PERCENT   ( 15, DATA_INDEX_outHumidity,    DAY),
+        CHART_PERCENT   ( 16, DATA_INDEX_outHumidity,    MONTH),
+        CHART_PERCENT   ( 17, DATA_INDEX_outHumidity,    YEAR),
+        CHART_TEMP      ( 18, DATA_INDEX_dewpoint,       DAY),
+        CHART_TEMP      ( 19, DATA_INDEX_dewpoint,       MONTH),
+        CHART_TEMP      ( 20, DATA_INDEX_dewpoint,       YEAR),
+        CHART_FIXED     ( 21, DATA_INDEX_windSpeed,      DAY,     0,   5,   1.0, TRUE),
+        CHART_FIXED     ( 22, DATA_INDEX_windSpeed,      MONTH,   0,   5,   1.0, TRUE),
+        CHART_FIXED     ( 23, DATA_INDEX_windSpeed,      YEAR,    0,   5,   1.0, TRUE),
+        CHART_FIXED     ( 27, DATA_INDEX_windGust,       DAY,     0,   5,   1.0, TRUE),
+        CHART_FIXED     ( 28, DATA_INDEX_windGust,       MONTH,   0,   5,   1.0, TRUE),
+        CHART_FIXED     ( 29, DATA_INDEX_windGust,       YEAR,    0,   5,   1.0, TRUE),
+        CHART_TEMP      ( 36, DATA_INDEX_windchill,      DAY),
+        CHART_TEMP      ( 37, DATA_INDEX_windchill,      MONTH),
+        CHART_TEMP      ( 38, DATA_INDEX_windchill,      YEAR),
+        CHART_TEMP      ( 39, DATA_INDEX_heatindex,      DAY),
+        CHART_TEMP      ( 40, DATA_INDEX_heatindex,      MONTH),
+        CHART_TEMP      ( 41, DATA_INDEX_heatindex,      YEAR),
+        CHART_FIXED     ( 46, DATA_INDEX_radiation,      DAY,     0,  10,  10.0, FALSE),
+        CHART_FIXED     ( 47, DATA_INDEX_radiation,      MONTH,   0, 100, 100.0, FALSE),
+        CHART_FIXED     ( 48, DATA_INDEX_radiation,      YEAR,    0, 100, 100.0, FALSE),
+        CHART_FIXED     ( 49, DATA_INDEX_UV,             DAY,     0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 50, DATA_INDEX_UV,             MONTH,   0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 51, DATA_INDEX_UV,             YEAR,    0,   5,   1.0, FALSE),
+        CHART_TEMP      ( 55, DATA_INDEX_leafTemp1,      DAY),
+        CHART_TEMP      ( 56, DATA_INDEX_leafTemp1,      MONTH),
+        CHART_TEMP      ( 57, DATA_INDEX_leafTemp1,      YEAR),
+        CHART_TEMP      ( 58, DATA_INDEX_leafTemp2,      DAY),
+        CHART_TEMP      ( 59, DATA_INDEX_leafTemp2,      MONTH),
+        CHART_TEMP      ( 60, DATA_INDEX_leafTemp2,      YEAR),
+        CHART_FIXED     ( 61, DATA_INDEX_leafWet1,       DAY,     0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 62, DATA_INDEX_leafWet1,       MONTH,   0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 63, DATA_INDEX_leafWet1,       YEAR,    0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 64, DATA_INDEX_leafWet2,       DAY,     0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 65, DATA_INDEX_leafWet2,       MONTH,   0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 66, DATA_INDEX_leafWet2,       YEAR,    0,   5,   1.0, FALSE),
+        CHART_TEMP      ( 67, DATA_INDEX_soilTemp1,      DAY),
+        CHART_TEMP      ( 68, DATA_INDEX_soilTemp1,      MONTH),
+        CHART_TEMP      ( 69, DATA_INDEX_soilTemp1,      YEAR),
+        CHART_TEMP      ( 70, DATA_INDEX_soilTemp2,      DAY),
+        CHART_TEMP      ( 71, DATA_INDEX_soilTemp2,      MONTH),
+        CHART_TEMP      ( 72, DATA_INDEX_soilTemp2,      YEAR),
+        CHART_TEMP      ( 73, DATA_INDEX_soilTemp3,      DAY),
+        CHART_TEMP      ( 74, DATA_INDEX_soilTemp3,      MONTH),
+        CHART_TEMP      ( 75, DATA_INDEX_soilTemp3,      YEAR),
+        CHART_TEMP      ( 76, DATA_INDEX_soilTemp4,      DAY),
+        CHART_TEMP      ( 77, DATA_INDEX_soilTemp4,      MONTH),
+        CHART_TEMP      ( 78, DATA_INDEX_soilTemp4,      YEAR),
+        CHART_PERCENT   ( 79, DATA_INDEX_extraHumid1,    DAY),
+        CHART_PERCENT   ( 80, DATA_INDEX_extraHumid1,    MONTH),
+        CHART_PERCENT   ( 81, DATA_INDEX_extraHumid1,    YEAR),
+        CHART_PERCENT   ( 82, DATA_INDEX_extraHumid2,    DAY),
+        CHART_PERCENT   ( 83, DATA_INDEX_extraHumid2,    MONTH),
+        CHART_PERCENT   ( 84, DATA_INDEX_extraHumid2,    YEAR),
+        CHART_TEMP      ( 85, DATA_INDEX_extraTemp1,     DAY),
+        CHART_TEMP      ( 86, DATA_INDEX_extraTemp1,     MONTH),
+        CHART_TEMP      ( 87, DATA_INDEX_extraTemp1,     YEAR),
+        CHART_TEMP      ( 88, DATA_INDEX_extraTemp2,     DAY),
+        CHART_TEMP      ( 89, DATA_INDEX_extraTemp2,     MONTH),
+        CHART_TEMP      ( 90, DATA_INDEX_extraTemp2,     YEAR),
+        CHART_TEMP      ( 91, DATA_INDEX_extraTemp3,     DAY),
+        CHART_TEMP      ( 92, DATA_INDEX_extraTemp3,     MONTH),
+        CHART_TEMP      ( 93, DATA_INDEX_extraTemp3,     YEAR),
+        CHART_FIXED     ( 94, DATA_INDEX_soilMoist1,     DAY,     0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 95, DATA_INDEX_soilMoist1,     MONTH,   0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 96, DATA_INDEX_soilMoist1,     YEAR,    0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 97, DATA_INDEX_soilMoist2,     DAY,     0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 98, DATA_INDEX_soilMoist2,     MONTH,   0,   5,   1.0, FALSE),
+        CHART_FIXED     ( 99, DATA_INDEX_soilMoist2,     YEAR,    0,   5,   1.0, FALSE),
+        CHART_FIXED     (100, DATA_INDEX_soilMoist3,     DAY,     0,   5,   1.0, FALSE),
+        CHART_FIXED     (101, DATA_INDEX_soilMoist3,     MONTH,   0,   5,   1.0, FALSE),
+        CHART_FIXED     (102, DATA_INDEX_soilMoist3,     YEAR,    0,   5,   1.0, FALSE),
+        CHART_FIXED     (103, DATA_INDEX_soilMoist4,     DAY,     0,   5,   1.0, FALSE),
+        CHART_FIXED     (104, DATA_INDEX_soilMoist4,     MONTH,   0,   5,   1.0, FALSE),
+        CHART_FIXED     (105, DATA_INDEX_soilMoist4,     YEAR,    0,   5,   1.0, FALSE),
+        CHART_PERCENT   (111, DATA_INDEX_rxCheckPercent, DAY),
+        CHART_TEMP      (117, DATA_INDEX_outTemp,        WEEK),
+        CHART_PERCENT   (118, DATA_INDEX_outHumidity,    WEEK),
+        CHART_TEMP      (119, DATA_INDEX_dewpoint,       WEEK),
+        CHART_FIXED     (120, DATA_INDEX_windSpeed,      WEEK,    0,   5,   1.0, TRUE),
+        CHART_FIXED     (122, DATA_INDEX_windGust,       WEEK,    0,   5,   1.0, TRUE),
+        CHART_TEMP      (125, DATA_INDEX_windchill,      WEEK),
+        CHART_TEMP      (126, DATA_INDEX_heatindex,      WEEK),
+        CHART_FIXED     (130, DATA_INDEX_radiation,      WEEK,    0, 100, 100.0, FALSE),
+        CHART_FIXED     (131, DATA_INDEX_UV,             WEEK,    0,   5,   1.0, FALSE)
+    };
+
+#define IMAGE_CHART_ENTRIES     (sizeof(images_charts)/sizeof(IMAGE_CHART_ENTRY))
+
+//  ... This is the table of the inputs (HTML_INPUT_BITS) each of the other
+//  ... built-in generators is drawn from; see imagesGetInputs.
+typedef struct
+{
+    int         (*generator) (HTML_IMG *img);
+    int         inputs;
+} IMAGE_INPUT_ENTRY;
+
+static IMAGE_INPUT_ENTRY images_inputs[] =
+    {
+        { generateTemp,                       HTML_INPUT_LOOP },
+        { generateHumidity,                   HTML_INPUT_LOOP },
+        { generateDewpoint,                   HTML_INPUT_LOOP },
+        { generateWindChill,                  HTML_INPUT_LOOP },
+        { generateHeatIndex,                  HTML_INPUT_LOOP },
+        { generateBarometer,                  HTML_INPUT_LOOP },
+        { generateDayRain,                    HTML_INPUT_LOOP },
+        { generateStormRain,                  HTML_INPUT_LOOP },
+        { generateRainRate,                   HTML_INPUT_LOOP },
+        { generateMonthRain,                  HTML_INPUT_LOOP },
+        { generateYearRain,                   HTML_INPUT_LOOP },
+        { generateWind,                       HTML_INPUT_LOOP },
+        { generateWDirDay,                    HTML_INPUT_ARCHIVE },
+        { generateWDirMonth,                  HTML_INPUT_HOUR },
+        { generateWDirYear,                   HTML_INPUT_DAY },
+        { generateBaromDay,                   HTML_INPUT_ARCHIVE },
+        { generateBaromMonth,                 HTML_INPUT_HOUR },
+        { generateBaromYear,                  HTML_INPUT_DAY },
+        { generateRainDay,                    HTML_INPUT_ARCHIVE },
+        { generateRainMonth,                  HTML_INPUT_HOUR },
+        { generateRainYear,                   HTML_INPUT_DAY },
+        { generateCompositeTempDay,           HTML_INPUT_ARCHIVE },
+        { generateCompositeHIndexWChillDay,   HTML_INPUT_ARCHIVE },
+        { generateCompositeTempMonth,         HTML_INPUT_HOUR },
+        { generateCompositeHIndexWChillMonth, HTML_INPUT_HOUR },
+        { generateETDay,                      HTML_INPUT_ARCHIVE },
+        { generateETMonth,                    HTML_INPUT_HOUR },
+        { generateETYear,                     HTML_INPUT_DAY },
+        { generateUV,                         HTML_INPUT_LOOP },
+        { generateRadiation,                  HTML_INPUT_LOOP },
+        { generateET,                         HTML_INPUT_LOOP },
+        { generateDialTemp,                   HTML_INPUT_LOOP },
+        { generateDialHumidity,               HTML_INPUT_LOOP },
+        { generateDialNetRainDay,             HTML_INPUT_LOOP },
+        { generateDialNetRainMonth,           HTML_INPUT_LOOP },
+        { generateDialNetRainYear,            HTML_INPUT_LOOP },
+        { generateCompositeInTempHumidDay,    HTML_INPUT_ARCHIVE },
+        { generateCompositeInTempHumidMonth,  HTML_INPUT_HOUR },
+        { generateWDirWeek,                   HTML_INPUT_HOUR },
+        { generateBaromWeek,                  HTML_INPUT_HOUR },
+        { generateRainWeek,                   HTML_INPUT_HOUR },
+        { generateCompositeTempWeek,          HTML_INPUT_HOUR },
+        { generateCompositeHIndexWChillWeek,  HTML_INPUT_HOUR },
+        { generateCompositeInTempHumidWeek,   HTML_INPUT_HOUR },
+        { generateETWeek,                     HTML_INPUT_HOUR },
+        { generateWindroseDay,                HTML_INPUT_ARCHIVE },
+        { generateWindroseWeek,               HTML_INPUT_HOUR },
+        { generateWindroseMonth,              HTML_INPUT_HOUR },
+        { generateWindroseYear,               HTML_INPUT_ARCHIVE },
+        { generateCompositeWindDay,           HTML_INPUT_ARCHIVE },
+        { generateCompositeWindWeek,          HTML_INPUT_HOUR },
+        { generateCompositeWindMonth,         HTML_INPUT_HOUR },
+        { generateCompositeWindYear,          HTML_INPUT_DAY }
+    };
+
+#define IMAGE_INPUT_ENTRIES     (sizeof(images_inputs)/sizeof(IMAGE_INPUT_ENTRY))
+
+
+int imagesGetBuiltinChart (int index, HTML_CHART *chart)
+{
+    int         i;
+
+    for (i = 0; i < IMAGE_CHART_ENTRIES; i ++)
+    {
+        if (images_charts[i].index == index)
+        {
+            *chart = images_charts[i].chart;
+            return OK;
+        }
+    }
+
+    return ERROR;
+}
+
+int imagesGetInputs (HTML_IMG *img)
+{
+    int         i;
+
+    if (img->generator == imagesGenerateChart)
+    {
+        return chartArchiveMask[img->chart.span];
+    }
+
+    for (i = 0; i < IMAGE_INPUT_ENTRIES; i ++)
+    {
+        if (images_inputs[i].generator == img->generator)
+        {
+            return images_inputs[i].inputs;
+        }
+    }
+
+    // user generators may use anything:
+    return HTML_INPUT_ALL;
+}
+
+int imagesParseChart (char *spec, HTML_CHART *chart)
+{
+    char        temp[128];
+    char        *fields[5];
+    int         i, numFields;
+
+    if (strncmp (spec, IMAGES_CHART_PREFIX, strlen(IMAGES_CHART_PREFIX)))
+    {
+        return ERROR;
+    }
+    wvstrncpy (temp, &spec[strlen(IMAGES_CHART_PREFIX)], sizeof(temp));
+
+    // split "<field>:<span>:<scale>[:dual]":
+    fields[0] = temp;
+    for (i = 0, numFields = 1; temp[i] != 0 && numFields < 5; i ++)
+    {
+        if (temp[i] == ':')
+        {
+            temp[i] = 0;
+            fields[numFields ++] = &temp[i+1];
+        }
+    }
+    if (numFields < 3 || numFields > 4)
+    {
+        return ERROR;
+    }
+
+    memset (chart, 0, sizeof (*chart));
+
+    chart->field = dbsqliteArchiveGetFieldIndex (fields[0]);
+    if (chart->field == ERROR)
+    {
+        return ERROR;
+    }
+
+    for (i = 0; i < HTML_CHART_SPAN_MAX; i ++)
+    {
+        if (!strcmp (fields[1], chartSpanNames[i]))
+        {
+            break;
+        }
+    }
+    if (i == HTML_CHART_SPAN_MAX)
+    {
+        return ERROR;
+    }
+    chart->span = (HTML_CHART_SPAN)i;
+
+    if (!strcmp (fields[2], "temp"))
+    {
+        chart->kind     = HTML_CHART_KIND_LINE;
+        chart->scale    = HTML_CHART_SCALE_TEMP;
+        chart->step     = 1.0;
+    }
+    else if (!strcmp (fields[2], "percent"))
+    {
+        chart->kind     = HTML_CHART_KIND_PERCENT;
+        chart->scale    = HTML_CHART_SCALE_FIXED;
+        chart->max      = 100;
+        chart->step     = 10;
+    }
+    else if (sscanf (fields[2], "%f,%f,%f", &chart->min, &chart->max, &chart->step) == 3 &&
+             chart->max > chart->min && chart->step > 0)
+    {
+        chart->kind     = HTML_CHART_KIND_LINE;
+        chart->scale    = HTML_CHART_SCALE_FIXED;
+    }
+    else
+    {
+        return ERROR;
+    }
+
+    if (numFields > 3)
+    {
+        if (strcmp (fields[3], "dual"))
+        {
+            return ERROR;
+        }
+        chart->isDualUnits = TRUE;
+    }
+
+    return OK;
+}
+
+
 
@@ -11,9 +11,17 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         01/20/04        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Table-driven charts
+        10/19/2026      M.S. Teel       2               Generator inputs
  
   NOTES:
-        
+        The single-field day/week/month/year charts are table driven (see
+        images_charts in images.c) and drawn by imagesGenerateChart. An
+        images.conf line can also give a chart spec in place of the FNIndex:
+            chart:<field>:<span>:<scale>[:dual]
+        where <field> is an archive field name (outTemp, extraTemp1, ...),
+        <span> is day, week, month or year, <scale> is temp, percent or
+        <min>,<max>,<step> and "dual" enables dual units if configured.
  
   LICENSE:
         Copyright (c) 2004, Mark S. Teel (mark@teel.ws)
@@ -53,6 +61,7 @@
 
 /*  ... API definitions
 */
+#define IMAGES_CHART_PREFIX         "chart:"
 
 
 /*  !!!!!!!!!!!!!!!!!!  HIDDEN, NOT FOR API USE  !!!!!!!!!!!!!!!!!!
@@ -69,4 +78,19 @@ extern int (*images_generators[]) (HTML_IMG *img);
 /* ... function prototypes
 */
 
+//  ... the generic chart generator; draws img->chart
+extern int imagesGenerateChart (HTML_IMG *img);
+
+//  ... get the built-in chart for images_generators 'index';
+//  ... returns OK or ERROR if 'index' is not a generic chart
+extern int imagesGetBuiltinChart (int index, HTML_CHART *chart);
+
+//  ... get the inputs (HTML_INPUT_BITS) 'img' is drawn from; img->generator
+//  ... (and img->chart for generic charts) must be set
+extern int imagesGetInputs (HTML_IMG *img);
+
+//  ... parse an images.conf "chart:<field>:<span>:<scale>[:dual]" spec;
+//  ... returns OK or ERROR
+extern int imagesParseChart (char *spec, HTML_CHART *chart);
+
 #endif
@@ -0,0 +1,351 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        manifestTest.c
+
+  PURPOSE:
+        Check the file content manifest: hashing, lookups, save and load,
+        and directory rescans ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        manifestHashFile is checked against published FNV-1a 64-bit test
+        vectors and against a byte at a time hash of a file larger than its
+        read buffer.
+
+        A scratch directory tree under /tmp is then scanned the way htmlgend
+        does it: the first manifestUpdate hashes every file, the next only
+        the modified ones, removed files are dropped and dot files skipped.
+        The rescan times are printed but not checked.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <utime.h>
+#include <sys/time.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radtimeUtils.h>
+
+/*  ... Local include files
+*/
+#include <manifest.h>
+
+
+/*  ... local memory
+*/
+
+#define TEST_FILES              200
+#define TEST_FILE_SIZE          8192
+#define TEST_LARGE_SIZE         200000      // several manifest read buffers
+
+typedef struct
+{
+    const char      *data;
+    ULONGLONG       hash;
+} TEST_VECTOR;
+
+// FNV-1a 64-bit reference values:
+static TEST_VECTOR  testVectors[] =
+{
+    { "",           0xcbf29ce484222325ULL },
+    { "a",          0xaf63dc4c8601ec8cULL },
+    { "foobar",     0x85944171f73967e8ULL }
+};
+
+static char         testDir[64];
+static char         testRealDir[PATH_MAX];
+static int          testFailures;
+
+
+//  ... stand-ins for what manifest.c takes from wvutils
+
+int wvstrncpy (char *d, const char *s, size_t bufsize)
+{
+    snprintf (d, bufsize, "%s", s);
+    return strlen (s);
+}
+
+
+static void check (int condition, char *what)
+{
+    printf ("manifestTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static int writeFile (const char *name, const char *data, int size)
+{
+    char            path[_MAX_PATH];
+    FILE            *file;
+
+    sprintf (path, "%s/%s", testDir, name);
+    if ((file = fopen (path, "wb")) == NULL)
+    {
+        return ERROR;
+    }
+
+    if (size > 0 && fwrite (data, 1, size, file) != (size_t)size)
+    {
+        fclose (file);
+        return ERROR;
+    }
+
+    fclose (file);
+    return OK;
+}
+
+static void makePath (char *path, const char *name)
+{
+    sprintf (path, "%s/%s", testRealDir, name);
+    return;
+}
+
+static void checkHashes (void)
+{
+    char            path[_MAX_PATH], *data;
+    ULONGLONG       hash, expected;
+    int             i, isRight = TRUE;
+
+    for (i = 0; i < (int)(sizeof (testVectors) / sizeof (testVectors[0])); i ++)
+    {
+        writeFile ("vector", testVectors[i].data, strlen (testVectors[i].data));
+        makePath (path, "vector");
+        if (manifestHashFile (path, &hash) == ERROR || hash != testVectors[i].hash)
+        {
+            printf ("manifestTest: \"%s\": %16.16llx, expected %16.16llx\n",
+                    testVectors[i].data, hash, testVectors[i].hash);
+            isRight = FALSE;
+        }
+    }
+    makePath (path, "vector");
+    unlink (path);
+    check (isRight, "FNV-1a test vectors");
+
+    data = malloc (TEST_LARGE_SIZE);
+    expected = 0xcbf29ce484222325ULL;
+    for (i = 0; i < TEST_LARGE_SIZE; i ++)
+    {
+        data[i] = (char)((i * 31) ^ (i >> 8));
+        expected = (expected ^ (unsigned char)data[i]) * 0x100000001b3ULL;
+    }
+    writeFile ("large", data, TEST_LARGE_SIZE);
+    free (data);
+    makePath (path, "large");
+    check (manifestHashFile (path, &hash) == OK && hash == expected,
+           "file larger than the read buffer");
+    unlink (path);
+
+    check (manifestHashFile ("/nonexistent/manifestTest", &hash) == ERROR,
+           "missing file is an error");
+    return;
+}
+
+static void checkEntries (void)
+{
+    MANIFEST        manifest, loaded;
+    MANIFEST_ENTRY  *entry;
+    char            file[_MAX_PATH], tempFile[_MAX_PATH + 8];
+    static char     *paths[] = { "/b/x.htm", "/a/z.htm", "/c.png", "/a/y.htm", "/b" };
+    int             i, isSorted = TRUE, isSame = TRUE;
+
+    manifestInit (&manifest, "ftp://example.com/web");
+    for (i = 0; i < (int)(sizeof (paths) / sizeof (paths[0])); i ++)
+    {
+        manifestSet (&manifest, paths[i], 100 + i, 1000 + i, 0x1000ULL + i);
+    }
+    manifestSet (&manifest, "/c.png", 50, 2000, 0x2000ULL);
+
+    for (i = 1; i < manifest.count; i ++)
+    {
+        if (strcmp (manifest.entries[i - 1].path, manifest.entries[i].path) >= 0)
+        {
+            isSorted = FALSE;
+        }
+    }
+    check (manifest.count == 5 && isSorted, "entries are kept sorted and unique");
+
+    entry = manifestFind (&manifest, "/c.png");
+    check (entry != NULL && entry->size == 50 && entry->mtime == 2000 &&
+           entry->hash == 0x2000ULL && manifestFind (&manifest, "/a") == NULL,
+           "find returns the latest entry");
+
+    // save and load it back:
+    sprintf (file, "%s/sent_manifest", testDir);
+    sprintf (tempFile, "%s.tmp", file);
+    check (manifestSave (&manifest, file) == OK && access (tempFile, F_OK) != 0,
+           "save replaces the file atomically");
+
+    manifestInit (&loaded, "ftp://example.com/web");
+    manifestLoad (&loaded, file);
+    isSame = (loaded.count == manifest.count);
+    for (i = 0; isSame && i < manifest.count; i ++)
+    {
+        if (strcmp (loaded.entries[i].path, manifest.entries[i].path) != 0 ||
+            loaded.entries[i].size != manifest.entries[i].size ||
+            loaded.entries[i].mtime != manifest.entries[i].mtime ||
+            loaded.entries[i].hash != manifest.entries[i].hash)
+        {
+            isSame = FALSE;
+        }
+    }
+    check (isSame, "load gives back the saved entries");
+    manifestExit (&loaded);
+
+    manifestInit (&loaded, "ftp://example.org/web");
+    check (manifestLoad (&loaded, file) == OK && loaded.count == 0,
+           "another destination's manifest is ignored");
+    manifestExit (&loaded);
+
+    manifestInit (&loaded, NULL);
+    check (manifestLoad (&loaded, "/nonexistent/manifestTest") == OK && loaded.count == 0,
+           "missing manifest loads empty");
+    manifestExit (&loaded);
+
+    unlink (file);
+    manifestExit (&manifest);
+    return;
+}
+
+static double getUsecs (void)
+{
+    struct timeval      tv;
+
+    gettimeofday (&tv, NULL);
+    return ((double)tv.tv_sec * 1000000.0) + (double)tv.tv_usec;
+}
+
+static void checkUpdate (void)
+{
+    MANIFEST        published;
+    MANIFEST_ENTRY  *entry;
+    struct stat     fileStat;
+    struct utimbuf  times;
+    char            name[64], path[_MAX_PATH], *data;
+    ULONGLONG       hash;
+    double          firstTime, nextTime;
+    int             i, rehashed, isRight = TRUE;
+
+    sprintf (path, "%s/sub", testDir);
+    mkdir (path, 0755);
+    data = malloc (TEST_FILE_SIZE);
+    for (i = 0; i < TEST_FILES; i ++)
+    {
+        memset (data, 'a' + (i % 26), TEST_FILE_SIZE);
+        sprintf (name, ((i % 4) ? "page%3.3d.htm" : "sub/chart%3.3d.png"), i);
+        writeFile (name, data, TEST_FILE_SIZE - i);
+    }
+    writeFile (".hidden", data, 10);
+    free (data);
+
+    manifestInit (&published, NULL);
+    firstTime = getUsecs ();
+    rehashed = manifestUpdate (&published, testDir);
+    firstTime = getUsecs () - firstTime;
+    check (rehashed == TEST_FILES && published.count == TEST_FILES,
+           "first scan hashes every file");
+
+    makePath (path, ".hidden");
+    check (manifestFind (&published, path) == NULL, "dot files are skipped");
+
+    for (i = 0; i < TEST_FILES; i ++)
+    {
+        sprintf (name, ((i % 4) ? "page%3.3d.htm" : "sub/chart%3.3d.png"), i);
+        makePath (path, name);
+        entry = manifestFind (&published, path);
+        if (entry == NULL || manifestHashFile (path, &hash) == ERROR ||
+            entry->hash != hash || entry->size != TEST_FILE_SIZE - i)
+        {
+            isRight = FALSE;
+        }
+    }
+    check (isRight, "entries are keyed by real path with the hash");
+
+    nextTime = getUsecs ();
+    rehashed = manifestUpdate (&published, testDir);
+    nextTime = getUsecs () - nextTime;
+    check (rehashed == 0 && published.count == TEST_FILES, "unchanged files are not rehashed");
+
+    // a content change and a touch with the same size:
+    writeFile ("page001.htm", "changed", 7);
+    makePath (path, "page002.htm");
+    stat (path, &fileStat);
+    times.actime = times.modtime = fileStat.st_mtime + 10;
+    utime (path, &times);
+    rehashed = manifestUpdate (&published, testDir);
+    makePath (path, "page001.htm");
+    manifestHashFile (path, &hash);
+    entry = manifestFind (&published, path);
+    check (rehashed == 2 && entry != NULL && entry->hash == hash && entry->size == 7,
+           "modified files are rehashed");
+
+    makePath (path, "page003.htm");
+    unlink (path);
+    rehashed = manifestUpdate (&published, testDir);
+    check (rehashed == 0 && published.count == TEST_FILES - 1 &&
+           manifestFind (&published, path) == NULL,
+           "removed files are dropped");
+
+    // the uploaders take a current published hash instead of reading:
+    makePath (path, "page005.htm");
+    entry = manifestFind (&published, path);
+    entry->hash = 0x5555ULL;
+    stat (path, &fileStat);
+    check (manifestGetHash (&published, path, &fileStat, &hash) == OK && hash == 0x5555ULL,
+           "current published hash is used");
+    fileStat.st_mtime ++;
+    check (manifestGetHash (&published, path, &fileStat, &hash) == OK && hash != 0x5555ULL,
+           "stale published hash is not used");
+
+    printf ("manifestTest: %d files: first scan %.0f us, rescan %.0f us\n",
+            TEST_FILES, firstTime, nextTime);
+
+    manifestExit (&published);
+    return;
+}
+
+
+int main (int argc, char *argv[])
+{
+    char            command[128];
+
+    snprintf (testDir, sizeof (testDir), "/tmp/manifestTest.%d", (int)getpid ());
+    if (mkdir (testDir, 0755) != 0 || realpath (testDir, testRealDir) == NULL)
+    {
+        printf ("manifestTest: cannot create %s\n", testDir);
+        return 1;
+    }
+
+    checkHashes ();
+    checkEntries ();
+    checkUpdate ();
+
+    sprintf (command, "rm -rf %s", testDir);
+    if (system (command) != 0)
+    {
+        printf ("manifestTest: cannot remove %s\n", testDir);
+    }
+
+    printf ("manifestTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
@@ -9,6 +9,7 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         01/25/04        M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Commit reports via htmlBuffer
  
   NOTES:
         
@@ -30,6 +31,7 @@
 /*  ... Local include files
 */
 #include <noaaGenerate.h>
+#include <htmlBuffer.h>
 
 
 /*  ... global memory declarations
@@ -88,7 +90,7 @@ static void writeNoaaMonthFiles (NOAA_ID work, time_t startTime)
 {
     char            *destPath = work->htmlPath;
     FILE            *outfile = NULL;
-    char            temp[_MAX_PATH];
+    char            temp[_MAX_PATH], outName[_MAX_PATH];
     NOAA_DAY_REC    record;
     int             month;
     int             numDays, totalDays, totalMonths, done;
@@ -194,12 +196,14 @@ static void writeNoaaMonthFiles (NOAA_ID work, time_t startTime)
 
                 fclose (outfile);
                 outfile = NULL;
+                htmlbufferCommitFile (outName);
             }
 
             if (! done)
             {
-                sprintf (temp, "%s/NOAA/NOAA-%4.4d-%2.2d.txt",
+                sprintf (outName, "%s/NOAA/NOAA-%4.4d-%2.2d.txt",
                          destPath, record.year, record.month);
+                sprintf (temp, "%s%s", outName, HTML_BUFFER_TEMP_EXT);
                 outfile = fopen (temp, "w");
                 if (outfile == NULL)
                 {
@@ -347,7 +351,10 @@ static void writeNoaaMonthFiles (NOAA_ID work, time_t startTime)
     }
 
     if (outfile)
+    {
         fclose (outfile);
+        htmlbufferCommitFile (outName);
+    }
 
     if (numDays > 0 || totalDays > 0)
     {
@@ -367,7 +374,7 @@ static void writeNoaaYearFiles (NOAA_ID work, time_t startTime)
 {
     char            *destPath = work->htmlPath;
     FILE            *outfile = NULL;
-    char            temp[512];
+    char            temp[_MAX_PATH], outName[_MAX_PATH];
     float           normalTemp[13], normalRain[13];
     float           normYearTemp, normYearRain;
     NOAA_DAY_REC    record;
@@ -779,13 +786,15 @@ static void writeNoaaYearFiles (NOAA_ID work, time_t startTime)
 
                 fclose (outfile);
                 outfile = NULL;
+                htmlbufferCommitFile (outName);
             }
 
             if (! done)
             {
                 year = record.year;
                 numMonths = 0;
-                sprintf (temp, "%s/NOAA/NOAA-%4.4d.txt", destPath, record.year);
+                sprintf (outName, "%s/NOAA/NOAA-%4.4d.txt", destPath, record.year);
+                sprintf (temp, "%s%s", outName, HTML_BUFFER_TEMP_EXT);
                 outfile = fopen (temp, "w");
                 if (outfile == NULL)
                 {
@@ -871,7 +880,10 @@ static void writeNoaaYearFiles (NOAA_ID work, time_t startTime)
     }
 
     if (outfile)
+    {
         fclose (outfile);
+        htmlbufferCommitFile (outName);
+    }
   
     radMsgLog(PRI_STATUS, "NOAA: %d months, %d years", totalMonths-1, totalYears-1);
     return;
@@ -0,0 +1,677 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        serverTest.c
+
+  PURPOSE:
+        Run the htmlgend embedded HTTP server against loopback clients
+        ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The radProcess event loop is replaced by a poll loop over the
+        descriptors and the timer the server registers, so the server runs
+        exactly as it does in htmlgend, serving a scratch directory under
+        /tmp written through htmlbufferWriteFile:
+            - a GET is answered with the file, an ETag and keep-alive
+            - If-None-Match with the current ETag is answered with 304 and
+              no body, a stale one with the new file
+            - large text files go gzip compressed to clients which accept
+              it (with their own ETag), small and binary files do not
+            - HEAD, pipelined requests, 404, 405 and an escape of the
+              image path
+            - request headers over HTML_SERVER_REQUEST_MAX get 431 and the
+              connection is closed
+            - the event stream gets each LOOP packet
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <zlib.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radtimeUtils.h>
+
+/*  ... Local include files
+*/
+#include <htmlServer.h>
+#include <htmlData.h>
+
+
+/*  ... local memory
+*/
+
+#define TEST_PAGE_SIZE          20000
+#define TEST_SMALL_SIZE         100
+#define TEST_IMAGE_SIZE         5000
+#define TEST_MAX_DESCRIPTORS    (HTML_SERVER_MAX_CLIENTS + 1)
+#define TEST_INPUT_MAX          (256 * 1024)
+#define TEST_REPLY_MS           2000        // longest wait for a reply
+#define TEST_TIMEOUT_SECS       60
+
+typedef struct
+{
+    int             fd;
+    void            (*callback) (int fd, void *userData);
+    void            *userData;
+} TEST_DESCRIPTOR;
+
+typedef struct
+{
+    int             fd;
+    char            input[TEST_INPUT_MAX];
+    int             length;
+    int             isClosed;
+} TEST_CLIENT;
+
+typedef struct
+{
+    int             status;
+    char            headers[2048];
+    char            body[TEST_INPUT_MAX];
+    int             bodyLength;
+} TEST_REPLY;
+
+static char         testDir[64];
+static char         testPage[TEST_PAGE_SIZE];
+static int          testPort;
+static int          testFailures;
+
+static TEST_CLIENT  testClient;
+static TEST_REPLY   testReply;
+
+// the radProcess stand-in state:
+static TEST_DESCRIPTOR  testDescriptors[TEST_MAX_DESCRIPTORS];
+static int          testNumDescriptors;
+static int          testTimer;
+static ULONGLONG    testTimerExpiry;            // 0 when stopped
+static void         (*testTimerRoutine) (void *parm);
+static void         *testTimerParm;
+
+
+//  ... stand-ins for wvutils and the live data document
+
+int wvstrncpy (char *d, const char *s, size_t bufsize)
+{
+    snprintf (d, bufsize, "%s", s);
+    return strlen (s);
+}
+
+int htmldataFormatLoop (LOOP_PKT *loop, HTML_BUFFER *buffer)
+{
+    char            text[64];
+
+    snprintf (text, sizeof (text), "{\"outTemp\":%.1f}", loop->outTemp);
+    return htmlbufferAppendString (buffer, text);
+}
+
+
+//  ... stand-ins for the radProcess timer and descriptor registration
+
+TIMER_ID radTimerCreate (TIMER_ID timer, void (*routine) (void *parm), void *parm)
+{
+    testTimerRoutine    = routine;
+    testTimerParm       = parm;
+    testTimerExpiry     = 0;
+    return (TIMER_ID)&testTimer;
+}
+
+void radTimerDelete (TIMER_ID timer)
+{
+    testTimerExpiry = 0;
+    testTimerRoutine = NULL;
+    return;
+}
+
+void radProcessTimerStart (TIMER_ID timer, ULONG time)
+{
+    testTimerExpiry = radTimeGetMSSinceEpoch () + time;
+    return;
+}
+
+void radProcessTimerStop (TIMER_ID timer)
+{
+    testTimerExpiry = 0;
+    return;
+}
+
+int radProcessIORegisterDescriptor
+(
+    int             fd,
+    void            (*callback) (int fd, void *userData),
+    void            *userData
+)
+{
+    if (testNumDescriptors >= TEST_MAX_DESCRIPTORS)
+    {
+        return ERROR;
+    }
+
+    testDescriptors[testNumDescriptors].fd          = fd;
+    testDescriptors[testNumDescriptors].callback    = callback;
+    testDescriptors[testNumDescriptors].userData    = userData;
+    testNumDescriptors ++;
+    return OK;
+}
+
+int radProcessIODeRegisterDescriptorByFd (int fd)
+{
+    int             i;
+
+    for (i = 0; i < testNumDescriptors; i ++)
+    {
+        if (testDescriptors[i].fd == fd)
+        {
+            testDescriptors[i] = testDescriptors[-- testNumDescriptors];
+            return OK;
+        }
+    }
+    return ERROR;
+}
+
+
+// one pass of the radProcess loop, waiting up to 'timeoutMS':
+static void runServer (int timeoutMS)
+{
+    TEST_DESCRIPTOR descriptors[TEST_MAX_DESCRIPTORS];
+    struct pollfd   fds[TEST_MAX_DESCRIPTORS];
+    ULONGLONG       now = radTimeGetMSSinceEpoch ();
+    int             i, j, numFds;
+
+    if (testTimerExpiry != 0)
+    {
+        if (testTimerExpiry <= now)
+            timeoutMS = 0;
+        else if ((int)(testTimerExpiry - now) < timeoutMS)
+            timeoutMS = (int)(testTimerExpiry - now);
+    }
+
+    // the callbacks may change the registrations:
+    numFds = testNumDescriptors;
+    memcpy (descriptors, testDescriptors, sizeof (descriptors));
+    for (i = 0; i < numFds; i ++)
+    {
+        fds[i].fd       = descriptors[i].fd;
+        fds[i].events   = POLLIN;
+        fds[i].revents  = 0;
+    }
+
+    if (poll (fds, numFds, timeoutMS) > 0)
+    {
+        for (i = 0; i < numFds; i ++)
+        {
+            if (fds[i].revents == 0)
+                continue;
+
+            for (j = 0; j < testNumDescriptors; j ++)
+            {
+                if (testDescriptors[j].fd == fds[i].fd)
+                {
+                    (*testDescriptors[j].callback) (fds[i].fd, testDescriptors[j].userData);
+                    break;
+                }
+            }
+        }
+    }
+
+    if (testTimerExpiry != 0 && radTimeGetMSSinceEpoch () >= testTimerExpiry)
+    {
+        testTimerExpiry = 0;
+        (*testTimerRoutine) (testTimerParm);
+    }
+
+    return;
+}
+
+static int findFreePort (void)
+{
+    struct sockaddr_in  addr;
+    socklen_t           length = sizeof (addr);
+    int                 fd, port = 0;
+
+    fd = socket (AF_INET, SOCK_STREAM, 0);
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_addr.s_addr    = htonl (INADDR_ANY);
+    addr.sin_port           = 0;
+    if (fd >= 0 &&
+        bind (fd, (struct sockaddr *)&addr, sizeof (addr)) == 0 &&
+        getsockname (fd, (struct sockaddr *)&addr, &length) == 0)
+    {
+        port = ntohs (addr.sin_port);
+    }
+    if (fd >= 0)
+    {
+        close (fd);
+    }
+    return port;
+}
+
+static int openClient (TEST_CLIENT *client)
+{
+    struct sockaddr_in  addr;
+
+    memset (client, 0, sizeof (*client));
+    client->fd = socket (AF_INET, SOCK_STREAM, 0);
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_addr.s_addr    = htonl (INADDR_LOOPBACK);
+    addr.sin_port           = htons ((USHORT)testPort);
+    if (client->fd < 0 || connect (client->fd, (struct sockaddr *)&addr, sizeof (addr)) != 0)
+    {
+        printf ("serverTest: cannot connect to port %d\n", testPort);
+        return ERROR;
+    }
+
+    // let the server accept it:
+    runServer (10);
+    return OK;
+}
+
+static void closeClient (TEST_CLIENT *client)
+{
+    close (client->fd);
+    client->fd = -1;
+    runServer (10);
+    return;
+}
+
+static void sendRequest (TEST_CLIENT *client, const char *request)
+{
+    int             length = strlen (request);
+
+    if (send (client->fd, request, length, MSG_NOSIGNAL) != length)
+    {
+        printf ("serverTest: cannot send the request\n");
+    }
+    return;
+}
+
+// run the server until the next reply is in; returns OK or ERROR
+static int getReply (TEST_CLIENT *client, int isHead, TEST_REPLY *reply)
+{
+    ULONGLONG       end = radTimeGetMSSinceEpoch () + TEST_REPLY_MS;
+    char            *headerEnd, *length;
+    int             count, headerLength, need;
+
+    memset (reply, 0, sizeof (*reply));
+    while (radTimeGetMSSinceEpoch () < end)
+    {
+        client->input[client->length] = 0;
+        headerEnd = strstr (client->input, "\r\n\r\n");
+        if (headerEnd != NULL)
+        {
+            headerLength = (headerEnd + 4) - client->input;
+            sscanf (client->input, "HTTP/1.1 %d", &reply->status);
+            length = strstr (client->input, "Content-Length: ");
+            need = 0;
+            if (! isHead && reply->status != 304 && length != NULL && length < headerEnd)
+            {
+                need = atoi (length + 16);
+            }
+
+            if (client->length >= headerLength + need &&
+                headerLength < (int)sizeof (reply->headers))
+            {
+                memcpy (reply->headers, client->input, headerLength);
+                reply->headers[headerLength] = 0;
+                memcpy (reply->body, &client->input[headerLength], need);
+                reply->bodyLength = need;
+
+                client->length -= headerLength + need;
+                memmove (client->input, &client->input[headerLength + need], client->length);
+                return OK;
+            }
+        }
+
+        if (client->isClosed)
+        {
+            return ERROR;
+        }
+
+        runServer (10);
+        count = recv (client->fd, &client->input[client->length],
+                      sizeof (client->input) - 1 - client->length, MSG_DONTWAIT);
+        if (count > 0)
+        {
+            client->length += count;
+        }
+        else if (count == 0)
+        {
+            client->isClosed = TRUE;
+        }
+    }
+
+    return ERROR;
+}
+
+// is the connection closed by the server once it has sent everything?
+static int isClosedByServer (TEST_CLIENT *client)
+{
+    ULONGLONG       end = radTimeGetMSSinceEpoch () + TEST_REPLY_MS;
+    char            buffer[1024];
+    int             count;
+
+    while (! client->isClosed && radTimeGetMSSinceEpoch () < end)
+    {
+        runServer (10);
+        count = recv (client->fd, buffer, sizeof (buffer), MSG_DONTWAIT);
+        if (count == 0)
+        {
+            client->isClosed = TRUE;
+        }
+    }
+
+    return client->isClosed;
+}
+
+static void getHeaderValue (TEST_REPLY *reply, const char *name, char *value, int size)
+{
+    char            search[64], *start, *end;
+
+    value[0] = 0;
+    snprintf (search, sizeof (search), "\r\n%s: ", name);
+    start = strstr (reply->headers, search);
+    if (start == NULL)
+    {
+        return;
+    }
+
+    start += strlen (search);
+    end = strstr (start, "\r\n");
+    snprintf (value, size, "%.*s", (int)(end - start), start);
+    return;
+}
+
+static int isGunzipped (TEST_REPLY *reply, const char *data, int length)
+{
+    z_stream        stream;
+    char            *out = malloc (length + 1);
+    int             retVal, isSame;
+
+    memset (&stream, 0, sizeof (stream));
+    if (inflateInit2 (&stream, 15 + 16) != Z_OK)
+    {
+        free (out);
+        return FALSE;
+    }
+
+    stream.next_in      = (Bytef *)reply->body;
+    stream.avail_in     = reply->bodyLength;
+    stream.next_out     = (Bytef *)out;
+    stream.avail_out    = length + 1;
+    retVal = inflate (&stream, Z_FINISH);
+    isSame = (retVal == Z_STREAM_END && stream.total_out == (uLong)length &&
+              memcmp (out, data, length) == 0);
+    inflateEnd (&stream);
+    free (out);
+    return isSame;
+}
+
+static void writeFile (const char *name, const char *data, int length)
+{
+    char            path[_MAX_PATH];
+
+    sprintf (path, "%s/%s", testDir, name);
+    if (htmlbufferWriteFile (path, data, length) == ERROR)
+    {
+        printf ("serverTest: cannot write %s\n", path);
+    }
+    return;
+}
+
+static void check (int condition, char *what)
+{
+    printf ("serverTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static void checkFiles (void)
+{
+    TEST_REPLY      *reply = &testReply;
+    char            request[512], etag[64], gzEtag[64], value[128];
+
+    openClient (&testClient);
+
+    sendRequest (&testClient, "GET /page.htm HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 200 &&
+           reply->bodyLength == TEST_PAGE_SIZE &&
+           memcmp (reply->body, testPage, TEST_PAGE_SIZE) == 0,
+           "GET answers with the file");
+    getHeaderValue (reply, "ETag", etag, sizeof (etag));
+    getHeaderValue (reply, "Connection", value, sizeof (value));
+    check (etag[0] == '"' && !strcmp (value, "keep-alive") &&
+           strstr (reply->headers, "Content-Encoding") == NULL,
+           "reply has an ETag and keeps the connection");
+
+    // the same connection:
+    sprintf (request, "GET /page.htm HTTP/1.1\r\nIf-None-Match: %s\r\n\r\n", etag);
+    sendRequest (&testClient, request);
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 304 &&
+           reply->bodyLength == 0 && strstr (reply->headers, "Content-Length") == NULL,
+           "current ETag is answered with 304");
+
+    sendRequest (&testClient, "GET /page.htm HTTP/1.1\r\nAccept-Encoding: deflate, gzip\r\n\r\n");
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 200 &&
+           strstr (reply->headers, "Content-Encoding: gzip\r\n") != NULL &&
+           reply->bodyLength < TEST_PAGE_SIZE &&
+           isGunzipped (reply, testPage, TEST_PAGE_SIZE),
+           "large text file is sent gzip compressed");
+    getHeaderValue (reply, "ETag", gzEtag, sizeof (gzEtag));
+    check (gzEtag[0] == '"' && strcmp (gzEtag, etag) != 0 &&
+           strstr (reply->headers, "Vary: Accept-Encoding") != NULL,
+           "compressed reply has its own ETag");
+
+    sprintf (request, "GET /page.htm HTTP/1.1\r\nAccept-Encoding: gzip\r\n"
+             "If-None-Match: %s\r\n\r\n", gzEtag);
+    sendRequest (&testClient, request);
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 304,
+           "compressed ETag is answered with 304");
+
+    sendRequest (&testClient, "GET /small.htm HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n");
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 200 &&
+           reply->bodyLength == TEST_SMALL_SIZE &&
+           strstr (reply->headers, "Content-Encoding") == NULL,
+           "small file is not compressed");
+
+    sendRequest (&testClient, "GET /chart.png HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n");
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 200 &&
+           reply->bodyLength == TEST_IMAGE_SIZE &&
+           strstr (reply->headers, "Content-Type: image/png") != NULL &&
+           strstr (reply->headers, "Content-Encoding") == NULL,
+           "image is not compressed");
+
+    // a new generation of the page:
+    testPage[0] = '#';
+    writeFile ("page.htm", testPage, TEST_PAGE_SIZE);
+    sprintf (request, "GET /page.htm HTTP/1.1\r\nIf-None-Match: %s\r\n\r\n", etag);
+    sendRequest (&testClient, request);
+    getReply (&testClient, FALSE, reply);
+    getHeaderValue (reply, "ETag", value, sizeof (value));
+    check (reply->status == 200 && reply->bodyLength == TEST_PAGE_SIZE &&
+           reply->body[0] == '#' && strcmp (value, etag) != 0,
+           "stale ETag gets the new file");
+
+    sendRequest (&testClient, "HEAD /page.htm HTTP/1.1\r\n\r\n"
+                 "GET /small.htm HTTP/1.1\r\n\r\n");
+    check (getReply (&testClient, TRUE, reply) == OK && reply->status == 200 &&
+           strstr (reply->headers, "Content-Length: 20000\r\n") != NULL &&
+           getReply (&testClient, FALSE, reply) == OK && reply->status == 200 &&
+           reply->bodyLength == TEST_SMALL_SIZE,
+           "HEAD has no body, pipelined requests are answered");
+
+    sendRequest (&testClient, "GET /missing.htm HTTP/1.1\r\n\r\n");
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 404,
+           "missing file is 404");
+
+    sendRequest (&testClient, "GET /../serverTest.c HTTP/1.1\r\n\r\n");
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 404,
+           "path outside the image path is 404");
+
+    sendRequest (&testClient, "POST /page.htm HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 405 &&
+           isClosedByServer (&testClient),
+           "POST is 405 and closes the connection");
+    closeClient (&testClient);
+    return;
+}
+
+static void checkLimits (void)
+{
+    TEST_REPLY      *reply = &testReply;
+    char            line[1024];
+    int             i;
+
+    // a header block which never ends:
+    openClient (&testClient);
+    sendRequest (&testClient, "GET /page.htm HTTP/1.1\r\n");
+    memset (line, 'x', sizeof (line) - 3);
+    strcpy (&line[sizeof (line) - 3], "\r\n");
+    line[0] = 'X';
+    line[1] = ':';
+    for (i = 0; i <= HTML_SERVER_REQUEST_MAX / (int)(sizeof (line) - 1); i ++)
+    {
+        sendRequest (&testClient, line);
+    }
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 431 &&
+           isClosedByServer (&testClient),
+           "oversized request headers are 431 and closed");
+    closeClient (&testClient);
+
+    // just under the limit is fine:
+    openClient (&testClient);
+    sendRequest (&testClient, "GET /small.htm HTTP/1.1\r\n");
+    for (i = 0; i < (HTML_SERVER_REQUEST_MAX / 2) / (int)(sizeof (line) - 1); i ++)
+    {
+        sendRequest (&testClient, line);
+    }
+    sendRequest (&testClient, "\r\n");
+    check (getReply (&testClient, FALSE, reply) == OK && reply->status == 200 &&
+           reply->bodyLength == TEST_SMALL_SIZE,
+           "request headers under the limit are answered");
+    closeClient (&testClient);
+    return;
+}
+
+static void checkEvents (void)
+{
+    LOOP_PKT        loop;
+    ULONGLONG       end;
+    int             count;
+
+    openClient (&testClient);
+    sendRequest (&testClient, "GET /events HTTP/1.1\r\n\r\n");
+    end = radTimeGetMSSinceEpoch () + TEST_REPLY_MS;
+    while (strstr (testClient.input, "\r\n\r\n") == NULL && radTimeGetMSSinceEpoch () < end)
+    {
+        runServer (10);
+        count = recv (testClient.fd, &testClient.input[testClient.length],
+                      sizeof (testClient.input) - 1 - testClient.length, MSG_DONTWAIT);
+        if (count > 0)
+        {
+            testClient.length += count;
+            testClient.input[testClient.length] = 0;
+        }
+    }
+
+    memset (&loop, 0, sizeof (loop));
+    loop.outTemp = 71.5;
+    htmlserverPushLoop (&loop);
+    end = radTimeGetMSSinceEpoch () + TEST_REPLY_MS;
+    while (strstr (testClient.input, "\n\n") == NULL && radTimeGetMSSinceEpoch () < end)
+    {
+        runServer (10);
+        count = recv (testClient.fd, &testClient.input[testClient.length],
+                      sizeof (testClient.input) - 1 - testClient.length, MSG_DONTWAIT);
+        if (count > 0)
+        {
+            testClient.length += count;
+            testClient.input[testClient.length] = 0;
+        }
+    }
+
+    check (strstr (testClient.input, "Content-Type: text/event-stream\r\n") != NULL &&
+           strstr (testClient.input, "event: loop\ndata: {\"outTemp\":71.5}\n\n") != NULL,
+           "event stream gets the LOOP packet");
+    closeClient (&testClient);
+    return;
+}
+
+
+int main (int argc, char *argv[])
+{
+    char            command[128], small[TEST_SMALL_SIZE], image[TEST_IMAGE_SIZE];
+    int             i;
+
+    alarm (TEST_TIMEOUT_SECS);
+
+    snprintf (testDir, sizeof (testDir), "/tmp/serverTest.%d", (int)getpid ());
+    if (mkdir (testDir, 0755) != 0)
+    {
+        printf ("serverTest: cannot create %s\n", testDir);
+        return 1;
+    }
+
+    testPort = findFreePort ();
+    if (testPort == 0 || htmlserverInit (testPort, testDir) == ERROR)
+    {
+        printf ("serverTest: cannot start the server\n");
+        return 1;
+    }
+
+    for (i = 0; i < TEST_PAGE_SIZE; i ++)
+    {
+        testPage[i] = 'a' + ((i * 7) % 26);
+    }
+    memset (small, 's', sizeof (small));
+    for (i = 0; i < TEST_IMAGE_SIZE; i ++)
+    {
+        image[i] = (char)(i * 31);
+    }
+    writeFile ("page.htm", testPage, TEST_PAGE_SIZE);
+    writeFile ("small.htm", small, TEST_SMALL_SIZE);
+    writeFile ("chart.png", image, TEST_IMAGE_SIZE);
+
+    checkFiles ();
+    checkLimits ();
+    checkEvents ();
+
+    htmlserverExit ();
+    htmlbufferFlushFiles ();
+
+    sprintf (command, "rm -rf %s", testDir);
+    if (system (command) != 0)
+    {
+        printf ("serverTest: cannot remove %s\n", testDir);
+    }
+
+    printf ("serverTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
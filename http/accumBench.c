@@ -0,0 +1,346 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        accumBench.c
+
+  PURPOSE:
+        Compare the bucketed sample accumulator in sensor.c with the list
+        accumulator it replaced ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The list accumulator (one radlib buffer per sample, the total summed
+        by walking the list) is kept here as it was in sensor.c. Both are
+        filled with the same samples for the accumulator windows used in
+        the tree, then read repeatedly the way wvhttpd reads its 60 minute
+        rain total on every rapid-fire post.
+
+        The test fails if the two disagree on the total or average, or if
+        the ring counts a sample that is already outside its window. The
+        timings are printed but not checked, since they depend on the host.
+
+        radlib buffers are replaced by malloc here so no radlib system is
+        needed to run the benchmark.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+
+/*  ... Library include files
+*/
+#include <radlist.h>
+#include <radbuffers.h>
+
+/*  ... Local include files
+*/
+#include <sensor.h>
+
+
+/*  ... local memory
+*/
+
+#define BENCH_READS             2000
+#define BENCH_AGE_MARGIN        300         // keep samples clear of aging
+#define BENCH_TOLERANCE         0.0005      // relative, for float sums
+
+typedef struct
+{
+    char            *name;
+    int             minutes;
+    int             secondsPerSample;
+} BENCH_CASE;
+
+static BENCH_CASE   benchCases[] =
+{
+    { "60 min rain, 2 s posts",       60,         2 },
+    { "60 min rain, 1 s LOOP",        60,         1 },
+    { "12 hour temp avg, 1 s LOOP",   60 * 12,    1 }
+};
+
+static int          benchFailures;
+
+
+//  ... stand-ins for the radlib buffer pool and wvutils
+
+void *radBufferGet (int size)
+{
+    return malloc (size);
+}
+
+void radBufferRls (void *buffer)
+{
+    free (buffer);
+    return;
+}
+
+int wvutilsGetHour (time_t timeval)
+{
+    struct tm       bknTime;
+
+    localtime_r (&timeval, &bknTime);
+    return bknTime.tm_hour;
+}
+
+int wvutilsGetMin (time_t timeval)
+{
+    struct tm       bknTime;
+
+    localtime_r (&timeval, &bknTime);
+    return bknTime.tm_min;
+}
+
+
+//  ... the list accumulator sensor.c used before the bucket ring
+
+typedef struct
+{
+    NODE                node;
+    float               value;
+    time_t              sampleTime;
+} LIST_ACCUM_SAMPLE;
+
+typedef struct
+{
+    RADLIST             samples;
+    int                 secondsInAccumulator;
+} LIST_ACCUM, *LIST_ACCUM_ID;
+
+static void listAccumAge (LIST_ACCUM_ID id)
+{
+    LIST_ACCUM_SAMPLE   *nodePtr, *oldPtr;
+    time_t              nowTime = time(NULL);
+
+    for (nodePtr = (LIST_ACCUM_SAMPLE*)radListGetLast (&id->samples);
+         nodePtr != NULL;
+         nodePtr = (LIST_ACCUM_SAMPLE*)radListGetLast (&id->samples))
+    {
+        if ((nowTime - id->secondsInAccumulator) >= nodePtr->sampleTime)
+        {
+            oldPtr = (LIST_ACCUM_SAMPLE*)radListRemoveLast (&id->samples);
+            radBufferRls (oldPtr);
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+static LIST_ACCUM_ID listAccumInit (int minutesInAccumulator)
+{
+    LIST_ACCUM_ID       newId;
+
+    newId = (LIST_ACCUM_ID)radBufferGet (sizeof (LIST_ACCUM));
+    if (newId == NULL)
+    {
+        return NULL;
+    }
+
+    radListReset (&newId->samples);
+    newId->secondsInAccumulator = minutesInAccumulator * 60;
+    return newId;
+}
+
+static void listAccumExit (LIST_ACCUM_ID id)
+{
+    LIST_ACCUM_SAMPLE*  nodePtr;
+
+    for (nodePtr = (LIST_ACCUM_SAMPLE*)radListRemoveFirst (&id->samples);
+         nodePtr != NULL;
+         nodePtr = (LIST_ACCUM_SAMPLE*)radListRemoveFirst (&id->samples))
+    {
+        radBufferRls (nodePtr);
+    }
+    radBufferRls (id);
+}
+
+static void listAccumAddSample (LIST_ACCUM_ID id, time_t timeStamp, float value)
+{
+    LIST_ACCUM_SAMPLE*  newNode;
+
+    newNode = (LIST_ACCUM_SAMPLE*)radBufferGet (sizeof(LIST_ACCUM_SAMPLE));
+    if (newNode == NULL)
+    {
+        return;
+    }
+
+    newNode->value      = value;
+    newNode->sampleTime = timeStamp;
+    radListAddToFront (&id->samples, (NODE_PTR)newNode);
+
+    listAccumAge (id);
+}
+
+static float listAccumGetTotal (LIST_ACCUM_ID id)
+{
+    LIST_ACCUM_SAMPLE*  nodePtr;
+    float               sum = 0;
+
+    listAccumAge (id);
+
+    for (nodePtr = (LIST_ACCUM_SAMPLE*)radListGetFirst (&id->samples);
+         nodePtr != NULL;
+         nodePtr = (LIST_ACCUM_SAMPLE*)radListGetNext (&id->samples, (NODE_PTR)nodePtr))
+    {
+        sum += nodePtr->value;
+    }
+
+    return sum;
+}
+
+static float listAccumGetAverage (LIST_ACCUM_ID id)
+{
+    float               samples, sum;
+
+    sum = listAccumGetTotal (id);
+    samples = (float)radListGetNumberOfNodes (&id->samples);
+    if (samples > 0)
+    {
+        return (sum/samples);
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+
+//  ... the benchmark
+
+static double getUsecs (void)
+{
+    struct timeval      tv;
+
+    gettimeofday (&tv, NULL);
+    return ((double)tv.tv_sec * 1000000.0) + (double)tv.tv_usec;
+}
+
+static int isClose (float a, float b)
+{
+    return (fabs (a - b) <= BENCH_TOLERANCE * fmax (1.0, fabs (b)));
+}
+
+static void check (int condition, char *caseName, char *what, float ring, float list)
+{
+    if (! condition)
+    {
+        printf ("accumBench: %s: %s differs: ring %f, list %f - FAIL\n",
+                caseName, what, ring, list);
+        benchFailures ++;
+    }
+    return;
+}
+
+static int runCase (BENCH_CASE *bench)
+{
+    WV_ACCUM_ID         ring;
+    LIST_ACCUM_ID       list;
+    time_t              now = time (NULL), start, sampleTime;
+    float               *values, ringTotal = 0, listTotal = 0;
+    int                 i, numSamples;
+    double              startTime, ringAdd, listAdd, ringRead, listRead;
+
+    start = now - (bench->minutes * 60) + BENCH_AGE_MARGIN;
+    numSamples = (now - start) / bench->secondsPerSample + 1;
+    values = (float *)malloc (numSamples * sizeof (float));
+    ring = sensorAccumInit (bench->minutes);
+    list = listAccumInit (bench->minutes);
+    if (values == NULL || ring == NULL || list == NULL)
+    {
+        printf ("accumBench: %s: out of memory\n", bench->name);
+        return ERROR;
+    }
+
+    srand (bench->minutes + bench->secondsPerSample);
+    for (i = 0; i < numSamples; i ++)
+    {
+        values[i] = (float)(rand () % 1000) / 10000.0;
+    }
+
+    // add the same samples, oldest first, as the daemons do:
+    startTime = getUsecs ();
+    for (i = 0, sampleTime = start; i < numSamples; i ++, sampleTime += bench->secondsPerSample)
+    {
+        sensorAccumAddSample (ring, sampleTime, values[i]);
+    }
+    ringAdd = getUsecs () - startTime;
+
+    startTime = getUsecs ();
+    for (i = 0, sampleTime = start; i < numSamples; i ++, sampleTime += bench->secondsPerSample)
+    {
+        listAccumAddSample (list, sampleTime, values[i]);
+    }
+    listAdd = getUsecs () - startTime;
+
+    startTime = getUsecs ();
+    for (i = 0; i < BENCH_READS; i ++)
+    {
+        ringTotal = sensorAccumGetTotal (ring);
+    }
+    ringRead = getUsecs () - startTime;
+
+    startTime = getUsecs ();
+    for (i = 0; i < BENCH_READS; i ++)
+    {
+        listTotal = listAccumGetTotal (list);
+    }
+    listRead = getUsecs () - startTime;
+
+    check (isClose (ringTotal, listTotal), bench->name, "total", ringTotal, listTotal);
+    check (isClose (sensorAccumGetAverage (ring), listAccumGetAverage (list)),
+           bench->name, "average",
+           sensorAccumGetAverage (ring), listAccumGetAverage (list));
+
+    // a sample already too old for the window must not count (the list
+    // version only aged from the oldest end, so it kept these):
+    sensorAccumAddSample (ring, now - (bench->minutes * 60) - 60, 100.0);
+    check (isClose (sensorAccumGetTotal (ring), ringTotal), bench->name,
+           "expired sample total", sensorAccumGetTotal (ring), ringTotal);
+
+    printf ("accumBench: %-28s %6d samples: add %7.3f us vs %7.3f us, "
+            "total %9.3f us vs %9.3f us (%.0fx)\n",
+            bench->name, numSamples,
+            ringAdd / numSamples, listAdd / numSamples,
+            ringRead / BENCH_READS, listRead / BENCH_READS,
+            (ringRead > 0) ? listRead / ringRead : 0.0);
+
+    sensorAccumExit (ring);
+    listAccumExit (list);
+    free (values);
+    return OK;
+}
+
+int main (int argc, char *argv[])
+{
+    int                 i;
+
+    printf ("accumBench: per sample add and per read total, ring vs list\n");
+
+    for (i = 0; i < (int)(sizeof (benchCases) / sizeof (benchCases[0])); i ++)
+    {
+        if (runCase (&benchCases[i]) == ERROR)
+        {
+            return 1;
+        }
+    }
+
+    printf ("accumBench: %d failures\n", benchFailures);
+    return ((benchFailures == 0) ? 0 : 1);
+}
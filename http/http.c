@@ -10,6 +10,7 @@
         Date            Engineer        Revision        Remarks
         07/12/2005      M.S. Teel       0               
         12/09/2007      M.S. Teel       1               Add WeatherForYou.com
+        10/19/2026      M.S. Teel       2               Shared upload engine
  
   NOTES:
         
@@ -55,62 +56,26 @@ static char*                    httpStatusLabels[STATUS_STATS_MAX] =
 {
     "Connection errors",
     "Packets sent",
-    NULL,
-    NULL
+    "Retries queued",
+    "Average latency ms"
 };
 
 /* ... methods
 */
-// curl recv callback
-static size_t recv_data (void *buffer, size_t size, size_t nmemb, void *userp)
+// log the URL and hand it to the upload engine
+static void httpSend (char *service, char *httpBuffer, int retry)
 {
-    // we don't care about the recvd data
-    return size*nmemb;
-}
-
-static void wuSendCurl(char *httpBuffer);
-
-static void wuSendCurl(char *httpBuffer) {
-    CURL                *curl;
-    CURLcode            res;
-    char                curlError[CURL_ERROR_SIZE];
     char                tempBfr[194];
 
     wvstrncpy (tempBfr, httpBuffer, 192);
-    wvutilsLogEvent (PRI_STATUS, "WUNDERGROUND-send: %s", tempBfr);
+    wvutilsLogEvent (PRI_STATUS, "%s-send: %s", service, tempBfr);
     if (strlen(httpBuffer) > 192)
     {
         wvstrncpy (tempBfr, &httpBuffer[192], 192);
-        wvutilsLogEvent (PRI_STATUS, "WUNDERGROUND-send: %s", tempBfr);
-    }
-
-
-    // OK, now use libcurl to execute the HTTP "GET"
-    curl = curl_easy_init ();
-    if (curl == NULL)
-    {
-        radMsgLog (PRI_HIGH, "WUNDERGROUND-error: failed to initialize curl!");
-        statusUpdateMessage("HTTP-WU: failed to initialize curl");
-        statusIncrementStat(HTTP_STATS_CONNECT_ERRORS);
-        return;
-    }
-    
-    curl_easy_setopt (curl, CURLOPT_URL, httpBuffer);
-    curl_easy_setopt (curl, CURLOPT_WRITEFUNCTION, recv_data);
-    curl_easy_setopt (curl, CURLOPT_ERRORBUFFER, curlError);
-    curl_easy_setopt (curl, CURLOPT_TIMEOUT, 60);
-
-    res = curl_easy_perform (curl);
-    if (res != 0)
-    {
-        statusUpdateMessage("HTTP-WU: failed curl_easy_perform");
-        statusIncrementStat(HTTP_STATS_CONNECT_ERRORS);
-        radMsgLog (PRI_HIGH, "WUNDERGROUND-error: %s", curlError);
+        wvutilsLogEvent (PRI_STATUS, "%s-send: %s", service, tempBfr);
     }
-    
-    curl_easy_cleanup (curl);
-    statusIncrementStat(HTTP_STATS_PKTS_SENT);
 
+    httpEngineSend (&httpWork.engine, service, httpBuffer, retry);
     return;
 }
 
@@ -171,7 +136,7 @@ static void processWUNDERGROUND (WVIEW_MSG_ARCHIVE_NOTIFY *notify)
     length += sprintf (&httpBuffer[length], "&weather=&clouds=&softwaretype=%s&action=updateraw",
                        version);
 
-    wuSendCurl(httpBuffer);
+    httpSend ("WUNDERGROUND", httpBuffer, TRUE);
 
     return;
 }
@@ -211,6 +176,12 @@ static void processWUNDERGROUNDRapid (LOOP_PKT *loopData)
     length += sprintf (&httpBuffer[length], "&windgustmph=%3.3d", 
                        (loopData->windGust >= 0) ? loopData->windGust : 0);
 
+    // exact trailing windows from the wviewd wind statistics:
+    length += sprintf (&httpBuffer[length], "&windspdmph_avg2m=%d&winddir_avg2m=%d",
+                       loopData->twoMinuteAvgWindSpeed, loopData->twoMinuteAvgWindDir);
+    length += sprintf (&httpBuffer[length], "&windgustmph_10m=%d&windgustdir_10m=%d",
+                       loopData->tenMinuteWindGust, loopData->tenMinuteWindGustDir);
+
     if (loopData->outHumidity >= 0 && loopData->outHumidity <= 100)
     {
         length += sprintf (&httpBuffer[length], "&humidity=%d", loopData->outHumidity);
@@ -235,7 +206,8 @@ static void processWUNDERGROUNDRapid (LOOP_PKT *loopData)
     length += sprintf (&httpBuffer[length], "&weather=&clouds=&softwaretype=%s&action=updateraw",
                        version);
 
-    wuSendCurl(httpBuffer);
+    // real time updates are not worth retrying:
+    httpSend ("WUNDERGROUND", httpBuffer, FALSE);
 
     return;
 }
@@ -249,10 +221,6 @@ static void processWEATHERFORYOU (WVIEW_MSG_ARCHIVE_NOTIFY *notify)
     char                *serv;
     int                 port;
     char                version[64];
-    CURL                *curl;
-    CURLcode            res;
-    char                curlError[CURL_ERROR_SIZE];
-    char                tempBfr[194];
     float               rainIN = sensorAccumGetTotal (httpWork.rainAccumulator);
     
     // format the WEATHERFORYOU data
@@ -301,41 +269,7 @@ static void processWEATHERFORYOU (WVIEW_MSG_ARCHIVE_NOTIFY *notify)
     length += sprintf (&httpBuffer[length], "&weather=&softwaretype=%s&action=updateraw",
                        version);
 
-
-    wvstrncpy (tempBfr, httpBuffer, 192);
-    wvutilsLogEvent (PRI_STATUS, "WEATHERFORYOU-send: %s", tempBfr);
-    if (strlen(httpBuffer) > 192)
-    {
-        wvstrncpy (tempBfr, &httpBuffer[192], 192);
-        wvutilsLogEvent (PRI_STATUS, "WEATHERFORYOU-send: %s", tempBfr);
-    }
-
-
-    // OK, now use libcurl to execute the HTTP "GET"
-    curl = curl_easy_init ();
-    if (curl == NULL)
-    {
-        radMsgLog (PRI_HIGH, "WEATHERFORYOU-error: failed to initialize curl!");
-        statusUpdateMessage("HTTP-WFY: failed to initialize curl");
-        statusIncrementStat(HTTP_STATS_CONNECT_ERRORS);
-        return;
-    }
-    
-    curl_easy_setopt (curl, CURLOPT_URL, httpBuffer);
-    curl_easy_setopt (curl, CURLOPT_WRITEFUNCTION, recv_data);
-    curl_easy_setopt (curl, CURLOPT_ERRORBUFFER, curlError);
-    curl_easy_setopt (curl, CURLOPT_TIMEOUT, 60);
-
-    res = curl_easy_perform (curl);
-    if (res != 0)
-    {
-        radMsgLog (PRI_HIGH, "WEATHERFORYOU-error: %s", curlError);
-        statusUpdateMessage("HTTP-WFY: failed curl_easy_perform");
-        statusIncrementStat(HTTP_STATS_CONNECT_ERRORS);
-    }
-    
-    curl_easy_cleanup (curl);
-    statusIncrementStat(HTTP_STATS_PKTS_SENT);
+    httpSend ("WEATHERFORYOU", httpBuffer, TRUE);
 
     return;
 }
@@ -512,15 +446,15 @@ static void defaultSigHandler (int signum)
                 return;
             }
 
-            // We exit now, we are probably hung on a "curl_easy_perform" call!
-            radMsgLog (PRI_HIGH, "wvhttpd: recv signal %d: exiting now!", signum);
-            statusUpdateMessage("exiting normally");
-            statusUpdate(STATUS_SHUTDOWN);
-            radMsgRouterExit ();
-            httpSysExit (&httpWork);
-            radProcessExit ();
-            radSystemExit (WVIEW_SYSTEM_ID);
-            exit (0);                
+            // uploads no longer block, so we can allow the process to exit
+            // normally (saving the retry queue)...
+            radMsgLog (PRI_HIGH, "wvhttpd: recv signal %d: exiting!", signum);
+
+            httpWork.exiting = TRUE;
+            radProcessSetExitFlag ();
+
+            radProcessSignalCatch(signum, defaultSigHandler);
+            break;
     }
     
     return;
@@ -606,6 +540,7 @@ int main (int argc, char *argv[])
     ARCHIVE_PKT     recordStore;
     float           tempRain;
     int             runAsDaemon = TRUE;
+    char            retryFile[_MAX_PATH];
 
     if (argc > 1)
     {
@@ -893,6 +828,22 @@ int main (int argc, char *argv[])
         timeStamp = dbsqliteArchiveGetNextRecord(timeStamp, &recordStore);
     }
 
+    // Create the upload engine
+    sprintf (retryFile, "%s/%s", WVIEW_RUN_DIR, HTTP_RETRY_FILE);
+    if (httpEngineInit (&httpWork.engine, retryFile) == ERROR)
+    {
+        statusUpdateMessage("httpEngineInit failed");
+        statusUpdate(STATUS_ERROR);
+        radMsgLog (PRI_HIGH, "httpEngineInit failed");
+        sensorAccumExit (httpWork.rainAccumulator);
+        radMsgRouterExit ();
+        dbsqliteArchiveExit();
+        httpSysExit (&httpWork);
+        radProcessExit ();
+        radSystemExit (WVIEW_SYSTEM_ID);
+        exit (1);
+    }
+
     // enable message reception from the radlib router for archive notifications
     radMsgRouterMessageRegister (WVIEW_MSG_TYPE_ARCHIVE_NOTIFY);
 
@@ -924,6 +875,7 @@ int main (int argc, char *argv[])
     radMsgLog (PRI_STATUS, "exiting normally...");
     statusUpdate(STATUS_SHUTDOWN);
 
+    httpEngineExit (&httpWork.engine);
     sensorAccumExit (httpWork.rainAccumulator);
     radMsgRouterExit ();
     dbsqliteArchiveExit();
@@ -12,6 +12,7 @@
         Date            Engineer        Revision        Remarks
         07/12/2005      M.S. Teel       0               
         12/09/2007      M.S. Teel       1               Add WeatherForYou.com
+        10/19/2026      M.S. Teel       2               Shared upload engine
  
   NOTES:
         
@@ -59,6 +60,7 @@
 #include <dbsqlite.h>
 #include <wvconfig.h>
 #include <status.h>
+#include <httpEngine.h>
 
 
 
@@ -71,7 +73,9 @@
 typedef enum
 {
     HTTP_STATS_CONNECT_ERRORS       = 0,
-    HTTP_STATS_PKTS_SENT
+    HTTP_STATS_PKTS_SENT,
+    HTTP_STATS_RETRIES_QUEUED,
+    HTTP_STATS_AVG_LATENCY_MS
 } HTTP_STATS;
 
 
@@ -89,6 +93,7 @@ typedef struct
     char            youstationId[128];
     char            youpassword[64];
     WV_ACCUM_ID     rainAccumulator;
+    HTTP_ENGINE     engine;
     int             inMainLoop;
     int             exiting;
 } WVIEW_HTTPD_WORK;
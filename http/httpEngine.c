@@ -0,0 +1,854 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        httpEngine.c
+
+  PURPOSE:
+        Provide the wvhttpd upload engine: persistent curl handles per host,
+        non-blocking requests serviced from the radProcess loop and an on-disk
+        retry queue for failed posts.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        See httpEngine.h.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radprocess.h>
+#include <radtimeUtils.h>
+
+/*  ... Local include files
+*/
+#include <http.h>
+
+
+/*  ... static (local) memory declarations
+*/
+static const int        latencyLimits[HTTP_LATENCY_BINS - 1] = HTTP_LATENCY_LIMITS;
+
+static const char       *errorNames[HTTP_ERROR_TYPES] =
+{
+    "resolve",
+    "connect",
+    "timeout",
+    "status",
+    "other"
+};
+
+
+/* ... methods
+*/
+static void CheckDone (HTTP_ENGINE_ID id);
+static void StartPending (HTTP_ENGINE_ID id);
+
+// curl recv callback
+static size_t recv_data (void *buffer, size_t size, size_t nmemb, void *userp)
+{
+    // we don't care about the recvd data
+    return size*nmemb;
+}
+
+static HTTP_REQUEST *CreateRequest
+(
+    const char      *service,
+    const char      *url,
+    time_t          queued,
+    int             retry
+)
+{
+    HTTP_REQUEST    *request;
+    const char      *start, *end;
+    int             length;
+
+    if (strlen (url) >= HTTP_MAX_URL)
+    {
+        radMsgLog (PRI_HIGH, "%s-error: URL too long", service);
+        return NULL;
+    }
+
+    // the host (and port) is what follows the scheme up to the path:
+    start = strstr (url, "://");
+    start = (start == NULL) ? url : start + 3;
+    end = start + strcspn (start, "/?");
+    length = end - start;
+    if (length == 0 || length >= HTTP_MAX_HOST)
+    {
+        radMsgLog (PRI_HIGH, "%s-error: bad host in URL", service);
+        return NULL;
+    }
+
+    request = (HTTP_REQUEST *)malloc (sizeof (*request));
+    if (request == NULL)
+    {
+        radMsgLog (PRI_HIGH, "%s-error: cannot allocate request", service);
+        return NULL;
+    }
+
+    memset (request, 0, sizeof (*request));
+    wvstrncpy (request->service, service, HTTP_MAX_SERVICE);
+    memcpy (request->host, start, length);
+    request->host[length] = 0;
+    strcpy (request->url, url);
+    request->queued = queued;
+    request->retry  = retry;
+    return request;
+}
+
+static HTTP_HOST *GetHost (HTTP_ENGINE_ID id, const char *name)
+{
+    HTTP_HOST       *host;
+    HTTP_HANDLE     *handle;
+    int             i;
+
+    for (host = (HTTP_HOST *)radListGetFirst (&id->hosts);
+         host != NULL;
+         host = (HTTP_HOST *)radListGetNext (&id->hosts, (NODE_PTR)host))
+    {
+        if (! strcmp (host->host, name))
+        {
+            return host;
+        }
+    }
+
+    host = (HTTP_HOST *)malloc (sizeof (*host));
+    if (host == NULL)
+    {
+        return NULL;
+    }
+    memset (host, 0, sizeof (*host));
+    wvstrncpy (host->host, name, HTTP_MAX_HOST);
+
+    // these live as long as we do so DNS results and connections are reused:
+    for (i = 0; i < HTTP_HOST_HANDLES; i ++)
+    {
+        handle = &host->handles[i];
+        handle->host = host;
+        handle->curl = curl_easy_init ();
+        if (handle->curl == NULL)
+        {
+            radMsgLog (PRI_HIGH, "HTTP-error: failed to initialize curl!");
+            for (i --; i >= 0; i --)
+            {
+                curl_easy_cleanup (host->handles[i].curl);
+            }
+            free (host);
+            return NULL;
+        }
+
+        // Make sure libcurl does NOT use SIG_ALARM:
+        curl_easy_setopt (handle->curl, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt (handle->curl, CURLOPT_PRIVATE, handle);
+        curl_easy_setopt (handle->curl, CURLOPT_WRITEFUNCTION, recv_data);
+        curl_easy_setopt (handle->curl, CURLOPT_ERRORBUFFER, handle->curlError);
+        curl_easy_setopt (handle->curl, CURLOPT_FAILONERROR, 1L);
+        curl_easy_setopt (handle->curl, CURLOPT_NOPROGRESS, 1L);
+        curl_easy_setopt (handle->curl, CURLOPT_TIMEOUT, HTTP_REQUEST_TIMEOUT);
+        curl_easy_setopt (handle->curl, CURLOPT_CONNECTTIMEOUT, HTTP_CONNECT_TIMEOUT);
+        curl_easy_setopt (handle->curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt (handle->curl, CURLOPT_DNS_CACHE_TIMEOUT, 3600L);
+    }
+
+    radListAddToEnd (&id->hosts, (NODE_PTR)host);
+    return host;
+}
+
+static HTTP_HANDLE *GetIdleHandle (HTTP_HOST *host)
+{
+    int             i;
+
+    for (i = 0; i < HTTP_HOST_HANDLES; i ++)
+    {
+        if (host->handles[i].request == NULL)
+        {
+            return &host->handles[i];
+        }
+    }
+
+    return NULL;
+}
+
+static int StartRequest (HTTP_ENGINE_ID id, HTTP_HANDLE *handle, HTTP_REQUEST *request)
+{
+    handle->curlError[0] = 0;
+    curl_easy_setopt (handle->curl, CURLOPT_URL, request->url);
+
+    if (curl_multi_add_handle (id->multi, handle->curl) != CURLM_OK)
+    {
+        radMsgLog (PRI_HIGH, "%s-error: curl_multi_add_handle failed", request->service);
+        return ERROR;
+    }
+
+    request->startMS = radTimeGetMSSinceEpoch ();
+    handle->request = request;
+    return OK;
+}
+
+static int LoadRetries (HTTP_ENGINE_ID id)
+{
+    FILE            *fp;
+    HTTP_REQUEST    *request;
+    char            line[HTTP_MAX_URL + 64];
+    char            service[HTTP_MAX_SERVICE];
+    long            queued;
+    int             offset, length;
+    time_t          ntime = time (NULL);
+
+    fp = fopen (id->retryFile, "r");
+    if (fp == NULL)
+    {
+        return OK;
+    }
+
+    while (fgets (line, sizeof(line), fp) != NULL)
+    {
+        length = strlen (line);
+        if (length > 0 && line[length - 1] == '\n')
+            line[length - 1] = 0;
+
+        offset = 0;
+        if (sscanf (line, "%ld %31s %n", &queued, service, &offset) < 2 ||
+            offset == 0 || line[offset] == 0)
+        {
+            continue;
+        }
+
+        if (ntime - (time_t)queued > HTTP_RETRY_MAX_AGE ||
+            id->numRetries >= HTTP_RETRY_QUEUE_MAX)
+        {
+            continue;
+        }
+
+        request = CreateRequest (service, &line[offset], (time_t)queued, TRUE);
+        if (request == NULL)
+        {
+            continue;
+        }
+
+        request->attempts = 1;
+        radListAddToEnd (&id->retries, (NODE_PTR)request);
+        id->numRetries ++;
+    }
+
+    fclose (fp);
+    return OK;
+}
+
+static int SaveRetries (HTTP_ENGINE_ID id)
+{
+    FILE            *fp;
+    HTTP_REQUEST    *request;
+    char            tempFile[_MAX_PATH];
+    int             fd;
+
+    id->retriesChanged = FALSE;
+
+    if (id->numRetries == 0)
+    {
+        unlink (id->retryFile);
+        return OK;
+    }
+
+    // the URLs carry station passwords:
+    snprintf (tempFile, sizeof(tempFile), "%s.tmp", id->retryFile);
+    fd = open (tempFile, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd == -1 || (fp = fdopen (fd, "w")) == NULL)
+    {
+        radMsgLog (PRI_HIGH, "HTTP-error: cannot open %s: %s", tempFile, strerror(errno));
+        if (fd != -1)
+            close (fd);
+        return ERROR;
+    }
+
+    for (request = (HTTP_REQUEST *)radListGetFirst (&id->retries);
+         request != NULL;
+         request = (HTTP_REQUEST *)radListGetNext (&id->retries, (NODE_PTR)request))
+    {
+        fprintf (fp, "%ld %s %s\n", (long)request->queued, request->service, request->url);
+    }
+
+    if (fflush (fp) != 0 || ferror (fp))
+    {
+        radMsgLog (PRI_HIGH, "HTTP-error: write to %s failed: %s", tempFile, strerror(errno));
+        fclose (fp);
+        unlink (tempFile);
+        return ERROR;
+    }
+    fclose (fp);
+
+    if (rename (tempFile, id->retryFile) == -1)
+    {
+        radMsgLog (PRI_HIGH, "HTTP-error: rename to %s failed: %s", id->retryFile, strerror(errno));
+        unlink (tempFile);
+        return ERROR;
+    }
+
+    return OK;
+}
+
+static void QueueRetry (HTTP_ENGINE_ID id, HTTP_REQUEST *request)
+{
+    HTTP_REQUEST    *oldest;
+
+    if (time (NULL) - request->queued > HTTP_RETRY_MAX_AGE)
+    {
+        radMsgLog (PRI_MEDIUM, "%s: giving up on a post after %d attempts",
+                   request->service, request->attempts);
+        id->dropped ++;
+        free (request);
+        return;
+    }
+
+    if (id->numRetries >= HTTP_RETRY_QUEUE_MAX)
+    {
+        oldest = (HTTP_REQUEST *)radListRemoveFirst (&id->retries);
+        radMsgLog (PRI_MEDIUM, "%s: retry queue full, dropping the oldest post",
+                   oldest->service);
+        free (oldest);
+        id->numRetries --;
+        id->dropped ++;
+    }
+
+    radListAddToEnd (&id->retries, (NODE_PTR)request);
+    id->numRetries ++;
+    id->retriesChanged = TRUE;
+}
+
+// move up to HTTP_RETRY_BURST queued posts for 'host' to the pending list
+static void PromoteRetries (HTTP_ENGINE_ID id, HTTP_HOST *host)
+{
+    HTTP_REQUEST    *request, *next;
+    int             count = 0;
+
+    for (request = (HTTP_REQUEST *)radListGetFirst (&id->retries);
+         request != NULL && count < HTTP_RETRY_BURST;
+         request = next)
+    {
+        next = (HTTP_REQUEST *)radListGetNext (&id->retries, (NODE_PTR)request);
+        if (strcmp (request->host, host->host))
+        {
+            continue;
+        }
+
+        radListRemove (&id->retries, (NODE_PTR)request);
+        id->numRetries --;
+        id->retriesChanged = TRUE;
+        radListAddToEnd (&id->pending, (NODE_PTR)request);
+        count ++;
+    }
+}
+
+static HTTP_ERROR_TYPE ClassifyError (CURLcode result)
+{
+    switch (result)
+    {
+        case CURLE_COULDNT_RESOLVE_HOST:
+        case CURLE_COULDNT_RESOLVE_PROXY:
+            return HTTP_ERROR_RESOLVE;
+        case CURLE_COULDNT_CONNECT:
+            return HTTP_ERROR_CONNECT;
+        case CURLE_OPERATION_TIMEDOUT:
+            return HTTP_ERROR_TIMEOUT;
+        case CURLE_HTTP_RETURNED_ERROR:
+            return HTTP_ERROR_STATUS;
+        default:
+            return HTTP_ERROR_OTHER;
+    }
+}
+
+static void FinishRequest (HTTP_ENGINE_ID id, HTTP_HANDLE *handle, CURLcode result)
+{
+    HTTP_REQUEST    *request = handle->request;
+    HTTP_ERROR_TYPE errorType;
+    long            responseCode = 0;
+    int             elapsedMS, bin;
+
+    handle->request = NULL;
+    elapsedMS = (int)(radTimeGetMSSinceEpoch () - request->startMS);
+
+    if (result == CURLE_OK)
+    {
+        for (bin = 0; bin < HTTP_LATENCY_BINS - 1; bin ++)
+        {
+            if (elapsedMS < latencyLimits[bin])
+                break;
+        }
+        id->latency[bin] ++;
+        id->totalMS += elapsedMS;
+        id->sent ++;
+        statusIncrementStat(HTTP_STATS_PKTS_SENT);
+        statusUpdateStat(HTTP_STATS_AVG_LATENCY_MS, (int)(id->totalMS / id->sent));
+
+        if (request->attempts > 0)
+        {
+            radMsgLog (PRI_STATUS, "%s: delivered a post queued %d seconds ago",
+                       request->service, (int)(time (NULL) - request->queued));
+        }
+        free (request);
+
+        // the host is back, resend what it missed:
+        PromoteRetries (id, (HTTP_HOST *)handle->host);
+        return;
+    }
+
+    errorType = ClassifyError (result);
+    id->errors[errorType] ++;
+    id->failed ++;
+    request->attempts ++;
+
+    curl_easy_getinfo (handle->curl, CURLINFO_RESPONSE_CODE, &responseCode);
+    radMsgLog (PRI_HIGH, "%s-error: %s",
+               request->service,
+               (handle->curlError[0] != 0) ? handle->curlError : curl_easy_strerror (result));
+    statusUpdateMessage("HTTP: request failed");
+    statusIncrementStat(HTTP_STATS_CONNECT_ERRORS);
+
+    // a 4xx (bad station ID or password) will never succeed:
+    if (request->retry &&
+        (errorType != HTTP_ERROR_STATUS || responseCode >= 500))
+    {
+        QueueRetry (id, request);
+    }
+    else
+    {
+        free (request);
+    }
+}
+
+static int FindSocket (HTTP_ENGINE_ID id, int fd)
+{
+    int             i;
+
+    for (i = 0; i < id->numSockets; i ++)
+    {
+        if (id->sockets[i].fd == fd)
+            return i;
+    }
+
+    return -1;
+}
+
+// (re)start the process timer for curl's next timeout; sockets waiting to
+// connect or send are polled since radProcess only watches for input
+static void ArmTimer (HTTP_ENGINE_ID id, long timeoutMS)
+{
+    int             i;
+
+    for (i = 0; i < id->numSockets; i ++)
+    {
+        if (id->sockets[i].wantOut)
+        {
+            if (timeoutMS < 0 || timeoutMS > HTTP_POLL_MS)
+                timeoutMS = HTTP_POLL_MS;
+            break;
+        }
+    }
+
+    if (timeoutMS < 0)
+    {
+        radTimerStop (id->timer);
+        return;
+    }
+
+    radTimerStart (id->timer, (timeoutMS > 0) ? timeoutMS : 1);
+}
+
+// service completions and start whatever can go next
+static void CheckDone (HTTP_ENGINE_ID id)
+{
+    CURLMsg         *msg;
+    HTTP_HANDLE     *handle;
+    int             remaining;
+    long            timeoutMS;
+
+    while ((msg = curl_multi_info_read (id->multi, &remaining)) != NULL)
+    {
+        if (msg->msg != CURLMSG_DONE)
+        {
+            continue;
+        }
+
+        handle = NULL;
+        curl_easy_getinfo (msg->easy_handle, CURLINFO_PRIVATE, (char **)&handle);
+        curl_multi_remove_handle (id->multi, msg->easy_handle);
+        if (handle != NULL && handle->request != NULL)
+        {
+            FinishRequest (id, handle, msg->data.result);
+        }
+    }
+
+    StartPending (id);
+
+    if (id->retriesChanged)
+    {
+        SaveRetries (id);
+        statusUpdateStat(HTTP_STATS_RETRIES_QUEUED, id->numRetries);
+    }
+
+    if (time (NULL) - id->lastStatsLog >= HTTP_STATS_LOG_INTERVAL)
+    {
+        httpEngineLogStats (id);
+    }
+
+    if (curl_multi_timeout (id->multi, &timeoutMS) == CURLM_OK)
+    {
+        ArmTimer (id, timeoutMS);
+    }
+}
+
+static void StartPending (HTTP_ENGINE_ID id)
+{
+    HTTP_REQUEST    *request, *next;
+    HTTP_HOST       *host;
+    HTTP_HANDLE     *handle;
+
+    for (request = (HTTP_REQUEST *)radListGetFirst (&id->pending);
+         request != NULL;
+         request = next)
+    {
+        next = (HTTP_REQUEST *)radListGetNext (&id->pending, (NODE_PTR)request);
+
+        host = GetHost (id, request->host);
+        if (host == NULL)
+        {
+            radListRemove (&id->pending, (NODE_PTR)request);
+            free (request);
+            id->dropped ++;
+            continue;
+        }
+
+        handle = GetIdleHandle (host);
+        if (handle == NULL)
+        {
+            continue;
+        }
+
+        radListRemove (&id->pending, (NODE_PTR)request);
+        if (StartRequest (id, handle, request) == ERROR)
+        {
+            if (request->retry)
+            {
+                QueueRetry (id, request);
+            }
+            else
+            {
+                free (request);
+            }
+        }
+    }
+}
+
+// radProcess input callback for a curl socket
+static void SocketDataCallback (int fd, void *userData)
+{
+    HTTP_ENGINE_ID  id = (HTTP_ENGINE_ID)userData;
+    int             running;
+
+    curl_multi_socket_action (id->multi, fd, CURL_CSELECT_IN, &running);
+    CheckDone (id);
+}
+
+static void TimerHandler (void *parm)
+{
+    HTTP_ENGINE_ID  id = (HTTP_ENGINE_ID)parm;
+    struct pollfd   fds[HTTP_MAX_SOCKETS];
+    int             i, numFds = 0, flags, running;
+
+    // poll the sockets radProcess is not watching for output:
+    for (i = 0; i < id->numSockets; i ++)
+    {
+        if (id->sockets[i].wantOut)
+        {
+            fds[numFds].fd      = id->sockets[i].fd;
+            fds[numFds].events  = POLLOUT;
+            fds[numFds].revents = 0;
+            numFds ++;
+        }
+    }
+
+    if (numFds > 0 && poll (fds, numFds, 0) > 0)
+    {
+        for (i = 0; i < numFds; i ++)
+        {
+            flags = 0;
+            if (fds[i].revents & POLLOUT)
+                flags |= CURL_CSELECT_OUT;
+            if (fds[i].revents & (POLLERR | POLLHUP))
+                flags |= CURL_CSELECT_ERR;
+            if (flags != 0)
+            {
+                curl_multi_socket_action (id->multi, fds[i].fd, flags, &running);
+            }
+        }
+    }
+
+    curl_multi_socket_action (id->multi, CURL_SOCKET_TIMEOUT, 0, &running);
+    CheckDone (id);
+}
+
+// curl socket callback: track which sockets need input or output
+static int SocketFunction
+(
+    CURL            *easy,
+    curl_socket_t   fd,
+    int             what,
+    void            *userp,
+    void            *socketp
+)
+{
+    HTTP_ENGINE_ID  id = (HTTP_ENGINE_ID)userp;
+    HTTP_SOCKET     *sock;
+    int             index = FindSocket (id, fd);
+
+    if (what == CURL_POLL_REMOVE)
+    {
+        if (index >= 0)
+        {
+            if (id->sockets[index].isRegistered)
+            {
+                radProcessIODeRegisterDescriptorByFd (fd);
+            }
+            id->sockets[index] = id->sockets[-- id->numSockets];
+        }
+        return 0;
+    }
+
+    if (index < 0)
+    {
+        if (id->numSockets >= HTTP_MAX_SOCKETS)
+        {
+            radMsgLog (PRI_HIGH, "HTTP-error: too many sockets");
+            return -1;
+        }
+        index = id->numSockets ++;
+        memset (&id->sockets[index], 0, sizeof (HTTP_SOCKET));
+        id->sockets[index].fd = fd;
+    }
+
+    sock = &id->sockets[index];
+    sock->wantOut = ((what & CURL_POLL_OUT) != 0);
+
+    if ((what & CURL_POLL_IN) && ! sock->isRegistered)
+    {
+        if (radProcessIORegisterDescriptor (fd, SocketDataCallback, (void *)id) == ERROR)
+        {
+            radMsgLog (PRI_HIGH, "HTTP-error: radProcessIORegisterDescriptor failed");
+            return -1;
+        }
+        sock->isRegistered = TRUE;
+    }
+    else if (! (what & CURL_POLL_IN) && sock->isRegistered)
+    {
+        radProcessIODeRegisterDescriptorByFd (fd);
+        sock->isRegistered = FALSE;
+    }
+
+    return 0;
+}
+
+// curl timer callback: we may not call curl from here, just arm the timer
+static int TimerFunction (CURLM *multi, long timeoutMS, void *userp)
+{
+    ArmTimer ((HTTP_ENGINE_ID)userp, timeoutMS);
+    return 0;
+}
+
+
+// API:
+int httpEngineInit (HTTP_ENGINE_ID id, const char *retryFile)
+{
+    memset (id, 0, sizeof (*id));
+    radListReset (&id->hosts);
+    radListReset (&id->pending);
+    radListReset (&id->retries);
+    wvstrncpy (id->retryFile, retryFile, _MAX_PATH);
+    id->lastStatsLog = time (NULL);
+
+    id->timer = radTimerCreate (NULL, TimerHandler, (void *)id);
+    if (id->timer == NULL)
+    {
+        radMsgLog (PRI_HIGH, "httpEngineInit: radTimerCreate failed");
+        return ERROR;
+    }
+
+    curl_global_init (CURL_GLOBAL_ALL);
+    id->multi = curl_multi_init ();
+    if (id->multi == NULL)
+    {
+        radMsgLog (PRI_HIGH, "httpEngineInit: failed to initialize curl!");
+        radTimerDelete (id->timer);
+        curl_global_cleanup ();
+        return ERROR;
+    }
+
+    curl_multi_setopt (id->multi, CURLMOPT_SOCKETFUNCTION, SocketFunction);
+    curl_multi_setopt (id->multi, CURLMOPT_SOCKETDATA, (void *)id);
+    curl_multi_setopt (id->multi, CURLMOPT_TIMERFUNCTION, TimerFunction);
+    curl_multi_setopt (id->multi, CURLMOPT_TIMERDATA, (void *)id);
+    curl_multi_setopt (id->multi, CURLMOPT_MAXCONNECTS, (long)HTTP_MAX_SOCKETS);
+
+    LoadRetries (id);
+    if (id->numRetries > 0)
+    {
+        radMsgLog (PRI_STATUS, "HTTP: %d posts queued for retry", id->numRetries);
+    }
+    statusUpdateStat(HTTP_STATS_RETRIES_QUEUED, id->numRetries);
+
+    return OK;
+}
+
+int httpEngineSend
+(
+    HTTP_ENGINE_ID  id,
+    const char      *service,
+    const char      *url,
+    int             retry
+)
+{
+    HTTP_REQUEST    *request;
+    HTTP_HOST       *host;
+
+    request = CreateRequest (service, url, time (NULL), retry);
+    if (request == NULL)
+    {
+        statusIncrementStat(HTTP_STATS_CONNECT_ERRORS);
+        return ERROR;
+    }
+
+    host = GetHost (id, request->host);
+    if (host == NULL)
+    {
+        statusUpdateMessage("HTTP: failed to initialize curl");
+        statusIncrementStat(HTTP_STATS_CONNECT_ERRORS);
+        free (request);
+        return ERROR;
+    }
+
+    // real time data is stale by the time a busy host could take it:
+    if (! retry && GetIdleHandle (host) == NULL)
+    {
+        wvutilsLogEvent (PRI_MEDIUM, "%s: %s busy, dropping post", service, host->host);
+        id->dropped ++;
+        free (request);
+        return ERROR;
+    }
+
+    radListAddToEnd (&id->pending, (NODE_PTR)request);
+    StartPending (id);
+
+    if (id->retriesChanged)
+    {
+        SaveRetries (id);
+        statusUpdateStat(HTTP_STATS_RETRIES_QUEUED, id->numRetries);
+    }
+
+    return OK;
+}
+
+void httpEngineLogStats (HTTP_ENGINE_ID id)
+{
+    char            bfr[256];
+    int             i, length;
+
+    id->lastStatsLog = time (NULL);
+
+    radMsgLog (PRI_STATUS, "HTTP: %lu sent, %lu failed, %lu dropped, %d queued for retry",
+               id->sent, id->failed, id->dropped, id->numRetries);
+
+    length = sprintf (bfr, "HTTP: latency ms:");
+    for (i = 0; i < HTTP_LATENCY_BINS - 1; i ++)
+    {
+        length += sprintf (&bfr[length], " <%d:%lu", latencyLimits[i], id->latency[i]);
+    }
+    sprintf (&bfr[length], " >=%d:%lu",
+             latencyLimits[HTTP_LATENCY_BINS - 2], id->latency[HTTP_LATENCY_BINS - 1]);
+    radMsgLog (PRI_STATUS, "%s", bfr);
+
+    length = sprintf (bfr, "HTTP: errors:");
+    for (i = 0; i < HTTP_ERROR_TYPES; i ++)
+    {
+        length += sprintf (&bfr[length], " %s:%lu", errorNames[i], id->errors[i]);
+    }
+    radMsgLog (PRI_STATUS, "%s", bfr);
+}
+
+void httpEngineExit (HTTP_ENGINE_ID id)
+{
+    HTTP_HOST       *host;
+    HTTP_HANDLE     *handle;
+    HTTP_REQUEST    *request;
+    int             i;
+
+    // keep what may be retried, newest after the queued ones:
+    for (host = (HTTP_HOST *)radListRemoveFirst (&id->hosts);
+         host != NULL;
+         host = (HTTP_HOST *)radListRemoveFirst (&id->hosts))
+    {
+        for (i = 0; i < HTTP_HOST_HANDLES; i ++)
+        {
+            handle = &host->handles[i];
+            if (handle->request != NULL)
+            {
+                curl_multi_remove_handle (id->multi, handle->curl);
+                if (handle->request->retry)
+                    QueueRetry (id, handle->request);
+                else
+                    free (handle->request);
+                handle->request = NULL;
+            }
+            curl_easy_cleanup (handle->curl);
+        }
+        free (host);
+    }
+
+    for (request = (HTTP_REQUEST *)radListRemoveFirst (&id->pending);
+         request != NULL;
+         request = (HTTP_REQUEST *)radListRemoveFirst (&id->pending))
+    {
+        if (request->retry)
+            QueueRetry (id, request);
+        else
+            free (request);
+    }
+
+    SaveRetries (id);
+    httpEngineLogStats (id);
+
+    for (i = 0; i < id->numSockets; i ++)
+    {
+        if (id->sockets[i].isRegistered)
+        {
+            radProcessIODeRegisterDescriptorByFd (id->sockets[i].fd);
+        }
+    }
+    id->numSockets = 0;
+
+    curl_multi_cleanup (id->multi);
+    curl_global_cleanup ();
+    radTimerDelete (id->timer);
+
+    for (request = (HTTP_REQUEST *)radListRemoveFirst (&id->retries);
+         request != NULL;
+         request = (HTTP_REQUEST *)radListRemoveFirst (&id->retries))
+    {
+        free (request);
+    }
+    id->numRetries = 0;
+}
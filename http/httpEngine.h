@@ -0,0 +1,168 @@
+#ifndef INC_httpEngineh
+#define INC_httpEngineh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        httpEngine.h
+
+  PURPOSE:
+        Provide the wvhttpd upload engine definitions.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        All uploads share one curl multi handle driven from the radProcess
+        loop: curl sockets waiting for data are registered with
+        radProcessIORegisterDescriptor and the curl timeouts (and sockets
+        still connecting or sending) are serviced by the process timer, so a
+        slow server no longer blocks message processing.
+
+        Each host keeps HTTP_HOST_HANDLES easy handles for the life of the
+        process and the multi handle keeps their connections alive between
+        posts. A request which may not be retried (RapidFire) is dropped if
+        its host is busy. A failed request which may be retried is kept in
+        WVIEW_RUN_DIR/HTTP_RETRY_FILE (at most HTTP_RETRY_QUEUE_MAX posts, up
+        to HTTP_RETRY_MAX_AGE old) and resent after the next successful post
+        to the same host.
+
+        Retry file format (one post per line, oldest first):
+            <time queued> <service> <url>
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radlist.h>
+#include <radtimers.h>
+#include <curl/curl.h>
+
+
+/*  ... API definitions
+*/
+#define HTTP_MAX_URL                    1024
+#define HTTP_MAX_HOST                   128
+#define HTTP_MAX_SERVICE                32
+#define HTTP_HOST_HANDLES               2           // requests in flight per host
+#define HTTP_MAX_SOCKETS                16
+#define HTTP_REQUEST_TIMEOUT            30L         // seconds
+#define HTTP_CONNECT_TIMEOUT            15L         // seconds
+#define HTTP_POLL_MS                    50          // while sockets are connecting
+#define HTTP_RETRY_QUEUE_MAX            288         // a day of 5 minute records
+#define HTTP_RETRY_MAX_AGE              (24*WV_SECONDS_IN_HOUR)
+#define HTTP_RETRY_BURST                4           // resent per successful post
+#define HTTP_STATS_LOG_INTERVAL         WV_SECONDS_IN_HOUR
+
+// latency histogram upper bounds in ms, the last bin is everything slower
+#define HTTP_LATENCY_BINS               8
+#define HTTP_LATENCY_LIMITS             {100, 250, 500, 1000, 2500, 5000, 10000}
+
+typedef enum
+{
+    HTTP_ERROR_RESOLVE              = 0,
+    HTTP_ERROR_CONNECT,
+    HTTP_ERROR_TIMEOUT,
+    HTTP_ERROR_STATUS,
+    HTTP_ERROR_OTHER,
+    HTTP_ERROR_TYPES
+} HTTP_ERROR_TYPE;
+
+typedef struct
+{
+    NODE            node;
+    char            service[HTTP_MAX_SERVICE];
+    char            host[HTTP_MAX_HOST];
+    char            url[HTTP_MAX_URL];
+    time_t          queued;
+    int             retry;                      // may be queued for retry
+    int             attempts;
+    ULONGLONG       startMS;
+} HTTP_REQUEST;
+
+typedef struct
+{
+    CURL            *curl;
+    void            *host;                      // HTTP_HOST owning this handle
+    HTTP_REQUEST    *request;                   // NULL when idle
+    char            curlError[CURL_ERROR_SIZE];
+} HTTP_HANDLE;
+
+typedef struct
+{
+    NODE            node;
+    char            host[HTTP_MAX_HOST];
+    HTTP_HANDLE     handles[HTTP_HOST_HANDLES];
+} HTTP_HOST;
+
+typedef struct
+{
+    int             fd;
+    int             isRegistered;               // with the radProcess loop
+    int             wantOut;
+} HTTP_SOCKET;
+
+typedef struct
+{
+    CURLM           *multi;
+    TIMER_ID        timer;
+    RADLIST         hosts;
+    RADLIST         pending;                    // waiting for a free handle
+    RADLIST         retries;                    // failed, oldest first
+    int             numRetries;
+    int             retriesChanged;
+    char            retryFile[_MAX_PATH];
+    HTTP_SOCKET     sockets[HTTP_MAX_SOCKETS];
+    int             numSockets;
+
+    // statistics:
+    ULONG           sent;
+    ULONG           failed;
+    ULONG           dropped;
+    ULONG           latency[HTTP_LATENCY_BINS];
+    ULONG           errors[HTTP_ERROR_TYPES];
+    ULONGLONG       totalMS;
+    time_t          lastStatsLog;
+} HTTP_ENGINE, *HTTP_ENGINE_ID;
+
+
+/* ... API function prototypes
+*/
+
+// create the multi handle and process timer and load the retry queue;
+// returns OK or ERROR
+extern int httpEngineInit (HTTP_ENGINE_ID id, const char *retryFile);
+
+// queue a GET of 'url' for 'service'; 'retry' is TRUE if the post should be
+// kept for a later retry when it fails; returns OK or ERROR if dropped
+extern int httpEngineSend
+(
+    HTTP_ENGINE_ID  id,
+    const char      *service,
+    const char      *url,
+    int             retry
+);
+
+// log the latency and error histograms
+extern void httpEngineLogStats (HTTP_ENGINE_ID id);
+
+// abandon requests in flight (keeping those that may be retried), save the
+// retry queue and release everything
+extern void httpEngineExit (HTTP_ENGINE_ID id);
+
+#endif
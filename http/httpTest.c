@@ -0,0 +1,683 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        httpTest.c
+
+  PURPOSE:
+        Run the wvhttpd upload engine against a loopback HTTP stand-in
+        ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The stand-in is a forked HTTP/1.1 server on a 127.0.0.1 port with
+        one child per connection, logging each connection and request to a
+        shared file. Its replies depend on the path:
+            /post       200, or 503 while the "down" file exists
+            /dribble    200, written in pieces with pauses in between
+            /cut        200 with 10 of 100 body bytes, then closed
+            /slow       200 after TEST_SLOW_MS
+            /auth       401
+
+        The radProcess event loop is replaced by a poll loop over the
+        descriptors and the timer the engine registers, so the engine runs
+        exactly as it does in wvhttpd:
+            - sequential posts reuse one kept-alive connection
+            - a reply arriving in pieces completes
+            - a truncated reply and a refused connection are errors
+            - a busy host drops real-time posts but holds retryable ones
+            - a 5xx post is saved for retry and resent once the host
+              accepts posts again, a 4xx post is not retried
+            - the retry queue survives an exit and init
+
+        The 30 second request timeout is not waited out; the truncated
+        reply and the refused connection cover the error paths.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radtimeUtils.h>
+
+/*  ... Local include files
+*/
+#include <http.h>
+
+
+/*  ... local memory
+*/
+
+#define TEST_KEEPALIVE_POSTS    5
+#define TEST_SLOW_MS            300
+#define TEST_PIECE_MS           50
+#define TEST_RUN_MS             5000        // longest wait for the engine
+#define TEST_TIMEOUT_SECS       60
+
+typedef struct
+{
+    int             fd;
+    void            (*callback) (int fd, void *userData);
+    void            *userData;
+} TEST_DESCRIPTOR;
+
+static char         testDir[64];
+static char         testLogFile[128];
+static char         testDownFile[128];
+static char         testRetryFile[128];
+static char         testHost[64];
+static pid_t        testPid;
+static int          testFailures;
+
+static HTTP_ENGINE  testEngine;
+
+// the radProcess stand-in state:
+static TEST_DESCRIPTOR  testDescriptors[HTTP_MAX_SOCKETS];
+static int          testNumDescriptors;
+static int          testTimer;
+static ULONGLONG    testTimerExpiry;            // 0 when stopped
+static void         (*testTimerRoutine) (void *parm);
+static void         *testTimerParm;
+
+
+//  ... stand-ins for wvutils and the status file
+
+int wvstrncpy (char *d, const char *s, size_t bufsize)
+{
+    snprintf (d, bufsize, "%s", s);
+    return strlen (s);
+}
+
+void wvutilsLogEvent (int priority, char *format, ...)
+{
+    return;
+}
+
+int statusUpdateStat (int index, int value)
+{
+    return OK;
+}
+
+int statusIncrementStat (int index)
+{
+    return OK;
+}
+
+int statusUpdateMessage (const char *message)
+{
+    return OK;
+}
+
+
+//  ... stand-ins for the radProcess timer and descriptor registration
+
+TIMER_ID radTimerCreate (TIMER_ID timer, void (*routine) (void *parm), void *parm)
+{
+    testTimerRoutine    = routine;
+    testTimerParm       = parm;
+    testTimerExpiry     = 0;
+    return (TIMER_ID)&testTimer;
+}
+
+void radTimerStart (TIMER_ID timer, ULONG time)
+{
+    testTimerExpiry = radTimeGetMSSinceEpoch () + time;
+    return;
+}
+
+void radTimerStop (TIMER_ID timer)
+{
+    testTimerExpiry = 0;
+    return;
+}
+
+void radTimerDelete (TIMER_ID timer)
+{
+    testTimerExpiry = 0;
+    testTimerRoutine = NULL;
+    return;
+}
+
+int radProcessIORegisterDescriptor
+(
+    int             fd,
+    void            (*callback) (int fd, void *userData),
+    void            *userData
+)
+{
+    if (testNumDescriptors >= HTTP_MAX_SOCKETS)
+    {
+        return ERROR;
+    }
+
+    testDescriptors[testNumDescriptors].fd          = fd;
+    testDescriptors[testNumDescriptors].callback    = callback;
+    testDescriptors[testNumDescriptors].userData    = userData;
+    testNumDescriptors ++;
+    return OK;
+}
+
+int radProcessIODeRegisterDescriptorByFd (int fd)
+{
+    int             i;
+
+    for (i = 0; i < testNumDescriptors; i ++)
+    {
+        if (testDescriptors[i].fd == fd)
+        {
+            testDescriptors[i] = testDescriptors[-- testNumDescriptors];
+            return OK;
+        }
+    }
+    return ERROR;
+}
+
+
+//  ... the HTTP stand-in
+
+static void standInLog (const char *format, const char *arg)
+{
+    char            line[512];
+    int             fd, length;
+
+    length = snprintf (line, sizeof (line), format, arg);
+    fd = open (testLogFile, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd >= 0)
+    {
+        if (write (fd, line, length) != length)
+        {
+            exit (1);
+        }
+        close (fd);
+    }
+    return;
+}
+
+static void standInWrite (int fd, const char *data)
+{
+    int             length = strlen (data);
+
+    if (write (fd, data, length) != length)
+    {
+        exit (0);
+    }
+    return;
+}
+
+static void standInReply (int fd, int status, const char *text, const char *body)
+{
+    char            reply[256];
+
+    sprintf (reply, "HTTP/1.1 %d %s\r\nContent-Type: text/plain\r\n"
+             "Content-Length: %d\r\n\r\n%s",
+             status, text, (int)strlen (body), body);
+    standInWrite (fd, reply);
+    return;
+}
+
+static void standInSession (int fd)
+{
+    char            request[2048], path[1024];
+    int             length = 0, count;
+    char            *end;
+
+    standInLog ("CONN\n", "");
+
+    for (;;)
+    {
+        // one request at a time, the engine does not pipeline:
+        request[length] = 0;
+        while ((end = strstr (request, "\r\n\r\n")) == NULL)
+        {
+            count = read (fd, &request[length], sizeof (request) - 1 - length);
+            if (count <= 0)
+            {
+                exit (0);
+            }
+            length += count;
+            request[length] = 0;
+        }
+
+        if (sscanf (request, "GET %1023s", path) != 1)
+        {
+            exit (0);
+        }
+        standInLog ("GET %s\n", path);
+
+        end += 4;
+        length -= (end - request);
+        memmove (request, end, length);
+
+        if (! strncmp (path, "/post", 5))
+        {
+            if (access (testDownFile, F_OK) == 0)
+                standInReply (fd, 503, "Service Unavailable", "try later");
+            else
+                standInReply (fd, 200, "OK", "success");
+        }
+        else if (! strncmp (path, "/dribble", 8))
+        {
+            standInWrite (fd, "HTTP/1.1 200 OK\r\n");
+            usleep (TEST_PIECE_MS * 1000);
+            standInWrite (fd, "Content-Type: text/plain\r\nContent-Length: 7\r\n\r\n");
+            usleep (TEST_PIECE_MS * 1000);
+            standInWrite (fd, "succ");
+            usleep (TEST_PIECE_MS * 1000);
+            standInWrite (fd, "ess");
+        }
+        else if (! strncmp (path, "/cut", 4))
+        {
+            standInWrite (fd, "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n"
+                          "Content-Length: 100\r\n\r\n0123456789");
+            exit (0);
+        }
+        else if (! strncmp (path, "/slow", 5))
+        {
+            usleep (TEST_SLOW_MS * 1000);
+            standInReply (fd, 200, "OK", "success");
+        }
+        else
+        {
+            standInReply (fd, 401, "Unauthorized", "bad password");
+        }
+    }
+}
+
+static int standInListen (int *port)
+{
+    int                 fd;
+    struct sockaddr_in  addr;
+    socklen_t           length = sizeof (addr);
+
+    fd = socket (AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return ERROR;
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_addr.s_addr    = htonl (INADDR_LOOPBACK);
+    addr.sin_port           = 0;
+    if (bind (fd, (struct sockaddr *)&addr, sizeof (addr)) < 0 ||
+        listen (fd, 16) < 0 ||
+        getsockname (fd, (struct sockaddr *)&addr, &length) < 0)
+    {
+        close (fd);
+        return ERROR;
+    }
+
+    *port = ntohs (addr.sin_port);
+    return fd;
+}
+
+static void standInRun (int listenFd)
+{
+    int             fd;
+
+    signal (SIGPIPE, SIG_IGN);
+    signal (SIGCHLD, SIG_IGN);
+    signal (SIGTERM, SIG_DFL);
+
+    for (;;)
+    {
+        if ((fd = accept (listenFd, NULL, NULL)) < 0)
+        {
+            continue;
+        }
+
+        if (fork () == 0)
+        {
+            close (listenFd);
+            standInSession (fd);
+        }
+        close (fd);
+    }
+}
+
+static int standInStart (void)
+{
+    int             fd, port;
+
+    fd = standInListen (&port);
+    if (fd < 0)
+    {
+        return ERROR;
+    }
+    sprintf (testHost, "127.0.0.1:%d", port);
+
+    testPid = fork ();
+    if (testPid < 0)
+    {
+        close (fd);
+        return ERROR;
+    }
+    else if (testPid == 0)
+    {
+        // the sessions share its process group so they stop with it:
+        setpgid (0, 0);
+        standInRun (fd);
+        exit (0);
+    }
+
+    setpgid (testPid, testPid);
+    close (fd);
+    return OK;
+}
+
+static void standInStop (void)
+{
+    if (testPid > 0)
+    {
+        kill (0 - testPid, SIGTERM);
+        kill (testPid, SIGTERM);
+        waitpid (testPid, NULL, 0);
+        testPid = 0;
+    }
+    return;
+}
+
+static int standInCount (const char *what)
+{
+    FILE            *file = fopen (testLogFile, "r");
+    char            line[512];
+    int             count = 0;
+
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    while (fgets (line, sizeof (line), file) != NULL)
+    {
+        if (!strncmp (line, what, strlen (what)))
+        {
+            count ++;
+        }
+    }
+
+    fclose (file);
+    return count;
+}
+
+
+//  ... the engine, driven the way the radProcess loop drives it
+
+static int isIdle (HTTP_ENGINE_ID id)
+{
+    HTTP_HOST       *host;
+    int             i;
+
+    if (radListGetNumberOfNodes (&id->pending) > 0)
+    {
+        return FALSE;
+    }
+
+    for (host = (HTTP_HOST *)radListGetFirst (&id->hosts);
+         host != NULL;
+         host = (HTTP_HOST *)radListGetNext (&id->hosts, (NODE_PTR)host))
+    {
+        for (i = 0; i < HTTP_HOST_HANDLES; i ++)
+        {
+            if (host->handles[i].request != NULL)
+                return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+// run the event loop until the engine has nothing in flight:
+static int runEngine (void)
+{
+    TEST_DESCRIPTOR descriptors[HTTP_MAX_SOCKETS];
+    struct pollfd   fds[HTTP_MAX_SOCKETS];
+    ULONGLONG       now, end = radTimeGetMSSinceEpoch () + TEST_RUN_MS;
+    int             i, j, numFds, timeoutMS;
+
+    while (! isIdle (&testEngine))
+    {
+        now = radTimeGetMSSinceEpoch ();
+        if (now >= end)
+        {
+            return ERROR;
+        }
+
+        timeoutMS = 100;
+        if (testTimerExpiry != 0)
+        {
+            timeoutMS = (testTimerExpiry > now) ? (int)(testTimerExpiry - now) : 0;
+            if (timeoutMS > 100)
+                timeoutMS = 100;
+        }
+
+        // the callbacks may change the registrations:
+        numFds = testNumDescriptors;
+        memcpy (descriptors, testDescriptors, sizeof (descriptors));
+        for (i = 0; i < numFds; i ++)
+        {
+            fds[i].fd       = descriptors[i].fd;
+            fds[i].events   = POLLIN;
+            fds[i].revents  = 0;
+        }
+
+        if (poll (fds, numFds, timeoutMS) > 0)
+        {
+            for (i = 0; i < numFds; i ++)
+            {
+                if (fds[i].revents == 0)
+                    continue;
+
+                for (j = 0; j < testNumDescriptors; j ++)
+                {
+                    if (testDescriptors[j].fd == fds[i].fd)
+                    {
+                        (*testDescriptors[j].callback) (fds[i].fd, testDescriptors[j].userData);
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (testTimerExpiry != 0 && radTimeGetMSSinceEpoch () >= testTimerExpiry)
+        {
+            testTimerExpiry = 0;
+            (*testTimerRoutine) (testTimerParm);
+        }
+    }
+
+    return OK;
+}
+
+static int sendPost (const char *path, int retry)
+{
+    char            url[HTTP_MAX_URL];
+
+    sprintf (url, "http://%s%s", testHost, path);
+    return httpEngineSend (&testEngine, "TEST", url, retry);
+}
+
+static int countLines (const char *file, const char *what)
+{
+    FILE            *fp = fopen (file, "r");
+    char            line[HTTP_MAX_URL + 64];
+    int             count = 0;
+
+    if (fp == NULL)
+    {
+        return 0;
+    }
+
+    while (fgets (line, sizeof (line), fp) != NULL)
+    {
+        if (strstr (line, what) != NULL)
+        {
+            count ++;
+        }
+    }
+
+    fclose (fp);
+    return count;
+}
+
+static void check (int condition, char *what)
+{
+    printf ("httpTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static void checkConnections (void)
+{
+    ULONGLONG       startMS;
+    char            path[64];
+    int             i, isRight = TRUE;
+
+    startMS = radTimeGetMSSinceEpoch ();
+    for (i = 0; i < TEST_KEEPALIVE_POSTS; i ++)
+    {
+        sprintf (path, "/post?n=%d", i);
+        if (sendPost (path, TRUE) == ERROR || runEngine () == ERROR)
+        {
+            isRight = FALSE;
+        }
+    }
+    check (isRight && testEngine.sent == TEST_KEEPALIVE_POSTS &&
+           standInCount ("GET /post") == TEST_KEEPALIVE_POSTS,
+           "sequential posts are delivered");
+    check (standInCount ("CONN") == 1, "and reuse one kept-alive connection");
+    printf ("httpTest: %d posts over one connection in %llu ms\n",
+            TEST_KEEPALIVE_POSTS, radTimeGetMSSinceEpoch () - startMS);
+
+    check (sendPost ("/dribble", FALSE) == OK && runEngine () == OK &&
+           testEngine.sent == TEST_KEEPALIVE_POSTS + 1 && testEngine.failed == 0,
+           "a reply arriving in pieces completes");
+
+    check (sendPost ("/cut", FALSE) == OK && runEngine () == OK &&
+           testEngine.failed == 1 && testEngine.errors[HTTP_ERROR_OTHER] == 1 &&
+           testEngine.numRetries == 0,
+           "a truncated reply is an error");
+
+    // both handles busy:
+    isRight = (sendPost ("/slow?n=1", TRUE) == OK && sendPost ("/slow?n=2", TRUE) == OK);
+    check (isRight && sendPost ("/post?rapid", FALSE) == ERROR && testEngine.dropped == 1,
+           "a busy host drops real-time posts");
+    check (sendPost ("/post?held", TRUE) == OK && runEngine () == OK &&
+           testEngine.sent == TEST_KEEPALIVE_POSTS + 4 &&
+           standInCount ("GET /post?held") == 1,
+           "and holds retryable ones");
+    return;
+}
+
+static void checkRetries (void)
+{
+    char            url[128];
+    int             port, fd;
+
+    fd = open (testDownFile, O_WRONLY | O_CREAT, 0644);
+    close (fd);
+    check (sendPost ("/post?archive=1", TRUE) == OK && runEngine () == OK &&
+           testEngine.errors[HTTP_ERROR_STATUS] == 1 && testEngine.numRetries == 1 &&
+           countLines (testRetryFile, "/post?archive=1") == 1,
+           "a 5xx post is saved for retry");
+
+    unlink (testDownFile);
+    check (sendPost ("/post?archive=2", TRUE) == OK && runEngine () == OK &&
+           standInCount ("GET /post?archive=1") == 2 && testEngine.numRetries == 0 &&
+           access (testRetryFile, F_OK) != 0,
+           "and resent once the host is back");
+
+    check (sendPost ("/auth", TRUE) == OK && runEngine () == OK &&
+           testEngine.errors[HTTP_ERROR_STATUS] == 2 && testEngine.numRetries == 0,
+           "a 4xx post is not retried");
+
+    // a port nobody listens on:
+    fd = standInListen (&port);
+    close (fd);
+    sprintf (url, "http://127.0.0.1:%d/post?refused", port);
+    check (httpEngineSend (&testEngine, "TEST", url, TRUE) == OK && runEngine () == OK &&
+           testEngine.errors[HTTP_ERROR_CONNECT] == 1 && testEngine.numRetries == 1,
+           "a refused connection is saved for retry");
+
+    httpEngineExit (&testEngine);
+    check (httpEngineInit (&testEngine, testRetryFile) == OK &&
+           testEngine.numRetries == 1 &&
+           ! strcmp (((HTTP_REQUEST *)radListGetFirst (&testEngine.retries))->url, url),
+           "the retry queue survives a restart");
+    return;
+}
+
+
+int main (int argc, char *argv[])
+{
+    char            command[128];
+
+    alarm (TEST_TIMEOUT_SECS);
+    signal (SIGPIPE, SIG_IGN);
+
+    snprintf (testDir, sizeof (testDir), "/tmp/httpTest.%d", (int)getpid ());
+    if (mkdir (testDir, 0755) != 0)
+    {
+        printf ("httpTest: cannot create %s\n", testDir);
+        return 1;
+    }
+    sprintf (testLogFile, "%s/server.log", testDir);
+    sprintf (testDownFile, "%s/down", testDir);
+    sprintf (testRetryFile, "%s/http_retry", testDir);
+
+    if (standInStart () == ERROR)
+    {
+        printf ("httpTest: cannot start the stand-in: %s\n", strerror (errno));
+        return 1;
+    }
+
+    if (httpEngineInit (&testEngine, testRetryFile) == ERROR)
+    {
+        printf ("httpTest: httpEngineInit failed\n");
+        standInStop ();
+        return 1;
+    }
+
+    checkConnections ();
+    checkRetries ();
+
+    httpEngineExit (&testEngine);
+    standInStop ();
+
+    sprintf (command, "rm -rf %s", testDir);
+    if (system (command) != 0)
+    {
+        printf ("httpTest: cannot remove %s\n", testDir);
+    }
+
+    printf ("httpTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
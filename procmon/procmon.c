@@ -9,6 +9,7 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         11/20/2007      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Add health sampling
  
   NOTES:
         
@@ -39,9 +40,9 @@ static WVIEW_PMON_WORK procmonWork;
 static char*            pmonStatusLabels[STATUS_STATS_MAX] =
 {
     "Processes restarted",
-    NULL,
-    NULL,
-    NULL
+    "Largest daemon KB",
+    "Slowest poll ms",
+    "Health alerts"
 };
 
 static const char*  configIDs[PMON_PROCESS_MAX] =
@@ -310,6 +311,7 @@ static void msgHandler
             {
                 // Clear his tick counter:
                 procmonWork.process[i].ticks = 0;
+                pmonHealthPollResponse (&procmonWork, i);
 
                 // Tickle the state machine
                 memset (&stim, 0, sizeof(stim));
@@ -340,6 +342,10 @@ static void pollTimerHandler (void *parm)
     WVIEW_MSG_POLL      poll;
     PMON_STIM           stim;
 
+    // Sample health first so the last poll responses are included:
+    pmonHealthReloadLimits (&procmonWork);
+    pmonHealthSample (&procmonWork);
+
     // Set active process bits:
     for (i = 0; i < PMON_PROCESS_MAX; i ++)
     {
@@ -352,6 +358,7 @@ static void pollTimerHandler (void *parm)
 
         mask = PMON_PROCESS_SET(mask,i);
         procmonWork.process[i].ticks = procmonWork.process[i].timeout;
+        procmonWork.process[i].pollSentMS = radTimeGetMSSinceEpoch ();
 
         // Tickle the state machine
         memset (&stim, 0, sizeof(stim));
@@ -724,6 +731,7 @@ int main (int argc, char *argv[])
         }
     }
 
+    pmonHealthInit (&procmonWork);
     wvconfigExit();
 
 
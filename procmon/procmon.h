@@ -11,9 +11,16 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         11/20/2007      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Add health sampling
  
   NOTES:
-        
+        Every poll interval the health of each running daemon (monitored or
+        not) is sampled from /proc: resident memory, CPU use and open files,
+        plus the poll round trip for monitored daemons. The last
+        PMON_HEALTH_SAMPLES samples are kept and their last/avg/max values
+        written to WVIEW_STATUS_DIRECTORY/PMON_HEALTH_FILE_NAME. Samples over
+        the PROCMON_ALERT_* thresholds send the email alerts; changes to the
+        thresholds in the config database are picked up at the next poll.
  
   LICENSE:
         Copyright (c) 2007, Mark S. Teel (mark@teel.ws)
@@ -33,6 +40,7 @@
 #include <string.h>
 #include <signal.h>
 #include <errno.h>
+#include <dirent.h>
 
 //  Library include files
 
@@ -59,6 +67,7 @@
 #include <status.h>
 #include <datadefs.h>
 #include <wvconfig.h>
+#include <emailAlerts.h>
 
 
 
@@ -69,12 +78,42 @@
 #define PMON_WAIT_EXIT_TIME         2               // 2 sec
 #define PMON_WAIT_START_TIME        2               // 2 sec
 #define PMON_MAX_PATH               256
+#define PMON_HEALTH_SAMPLES         60              // 1 hour of polls
 
 typedef enum
 {
-    PMON_STATS_RESTARTS             = 0
+    PMON_STATS_RESTARTS             = 0,
+    PMON_STATS_MAX_RSS_KB,
+    PMON_STATS_MAX_POLL_MS,
+    PMON_STATS_ALERTS
 } PMON_STATS;
 
+// status histograms (upper bounds in ms, the last bin is everything slower):
+#define PMON_HISTOGRAM_POLL_MS      0
+#define PMON_POLL_MS_LIMITS         {10, 50, 100, 250, 1000, 5000, 30000}
+
+typedef enum
+{
+    PMON_HEALTH_RSS_KB              = 0,
+    PMON_HEALTH_CPU_PCT,
+    PMON_HEALTH_FDS,
+    PMON_HEALTH_POLL_MS,
+    PMON_HEALTH_MAX
+} PMON_HEALTH_METRICS;
+
+typedef struct
+{
+    int             sample[PMON_HEALTH_MAX][PMON_HEALTH_SAMPLES];
+    int             isValid[PMON_HEALTH_MAX][PMON_HEALTH_SAMPLES];
+    int             next;
+    pid_t           pid;                        // of the last sample
+    ULONG           lastCpuTicks;
+    ULONGLONG       lastSampleMS;
+    int             pollMS;                     // -1 if no response yet
+    int             alertMask;                  // thresholds currently exceeded
+    int             segmentSamples;             // status histogram count seen
+    int             segmentLast;                // -1 if none
+} PMON_HEALTH;
 
 typedef struct
 {
@@ -84,6 +123,8 @@ typedef struct
     int             timeout;
     int             ticks;
     STATES_ID       stateMachine;
+    ULONGLONG       pollSentMS;
+    PMON_HEALTH     health;
 } PMON_PROCESS;
 
 typedef struct
@@ -94,7 +135,14 @@ typedef struct
     char            statusFile[PMON_MAX_PATH];
     char            daemonQname[PMON_MAX_PATH];
     char            wviewdir[PMON_MAX_PATH];
+    char            healthFile[PMON_MAX_PATH];
     PMON_PROCESS    process[PMON_PROCESS_MAX];
+    int             alertRSS;                   // PROCMON_ALERT_* thresholds
+    int             alertFDs;
+    int             alertPollMS;
+    int             alertHtmlMS;
+    int             alertBacklog;
+    int             alertsSent;
     TIMER_ID        pollTimer;
     TIMER_ID        tickTimer;
     int             inMainLoop;
@@ -130,5 +178,11 @@ extern int WaitExitStateHandler (int state, void* stimulus, void* userData);
 extern int WaitStartStateHandler (int state, void* stimulus, void* userData);
 extern int pmonGetProcessPid (char* pidFilePath);
 
+// procmonHealth.c:
+extern void pmonHealthInit (WVIEW_PMON_WORK* work);
+extern void pmonHealthReloadLimits (WVIEW_PMON_WORK* work);
+extern void pmonHealthPollResponse (WVIEW_PMON_WORK* work, int index);
+extern void pmonHealthSample (WVIEW_PMON_WORK* work);
+
 #endif
 
@@ -0,0 +1,519 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        procmonHealth.c
+
+  PURPOSE:
+        Provide the wview PMON process health sampling.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        Sampled once per poll interval from pollTimerHandler. The pid of each
+        daemon is read from its pid file on every sample so daemons which are
+        not monitored for restarts (PROCMON_<daemon> = 0) are included and
+        restarts are followed.
+
+        Thresholds log once when crossed and once when cleared; the email
+        alert is re-sent while still exceeded (emailAlertSend abates to one
+        per ALERT_NOTIFY_INTERVAL).
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+//  System include files
+#include <sys/types.h>
+#include <unistd.h>
+
+//  Library include files
+#include <radsystem.h>
+
+//  Local include files
+#include <procmon.h>
+
+
+//  local definitions
+#define PMON_ALERT_RSS              0x01
+#define PMON_ALERT_FDS              0x02
+#define PMON_ALERT_POLL             0x04
+#define PMON_ALERT_SEGMENT          0x08
+
+//  static (local) memory declarations
+static const char*  healthProcNames[PMON_PROCESS_MAX] =
+{
+    "wviewd",
+    "htmlgend",
+    "wvalarmd",
+    "wvcwopd",
+    "wvhttpd"
+};
+
+// status segment (WVIEW_STATUS_DIRECTORY/<name>.met) of each daemon:
+static const char*  healthStatusNames[PMON_PROCESS_MAX] =
+{
+    "wview",
+    "html",
+    "alarms",
+    "cwop",
+    "http"
+};
+
+static const char*  healthMetricNames[PMON_HEALTH_MAX] =
+{
+    "rss_kb",
+    "cpu_pct",
+    "fds",
+    "poll_ms"
+};
+
+static int          pollLimits[STATUS_HISTOGRAM_BINS - 1] = PMON_POLL_MS_LIMITS;
+
+
+//  methods
+static pid_t readPid (const char* name)
+{
+    FILE*           pidfile;
+    char            path[PMON_MAX_PATH];
+    int             intValue;
+
+    sprintf (path, "%s/%s.pid", WVIEW_RUN_DIR, name);
+    pidfile = fopen (path, "r");
+    if (pidfile == NULL)
+    {
+        return 0;
+    }
+
+    if (fscanf (pidfile, "%d", &intValue) != 1)
+    {
+        intValue = 0;
+    }
+
+    fclose (pidfile);
+    return (pid_t)intValue;
+}
+
+static int readRSS (pid_t pid)
+{
+    FILE*           file;
+    char            path[PMON_MAX_PATH];
+    ULONG           size, resident;
+
+    sprintf (path, "/proc/%d/statm", (int)pid);
+    file = fopen (path, "r");
+    if (file == NULL)
+    {
+        return ERROR;
+    }
+
+    if (fscanf (file, "%lu %lu", &size, &resident) != 2)
+    {
+        fclose (file);
+        return ERROR;
+    }
+
+    fclose (file);
+    return (int)(resident * (getpagesize() / 1024));
+}
+
+// user + system time in clock ticks:
+static int readCpuTicks (pid_t pid, ULONG* ticks)
+{
+    FILE*           file;
+    char            path[PMON_MAX_PATH], line[512];
+    char*           fields;
+    ULONG           utime, stime;
+
+    sprintf (path, "/proc/%d/stat", (int)pid);
+    file = fopen (path, "r");
+    if (file == NULL)
+    {
+        return ERROR;
+    }
+
+    if (fgets (line, sizeof(line), file) == NULL)
+    {
+        fclose (file);
+        return ERROR;
+    }
+    fclose (file);
+
+    // the command name may contain spaces, start after it:
+    fields = strrchr (line, ')');
+    if (fields == NULL ||
+        sscanf (fields + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu",
+                &utime, &stime) != 2)
+    {
+        return ERROR;
+    }
+
+    *ticks = utime + stime;
+    return OK;
+}
+
+static int countFDs (pid_t pid)
+{
+    DIR*            dir;
+    struct dirent*  entry;
+    char            path[PMON_MAX_PATH];
+    int             count = 0;
+
+    sprintf (path, "/proc/%d/fd", (int)pid);
+    dir = opendir (path);
+    if (dir == NULL)
+    {
+        return ERROR;
+    }
+
+    while ((entry = readdir (dir)) != NULL)
+    {
+        if (entry->d_name[0] != '.')
+        {
+            count ++;
+        }
+    }
+
+    closedir (dir);
+    return count;
+}
+
+static void checkThreshold
+(
+    WVIEW_PMON_WORK*    work,
+    int                 index,
+    int                 alertBit,
+    int                 value,
+    int                 limit,
+    EmailAlertTypes     alertType,
+    const char*         what
+)
+{
+    PMON_HEALTH*        health = &work->process[index].health;
+
+    if (limit > 0 && value > limit)
+    {
+        if (! (health->alertMask & alertBit))
+        {
+            radMsgLog (PRI_HIGH, "PMON: %s %s %d is over the %d limit",
+                       healthProcNames[index], what, value, limit);
+            health->alertMask |= alertBit;
+            work->alertsSent ++;
+            statusUpdateStat(PMON_STATS_ALERTS, work->alertsSent);
+        }
+
+        emailAlertSend (alertType);
+    }
+    else if (health->alertMask & alertBit)
+    {
+        radMsgLog (PRI_STATUS, "PMON: %s %s %d is back under the %d limit",
+                   healthProcNames[index], what, value, limit);
+        health->alertMask &= ~alertBit;
+    }
+}
+
+// Check the last value of a histogram in the daemon's own status segment,
+// if it has changed since the last sample:
+static void checkSegment
+(
+    WVIEW_PMON_WORK*    work,
+    int                 index,
+    int                 histogram,
+    int                 limit,
+    EmailAlertTypes     alertType,
+    const char*         what
+)
+{
+    PMON_HEALTH*        health = &work->process[index].health;
+    STATUS_SEGMENT*     segment;
+    char                path[PMON_MAX_PATH];
+    int                 samples, last;
+
+    sprintf (path, "%s/%s%s",
+             WVIEW_STATUS_DIRECTORY, healthStatusNames[index], STATUS_SEGMENT_EXT);
+    segment = statusSegmentAttach (path);
+    if (segment == NULL)
+    {
+        health->segmentLast = -1;
+        return;
+    }
+
+    if (segment->histogram[histogram].name[0] == 0)
+    {
+        statusSegmentDetach (segment);
+        return;
+    }
+
+    samples = segment->histogram[histogram].samples;
+    last    = segment->histogram[histogram].last;
+    statusSegmentDetach (segment);
+
+    if (samples == health->segmentSamples)
+    {
+        return;
+    }
+
+    health->segmentSamples = samples;
+    health->segmentLast = last;
+    checkThreshold (work, index, PMON_ALERT_SEGMENT, last, limit, alertType, what);
+}
+
+static void sampleProcess (WVIEW_PMON_WORK* work, int index, ULONGLONG nowMS)
+{
+    PMON_HEALTH*        health = &work->process[index].health;
+    pid_t               pid;
+    ULONG               ticks;
+    int                 metric, value[PMON_HEALTH_MAX];
+
+    for (metric = 0; metric < PMON_HEALTH_MAX; metric ++)
+    {
+        value[metric] = ERROR;
+    }
+
+    pid = readPid (healthProcNames[index]);
+    if (pid > 0 && (kill (pid, 0) == 0 || errno != ESRCH))
+    {
+        if (pid != health->pid)
+        {
+            // new or restarted:
+            health->pid = pid;
+            health->lastSampleMS = 0;
+        }
+
+        value[PMON_HEALTH_RSS_KB] = readRSS (pid);
+        value[PMON_HEALTH_FDS]    = countFDs (pid);
+        if (readCpuTicks (pid, &ticks) == OK)
+        {
+            if (health->lastSampleMS != 0 && ticks >= health->lastCpuTicks &&
+                nowMS > health->lastSampleMS)
+            {
+                value[PMON_HEALTH_CPU_PCT] =
+                    (int)(((ULONGLONG)(ticks - health->lastCpuTicks) * 100000) /
+                          ((ULONGLONG)sysconf(_SC_CLK_TCK) * (nowMS - health->lastSampleMS)));
+            }
+
+            health->lastCpuTicks = ticks;
+            health->lastSampleMS = nowMS;
+        }
+
+        value[PMON_HEALTH_POLL_MS] = health->pollMS;
+    }
+    else
+    {
+        health->pid = 0;
+    }
+
+    health->pollMS = ERROR;
+
+    for (metric = 0; metric < PMON_HEALTH_MAX; metric ++)
+    {
+        health->sample[metric][health->next] = value[metric];
+        health->isValid[metric][health->next] = (value[metric] >= 0);
+    }
+    health->next = (health->next + 1) % PMON_HEALTH_SAMPLES;
+
+    if (health->pid == 0)
+    {
+        return;
+    }
+
+    checkThreshold (work, index, PMON_ALERT_RSS, value[PMON_HEALTH_RSS_KB],
+                    work->alertRSS, ALERT_TYPE_PROCESS_RESOURCES, "memory KB");
+    checkThreshold (work, index, PMON_ALERT_FDS, value[PMON_HEALTH_FDS],
+                    work->alertFDs, ALERT_TYPE_PROCESS_RESOURCES, "open files");
+    checkThreshold (work, index, PMON_ALERT_POLL, value[PMON_HEALTH_POLL_MS],
+                    work->alertPollMS, ALERT_TYPE_PROCESS_LATENCY, "poll ms");
+
+    if (index == PMON_PROCESS_HTMLGEND)
+    {
+        checkSegment (work, index, HTML_HISTOGRAM_GENERATE_MS, work->alertHtmlMS,
+                      ALERT_TYPE_HTML_GENERATION, "generation ms");
+    }
+    else if (index == PMON_PROCESS_WVALARMD)
+    {
+        checkSegment (work, index, ALARMS_HISTOGRAM_BACKLOG, work->alertBacklog,
+                      ALERT_TYPE_DATAFEED_BACKLOG, "datafeed backlog bytes");
+    }
+}
+
+// returns the last sample of 'metric' or ERROR:
+static int writeMetric (FILE* file, PMON_HEALTH* health, int metric)
+{
+    int                 i, slot, count = 0, last = ERROR, max = 0;
+    LONGLONG            sum = 0;
+
+    for (i = 0; i < PMON_HEALTH_SAMPLES; i ++)
+    {
+        slot = (health->next + i) % PMON_HEALTH_SAMPLES;
+        if (! health->isValid[metric][slot])
+        {
+            continue;
+        }
+
+        last = health->sample[metric][slot];
+        sum += last;
+        if (last > max)
+        {
+            max = last;
+        }
+        count ++;
+    }
+
+    if (count == 0)
+    {
+        return ERROR;
+    }
+
+    fprintf (file, "%s = %d\n", healthMetricNames[metric], last);
+    fprintf (file, "%s_avg = %d\n", healthMetricNames[metric], (int)(sum / count));
+    fprintf (file, "%s_max = %d\n", healthMetricNames[metric], max);
+    return last;
+}
+
+static void writeHealth (WVIEW_PMON_WORK* work)
+{
+    FILE*               file;
+    PMON_HEALTH*        health;
+    char                temp[PMON_MAX_PATH+8];
+    int                 i, value, maxRSS = 0, maxPoll = 0;
+
+    sprintf (temp, "%s.tmp", work->healthFile);
+    file = fopen (temp, "w");
+    if (file == NULL)
+    {
+        radMsgLog (PRI_HIGH, "PMON: failed to create %s", temp);
+        return;
+    }
+
+    for (i = 0; i < PMON_PROCESS_MAX; i ++)
+    {
+        health = &work->process[i].health;
+        if (health->pid == 0)
+        {
+            continue;
+        }
+
+        fprintf (file, "[%s]\n", healthProcNames[i]);
+        fprintf (file, "pid = %d\n", (int)health->pid);
+
+        value = writeMetric (file, health, PMON_HEALTH_RSS_KB);
+        if (value > maxRSS)
+        {
+            maxRSS = value;
+        }
+        writeMetric (file, health, PMON_HEALTH_CPU_PCT);
+        writeMetric (file, health, PMON_HEALTH_FDS);
+        value = writeMetric (file, health, PMON_HEALTH_POLL_MS);
+        if (value > maxPoll)
+        {
+            maxPoll = value;
+        }
+
+        if (health->segmentLast >= 0)
+        {
+            if (i == PMON_PROCESS_HTMLGEND)
+            {
+                fprintf (file, "generation_ms = %d\n", health->segmentLast);
+            }
+            else if (i == PMON_PROCESS_WVALARMD)
+            {
+                fprintf (file, "datafeed_backlog = %d\n", health->segmentLast);
+            }
+        }
+    }
+
+    fclose (file);
+    if (rename (temp, work->healthFile) != 0)
+    {
+        radMsgLog (PRI_HIGH, "PMON: failed to rename %s", temp);
+        unlink (temp);
+    }
+
+    statusUpdateStat(PMON_STATS_MAX_RSS_KB, maxRSS);
+    statusUpdateStat(PMON_STATS_MAX_POLL_MS, maxPoll);
+}
+
+
+static void readLimits (WVIEW_PMON_WORK* work)
+{
+    work->alertRSS      = wvconfigGetINTValue(configItemPROCMON_ALERT_RSS_KB);
+    work->alertFDs      = wvconfigGetINTValue(configItemPROCMON_ALERT_FDS);
+    work->alertPollMS   = wvconfigGetINTValue(configItemPROCMON_ALERT_POLL_MS);
+    work->alertHtmlMS   = wvconfigGetINTValue(configItemPROCMON_ALERT_HTML_GEN_MS);
+    work->alertBacklog  = wvconfigGetINTValue(configItemPROCMON_ALERT_DATAFEED_BACKLOG);
+    radMsgLog (PRI_STATUS, "PMON: alert limits: memory %d KB, %d files, poll %d ms, "
+               "generation %d ms, datafeed backlog %d bytes (0 disables)",
+               work->alertRSS, work->alertFDs, work->alertPollMS,
+               work->alertHtmlMS, work->alertBacklog);
+}
+
+
+//  API
+void pmonHealthInit (WVIEW_PMON_WORK* work)
+{
+    int             i;
+
+    sprintf (work->healthFile, "%s/%s", WVIEW_STATUS_DIRECTORY, PMON_HEALTH_FILE_NAME);
+    readLimits (work);
+
+    for (i = 0; i < PMON_PROCESS_MAX; i ++)
+    {
+        memset (&work->process[i].health, 0, sizeof(PMON_HEALTH));
+        work->process[i].health.pollMS = ERROR;
+        work->process[i].health.segmentSamples = ERROR;
+        work->process[i].health.segmentLast = ERROR;
+    }
+
+    statusHistogramInit(PMON_HISTOGRAM_POLL_MS, "Poll latency ms", pollLimits);
+}
+
+// Pick up limits changed in the config database without a restart:
+void pmonHealthReloadLimits (WVIEW_PMON_WORK* work)
+{
+    if (wvconfigReload () <= 0)
+    {
+        return;
+    }
+
+    if (wvconfigIsChanged(configItemPROCMON_ALERT_RSS_KB) ||
+        wvconfigIsChanged(configItemPROCMON_ALERT_FDS) ||
+        wvconfigIsChanged(configItemPROCMON_ALERT_POLL_MS) ||
+        wvconfigIsChanged(configItemPROCMON_ALERT_HTML_GEN_MS) ||
+        wvconfigIsChanged(configItemPROCMON_ALERT_DATAFEED_BACKLOG))
+    {
+        readLimits (work);
+    }
+}
+
+void pmonHealthPollResponse (WVIEW_PMON_WORK* work, int index)
+{
+    PMON_PROCESS*   process = &work->process[index];
+
+    if (process->pollSentMS == 0)
+    {
+        return;
+    }
+
+    process->health.pollMS = (int)(radTimeGetMSSinceEpoch() - process->pollSentMS);
+    process->pollSentMS = 0;
+    statusHistogramAdd(PMON_HISTOGRAM_POLL_MS, process->health.pollMS);
+}
+
+void pmonHealthSample (WVIEW_PMON_WORK* work)
+{
+    ULONGLONG       nowMS = radTimeGetMSSinceEpoch();
+    int             i;
+
+    for (i = 0; i < PMON_PROCESS_MAX; i ++)
+    {
+        sampleProcess (work, i, nowMS);
+    }
+
+    writeHealth (work);
+}
+
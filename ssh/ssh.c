@@ -50,8 +50,8 @@ static char*            sshStatusLabels[STATUS_STATS_MAX] =
 {
     "Rules defined",
     "Rules sent",
-    NULL,
-    NULL
+    "Files sent (last cycle)",
+    "Cycle time ms (last cycle)"
 };
 
 /* ... methods
@@ -0,0 +1,570 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        sshTest.c
+
+  PURPOSE:
+        Check the rsync and ssh command lines wviewsshd builds and the
+        grouping of its rules by host ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        sshUtils.c is included here so its static helpers can be called,
+        with WVIEW_RUN_DIR pointed at a scratch directory under /tmp. The
+        rules are added the way sshUtilsInit adds them (it would stop at
+        the rsync lookup on a build host without rsync), then:
+            - rules with the same host, port and user share one host and
+              its ControlMaster socket, which persists past the longest
+              rule interval
+            - SetupStaging finds the common destination root and refuses
+              overlapping, "..", and mixed absolute/relative destinations
+            - sshUtilsSendFiles runs a stand-in rsync that records its
+              arguments and --files-from list: one run per staged host or
+              per rule otherwise, with the expected --rsh, source and
+              destination, and listed paths that resolve through the
+              staging links
+            - unchanged files are not sent again and a failed run is
+              retried the next cycle
+            - sshUtilsExit closes each master with a stand-in ssh
+
+        No sshd is needed; the stand-ins are shell scripts found first in
+        PATH (ssh) or set as the rsync path.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+/*  ... the code under test, with its run directory in the scratch tree
+*/
+static char         testRunDir[256];
+
+#undef WV_RUN_DIR
+#define WV_RUN_DIR  testRunDir
+#include "sshUtils.c"
+
+
+/*  ... local memory
+*/
+
+#define TEST_HOST               "wx.example.com"
+#define TEST_MIRROR             "mirror.example.org"
+#define TEST_MAX_RUNS           8
+#define TEST_MAX_ARGS           12
+#define TEST_MAX_FILES          16
+#define TEST_TIMEOUT_SECS       60
+
+typedef struct
+{
+    char            args[TEST_MAX_ARGS][512];
+    int             numArgs;
+    char            files[TEST_MAX_FILES][256];
+    int             numFiles;
+} TEST_RUN;
+
+static char         testDir[64];
+static char         testRealDir[128];
+static TEST_RUN     testRuns[TEST_MAX_RUNS];
+static int          testNumRuns;
+static int          testFailures;
+
+static SSH_DATA     testData;
+
+
+//  ... stand-ins for what sshUtils.c takes from wviewsshd
+
+void SSHDefaultSigHandler (int signum)
+{
+    return;
+}
+
+int wvconfigInit (int firstProcess)
+{
+    return OK;
+}
+
+void wvconfigExit (void)
+{
+    return;
+}
+
+int wvconfigGetBooleanValue (const char *configItem)
+{
+    return ERROR;
+}
+
+int wvconfigGetINTValue (const char *configItem)
+{
+    return ERROR;
+}
+
+const char *wvconfigGetStringValue (const char *configItem)
+{
+    return NULL;
+}
+
+int wvutilsSetVerbosity (USHORT daemonBitMask)
+{
+    return OK;
+}
+
+int wvstrncpy (char *d, const char *s, size_t bufsize)
+{
+    snprintf (d, bufsize, "%s", s);
+    return strlen (s);
+}
+
+void wvutilsLogEvent (int priority, char *format, ...)
+{
+    return;
+}
+
+int statusUpdateStat (int index, int value)
+{
+    return OK;
+}
+
+
+static void check (int condition, char *what)
+{
+    printf ("sshTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static int writeFile (const char *name, const char *data)
+{
+    char            path[_MAX_PATH];
+    FILE            *file;
+
+    sprintf (path, "%s/%s", testRealDir, name);
+    if ((file = fopen (path, "w")) == NULL)
+    {
+        return ERROR;
+    }
+
+    fputs (data, file);
+    fclose (file);
+    return OK;
+}
+
+// the rsync and ssh stand-ins log one "RUN" line, then their arguments
+// and (rsync) the --files-from list:
+static int writeScripts (void)
+{
+    char            path[_MAX_PATH], script[1024];
+
+    sprintf (path, "%s/bin", testRealDir);
+    mkdir (path, 0755);
+
+    sprintf (script,
+             "#!/bin/sh\n"
+             "echo RUN >> %s/rsync.log\n"
+             "for arg in \"$@\"; do echo \"ARG $arg\" >> %s/rsync.log; done\n"
+             "sed 's/^/FILE /' \"${3#--files-from=}\" >> %s/rsync.log\n"
+             "test -f %s/fail && exit 23\n"
+             "exit 0\n",
+             testRealDir, testRealDir, testRealDir, testRealDir);
+    if (writeFile ("bin/rsync", script) == ERROR)
+    {
+        return ERROR;
+    }
+
+    sprintf (script,
+             "#!/bin/sh\n"
+             "echo RUN >> %s/ssh.log\n"
+             "for arg in \"$@\"; do echo \"ARG $arg\" >> %s/ssh.log; done\n"
+             "exit 0\n",
+             testRealDir, testRealDir);
+    if (writeFile ("bin/ssh", script) == ERROR)
+    {
+        return ERROR;
+    }
+
+    sprintf (path, "%s/bin/rsync", testRealDir);
+    chmod (path, 0755);
+    sprintf (path, "%s/bin/ssh", testRealDir);
+    chmod (path, 0755);
+    return OK;
+}
+
+// read a stand-in log into testRuns, then empty it:
+static void readLog (const char *name)
+{
+    char            path[_MAX_PATH], line[512];
+    FILE            *file;
+    TEST_RUN        *run = NULL;
+
+    memset (testRuns, 0, sizeof (testRuns));
+    testNumRuns = 0;
+
+    sprintf (path, "%s/%s", testRealDir, name);
+    if ((file = fopen (path, "r")) == NULL)
+    {
+        return;
+    }
+
+    while (fgets (line, sizeof (line), file) != NULL)
+    {
+        line[strcspn (line, "\n")] = 0;
+        if (! strcmp (line, "RUN"))
+        {
+            run = (testNumRuns < TEST_MAX_RUNS) ? &testRuns[testNumRuns ++] : NULL;
+        }
+        else if (run != NULL && ! strncmp (line, "ARG ", 4) && run->numArgs < TEST_MAX_ARGS)
+        {
+            wvstrncpy (run->args[run->numArgs ++], &line[4], 512);
+        }
+        else if (run != NULL && ! strncmp (line, "FILE ", 5) && run->numFiles < TEST_MAX_FILES)
+        {
+            wvstrncpy (run->files[run->numFiles ++], &line[5], 256);
+        }
+    }
+
+    fclose (file);
+    unlink (path);
+    return;
+}
+
+static int hasFile (TEST_RUN *run, const char *name)
+{
+    int             i;
+
+    for (i = 0; i < run->numFiles; i ++)
+    {
+        if (! strcmp (run->files[i], name))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+// is 'run' the rsync of 'srcRoot' to 'dest' with the given --rsh?
+static int isRsync (TEST_RUN *run, const char *rsh, const char *srcRoot, const char *dest)
+{
+    char            filesFrom[_MAX_PATH];
+
+    sprintf (filesFrom, "--files-from=%s/%s", testRunDir, SSH_FILES_FROM_FILE);
+    return (run->numArgs == 6 &&
+            ! strcmp (run->args[0], "-azL") &&
+            ! strcmp (run->args[1], "--timeout=120") &&
+            ! strcmp (run->args[2], filesFrom) &&
+            ! strcmp (run->args[3], rsh) &&
+            ! strcmp (run->args[4], srcRoot) &&
+            ! strcmp (run->args[5], dest));
+}
+
+// add a rule the way sshUtilsInit does:
+static SSH_RULE_ID addRule
+(
+    SSH_ID          id,
+    int             number,
+    const char      *host,
+    int             port,
+    const char      *user,
+    const char      *src,
+    const char      *dest,
+    int             interval
+)
+{
+    SSH_RULE_ID     rule;
+    char            temp[_MAX_PATH];
+
+    rule = (SSH_RULE_ID) malloc (sizeof (*rule));
+    memset (rule, 0, sizeof (*rule));
+    wvstrncpy (rule->host, host, sizeof (rule->host));
+    rule->sshPort = port;
+    wvstrncpy (rule->sshUser, user, sizeof (rule->sshUser));
+    sprintf (rule->src, "%s/%s", testRealDir, src);
+    wvstrncpy (rule->dest, dest, sizeof (rule->dest));
+    rule->interval = interval;
+    rule->number = number;
+
+    sprintf (temp, "%s@%s:%d:%s", rule->sshUser, rule->host, rule->sshPort, rule->dest);
+    manifestInit (&rule->sent, temp);
+    sprintf (rule->manifestFile, "%s/%s_%d", WVIEW_RUN_DIR, SSH_MANIFEST_FILE, number);
+    manifestLoad (&rule->sent, rule->manifestFile);
+    manifestInit (&rule->pending, NULL);
+
+    rule->sshHost = GetHost (id, rule);
+    if (rule->interval * 60 + SSH_PERSIST_MARGIN > rule->sshHost->persistSecs)
+    {
+        rule->sshHost->persistSecs = rule->interval * 60 + SSH_PERSIST_MARGIN;
+    }
+
+    radListAddToEnd (&id->rules, (NODE_PTR)rule);
+    return rule;
+}
+
+static void initData (SSH_ID id)
+{
+    memset (id, 0, sizeof (*id));
+    radListReset (&id->rules);
+    radListReset (&id->hosts);
+    sprintf (id->rsyncPath, "%s/bin/rsync", testRealDir);
+    id->isPersistent = TRUE;
+    manifestInit (&id->published, NULL);
+    return;
+}
+
+static void exitData (SSH_ID id)
+{
+    id->isPersistent = FALSE;
+    sshUtilsExit (id);
+    return;
+}
+
+// stage two destinations on one host; returns host->isStaged:
+static int stageCase (const char *dest1, const char *dest2, char *root, char *rel2)
+{
+    SSH_DATA        data;
+    SSH_RULE_ID     rule2;
+    int             isStaged;
+
+    initData (&data);
+    addRule (&data, 1, TEST_HOST, 22, "", "web/a", dest1, 1);
+    rule2 = addRule (&data, 2, TEST_HOST, 22, "", "web/b", dest2, 1);
+    SetupStaging (&data, rule2->sshHost);
+
+    isStaged = rule2->sshHost->isStaged;
+    strcpy (root, rule2->sshHost->destRoot);
+    strcpy (rel2, rule2->destRel);
+    exitData (&data);
+    return isStaged;
+}
+
+static void checkStaging (void)
+{
+    char            root[_MAX_PATH], rel[_MAX_PATH];
+
+    check (stageCase ("/var/www/wx/now", "/var/www/wx/charts/day", root, rel) &&
+           ! strcmp (root, "/var/www/wx") && ! strcmp (rel, "charts/day"),
+           "absolute destinations share their common root");
+    check (stageCase ("site/now", "./site/day", root, rel) &&
+           ! strcmp (root, "site") && ! strcmp (rel, "day"),
+           "relative destinations share their common root");
+    check (stageCase ("now", "day", root, rel) && ! strcmp (root, "."),
+           "top level relative destinations stage at \".\"");
+    check (! stageCase ("site", "site/img", root, rel), "overlapping destinations are not staged");
+    check (! stageCase ("/var/www/now", "var/www/day", root, rel),
+           "mixed absolute and relative are not staged");
+    check (! stageCase ("/var/www/now", "/var/www/../day", root, rel), "\"..\" is not staged");
+    return;
+}
+
+static void runCycle (const char *log)
+{
+    SSH_RULE_ID     rule;
+
+    // make every rule due:
+    for (rule = (SSH_RULE_ID)radListGetFirst (&testData.rules);
+         rule != NULL;
+         rule = (SSH_RULE_ID)radListGetNext (&testData.rules, (NODE_PTR)rule))
+    {
+        rule->currentCount = 0;
+    }
+
+    sshUtilsSendFiles (&testData, testRealDir);
+    readLog (log);
+    return;
+}
+
+static void checkTransfers (void)
+{
+    SSH_RULE_ID     rules[6];
+    SSH_HOST_ID     host;
+    char            rsh[1024], src[_MAX_PATH], path[_MAX_PATH];
+    int             i, isRight;
+
+    initData (&testData);
+    rules[1] = addRule (&testData, 1, TEST_HOST, 2222, "wx", "web/a", "/var/www/wx/now", 1);
+    rules[2] = addRule (&testData, 2, TEST_HOST, 2222, "wx", "web/b", "/var/www/wx/charts/day", 5);
+    rules[3] = addRule (&testData, 3, TEST_HOST, 2222, "other", "web/c", "/var/www/wx", 1);
+    rules[4] = addRule (&testData, 4, TEST_MIRROR, 22, "", "web/d", "site", 1);
+    rules[5] = addRule (&testData, 5, TEST_MIRROR, 22, "", "web/e", "site/img", 1);
+
+    check (radListGetNumberOfNodes (&testData.hosts) == 3 &&
+           rules[1]->sshHost == rules[2]->sshHost &&
+           rules[3]->sshHost != rules[1]->sshHost &&
+           rules[4]->sshHost == rules[5]->sshHost &&
+           rules[4]->sshHost != rules[1]->sshHost &&
+           rules[4]->sshHost != rules[3]->sshHost,
+           "rules are grouped by host, port and user");
+
+    sprintf (path, "%s/%s_3", testRunDir, SSH_CONTROL_FILE);
+    check (rules[1]->sshHost->persistSecs == 5 * 60 + SSH_PERSIST_MARGIN &&
+           rules[3]->sshHost->persistSecs == 60 + SSH_PERSIST_MARGIN &&
+           ! strcmp (rules[4]->sshHost->controlPath, path),
+           "each host has its own persisting master");
+
+    for (host = (SSH_HOST_ID)radListGetFirst (&testData.hosts);
+         host != NULL;
+         host = (SSH_HOST_ID)radListGetNext (&testData.hosts, (NODE_PTR)host))
+    {
+        SetupStaging (&testData, host);
+    }
+    check (rules[1]->sshHost->isStaged && ! rules[3]->sshHost->isStaged &&
+           ! rules[4]->sshHost->isStaged,
+           "only the non-overlapping host is staged");
+
+    // the first cycle sends everything:
+    runCycle ("rsync.log");
+    check (testNumRuns == 4, "one rsync per staged host or other rule");
+
+    sprintf (rsh, "--rsh=ssh -p 2222 -l wx -o ControlMaster=auto -o ControlPath=%s "
+             "-o ControlPersist=%d", rules[1]->sshHost->controlPath,
+             rules[1]->sshHost->persistSecs);
+    sprintf (src, "%s/", rules[1]->sshHost->stageDir);
+    check (isRsync (&testRuns[0], rsh, src, TEST_HOST ":/var/www/wx") &&
+           testRuns[0].numFiles == 3 &&
+           hasFile (&testRuns[0], "now/index.htm") &&
+           hasFile (&testRuns[0], "now/wind.png") &&
+           hasFile (&testRuns[0], "charts/day/day.png"),
+           "staged rsync command line and file list");
+
+    isRight = TRUE;
+    for (i = 0; i < testRuns[0].numFiles; i ++)
+    {
+        sprintf (path, "%s%s", src, testRuns[0].files[i]);
+        if (access (path, R_OK) != 0)
+            isRight = FALSE;
+    }
+    check (isRight, "staged files resolve through the links");
+
+    sprintf (rsh, "--rsh=ssh -p 2222 -l other -o ControlMaster=auto -o ControlPath=%s "
+             "-o ControlPersist=%d", rules[3]->sshHost->controlPath,
+             rules[3]->sshHost->persistSecs);
+    sprintf (src, "%s/", rules[3]->srcPath);
+    check (isRsync (&testRuns[1], rsh, src, TEST_HOST ":/var/www/wx") &&
+           testRuns[1].numFiles == 1 && hasFile (&testRuns[1], "c.htm"),
+           "single rule rsync command line");
+
+    sprintf (rsh, "--rsh=ssh -p 22 -o ControlMaster=auto -o ControlPath=%s "
+             "-o ControlPersist=%d", rules[4]->sshHost->controlPath,
+             rules[4]->sshHost->persistSecs);
+    sprintf (src, "%s/", rules[5]->srcPath);
+    check (isRsync (&testRuns[3], rsh, src, TEST_MIRROR ":site/img") &&
+           hasFile (&testRuns[3], "e.png"),
+           "no login without a user name");
+
+    runCycle ("rsync.log");
+    sprintf (path, "%s/%s_1", testRunDir, SSH_MANIFEST_FILE);
+    check (testNumRuns == 0 && access (path, R_OK) == 0, "unchanged files are not sent again");
+
+    writeFile ("web/b/day.png", "day chart, next hour");
+    runCycle ("rsync.log");
+    sprintf (src, "%s/", rules[1]->sshHost->stageDir);
+    check (testNumRuns == 1 && testRuns[0].numFiles == 1 &&
+           ! strcmp (testRuns[0].args[4], src) &&
+           hasFile (&testRuns[0], "charts/day/day.png"),
+           "a changed file is sent through the staged root");
+
+    // a failed run leaves the files to be sent again:
+    writeFile ("fail", "");
+    writeFile ("web/c/c.htm", "current conditions, later");
+    runCycle ("rsync.log");
+    sprintf (path, "%s/fail", testRealDir);
+    unlink (path);
+    isRight = (testNumRuns == 1);
+    runCycle ("rsync.log");
+    check (isRight && testNumRuns == 1 && hasFile (&testRuns[0], "c.htm"),
+           "a failed transfer is retried next cycle");
+    runCycle ("rsync.log");
+    check (testNumRuns == 0, "and not after it succeeds");
+
+    testData.isPersistent = FALSE;
+    writeFile ("web/d/d.htm", "mirror page, later");
+    runCycle ("rsync.log");
+    check (testNumRuns == 1 && ! strcmp (testRuns[0].args[3], "--rsh=ssh -p 22"),
+           "no master options without persistence");
+
+    // each master is closed at exit:
+    testData.isPersistent = TRUE;
+    sprintf (path, "%s", rules[1]->sshHost->stageDir);
+    sshUtilsExit (&testData);
+    readLog ("ssh.log");
+    sprintf (rsh, "ControlPath=%s/%s_2", testRunDir, SSH_CONTROL_FILE);
+    check (testNumRuns == 3 && testRuns[1].numArgs == 5 &&
+           ! strcmp (testRuns[1].args[0], "-o") &&
+           ! strcmp (testRuns[1].args[1], rsh) &&
+           ! strcmp (testRuns[1].args[2], "-O") &&
+           ! strcmp (testRuns[1].args[3], "exit") &&
+           ! strcmp (testRuns[1].args[4], TEST_HOST) &&
+           access (path, F_OK) != 0,
+           "masters are closed and staging removed at exit");
+    return;
+}
+
+
+int main (int argc, char *argv[])
+{
+    static char     *files[][2] =
+    {
+        { "web/a/index.htm",    "current conditions" },
+        { "web/a/wind.png",     "wind chart" },
+        { "web/b/day.png",      "day chart" },
+        { "web/c/c.htm",        "current conditions" },
+        { "web/d/d.htm",        "mirror page" },
+        { "web/e/e.png",        "mirror chart" }
+    };
+    char            path[PATH_MAX + 64], command[128];
+    int             i;
+
+    alarm (TEST_TIMEOUT_SECS);
+    snprintf (testDir, sizeof (testDir), "/tmp/sshTest.%d", (int)getpid ());
+    if (mkdir (testDir, 0755) != 0 || realpath (testDir, path) == NULL ||
+        strlen (path) >= sizeof (testRealDir))
+    {
+        printf ("sshTest: cannot create %s\n", testDir);
+        return 1;
+    }
+    wvstrncpy (testRealDir, path, sizeof (testRealDir));
+
+    sprintf (testRunDir, "%s/run", testRealDir);
+    mkdir (testRunDir, 0755);
+    sprintf (path, "%s/web", testRealDir);
+    mkdir (path, 0755);
+    for (i = 0; i < (int)(sizeof (files) / sizeof (files[0])); i ++)
+    {
+        sprintf (path, "%s/%s", testRealDir, files[i][0]);
+        *strrchr (path, '/') = 0;
+        mkdir (path, 0755);
+        writeFile (files[i][0], files[i][1]);
+    }
+
+    sprintf (path, "%s/bin:%s", testRealDir, getenv ("PATH") ? getenv ("PATH") : "/bin");
+    if (writeScripts () == ERROR || setenv ("PATH", path, 1) != 0)
+    {
+        printf ("sshTest: cannot create the stand-in scripts\n");
+        return 1;
+    }
+
+    checkStaging ();
+    checkTransfers ();
+
+    sprintf (command, "rm -rf %s", testDir);
+    if (system (command) != 0)
+    {
+        printf ("sshTest: cannot remove %s\n", testDir);
+    }
+
+    printf ("sshTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
@@ -26,6 +26,10 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
+#include <sys/stat.h>
+#include <limits.h>
+#include <errno.h>
+#include <ftw.h>
 
 /*  ... Library include files
 */
@@ -54,10 +58,562 @@ static char     *rsyncPaths[] =
     NULL
 };
 
+typedef struct
+{
+    SSH_ID          id;
+    SSH_RULE_ID     rule;
+    FILE            *filesFrom;                 // rsync --files-from list
+    const char      *prefix;                    // staged path of the rule
+    int             listed;
+} SSH_WALK_CONTEXT;
+
+
+// Add 'path' to the rsync file list if its content differs from what the
+// destination already has:
+static void CheckFile
+(
+    const char      *path,
+    const char      *relPath,
+    struct stat     *fileStat,
+    void            *context
+)
+{
+    SSH_WALK_CONTEXT    *walk = (SSH_WALK_CONTEXT *)context;
+    MANIFEST_ENTRY      *sent;
+    ULONGLONG           hash;
+
+    sent = manifestFind (&walk->rule->sent, path);
+    if (sent != NULL &&
+        sent->size == fileStat->st_size &&
+        sent->mtime == fileStat->st_mtime)
+    {
+        // not touched since we sent it:
+        return;
+    }
+
+    if (manifestGetHash (&walk->id->published, path, fileStat, &hash) == OK)
+    {
+        if (sent != NULL && sent->hash == hash)
+        {
+            // rewritten with the same content; remember the new mtime:
+            manifestSet (&walk->rule->sent, path, fileStat->st_size, fileStat->st_mtime, hash);
+            return;
+        }
+
+        manifestSet (&walk->rule->pending, path, fileStat->st_size, fileStat->st_mtime, hash);
+    }
+
+    // if it cannot be hashed send it anyway, it just is not recorded:
+    if (walk->prefix != NULL)
+        fprintf (walk->filesFrom, "%s/%s\n", walk->prefix, relPath);
+    else
+        fprintf (walk->filesFrom, "%s\n", relPath);
+    walk->listed ++;
+}
+
+// Append the changed files of 'rule' to the rsync --files-from list;
+// returns the number of files listed or ERROR
+static int BuildFileList
+(
+    SSH_ID          id,
+    SSH_RULE_ID     rule,
+    FILE            *filesFrom,
+    const char      *prefix
+)
+{
+    SSH_WALK_CONTEXT    walk;
+
+    memset (&walk, 0, sizeof (walk));
+    walk.id         = id;
+    walk.rule       = rule;
+    walk.filesFrom  = filesFrom;
+    walk.prefix     = prefix;
+
+    manifestClear (&rule->pending);
+    if (manifestWalk (rule->srcPath, CheckFile, &walk) == ERROR)
+    {
+        return ERROR;
+    }
+
+    return walk.listed;
+}
+
+// Record what the destination has after a successful transfer:
+static void RecordSent (SSH_RULE_ID rule)
+{
+    MANIFEST_ENTRY  *entry;
+    int             i;
+
+    for (i = 0; i < rule->pending.count; i ++)
+    {
+        entry = &rule->pending.entries[i];
+        manifestSet (&rule->sent, entry->path, entry->size, entry->mtime, entry->hash);
+    }
+    manifestClear (&rule->pending);
+
+    manifestSave (&rule->sent, rule->manifestFile);
+}
+
+static int BuildRsh (SSH_ID id, SSH_HOST_ID host, char *rsh)
+{
+    int             length = 0;
+
+    length += sprintf (&rsh[length], "--rsh=\'ssh -p %d", host->sshPort);
+    if (strlen(host->sshUser) > 0)
+    {
+        length += sprintf (&rsh[length], " -l %s", host->sshUser);
+    }
+    if (id->isPersistent)
+    {
+        // the first rsync starts the master, later ones share it:
+        length += sprintf (&rsh[length],
+                           " -o ControlMaster=auto -o ControlPath=%s -o ControlPersist=%d",
+                           host->controlPath, host->persistSecs);
+    }
+    length += sprintf (&rsh[length], "\' ");
+
+    return length;
+}
+
+// Run one rsync; returns OK if rsync exited with status 0, else ERROR:
+static int RunRsync
+(
+    SSH_ID          id,
+    SSH_HOST_ID     host,
+    const char      *srcRoot,
+    const char      *listFile,
+    const char      *dest
+)
+{
+    char            rsync[_MAX_PATH];
+    char            cmndLine[2048];
+    int             index, cmndLength, done, status;
+    FILE*           fp;
+
+    // Build the command:
+    cmndLength = 0;
+    cmndLength += sprintf(&cmndLine[cmndLength], "%s ", id->rsyncPath);
+    cmndLength += sprintf(&cmndLine[cmndLength], "-azL --timeout=120 ");
+    cmndLength += sprintf(&cmndLine[cmndLength], "--files-from=%s ", listFile);
+    cmndLength += BuildRsh(id, host, &cmndLine[cmndLength]);
+    cmndLength += sprintf(&cmndLine[cmndLength], "%s/ ", srcRoot);
+    cmndLength += sprintf(&cmndLine[cmndLength], "%s:%s", host->host, dest);
+
+    // Log the monster before executing it:
+    for (index = 0; index < cmndLength; index += RADMSGLOG_MAX_LENGTH)
+    {
+        strncpy(rsync, &cmndLine[index], RADMSGLOG_MAX_LENGTH);
+        if (strlen(rsync) > 0)
+        {
+            wvutilsLogEvent(PRI_STATUS, "SSH-COMMAND: %s", rsync);
+        }
+    }
+
+    // Release the SIGCHLD signal so popen can do its thing:
+    radProcessSignalRelease(SIGCHLD);
+
+    // Use popen so we can retrieve the rsync command output:
+    fp = popen(cmndLine, "r");
+    if (fp == NULL)
+    {
+        radMsgLog (PRI_HIGH, "SSH: popen failed: %s", strerror(errno));
+        radProcessSignalCatch (SIGCHLD, SSHDefaultSigHandler);
+        return ERROR;
+    }
+
+    done = FALSE;
+    while (! done)
+    {
+        if (fgets(rsync, _MAX_PATH, fp) == NULL)
+        {
+            if (ferror(fp) && errno != EINTR)
+            {
+                radMsgLog (PRI_HIGH, "SSH: IO error for popen stream: %s",
+                           strerror(errno));
+            }
+
+            done = TRUE;
+        }
+        else
+        {
+            // Log if verbosity is ON:
+            wvutilsLogEvent(PRI_STATUS, "SSH-OUTPUT: %s", rsync);
+        }
+    }
+
+    status = pclose(fp);
+
+    // Restore the SIGCHLD signal:
+    radProcessSignalCatch (SIGCHLD, SSHDefaultSigHandler);
+
+    if (status == -1)
+    {
+        radMsgLog (PRI_HIGH, "SSH: pclose failed: %s", strerror(errno));
+        return ERROR;
+    }
+
+    if (! WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        radMsgLog (PRI_HIGH, "SSH: rsync to %s:%s failed (status %d)",
+                   host->host, dest, (WIFEXITED(status) ? WEXITSTATUS(status) : -1));
+        return ERROR;
+    }
+
+    return OK;
+}
+
+static SSH_HOST_ID GetHost (SSH_ID id, SSH_RULE_ID rule)
+{
+    SSH_HOST_ID     host;
+
+    for (host = (SSH_HOST_ID)radListGetFirst (&id->hosts);
+         host != NULL;
+         host = (SSH_HOST_ID)radListGetNext (&id->hosts, (NODE_PTR)host))
+    {
+        if (! strcmp (host->host, rule->host) &&
+            host->sshPort == rule->sshPort &&
+            ! strcmp (host->sshUser, rule->sshUser))
+        {
+            return host;
+        }
+    }
+
+    host = (SSH_HOST_ID) malloc (sizeof (*host));
+    if (host == NULL)
+    {
+        return NULL;
+    }
+    memset (host, 0, sizeof (*host));
+
+    wvstrncpy (host->host, rule->host, sizeof(host->host));
+    host->sshPort = rule->sshPort;
+    wvstrncpy (host->sshUser, rule->sshUser, sizeof(host->sshUser));
+    host->number = radListGetNumberOfNodes (&id->hosts) + 1;
+    sprintf (host->controlPath, "%s/%s_%d", WVIEW_RUN_DIR, SSH_CONTROL_FILE, host->number);
+    sprintf (host->stageDir, "%s/%s_%d", WVIEW_RUN_DIR, SSH_STAGE_DIR, host->number);
+
+    radListAddToEnd (&id->hosts, (NODE_PTR)host);
+    return host;
+}
+
+static int RemoveEntry
+(
+    const char          *path,
+    const struct stat   *fileStat,
+    int                 type,
+    struct FTW          *ftw
+)
+{
+    remove (path);
+    return 0;
+}
+
+static void RemoveTree (const char *path)
+{
+    struct stat     fileStat;
+
+    if (lstat (path, &fileStat) == 0)
+    {
+        nftw (path, RemoveEntry, 8, FTW_DEPTH | FTW_PHYS);
+    }
+}
+
+static int MakeDirs (const char *path)
+{
+    char            temp[_MAX_PATH];
+    char            *cp;
+
+    wvstrncpy (temp, path, sizeof(temp));
+    for (cp = temp + 1; *cp; cp ++)
+    {
+        if (*cp == '/')
+        {
+            *cp = 0;
+            if (mkdir (temp, 0755) == -1 && errno != EEXIST)
+                return ERROR;
+            *cp = '/';
+        }
+    }
+
+    if (mkdir (temp, 0755) == -1 && errno != EEXIST)
+        return ERROR;
+
+    return OK;
+}
+
+// Split 'path' (no trailing '/') into its components; returns the count:
+static int SplitPath (char *path, char **parts, int maxParts)
+{
+    int             count = 0;
+    char            *token, *save;
+
+    for (token = strtok_r (path, "/", &save);
+         token != NULL && count < maxParts;
+         token = strtok_r (NULL, "/", &save))
+    {
+        if (strcmp (token, ".") != 0)
+            parts[count ++] = token;
+    }
+
+    return count;
+}
+
+// Work out if the host's rules can be sent in one rsync run: every
+// destination must be a distinct subdirectory of a common root. Build
+// the staging directory if so.
+static void SetupStaging (SSH_ID id, SSH_HOST_ID host)
+{
+    SSH_RULE_ID     rule, rules[SSH_MAX_RULES];
+    char            dests[SSH_MAX_RULES][_MAX_PATH];
+    char            *parts[SSH_MAX_RULES][64];
+    int             numParts[SSH_MAX_RULES];
+    int             i, j, k, numRules = 0, common, isAbsolute = -1;
+    size_t          len;
+    char            temp[_MAX_PATH];
+
+    host->isStaged = FALSE;
+    RemoveTree (host->stageDir);
+
+    for (rule = (SSH_RULE_ID)radListGetFirst (&id->rules);
+         rule != NULL && numRules < SSH_MAX_RULES;
+         rule = (SSH_RULE_ID)radListGetNext (&id->rules, (NODE_PTR)rule))
+    {
+        if (rule->sshHost != host)
+            continue;
+
+        if (isAbsolute == -1)
+            isAbsolute = (rule->dest[0] == '/');
+        else if (isAbsolute != (rule->dest[0] == '/'))
+            return;
+
+        wvstrncpy (dests[numRules], rule->dest, _MAX_PATH);
+        numParts[numRules] = SplitPath (dests[numRules], parts[numRules], 64);
+        for (j = 0; j < numParts[numRules]; j ++)
+        {
+            if (! strcmp (parts[numRules][j], ".."))
+                return;
+        }
+        rules[numRules ++] = rule;
+    }
+
+    if (numRules < 2)
+    {
+        return;
+    }
+
+    // the deepest common directory:
+    for (common = 0; ; common ++)
+    {
+        for (i = 0; i < numRules; i ++)
+        {
+            if (common >= numParts[i] - 1 ||
+                strcmp (parts[i][common], parts[0][common]) != 0)
+                break;
+        }
+        if (i < numRules)
+            break;
+    }
+
+    // each rule needs its own subdirectory:
+    for (i = 0; i < numRules; i ++)
+    {
+        for (j = 0; j < numRules; j ++)
+        {
+            if (i == j || numParts[i] > numParts[j])
+                continue;
+
+            for (k = common; k < numParts[i]; k ++)
+            {
+                if (strcmp (parts[i][k], parts[j][k]) != 0)
+                    break;
+            }
+            if (k == numParts[i])
+            {
+                radMsgLog (PRI_STATUS, "SSH: %s: destinations %s and %s overlap, "
+                           "sending them separately",
+                           host->host, rules[i]->dest, rules[j]->dest);
+                return;
+            }
+        }
+    }
+
+    host->destRoot[0] = 0;
+    len = 0;
+    for (j = 0; j < common; j ++)
+    {
+        len += snprintf (&host->destRoot[len], sizeof(host->destRoot) - len, "%s%s",
+                         ((j > 0 || isAbsolute) ? "/" : ""), parts[0][j]);
+    }
+    if (len == 0)
+    {
+        wvstrncpy (host->destRoot, (isAbsolute ? "/" : "."), sizeof(host->destRoot));
+    }
+
+    for (i = 0; i < numRules; i ++)
+    {
+        rules[i]->destRel[0] = 0;
+        len = 0;
+        for (j = common; j < numParts[i]; j ++)
+        {
+            len += snprintf (&rules[i]->destRel[len], sizeof(rules[i]->destRel) - len,
+                             "%s%s", ((j > common) ? "/" : ""), parts[i][j]);
+        }
+
+        // the parent directories of the rule's link:
+        snprintf (temp, sizeof(temp), "%s/%s", host->stageDir, rules[i]->destRel);
+        *strrchr (temp, '/') = 0;
+        if (MakeDirs (temp) == ERROR)
+        {
+            radMsgLog (PRI_HIGH, "SSH: cannot create %s: %s", temp, strerror(errno));
+            RemoveTree (host->stageDir);
+            return;
+        }
+    }
+
+    host->isStaged = TRUE;
+    radMsgLog (PRI_STATUS, "SSH: %s: sending %d rules together to %s",
+               host->host, numRules, host->destRoot);
+}
+
+// Point the rule's staging link at its source directory:
+static int UpdateStageLink (SSH_HOST_ID host, SSH_RULE_ID rule)
+{
+    char            link[_MAX_PATH], target[PATH_MAX];
+    ssize_t         length;
+
+    snprintf (link, sizeof(link), "%s/%s", host->stageDir, rule->destRel);
+    length = readlink (link, target, sizeof(target) - 1);
+    if (length >= 0)
+    {
+        target[length] = 0;
+        if (! strcmp (target, rule->srcPath))
+            return OK;
+
+        unlink (link);
+    }
+
+    if (symlink (rule->srcPath, link) == -1)
+    {
+        radMsgLog (PRI_HIGH, "SSH: cannot link %s: %s", link, strerror(errno));
+        return ERROR;
+    }
+
+    return OK;
+}
+
+// Send the changed files of 'rules' in one rsync run; returns the number
+// of rules sent:
+static int SendRules
+(
+    SSH_ID          id,
+    SSH_HOST_ID     host,
+    SSH_RULE_ID     *rules,
+    int             numRules
+)
+{
+    SSH_RULE_ID     rule;
+    FILE            *filesFrom;
+    char            listFile[_MAX_PATH];
+    int             i, retVal, numSent = 0, totalFiles = 0;
+    int             isStaged = (numRules > 1);
+    ULONGLONG       startMS, transferMS = 0;
+
+    sprintf (listFile, "%s/%s", WVIEW_RUN_DIR, SSH_FILES_FROM_FILE);
+    filesFrom = fopen (listFile, "w");
+    if (filesFrom == NULL)
+    {
+        radMsgLog (PRI_HIGH, "SSH: cannot create %s: %s", listFile, strerror(errno));
+        return 0;
+    }
+
+    // Only send the files whose content changed since the last transfer:
+    for (i = 0; i < numRules; i ++)
+    {
+        rule = rules[i];
+        startMS = radTimeGetMSSinceEpoch();
+        rule->filesLast = ERROR;
+
+        if (realpath(rule->src, rule->srcPath) == NULL)
+        {
+            radMsgLog (PRI_HIGH, "SSH: %s: %s", rule->src, strerror(errno));
+            continue;
+        }
+
+        if (isStaged && UpdateStageLink(host, rule) == ERROR)
+        {
+            continue;
+        }
+
+        rule->filesLast = BuildFileList(id, rule, filesFrom,
+                                        (isStaged ? rule->destRel : NULL));
+        rule->scanMS = radTimeGetMSSinceEpoch() - startMS;
+        if (rule->filesLast > 0)
+        {
+            totalFiles += rule->filesLast;
+        }
+    }
+
+    if (fclose (filesFrom) != 0)
+    {
+        radMsgLog (PRI_HIGH, "SSH: cannot write %s: %s", listFile, strerror(errno));
+        return 0;
+    }
+
+    retVal = OK;
+    if (totalFiles > 0)
+    {
+        startMS = radTimeGetMSSinceEpoch();
+        retVal = RunRsync(id, host,
+                          (isStaged ? host->stageDir : rules[0]->srcPath),
+                          listFile,
+                          (isStaged ? host->destRoot : rules[0]->dest));
+        transferMS = radTimeGetMSSinceEpoch() - startMS;
+    }
+
+    for (i = 0; i < numRules; i ++)
+    {
+        rule = rules[i];
+        if (rule->filesLast == ERROR)
+        {
+            continue;
+        }
+
+        rule->transferMS = transferMS;
+        if (retVal == ERROR)
+        {
+            // leave the sent manifest alone so they are retried:
+            manifestClear (&rule->pending);
+            continue;
+        }
+
+        RecordSent (rule);
+
+        rule->cycles ++;
+        rule->totalMS += rule->scanMS + rule->transferMS;
+        if (rule->scanMS + rule->transferMS > rule->maxMS)
+        {
+            rule->maxMS = rule->scanMS + rule->transferMS;
+        }
+
+        wvutilsLogEvent (PRI_STATUS,
+                         "SSH-RULE %d: %s ==> %s:%s: %d files, scan %llu ms, "
+                         "transfer %llu ms (%d rules), avg %llu ms, max %llu ms",
+                         rule->number, rule->src, rule->host, rule->dest,
+                         rule->filesLast, rule->scanMS, rule->transferMS, numRules,
+                         rule->totalMS / rule->cycles, rule->maxMS);
+
+        id->filesLast += rule->filesLast;
+        numSent ++;
+    }
+
+    return numSent;
+}
+
 
 int sshUtilsInit (SSH_DATA* data)
 {
     SSH_RULE_ID     rule;
+    SSH_HOST_ID     host;
     SSH_ID          newId;
     int             i, iValue;
     const char*     sValue;
@@ -88,6 +644,7 @@ int sshUtilsInit (SSH_DATA* data)
 
     memset (newId, 0, sizeof (*newId));
     radListReset (&newId->rules);
+    radListReset (&newId->hosts);
     wvstrncpy (newId->rsyncPath, temp, sizeof(newId->rsyncPath));
 
     if (wvconfigInit(FALSE) == ERROR)
@@ -112,6 +669,12 @@ int sshUtilsInit (SSH_DATA* data)
         radMsgLog (PRI_CATASTROPHIC, "wvutilsSetVerbosity failed!");
         return ERROR_ABORT;
     }
+
+    // Keep one ssh connection per host open between updates?
+    iValue = wvconfigGetBooleanValue(configItemSSH_PERSISTENT_CONNECTION);
+    newId->isPersistent = ((iValue == ERROR) ? TRUE : iValue);
+    radMsgLog (PRI_STATUS, "SSH: %susing persistent connections",
+               (newId->isPersistent ? "" : "not "));
     
 
     for (i = 1; i <= SSH_MAX_RULES; i ++)
@@ -202,122 +765,127 @@ int sshUtilsInit (SSH_DATA* data)
         // Cause a transfer at the first opportunity:
         rule->currentCount = 0;
 
+        // Load the hashes of the files this destination already has:
+        sprintf (temp, "%s@%s:%d:%s", rule->sshUser, rule->host, rule->sshPort, rule->dest);
+        manifestInit (&rule->sent, temp);
+        sprintf (rule->manifestFile, "%s/%s_%d", WVIEW_RUN_DIR, SSH_MANIFEST_FILE, i);
+        manifestLoad (&rule->sent, rule->manifestFile);
+
         radMsgLog (PRI_STATUS, "SSH: RULE %d: updating %s ==> %s:%s every %d minutes",
                    i, rule->src, rule->host, rule->dest, rule->interval);
 
+        manifestInit (&rule->pending, NULL);
+        rule->number = i;
+        rule->sshHost = GetHost (newId, rule);
+        if (rule->sshHost == NULL)
+        {
+            radMsgLog (PRI_HIGH, "SSH: cannot allocate host for rule %d", i);
+            manifestExit (&rule->sent);
+            free (rule);
+            continue;
+        }
+
+        // the master must outlive the longest wait between this host's rules:
+        if (rule->interval * 60 + SSH_PERSIST_MARGIN > rule->sshHost->persistSecs)
+        {
+            rule->sshHost->persistSecs = rule->interval * 60 + SSH_PERSIST_MARGIN;
+        }
+
         radListAddToEnd (&newId->rules, (NODE_PTR)rule);
     }
 
+    if (newId->isPersistent)
+    {
+        for (host = (SSH_HOST_ID)radListGetFirst (&newId->hosts);
+             host != NULL;
+             host = (SSH_HOST_ID)radListGetNext (&newId->hosts, (NODE_PTR)host))
+        {
+            SetupStaging (newId, host);
+        }
+    }
+
+    manifestInit (&newId->published, NULL);
+
     wvconfigExit();
     return OK;
 }
 
 int sshUtilsSendFiles (SSH_ID id, char *workdir)
 {
-    SSH_RULE_ID     rule;
-    int             done, numRules = 0;
-    int             retVal, isUpdated = FALSE;
-    char            rsync[_MAX_PATH];
-    char            cmndLine[2048];
-    int             index, cmndLength;
-    FILE*           fp;
-
-    // loop through all of our rules here
+    SSH_RULE_ID     rule, rules[SSH_MAX_RULES];
+    SSH_HOST_ID     host;
+    int             numRules = 0, numDue;
+    char            temp[_MAX_PATH];
+    ULONGLONG       startMS = radTimeGetMSSinceEpoch();
+
+    // our time to run?
+    numDue = 0;
     for (rule = (SSH_RULE_ID)radListGetFirst (&id->rules);
          rule != NULL;
          rule = (SSH_RULE_ID)radListGetNext (&id->rules, (NODE_PTR)rule))
     {
-        // our time to run?
         if (rule->currentCount > 0)
         {
             rule->currentCount --;
+            rule->isDue = FALSE;
             continue;
         }
-        
-        // Build the command:
-        cmndLength = 0;
-        cmndLength += sprintf(&cmndLine[cmndLength], "%s ", id->rsyncPath);
-        cmndLength += sprintf(&cmndLine[cmndLength], "-azL --timeout=120 ");
-        if (strlen(rule->sshUser) > 0)
-        {
-            cmndLength += sprintf(&cmndLine[cmndLength], "--rsh=\'ssh -p %d -l %s\' ",
-                                  rule->sshPort, rule->sshUser);
-        }
-        else
-        {
-            cmndLength += sprintf(&cmndLine[cmndLength], "--rsh=\'ssh -p %d\' ",
-                                  rule->sshPort);
-        }
-        cmndLength += sprintf(&cmndLine[cmndLength], "%s/ ", rule->src);
-        cmndLength += sprintf(&cmndLine[cmndLength], "%s:%s", rule->host, rule->dest);
 
-        // Log the monster before executing it:
-        for (index = 0; index < cmndLength; index += RADMSGLOG_MAX_LENGTH)
-        {
-            strncpy(rsync, &cmndLine[index], RADMSGLOG_MAX_LENGTH);
-            if (strlen(rsync) > 0)
-            {
-                wvutilsLogEvent(PRI_STATUS, "SSH-COMMAND: %s", rsync);
-            }
-        }
+        rule->currentCount = rule->interval - 1;
+        rule->isDue = TRUE;
+        numDue ++;
+    }
 
-        if (chdir(workdir) == -1)
-        {
-            radMsgLog (PRI_HIGH, "SSH: chdir failed: %s", strerror(errno));
-            return ERROR;
-        }
-    
-        // Release the SIGCHLD signal so popen can do its thing:
-        radProcessSignalRelease(SIGCHLD);
+    if (numDue == 0)
+    {
+        return OK;
+    }
 
-        // Use popen so we can retrieve the rsync command output:
-        fp = popen(cmndLine, "r");
-        if (fp == NULL)
-        {
-            radMsgLog (PRI_HIGH, "SSH: popen failed: %s", strerror(errno));
-            radProcessSignalCatch (SIGCHLD, SSHDefaultSigHandler);
-            return ERROR;
-        }
+    if (chdir(workdir) == -1)
+    {
+        radMsgLog (PRI_HIGH, "SSH: chdir failed: %s", strerror(errno));
+        return ERROR;
+    }
+
+    // Pick up htmlgend's latest content hashes:
+    sprintf (temp, "%s/%s", WVIEW_RUN_DIR, HTML_MANIFEST_FILE);
+    manifestLoad (&id->published, temp);
 
-        done = FALSE;
-        while (! done)
+    id->filesLast = 0;
+    for (host = (SSH_HOST_ID)radListGetFirst (&id->hosts);
+         host != NULL;
+         host = (SSH_HOST_ID)radListGetNext (&id->hosts, (NODE_PTR)host))
+    {
+        numDue = 0;
+        for (rule = (SSH_RULE_ID)radListGetFirst (&id->rules);
+             rule != NULL;
+             rule = (SSH_RULE_ID)radListGetNext (&id->rules, (NODE_PTR)rule))
         {
-            if (fgets(rsync, _MAX_PATH, fp) == NULL)
+            if (rule->sshHost != host || ! rule->isDue)
             {
-                if (ferror(fp) && errno != EINTR)
-                {
-                    radMsgLog (PRI_HIGH, "SSH: IO error for popen stream: %s",
-                               strerror(errno));
-                }
+                continue;
+            }
 
-                done = TRUE;
+            if (host->isStaged)
+            {
+                rules[numDue ++] = rule;
             }
             else
             {
-                // Log if verbosity is ON:
-                wvutilsLogEvent(PRI_STATUS, "SSH-OUTPUT: %s", rsync);
+                numRules += SendRules (id, host, &rule, 1);
             }
         }
 
-        if (pclose(fp) == -1)
+        if (numDue > 0)
         {
-            radMsgLog (PRI_HIGH, "SSH: pclose failed: %s", strerror(errno));
-            radProcessSignalCatch (SIGCHLD, SSHDefaultSigHandler);
-            return ERROR;
+            numRules += SendRules (id, host, rules, numDue);
         }
-
-        // Restore the SIGCHLD signal:
-        radProcessSignalCatch (SIGCHLD, SSHDefaultSigHandler);
-
-        rule->currentCount = rule->interval - 1;
-        wvutilsLogEvent (PRI_STATUS, "SSH-RULE: %s ==> %s:%s", 
-                         rule->src, rule->host, rule->dest);
-
-        numRules ++;
     }
-    
+
     id->rulesSent += numRules;
     statusUpdateStat(SSH_STATS_RULES_SENT, id->rulesSent);
+    statusUpdateStat(SSH_STATS_FILES_LAST_CYCLE, id->filesLast);
+    statusUpdateStat(SSH_STATS_MS_LAST_CYCLE, (int)(radTimeGetMSSinceEpoch() - startMS));
     return OK;
 }
 
@@ -325,12 +893,36 @@ int sshUtilsSendFiles (SSH_ID id, char *workdir)
 void sshUtilsExit (SSH_ID id)
 {
     SSH_RULE_ID rule;
+    SSH_HOST_ID host;
+    char        cmndLine[_MAX_PATH * 2];
 
     for (rule = (SSH_RULE_ID)radListRemoveFirst (&id->rules);
          rule != NULL;
          rule = (SSH_RULE_ID)radListRemoveFirst (&id->rules))
     {
+        manifestExit (&rule->sent);
+        manifestExit (&rule->pending);
         free (rule);
     }
+
+    for (host = (SSH_HOST_ID)radListRemoveFirst (&id->hosts);
+         host != NULL;
+         host = (SSH_HOST_ID)radListRemoveFirst (&id->hosts))
+    {
+        if (id->isPersistent)
+        {
+            // close the master connection:
+            sprintf (cmndLine, "ssh -o ControlPath=%s -O exit %s > /dev/null 2>&1",
+                     host->controlPath, host->host);
+            radProcessSignalRelease(SIGCHLD);
+            system (cmndLine);
+            radProcessSignalCatch (SIGCHLD, SSHDefaultSigHandler);
+        }
+
+        RemoveTree (host->stageDir);
+        free (host);
+    }
+
+    manifestExit (&id->published);
 }
 
@@ -13,7 +13,12 @@
         05/28/2005      M.S. Teel       0               Original
  
   NOTES:
-        
+        With SSH_PERSISTENT_CONNECTION enabled the rules are grouped by
+        host/port/user. Each host gets one ssh ControlMaster connection that
+        persists between update cycles and all of its due rules are sent in
+        one rsync run: a staging directory holds a symlink per rule at the
+        rule's destination path relative to the deepest directory common to
+        all of the host's destinations, and rsync -L follows them.
  
   LICENSE:
         Copyright (c) 2004, Mark S. Teel (mark@teel.ws)
@@ -32,6 +37,7 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <string.h>
+#include <limits.h>
 
 /*  ... Library include files
 */
@@ -48,6 +54,7 @@
 #include <datadefs.h>
 #include <wvconfig.h>
 #include <status.h>
+#include <manifest.h>
 
 
 
@@ -55,6 +62,7 @@
 */
 #define SSH_MAX_RULES           5
 #define SSH_PORT_DEFAULT        22
+#define SSH_PERSIST_MARGIN      120             // secs beyond the longest interval
 
 
 /*  !!!!!!!!!!!!!!!!!!  HIDDEN, NOT FOR API USE  !!!!!!!!!!!!!!!!!!
@@ -62,10 +70,28 @@
 typedef enum
 {
     SSH_STATS_RULES_DEFINED     = 0,
-    SSH_STATS_RULES_SENT
+    SSH_STATS_RULES_SENT,
+    SSH_STATS_FILES_LAST_CYCLE,
+    SSH_STATS_MS_LAST_CYCLE
 } SSH_STATS;
 
 
+// one remote login shared by all rules with the same host, port and user:
+typedef struct
+{
+    NODE        node;
+    char        host[128];
+    int         sshPort;
+    char        sshUser[64];
+    int         number;
+    char        controlPath[_MAX_PATH];         // ControlMaster socket
+    int         persistSecs;
+    int         isStaged;                       // rules sent in one batch
+    char        stageDir[_MAX_PATH];
+    char        destRoot[_MAX_PATH];            // common destination dir
+} *SSH_HOST_ID;
+
+
 typedef struct
 {
     NODE        node;
@@ -76,6 +102,22 @@ typedef struct
     char        dest[_MAX_PATH];
     int         interval;
     int         currentCount;
+    int         number;
+    SSH_HOST_ID sshHost;
+    int         isDue;
+    char        destRel[_MAX_PATH];             // below sshHost->destRoot
+    char        srcPath[PATH_MAX];              // real path of src
+    MANIFEST    sent;                           // what the destination has
+    MANIFEST    pending;                        // changed files being sent
+    char        manifestFile[_MAX_PATH];
+
+    // timing stats:
+    int         filesLast;
+    ULONGLONG   scanMS;                         // last cycle
+    ULONGLONG   transferMS;                     // last cycle (whole batch)
+    ULONGLONG   totalMS;
+    ULONGLONG   maxMS;
+    int         cycles;
 } *SSH_RULE_ID;
 
 
@@ -83,7 +125,11 @@ typedef struct
 {
     char        rsyncPath[_MAX_PATH];
     RADLIST     rules;
+    RADLIST     hosts;
+    int         isPersistent;
     int         rulesSent;
+    int         filesLast;
+    MANIFEST    published;                      // htmlgend's content hashes
 }SSH_DATA, *SSH_ID;
 
 
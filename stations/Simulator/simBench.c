@@ -0,0 +1,668 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        simBench.c
+
+  PURPOSE:
+        Provide the station simulator benchmark (load generation) mode.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Match datafeed LOOPs by
+                                                        fingerprint, not a tag
+
+  NOTES:
+        LOOP packets are generated from the interface timer in bursts sized
+        to hold the configured rate and are processed synchronously through
+        daemonStationLoopComplete then pushed to clients, so every packet
+        exercises the full wviewd -> wvalarmd -> datafeed path.
+
+        The simulated clock advances 'compression' seconds per real second
+        (but never past the real clock) and the simulator indicates an
+        archive record each time it crosses an archive interval boundary.
+
+        Latencies reported:
+          loop    - wviewd LOOP processing (sensors + HILOW sample store)
+          feed    - LOOP creation to receipt on a local datafeed connection
+                    (packets are matched in order by a hash of their values
+                    as converted for the datafeed; ones never seen are
+                    skipped)
+          archive - archive record indication (DB commit + HILOW update)
+          html    - archive indication to the next update of the configured
+                    HTML file (1 second resolution)
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+
+/*  ... Library include files
+*/
+#include <radprocess.h>
+
+/*  ... Local include files
+*/
+#include <services.h>
+#include <computedData.h>
+#include <simBench.h>
+
+/*  ... global memory declarations
+*/
+
+/*  ... local memory
+*/
+#define PI                  3.1415926535897932384626433832795
+#define RAD                 (PI/180.0)
+
+static SIM_BENCH_WORK       benchWork;
+static void                 (*ArchiveIndicator) (ARCHIVE_PKT* newRecord);
+
+
+/*  ... methods
+*/
+
+static ULONGLONG GetUsecs (void)
+{
+    struct timeval      tv;
+
+    gettimeofday (&tv, NULL);
+    return (((ULONGLONG)tv.tv_sec * 1000000ULL) + (ULONGLONG)tv.tv_usec);
+}
+
+static void LatencyAdd (SIM_BENCH_LATENCY *lat, ULONGLONG usecs)
+{
+    lat->count ++;
+    lat->sum += usecs;
+    if (usecs > lat->max)
+    {
+        lat->max = usecs;
+    }
+    return;
+}
+
+static float LatencyAvgMS (SIM_BENCH_LATENCY *lat)
+{
+    if (lat->count == 0)
+    {
+        return 0;
+    }
+
+    return (float)((double)lat->sum / (double)lat->count / 1000.0);
+}
+
+static float LatencyMaxMS (SIM_BENCH_LATENCY *lat)
+{
+    return (float)((double)lat->max / 1000.0);
+}
+
+// uniform random value in [-1.0, 1.0]:
+static float Noise (void)
+{
+    return ((float)rand_r(&benchWork.seed) / (float)RAND_MAX) * 2.0 - 1.0;
+}
+
+static void StoreLoopPkt
+(
+    WVIEWD_WORK     *work,
+    LOOP_PKT        *dest,
+    time_t          simTime,
+    double          sampleSecs
+)
+{
+    struct tm       bknTime;
+    float           hour, season, daily, tempfloat;
+    double          declination, hourAngle, elevation, storm;
+
+    // Clear optional data:
+    stationClearLoopData(work);
+
+    localtime_r (&simTime, &bknTime);
+    hour = (float)bknTime.tm_hour + ((float)bknTime.tm_min / 60.0);
+
+    // +1 in mid-July, -1 in mid-January (flipped south of the equator):
+    season = cos(2 * PI * (bknTime.tm_yday - 196) / 365.0);
+    if (benchWork.latitude < 0)
+    {
+        season = -season;
+    }
+
+    // +1 at 3 PM, -1 at 3 AM:
+    daily = cos(2 * PI * (hour - 15) / 24.0);
+
+    // slow weather random walks:
+    benchWork.tempWalk += Noise() * 0.002 * sampleSecs;
+    if (fabsf(benchWork.tempWalk) > 8)
+    {
+        benchWork.tempWalk *= 0.99;
+    }
+    benchWork.pressureWalk += Noise() * 0.00005 * sampleSecs;
+    if (fabsf(benchWork.pressureWalk) > 0.4)
+    {
+        benchWork.pressureWalk *= 0.99;
+    }
+
+    // TEMP: seasonal mean 35 to 75, daily swing 14 to 20
+    tempfloat = 55 + (20 * season);
+    tempfloat += (17 + (3 * season)) * daily / 2;
+    tempfloat += benchWork.tempWalk;
+    dest->outTemp = tempfloat;
+    dest->inTemp = 70 + daily;
+
+    // HUMIDITY runs opposite the daily temperature curve:
+    tempfloat = 65 - (20 * daily) + (Noise() * 2);
+    if (tempfloat > 100)
+        tempfloat = 100;
+    if (tempfloat < 5)
+        tempfloat = 5;
+    dest->outHumidity = (USHORT)tempfloat;
+    dest->inHumidity = 40;
+
+    // BP: synoptic walk plus the semidiurnal tide (peaks 10 AM/PM)
+    tempfloat = 30.00 + benchWork.pressureWalk;
+    tempfloat += 0.02 * cos(2 * PI * (hour - 10) / 12.0);
+    dest->barometer = tempfloat;
+
+    // Apply calibration here so the computed values reflect it:
+    dest->barometer *= work->calMBarometer;
+    dest->barometer += work->calCBarometer;
+
+    // calculate station pressure by giving a negative elevation
+    dest->stationPressure = wvutilsConvertSPToSLP(dest->barometer,
+                                                  dest->outTemp,
+                                                  (float)(-benchWork.elevation));
+
+    // calculate altimeter
+    dest->altimeter = wvutilsConvertSPToAltimeter(dest->stationPressure,
+                                                  (float)benchWork.elevation);
+
+    // SOLAR: sun elevation from declination and hour angle
+    declination = 23.44 * sin(2 * PI * (284 + bknTime.tm_yday) / 365.0) * RAD;
+    hourAngle = 15.0 * (hour - 12) * RAD;
+    elevation = asin(sin(benchWork.latitude * RAD) * sin(declination) +
+                     cos(benchWork.latitude * RAD) * cos(declination) * cos(hourAngle));
+    if (elevation > 0)
+    {
+        tempfloat = 1000 * sin(elevation) * (0.85 + (Noise() * 0.15));
+        dest->radiation = (USHORT)tempfloat;
+        dest->UV = tempfloat / 90;
+    }
+    else
+    {
+        dest->radiation = 0;
+        dest->UV = 0;
+    }
+
+    // WIND: calm nights, afternoon peak
+    tempfloat = 3 + (8 * ((daily + 1) / 2)) + (Noise() * 2);
+    if (tempfloat < 0)
+        tempfloat = 0;
+    dest->windSpeed = (USHORT)tempfloat;
+    dest->windGust = (USHORT)(tempfloat * 1.4 + fabsf(Noise()) * 4);
+
+    tempfloat = 180 + 90 * sin(2 * PI * simTime / (3.0 * WV_SECONDS_IN_DAY));
+    tempfloat += Noise() * 20;
+    dest->windDir = ((USHORT)(tempfloat + 360)) % 360;
+    dest->windGustDir = dest->windDir;
+
+    // RAIN: a storm roughly every 4.3 days
+    storm = sin(2 * PI * simTime / (4.3 * WV_SECONDS_IN_DAY));
+    if (storm > 0.9)
+    {
+        dest->rainRate = (float)((storm - 0.9) * 10);
+        dest->sampleRain = dest->rainRate * (float)(sampleSecs / WV_SECONDS_IN_HOUR);
+    }
+    else
+    {
+        dest->rainRate = 0;
+        dest->sampleRain = 0;
+    }
+
+    return;
+}
+
+static ULONG HashBytes (ULONG hash, void *data, int length)
+{
+    UCHAR           *ptr = (UCHAR *)data;
+    int             i;
+
+    for (i = 0; i < length; i ++)
+    {
+        hash ^= ptr[i];
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+    }
+
+    return hash;
+}
+
+// FNV-1a over the fields the simulator varies on every sample:
+static ULONG Fingerprint (LOOP_PKT *loop)
+{
+    ULONG           hash = 2166136261UL;
+
+    hash = HashBytes (hash, &loop->outTemp, sizeof(loop->outTemp));
+    hash = HashBytes (hash, &loop->barometer, sizeof(loop->barometer));
+    hash = HashBytes (hash, &loop->dewpoint, sizeof(loop->dewpoint));
+    hash = HashBytes (hash, &loop->rainRate, sizeof(loop->rainRate));
+    hash = HashBytes (hash, &loop->outHumidity, sizeof(loop->outHumidity));
+    hash = HashBytes (hash, &loop->windSpeed, sizeof(loop->windSpeed));
+    hash = HashBytes (hash, &loop->windGust, sizeof(loop->windGust));
+    hash = HashBytes (hash, &loop->windDir, sizeof(loop->windDir));
+    hash = HashBytes (hash, &loop->radiation, sizeof(loop->radiation));
+    return hash;
+}
+
+// remember a LOOP pushed to the datafeed; the oldest entry is dropped when
+// the ring is full:
+static void SentAdd (LOOP_PKT *loop, ULONGLONG created)
+{
+    LOOP_PKT        netLoop, hostLoop;
+    int             index;
+
+    // fingerprint it as the datafeed client will see it (fixed point floats):
+    memset (&netLoop, 0, sizeof(netLoop));
+    memset (&hostLoop, 0, sizeof(hostLoop));
+    datafeedConvertLOOP_HTON (&netLoop, loop);
+    datafeedConvertLOOP_NTOH (&hostLoop, &netLoop);
+
+    if (benchWork.sentCount == SIM_BENCH_SENT_RING)
+    {
+        benchWork.sentHead = (benchWork.sentHead + 1) % SIM_BENCH_SENT_RING;
+        benchWork.sentCount --;
+    }
+
+    index = (benchWork.sentHead + benchWork.sentCount) % SIM_BENCH_SENT_RING;
+    benchWork.sent[index].time = created;
+    benchWork.sent[index].fingerprint = Fingerprint (&hostLoop);
+    benchWork.sentCount ++;
+    return;
+}
+
+// find a received LOOP in the sent ring; older entries it passes over were
+// lost on the way and are discarded. Returns the creation time or 0:
+static ULONGLONG SentMatch (LOOP_PKT *loop)
+{
+    ULONG           fingerprint = Fingerprint (loop);
+    ULONGLONG       created;
+    int             i, index;
+
+    for (i = 0; i < benchWork.sentCount; i ++)
+    {
+        index = (benchWork.sentHead + i) % SIM_BENCH_SENT_RING;
+        if (benchWork.sent[index].fingerprint == fingerprint)
+        {
+            created = benchWork.sent[index].time;
+            benchWork.sentHead = (index + 1) % SIM_BENCH_SENT_RING;
+            benchWork.sentCount -= (i + 1);
+            return created;
+        }
+    }
+
+    return 0;
+}
+
+static void GenerateArchive (WVIEWD_WORK *work, time_t dateTime)
+{
+    ARCHIVE_PKT     *newRec;
+    ULONGLONG       startTime;
+
+    newRec = computedDataGenerateArchive (work);
+    if (newRec == NULL)
+    {
+        return;
+    }
+
+    // use the simulated time:
+    newRec->dateTime = dateTime;
+
+    startTime = GetUsecs();
+    (*ArchiveIndicator) (newRec);
+    LatencyAdd (&benchWork.archiveLatency, GetUsecs() - startTime);
+
+    benchWork.archiveCount ++;
+    benchWork.lastArchiveCreated = startTime;
+    return;
+}
+
+static void feedDataCallback (int fd, void *userData)
+{
+    LOOP_PKT        loopData, hostLoopData;
+    DF_LOOP_EXT     loopExt;
+    ARCHIVE_PKT     archiveRecord;
+    RADSOCK_ID      sockId;
+    int             retVal;
+    ULONGLONG       created;
+
+    sockId = (*benchWork.feed.getsocket)(&benchWork.feed);
+    retVal = datafeedSyncStartOfFrame (sockId);
+    switch (retVal)
+    {
+        case ERROR:
+        case ERROR_ABORT:
+            radMsgLog (PRI_MEDIUM, "SIMBENCH: datafeed connection lost");
+            radProcessIODeRegisterDescriptorByFd (benchWork.feed.fd);
+            (*(benchWork.feed.exit)) (&benchWork.feed);
+            benchWork.feedConnected = FALSE;
+            benchWork.sentCount = 0;
+            return;
+
+        case DF_LOOP_PKT_TYPE:
+            if ((*benchWork.feed.read)(&benchWork.feed, (void *)&loopData,
+                                       DF_LOOP_PKT_LENGTH, SIM_BENCH_FEED_TIMEOUT)
+                != DF_LOOP_PKT_LENGTH)
+            {
+                return;
+            }
+
+            datafeedConvertLOOP_NTOH (&hostLoopData, &loopData);
+            created = SentMatch (&hostLoopData);
+            if (created != 0)
+            {
+                LatencyAdd (&benchWork.feedLatency, GetUsecs() - created);
+            }
+            else
+            {
+                benchWork.feedUnmatched ++;
+            }
+            return;
+
+        case DF_LOOP_EXT_PKT_TYPE:
+            // not part of the fingerprint, just consume it:
+            (*benchWork.feed.read)(&benchWork.feed, (void *)&loopExt,
+                                   sizeof (loopExt), SIM_BENCH_FEED_TIMEOUT);
+            return;
+
+        case DF_ARCHIVE_PKT_TYPE:
+            // not interested, just consume it:
+            (*benchWork.feed.read)(&benchWork.feed, (void *)&archiveRecord,
+                                   sizeof (archiveRecord), SIM_BENCH_FEED_TIMEOUT);
+            return;
+    }
+
+    return;
+}
+
+static void FeedConnect (void)
+{
+    if (benchWork.feedConnected)
+    {
+        return;
+    }
+
+    if (ethernetMediumInit (&benchWork.feed, "localhost", WV_DATAFEED_PORT) == ERROR)
+    {
+        return;
+    }
+
+    if ((*(benchWork.feed.init)) (&benchWork.feed, "") == ERROR)
+    {
+        (*(benchWork.feed.exit)) (&benchWork.feed);
+        radMsgLog (PRI_MEDIUM, "SIMBENCH: no datafeed server (wvalarmd) - "
+                               "feed latency not measured, will retry");
+        return;
+    }
+
+    if (radProcessIORegisterDescriptor (benchWork.feed.fd, feedDataCallback, NULL)
+        == ERROR)
+    {
+        (*(benchWork.feed.exit)) (&benchWork.feed);
+        return;
+    }
+
+    benchWork.feedConnected = TRUE;
+    radMsgLog (PRI_STATUS, "SIMBENCH: datafeed connected for latency measurement");
+    return;
+}
+
+static void CheckHTML (void)
+{
+    struct stat     fileData;
+
+    if (strlen(benchWork.htmlFile) == 0)
+    {
+        return;
+    }
+    if (stat (benchWork.htmlFile, &fileData) != 0)
+    {
+        return;
+    }
+    if (fileData.st_mtime == benchWork.htmlModTime)
+    {
+        return;
+    }
+
+    benchWork.htmlModTime = fileData.st_mtime;
+    if (benchWork.lastArchiveCreated != 0 &&
+        ((ULONGLONG)fileData.st_mtime * 1000000ULL) >= benchWork.lastArchiveCreated)
+    {
+        LatencyAdd (&benchWork.htmlLatency,
+                    ((ULONGLONG)fileData.st_mtime * 1000000ULL) - benchWork.lastArchiveCreated);
+        benchWork.lastArchiveCreated = 0;
+    }
+
+    return;
+}
+
+static void Report (ULONGLONG now)
+{
+    float           seconds = (float)(now - benchWork.lastReportTime) / 1000000.0;
+    time_t          simTime = (time_t)benchWork.simTime;
+    char            simDate[64];
+    char            msg[WVIEW_MAX_PATH];
+
+    strftime (simDate, sizeof(simDate), "%Y-%m-%d %H:%M", localtime(&simTime));
+
+    radMsgLog (PRI_STATUS, "SIMBENCH: %.0f LOOP/s, %.2f archive/s, simulated time %s",
+               (float)(benchWork.loopCount - benchWork.lastLoopCount) / seconds,
+               (float)(benchWork.archiveCount - benchWork.lastArchiveCount) / seconds,
+               simDate);
+    radMsgLog (PRI_STATUS, "SIMBENCH: latency avg/max ms: loop %.3f/%.3f  feed %.2f/%.2f  "
+               "archive %.2f/%.2f  html %.0f/%.0f",
+               LatencyAvgMS(&benchWork.loopLatency), LatencyMaxMS(&benchWork.loopLatency),
+               LatencyAvgMS(&benchWork.feedLatency), LatencyMaxMS(&benchWork.feedLatency),
+               LatencyAvgMS(&benchWork.archiveLatency), LatencyMaxMS(&benchWork.archiveLatency),
+               LatencyAvgMS(&benchWork.htmlLatency), LatencyMaxMS(&benchWork.htmlLatency));
+
+    sprintf (msg, "Benchmark: %.0f LOOP/s, simulated %s",
+             (float)(benchWork.loopCount - benchWork.lastLoopCount) / seconds,
+             simDate);
+    statusUpdateMessage (msg);
+
+    // start a new measurement interval:
+    memset (&benchWork.loopLatency, 0, sizeof(benchWork.loopLatency));
+    memset (&benchWork.feedLatency, 0, sizeof(benchWork.feedLatency));
+    memset (&benchWork.archiveLatency, 0, sizeof(benchWork.archiveLatency));
+    memset (&benchWork.htmlLatency, 0, sizeof(benchWork.htmlLatency));
+    benchWork.lastLoopCount = benchWork.loopCount;
+    benchWork.lastArchiveCount = benchWork.archiveCount;
+    benchWork.lastReportTime = now;
+    return;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////  A P I  ///////////////////////////////////
+
+int simBenchConfigure (WVIEWD_WORK *work, int elevation, float latitude)
+{
+    memset (&benchWork, 0, sizeof(benchWork));
+
+    if (stationGetConfigValueInt (work, SIM_BENCH_PARM_RATE, &benchWork.rate) == ERROR ||
+        benchWork.rate <= 0)
+    {
+        return FALSE;
+    }
+    if (benchWork.rate > SIM_BENCH_RATE_MAX)
+    {
+        benchWork.rate = SIM_BENCH_RATE_MAX;
+    }
+
+    if (stationGetConfigValueInt (work, SIM_BENCH_PARM_COMPRESSION, &benchWork.compression)
+        == ERROR || benchWork.compression < 1)
+    {
+        benchWork.compression = 1;
+    }
+
+    stationGetConfigValueString (work, SIM_BENCH_PARM_HTML_FILE,
+                                 benchWork.htmlFile, sizeof(benchWork.htmlFile));
+
+    benchWork.elevation = elevation;
+    benchWork.latitude = latitude;
+    benchWork.seed = (unsigned int)time(NULL);
+    return TRUE;
+}
+
+int simBenchStart
+(
+    WVIEWD_WORK     *work,
+    void            (*archiveIndication)(ARCHIVE_PKT* newRecord)
+)
+{
+    ARCHIVE_PKT     newestRecord;
+    time_t          newest, start, interval;
+    int             days;
+
+    ArchiveIndicator = archiveIndication;
+
+    // pick up after the newest record or 'days' ago, whichever is later:
+    if (stationGetConfigValueInt (work, SIM_BENCH_PARM_DAYS, &days) == ERROR ||
+        days < 0)
+    {
+        days = SIM_BENCH_DAYS_DEFAULT;
+    }
+    start = time(NULL) - (days * WV_SECONDS_IN_DAY);
+    newest = dbsqliteArchiveGetNewestTime (&newestRecord);
+    if ((int)newest != ERROR && newest > start)
+    {
+        start = newest;
+    }
+
+    interval = work->archiveInterval * 60;
+    benchWork.simTime = (double)start;
+    benchWork.nextArchiveTime = ((start / interval) + 1) * interval;
+
+    // prime the LOOP data for the daemon's init sequence:
+    StoreLoopPkt (work, &work->loopPkt, start, 0);
+
+    benchWork.startTime = GetUsecs();
+    benchWork.lastReportTime = benchWork.startTime;
+
+    FeedConnect ();
+
+    radMsgLog (PRI_STATUS, "SIMBENCH: %d LOOP/s, time compression %dx, starting at %s",
+               benchWork.rate, benchWork.compression, ctime(&start));
+
+    radProcessTimerStart (work->ifTimer, SIM_BENCH_REPORT_INTERVAL/10);
+    return OK;
+}
+
+void simBenchStop (WVIEWD_WORK *work)
+{
+    float           seconds;
+
+    radProcessTimerStop (work->ifTimer);
+
+    seconds = (float)(GetUsecs() - benchWork.startTime) / 1000000.0;
+    if (seconds > 0)
+    {
+        radMsgLog (PRI_STATUS, "SIMBENCH: %lu LOOP packets (%.0f/s), %lu archive records "
+                   "(%.2f/s) in %.0f seconds",
+                   benchWork.loopCount, (float)benchWork.loopCount / seconds,
+                   benchWork.archiveCount, (float)benchWork.archiveCount / seconds,
+                   seconds);
+    }
+    if (benchWork.feedUnmatched > 0)
+    {
+        radMsgLog (PRI_STATUS, "SIMBENCH: %lu datafeed LOOP packets were not matched "
+                   "to a sent packet", benchWork.feedUnmatched);
+    }
+
+    if (benchWork.feedConnected)
+    {
+        radProcessIODeRegisterDescriptorByFd (benchWork.feed.fd);
+        (*(benchWork.feed.exit)) (&benchWork.feed);
+        benchWork.feedConnected = FALSE;
+    }
+
+    return;
+}
+
+void simBenchTick (WVIEWD_WORK *work)
+{
+    ULONGLONG       now, loopStart;
+    double          due, sampleSecs, realTime;
+    int             burst, maxBurst;
+    time_t          simTime;
+
+    if (! work->runningFlag)
+    {
+        // daemon init is not complete yet:
+        radProcessTimerStart (work->ifTimer, SIM_BENCH_TICK);
+        return;
+    }
+
+    now = GetUsecs();
+    realTime = (double)now / 1000000.0;
+
+    // how many LOOP packets are due to hold the rate:
+    due = ((double)(now - benchWork.startTime) * benchWork.rate) / 1000000.0;
+    due -= benchWork.loopCount;
+
+    // never burst more than 100 ms worth - keep the process responsive:
+    maxBurst = (benchWork.rate / 10) + 1;
+    burst = (due > maxBurst) ? maxBurst : (int)due;
+
+    while (burst-- > 0)
+    {
+        // advance the simulated clock, it may not pass the real one:
+        sampleSecs = (double)benchWork.compression / (double)benchWork.rate;
+        if (benchWork.simTime + sampleSecs > realTime)
+        {
+            sampleSecs = realTime - benchWork.simTime;
+            if (sampleSecs < 0)
+            {
+                sampleSecs = 0;
+            }
+        }
+        benchWork.simTime += sampleSecs;
+        simTime = (time_t)benchWork.simTime;
+
+        // archive interval boundary crossed?
+        if (simTime >= benchWork.nextArchiveTime)
+        {
+            GenerateArchive (work, benchWork.nextArchiveTime);
+            benchWork.nextArchiveTime += (work->archiveInterval * 60);
+        }
+
+        loopStart = GetUsecs();
+        StoreLoopPkt (work, &work->loopPkt, simTime, sampleSecs);
+        daemonStationLoopComplete ();
+        LatencyAdd (&benchWork.loopLatency, GetUsecs() - loopStart);
+
+        // push it on to the datafeed:
+        stationPushDataToClients (work);
+        if (benchWork.feedConnected)
+        {
+            SentAdd (&work->loopPkt, loopStart);
+        }
+
+        benchWork.loopCount ++;
+    }
+
+    CheckHTML ();
+
+    if ((now - benchWork.lastReportTime) >= (SIM_BENCH_REPORT_INTERVAL * 1000ULL))
+    {
+        FeedConnect ();
+        Report (now);
+    }
+
+    radProcessTimerStart (work->ifTimer, SIM_BENCH_TICK);
+    return;
+}
@@ -0,0 +1,148 @@
+#ifndef INC_simBenchh
+#define INC_simBenchh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        simBench.h
+
+  PURPOSE:
+        Provide the station simulator benchmark (load generation) mode.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Match datafeed LOOPs by
+                                                        fingerprint, not a tag
+
+  NOTES:
+        When STATION_SIM_BENCH_RATE is non-zero the simulator emits LOOP
+        packets at that rate (per second) with diurnal/seasonal values and
+        generates archive records on a compressed clock, then reports the
+        end-to-end latencies it observes.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radtimeUtils.h>
+#include <radmsgLog.h>
+#include <radsysutils.h>
+
+/*  ... Local include files
+*/
+#include <datadefs.h>
+#include <datafeed.h>
+#include <dbsqlite.h>
+#include <daemon.h>
+#include <station.h>
+#include <ethernet.h>
+
+
+// Station-specific configuration items:
+#define SIM_BENCH_PARM_RATE             "STATION_SIM_BENCH_RATE"
+#define SIM_BENCH_PARM_COMPRESSION      "STATION_SIM_BENCH_COMPRESSION"
+#define SIM_BENCH_PARM_DAYS             "STATION_SIM_BENCH_DAYS"
+#define SIM_BENCH_PARM_HTML_FILE        "STATION_SIM_BENCH_HTML_FILE"
+
+#define SIM_BENCH_RATE_MAX              10000       // LOOP packets/sec
+#define SIM_BENCH_DAYS_DEFAULT          365
+#define SIM_BENCH_TICK                  10          // msecs
+#define SIM_BENCH_REPORT_INTERVAL       10000       // msecs
+#define SIM_BENCH_FEED_TIMEOUT          500         // msecs
+
+// LOOP packets pass through wvalarmd unchanged, so each one read back from
+// the datafeed is matched to its creation time by a fingerprint of its
+// values rather than by anything written into the LOOP data:
+#define SIM_BENCH_SENT_RING             4096
+
+typedef struct
+{
+    ULONGLONG       time;                       // usecs, LOOP creation
+    ULONG           fingerprint;
+} SIM_BENCH_SENT;
+
+
+typedef struct
+{
+    ULONG           count;
+    ULONGLONG       sum;                        // usecs
+    ULONGLONG       max;                        // usecs
+} SIM_BENCH_LATENCY;
+
+typedef struct
+{
+    int             rate;                       // LOOP packets/sec
+    int             compression;                // simulated secs per real sec
+    char            htmlFile[WVIEW_MAX_PATH];
+    int             elevation;
+    float           latitude;
+
+    double          simTime;                    // simulated clock
+    time_t          nextArchiveTime;            // simulated archive boundary
+    ULONGLONG       startTime;                  // usecs
+    ULONGLONG       lastReportTime;             // usecs
+    ULONG           loopCount;
+    ULONG           archiveCount;
+    ULONG           lastLoopCount;
+    ULONG           lastArchiveCount;
+    unsigned int    seed;
+    float           pressureWalk;
+    float           tempWalk;
+
+    SIM_BENCH_SENT  sent[SIM_BENCH_SENT_RING];  // oldest at sentHead
+    int             sentHead;
+    int             sentCount;
+    ULONG           feedUnmatched;
+
+    WVIEW_MEDIUM    feed;                       // datafeed loopback client
+    int             feedConnected;
+
+    time_t          htmlModTime;
+    ULONGLONG       lastArchiveCreated;         // usecs
+
+    SIM_BENCH_LATENCY   loopLatency;            // LOOP processing
+    SIM_BENCH_LATENCY   feedLatency;            // creation -> datafeed client
+    SIM_BENCH_LATENCY   archiveLatency;         // archive DB commit
+    SIM_BENCH_LATENCY   htmlLatency;            // archive -> HTML regeneration
+} SIM_BENCH_WORK;
+
+
+// function prototypes
+
+// read the benchmark configuration; returns TRUE if benchmark mode is enabled
+extern int simBenchConfigure (WVIEWD_WORK *work, int elevation, float latitude);
+
+// start load generation (uses the interface timer)
+extern int simBenchStart
+(
+    WVIEWD_WORK     *work,
+    void            (*archiveIndication)(ARCHIVE_PKT* newRecord)
+);
+
+// stop load generation and log the totals
+extern void simBenchStop (WVIEWD_WORK *work);
+
+// interface timer expiry - generate the LOOP packets due
+extern void simBenchTick (WVIEWD_WORK *work);
+
+
+#endif
@@ -9,6 +9,7 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         01/19/2006      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Add benchmark mode
  
   NOTES:
         
@@ -165,6 +166,20 @@ int stationInit
     radMsgLog (PRI_STATUS, "Starting station interface: Simulator"); 
 
 
+    // benchmark mode generates its own LOOP and archive data:
+    simWorkData.benchmark = simBenchConfigure (work, 
+                                               simWorkData.elevation, 
+                                               simWorkData.latitude);
+    if (simWorkData.benchmark)
+    {
+        // archive records follow the simulated clock
+        work->stationGeneratesArchives = TRUE;
+        simBenchStart (work, archiveIndication);
+
+        radProcessEventsSend (NULL, STATION_INIT_COMPLETE_EVENT, 0);
+        return OK;
+    }
+
     // do the initial GetReadings now
     // populate the LOOP structure
     storeLoopPkt (work, &work->loopPkt);
@@ -189,6 +204,11 @@ int stationInit
 //
 void stationExit (WVIEWD_WORK *work)
 {
+    if (simWorkData.benchmark)
+    {
+        simBenchStop (work);
+    }
+
     return;
 }
 
@@ -253,6 +273,12 @@ int stationGetReadings (WVIEWD_WORK *work)
 {
     // we will do this synchronously...
 
+    if (simWorkData.benchmark)
+    {
+        // LOOP data is generated from the interface timer
+        return OK;
+    }
+
     // populate the LOOP structure (with dummy data)
     storeLoopPkt (work, &work->loopPkt);
 
@@ -276,6 +302,12 @@ int stationGetReadings (WVIEWD_WORK *work)
 //
 int stationGetArchive (WVIEWD_WORK *work)
 {
+    if (simWorkData.benchmark)
+    {
+        // records are indicated on the simulated clock by the benchmark
+        return OK;
+    }
+
     // just indicate a NULL record, Simulator does not generate them (and this 
     // function should never be called!)
     (*ArchiveIndicator) (NULL);
@@ -324,6 +356,11 @@ void stationMessageIndicate (WVIEWD_WORK *work, int msgType, void *msg)
 //
 void stationIFTimerExpiry (WVIEWD_WORK *work)
 {
+    if (simWorkData.benchmark)
+    {
+        simBenchTick (work);
+    }
+
     // Simulator station is synchronous...
     return;
 }
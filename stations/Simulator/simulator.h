@@ -56,6 +56,7 @@
 #include <station.h>
 #include <serial.h>
 #include <ethernet.h>
+#include <simBench.h>
 
 
 // define simulator interface data here
@@ -65,6 +66,7 @@ typedef struct
     float           latitude;
     float           longitude;
     int             archiveInterval;
+    int             benchmark;
 
 } SIMULATOR_IF_DATA;
 
@@ -2347,6 +2347,115 @@ int dbfGetNextArchiveRecord
 }
 
 
+//  ... read every archive record in the 'year'/'month' WLK file in one pass;
+//  ... allocates '*entries' (caller frees) and does not use the shared
+//  ... record buffers, so it is safe to call from multiple threads;
+//  ... returns the number of records or ERROR if the file is missing or bad
+
+int dbfReadArchiveMonth
+(
+    char                *archivePath,
+    int                 year,
+    int                 month,
+    DBF_ARCHIVE_ENTRY   **entries
+)
+{
+    char                fileName[256];
+    FILE                *infile;
+    HeaderBlock         header;
+    DBF_ARCHIVE_ENTRY   *store;
+    ArchiveRecord       record;
+    int                 i, j, count = 0, day, hour, minute, recYear, recMonth;
+    time_t              ntime;
+    struct tm           tmtime;
+
+    *entries = NULL;
+
+    sprintf (fileName, "%s/%4.4d-%2.2d.wlk", archivePath, year, month);
+    infile = fopen (fileName, "r");
+    if (infile == NULL)
+    {
+        return ERROR;
+    }
+
+    if (fread (&header, sizeof(header), 1, infile) != 1 || header.totalRecords <= 0)
+    {
+        fclose (infile);
+        return ERROR;
+    }
+
+    store = (DBF_ARCHIVE_ENTRY *)malloc (header.totalRecords * sizeof(DBF_ARCHIVE_ENTRY));
+    if (store == NULL)
+    {
+        fclose (infile);
+        return ERROR;
+    }
+
+    for (i = 1; i < 32; i ++)
+    {
+        if (header.dayIndex[i].recordsInDay == 0)
+        {
+            continue;
+        }
+
+        //  ... skip the 2 daily summary records
+        if (fseek (infile,
+                   sizeof(header) +
+                   DBFILES_RECORD_SIZE*(header.dayIndex[i].startPos + 2),
+                   SEEK_SET)
+                == -1)
+        {
+            break;
+        }
+
+        for (j = 0; j < header.dayIndex[i].recordsInDay - 2; j ++)
+        {
+            if (count >= header.totalRecords ||
+                fread (&record, sizeof(record), 1, infile) != 1)
+            {
+                break;
+            }
+
+            recYear = year;
+            recMonth = month;
+            if (record.packedTime >= (60 * 24))
+            {
+                // 24:00 VP madness - bump the day forward
+                memset (&tmtime, 0, sizeof (tmtime));
+                tmtime.tm_year = year - 1900;
+                tmtime.tm_mon = month - 1;
+                tmtime.tm_mday = i;
+                tmtime.tm_min = 5;              // avoid leap second worries
+                tmtime.tm_isdst = -1;
+                ntime = mktime (&tmtime);
+                ntime += (WV_SECONDS_IN_DAY + 4*WV_SECONDS_IN_HOUR); // Avoid DST fallback
+                localtime_r (&ntime, &tmtime);
+                recYear = tmtime.tm_year + 1900;
+                recMonth = tmtime.tm_mon + 1;
+                day = tmtime.tm_mday;
+                hour = 0;
+                minute = 0;
+            }
+            else
+            {
+                day = i;
+                hour = record.packedTime/60;
+                minute = record.packedTime%60;
+            }
+
+            store[count].date = INSERT_PACKED_DATE(recYear,recMonth,day);
+            store[count].time = (hour*100) + minute;
+            store[count].record = record;
+            count ++;
+        }
+    }
+
+    fclose (infile);
+    *entries = store;
+    return count;
+}
+
+
 //  ... provide a routine to generate an ASCII browser view file
 //  ... 'outputFilename';
 //  ... 'start' and 'stop' are of the form: (("year" - 2000) * 100) + "month"
@@ -308,6 +308,14 @@ typedef struct
 }
 __attribute__ ((packed)) ArchiveRecord;
 
+//  ... one decoded record from dbfReadArchiveMonth
+typedef struct
+{
+    USHORT          date;                   // packed date
+    USHORT          time;                   // (hour * 100) + minute
+    ArchiveRecord   record;
+} DBF_ARCHIVE_ENTRY;
+
 /*  !!!!!!!!!!!!!!!!!!!!  END HIDDEN SECTION  !!!!!!!!!!!!!!!!!!!!!
 */
 
@@ -458,6 +466,19 @@ extern int dbfGetNextArchiveRecord
     ArchiveRecord   *recordStore
 );
 
+/*  ... dbfReadArchiveMonth - read all archive records in the 'year'/'month'
+    ... file in one pass; '*entries' is allocated and must be freed by the
+    ... caller; thread safe;
+    ... returns the number of records or ERROR if the file is missing
+*/
+extern int dbfReadArchiveMonth
+(
+    char                *archivePath,
+    int                 year,
+    int                 month,
+    DBF_ARCHIVE_ENTRY   **entries
+);
+
 /*  ... dbfCopyArchiveRecordToConsoleRecord - copy an archive file record to
     ... the station message record format
 */
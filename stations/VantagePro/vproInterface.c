@@ -859,9 +859,6 @@ static void storeLoopPkt (WVIEWD_WORK *work, LOOP_DATA *src)
     if (src->radiation != 0xFFFF)
         dest->radiation = SHORT_SWAP(src->radiation);
 
-    if (src->tenMinuteAvgWindSpeed != 0xFF)
-        dest->tenMinuteAvgWindSpeed = src->tenMinuteAvgWindSpeed;
-
     dest->forecastIcon = src->forecastIcon;
     dest->forecastRule = src->forecastRule;
     dest->txBatteryStatus = src->txBatteryStatus;
@@ -0,0 +1,393 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        captureTest.c
+
+  PURPOSE:
+        Record a virtual station session against a loopback stand-in for
+        the upstream datafeed server, then replay it ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        The stand-in is a forked child serving the wvalarmd datafeed
+        protocol on a 127.0.0.1 port. The session is opened the way
+        virtualInterface.c does it (medium init, then the socket is made
+        blocking through getsocket), runs the archive catch-up and reads
+        TEST_FRAMES more frames with capture recording.
+
+        The stand-in is then stopped and the same session is replayed from
+        the capture file at full speed: it must get through the getsocket
+        call, the catch-up and every frame with the same results, which
+        needs the frame start bytes to have been captured.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radtimeUtils.h>
+#include <radsocket.h>
+
+/*  ... Local include files
+*/
+#include <daemon.h>
+#include <capture.h>
+#include <virtualProtocol.h>
+
+
+/*  ... local memory
+*/
+
+#define TEST_FRAMES             12
+#define TEST_LOOP_MS            50          // stand-in LOOP interval
+#define TEST_ARCHIVE_LOOP       4           // live archive after this many
+#define TEST_TIMEOUT_SECS       60          // a hung replay fails the test
+
+typedef struct
+{
+    int             frames[TEST_FRAMES];    // ReadDataFrame results
+    float           outTemp[TEST_FRAMES];
+    int             archives;
+    ULONG           lastArchive;
+} TEST_SESSION;
+
+static char         testFile[64];
+static int          testPort;
+static pid_t        testPid;
+static time_t       testSyncTime;
+static time_t       testLiveTime;
+static TEST_SESSION *testSession;
+static int          testFailures;
+
+static void testArchiveIndicator (ARCHIVE_PKT *newRecord)
+{
+    testSession->archives ++;
+    testSession->lastArchive = newRecord->dateTime;
+    return;
+}
+
+
+//  ... stand-ins for what virtualProtocol.c takes from wviewd
+
+void (*ArchiveIndicator) (ARCHIVE_PKT *newRecord) = testArchiveIndicator;
+
+int dbsqliteHiLowUpdateArchive (ARCHIVE_PKT *data)
+{
+    return OK;
+}
+
+int dbsqliteHiLowStoreArchive (ARCHIVE_PKT *data)
+{
+    return OK;
+}
+
+int wvstrncpy (char *d, const char *s, size_t bufsize)
+{
+    snprintf (d, bufsize, "%s", s);
+    return strlen (s);
+}
+
+
+//  ... the upstream stand-in
+
+static void standInWrite (int fd, const USHORT *frame, void *data, int length)
+{
+    if (write (fd, frame, DF_START_FRAME_LENGTH) != DF_START_FRAME_LENGTH ||
+        write (fd, data, length) != length)
+    {
+        exit (1);
+    }
+    return;
+}
+
+static void standInArchive (int fd, time_t dateTime)
+{
+    ARCHIVE_PKT     record, netRecord;
+
+    memset (&record, 0, sizeof (record));
+    record.dateTime = (ULONG)dateTime;
+    record.interval = 5;
+    datafeedConvertArchive_HTON (&netRecord, &record);
+    standInWrite (fd, DF_ARCHIVE_START_FRAME, &netRecord, sizeof (netRecord));
+    return;
+}
+
+static void standInLOOP (int fd, int count)
+{
+    LOOP_PKT        loop, netLoop;
+    DF_LOOP_EXT     netExt;
+
+    memset (&loop, 0, sizeof (loop));
+    loop.barometer      = 30.0;
+    loop.outTemp        = 50.0 + count;
+    loop.outHumidity    = 50;
+    loop.windSpeed      = 4;
+    loop.windDir        = 180;
+    datafeedConvertLOOP_HTON (&netLoop, &loop);
+    datafeedConvertLOOPExt_HTON (&netExt, &loop);
+    standInWrite (fd, DF_LOOP_START_FRAME, &netLoop, DF_LOOP_PKT_LENGTH);
+    standInWrite (fd, DF_LOOP_EXT_START_FRAME, &netExt, sizeof (netExt));
+    return;
+}
+
+static void standInRun (int listenFd)
+{
+    int             fd, loops = 0;
+    UCHAR           request[DF_START_FRAME_LENGTH + sizeof (ULONG)];
+    ULONG           dateTime;
+    ULONGLONG       lastLoop = 0;
+    struct pollfd   pfd;
+
+    signal (SIGPIPE, SIG_IGN);
+
+    if ((fd = accept (listenFd, NULL, NULL)) < 0)
+    {
+        exit (1);
+    }
+
+    for (;;)
+    {
+        pfd.fd      = fd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        if (poll (&pfd, 1, 10) > 0)
+        {
+            if (recv (fd, request, sizeof (request), MSG_WAITALL) != sizeof (request))
+            {
+                exit (0);
+            }
+            if (! memcmp (request, DF_RQST_ARCHIVE_START_FRAME, DF_START_FRAME_LENGTH))
+            {
+                // the catch-up has one record, then "no more":
+                memcpy (&dateTime, &request[DF_START_FRAME_LENGTH], sizeof (dateTime));
+                dateTime = ntohl (dateTime);
+                standInArchive (fd, ((time_t)dateTime < testSyncTime) ? testSyncTime : 0);
+                lastLoop = radTimeGetMSSinceEpoch ();
+            }
+        }
+
+        if (lastLoop == 0 || radTimeGetMSSinceEpoch () - lastLoop < TEST_LOOP_MS)
+        {
+            continue;
+        }
+        lastLoop = radTimeGetMSSinceEpoch ();
+
+        standInLOOP (fd, loops);
+        loops ++;
+        if (loops == TEST_ARCHIVE_LOOP)
+        {
+            standInArchive (fd, testLiveTime);
+        }
+    }
+}
+
+static int standInStart (void)
+{
+    int                 fd, on = 1;
+    struct sockaddr_in  addr;
+    socklen_t           length = sizeof (addr);
+
+    fd = socket (AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return ERROR;
+    }
+    setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof (on));
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_addr.s_addr    = htonl (INADDR_LOOPBACK);
+    addr.sin_port           = 0;
+    if (bind (fd, (struct sockaddr *)&addr, sizeof (addr)) < 0 ||
+        listen (fd, 4) < 0 ||
+        getsockname (fd, (struct sockaddr *)&addr, &length) < 0)
+    {
+        close (fd);
+        return ERROR;
+    }
+    testPort = ntohs (addr.sin_port);
+
+    testPid = fork ();
+    if (testPid < 0)
+    {
+        close (fd);
+        return ERROR;
+    }
+    else if (testPid == 0)
+    {
+        standInRun (fd);
+        exit (0);
+    }
+
+    close (fd);
+    return OK;
+}
+
+static void standInStop (void)
+{
+    if (testPid > 0)
+    {
+        kill (testPid, SIGTERM);
+        waitpid (testPid, NULL, 0);
+        testPid = 0;
+    }
+    return;
+}
+
+
+//  ... the session, as virtualInterface.c runs it
+
+static void check (int condition, char *what)
+{
+    printf ("captureTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static int runSession (char *captureFile, char *replayFile, TEST_SESSION *session)
+{
+    static WVIEWD_WORK  work;
+    LOOP_PKT            loop;
+    RADSOCK_ID          sockId;
+    int                 i;
+
+    memset (&work, 0, sizeof (work));
+    memset (session, 0, sizeof (*session));
+    testSession = session;
+    work.archiveDateTime = testSyncTime - 600;
+
+    captureConfigure (&work.medium, captureFile, replayFile, 0);
+    if (ethernetMediumInit (&work.medium, "127.0.0.1", testPort) == ERROR ||
+        (*(work.medium.init)) (&work.medium, "") == ERROR)
+    {
+        printf ("captureTest: medium init failed\n");
+        return ERROR;
+    }
+
+    sockId = (*(work.medium.getsocket)) (&work.medium);
+    if (sockId == NULL)
+    {
+        printf ("captureTest: getsocket returned NULL\n");
+        (*(work.medium.exit)) (&work.medium);
+        return ERROR;
+    }
+    radSocketSetBlocking (sockId, TRUE);
+
+    if (virtualProtocolInit (&work) == ERROR)
+    {
+        printf ("captureTest: virtualProtocolInit failed\n");
+        (*(work.medium.exit)) (&work.medium);
+        return ERROR;
+    }
+
+    for (i = 0; i < TEST_FRAMES; i ++)
+    {
+        session->frames[i] = virtualProtocolDataIndicate (&work);
+        virtualProtocolGetReadings (&work, &loop);
+        session->outTemp[i] = loop.outTemp;
+    }
+    virtualProtocolGetArchive (&work);
+
+    (*(work.medium.exit)) (&work.medium);
+    return OK;
+}
+
+
+int main (int argc, char *argv[])
+{
+    TEST_SESSION        recorded, replayed;
+    ULONGLONG           replayTime;
+    int                 i, isSame, loops = 0;
+
+    alarm (TEST_TIMEOUT_SECS);
+    testSyncTime = time (NULL) - 600;
+    testLiveTime = time (NULL) + 300;
+    snprintf (testFile, sizeof (testFile), "/tmp/captureTest.%d", (int)getpid ());
+
+    if (standInStart () == ERROR)
+    {
+        printf ("captureTest: cannot start the stand-in: %s\n", strerror (errno));
+        return 1;
+    }
+
+    if (runSession (testFile, NULL, &recorded) == ERROR)
+    {
+        standInStop ();
+        unlink (testFile);
+        return 1;
+    }
+    standInStop ();
+
+    for (i = 0; i < TEST_FRAMES; i ++)
+    {
+        if (recorded.frames[i] == DF_LOOP_PKT_TYPE)
+        {
+            loops ++;
+        }
+    }
+    check (recorded.archives == 2 && recorded.lastArchive == (ULONG)testLiveTime,
+           "recorded the catch-up and the live archive");
+    check (loops >= TEST_ARCHIVE_LOOP, "recorded LOOP frames");
+
+    // nothing is listening now, replay must not touch the network:
+    replayTime = radTimeGetMSSinceEpoch ();
+    if (runSession (NULL, testFile, &replayed) == ERROR)
+    {
+        check (FALSE, "replay ran");
+        unlink (testFile);
+        printf ("captureTest: %d failures\n", testFailures);
+        return 1;
+    }
+    replayTime = radTimeGetMSSinceEpoch () - replayTime;
+
+    isSame = TRUE;
+    for (i = 0; i < TEST_FRAMES; i ++)
+    {
+        if (replayed.frames[i] != recorded.frames[i] ||
+            replayed.outTemp[i] != recorded.outTemp[i])
+        {
+            printf ("captureTest: frame %d: recorded %d (%.1f), replayed %d (%.1f)\n",
+                    i, recorded.frames[i], recorded.outTemp[i],
+                    replayed.frames[i], replayed.outTemp[i]);
+            isSame = FALSE;
+        }
+    }
+    check (replayed.archives == recorded.archives &&
+           replayed.lastArchive == recorded.lastArchive,
+           "replayed the same archive records");
+    check (isSame, "replayed the same frames and readings");
+
+    printf ("captureTest: %d frames replayed in %llu ms\n",
+            TEST_FRAMES, (unsigned long long)replayTime);
+
+    unlink (testFile);
+    printf ("captureTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
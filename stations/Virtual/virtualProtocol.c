@@ -9,8 +9,12 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         12/17/2009      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Sync on the frame start
+                                                        through the medium
 
   NOTES:
+        All datafeed traffic goes through the medium methods (not the raw
+        socket), so station capture and replay see every byte.
 
   LICENSE:
         Copyright (c) 2009, Mark S. Teel (mark@teel.ws)
@@ -63,17 +67,58 @@ static VIRTUAL_WORK         virtualWork;
 /*  ... methods
 */
 
+// datafeedSyncStartOfFrame, read through the medium:
+static int SyncStartOfFrame(WVIEWD_WORK *work)
+{
+    USHORT          start[4];
+    int             i;
+
+    if ((*work->medium.read)(&work->medium, (void *)&start[0], sizeof (USHORT), DF_WAIT_FIRST)
+        != sizeof (USHORT))
+    {
+        return ERROR_ABORT;
+    }
+    else if (start[0] != DF_LOOP_START_FRAME[0])
+    {
+        return FALSE;
+    }
+
+    for (i = 1; i < 4; i ++)
+    {
+        if ((*work->medium.read)(&work->medium, (void *)&start[i], sizeof (USHORT), DF_WAIT_MORE)
+            != sizeof (USHORT))
+        {
+            radMsgLog (PRI_HIGH, "VIRTUAL: frame start read %d error - abort!", i + 1);
+            return ERROR;
+        }
+        else if (i < 3 && start[i] != DF_LOOP_START_FRAME[i])
+        {
+            return FALSE;
+        }
+    }
+
+    if (start[3] == DF_LOOP_START_FRAME[3] ||
+        start[3] == DF_ARCHIVE_START_FRAME[3] ||
+        start[3] == DF_RQST_ARCHIVE_START_FRAME[3] ||
+        start[3] == DF_LOOP_EXT_START_FRAME[3])
+    {
+        return (int)start[3];
+    }
+
+    return FALSE;
+}
+
 static int ReadDataFrame(WVIEWD_WORK *work)
 {
     int             retVal;
     LOOP_PKT        loopData;
     LOOP_PKT        hostLoopData;
+    DF_LOOP_EXT     loopExt;
     ARCHIVE_PKT     archiveRecord;
     ARCHIVE_PKT     hostRecord;
-    RADSOCK_ID      sockId = (*work->medium.getsocket)(&work->medium);
 
     /* try to find the start frame (this blocks if the socket is empty) */
-    retVal = datafeedSyncStartOfFrame(sockId);
+    retVal = SyncStartOfFrame(work);
     switch (retVal)
     {
         case ERROR:
@@ -87,8 +132,8 @@ static int ReadDataFrame(WVIEWD_WORK *work)
 
         case DF_LOOP_PKT_TYPE:
             /* OK, we have a loop update coming (this may block) */
-            if ((*work->medium.read)(&work->medium, (void *)&loopData, sizeof (loopData), 1000) 
-                != sizeof (loopData))
+            if ((*work->medium.read)(&work->medium, (void *)&loopData, DF_LOOP_PKT_LENGTH, 1000) 
+                != DF_LOOP_PKT_LENGTH)
             {
                 return FALSE;
             }
@@ -100,6 +145,12 @@ static int ReadDataFrame(WVIEWD_WORK *work)
             virtualWork.data.loopData = hostLoopData;
             return DF_LOOP_PKT_TYPE;
 
+        case DF_LOOP_EXT_PKT_TYPE:
+            // the wind windows are computed here from our own LOOPs, so
+            // just consume the remote ones:
+            (*work->medium.read)(&work->medium, (void *)&loopExt, sizeof (loopExt), 1000);
+            return FALSE;
+
         case DF_ARCHIVE_PKT_TYPE:
             /* OK, we have an archive coming (this may block) */
             if ((*work->medium.read)(&work->medium, (void *)&archiveRecord, sizeof(archiveRecord), 1000) 
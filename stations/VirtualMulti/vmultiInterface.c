@@ -0,0 +1,384 @@
+/*---------------------------------------------------------------------------
+ 
+  FILENAME:
+        vmultiInterface.c
+ 
+  PURPOSE:
+        Provide the multi-upstream virtual station interface API and
+        utilities.
+ 
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+        Each upstream source socket is registered with the process I/O
+        loop by the protocol module, so the daemon medium is MEDIUM_TYPE_NONE.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+ 
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+
+/*  ... Library include files
+*/
+
+/*  ... Local include files
+*/
+#include <vmultiInterface.h>
+
+/*  ... global memory declarations
+*/
+
+/*  ... local memory
+*/
+
+static VMULTI_IF_DATA   vmultiWorkData;
+
+void                    (*ArchiveIndicator) (ARCHIVE_PKT* newRecord);
+
+static void             storeLoopPkt (LOOP_PKT *dest, VMULTI_IF_DATA *src);
+
+
+////////////****////****  S T A T I O N   A P I  ****////****////////////
+/////  Must be provided by each supported wview station interface  //////
+
+// station-supplied init function
+// -- Can Be Asynchronous - event indication required --
+//
+// MUST:
+//   - set the 'stationGeneratesArchives' flag in WVIEWD_WORK:
+//     if the station generates archive records (TRUE) or they should be
+//     generated automatically by the daemon from the sensor readings (FALSE)
+//   - Initialize the 'stationData' store for station work area
+//   - Initialize the interface medium
+//   - do initial LOOP acquisition
+//   - do any catch-up on archive records if there is a data logger
+//   - 'work->runningFlag' can be used for start up synchronization but should
+//     not be modified by the station interface code
+//   - indicate init is done by sending the STATION_INIT_COMPLETE_EVENT event to
+//     this process (radProcessEventsSend (NULL, STATION_INIT_COMPLETE_EVENT, 0))
+//
+// OPTIONAL:
+//   - Initialize a state machine or any other construct required for the
+//     station interface - these should be stored in the 'stationData' store
+//
+// 'archiveIndication' - indication callback used to pass back an archive record
+//   generated as a result of 'stationGetArchive' being called; should receive a
+//   NULL pointer for 'newRecord' if no record available; only used if
+//   'stationGeneratesArchives' flag is set to TRUE by the station interface
+//
+// Returns: OK or ERROR
+//
+int stationInit
+(
+    WVIEWD_WORK     *work,
+    void            (*archiveIndication)(ARCHIVE_PKT* newRecord)
+)
+{
+    ARCHIVE_PKT     newestRecord;
+    char            tempStr[WVIEW_MAX_PATH];
+    char            hostList[WVIEW_MAX_PATH];
+    char            policy[WVIEW_STRING1_SIZE];
+    char            fieldPriority[WVIEW_MAX_PATH];
+    int             staleSeconds;
+
+    memset (&vmultiWorkData, 0, sizeof(vmultiWorkData));
+
+    // save the archive indication callback (we should never need it)
+    ArchiveIndicator = archiveIndication;
+
+    // set our work data pointer
+    work->stationData = &vmultiWorkData;
+
+    // set the Archive Generation flag to indicate the upstream stations
+    // generate them
+    work->stationGeneratesArchives = TRUE;
+
+    // the protocol module owns the upstream sockets:
+    memset (&work->medium, 0, sizeof(work->medium));
+    work->medium.type = MEDIUM_TYPE_NONE;
+
+    // get the upstream source list - default to the single virtual host:
+    stationGetConfigValueString (work, VMULTI_PARM_HOSTS, hostList, sizeof(hostList));
+    if (strlen(hostList) == 0)
+    {
+        sprintf (hostList, "%s:%d", work->stationHost, work->stationPort);
+    }
+    stationGetConfigValueString (work, VMULTI_PARM_POLICY, policy, sizeof(policy));
+    stationGetConfigValueString (work, VMULTI_PARM_FIELD_PRIORITY,
+                                 fieldPriority, sizeof(fieldPriority));
+    if (stationGetConfigValueInt (work, VMULTI_PARM_STALE_SECS, &staleSeconds) == ERROR)
+    {
+        staleSeconds = VMULTI_STALE_DEFAULT;
+    }
+
+    if (vmultiProtocolConfigure (work, hostList, policy, fieldPriority, staleSeconds)
+        == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "stationInit: vmultiProtocolConfigure failed");
+        return ERROR;
+    }
+
+    // grab the station configuration now
+    if (stationGetConfigValueInt (work,
+                                  STATION_PARM_ELEVATION,
+                                  &vmultiWorkData.elevation)
+            == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "stationInit: stationGetConfigValueInt ELEV failed!");
+        return ERROR;
+    }
+    if (stationGetConfigValueFloat (work,
+                                    STATION_PARM_LATITUDE,
+                                    &vmultiWorkData.latitude)
+            == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "stationInit: stationGetConfigValueInt LAT failed!");
+        return ERROR;
+    }
+    if (stationGetConfigValueFloat (work,
+                                    STATION_PARM_LONGITUDE,
+                                    &vmultiWorkData.longitude)
+            == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "stationInit: stationGetConfigValueInt LONG failed!");
+        return ERROR;
+    }
+    if (stationGetConfigValueInt (work,
+                                  STATION_PARM_ARC_INTERVAL,
+                                  &vmultiWorkData.archiveInterval)
+            == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "stationInit: stationGetConfigValueInt ARCINT failed!");
+        return ERROR;
+    }
+
+    // set the work archive interval now
+    work->archiveInterval = vmultiWorkData.archiveInterval;
+
+    // sanity check the archive interval against the most recent record
+    if (stationVerifyArchiveInterval (work) == ERROR)
+    {
+        // bad magic!
+        radMsgLog (PRI_HIGH, "stationInit: stationVerifyArchiveInterval failed!");
+        radMsgLog (PRI_HIGH, "You must either move old archive data out of the way -or-");
+        radMsgLog (PRI_HIGH, "fix the interval setting...");
+        return ERROR;
+    }
+    else
+    {
+        radMsgLog (PRI_STATUS, "station archive interval: %d minutes",
+                   work->archiveInterval);
+    }
+
+    radMsgLog (PRI_STATUS, "Starting station interface: VIRTUALMULTI"); 
+
+    // This must be done here:
+    work->archiveDateTime = dbsqliteArchiveGetNewestTime(&newestRecord);
+    if ((int)work->archiveDateTime == ERROR)
+    {
+        work->archiveDateTime = 0;
+        radMsgLog (PRI_STATUS, "stationInit: no archive records found in database!");
+    }
+
+    // initialize the station interface
+    if (vmultiProtocolInit(work) == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "stationInit: vmultiProtocolInit failed!");
+        return ERROR;
+    }
+
+    // Reset the stationType to include the source count:
+    sprintf(tempStr, "%s:%d sources", 
+            work->stationType, vmultiProtocolGetNumConnected());
+    wvstrncpy(work->stationType, tempStr, sizeof(work->stationType));
+
+    // do the initial GetReadings now
+    if (vmultiProtocolGetReadings(work, &vmultiWorkData.vmultiReadings) != OK)
+    {
+        radMsgLog (PRI_HIGH, "stationInit: initial vmultiProtocolGetReadings failed!");
+        vmultiProtocolExit (work);
+        return ERROR;
+    }
+
+    // populate the LOOP structure
+    storeLoopPkt (&work->loopPkt, &vmultiWorkData);
+
+    // we must indicate successful completion here -
+    // even though we are synchronous, the daemon wants to see this event
+    radProcessEventsSend(NULL, STATION_INIT_COMPLETE_EVENT, 0);
+
+    return OK;
+}
+
+// station-supplied exit function
+//
+// Returns: N/A
+//
+void stationExit (WVIEWD_WORK *work)
+{
+    vmultiProtocolExit (work);
+
+    return;
+}
+
+// station-supplied function to retrieve positional info (lat, long, elev) -
+// should populate 'work' fields: latitude, longitude, elevation
+// -- Synchronous --
+//
+// - If station does not store these parameters, they can be retrieved from the
+//   wview.conf file (see daemon.c for example conf file use) - user must choose
+//   station type "Generic" when running the wviewconfig script
+//
+// Returns: OK or ERROR
+//
+int stationGetPosition (WVIEWD_WORK *work)
+{
+    // just set the values from our internal store - we retrieved them in
+    // stationInit
+    work->elevation     = (short)vmultiWorkData.elevation;
+    if (vmultiWorkData.latitude >= 0)
+        work->latitude      = (short)((vmultiWorkData.latitude*10)+0.5);
+    else
+        work->latitude      = (short)((vmultiWorkData.latitude*10)-0.5);
+    if (vmultiWorkData.longitude >= 0)
+        work->longitude     = (short)((vmultiWorkData.longitude*10)+0.5);
+    else
+        work->longitude     = (short)((vmultiWorkData.longitude*10)-0.5);
+
+    radMsgLog (PRI_STATUS, "station location: elevation: %d feet",
+               work->elevation);
+
+    radMsgLog (PRI_STATUS, "station location: latitude: %3.1f %c  longitude: %3.1f %c",
+               (float)abs(work->latitude)/10.0,
+               ((work->latitude < 0) ? 'S' : 'N'),
+               (float)abs(work->longitude)/10.0,
+               ((work->longitude < 0) ? 'W' : 'E'));
+
+    return OK;
+}
+
+// station-supplied function to indicate a time sync should be performed if the
+// station maintains time, otherwise may be safely ignored
+// -- Can Be Asynchronous --
+//
+// Returns: OK or ERROR
+//
+int stationSyncTime (WVIEWD_WORK *work)
+{
+    // VIRTUALMULTI does not keep time...
+    return OK;
+}
+
+// station-supplied function to indicate sensor readings should be performed -
+// should populate 'work' struct: loopPkt (see datadefs.h for minimum field reqs)
+// -- Can Be Asynchronous --
+//
+// - indicate readings are complete by sending the STATION_LOOP_COMPLETE_EVENT
+//   event to this process (radProcessEventsSend (NULL, STATION_LOOP_COMPLETE_EVENT, 0))
+//
+// Returns: OK or ERROR
+//
+int stationGetReadings (WVIEWD_WORK *work)
+{
+    // we will do this synchronously...
+
+    // get readings from station
+    if (vmultiProtocolGetReadings(work, &vmultiWorkData.vmultiReadings) == OK)
+    {
+        // populate the LOOP structure
+        storeLoopPkt(&work->loopPkt, &vmultiWorkData);
+
+        // indicate we are done
+        radProcessEventsSend(NULL, STATION_LOOP_COMPLETE_EVENT, 0);
+    }
+
+    return OK;
+}
+
+// station-supplied function to indicate an archive record should be generated -
+// MUST populate an ARCHIVE_RECORD struct and indicate it to 'archiveIndication'
+// function passed into 'stationInit'
+// -- Asynchronous - callback indication required --
+//
+// Returns: OK or ERROR
+//
+// Note: 'archiveIndication' should receive a NULL pointer for the newRecord if
+//       no record is available
+// Note: This function will only be invoked by the wview daemon if the
+//       'stationInit' function set the 'stationGeneratesArchives' to TRUE
+//
+int stationGetArchive (WVIEWD_WORK *work)
+{
+    // Let the protocol module handle archive requests:
+    vmultiProtocolGetArchive(work);
+    return OK;
+}
+
+// station-supplied function to indicate data is available on the station
+// interface medium (serial or ethernet) -
+// It is the responsibility of the station interface to read the data from the
+// medium and process appropriately. The data does not have to be read within
+// the context of this function, but may be used to stimulate a state machine.
+// -- Synchronous --
+//
+// Returns: N/A
+//
+void stationDataIndicate (WVIEWD_WORK *work)
+{
+    // N/A - each upstream source has its own I/O callback
+    return;
+}
+
+// station-supplied function to receive IPM messages - any message received by
+// the generic station message handler which is not recognized will be passed
+// to the station-specific code through this function.
+// It is the responsibility of the station interface to process the message 
+// appropriately (or ignore it).
+// -- Synchronous --
+//
+// Returns: N/A
+//
+void stationMessageIndicate (WVIEWD_WORK *work, int msgType, void *msg)
+{
+    // N/A
+    return;
+}
+
+// station-supplied function to indicate the interface timer has expired -
+// It is the responsibility of the station interface to start/stop the interface
+// timer as needed for the particular station requirements.
+// The station interface timer is specified by the 'ifTimer' member of the
+// WVIEWD_WORK structure. No other timers in that structure should be manipulated
+// in any way by the station interface code.
+// -- Synchronous --
+//
+// Returns: N/A
+//
+void stationIFTimerExpiry (WVIEWD_WORK *work)
+{
+    // Try to restore any lost upstream sources:
+    vmultiProtocolReconnect (work);
+    return;
+}
+
+
+////////////****////  S T A T I O N   A P I   E N D  ////****////////////
+
+
+//  ... ----- static (local) methods ----- ...
+
+static void storeLoopPkt (LOOP_PKT *dest, VMULTI_IF_DATA *src)
+{
+    *dest = src->vmultiReadings;
+
+    return;
+}
+
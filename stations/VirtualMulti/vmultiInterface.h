@@ -0,0 +1,78 @@
+#ifndef INC_vmultiInterfaceh
+#define INC_vmultiInterfaceh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        vmultiInterface.h
+
+  PURPOSE:
+        Provide the multi-upstream virtual station interface API and
+        utilities.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+
+  NOTES:
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+#include <errno.h>
+#include <math.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radtimeUtils.h>
+#include <radmsgLog.h>
+#include <radsysutils.h>
+
+/*  ... Local include files
+*/
+#include <datadefs.h>
+#include <dbsqlite.h>
+#include <config.h>
+#include <computedData.h>
+#include <daemon.h>
+#include <station.h>
+#include <serial.h>
+#include <ethernet.h>
+
+#include <vmultiProtocol.h>
+
+
+// define VirtualMulti-specific interface data here
+typedef struct
+{
+    int             elevation;
+    float           latitude;
+    float           longitude;
+    int             archiveInterval;
+    LOOP_PKT        vmultiReadings;
+} VMULTI_IF_DATA;
+
+
+// Prototypes:
+
+
+#endif
+
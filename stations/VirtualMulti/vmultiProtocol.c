@@ -0,0 +1,985 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        vmultiProtocol.c
+
+  PURPOSE:
+        Provide protocol utilities for multi-upstream virtual station
+        communication.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Restart the reconnect timer
+                                                        when a source drops
+        10/19/2026      M.S. Teel       2               Connect to sources without
+                                                        blocking
+
+  NOTES:
+        Based on the single upstream virtual station (virtualProtocol.c).
+        Archive catch-up at startup is done against the first reachable
+        source; after that each source socket is non-blocking and is
+        registered with the process I/O loop on its own.
+
+        Source connects are non-blocking: the archive sync source waits at
+        most VMULTI_CONNECT_TIMEOUT at startup, every other connect is
+        started and then checked each VMULTI_CONNECT_POLL by the interface
+        timer, so an unreachable host never holds up the process loop.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+#include <errno.h>
+#include <math.h>
+
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radsysutils.h>
+#include <radtimeUtils.h>
+#include <radprocess.h>
+
+/*  ... Local include files
+*/
+#include <services.h>
+#include <daemon.h>
+#include <station.h>
+#include <vmultiProtocol.h>
+
+/*  ... global memory declarations
+*/
+extern void     (*ArchiveIndicator)(ARCHIVE_PKT* newRecord);
+
+/*  ... local memory
+*/
+
+static VMULTI_WORK          vmultiWork;
+
+#define VMULTI_LOOP_OFFSET(x)       ((int)offsetof(LOOP_PKT, x))
+
+// The LOOP fields subject to the merge policy (the minimum required set):
+static VMULTI_FIELD         vmultiFields[VMULTI_FIELD_MAX] =
+{
+    { "barometer",          VMULTI_LOOP_OFFSET(barometer),          VMULTI_FIELD_FLOAT      },
+    { "stationPressure",    VMULTI_LOOP_OFFSET(stationPressure),    VMULTI_FIELD_FLOAT      },
+    { "altimeter",          VMULTI_LOOP_OFFSET(altimeter),          VMULTI_FIELD_FLOAT      },
+    { "inTemp",             VMULTI_LOOP_OFFSET(inTemp),             VMULTI_FIELD_FLOAT      },
+    { "outTemp",            VMULTI_LOOP_OFFSET(outTemp),            VMULTI_FIELD_FLOAT      },
+    { "inHumidity",         VMULTI_LOOP_OFFSET(inHumidity),         VMULTI_FIELD_USHORT     },
+    { "outHumidity",        VMULTI_LOOP_OFFSET(outHumidity),        VMULTI_FIELD_USHORT     },
+    { "windSpeed",          VMULTI_LOOP_OFFSET(windSpeed),          VMULTI_FIELD_USHORT     },
+    { "windDir",            VMULTI_LOOP_OFFSET(windDir),            VMULTI_FIELD_DIRECTION  },
+    { "windGust",           VMULTI_LOOP_OFFSET(windGust),           VMULTI_FIELD_USHORT     },
+    { "windGustDir",        VMULTI_LOOP_OFFSET(windGustDir),        VMULTI_FIELD_DIRECTION  },
+    { "rainRate",           VMULTI_LOOP_OFFSET(rainRate),           VMULTI_FIELD_FLOAT      },
+    { "sampleRain",         VMULTI_LOOP_OFFSET(sampleRain),         VMULTI_FIELD_FLOAT      },
+    { "sampleET",           VMULTI_LOOP_OFFSET(sampleET),           VMULTI_FIELD_FLOAT      },
+    { "radiation",          VMULTI_LOOP_OFFSET(radiation),          VMULTI_FIELD_USHORT     },
+    { "UV",                 VMULTI_LOOP_OFFSET(UV),                 VMULTI_FIELD_FLOAT      },
+    { "dewpoint",           VMULTI_LOOP_OFFSET(dewpoint),           VMULTI_FIELD_FLOAT      },
+    { "windchill",          VMULTI_LOOP_OFFSET(windchill),          VMULTI_FIELD_FLOAT      },
+    { "heatindex",          VMULTI_LOOP_OFFSET(heatindex),          VMULTI_FIELD_FLOAT      }
+};
+
+
+/*  ... methods
+*/
+
+static float *fieldFloat(LOOP_PKT *pkt, int index)
+{
+    return (float *)((UCHAR *)pkt + vmultiFields[index].offset);
+}
+
+static USHORT *fieldUShort(LOOP_PKT *pkt, int index)
+{
+    return (USHORT *)((UCHAR *)pkt + vmultiFields[index].offset);
+}
+
+static int IsSourceFresh(VMULTI_SOURCE *src, time_t now)
+{
+    if (! src->isConnected || src->loopTime == 0)
+    {
+        return FALSE;
+    }
+
+    return ((now - src->loopTime) <= vmultiWork.staleSeconds);
+}
+
+// Returns the index of the first fresh source in priority order or ERROR:
+static int GetPrimarySource(time_t now)
+{
+    int             i;
+
+    for (i = 0; i < vmultiWork.numSources; i ++)
+    {
+        if (IsSourceFresh(&vmultiWork.source[i], now))
+        {
+            return i;
+        }
+    }
+
+    return ERROR;
+}
+
+// Returns the index of the most recently updated fresh source or ERROR:
+static int GetFreshestSource(time_t now)
+{
+    int             i, retVal = ERROR;
+
+    for (i = 0; i < vmultiWork.numSources; i ++)
+    {
+        if (! IsSourceFresh(&vmultiWork.source[i], now))
+        {
+            continue;
+        }
+        if (retVal == ERROR ||
+            vmultiWork.source[i].loopTime > vmultiWork.source[retVal].loopTime)
+        {
+            retVal = i;
+        }
+    }
+
+    return retVal;
+}
+
+static void AverageField(LOOP_PKT *dest, int field, time_t now)
+{
+    int             i, count = 0;
+    double          sum = 0, sumX = 0, sumY = 0, angle;
+    LOOP_PKT        *pkt;
+
+    for (i = 0; i < vmultiWork.numSources; i ++)
+    {
+        if (! IsSourceFresh(&vmultiWork.source[i], now))
+        {
+            continue;
+        }
+
+        pkt = &vmultiWork.source[i].loopData;
+        switch (vmultiFields[field].type)
+        {
+            case VMULTI_FIELD_FLOAT:
+                if (*fieldFloat(pkt, field) <= ARCHIVE_VALUE_NULL)
+                {
+                    continue;
+                }
+                sum += *fieldFloat(pkt, field);
+                break;
+
+            case VMULTI_FIELD_USHORT:
+                if (*fieldUShort(pkt, field) == 0xFFFF)
+                {
+                    continue;
+                }
+                sum += *fieldUShort(pkt, field);
+                break;
+
+            case VMULTI_FIELD_DIRECTION:
+                if (*fieldUShort(pkt, field) > 360)
+                {
+                    continue;
+                }
+                angle = (double)(*fieldUShort(pkt, field)) * M_PI / 180.0;
+                sumX += sin(angle);
+                sumY += cos(angle);
+                break;
+        }
+
+        count ++;
+    }
+
+    if (count == 0)
+    {
+        // Leave the primary source value in place:
+        return;
+    }
+
+    switch (vmultiFields[field].type)
+    {
+        case VMULTI_FIELD_FLOAT:
+            *fieldFloat(dest, field) = (float)(sum / count);
+            break;
+
+        case VMULTI_FIELD_USHORT:
+            *fieldUShort(dest, field) = (USHORT)((sum / count) + 0.5);
+            break;
+
+        case VMULTI_FIELD_DIRECTION:
+            angle = atan2(sumX, sumY) * 180.0 / M_PI;
+            if (angle < 0)
+            {
+                angle += 360.0;
+            }
+            *fieldUShort(dest, field) = ((USHORT)(angle + 0.5)) % 360;
+            break;
+    }
+
+    return;
+}
+
+static void MergeLOOP(void)
+{
+    time_t          now = time(NULL);
+    int             base, field, src;
+    LOOP_PKT        *merged = &vmultiWork.loopData;
+
+    if (vmultiWork.policy == VMULTI_POLICY_FRESHEST)
+    {
+        base = GetFreshestSource(now);
+    }
+    else
+    {
+        base = GetPrimarySource(now);
+    }
+
+    if (base == ERROR)
+    {
+        // Nothing fresh, keep the last merged packet:
+        return;
+    }
+
+    // Fields not in the merge table come from the base source:
+    *merged = vmultiWork.source[base].loopData;
+
+    for (field = 0; field < VMULTI_FIELD_MAX; field ++)
+    {
+        switch (vmultiWork.policy)
+        {
+            case VMULTI_POLICY_AVERAGE:
+                AverageField(merged, field, now);
+                break;
+
+            case VMULTI_POLICY_PRIORITY:
+                src = vmultiWork.fieldSource[field];
+                if (src != VMULTI_SOURCE_NONE &&
+                    src != base &&
+                    IsSourceFresh(&vmultiWork.source[src], now))
+                {
+                    if (vmultiFields[field].type == VMULTI_FIELD_FLOAT)
+                    {
+                        *fieldFloat(merged, field) =
+                            *fieldFloat(&vmultiWork.source[src].loopData, field);
+                    }
+                    else
+                    {
+                        *fieldUShort(merged, field) =
+                            *fieldUShort(&vmultiWork.source[src].loopData, field);
+                    }
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return;
+}
+
+static void IndicateArchive(void)
+{
+    vmultiWork.IsArchiveReceived = FALSE;
+    vmultiWork.IsArchiveNeeded = FALSE;
+    (*ArchiveIndicator)(&vmultiWork.archiveData);
+
+    // Add all but cumulative:
+    dbsqliteHiLowUpdateArchive(&vmultiWork.archiveData);
+    return;
+}
+
+static int ReadDataFrame(VMULTI_SOURCE *src, int isSync)
+{
+    int             retVal;
+    LOOP_PKT        loopData;
+    LOOP_PKT        hostLoopData;
+    DF_LOOP_EXT     loopExt;
+    ARCHIVE_PKT     archiveRecord;
+    ARCHIVE_PKT     hostRecord;
+    RADSOCK_ID      sockId = (*src->medium.getsocket)(&src->medium);
+
+    /* try to find the start frame */
+    retVal = datafeedSyncStartOfFrame(sockId);
+    switch (retVal)
+    {
+        case ERROR:
+            return ERROR;
+
+        case ERROR_ABORT:
+            return ERROR_ABORT;
+
+        case FALSE:
+            return FALSE;
+
+        case DF_LOOP_PKT_TYPE:
+            /* OK, we have a loop update coming */
+            if ((*src->medium.read)(&src->medium, (void *)&loopData, DF_LOOP_PKT_LENGTH,
+                                    VMULTI_RESPONSE_TIMEOUT)
+                != DF_LOOP_PKT_LENGTH)
+            {
+                return FALSE;
+            }
+
+            // Convert from network byte order:
+            datafeedConvertLOOP_NTOH(&hostLoopData, &loopData);
+
+            // Store it and re-merge:
+            src->loopData = hostLoopData;
+            src->loopTime = time(NULL);
+            src->loopCount ++;
+            MergeLOOP();
+            return DF_LOOP_PKT_TYPE;
+
+        case DF_LOOP_EXT_PKT_TYPE:
+            // the wind windows are computed here from the merged LOOPs, so
+            // just consume the source's:
+            (*src->medium.read)(&src->medium, (void *)&loopExt, sizeof (loopExt),
+                                VMULTI_RESPONSE_TIMEOUT);
+            return FALSE;
+
+        case DF_ARCHIVE_PKT_TYPE:
+            /* OK, we have an archive coming */
+            if ((*src->medium.read)(&src->medium, (void *)&archiveRecord, sizeof(archiveRecord),
+                                    VMULTI_RESPONSE_TIMEOUT)
+                != sizeof (archiveRecord))
+            {
+                return FALSE;
+            }
+
+            // Convert from network byte order:
+            datafeedConvertArchive_NTOH(&hostRecord, &archiveRecord);
+            src->archiveCount ++;
+
+            if (isSync)
+            {
+                // Init catch-up handles the record itself:
+                vmultiWork.archiveData = hostRecord;
+                return DF_ARCHIVE_PKT_TYPE;
+            }
+
+            // De-duplicate by timestamp - the first source to deliver wins:
+            if (hostRecord.dateTime == 0 ||
+                (time_t)hostRecord.dateTime <= vmultiWork.lastArchiveTime)
+            {
+                vmultiWork.duplicateArchives ++;
+                return DF_ARCHIVE_PKT_TYPE;
+            }
+
+            radMsgLog (PRI_STATUS, "VMULTI: RX archive from %s:%d: %s",
+                       src->host, src->port,
+                       ctime((const time_t*)(&hostRecord.dateTime)));
+
+            vmultiWork.archiveData = hostRecord;
+            vmultiWork.lastArchiveTime = hostRecord.dateTime;
+
+            if (vmultiWork.IsArchiveNeeded)
+            {
+                // Indicate it right now:
+                IndicateArchive();
+            }
+            else
+            {
+                // Indicate a new record is ready:
+                vmultiWork.IsArchiveReceived = TRUE;
+            }
+
+            return DF_ARCHIVE_PKT_TYPE;
+    }
+
+    return FALSE;
+}
+
+static void CloseSource(VMULTI_SOURCE *src)
+{
+    if (src->isConnecting)
+    {
+        (*(src->medium.exit))(&src->medium);
+        src->isConnecting = FALSE;
+        return;
+    }
+
+    if (! src->isConnected)
+    {
+        return;
+    }
+
+    radProcessIODeRegisterDescriptorByFd(src->medium.fd);
+    (*(src->medium.exit))(&src->medium);
+    src->isConnected = FALSE;
+    src->loopTime = 0;
+    return;
+}
+
+// schedule a retry of the closed sources (if one is not already due):
+static void ScheduleReconnect(void)
+{
+    if (! vmultiWork.IsReconnectPending)
+    {
+        vmultiWork.IsReconnectPending = TRUE;
+        vmultiWork.reconnectTime = radTimeGetMSSinceEpoch() + VMULTI_RECONNECT_INTERVAL;
+    }
+
+    return;
+}
+
+// arm the interface timer for the next connect check or reconnect:
+static void StartReconnectTimer(void)
+{
+    ULONGLONG       now = radTimeGetMSSinceEpoch();
+    int             i;
+
+    for (i = 0; i < vmultiWork.numSources; i ++)
+    {
+        if (vmultiWork.source[i].isConnecting)
+        {
+            radProcessTimerStart(vmultiWork.reconnectTimer, VMULTI_CONNECT_POLL);
+            return;
+        }
+    }
+
+    if (vmultiWork.IsReconnectPending)
+    {
+        radProcessTimerStart(vmultiWork.reconnectTimer,
+                             ((vmultiWork.reconnectTime > now) ?
+                              (ULONG)(vmultiWork.reconnectTime - now) :
+                              VMULTI_CONNECT_POLL));
+    }
+
+    return;
+}
+
+static void sourceDataCallback(int fd, void *userData)
+{
+    VMULTI_SOURCE   *src = (VMULTI_SOURCE *)userData;
+    int             retVal;
+
+    if (! src->isConnected)
+    {
+        return;
+    }
+
+    retVal = ReadDataFrame(src, FALSE);
+    if (retVal == ERROR || retVal == ERROR_ABORT)
+    {
+        radMsgLog (PRI_HIGH, "VMULTI: source %s:%d lost - will retry",
+                   src->host, src->port);
+        CloseSource(src);
+        if (! vmultiWork.IsReconnectPending)
+        {
+            ScheduleReconnect();
+            StartReconnectTimer();
+        }
+
+        // Re-merge without the lost source:
+        MergeLOOP();
+    }
+
+    return;
+}
+
+// Returns TRUE once connected, FALSE while the connect is still in progress
+// or ERROR if it failed or timed out (the source is then closed):
+static int ConnectSource(VMULTI_SOURCE *src, int msTimeout)
+{
+    int             retVal;
+
+    retVal = ethernetMediumConnectCheck(&src->medium, msTimeout);
+    if (retVal == FALSE &&
+        radTimeGetMSSinceEpoch() - src->connectTime >= VMULTI_CONNECT_TIMEOUT)
+    {
+        radMsgLog (PRI_HIGH, "VMULTI: connect to %s:%d timed out",
+                   src->host, src->port);
+        retVal = ERROR;
+    }
+
+    if (retVal == ERROR)
+    {
+        CloseSource(src);
+        return ERROR;
+    }
+    else if (retVal == FALSE)
+    {
+        return FALSE;
+    }
+
+    src->isConnecting = FALSE;
+    src->isConnected = TRUE;
+    src->loopTime = 0;
+    return TRUE;
+}
+
+// Start a non-blocking connect and wait up to 'msTimeout' for it;
+// returns as ConnectSource:
+static int OpenSource(VMULTI_SOURCE *src, int msTimeout)
+{
+    if (ethernetMediumInit(&src->medium, src->host, src->port) == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "VMULTI: ethernet MediumInit failed for %s:%d",
+                   src->host, src->port);
+        return ERROR;
+    }
+
+    if (ethernetMediumConnectStart(&src->medium) == ERROR)
+    {
+        // ethernetMediumConnectStart already logged it:
+        (*(src->medium.exit))(&src->medium);
+        return ERROR;
+    }
+
+    src->isConnecting = TRUE;
+    src->connectTime = radTimeGetMSSinceEpoch();
+    return ConnectSource(src, msTimeout);
+}
+
+static int RegisterSource(VMULTI_SOURCE *src)
+{
+    // The datafeed is read non-blocking from here on:
+    radSocketSetBlocking((*(src->medium.getsocket))(&src->medium), FALSE);
+
+    if (radProcessIORegisterDescriptor(src->medium.fd, sourceDataCallback, src)
+        == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "VMULTI: IORegDescriptor failed for %s:%d",
+                   src->host, src->port);
+        (*(src->medium.exit))(&src->medium);
+        src->isConnected = FALSE;
+        return ERROR;
+    }
+
+    radMsgLog (PRI_STATUS, "VMULTI: source %s:%d connected", src->host, src->port);
+    return OK;
+}
+
+// Start (or restart) a source that is not connected:
+static void StartSource(VMULTI_SOURCE *src)
+{
+    int             retVal;
+
+    retVal = OpenSource(src, 0);
+    if (retVal == ERROR || (retVal == TRUE && RegisterSource(src) == ERROR))
+    {
+        ScheduleReconnect();
+    }
+
+    return;
+}
+
+static int SyncArchive(WVIEWD_WORK *work, VMULTI_SOURCE *src)
+{
+    time_t          nowtime = time(NULL);
+    ULONG           dateTime;
+    int             retVal, retries = 0;
+
+    // We need to sync up the archive records:
+    while (work->archiveDateTime < nowtime)
+    {
+        // Send the request:
+        // write the frame start:
+        if ((*src->medium.write)(&src->medium,
+                                 (void *)DF_RQST_ARCHIVE_START_FRAME,
+                                 DF_START_FRAME_LENGTH)
+            != DF_START_FRAME_LENGTH)
+        {
+            radMsgLog (PRI_HIGH, "VMULTI: write sync error!");
+            return ERROR;
+        }
+
+        // Send the dateTime:
+        // convert to network byte order:
+        dateTime = htonl(work->archiveDateTime);
+        if ((*src->medium.write)(&src->medium, &dateTime, sizeof(dateTime))
+            != sizeof(dateTime))
+        {
+            radMsgLog (PRI_HIGH, "VMULTI: write data error!");
+            return ERROR;
+        }
+
+        // OK, block waiting on it:
+        retVal = 0;
+        retries = 0;
+        while (retVal != DF_ARCHIVE_PKT_TYPE && retries < VMULTI_MAX_RETRIES)
+        {
+            retVal = ReadDataFrame(src, TRUE);
+            if (retVal == ERROR || retVal == ERROR_ABORT)
+            {
+                radMsgLog (PRI_HIGH, "VMULTI: socket error - aborting!");
+                return ERROR;
+            }
+            retries ++;
+        }
+        if (retries == VMULTI_MAX_RETRIES)
+        {
+            radMsgLog (PRI_HIGH, "VMULTI: archive read failed on %d tries", retries);
+            return ERROR;
+        }
+
+        // Check the time stamp:
+        if (vmultiWork.archiveData.dateTime < work->archiveDateTime)
+        {
+            // No new records:
+            radMsgLog (PRI_STATUS, "VMULTI: all archive records received from %s:%d",
+                       src->host, src->port);
+            work->archiveDateTime = nowtime;
+        }
+        else
+        {
+            // Good stuff:
+            (*ArchiveIndicator)(&vmultiWork.archiveData);
+
+            // If not running yet, add to HILOW database:
+            dbsqliteHiLowStoreArchive(&vmultiWork.archiveData);
+
+            work->archiveDateTime = vmultiWork.archiveData.dateTime;
+            vmultiWork.lastArchiveTime = vmultiWork.archiveData.dateTime;
+        }
+    }
+
+    return OK;
+}
+
+static int ParsePolicy(char *policy)
+{
+    if (policy == NULL || strlen(policy) == 0 || !strcmp(policy, "priority"))
+    {
+        return VMULTI_POLICY_PRIORITY;
+    }
+    else if (!strcmp(policy, "freshest"))
+    {
+        return VMULTI_POLICY_FRESHEST;
+    }
+    else if (!strcmp(policy, "average"))
+    {
+        return VMULTI_POLICY_AVERAGE;
+    }
+
+    radMsgLog (PRI_MEDIUM, "VMULTI: unknown merge policy %s - using priority", policy);
+    return VMULTI_POLICY_PRIORITY;
+}
+
+// "host:port,host:port,..."
+static int ParseHosts(char *hostList)
+{
+    char            *token, *save, *colon;
+    int             port;
+
+    for (token = strtok_r(hostList, ", ", &save);
+         token != NULL && vmultiWork.numSources < VMULTI_MAX_SOURCES;
+         token = strtok_r(NULL, ", ", &save))
+    {
+        colon = strrchr(token, ':');
+        if (colon == NULL)
+        {
+            port = WV_DATAFEED_PORT;
+        }
+        else
+        {
+            *colon = 0;
+            port = atoi(colon + 1);
+        }
+
+        if (strlen(token) == 0 || port <= 0)
+        {
+            radMsgLog (PRI_MEDIUM, "VMULTI: ignoring bad source entry %s", token);
+            continue;
+        }
+
+        wvstrncpy(vmultiWork.source[vmultiWork.numSources].host, token,
+                  sizeof(vmultiWork.source[vmultiWork.numSources].host));
+        vmultiWork.source[vmultiWork.numSources].port = port;
+        vmultiWork.numSources ++;
+    }
+
+    return vmultiWork.numSources;
+}
+
+// "field:sourceNumber,..." (source numbers start at 1)
+static void ParseFieldPriority(char *fieldPriority)
+{
+    char            *token, *save, *colon;
+    int             field, src;
+
+    memset(vmultiWork.fieldSource, VMULTI_SOURCE_NONE, sizeof(vmultiWork.fieldSource));
+    if (fieldPriority == NULL)
+    {
+        return;
+    }
+
+    for (token = strtok_r(fieldPriority, ", ", &save);
+         token != NULL;
+         token = strtok_r(NULL, ", ", &save))
+    {
+        colon = strchr(token, ':');
+        if (colon == NULL)
+        {
+            continue;
+        }
+        *colon = 0;
+        src = atoi(colon + 1) - 1;
+        if (src < 0 || src >= vmultiWork.numSources)
+        {
+            radMsgLog (PRI_MEDIUM, "VMULTI: bad source number for %s", token);
+            continue;
+        }
+
+        for (field = 0; field < VMULTI_FIELD_MAX; field ++)
+        {
+            if (!strcmp(token, vmultiFields[field].name))
+            {
+                vmultiWork.fieldSource[field] = (UCHAR)src;
+                break;
+            }
+        }
+        if (field == VMULTI_FIELD_MAX)
+        {
+            radMsgLog (PRI_MEDIUM, "VMULTI: unknown LOOP field %s", token);
+        }
+    }
+
+    return;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+///////////////////////////////  A P I  ///////////////////////////////////
+int vmultiProtocolConfigure
+(
+    WVIEWD_WORK     *work,
+    char            *hostList,
+    char            *policy,
+    char            *fieldPriority,
+    int             staleSeconds
+)
+{
+    memset (&vmultiWork, 0, sizeof(vmultiWork));
+
+    if (ParseHosts(hostList) == 0)
+    {
+        radMsgLog (PRI_HIGH, "VMULTI: no upstream sources configured!");
+        return ERROR;
+    }
+
+    vmultiWork.policy = ParsePolicy(policy);
+    vmultiWork.staleSeconds = ((staleSeconds > 0) ? staleSeconds : VMULTI_STALE_DEFAULT);
+    ParseFieldPriority(fieldPriority);
+
+    radMsgLog (PRI_STATUS, "VMULTI: %d sources, merge policy %s, stale after %d secs",
+               vmultiWork.numSources,
+               ((vmultiWork.policy == VMULTI_POLICY_AVERAGE) ? "average" :
+                ((vmultiWork.policy == VMULTI_POLICY_FRESHEST) ? "freshest" : "priority")),
+               vmultiWork.staleSeconds);
+
+    return OK;
+}
+
+int vmultiProtocolInit (WVIEWD_WORK *work)
+{
+    int             i, retVal, syncSource = ERROR;
+    VMULTI_SOURCE   *src;
+
+    vmultiWork.reconnectTimer = work->ifTimer;
+
+    // Archive catch-up against the first source that will talk to us:
+    for (i = 0; i < vmultiWork.numSources && syncSource == ERROR; i ++)
+    {
+        src = &vmultiWork.source[i];
+        if (OpenSource(src, VMULTI_CONNECT_TIMEOUT) != TRUE)
+        {
+            CloseSource(src);
+            continue;
+        }
+
+        // The archive sync is done blocking:
+        radSocketSetBlocking((*(src->medium.getsocket))(&src->medium), TRUE);
+
+        // Let the socket settle down:
+        radUtilsSleep (100);
+
+        if (SyncArchive(work, src) == ERROR)
+        {
+            radMsgLog (PRI_HIGH, "VMULTI: archive sync with %s:%d failed",
+                       src->host, src->port);
+            (*(src->medium.exit))(&src->medium);
+            src->isConnected = FALSE;
+            continue;
+        }
+
+        syncSource = i;
+    }
+
+    if (syncSource == ERROR)
+    {
+        radMsgLog (PRI_HIGH, "VMULTI: no upstream source is reachable!");
+        return ERROR;
+    }
+
+    // Reset the archive handling flags:
+    vmultiWork.IsArchiveReceived = FALSE;
+    vmultiWork.IsArchiveNeeded = FALSE;
+    if (vmultiWork.lastArchiveTime < work->archiveDateTime)
+    {
+        vmultiWork.lastArchiveTime = work->archiveDateTime;
+    }
+
+    // Now we need to wait for initial readings from the sync source:
+    src = &vmultiWork.source[syncSource];
+    retVal = 0;
+    radMsgLog (PRI_STATUS, "VMULTI: waiting for initial readings...");
+    while (retVal != DF_LOOP_PKT_TYPE)
+    {
+        retVal = ReadDataFrame(src, TRUE);
+        if (retVal == ERROR || retVal == ERROR_ABORT)
+        {
+            radMsgLog (PRI_HIGH, "VMULTI: socket error - aborting!");
+            (*(src->medium.exit))(&src->medium);
+            src->isConnected = FALSE;
+            return ERROR;
+        }
+        else if (retVal == DF_LOOP_PKT_TYPE)
+        {
+            radMsgLog (PRI_STATUS, "VMULTI: RX LOOP from %s:%d", src->host, src->port);
+        }
+    }
+
+    if (RegisterSource(src) == ERROR)
+    {
+        return ERROR;
+    }
+
+    // Start the rest of the sources, the interface timer finishes them:
+    for (i = 0; i < vmultiWork.numSources; i ++)
+    {
+        if (i != syncSource)
+        {
+            StartSource(&vmultiWork.source[i]);
+        }
+    }
+
+    StartReconnectTimer();
+    return OK;
+}
+
+void vmultiProtocolExit (WVIEWD_WORK *work)
+{
+    int             i;
+    VMULTI_SOURCE   *src;
+
+    for (i = 0; i < vmultiWork.numSources; i ++)
+    {
+        src = &vmultiWork.source[i];
+        radMsgLog (PRI_STATUS, "VMULTI: %s:%d: %lu LOOP, %lu archive packets received",
+                   src->host, src->port, src->loopCount, src->archiveCount);
+        CloseSource(src);
+    }
+
+    radMsgLog (PRI_STATUS, "VMULTI: %lu duplicate archive records discarded",
+               vmultiWork.duplicateArchives);
+    return;
+}
+
+int vmultiProtocolGetReadings(WVIEWD_WORK *work, LOOP_PKT *store)
+{
+    // Use the last merged LOOP data:
+    *store = vmultiWork.loopData;
+
+    return OK;
+}
+
+int vmultiProtocolGetArchive(WVIEWD_WORK *work)
+{
+    if (! vmultiWork.IsArchiveReceived)
+    {
+        vmultiWork.IsArchiveNeeded = TRUE;
+        return FALSE;
+    }
+
+    // Indicate it and reset flags:
+    IndicateArchive();
+
+    return TRUE;
+}
+
+void vmultiProtocolReconnect(WVIEWD_WORK *work)
+{
+    int             i, isRetryDue = TRUE;
+    VMULTI_SOURCE   *src;
+
+    // With connects in progress this may just be a connect check:
+    for (i = 0; i < vmultiWork.numSources; i ++)
+    {
+        if (vmultiWork.source[i].isConnecting)
+        {
+            isRetryDue = (radTimeGetMSSinceEpoch() >= vmultiWork.reconnectTime);
+            break;
+        }
+    }
+
+    if (isRetryDue)
+    {
+        vmultiWork.IsReconnectPending = FALSE;
+    }
+
+    for (i = 0; i < vmultiWork.numSources; i ++)
+    {
+        src = &vmultiWork.source[i];
+        if (src->isConnected)
+        {
+            continue;
+        }
+
+        if (src->isConnecting)
+        {
+            if (ConnectSource(src, 0) == TRUE)
+            {
+                if (RegisterSource(src) == ERROR)
+                {
+                    ScheduleReconnect();
+                }
+            }
+            else if (! src->isConnecting)
+            {
+                ScheduleReconnect();
+            }
+        }
+        else if (isRetryDue)
+        {
+            StartSource(src);
+        }
+    }
+
+    StartReconnectTimer();
+    return;
+}
+
+int vmultiProtocolGetNumConnected(void)
+{
+    int             i, count = 0;
+
+    for (i = 0; i < vmultiWork.numSources; i ++)
+    {
+        if (vmultiWork.source[i].isConnected)
+        {
+            count ++;
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,166 @@
+#ifndef INC_vmultiProtocolh
+#define INC_vmultiProtocolh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        vmultiProtocol.h
+
+  PURPOSE:
+        Provide protocol utilities for multi-upstream virtual station
+        communication.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Keep the reconnect timer
+        10/19/2026      M.S. Teel       2               Non-blocking connects
+
+  NOTES:
+        Each upstream source is a wview datafeed (wvalarmd) server. LOOP
+        packets from all sources are merged per the configured policy and
+        archive records are de-duplicated by timestamp.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <string.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radtimeUtils.h>
+#include <radsocket.h>
+
+/*  ... Local include files
+*/
+#include <datafeed.h>
+#include <datadefs.h>
+#include <dbsqlite.h>
+#include <daemon.h>
+#include <parser.h>
+#include <ethernet.h>
+
+
+#define VMULTI_RESPONSE_TIMEOUT         1000
+#define VMULTI_MAX_RETRIES              5
+#define VMULTI_MAX_SOURCES              8
+#define VMULTI_STALE_DEFAULT            120         // seconds
+#define VMULTI_RECONNECT_INTERVAL       15000       // msecs
+#define VMULTI_CONNECT_TIMEOUT          5000        // msecs
+#define VMULTI_CONNECT_POLL             500         // msecs
+#define VMULTI_SOURCE_NONE              0xFF
+
+// Station-specific configuration items:
+#define VMULTI_PARM_HOSTS               "STATION_VMULTI_HOSTS"
+#define VMULTI_PARM_POLICY              "STATION_VMULTI_POLICY"
+#define VMULTI_PARM_FIELD_PRIORITY      "STATION_VMULTI_FIELD_PRIORITY"
+#define VMULTI_PARM_STALE_SECS          "STATION_VMULTI_STALE_SECS"
+
+// LOOP merge policies:
+typedef enum
+{
+    VMULTI_POLICY_PRIORITY          = 0,    // first listed fresh source wins
+    VMULTI_POLICY_FRESHEST,                 // most recently received wins
+    VMULTI_POLICY_AVERAGE                   // average across fresh sources
+} VMULTI_POLICY;
+
+// Merged LOOP fields:
+typedef enum
+{
+    VMULTI_FIELD_FLOAT              = 0,
+    VMULTI_FIELD_USHORT,
+    VMULTI_FIELD_DIRECTION                  // USHORT degrees, vector averaged
+} VMULTI_FIELD_TYPE;
+
+typedef struct
+{
+    char*               name;
+    int                 offset;
+    VMULTI_FIELD_TYPE   type;
+} VMULTI_FIELD;
+
+#define VMULTI_FIELD_MAX                19
+
+
+// define an upstream source
+typedef struct
+{
+    char            host[WVIEW_STRING1_SIZE];
+    int             port;
+    WVIEW_MEDIUM    medium;
+    int             isConnected;
+    int             isConnecting;
+    ULONGLONG       connectTime;            // msecs, when the connect started
+    LOOP_PKT        loopData;
+    time_t          loopTime;
+    ULONG           loopCount;
+    ULONG           archiveCount;
+} VMULTI_SOURCE;
+
+// define the work area
+typedef struct
+{
+    VMULTI_SOURCE   source[VMULTI_MAX_SOURCES];
+    int             numSources;
+    int             policy;
+    int             staleSeconds;
+    UCHAR           fieldSource[VMULTI_FIELD_MAX];
+    LOOP_PKT        loopData;
+    ARCHIVE_PKT     archiveData;
+    time_t          lastArchiveTime;
+    int             IsArchiveReceived;
+    int             IsArchiveNeeded;
+    int             IsReconnectPending;
+    ULONGLONG       reconnectTime;          // msecs, when to retry closed sources
+    TIMER_ID        reconnectTimer;         // the wviewd ifTimer
+    ULONG           duplicateArchives;
+}
+VMULTI_WORK;
+
+
+// function prototypes
+
+// parse configuration (call before vmultiProtocolInit):
+extern int vmultiProtocolConfigure
+(
+    WVIEWD_WORK     *work,
+    char            *hostList,
+    char            *policy,
+    char            *fieldPriority,
+    int             staleSeconds
+);
+
+// call once during initialization
+extern int vmultiProtocolInit(WVIEWD_WORK *work);
+
+// do cleanup
+extern void vmultiProtocolExit(WVIEWD_WORK *work);
+
+// initiate a synchronous sensor collection:
+extern int vmultiProtocolGetReadings(WVIEWD_WORK *work, LOOP_PKT *store);
+
+// Retrieve archive record or set "need it" flag:
+extern int vmultiProtocolGetArchive(WVIEWD_WORK *work);
+
+// try to restore any lost upstream connections:
+extern void vmultiProtocolReconnect(WVIEWD_WORK *work);
+
+// return the number of connected sources:
+extern int vmultiProtocolGetNumConnected(void);
+
+
+#endif
+
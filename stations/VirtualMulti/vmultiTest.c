@@ -0,0 +1,617 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        vmultiTest.c
+
+  PURPOSE:
+        Test the multi-upstream virtual station protocol against loopback
+        stand-ins for the upstream datafeed servers ("make check").
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Non-blocking connects
+
+  NOTES:
+        Each stand-in is a forked child serving the wvalarmd datafeed
+        protocol on a 127.0.0.1 port. The radlib process I/O and timer
+        calls made by vmultiProtocol.c are replaced here by a local poll
+        loop, so no wviewd, radlib router or database is needed.
+
+        The test checks the archive catch-up, the "average" merge (with a
+        DF_LOOP_EXT frame after each LOOP), archive de-duplication, that a
+        source dropping at runtime arms the reconnect timer and that
+        vmultiProtocolReconnect restores it.
+
+        Connects are finished by the interface timer (expired here by
+        runTimer). Last, a listener whose accept queue is kept full stands
+        in for an unreachable host: startup must not wait on it, LOOPs from
+        the other source must still be read and the connect checks must
+        give up on it after VMULTI_CONNECT_TIMEOUT.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <math.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radtimeUtils.h>
+#include <radprocess.h>
+
+/*  ... Local include files
+*/
+#include <daemon.h>
+#include <vmultiProtocol.h>
+
+
+/*  ... local memory
+*/
+
+#define TEST_SOURCES            3
+#define TEST_LOOP_MS            100         // stand-in LOOP interval
+#define TEST_LIVE_ARCHIVE_LOOP  5           // LOOPs before the live archive
+#define TEST_DROP_SOURCE        2           // this one drops once...
+#define TEST_DROP_LOOP          20          // ...after this many LOOPs
+#define TEST_WAIT_MS            5000
+
+typedef struct
+{
+    int             fd;
+    void            (*callback) (int fd, void *userData);
+    void            *userData;
+} TEST_IO;
+
+static int          testPorts[TEST_SOURCES];
+static pid_t        testPids[TEST_SOURCES];
+static const USHORT testWindDir[TEST_SOURCES] = { 350, 10, 0 };
+static time_t       testSyncTime;
+static time_t       testLiveTime;
+
+static int          testStalledPort;
+static int          testStalledFds[2];      // listener, queued client
+
+static TEST_IO      testIO[TEST_SOURCES];
+static int          testTimerStarts;
+static ULONG        testTimerMsecs;         // 0 if not running
+static TIMER_ID     testTimer;
+static int          testArchives;
+static ULONG        testLastArchive;
+static int          testFailures;
+
+static void testArchiveIndicator (ARCHIVE_PKT *newRecord)
+{
+    testArchives ++;
+    testLastArchive = newRecord->dateTime;
+    return;
+}
+
+
+//  ... stand-ins for what vmultiProtocol.c takes from wviewd and radlib
+
+void (*ArchiveIndicator) (ARCHIVE_PKT *newRecord) = testArchiveIndicator;
+
+int dbsqliteHiLowUpdateArchive (ARCHIVE_PKT *data)
+{
+    return OK;
+}
+
+int dbsqliteHiLowStoreArchive (ARCHIVE_PKT *data)
+{
+    return OK;
+}
+
+void captureMediumAttach (WVIEW_MEDIUM *medium)
+{
+    return;
+}
+
+int wvstrncpy (char *d, const char *s, size_t bufsize)
+{
+    snprintf (d, bufsize, "%s", s);
+    return strlen (s);
+}
+
+int radProcessIORegisterDescriptor
+(
+    int             fd,
+    void            (*processData) (int fd, void *userData),
+    void            *userData
+)
+{
+    int             i;
+
+    for (i = 0; i < TEST_SOURCES; i ++)
+    {
+        if (testIO[i].callback == NULL)
+        {
+            testIO[i].fd        = fd;
+            testIO[i].callback  = processData;
+            testIO[i].userData  = userData;
+            return OK;
+        }
+    }
+
+    return ERROR;
+}
+
+int radProcessIODeRegisterDescriptorByFd (int fd)
+{
+    int             i;
+
+    for (i = 0; i < TEST_SOURCES; i ++)
+    {
+        if (testIO[i].callback != NULL && testIO[i].fd == fd)
+        {
+            testIO[i].callback = NULL;
+            return OK;
+        }
+    }
+
+    return ERROR;
+}
+
+void radProcessTimerStart (TIMER_ID timer, ULONG milliSeconds)
+{
+    if (timer == testTimer)
+    {
+        testTimerStarts ++;
+        testTimerMsecs = milliSeconds;
+    }
+    return;
+}
+
+
+//  ... the upstream stand-ins
+
+static void standInWrite (int fd, const USHORT *frame, void *data, int length)
+{
+    if (write (fd, frame, DF_START_FRAME_LENGTH) != DF_START_FRAME_LENGTH ||
+        write (fd, data, length) != length)
+    {
+        exit (1);
+    }
+    return;
+}
+
+static void standInArchive (int fd, time_t dateTime)
+{
+    ARCHIVE_PKT     record, netRecord;
+
+    memset (&record, 0, sizeof (record));
+    record.dateTime = (ULONG)dateTime;
+    record.interval = 5;
+    datafeedConvertArchive_HTON (&netRecord, &record);
+    standInWrite (fd, DF_ARCHIVE_START_FRAME, &netRecord, sizeof (netRecord));
+    return;
+}
+
+static void standInLOOP (int fd, int index)
+{
+    LOOP_PKT        loop, netLoop;
+    DF_LOOP_EXT     netExt;
+
+    memset (&loop, 0, sizeof (loop));
+    loop.barometer      = 30.0;
+    loop.outTemp        = 60.0 + index;
+    loop.outHumidity    = 50;
+    loop.windSpeed      = 4 + index;
+    loop.windDir        = testWindDir[index];
+    loop.windGust       = 8;
+    loop.windGustDir    = testWindDir[index];
+    loop.twoMinuteAvgWindSpeed = 99;
+    datafeedConvertLOOP_HTON (&netLoop, &loop);
+    datafeedConvertLOOPExt_HTON (&netExt, &loop);
+    standInWrite (fd, DF_LOOP_START_FRAME, &netLoop, DF_LOOP_PKT_LENGTH);
+    standInWrite (fd, DF_LOOP_EXT_START_FRAME, &netExt, sizeof (netExt));
+    return;
+}
+
+static void standInRun (int listenFd, int index)
+{
+    int             fd, connections = 0, loops;
+    UCHAR           request[DF_START_FRAME_LENGTH + sizeof (ULONG)];
+    ULONG           dateTime;
+    ULONGLONG       lastLoop;
+    struct pollfd   pfd;
+
+    signal (SIGPIPE, SIG_IGN);
+
+    for (;;)
+    {
+        if ((fd = accept (listenFd, NULL, NULL)) < 0)
+        {
+            exit (1);
+        }
+        connections ++;
+        loops = 0;
+        lastLoop = radTimeGetMSSinceEpoch ();
+
+        for (;;)
+        {
+            pfd.fd      = fd;
+            pfd.events  = POLLIN;
+            pfd.revents = 0;
+            if (poll (&pfd, 1, 10) > 0)
+            {
+                if (recv (fd, request, sizeof (request), MSG_WAITALL) != sizeof (request))
+                {
+                    break;
+                }
+                if (! memcmp (request, DF_RQST_ARCHIVE_START_FRAME, DF_START_FRAME_LENGTH))
+                {
+                    // the catch-up has one record, then "no more":
+                    memcpy (&dateTime, &request[DF_START_FRAME_LENGTH], sizeof (dateTime));
+                    dateTime = ntohl (dateTime);
+                    standInArchive (fd, ((time_t)dateTime < testSyncTime) ? testSyncTime : 0);
+                }
+            }
+
+            if (radTimeGetMSSinceEpoch () - lastLoop < TEST_LOOP_MS)
+            {
+                continue;
+            }
+            lastLoop = radTimeGetMSSinceEpoch ();
+
+            standInLOOP (fd, index);
+            loops ++;
+
+            // every source delivers the same live archive record:
+            if (loops == TEST_LIVE_ARCHIVE_LOOP)
+            {
+                standInArchive (fd, testLiveTime);
+            }
+
+            if (index == TEST_DROP_SOURCE && connections == 1 && loops == TEST_DROP_LOOP)
+            {
+                break;
+            }
+        }
+
+        close (fd);
+    }
+}
+
+static int standInStart (int index)
+{
+    int                 fd, on = 1;
+    struct sockaddr_in  addr;
+    socklen_t           length = sizeof (addr);
+
+    fd = socket (AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return ERROR;
+    }
+    setsockopt (fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof (on));
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_addr.s_addr    = htonl (INADDR_LOOPBACK);
+    addr.sin_port           = 0;
+    if (bind (fd, (struct sockaddr *)&addr, sizeof (addr)) < 0 ||
+        listen (fd, 4) < 0 ||
+        getsockname (fd, (struct sockaddr *)&addr, &length) < 0)
+    {
+        close (fd);
+        return ERROR;
+    }
+    testPorts[index] = ntohs (addr.sin_port);
+
+    testPids[index] = fork ();
+    if (testPids[index] < 0)
+    {
+        close (fd);
+        return ERROR;
+    }
+    else if (testPids[index] == 0)
+    {
+        standInRun (fd, index);
+        exit (0);
+    }
+
+    close (fd);
+    return OK;
+}
+
+static void standInStop (void)
+{
+    int             i;
+
+    for (i = 0; i < TEST_SOURCES; i ++)
+    {
+        if (testPids[i] > 0)
+        {
+            kill (testPids[i], SIGTERM);
+            waitpid (testPids[i], NULL, 0);
+        }
+    }
+    return;
+}
+
+
+// a listener with a full accept queue - new connects stay in progress:
+static int stalledStart (void)
+{
+    int                 fd;
+    struct sockaddr_in  addr;
+    socklen_t           length = sizeof (addr);
+
+    testStalledFds[0] = socket (AF_INET, SOCK_STREAM, 0);
+    if (testStalledFds[0] < 0)
+    {
+        return ERROR;
+    }
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_addr.s_addr    = htonl (INADDR_LOOPBACK);
+    addr.sin_port           = 0;
+    if (bind (testStalledFds[0], (struct sockaddr *)&addr, sizeof (addr)) < 0 ||
+        listen (testStalledFds[0], 0) < 0 ||
+        getsockname (testStalledFds[0], (struct sockaddr *)&addr, &length) < 0)
+    {
+        return ERROR;
+    }
+    testStalledPort = ntohs (addr.sin_port);
+
+    // fill the queue (never accepted):
+    fd = socket (AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || connect (fd, (struct sockaddr *)&addr, sizeof (addr)) < 0)
+    {
+        return ERROR;
+    }
+    testStalledFds[1] = fd;
+
+    return OK;
+}
+
+static void stalledStop (void)
+{
+    close (testStalledFds[1]);
+    close (testStalledFds[0]);
+    return;
+}
+
+
+//  ... the local stand-in for the wviewd process I/O loop
+
+static void runIO (int msecs, int (*isDone) (void))
+{
+    ULONGLONG       start = radTimeGetMSSinceEpoch ();
+    struct pollfd   pfd[TEST_SOURCES];
+    TEST_IO         *io[TEST_SOURCES];
+    int             i, count;
+
+    while (radTimeGetMSSinceEpoch () - start < (ULONGLONG)msecs)
+    {
+        if (isDone != NULL && (*isDone) ())
+        {
+            return;
+        }
+
+        for (i = 0, count = 0; i < TEST_SOURCES; i ++)
+        {
+            if (testIO[i].callback != NULL)
+            {
+                pfd[count].fd       = testIO[i].fd;
+                pfd[count].events   = POLLIN;
+                pfd[count].revents  = 0;
+                io[count]           = &testIO[i];
+                count ++;
+            }
+        }
+
+        if (poll (pfd, count, 10) <= 0)
+        {
+            continue;
+        }
+
+        for (i = 0; i < count; i ++)
+        {
+            // a callback may deregister a descriptor:
+            if (pfd[i].revents != 0 && io[i]->callback != NULL && io[i]->fd == pfd[i].fd)
+            {
+                (*io[i]->callback) (io[i]->fd, io[i]->userData);
+            }
+        }
+    }
+
+    return;
+}
+
+static int isSourceDropped (void)
+{
+    return (vmultiProtocolGetNumConnected () < TEST_SOURCES);
+}
+
+// run the I/O loop, expiring the interface timer when it is due, until
+// 'isDone' or the timer is left at the reconnect interval (or stopped):
+static void runTimer (WVIEWD_WORK *work, int msecs, int (*isDone) (void))
+{
+    ULONGLONG       start = radTimeGetMSSinceEpoch ();
+    ULONG           timerMsecs;
+
+    while (radTimeGetMSSinceEpoch () - start < (ULONGLONG)msecs)
+    {
+        if ((isDone != NULL && (*isDone) ()) ||
+            testTimerMsecs == 0 || testTimerMsecs > VMULTI_CONNECT_POLL)
+        {
+            return;
+        }
+
+        timerMsecs = testTimerMsecs;
+        runIO (timerMsecs, NULL);
+        testTimerMsecs = 0;
+        vmultiProtocolReconnect (work);
+    }
+
+    return;
+}
+
+static int isAllConnected (void)
+{
+    return (vmultiProtocolGetNumConnected () == TEST_SOURCES);
+}
+
+static void check (int condition, char *what)
+{
+    printf ("vmultiTest: %-50s %s\n", what, (condition ? "PASS" : "FAIL"));
+    if (! condition)
+    {
+        testFailures ++;
+    }
+    return;
+}
+
+static void checkReadings (float outTemp, char *what)
+{
+    LOOP_PKT        loop;
+
+    vmultiProtocolGetReadings (NULL, &loop);
+    check (fabs (loop.outTemp - outTemp) < 0.01, what);
+    return;
+}
+
+
+int main (int argc, char *argv[])
+{
+    static WVIEWD_WORK  work;
+    static char         timerTag;
+    char                hosts[256];
+    LOOP_PKT            loop;
+    ULONGLONG           initTime;
+    int                 i;
+
+    testSyncTime = time (NULL) - 600;
+    testLiveTime = time (NULL) + 300;
+
+    for (i = 0; i < TEST_SOURCES; i ++)
+    {
+        if (standInStart (i) == ERROR)
+        {
+            printf ("vmultiTest: cannot start stand-in %d: %s\n", i, strerror (errno));
+            standInStop ();
+            return 1;
+        }
+    }
+
+    snprintf (hosts, sizeof (hosts), "127.0.0.1:%d,127.0.0.1:%d,127.0.0.1:%d",
+              testPorts[0], testPorts[1], testPorts[2]);
+
+    memset (&work, 0, sizeof (work));
+    testTimer = (TIMER_ID)&timerTag;
+    work.ifTimer = testTimer;
+    work.archiveDateTime = testSyncTime - 600;
+
+    if (vmultiProtocolConfigure (&work, hosts, "average", NULL, 30) == ERROR ||
+        vmultiProtocolInit (&work) == ERROR)
+    {
+        printf ("vmultiTest: vmultiProtocolInit failed\n");
+        standInStop ();
+        return 1;
+    }
+
+    check (testArchives == 1 && testLastArchive == (ULONG)testSyncTime,
+           "archive catch-up from the first source");
+
+    // the timer finishes the other connects:
+    runTimer (&work, TEST_WAIT_MS, isAllConnected);
+    check (vmultiProtocolGetNumConnected () == TEST_SOURCES, "all sources connected");
+    check (testTimerMsecs == 0, "no reconnect pending");
+
+    // let every source deliver a few LOOPs and the live archive:
+    runIO ((TEST_LIVE_ARCHIVE_LOOP + 3) * TEST_LOOP_MS, NULL);
+    checkReadings (61.0, "outTemp averaged across 3 sources");
+    vmultiProtocolGetReadings (NULL, &loop);
+    check (loop.windSpeed == 5, "windSpeed averaged");
+    check (loop.windDir == 0 && loop.windGustDir == 0, "windDir vector averaged across north");
+    check (loop.twoMinuteAvgWindSpeed == 0, "LOOP extension frames skipped");
+
+    check (vmultiProtocolGetArchive (&work) == TRUE &&
+           testArchives == 2 && testLastArchive == (ULONG)testLiveTime,
+           "live archive indicated once");
+    check (vmultiProtocolGetArchive (&work) == FALSE && testArchives == 2,
+           "duplicate archives discarded");
+
+    // source 3 goes away at runtime:
+    testTimerStarts = 0;
+    runIO (TEST_WAIT_MS, isSourceDropped);
+    check (vmultiProtocolGetNumConnected () == TEST_SOURCES - 1, "dropped source detected");
+    check (testTimerStarts == 1 && testTimerMsecs > VMULTI_CONNECT_POLL &&
+           testTimerMsecs <= VMULTI_RECONNECT_INTERVAL,
+           "reconnect timer armed on the drop");
+    checkReadings (60.5, "outTemp averaged across the remaining 2");
+
+    // the timer expiry, then the connect checks:
+    testTimerMsecs = 0;
+    vmultiProtocolReconnect (&work);
+    runTimer (&work, TEST_WAIT_MS, isAllConnected);
+    check (vmultiProtocolGetNumConnected () == TEST_SOURCES, "dropped source reconnected");
+    runTimer (&work, TEST_WAIT_MS, NULL);
+    check (testTimerMsecs == 0, "no reconnect pending after it");
+    runIO ((TEST_LIVE_ARCHIVE_LOOP + 3) * TEST_LOOP_MS, NULL);
+    checkReadings (61.0, "outTemp averaged across 3 sources again");
+    check (testArchives == 2, "replayed live archive discarded");
+
+    vmultiProtocolExit (&work);
+
+    // a source that never answers must not hold up startup or the I/O loop:
+    if (stalledStart () == ERROR)
+    {
+        printf ("vmultiTest: cannot start the stalled listener: %s\n", strerror (errno));
+        standInStop ();
+        return 1;
+    }
+    memset (testIO, 0, sizeof (testIO));
+    snprintf (hosts, sizeof (hosts), "127.0.0.1:%d,127.0.0.1:%d",
+              testPorts[0], testStalledPort);
+    testTimerMsecs = 0;
+    initTime = radTimeGetMSSinceEpoch ();
+    if (vmultiProtocolConfigure (&work, hosts, "average", NULL, 30) == ERROR ||
+        vmultiProtocolInit (&work) == ERROR)
+    {
+        printf ("vmultiTest: vmultiProtocolInit failed\n");
+        stalledStop ();
+        standInStop ();
+        return 1;
+    }
+    initTime = radTimeGetMSSinceEpoch () - initTime;
+    check (initTime < VMULTI_CONNECT_TIMEOUT && testTimerMsecs == VMULTI_CONNECT_POLL,
+           "startup does not wait on the stalled source");
+
+    runTimer (&work, VMULTI_CONNECT_TIMEOUT + TEST_WAIT_MS, NULL);
+    check (vmultiProtocolGetNumConnected () == 1 &&
+           testTimerMsecs > VMULTI_CONNECT_POLL &&
+           testTimerMsecs <= VMULTI_RECONNECT_INTERVAL,
+           "stalled connect timed out, reconnect pending");
+    checkReadings (60.0, "LOOPs read while the connect was stalled");
+
+    vmultiProtocolExit (&work);
+    stalledStop ();
+    standInStop ();
+
+    printf ("vmultiTest: %d failures\n", testFailures);
+    return ((testFailures == 0) ? 0 : 1);
+}
@@ -0,0 +1,759 @@
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        capture.c
+
+  PURPOSE:
+        Provide record and replay of station medium traffic.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               64-bit record deltas
+        10/19/2026      M.S. Teel       2               Replay socket for getsocket
+
+  NOTES:
+        Record mode wraps the methods of an initialized medium so every
+        read and write is logged (with its timestamp) after the real
+        transfer completes.
+
+        Replay mode replaces the medium methods: reads are satisfied from
+        the capture file at the recorded (or scaled) time, writes are
+        checked against the recorded writes. A socket pair stands in for the
+        device descriptor so the daemon I/O loop still sees data become
+        available; its read end is also what getsocket returns, so drivers
+        can still set socket options on it (no data is read from it).
+
+        See capture.h for the file format.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <sys/types.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+
+/*  ... Library include files
+*/
+#include <radmsgLog.h>
+#include <radsysutils.h>
+
+/*  ... Local include files
+*/
+#include <services.h>
+#include <capture.h>
+
+/*  ... global memory declarations
+*/
+
+/*  ... local memory
+*/
+static CAPTURE_WORK     captureWork;
+
+
+//////////////////////////////////////////////////////////////////////////////
+//  ... common utilities
+//////////////////////////////////////////////////////////////////////////////
+
+static ULONGLONG GetUsecs (void)
+{
+    struct timeval      tv;
+
+    gettimeofday (&tv, NULL);
+    return (((ULONGLONG)tv.tv_sec * 1000000ULL) + (ULONGLONG)tv.tv_usec);
+}
+
+static void PutUsecs (UCHAR *bfr, ULONGLONG value)
+{
+    ULONG           tempLong;
+
+    tempLong = htonl((ULONG)(value >> 32));
+    memcpy (&bfr[0], &tempLong, 4);
+    tempLong = htonl((ULONG)(value & 0xFFFFFFFFULL));
+    memcpy (&bfr[4], &tempLong, 4);
+}
+
+static ULONGLONG GetRecordUsecs (UCHAR *bfr)
+{
+    ULONG           high, low;
+
+    memcpy (&high, &bfr[0], 4);
+    memcpy (&low, &bfr[4], 4);
+    return (((ULONGLONG)ntohl(high) << 32) | (ULONGLONG)ntohl(low));
+}
+
+static int isReadOp (int op)
+{
+    return (op == CAPTURE_OP_READ ||
+            op == CAPTURE_OP_USBHID_READ ||
+            op == CAPTURE_OP_USBHID_READ_SPECIAL);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//  ... record methods
+//////////////////////////////////////////////////////////////////////////////
+
+static int RecordOpen (int mediumType)
+{
+    UCHAR           header[CAPTURE_FILE_HEADER_LENGTH];
+    ULONG           tempLong;
+    USHORT          tempShort;
+    struct timeval  tv;
+
+    if (captureWork.records > 0)
+    {
+        // the station re-opened its medium, keep appending:
+        captureWork.file = fopen (captureWork.filePath, "a");
+        return ((captureWork.file == NULL) ? ERROR : OK);
+    }
+
+    captureWork.file = fopen (captureWork.filePath, "w");
+    if (captureWork.file == NULL)
+    {
+        radMsgLog (PRI_HIGH, "capture: cannot create %s: %s",
+                   captureWork.filePath, strerror(errno));
+        return ERROR;
+    }
+
+    gettimeofday (&tv, NULL);
+    captureWork.lastTime = ((ULONGLONG)tv.tv_sec * 1000000ULL) + tv.tv_usec;
+
+    memset (header, 0, sizeof(header));
+    memcpy (&header[0], CAPTURE_FILE_MAGIC, 8);
+    tempLong = htonl((ULONG)tv.tv_sec);
+    memcpy (&header[8], &tempLong, 4);
+    tempLong = htonl((ULONG)tv.tv_usec);
+    memcpy (&header[12], &tempLong, 4);
+    tempShort = htons((USHORT)mediumType);
+    memcpy (&header[16], &tempShort, 2);
+
+    if (fwrite (header, sizeof(header), 1, captureWork.file) != 1)
+    {
+        radMsgLog (PRI_HIGH, "capture: header write failed: %s", strerror(errno));
+        fclose (captureWork.file);
+        captureWork.file = NULL;
+        return ERROR;
+    }
+
+    radMsgLog (PRI_STATUS, "capture: recording medium traffic to %s",
+               captureWork.filePath);
+    return OK;
+}
+
+static void RecordClose (void)
+{
+    if (captureWork.file != NULL)
+    {
+        fclose (captureWork.file);
+        captureWork.file = NULL;
+        radMsgLog (PRI_STATUS, "capture: %lu records written to %s",
+                   captureWork.records, captureWork.filePath);
+    }
+
+    return;
+}
+
+static void RecordWrite (int op, int length, int result, void *data)
+{
+    UCHAR           header[CAPTURE_RECORD_HEADER_LENGTH];
+    ULONGLONG       now;
+    USHORT          tempShort;
+
+    if (captureWork.file == NULL)
+    {
+        return;
+    }
+
+    now = GetUsecs();
+    PutUsecs (&header[0], now - captureWork.lastTime);
+    captureWork.lastTime = now;
+
+    header[8] = (UCHAR)op;
+    header[9] = 0;
+    tempShort = htons((USHORT)length);
+    memcpy (&header[10], &tempShort, 2);
+    tempShort = htons((USHORT)((short)result));
+    memcpy (&header[12], &tempShort, 2);
+
+    if (fwrite (header, sizeof(header), 1, captureWork.file) != 1 ||
+        (result > 0 && data != NULL &&
+         fwrite (data, result, 1, captureWork.file) != 1))
+    {
+        radMsgLog (PRI_HIGH, "capture: write failed: %s - stopping capture",
+                   strerror(errno));
+        fclose (captureWork.file);
+        captureWork.file = NULL;
+        return;
+    }
+
+    // station traffic is light, keep the file current in case we die:
+    fflush (captureWork.file);
+    captureWork.records ++;
+    return;
+}
+
+static int recordInit (WVIEW_MEDIUM *med, char *deviceName)
+{
+    if ((*captureWork.original.init) (med, deviceName) == ERROR)
+    {
+        return ERROR;
+    }
+
+    RecordOpen (med->type);
+    return OK;
+}
+
+static void recordExit (WVIEW_MEDIUM *med)
+{
+    RecordClose ();
+    captureWork.isAttached = FALSE;
+    (*captureWork.original.exit) (med);
+    return;
+}
+
+static int recordRead (WVIEW_MEDIUM *med, void *bfr, int len, int timeout)
+{
+    int             retVal;
+
+    retVal = (*captureWork.original.read) (med, bfr, len, timeout);
+    RecordWrite (CAPTURE_OP_READ, len, retVal, bfr);
+    return retVal;
+}
+
+static int recordWrite (WVIEW_MEDIUM *med, void *buffer, int length)
+{
+    int             retVal;
+
+    retVal = (*captureWork.original.write) (med, buffer, length);
+    RecordWrite (CAPTURE_OP_WRITE, length, retVal, buffer);
+    return retVal;
+}
+
+static void recordFlush (WVIEW_MEDIUM *med, int queue)
+{
+    (*captureWork.original.flush) (med, queue);
+    RecordWrite (CAPTURE_OP_FLUSH, queue, 0, NULL);
+    return;
+}
+
+static void recordDrain (WVIEW_MEDIUM *med)
+{
+    (*captureWork.original.txdrain) (med);
+    RecordWrite (CAPTURE_OP_TXDRAIN, 0, 0, NULL);
+    return;
+}
+
+static int recordUsbhidInit (WVIEW_MEDIUM *med)
+{
+    if ((*captureWork.original.usbhidInit) (med) == ERROR)
+    {
+        return ERROR;
+    }
+
+    RecordOpen (med->type);
+    return OK;
+}
+
+static void recordUsbhidExit (WVIEW_MEDIUM *med)
+{
+    RecordClose ();
+    captureWork.isAttached = FALSE;
+    (*captureWork.original.usbhidExit) (med);
+    return;
+}
+
+static int recordUsbhidRead (WVIEW_MEDIUM *med, void *bfr, int len, int timeout)
+{
+    int             retVal;
+
+    retVal = (*captureWork.original.usbhidRead) (med, bfr, len, timeout);
+    RecordWrite (CAPTURE_OP_USBHID_READ, len, retVal, bfr);
+    return retVal;
+}
+
+static int recordUsbhidReadSpecial (WVIEW_MEDIUM *med, void *bfr, int len, int timeout)
+{
+    int             retVal;
+
+    retVal = (*captureWork.original.usbhidReadSpecial) (med, bfr, len, timeout);
+    RecordWrite (CAPTURE_OP_USBHID_READ_SPECIAL, len, retVal, bfr);
+    return retVal;
+}
+
+static int recordUsbhidWrite (WVIEW_MEDIUM *med, void *buffer, int length)
+{
+    int             retVal;
+
+    retVal = (*captureWork.original.usbhidWrite) (med, buffer, length);
+    RecordWrite (CAPTURE_OP_USBHID_WRITE, length, retVal, buffer);
+    return retVal;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////
+//  ... replay methods
+//////////////////////////////////////////////////////////////////////////////
+
+// Read the next record header (if not already buffered):
+static int ReplayPeek (void)
+{
+    UCHAR           header[CAPTURE_RECORD_HEADER_LENGTH];
+    UCHAR           *fields;
+    ULONG           tempLong;
+    USHORT          tempShort;
+
+    if (captureWork.haveNext)
+    {
+        return OK;
+    }
+    if (captureWork.file == NULL || captureWork.isComplete)
+    {
+        return ERROR;
+    }
+
+    if (fread (header, captureWork.recordHeaderLength, 1, captureWork.file) != 1)
+    {
+        radMsgLog (PRI_STATUS, "capture: replay complete: %lu records, %lu divergences",
+                   captureWork.records, captureWork.divergences);
+        captureWork.isComplete = TRUE;
+        return ERROR;
+    }
+
+    if (captureWork.recordHeaderLength == CAPTURE_RECORD_HEADER_LENGTH_V1)
+    {
+        memcpy (&tempLong, &header[0], 4);
+        captureWork.next.delta = ntohl(tempLong);
+        fields = &header[4];
+    }
+    else
+    {
+        captureWork.next.delta = GetRecordUsecs (&header[0]);
+        fields = &header[8];
+    }
+
+    captureWork.next.op = fields[0];
+    memcpy (&tempShort, &fields[2], 2);
+    captureWork.next.length = ntohs(tempShort);
+    memcpy (&tempShort, &fields[4], 2);
+    captureWork.next.result = (short)ntohs(tempShort);
+    captureWork.haveNext = TRUE;
+    return OK;
+}
+
+// Consume the buffered record - data is copied to 'bfr' up to 'len' bytes:
+static void ReplayConsume (void *bfr, int len)
+{
+    UCHAR           discard[256];
+    int             dataLen = captureWork.next.result, chunk;
+
+    captureWork.haveNext = FALSE;
+    captureWork.records ++;
+    captureWork.scheduleTime += captureWork.next.delta;
+
+    if (dataLen <= 0)
+    {
+        return;
+    }
+
+    if (bfr != NULL && len > 0)
+    {
+        chunk = (dataLen < len) ? dataLen : len;
+        if (fread (bfr, chunk, 1, captureWork.file) != 1)
+        {
+            captureWork.isComplete = TRUE;
+            return;
+        }
+        dataLen -= chunk;
+    }
+
+    while (dataLen > 0)
+    {
+        chunk = (dataLen < (int)sizeof(discard)) ? dataLen : (int)sizeof(discard);
+        if (fread (discard, chunk, 1, captureWork.file) != 1)
+        {
+            captureWork.isComplete = TRUE;
+            return;
+        }
+        dataLen -= chunk;
+    }
+
+    return;
+}
+
+// Hold off until the buffered record is due:
+static void ReplayWait (void)
+{
+    ULONGLONG       due, now;
+    struct timespec wait;
+
+    if (captureWork.speed <= 0)
+    {
+        return;
+    }
+
+    due = captureWork.startTime;
+    due += (ULONGLONG)((double)(captureWork.scheduleTime + captureWork.next.delta) /
+                       captureWork.speed);
+    now = GetUsecs();
+    if (due > now)
+    {
+        // gaps can be longer than usleep allows:
+        wait.tv_sec  = (time_t)((due - now) / 1000000ULL);
+        wait.tv_nsec = (long)(((due - now) % 1000000ULL) * 1000ULL);
+        while (nanosleep (&wait, &wait) != 0 && errno == EINTR)
+        {
+        }
+    }
+
+    return;
+}
+
+// Keep the pipe readable while the next record is a read:
+static void ReplaySignal (void)
+{
+    UCHAR           dummy = 0;
+    int             readPending;
+
+    readPending = (ReplayPeek() == OK && isReadOp(captureWork.next.op));
+
+    if (readPending && ! captureWork.isPending)
+    {
+        if (write (captureWork.pipeFds[1], &dummy, 1) == 1)
+        {
+            captureWork.isPending = TRUE;
+        }
+    }
+    else if (! readPending && captureWork.isPending)
+    {
+        if (read (captureWork.pipeFds[0], &dummy, 1) == 1)
+        {
+            captureWork.isPending = FALSE;
+        }
+    }
+
+    return;
+}
+
+static int ReplayOpen (WVIEW_MEDIUM *med)
+{
+    UCHAR           header[CAPTURE_FILE_HEADER_LENGTH];
+
+    captureWork.file = fopen (captureWork.filePath, "r");
+    if (captureWork.file == NULL)
+    {
+        radMsgLog (PRI_HIGH, "capture: cannot open %s: %s",
+                   captureWork.filePath, strerror(errno));
+        return ERROR;
+    }
+
+    if (fread (header, sizeof(header), 1, captureWork.file) != 1)
+    {
+        header[0] = 0;
+    }
+
+    if (memcmp (header, CAPTURE_FILE_MAGIC, 8) == 0)
+    {
+        captureWork.recordHeaderLength = CAPTURE_RECORD_HEADER_LENGTH;
+    }
+    else if (memcmp (header, CAPTURE_FILE_MAGIC_V1, 8) == 0)
+    {
+        captureWork.recordHeaderLength = CAPTURE_RECORD_HEADER_LENGTH_V1;
+    }
+    else
+    {
+        radMsgLog (PRI_HIGH, "capture: %s is not a capture file", captureWork.filePath);
+        fclose (captureWork.file);
+        captureWork.file = NULL;
+        return ERROR;
+    }
+
+    if (socketpair (AF_UNIX, SOCK_STREAM, 0, captureWork.pipeFds) != 0)
+    {
+        radMsgLog (PRI_HIGH, "capture: socketpair failed: %s", strerror(errno));
+        fclose (captureWork.file);
+        captureWork.file = NULL;
+        return ERROR;
+    }
+
+    // the socket ID handed out by getsocket (radlib has no call to adopt a
+    // descriptor; ReplayClose closes it and frees this):
+    captureWork.sockId = (RADSOCK_ID) malloc (sizeof (*captureWork.sockId));
+    if (captureWork.sockId == NULL)
+    {
+        close (captureWork.pipeFds[0]);
+        close (captureWork.pipeFds[1]);
+        fclose (captureWork.file);
+        captureWork.file = NULL;
+        return ERROR;
+    }
+    memset (captureWork.sockId, 0, sizeof (*captureWork.sockId));
+    captureWork.sockId->sockfd = captureWork.pipeFds[0];
+
+    med->fd = captureWork.pipeFds[0];
+    captureWork.isPending = FALSE;
+    captureWork.haveNext = FALSE;
+    captureWork.isComplete = FALSE;
+    captureWork.records = 0;
+    captureWork.divergences = 0;
+    captureWork.scheduleTime = 0;
+    captureWork.startTime = GetUsecs();
+
+    ReplaySignal ();
+
+    radMsgLog (PRI_STATUS, "capture: replaying %s at %s",
+               captureWork.filePath,
+               ((captureWork.speed <= 0) ? "full speed" : "recorded time scale"));
+    return OK;
+}
+
+static void ReplayClose (WVIEW_MEDIUM *med)
+{
+    if (captureWork.file != NULL)
+    {
+        fclose (captureWork.file);
+        captureWork.file = NULL;
+        close (captureWork.pipeFds[0]);
+        close (captureWork.pipeFds[1]);
+        free (captureWork.sockId);
+        captureWork.sockId = NULL;
+    }
+
+    // let the original exit clean up its work area without a device:
+    med->fd = -1;
+    captureWork.isAttached = FALSE;
+    return;
+}
+
+static int ReplayRead (int op, void *bfr, int len)
+{
+    int             retVal;
+
+    // skip anything the driver did not repeat:
+    while (ReplayPeek() == OK && captureWork.next.op != op)
+    {
+        captureWork.divergences ++;
+        ReplayConsume (NULL, 0);
+    }
+
+    if (ReplayPeek() == ERROR)
+    {
+        ReplaySignal ();
+        return ERROR;
+    }
+
+    ReplayWait ();
+
+    retVal = captureWork.next.result;
+    if (retVal > len)
+    {
+        captureWork.divergences ++;
+        retVal = len;
+    }
+    ReplayConsume (bfr, len);
+
+    ReplaySignal ();
+    return retVal;
+}
+
+static int ReplayWrite (int op, int length)
+{
+    int             retVal = length;
+
+    if (ReplayPeek() == OK && captureWork.next.op == op)
+    {
+        if (captureWork.next.length != length)
+        {
+            captureWork.divergences ++;
+        }
+        retVal = captureWork.next.result;
+        ReplayConsume (NULL, 0);
+    }
+    else
+    {
+        // driver wrote something the capture does not have:
+        captureWork.divergences ++;
+    }
+
+    ReplaySignal ();
+    return retVal;
+}
+
+static void ReplaySkip (int op)
+{
+    if (ReplayPeek() == OK && captureWork.next.op == op)
+    {
+        ReplayConsume (NULL, 0);
+        ReplaySignal ();
+    }
+
+    return;
+}
+
+static int replayInit (WVIEW_MEDIUM *med, char *deviceName)
+{
+    return ReplayOpen (med);
+}
+
+static void replayExit (WVIEW_MEDIUM *med)
+{
+    ReplayClose (med);
+    (*captureWork.original.exit) (med);
+    return;
+}
+
+static int replayRead (WVIEW_MEDIUM *med, void *bfr, int len, int timeout)
+{
+    return ReplayRead (CAPTURE_OP_READ, bfr, len);
+}
+
+static int replayWrite (WVIEW_MEDIUM *med, void *buffer, int length)
+{
+    return ReplayWrite (CAPTURE_OP_WRITE, length);
+}
+
+static void replayFlush (WVIEW_MEDIUM *med, int queue)
+{
+    ReplaySkip (CAPTURE_OP_FLUSH);
+    return;
+}
+
+static void replayDrain (WVIEW_MEDIUM *med)
+{
+    ReplaySkip (CAPTURE_OP_TXDRAIN);
+    return;
+}
+
+static RADSOCK_ID replayGetSocket (WVIEW_MEDIUM *med)
+{
+    return captureWork.sockId;
+}
+
+static int replayUsbhidInit (WVIEW_MEDIUM *med)
+{
+    return ReplayOpen (med);
+}
+
+static void replayUsbhidExit (WVIEW_MEDIUM *med)
+{
+    ReplayClose (med);
+    (*captureWork.original.usbhidExit) (med);
+    return;
+}
+
+static int replayUsbhidRead (WVIEW_MEDIUM *med, void *bfr, int len, int timeout)
+{
+    return ReplayRead (CAPTURE_OP_USBHID_READ, bfr, len);
+}
+
+static int replayUsbhidReadSpecial (WVIEW_MEDIUM *med, void *bfr, int len, int timeout)
+{
+    return ReplayRead (CAPTURE_OP_USBHID_READ_SPECIAL, bfr, len);
+}
+
+static int replayUsbhidWrite (WVIEW_MEDIUM *med, void *buffer, int length)
+{
+    return ReplayWrite (CAPTURE_OP_USBHID_WRITE, length);
+}
+
+
+// ... ----- API methods -----
+
+void captureConfigure
+(
+    WVIEW_MEDIUM    *stationMedium,
+    char            *captureFile,
+    char            *replayFile,
+    float           replaySpeed
+)
+{
+    memset (&captureWork, 0, sizeof(captureWork));
+    captureWork.station = stationMedium;
+
+    if (replayFile != NULL && strlen(replayFile) > 0)
+    {
+        captureWork.mode = CAPTURE_MODE_REPLAY;
+        wvstrncpy (captureWork.filePath, replayFile, sizeof(captureWork.filePath));
+        captureWork.speed = replaySpeed;
+    }
+    else if (captureFile != NULL && strlen(captureFile) > 0)
+    {
+        captureWork.mode = CAPTURE_MODE_RECORD;
+        wvstrncpy (captureWork.filePath, captureFile, sizeof(captureWork.filePath));
+    }
+
+    return;
+}
+
+void captureMediumAttach (WVIEW_MEDIUM *medium)
+{
+    if (captureWork.mode == CAPTURE_MODE_NONE ||
+        captureWork.isAttached ||
+        medium != captureWork.station)
+    {
+        return;
+    }
+
+    captureWork.original = *medium;
+    captureWork.isAttached = TRUE;
+
+    if (captureWork.mode == CAPTURE_MODE_RECORD)
+    {
+        if (medium->type == MEDIUM_TYPE_USBHID)
+        {
+            medium->usbhidInit          = recordUsbhidInit;
+            medium->usbhidExit          = recordUsbhidExit;
+            medium->usbhidRead          = recordUsbhidRead;
+            medium->usbhidReadSpecial   = recordUsbhidReadSpecial;
+            medium->usbhidWrite         = recordUsbhidWrite;
+        }
+        else
+        {
+            medium->init                = recordInit;
+            medium->exit                = recordExit;
+            medium->read                = recordRead;
+            medium->write               = recordWrite;
+            medium->flush               = recordFlush;
+            medium->txdrain             = recordDrain;
+        }
+    }
+    else
+    {
+        if (medium->type == MEDIUM_TYPE_USBHID)
+        {
+            medium->usbhidInit          = replayUsbhidInit;
+            medium->usbhidExit          = replayUsbhidExit;
+            medium->usbhidRead          = replayUsbhidRead;
+            medium->usbhidReadSpecial   = replayUsbhidReadSpecial;
+            medium->usbhidWrite         = replayUsbhidWrite;
+        }
+        else
+        {
+            medium->init                = replayInit;
+            medium->exit                = replayExit;
+            medium->read                = replayRead;
+            medium->write               = replayWrite;
+            medium->flush               = replayFlush;
+            medium->txdrain             = replayDrain;
+            medium->getsocket           = replayGetSocket;
+        }
+    }
+
+    return;
+}
@@ -0,0 +1,152 @@
+#ifndef INC_captureh
+#define INC_captureh
+/*---------------------------------------------------------------------------
+
+  FILENAME:
+        capture.h
+
+  PURPOSE:
+        Provide record and replay of station medium traffic.
+
+  REVISION HISTORY:
+        Date            Engineer        Revision        Remarks
+        10/19/2026      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               64-bit record deltas
+        10/19/2026      M.S. Teel       2               Replay socket for getsocket
+
+  NOTES:
+        Capture file format (all integers in network byte order):
+
+        file header (CAPTURE_FILE_HEADER_LENGTH bytes):
+            8 bytes     "WVCAPTR2"
+            4 bytes     start time seconds
+            4 bytes     start time microseconds
+            2 bytes     medium type (WVIEW_MEDIUM_TYPE)
+            2 bytes     reserved
+
+        followed by records (CAPTURE_RECORD_HEADER_LENGTH bytes + data):
+            8 bytes     microseconds since the previous record
+            1 byte      operation (CAPTURE_OP)
+            1 byte      reserved
+            2 bytes     requested length
+            2 bytes     result (bytes transferred or ERROR)
+            'result' bytes of data (if result > 0)
+
+        "WVCAPTR1" files (4 byte record deltas, which wrap after about 71
+        minutes between records) can still be replayed.
+
+        Only the station medium (WVIEWD_WORK.medium) is captured/replayed;
+        datafeed client media opened by a station are left alone.
+        Traffic a driver exchanges directly on the socket (getsocket) is not
+        seen by the medium layer and so is not captured; drivers must read
+        and write through the medium methods. During replay getsocket
+        returns the replay socket, good for socket options and select only.
+
+  LICENSE:
+        Copyright (c) 2026, Mark S. Teel (mark@teel.ws)
+
+        This source code is released for free distribution under the terms
+        of the GNU General Public License.
+
+----------------------------------------------------------------------------*/
+
+/*  ... System include files
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <string.h>
+
+/*  ... Library include files
+*/
+#include <sysdefs.h>
+#include <radtimeUtils.h>
+#include <radsocket.h>
+
+/*  ... Local include files
+*/
+#include <daemon.h>
+
+
+#define CAPTURE_FILE_MAGIC              "WVCAPTR2"
+#define CAPTURE_FILE_MAGIC_V1           "WVCAPTR1"
+#define CAPTURE_FILE_HEADER_LENGTH      20
+#define CAPTURE_RECORD_HEADER_LENGTH    14
+#define CAPTURE_RECORD_HEADER_LENGTH_V1 10
+
+typedef enum
+{
+    CAPTURE_OP_READ             = 1,
+    CAPTURE_OP_WRITE,
+    CAPTURE_OP_FLUSH,
+    CAPTURE_OP_TXDRAIN,
+    CAPTURE_OP_USBHID_READ,
+    CAPTURE_OP_USBHID_READ_SPECIAL,
+    CAPTURE_OP_USBHID_WRITE
+} CAPTURE_OP;
+
+typedef enum
+{
+    CAPTURE_MODE_NONE           = 0,
+    CAPTURE_MODE_RECORD,
+    CAPTURE_MODE_REPLAY
+} CAPTURE_MODE;
+
+typedef struct
+{
+    ULONGLONG       delta;                      // usecs
+    UCHAR           op;
+    USHORT          length;
+    short           result;
+} CAPTURE_RECORD;
+
+// define our work area
+typedef struct
+{
+    CAPTURE_MODE    mode;
+    char            filePath[WVIEW_MAX_PATH];
+    float           speed;                      // replay: 0 = no delay
+    FILE            *file;
+    WVIEW_MEDIUM    *station;                   // the medium to capture
+    int             isAttached;
+    WVIEW_MEDIUM    original;                   // medium methods we wrap
+    ULONGLONG       lastTime;                   // usecs
+
+    // replay:
+    int             pipeFds[2];                 // socketpair, [0] is med->fd
+    RADSOCK_ID      sockId;                     // pipeFds[0] for getsocket
+    int             recordHeaderLength;         // by file version
+    int             isPending;                  // byte in the pipe
+    int             haveNext;
+    CAPTURE_RECORD  next;
+    ULONGLONG       startTime;                  // usecs
+    ULONGLONG       scheduleTime;               // usecs since start
+    ULONG           records;
+    ULONG           divergences;
+    int             isComplete;
+} CAPTURE_WORK;
+
+
+
+/* ... function prototypes
+*/
+
+// set the capture mode - call before the station medium is initialized;
+// 'captureFile' records all traffic, else 'replayFile' is played back at
+// 'replaySpeed' times the recorded speed (0 means as fast as possible)
+extern void captureConfigure
+(
+    WVIEW_MEDIUM    *stationMedium,
+    char            *captureFile,
+    char            *replayFile,
+    float           replaySpeed
+);
+
+// called by each xxxMediumInit after the medium methods are set; ignores
+// any medium other than the configured station medium
+extern void captureMediumAttach (WVIEW_MEDIUM *medium);
+
+#endif
+
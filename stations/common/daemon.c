@@ -40,6 +40,7 @@
 #include <station.h>
 #include <computedData.h>
 #include <stormRain.h>
+#include <capture.h>
 
 /*  ... global memory declarations
 */
@@ -63,9 +64,10 @@ static char*            wviewStatusLabels[STATUS_STATS_MAX] =
 /* ... methods
 */
 
-static int daemonStationLoopComplete (void)
+int daemonStationLoopComplete (void)
 {
     float           tempf, sampleRain, sampleET;
+    time_t          nowTime;
 
     if (!wviewdWork.runningFlag)
     {
@@ -108,6 +110,24 @@ static int daemonStationLoopComplete (void)
     wviewdWork.loopPkt.heatindex = wvutilsCalculateHeatIndex(wviewdWork.loopPkt.outTemp,
                                                              (float)wviewdWork.loopPkt.outHumidity);
 
+    // update the sliding window wind statistics:
+    nowTime = time(NULL);
+    windStatsAddSample (&wviewdWork.windTwoMinute, nowTime,
+                        wviewdWork.loopPkt.windSpeed, wviewdWork.loopPkt.windDir,
+                        wviewdWork.loopPkt.windGust, wviewdWork.loopPkt.windGustDir);
+    windStatsAddSample (&wviewdWork.windTenMinute, nowTime,
+                        wviewdWork.loopPkt.windSpeed, wviewdWork.loopPkt.windDir,
+                        wviewdWork.loopPkt.windGust, wviewdWork.loopPkt.windGustDir);
+
+    tempf = windStatsGetAvgSpeed(&wviewdWork.windTwoMinute, nowTime);
+    wviewdWork.loopPkt.twoMinuteAvgWindSpeed    = (USHORT)(tempf + 0.5);
+    wviewdWork.loopPkt.twoMinuteAvgWindDir      = (USHORT)windStatsGetAvgDirection(&wviewdWork.windTwoMinute, nowTime);
+    tempf = windStatsGetAvgSpeed(&wviewdWork.windTenMinute, nowTime);
+    wviewdWork.loopPkt.tenMinuteAvgWindSpeed    = (USHORT)(tempf + 0.5);
+    wviewdWork.loopPkt.tenMinuteAvgWindDir      = (USHORT)windStatsGetAvgDirection(&wviewdWork.windTenMinute, nowTime);
+    wviewdWork.loopPkt.tenMinuteWindGust        = (USHORT)windStatsGetGust(&wviewdWork.windTenMinute, nowTime);
+    wviewdWork.loopPkt.tenMinuteWindGustDir     = (USHORT)windStatsGetGustDirection(&wviewdWork.windTenMinute, nowTime);
+
     // store the results:
     computedDataStoreSample (&wviewdWork);
 
@@ -666,6 +686,8 @@ int main (int argc, char *argv[])
     int             iValue;
     double          dValue;
     const char*     sValue;
+    char            captureFile[WVIEW_MAX_PATH];
+    char            replayFile[WVIEW_MAX_PATH];
     int             runAsDaemon = TRUE;
 
     if (argc > 1)
@@ -679,6 +701,8 @@ int main (int argc, char *argv[])
     /*  ... start with a clean slate
     */
     memset (&wviewdWork, 0, sizeof (wviewdWork));
+    windStatsInit (&wviewdWork.windTwoMinute, WSTATS_TWO_MINUTES);
+    windStatsInit (&wviewdWork.windTenMinute, WSTATS_TEN_MINUTES);
 
     /*  ... initialize some system stuff first
     */
@@ -895,6 +919,30 @@ int main (int argc, char *argv[])
     }
     ///// STATION_INTERFACE PROCESSING END /////
 
+    // medium record/replay (debugging aids):
+    sValue = wvconfigGetStringValue(configItem_STATION_CAPTURE_FILE);
+    wvstrncpy(captureFile, ((sValue == NULL) ? "" : sValue), sizeof(captureFile));
+    sValue = wvconfigGetStringValue(configItem_STATION_REPLAY_FILE);
+    wvstrncpy(replayFile, ((sValue == NULL) ? "" : sValue), sizeof(replayFile));
+    if (wvconfigGetStringValue(configItem_STATION_REPLAY_SPEED) == NULL)
+    {
+        dValue = 1.0;
+    }
+    else
+    {
+        dValue = wvconfigGetDOUBLEValue(configItem_STATION_REPLAY_SPEED);
+    }
+    if (strlen(replayFile) > 0)
+    {
+        radMsgLog (PRI_STATUS, "station medium: replaying %s (speed %.1f)",
+                   replayFile, dValue);
+    }
+    else if (strlen(captureFile) > 0)
+    {
+        radMsgLog (PRI_STATUS, "station medium: capturing to %s", captureFile);
+    }
+    captureConfigure (&wviewdWork.medium, captureFile, replayFile, (float)dValue);
+
     iValue = wvconfigGetINTValue(configItem_STATION_STATION_RAIN_SEASON_START);
     if (iValue <= 0)
     {
@@ -57,6 +57,7 @@
 #include <wvconfig.h>
 #include <emailAlerts.h>
 #include <status.h>
+#include <windStats.h>
 #include <hidapi.h>
 
 
@@ -162,6 +163,8 @@ typedef struct
     ULONG           cdataInterval;
     ULONG           pushInterval;
     SENSOR_STORE    sensors;
+    WSTATS          windTwoMinute;              // sliding window wind
+    WSTATS          windTenMinute;
     LOOP_PKT        loopPkt;                    // for IPM pkts
     int             numReadRetries;
     int             archiveRqstPending;
@@ -203,6 +206,12 @@ typedef struct
 } WVIEWD_WORK;
 
 
+// Process the LOOP data in WVIEWD_WORK synchronously - for stations which
+// produce LOOP packets faster than STATION_LOOP_COMPLETE_EVENT can deliver
+// them (events of the same type are coalesced):
+extern int daemonStationLoopComplete (void);
+
+
 /*  !!!!!!!!!!!!!!!!!!!!  END HIDDEN SECTION  !!!!!!!!!!!!!!!!!!!!!
 */
 
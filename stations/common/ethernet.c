@@ -10,6 +10,8 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         06/09/2005      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Add the non-blocking
+                                                        connect
  
   NOTES:
         wview medium-specific routines to be supplied:
@@ -47,6 +49,10 @@
 #include <time.h>
 #include <errno.h>
 #include <math.h>
+#include <poll.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 
 
 /*  ... Library include files
@@ -60,6 +66,7 @@
 #include <ethernet.h>
 #include <daemon.h>
 #include <station.h>
+#include <capture.h>
 
 /*  ... global memory declarations
 */
@@ -128,6 +135,8 @@ static void ethernetExit (WVIEW_MEDIUM *med)
 
     if (eth->sockId)
         radSocketDestroy (eth->sockId);
+    else if (eth->connectFd >= 0)
+        close (eth->connectFd);
     
     free (eth);
     
@@ -273,6 +282,7 @@ int ethernetMediumInit (WVIEW_MEDIUM *medium, char *hostname, int port)
 
     wvstrncpy (work->host, hostname, sizeof(work->host));
     work->port = port;
+    work->connectFd = -1;
     
     // set our workData pointer for later use
     medium->workData = (void *)work;
@@ -284,7 +294,126 @@ int ethernetMediumInit (WVIEW_MEDIUM *medium, char *hostname, int port)
     medium->flush       = ethernetFlush;
     medium->txdrain     = ethernetDrain;
     medium->getsocket   = ethernetGetSocket;
-    
+
+    // record/replay if configured:
+    captureMediumAttach (medium);
+
+    return OK;
+}
+
+
+int ethernetMediumConnectStart (WVIEW_MEDIUM *medium)
+{
+    MEDIUM_ETHERNET     *eth = (MEDIUM_ETHERNET *)medium->workData;
+    struct sockaddr_in  sa;
+    struct hostent      *hostEntry;
+    int                 flags;
+
+    memset (&sa, 0, sizeof (sa));
+    sa.sin_family = AF_INET;
+    sa.sin_port   = htons (eth->port);
+    if (inet_aton (eth->host, &sa.sin_addr) == 0)
+    {
+        // a host name still needs a (blocking) lookup:
+        hostEntry = gethostbyname (eth->host);
+        if (hostEntry == NULL || hostEntry->h_addrtype != AF_INET)
+        {
+            radMsgLog (PRI_HIGH, "ethernetMediumConnectStart: cannot resolve %s",
+                       eth->host);
+            return ERROR;
+        }
+        memcpy (&sa.sin_addr, hostEntry->h_addr_list[0], sizeof (sa.sin_addr));
+    }
+
+    eth->connectFd = socket (AF_INET, SOCK_STREAM, 0);
+    if (eth->connectFd < 0)
+    {
+        radMsgLog (PRI_HIGH, "ethernetMediumConnectStart: socket failed: %s",
+                   strerror(errno));
+        return ERROR;
+    }
+
+    flags = fcntl (eth->connectFd, F_GETFL, 0);
+    if (flags < 0 || fcntl (eth->connectFd, F_SETFL, flags | O_NONBLOCK) < 0)
+    {
+        radMsgLog (PRI_HIGH, "ethernetMediumConnectStart: O_NONBLOCK failed: %s",
+                   strerror(errno));
+        close (eth->connectFd);
+        eth->connectFd = -1;
+        return ERROR;
+    }
+
+    if (connect (eth->connectFd, (struct sockaddr *)&sa, sizeof (sa)) < 0 &&
+        errno != EINPROGRESS)
+    {
+        radMsgLog (PRI_HIGH, "ethernetMediumConnectStart: connect to %s:%d failed: %s",
+                   eth->host, eth->port, strerror(errno));
+        close (eth->connectFd);
+        eth->connectFd = -1;
+        return ERROR;
+    }
+
+    medium->fd = eth->connectFd;
     return OK;
 }
 
+int ethernetMediumConnectCheck (WVIEW_MEDIUM *medium, int msTimeout)
+{
+    MEDIUM_ETHERNET     *eth = (MEDIUM_ETHERNET *)medium->workData;
+    struct pollfd       pfd;
+    int                 retVal, sockError = 0;
+    socklen_t           length = sizeof (sockError);
+
+    if (eth->sockId != NULL)
+    {
+        return TRUE;
+    }
+    if (eth->connectFd < 0)
+    {
+        return ERROR;
+    }
+
+    pfd.fd      = eth->connectFd;
+    pfd.events  = POLLOUT;
+    pfd.revents = 0;
+    retVal = poll (&pfd, 1, msTimeout);
+    if (retVal == 0 || (retVal < 0 && errno == EINTR))
+    {
+        return FALSE;
+    }
+    else if (retVal < 0)
+    {
+        radMsgLog (PRI_HIGH, "ethernetMediumConnectCheck: poll failed: %s",
+                   strerror(errno));
+        return ERROR;
+    }
+
+    // writable - the connect has resolved one way or the other:
+    if (getsockopt (eth->connectFd, SOL_SOCKET, SO_ERROR, &sockError, &length) < 0)
+    {
+        sockError = errno;
+    }
+    if (sockError != 0)
+    {
+        radMsgLog (PRI_HIGH, "ethernetMediumConnectCheck: connect to %s:%d failed: %s",
+                   eth->host, eth->port, strerror(sockError));
+        return ERROR;
+    }
+
+    // radlib has no call to adopt a connected descriptor, so build the
+    // socket ID the way radSocketClientCreate does (radSocketDestroy closes
+    // the descriptor and frees it):
+    eth->sockId = (RADSOCK_ID) malloc (sizeof (*eth->sockId));
+    if (eth->sockId == NULL)
+    {
+        return ERROR;
+    }
+    memset (eth->sockId, 0, sizeof (*eth->sockId));
+    eth->sockId->sockfd = eth->connectFd;
+    eth->connectFd = -1;
+
+    radMsgLog (PRI_STATUS, "ethernetMediumConnectCheck: connected to %s:%d",
+               eth->host, eth->port);
+    return TRUE;
+}
+
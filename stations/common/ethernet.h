@@ -12,6 +12,8 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         06/09/2005      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Add the non-blocking
+                                                        connect
  
   NOTES:
         
@@ -53,6 +55,7 @@ typedef struct
     RADSOCK_ID      sockId;
     char            host[WVIEW_STRING1_SIZE];
     int             port;
+    int             connectFd;              // non-blocking connect in progress
 } MEDIUM_ETHERNET;
 
 
@@ -60,8 +63,19 @@ typedef struct
 /* ... function prototypes
 */
 
-// this is the only globally visible method
 extern int ethernetMediumInit (WVIEW_MEDIUM *medium, char *hostname, int port);
 
+// Instead of the medium 'init' method, start a non-blocking connect to the
+// host and port given to ethernetMediumInit; medium->fd is set for the
+// caller to wait on.
+// Returns: OK if the connect is complete or in progress, ERROR if it failed
+extern int ethernetMediumConnectStart (WVIEW_MEDIUM *medium);
+
+// Wait up to 'msTimeout' for the connect started by ethernetMediumConnectStart
+// to resolve; once it has, the medium is ready to use (non-blocking).
+// Returns: TRUE if connected, FALSE if still in progress or ERROR if the
+//          connect failed (the medium 'exit' method must still be called)
+extern int ethernetMediumConnectCheck (WVIEW_MEDIUM *medium, int msTimeout);
+
 #endif
 
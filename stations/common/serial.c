@@ -58,6 +58,7 @@
 #include <serial.h>
 #include <daemon.h>
 #include <station.h>
+#include <capture.h>
 
 /*  ... global memory declarations
 */
@@ -226,6 +227,9 @@ int serialMediumInit (WVIEW_MEDIUM *medium, void (*portInit)(int fd), int openFl
     medium->txdrain     = serialDrain;
     medium->getsocket   = serialGetSocket;
 
+    // record/replay if configured:
+    captureMediumAttach (medium);
+
     return OK;
 }
 
@@ -9,6 +9,8 @@
   REVISION HISTORY:
         Date            Engineer        Revision        Remarks
         12/31/2005      M.S. Teel       0               Original
+        10/19/2026      M.S. Teel       1               Wind windows in the
+                                                        archive notification
 
   NOTES:
 
@@ -107,6 +109,9 @@ int stationSendArchiveNotifications (WVIEWD_WORK *work, float sampleRain)
     notify.hiwspeed         = work->loopPkt.windGust;
     notify.rxPercent        = work->loopPkt.rxCheckPercent;
     notify.sampleRain       = sampleRain;
+    notify.winddir2min      = work->loopPkt.twoMinuteAvgWindDir;
+    notify.wspeed2min       = work->loopPkt.twoMinuteAvgWindSpeed;
+    notify.hiwspeed10min    = work->loopPkt.tenMinuteWindGust;
 
     tempfloat = sensorGetCumulative (&work->sensors.sensor[STF_HOUR][SENSOR_RAIN]);
     tempfloat *= 100;
@@ -500,6 +505,26 @@ int stationGetConfigValueFloat (WVIEWD_WORK *work, char *configName, float *stor
     return OK;
 }
 
+int stationGetConfigValueString (WVIEWD_WORK *work, char *configName, char *store, int length)
+{
+    const char*     value;
+    int             retVal = OK;
+
+    wvconfigInit (FALSE);
+    value = wvconfigGetStringValue (configName);
+    if (value == NULL)
+    {
+        store[0] = 0;
+        retVal = ERROR;
+    }
+    else
+    {
+        wvstrncpy (store, value, length);
+    }
+    wvconfigExit ();
+    return retVal;
+}
+
 void stationClearLoopData (WVIEWD_WORK *work)
 {
     work->loopPkt.sampleET                      = ARCHIVE_VALUE_NULL;
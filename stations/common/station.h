@@ -242,6 +242,7 @@ extern int stationVerifyArchiveInterval (WVIEWD_WORK *work);
 extern int stationGetConfigValueInt (WVIEWD_WORK *work, char *configName, int *store);
 extern int stationGetConfigValueFloat (WVIEWD_WORK *work, char *configName, float *store);
 extern int stationGetConfigValueBoolean (WVIEWD_WORK *work, char *configName, int *store);
+extern int stationGetConfigValueString (WVIEWD_WORK *work, char *configName, char *store, int length);
 
 // Clear optional station data in the loop packt:
 extern void stationClearLoopData (WVIEWD_WORK *work);
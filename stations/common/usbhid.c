@@ -58,6 +58,7 @@
 #include <daemon.h>
 #include <station.h>
 #include <usbhid.h>
+#include <capture.h>
 
 /*  ... global memory declarations
 */
@@ -287,6 +288,9 @@ int usbhidMediumInit
     medium->usbhidReadSpecial   = usbhidReadSpecial;
     medium->usbhidWrite         = usbhidWrite;
 
+    // record/replay if configured:
+    captureMediumAttach (medium);
+
     return OK;
 }
 
@@ -0,0 +1,153 @@
+/*---------------------------------------------------------------------
+
+ FILE NAME:
+        wvstatus.c
+
+ PURPOSE:
+        wview status utility: render the daemon status segments
+        (WVIEW_STATUS_DIRECTORY/<name>.met) in the status file format.
+
+ REVISION HISTORY:
+    Date        Programmer  Revision    Function
+    10/19/2026  M.S. Teel   0           Original
+
+ ASSUMPTIONS:
+ None.
+
+------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/types.h>
+
+#include <sysdefs.h>
+#include <status.h>
+
+
+
+static void USAGE (void)
+{
+    printf ("Usage: wvstatus [-m] [-w] [name ...]\n\n");
+    printf ("    Print the status of each daemon named (wview, html, alarms, cwop, http, ftp, ssh, pmon, export)\n");
+    printf ("    or of every daemon with a status segment in %s if none are named\n", WVIEW_STATUS_DIRECTORY);
+    printf ("Note: [-m] adds the histograms (hist<n>, hist<n>_samples, hist<n>_last, hist<n>_max, hist<n>_bins)\n");
+    printf ("Note: [-w] writes %s/<name>%s instead of printing\n\n", WVIEW_STATUS_DIRECTORY, STATUS_FILE_EXT);
+    return;
+}
+
+static int renderOne (const char* name, int withHistograms, int toFile, int withSection)
+{
+    STATUS_SEGMENT* segment;
+    FILE*           out = stdout;
+    char            path[_MAX_PATH], temp[_MAX_PATH+8];
+    int             retVal;
+
+    sprintf (path, "%s/%s%s", WVIEW_STATUS_DIRECTORY, name, STATUS_SEGMENT_EXT);
+    segment = statusSegmentAttach (path);
+    if (segment == NULL)
+    {
+        fprintf (stderr, "wvstatus: no status segment %s\n", path);
+        return ERROR;
+    }
+
+    if (toFile)
+    {
+        sprintf (path, "%s/%s%s", WVIEW_STATUS_DIRECTORY, name, STATUS_FILE_EXT);
+        sprintf (temp, "%s.tmp", path);
+        out = fopen (temp, "w");
+        if (out == NULL)
+        {
+            fprintf (stderr, "wvstatus: cannot create %s\n", temp);
+            statusSegmentDetach (segment);
+            return ERROR;
+        }
+    }
+    else if (withSection)
+    {
+        fprintf (out, "[%s]\n", name);
+    }
+
+    retVal = statusSegmentRender (segment, out, withHistograms);
+    statusSegmentDetach (segment);
+
+    if (toFile)
+    {
+        fclose (out);
+        if (rename (temp, path) != 0)
+        {
+            fprintf (stderr, "wvstatus: cannot rename %s\n", temp);
+            unlink (temp);
+            return ERROR;
+        }
+    }
+
+    return retVal;
+}
+
+
+int main (int argc, char *argv[])
+{
+    DIR*            dir;
+    struct dirent*  entry;
+    char            name[_MAX_PATH];
+    char*           ext;
+    int             opt, index, withHistograms = FALSE, toFile = FALSE;
+    int             retVal = OK;
+
+    while ((opt = getopt (argc, argv, "mwh")) != -1)
+    {
+        switch (opt)
+        {
+            case 'm':
+                withHistograms = TRUE;
+                break;
+            case 'w':
+                toFile = TRUE;
+                break;
+            default:
+                USAGE ();
+                exit (1);
+        }
+    }
+
+    if (optind < argc)
+    {
+        for (index = optind; index < argc; index ++)
+        {
+            if (renderOne (argv[index], withHistograms, toFile,
+                           (argc - optind) > 1) == ERROR)
+            {
+                retVal = ERROR;
+            }
+        }
+
+        exit ((retVal == OK) ? 0 : 1);
+    }
+
+    dir = opendir (WVIEW_STATUS_DIRECTORY);
+    if (dir == NULL)
+    {
+        fprintf (stderr, "wvstatus: cannot open %s\n", WVIEW_STATUS_DIRECTORY);
+        exit (1);
+    }
+
+    while ((entry = readdir (dir)) != NULL)
+    {
+        ext = strrchr (entry->d_name, '.');
+        if (ext == NULL || strcmp (ext, STATUS_SEGMENT_EXT) != 0)
+        {
+            continue;
+        }
+
+        wvstrncpy (name, entry->d_name, (ext - entry->d_name) + 1);
+        if (renderOne (name, withHistograms, toFile, TRUE) == ERROR)
+        {
+            retVal = ERROR;
+        }
+    }
+
+    closedir (dir);
+    exit ((retVal == OK) ? 0 : 1);
+}
+
@@ -55,7 +55,11 @@ else
                                 if [ "$STATION_BIN" = "wviewd_virtual" ]; then
                                     STATION_TYPE="Virtual"
                                 else
-                                    STATION_TYPE="Simulator"
+                                    if [ "$STATION_BIN" = "wviewd_vmulti" ]; then
+                                        STATION_TYPE="VirtualMulti"
+                                    else
+                                        STATION_TYPE="Simulator"
+                                    fi
                                 fi
                             fi
                         fi
@@ -189,6 +193,10 @@ get_wview_conf_interactive()
 		echo "                                        else"			>> $WVIEW_CONF_DIR/editparm
 		echo "                                            if [ \"\$INVAL\" = \"Virtual\" ]; then"				>> $WVIEW_CONF_DIR/editparm
 		echo "                                                echo \"wviewd_virtual\" > $WVIEW_CONF_DIR/wview-binary"	>> $WVIEW_CONF_DIR/editparm
+		echo "                                            else"			>> $WVIEW_CONF_DIR/editparm
+		echo "                                                if [ \"\$INVAL\" = \"VirtualMulti\" ]; then"				>> $WVIEW_CONF_DIR/editparm
+		echo "                                                    echo \"wviewd_vmulti\" > $WVIEW_CONF_DIR/wview-binary"	>> $WVIEW_CONF_DIR/editparm
+		echo "                                                fi"												>> $WVIEW_CONF_DIR/editparm
 		echo "                                            fi"												>> $WVIEW_CONF_DIR/editparm
 		echo "                                        fi"												>> $WVIEW_CONF_DIR/editparm
 		echo "                                    fi"												>> $WVIEW_CONF_DIR/editparm
@@ -8,6 +8,34 @@ function IsStatusAvailable($procname)
     return (file_exists($pidstr));
 }
 
+// Read the live status from the process status segment (via wvstatus), or
+// the last status file written if wvstatus is not available:
+function ReadStatus($procname)
+{
+    $statusBinary = GetBinaryPrefix() . "/bin/wvstatus";
+    if (is_executable($statusBinary))
+    {
+        $lines = array();
+        exec($statusBinary . " " . escapeshellarg($procname) . " 2>/dev/null", $lines, $retVal);
+        if ($retVal == 0)
+        {
+            $ini_array = array();
+            foreach ($lines as $line)
+            {
+                $pair = explode("=", $line, 2);
+                if (count($pair) == 2)
+                {
+                    $ini_array[trim($pair[0])] = trim(trim($pair[1]), "\"");
+                }
+            }
+            return $ini_array;
+        }
+    }
+
+    $pidstr = "/var/run/wview/" . $procname . ".sts";
+    return parse_ini_file($pidstr);
+}
+
 function DisplayStatusColor($status)
 {
     switch($status)
@@ -58,8 +86,7 @@ function DisplayStatuses()
         echo "<td>$process</td>";
         if (IsStatusAvailable($process))
         {
-            $pidstr = "/var/run/wview/" . $process . ".sts";
-            $ini_array = parse_ini_file($pidstr);
+            $ini_array = ReadStatus($process);
             echo "<td>" . DisplayStatusColor($ini_array[status]) . "</td>";
             echo "<td>" . $statusLabels[$ini_array[status]] . "</td>";
             if (array_key_exists(message, $ini_array))
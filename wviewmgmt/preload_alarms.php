@@ -54,6 +54,10 @@
     {
         $field_Station_Type = "Virtual";
     }
+    else if ($stationType == "VirtualMulti")
+    {
+        $field_Station_Type = "VirtualMulti";
+    }
 
     // Alarms:
     $field_Alarms_Metric                    = SqliteDBGetValue($dbID, 'ALARMS_STATION_METRIC');
@@ -54,6 +54,10 @@
     {
         $field_Station_Type = "Virtual";
     }
+    else if ($stationType == "VirtualMulti")
+    {
+        $field_Station_Type = "VirtualMulti";
+    }
 
     // Calibration:
     if (SqliteDBGetValue($dbID, 'STATION_TYPE') == "VantagePro")
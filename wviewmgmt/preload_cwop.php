@@ -54,6 +54,10 @@
     {
         $field_Station_Type = "Virtual";
     }
+    else if ($stationType == "VirtualMulti")
+    {
+        $field_Station_Type = "VirtualMulti";
+    }
 
     // CWOP:
     $field_CWOP_CallSign                    = SqliteDBGetValue($dbID, 'CWOP_APRS_CALL_SIGN');
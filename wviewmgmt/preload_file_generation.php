@@ -54,6 +54,10 @@
     {
         $field_Station_Type = "Virtual";
     }
+    else if ($stationType == "VirtualMulti")
+    {
+        $field_Station_Type = "VirtualMulti";
+    }
 
     // Generation:
     $field_Generate_Station_Name            = SqliteDBGetValue($dbID, 'HTMLGEN_STATION_NAME');
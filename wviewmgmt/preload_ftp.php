@@ -54,6 +54,10 @@
     {
         $field_Station_Type = "Virtual";
     }
+    else if ($stationType == "VirtualMulti")
+    {
+        $field_Station_Type = "VirtualMulti";
+    }
 
     // FTP:
     $field_FTP_Hostname                     = SqliteDBGetValue($dbID, 'FTP_HOST');
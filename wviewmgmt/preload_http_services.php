@@ -54,6 +54,10 @@
     {
         $field_Station_Type = "Virtual";
     }
+    else if ($stationType == "VirtualMulti")
+    {
+        $field_Station_Type = "VirtualMulti";
+    }
 
     // HTTP:
     $field_HTTP_Wunderground_ID             = SqliteDBGetValue($dbID, 'HTTP_WUSTATIONID');
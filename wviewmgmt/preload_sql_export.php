@@ -54,6 +54,10 @@
     {
         $field_Station_Type = "Virtual";
     }
+    else if ($stationType == "VirtualMulti")
+    {
+        $field_Station_Type = "VirtualMulti";
+    }
 
     // SQL Export:
     $field_SQL_Hostname                     = SqliteDBGetValue($dbID, 'STATION_SQLDB_HOST');
@@ -54,6 +54,10 @@
     {
         $field_Station_Type = "Virtual";
     }
+    else if ($stationType == "VirtualMulti")
+    {
+        $field_Station_Type = "VirtualMulti";
+    }
 
     // SSH:
     $field_SSH_Source_1                     = SqliteDBGetValue($dbID, 'SSH_1_SOURCE');
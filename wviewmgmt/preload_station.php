@@ -54,6 +54,10 @@
     {
         $field_Station_Type = "Virtual";
     }
+    else if ($stationType == "VirtualMulti")
+    {
+        $field_Station_Type = "VirtualMulti";
+    }
 
     $field_Station_Interface                = SqliteDBGetValue($dbID, 'STATION_INTERFACE');
     $field_Station_Device                   = SqliteDBGetValue($dbID, 'STATION_DEV');
@@ -72,6 +72,12 @@
         $systemstr = "echo  \"wviewd_virtual\" > " . GetConfigPrefix() . "/wview/wview-binary";
         system($systemstr);
     }
+    else if ($_POST['field_Station_Type'] == "VirtualMulti")
+    {
+        SqliteDBSetValue($dbID, 'STATION_TYPE', 'VirtualMulti');
+        $systemstr = "echo  \"wviewd_vmulti\" > " . GetConfigPrefix() . "/wview/wview-binary";
+        system($systemstr);
+    }
     else
     {
         SqliteDBSetValue($dbID, 'STATION_TYPE', 'Simulator');
@@ -292,6 +292,8 @@
               echo "Texas Weather Instruments";
           else if ($field_Station_Type == "Virtual") 
               echo "Virtual";
+          else if ($field_Station_Type == "VirtualMulti") 
+              echo "VirtualMulti";
           else if ($field_Station_Type == "Simulator") 
               echo "Simulator";
           else
@@ -506,6 +508,8 @@
           value="Honeywell TE923">Honeywell TE923</option>
         <option <?php if ($field_Station_Type == "Virtual") echo "selected"; ?> 
           value="Virtual">Virtual</option>
+        <option <?php if ($field_Station_Type == "VirtualMulti") echo "selected"; ?> 
+          value="VirtualMulti">VirtualMulti</option>
         <option <?php if ($field_Station_Type == "Simulator") echo "selected"; ?> 
           value="Simulator">Simulator</option>
       </select>
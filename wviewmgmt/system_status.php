@@ -147,6 +147,8 @@
               echo "Texas Weather Instruments";
           else if ($field_Station_Type == "Virtual") 
               echo "Virtual";
+          else if ($field_Station_Type == "VirtualMulti") 
+              echo "VirtualMulti";
           else if ($field_Station_Type == "Simulator") 
               echo "Simulator";
           else